@@ -31,21 +31,26 @@ invariant gl_Position;
 
 void main()
 {
-	vec4 modelPos = GetStaticModel(DrawID, GetLocalMeshOrMaterialIndex(aTexCoord1)) * vec4(aPos, 1.0);
+	uint localMeshIndex = GetLocalMeshOrMaterialIndex(aTexCoord1);
+	MeshData mesh = GetMeshData(DrawID, localMeshIndex);
+	vec3 normal = DecodeMeshDirection(mesh, aNormal);
+	vec3 tangent = DecodeMeshDirection(mesh, aTangent);
+
+	vec4 modelPos = GetStaticModel(DrawID, localMeshIndex) * vec4(DecodeMeshPosition(mesh, aPos), 1.0);
 	vs_out.fragPos = modelPos.xyz;
 	gl_Position = projection * view * modelPos;
 
 	mat3 normalMatrix = transpose(inverse(mat3(models[DrawID])));
-	vs_out.normal = normalize(normalMatrix * aNormal);
+	vs_out.normal = normalize(normalMatrix * normal);
 	mat3 viewNormalMatrix = transpose(inverse(mat3(view * models[DrawID])));
 
 	
-	vs_out.viewNormal = normalize(viewNormalMatrix * aNormal);
+	vs_out.viewNormal = normalize(viewNormalMatrix * normal);
 
 	//vs_out.worldNormal = vs_out.normal;
 
 
-	vec3 T = normalize(normalMatrix * aTangent);
+	vec3 T = normalize(normalMatrix * tangent);
 
 	T = normalize(T - (dot(T, vs_out.normal) * vs_out.normal));
 
@@ -7,6 +7,10 @@
 #include "r2/Game/ECS/Components/AnimationTransitionComponent.h"
 #include "r2/Game/ECS/Components/SkeletalAnimationComponent.h"
 #include "r2/Game/ECS/Components/TransformDirtyComponent.h"
+#include "r2/Game/ECSWorld/ECSWorld.h"
+#include "r2/Game/SceneGraph/SceneGraph.h"
+#include "r2/Platform/Platform.h"
+#include "r2/Core/Engine.h"
 #include "MoveUpdateComponent.h"
 #include "GridPositionComponent.h"
 #include "GameUtils.h"
@@ -146,7 +150,7 @@ void CharacterControllerSystem::Update()
 
 			r2::ecs::TransformDirtyComponent transformDirtyComponent;
 			transformDirtyComponent.dirtyFlags = r2::ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
-			mnoptrCoordinator->AddComponentIfNeeded(e, transformDirtyComponent);
+			MENG.GetECSWorld().GetSceneGraph().SetTransformDirty(e, transformDirtyComponent);
 			gridPositionComponent.localGridPosition = moveUpdateComponentPtr->startingGridPosition;
 
 			mnoptrCoordinator->RemoveComponent<MoveUpdateComponent>(e);
@@ -12,6 +12,8 @@
 
 #include "r2/Platform/Platform.h"
 #include "r2/Core/Engine.h"
+#include "r2/Game/ECSWorld/ECSWorld.h"
+#include "r2/Game/SceneGraph/SceneGraph.h"
 #include "GameUtils.h"
 #include "r2/Render/Renderer/Renderer.h"
 
@@ -142,7 +144,7 @@ void CharacterMovementSystem::Update()
 
 		r2::ecs::TransformDirtyComponent transformDirtyComponent;
 		transformDirtyComponent.dirtyFlags = r2::ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
-		mnoptrCoordinator->AddComponentIfNeeded(e, transformDirtyComponent);
+		MENG.GetECSWorld().GetSceneGraph().SetTransformDirty(e, transformDirtyComponent);
 
 	}
 
@@ -42,7 +42,7 @@ namespace r2::ecs
 	}
 
 	template<>
-	void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<FacingComponent>& components, const r2::SArray<Entity>* entities, const r2::SArray<const flat::EntityData*>* refEntities, const flat::ComponentArrayData* componentArrayData)
+	void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<FacingComponent>& components, const SerializedEntityRemap& entityRemap, const flat::ComponentArrayData* componentArrayData)
 	{
 		R2_CHECK(r2::sarr::Size(components) == 0, "Shouldn't have anything in there yet?");
 		R2_CHECK(componentArrayData != nullptr, "Shouldn't be nullptr");
@@ -56,7 +56,7 @@ void UpdateGridPositionHierarchy(GridPositionComponent& gridPositionComponent, r
 	{
 		//update all of the children
 
-		r2::SArray<r2::ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, r2::ecs::Entity, r2::ecs::MAX_NUM_ENTITIES);
+		r2::SArray<r2::ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, r2::ecs::Entity, sceneGraph.GetNumEntitiesInScene());
 
 		sceneGraph.GetAllChildrenForEntity(theEntity, *children);
 
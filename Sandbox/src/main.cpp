@@ -645,7 +645,7 @@ public:
 
     virtual u32 GetMaxNumECSEntities() const override
     {
-        return r2::ecs::MAX_NUM_ENTITIES;
+        return r2::ecs::DEFAULT_MAX_NUM_ENTITIES;
     }
 
     virtual u32 GetMaxNumComponents() const override
@@ -674,9 +674,9 @@ public:
         memorySize += r2::ecs::ComponentArray<PlayerCommandComponent>::MemorySize(GetMaxNumECSEntities(), ALIGNMENT, stackHeaderSize, boundsChecking);
         memorySize += r2::ecs::ComponentArray<FacingComponent>::MemorySize(GetMaxNumECSEntities(), ALIGNMENT, stackHeaderSize, boundsChecking);
         memorySize += r2::ecs::ComponentArray<GridPositionComponent>::MemorySize(GetMaxNumECSEntities(), ALIGNMENT, stackHeaderSize, boundsChecking);
-        memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::ecs::ECSCoordinator::MemorySizeOfSystemType<PlayerCommandSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
-        memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::ecs::ECSCoordinator::MemorySizeOfSystemType<CharacterControllerSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
-        memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::ecs::ECSCoordinator::MemorySizeOfSystemType<FacingUpdateSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+        memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::ecs::ECSCoordinator::MemorySizeOfSystemType<PlayerCommandSystem>(GetMaxNumECSEntities(), memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+        memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::ecs::ECSCoordinator::MemorySizeOfSystemType<CharacterControllerSystem>(GetMaxNumECSEntities(), memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+        memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::ecs::ECSCoordinator::MemorySizeOfSystemType<FacingUpdateSystem>(GetMaxNumECSEntities(), memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
 
         return memorySize;
     }
@@ -721,7 +721,6 @@ public:
 	   const auto skeletonAnimationComponentType = ecsCoordinator->GetComponentType<r2::ecs::SkeletalAnimationComponent>();
 	   const auto transformComponentType = ecsCoordinator->GetComponentType<r2::ecs::TransformComponent>();
 	   const auto facingComponentType = ecsCoordinator->GetComponentType<FacingComponent>();
-       const auto transformDirtyComponentType = ecsCoordinator->GetComponentType<r2::ecs::TransformDirtyComponent>();
        const auto gridPositionComponenType = ecsCoordinator->GetComponentType<GridPositionComponent>();
        const auto moveUpdateComponentType = ecsCoordinator->GetComponentType<MoveUpdateComponent>();
 
@@ -730,7 +729,6 @@ public:
 	   r2::ecs::Signature facingUpdateSystemSignature;
 	   facingUpdateSystemSignature.set(transformComponentType);
 	   facingUpdateSystemSignature.set(facingComponentType);
-	   //facingUpdateSystemSignature.set(transformDirtyComponentType);
 
 	   FacingUpdateSystem* facingUpdateSystem = ecsWorld.RegisterSystem<FacingUpdateSystem>(facingUpdateSystemSignature);
 
@@ -303,21 +303,21 @@ local CWD       = "cd " .. os.getcwd() .. "; " -- We are in current working dire
 		}
 
 	filter "configurations:Debug"
-		defines  {"R2_DEBUG", "R2_ASSET_PIPELINE", "R2_ASSET_CACHE_DEBUG", "R2_EDITOR", "R2_IMGUI"}
+		defines  {"R2_DEBUG", "R2_ASSET_PIPELINE", "R2_ASSET_CACHE_DEBUG", "R2_EDITOR", "R2_IMGUI", "R2_PROFILER"}
 		runtime "Debug"
 		symbols "On"
 		optimize "Off"
 		staticruntime "off"
 
 	filter "configurations:Release"
-		defines "R2_RELEASE"
+		defines {"R2_RELEASE", "R2_PROFILER"}
 		runtime "Release"
 		symbols "Off"
 		optimize "On"
 		staticruntime "off"
 
 	filter "configurations:Publish"
-		defines "R2_PUBLISH"
+		defines {"R2_PUBLISH", "R2_PROFILER"}
 		runtime "Release"
 		symbols "Off"
 		optimize "Full"
@@ -346,7 +346,13 @@ project "r2Tests"
 	{
 		"%{includeDirs.catch2}",
 		"%{includeDirs.glm}",
-		"r2engine/src"
+		"r2engine/src/r2/Render/Model",
+		"r2engine/src/r2/Render/Model/Shader",
+		"r2engine/src/r2/Core/Assets",
+		"r2engine/src",
+		"%{includeDirs.flatbuffers}",
+		"%{includeDirs.texturemetadata}",
+		"%{includeDirs.assetlib}"
 	}
 
 	links
@@ -462,6 +468,157 @@ project "r2Tests"
 		optimize "On"
 		staticruntime "off"
 
+project "r2Bench"
+	location "r2Bench"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	exceptionhandling "Off"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin_int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp"
+	}
+
+	includedirs
+	{
+		"r2engine/src/r2/Render/Model",
+		"r2engine/src/r2/Render/Model/Shader",
+		"r2engine/src/r2/Game/ECS",
+		"r2engine/src/r2/Core/Assets",
+		"r2engine/src",
+		"r2engine/libs/cmdln/include",
+		"%{includeDirs.glm}",
+		"%{includeDirs.flatbuffers}",
+		"%{includeDirs.texturemetadata}",
+		"%{includeDirs.assetlib}",
+		"%{includeDirs.loguru}",
+		"%{includeDirs.imgui}"
+	}
+
+	links
+	{
+		"r2engine",
+		"cmdln"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+		flags {"MultiProcessorCompile"}
+		
+		defines
+		{
+			"R2_PLATFORM_WINDOWS"
+		}
+
+		libdirs
+		{
+			"r2engine/vendor/FMOD/Windows/core/lib/x64",
+			"r2engine/vendor/FMOD/Windows/studio/lib/x64",
+			"r2engine/vendor/FMOD/Windows/fsbank/lib/x64"
+		}
+
+	filter {"configurations:Debug", "system:windows"}
+
+		links
+		{
+			"fmodL_vc",
+			"fmodstudioL_vc",
+			"fsbank_vc",
+		}
+
+		postbuildcommands
+		{
+			"{COPY} ../r2engine/vendor/SDL2/Windows/lib/x64/SDL2.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/core/lib/x64/fmodL.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/studio/lib/x64/fmodstudioL.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/fsbank/lib/x64/fsbank.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/fsbank/lib/x64/libfsbvorbis64.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/fsbank/lib/x64/opus.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/SDL2Image/Windows/lib/x64/SDL2_image.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/SDL2Image/Windows/lib/x64/libtiff-5.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/SDL2Image/Windows/lib/x64/libpng16-16.dll ../bin/Debug_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/SDL2Image/Windows/lib/x64/libjpeg-9.dll ../bin/Debug_windows_x86_64/%{prj.name}"
+		}
+
+	filter {"configurations:Release", "system:windows"}
+
+		links
+		{
+			"fmod_vc",
+			"fmodstudio_vc",
+			"fsbank_vc",
+		}
+
+		postbuildcommands
+		{
+			"{COPY} ../r2engine/vendor/SDL2/Windows/lib/x64/SDL2.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/core/lib/x64/fmod.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/studio/lib/x64/fmodstudio.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/fsbank/lib/x64/fsbank.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/fsbank/lib/x64/libfsbvorbis64.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/FMOD/Windows/fsbank/lib/x64/opus.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/SDL2Image/Windows/lib/x64/SDL2_image.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/SDL2Image/Windows/lib/x64/libtiff-5.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/SDL2Image/Windows/lib/x64/libpng16-16.dll ../bin/Release_windows_x86_64/%{prj.name}",
+			"{COPY} ../r2engine/vendor/SDL2Image/Windows/lib/x64/libjpeg-9.dll ../bin/Release_windows_x86_64/%{prj.name}"
+		}
+
+	filter "system:macosx"
+		systemversion "latest"
+
+		xcodebuildsettings { ["CC"] = "/usr/local/Cellar/llvm/8.0.0_1/bin/clang", ["COMPILER_INDEX_STORE_ENABLE"] = "No"}
+		defines
+		{
+			"R2_PLATFORM_MAC"
+		}
+
+	filter {"configurations:Debug", "system:macosx"}
+		postbuildcommands 
+		{
+			"{COPY} ../r2engine/vendor/FMOD/MacOSX/core/lib/libfmodL.dylib ../bin/Debug_macosx_x86_64/%{prj.name}",
+		}
+
+	filter {"configurations:Release", "system:macosx"}
+		postbuildcommands 
+		{
+			"{COPY} ../r2engine/vendor/FMOD/MacOSX/core/lib/libfmod.dylib ../bin/Release_macosx_x86_64/%{prj.name}",
+		}
+
+	filter "system:linux"
+		systemversion "latest"
+
+		defines
+		{
+			"R2_PLATFORM_LINUX"
+		}
+
+	--The engine's structs change with these so they have to match r2engine's or the layouts won't line up
+	filter "configurations:Debug"
+		defines {"R2_DEBUG", "R2_ASSET_PIPELINE", "R2_ASSET_CACHE_DEBUG", "R2_EDITOR", "R2_IMGUI", "R2_PROFILER"}
+		runtime "Debug"
+		symbols "On"
+		optimize "Off"
+		staticruntime "off"
+
+	filter "configurations:Release"
+		defines {"R2_RELEASE", "R2_PROFILER"}
+		runtime "Release"
+		symbols "On"
+		optimize "On"
+		staticruntime "off"
+
+	filter "configurations:Publish"
+		defines {"R2_PUBLISH", "R2_PROFILER"}
+		runtime "Release"
+		symbols "Off"
+		optimize "Full"
+		staticruntime "off"
+
 project "Sandbox"
 	location "Sandbox"
 	kind "ConsoleApp" 
@@ -681,20 +838,20 @@ project "Sandbox"
 		}
 
 	filter "configurations:Debug"
-		defines {"R2_DEBUG", "R2_ASSET_PIPELINE", "R2_ASSET_CACHE_DEBUG", "R2_EDITOR", "R2_IMGUI"}
+		defines {"R2_DEBUG", "R2_ASSET_PIPELINE", "R2_ASSET_CACHE_DEBUG", "R2_EDITOR", "R2_IMGUI", "R2_PROFILER"}
 		runtime "Debug"
 		symbols "On"
 		staticruntime "off"
 
 	filter "configurations:Release"
-		defines "R2_RELEASE"
+		defines {"R2_RELEASE", "R2_PROFILER"}
 		runtime "Release"
 		optimize "On"
 		symbols "On"
 		staticruntime "off"
 
 	filter "configurations:Publish"
-		defines "R2_PUBLISH"
+		defines {"R2_PUBLISH", "R2_PROFILER"}
 		runtime "Release"
 		optimize "Full"
 		symbols "Off"
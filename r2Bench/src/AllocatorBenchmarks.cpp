@@ -0,0 +1,173 @@
+#include "Benchmark.h"
+#include "r2/Core/Memory/Allocators/LinearAllocator.h"
+#include "r2/Core/Memory/Allocators/StackAllocator.h"
+#include "r2/Core/Memory/Allocators/PoolAllocator.h"
+#include "r2/Core/Memory/Allocators/RingBufferAllocator.h"
+#include "r2/Core/Memory/Allocators/MallocAllocator.h"
+#include "r2/Core/Memory/Allocators/FreeListAllocator.h"
+#include "r2/Core/Containers/SArray.h"
+#include <random>
+
+namespace r2::bench
+{
+	namespace
+	{
+		const u64 NUM_ALLOCATIONS = 1024;
+		const u32 MAX_ALLOCATION_SIZE = 256;
+		const u32 POOL_ELEMENT_SIZE = 64;
+		const u64 ALLOCATOR_MEMORY_SIZE = Megabytes(2);
+
+		r2::mem::utils::MemBoundary MakeBoundary(void* memory)
+		{
+			r2::mem::utils::MemBoundary boundary;
+			boundary.location = memory;
+			boundary.size = ALLOCATOR_MEMORY_SIZE;
+			return boundary;
+		}
+	}
+
+	void RunAllocatorBenchmarks(Runner& runner)
+	{
+		r2::mem::StackArena& arena = runner.Arena();
+
+		//a fixed mix of small sizes like the engine's SArrays and components, and a shuffled order to free them in
+		r2::SArray<u32>* sizes = MAKE_SARRAY(arena, u32, NUM_ALLOCATIONS);
+		r2::SArray<u32>* freeOrder = MAKE_SARRAY(arena, u32, NUM_ALLOCATIONS);
+		r2::SArray<void*>* allocations = MAKE_SARRAY(arena, void*, NUM_ALLOCATIONS);
+
+		std::mt19937 rng(7);
+		std::uniform_int_distribution<u32> sizeDistribution(1, MAX_ALLOCATION_SIZE / 16);
+
+		for (u32 i = 0; i < NUM_ALLOCATIONS; ++i)
+		{
+			r2::sarr::Push(*sizes, sizeDistribution(rng) * 16);
+			r2::sarr::Push(*freeOrder, i);
+			r2::sarr::Push(*allocations, static_cast<void*>(nullptr));
+		}
+
+		std::shuffle(r2::sarr::Begin(*freeOrder), r2::sarr::End(*freeOrder), rng);
+
+		byte* allocatorMemory = ALLOC_BYTESN(arena, ALLOCATOR_MEMORY_SIZE, 16);
+
+		{
+			r2::mem::LinearAllocator linearAllocator(MakeBoundary(allocatorMemory));
+
+			runner.Run("allocators/LinearAllocator/AllocateReset", NUM_ALLOCATIONS, [&]() {
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					DoNotOptimize(linearAllocator.Allocate(r2::sarr::At(*sizes, i), 16, 0));
+				}
+				linearAllocator.Reset();
+			});
+		}
+
+		{
+			r2::mem::StackAllocator stackAllocator(MakeBoundary(allocatorMemory));
+
+			runner.Run("allocators/StackAllocator/AllocateFreeLIFO", NUM_ALLOCATIONS, [&]() {
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					r2::sarr::At(*allocations, i) = stackAllocator.Allocate(r2::sarr::At(*sizes, i), 16, 0);
+				}
+
+				for (s64 i = NUM_ALLOCATIONS - 1; i >= 0; --i)
+				{
+					stackAllocator.Free(r2::sarr::At(*allocations, i));
+				}
+			});
+		}
+
+		{
+			r2::mem::utils::MemBoundary poolBoundary = MakeBoundary(allocatorMemory);
+			poolBoundary.elementSize = POOL_ELEMENT_SIZE;
+			poolBoundary.alignment = 16;
+			poolBoundary.offset = 0;
+
+			r2::mem::PoolAllocator poolAllocator(poolBoundary);
+
+			runner.Run("allocators/PoolAllocator/AllocateFreeShuffled", NUM_ALLOCATIONS, [&]() {
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					r2::sarr::At(*allocations, i) = poolAllocator.Allocate(POOL_ELEMENT_SIZE, 16, 0);
+				}
+
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					poolAllocator.Free(r2::sarr::At(*allocations, r2::sarr::At(*freeOrder, i)));
+				}
+			});
+		}
+
+		{
+			r2::mem::FreeListAllocator freeListAllocator(MakeBoundary(allocatorMemory));
+
+			runner.Run("allocators/FreeListAllocator/AllocateFreeShuffled", NUM_ALLOCATIONS, [&]() {
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					r2::sarr::At(*allocations, i) = freeListAllocator.Allocate(r2::sarr::At(*sizes, i), 16, 0);
+				}
+
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					freeListAllocator.Free(r2::sarr::At(*allocations, r2::sarr::At(*freeOrder, i)));
+				}
+			});
+		}
+
+		{
+			r2::mem::RingBufferAllocator ringBufferAllocator(MakeBoundary(allocatorMemory));
+
+			runner.Run("allocators/RingBufferAllocator/AllocateFreeFIFO", NUM_ALLOCATIONS, [&]() {
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					r2::sarr::At(*allocations, i) = ringBufferAllocator.Allocate(r2::sarr::At(*sizes, i), 16, 0);
+				}
+
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					ringBufferAllocator.Free(r2::sarr::At(*allocations, i));
+				}
+			});
+		}
+
+		{
+			r2::mem::MallocAllocator mallocAllocator;
+
+			runner.Run("allocators/MallocAllocator/AllocateFreeShuffled", NUM_ALLOCATIONS, [&]() {
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					r2::sarr::At(*allocations, i) = mallocAllocator.Allocate(r2::sarr::At(*sizes, i), 16, 0);
+				}
+
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					mallocAllocator.Free(r2::sarr::At(*allocations, r2::sarr::At(*freeOrder, i)));
+				}
+			});
+		}
+
+		{
+			//Same as the StackAllocator one but through an arena so the bounds checking, tracking and tagging policies are included
+			r2::mem::StackArena* stackArena = EMPLACE_STACK_ARENA_IN_BOUNDARY(MakeBoundary(allocatorMemory));
+
+			runner.Run("allocators/StackArena/AllocateFreeLIFO", NUM_ALLOCATIONS, [&]() {
+				for (u64 i = 0; i < NUM_ALLOCATIONS; ++i)
+				{
+					r2::sarr::At(*allocations, i) = ALLOC_BYTESN(*stackArena, r2::sarr::At(*sizes, i), 16);
+				}
+
+				for (s64 i = NUM_ALLOCATIONS - 1; i >= 0; --i)
+				{
+					FREE(static_cast<byte*>(r2::sarr::At(*allocations, i)), *stackArena);
+				}
+			});
+
+			FREE_EMPLACED_ARENA(stackArena);
+		}
+
+		FREE(allocatorMemory, arena);
+		FREE(allocations, arena);
+		FREE(freeOrder, arena);
+		FREE(sizes, arena);
+	}
+}
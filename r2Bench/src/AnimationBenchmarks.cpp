@@ -0,0 +1,186 @@
+#include "Benchmark.h"
+#include "r2/Core/Containers/SArray.h"
+#include "r2/Utils/Hash.h"
+#include "r2/Core/Assets/AssetName_generated.h"
+#include "r2/Render/Animation/AnimationClip.h"
+#include "r2/Render/Animation/AnimationBatch.h"
+#include "r2/Render/Animation/TransformTrack.h"
+#include "r2/Render/Animation/Pose.h"
+#include "assetlib/RAnimation_generated.h"
+#include <random>
+
+namespace r2::bench
+{
+	namespace
+	{
+		//About the size of a humanoid rig's clip - every joint has its own linear position, rotation and scale keys
+		const u32 NUM_JOINTS = 64;
+		const u32 NUM_KEYS = 30;
+		const u32 NUM_SAMPLES_PER_SECOND = 60;
+		const float CLIP_DURATION = 1.0f;
+		const u32 NUM_SAMPLE_TIMES = 256;
+
+		//Same lookup table that ModelConvert bakes into the track info
+		std::vector<u32> MakeSampledKeys(const std::vector<float>& keyTimes)
+		{
+			const u32 numSamples = static_cast<u32>(CLIP_DURATION * NUM_SAMPLES_PER_SECOND) + 1;
+			const u32 numFrames = static_cast<u32>(keyTimes.size());
+
+			std::vector<u32> sampledKeys(numSamples);
+
+			for (u32 i = 0; i < numSamples; ++i)
+			{
+				const float t = static_cast<float>(i) / static_cast<float>(NUM_SAMPLES_PER_SECOND);
+
+				u32 frame = 0;
+				for (u32 j = 0; j < numFrames; ++j)
+				{
+					if (keyTimes[j] <= t)
+					{
+						frame = j;
+					}
+				}
+
+				sampledKeys[i] = std::min(frame, numFrames - 2);
+			}
+
+			return sampledKeys;
+		}
+
+		void BuildAnimation(flatbuffers::FlatBufferBuilder& builder)
+		{
+			std::mt19937 rng(11);
+			std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+			std::vector<float> keyTimes(NUM_KEYS);
+			for (u32 i = 0; i < NUM_KEYS; ++i)
+			{
+				keyTimes[i] = CLIP_DURATION * static_cast<float>(i) / static_cast<float>(NUM_KEYS - 1);
+			}
+
+			const std::vector<u32> sampledKeys = MakeSampledKeys(keyTimes);
+
+			std::vector<flatbuffers::Offset<flat::TransformTrack>> tracks;
+
+			for (u32 joint = 0; joint < NUM_JOINTS; ++joint)
+			{
+				std::vector<flat::VectorKey> positionKeys;
+				std::vector<flat::VectorKey> scaleKeys;
+				std::vector<flat::RotationKey> rotationKeys;
+
+				const flat::Vertex3 zero(0.0f, 0.0f, 0.0f);
+				const flat::Quaternion identity(0.0f, 0.0f, 0.0f, 1.0f);
+
+				for (u32 i = 0; i < NUM_KEYS; ++i)
+				{
+					positionKeys.push_back(flat::VectorKey(keyTimes[i], flat::Vertex3(distribution(rng), distribution(rng), distribution(rng)), zero, zero));
+					scaleKeys.push_back(flat::VectorKey(keyTimes[i], flat::Vertex3(1.0f, 1.0f, 1.0f), zero, zero));
+
+					const glm::quat rotation = glm::normalize(glm::quat(distribution(rng), distribution(rng), distribution(rng), distribution(rng)));
+					rotationKeys.push_back(flat::RotationKey(keyTimes[i], flat::Quaternion(rotation.x, rotation.y, rotation.z, rotation.w), identity, identity));
+				}
+
+				auto positionTrack = flat::CreateVectorTrack(builder, builder.CreateVectorOfStructs(positionKeys),
+					flat::CreateTrackInfo(builder, flat::InterpolationType_LINEAR, NUM_SAMPLES_PER_SECOND, builder.CreateVector(sampledKeys)));
+
+				auto rotationTrack = flat::CreateQuaternionTrack(builder, builder.CreateVectorOfStructs(rotationKeys),
+					flat::CreateTrackInfo(builder, flat::InterpolationType_LINEAR, NUM_SAMPLES_PER_SECOND, builder.CreateVector(sampledKeys)));
+
+				auto scaleTrack = flat::CreateVectorTrack(builder, builder.CreateVectorOfStructs(scaleKeys),
+					flat::CreateTrackInfo(builder, flat::InterpolationType_LINEAR, NUM_SAMPLES_PER_SECOND, builder.CreateVector(sampledKeys)));
+
+				tracks.push_back(flat::CreateTransformTrack(builder, joint, positionTrack, rotationTrack, scaleTrack, 0.0f, CLIP_DURATION));
+			}
+
+			auto assetName = flat::CreateAssetName(builder, 0, STRING_ID("bench_clip"), builder.CreateString("bench_clip"));
+
+			builder.Finish(flat::CreateRAnimation(builder, assetName, 0.0f, CLIP_DURATION, builder.CreateVector(tracks)));
+		}
+
+		u64 AnimationClipMemorySize(const r2::mem::utils::MemoryProperties& memProperties)
+		{
+			const u32 numSampledKeys = static_cast<u32>(CLIP_DURATION * NUM_SAMPLES_PER_SECOND) + 1;
+
+			u64 bytes = r2::anim::AnimationClip::MemorySize(NUM_JOINTS, memProperties);
+
+			for (u32 i = 0; i < NUM_JOINTS; ++i)
+			{
+				bytes += r2::anim::TransformTrack::MemorySize(NUM_KEYS, NUM_KEYS, NUM_KEYS, numSampledKeys, numSampledKeys, numSampledKeys, memProperties);
+			}
+
+			bytes += r2::anim::SoAAnimationClip::MemorySize(
+				NUM_JOINTS,
+				NUM_JOINTS * NUM_KEYS, NUM_JOINTS * NUM_KEYS, NUM_JOINTS * NUM_KEYS,
+				NUM_JOINTS * numSampledKeys, NUM_JOINTS * numSampledKeys, NUM_JOINTS * numSampledKeys,
+				memProperties);
+
+			return bytes;
+		}
+	}
+
+	void RunAnimationBenchmarks(Runner& runner)
+	{
+		r2::mem::StackArena& arena = runner.Arena();
+
+		flatbuffers::FlatBufferBuilder builder;
+		BuildAnimation(builder);
+
+		const flat::RAnimation* flatAnimation = flatbuffers::GetRoot<flat::RAnimation>(builder.GetBufferPointer());
+
+		r2::mem::utils::MemoryProperties memProperties;
+		memProperties.alignment = 16;
+		memProperties.headerSize = 0;
+		memProperties.boundsChecking = 0;
+
+		const u64 clipMemorySize = AnimationClipMemorySize(memProperties);
+		byte* clipMemory = ALLOC_BYTESN(arena, clipMemorySize, 16);
+
+		r2::anim::AnimationClip* clip = nullptr;
+
+		runner.Run("animation/LoadAnimationClip", NUM_JOINTS, [&]() {
+			void* memoryPointer = clipMemory;
+			clip = r2::anim::LoadAnimationClip(&memoryPointer, flatAnimation);
+			DoNotOptimize(clip);
+		});
+
+		void* memoryPointer = clipMemory;
+		clip = r2::anim::LoadAnimationClip(&memoryPointer, flatAnimation);
+
+		r2::anim::Pose pose;
+		pose.mJointTransforms = MAKE_SARRAY(arena, r2::math::Transform, NUM_JOINTS);
+		pose.mParents = MAKE_SARRAY(arena, s32, NUM_JOINTS);
+
+		for (u32 i = 0; i < NUM_JOINTS; ++i)
+		{
+			r2::sarr::Push(*pose.mJointTransforms, r2::math::Transform{});
+			r2::sarr::Push(*pose.mParents, static_cast<s32>(i) - 1);
+		}
+
+		//Spread the sample times out over the clip and a bit past it so the looping wrap is included
+		float sampleTimes[NUM_SAMPLE_TIMES];
+		for (u32 i = 0; i < NUM_SAMPLE_TIMES; ++i)
+		{
+			sampleTimes[i] = 1.25f * CLIP_DURATION * static_cast<float>(i) / static_cast<float>(NUM_SAMPLE_TIMES);
+		}
+
+		runner.Run("animation/AnimationClip/Sample", NUM_JOINTS * NUM_SAMPLE_TIMES, [&]() {
+			for (u32 i = 0; i < NUM_SAMPLE_TIMES; ++i)
+			{
+				clip->Sample(pose, sampleTimes[i], true);
+			}
+			DoNotOptimize(r2::sarr::At(*pose.mJointTransforms, NUM_JOINTS - 1).position.x);
+		});
+
+		runner.Run("animation/AnimationClip/SampleSoA", NUM_JOINTS * NUM_SAMPLE_TIMES, [&]() {
+			for (u32 i = 0; i < NUM_SAMPLE_TIMES; ++i)
+			{
+				r2::anim::SampleSoA(*clip, pose, sampleTimes[i], true);
+			}
+			DoNotOptimize(r2::sarr::At(*pose.mJointTransforms, NUM_JOINTS - 1).position.x);
+		});
+
+		FREE(pose.mParents, arena);
+		FREE(pose.mJointTransforms, arena);
+		FREE(clipMemory, arena);
+	}
+}
@@ -0,0 +1,216 @@
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	volatile u64 g_sink = 0;
+
+#if defined(R2_DEBUG)
+	const char* BUILD_CONFIGURATION = "Debug";
+#elif defined(R2_RELEASE)
+	const char* BUILD_CONFIGURATION = "Release";
+#elif defined(R2_PUBLISH)
+	const char* BUILD_CONFIGURATION = "Publish";
+#else
+	const char* BUILD_CONFIGURATION = "Unknown";
+#endif
+
+#if defined(R2_PLATFORM_WINDOWS)
+	const char* PLATFORM = "windows";
+#elif defined(R2_PLATFORM_MAC)
+	const char* PLATFORM = "macosx";
+#elif defined(R2_PLATFORM_LINUX)
+	const char* PLATFORM = "linux";
+#else
+	const char* PLATFORM = "unknown";
+#endif
+
+	bool ReadStringField(const char* line, const char* field, std::string& outValue)
+	{
+		const char* start = strstr(line, field);
+		if (!start)
+		{
+			return false;
+		}
+
+		start = strchr(start + strlen(field), '"');
+		if (!start)
+		{
+			return false;
+		}
+
+		++start;
+
+		const char* end = strchr(start, '"');
+		if (!end)
+		{
+			return false;
+		}
+
+		outValue.assign(start, end);
+		return true;
+	}
+
+	bool ReadNumberField(const char* line, const char* field, double& outValue)
+	{
+		const char* start = strstr(line, field);
+		if (!start)
+		{
+			return false;
+		}
+
+		return sscanf(start + strlen(field), " : %lf", &outValue) == 1;
+	}
+}
+
+namespace r2::bench
+{
+	void DoNotOptimize(u64 value)
+	{
+		g_sink = g_sink ^ value;
+	}
+
+	bool Runner::ShouldRun(const char* name) const
+	{
+		return mConfig.filter.empty() || strstr(name, mConfig.filter.c_str()) != nullptr;
+	}
+
+	void Runner::AddResult(const char* name, u64 itemsPerIteration, u64 iterationsPerSample, std::vector<double>& samples)
+	{
+		std::sort(samples.begin(), samples.end());
+
+		const size_t numSamples = samples.size();
+
+		Result result;
+		result.name = name;
+		result.itemsPerIteration = itemsPerIteration;
+		result.iterationsPerSample = iterationsPerSample;
+		result.numSamples = static_cast<u32>(numSamples);
+		result.minNs = samples.front();
+		result.maxNs = samples.back();
+		result.medianNs = (numSamples % 2) ? samples[numSamples / 2] : (samples[numSamples / 2 - 1] + samples[numSamples / 2]) * 0.5;
+
+		double total = 0.0;
+		for (double sample : samples)
+		{
+			total += sample;
+		}
+
+		result.meanNs = total / static_cast<double>(numSamples);
+
+		double variance = 0.0;
+		for (double sample : samples)
+		{
+			variance += (sample - result.meanNs) * (sample - result.meanNs);
+		}
+
+		result.stdDevNs = std::sqrt(variance / static_cast<double>(numSamples));
+
+		const double itemsPerSecond = result.medianNs > 0.0 ? (static_cast<double>(itemsPerIteration) * 1000000000.0) / result.medianNs : 0.0;
+
+		printf("%-56s %14.1f ns %14.1f ns %10.2f%% %16.0f items/s\n",
+			name, result.medianNs, result.minNs, result.medianNs > 0.0 ? 100.0 * result.stdDevNs / result.medianNs : 0.0, itemsPerSecond);
+
+		mResults.push_back(result);
+	}
+
+	bool WriteJSON(const char* path, const Config& config, const std::vector<Result>& results)
+	{
+		FILE* file = fopen(path, "w");
+
+		if (!file)
+		{
+			printf("Failed to open: %s for writing\n", path);
+			return false;
+		}
+
+		fprintf(file, "{\n");
+		fprintf(file, "\t\"version\": 1,\n");
+		fprintf(file, "\t\"configuration\": \"%s\",\n", BUILD_CONFIGURATION);
+		fprintf(file, "\t\"platform\": \"%s\",\n", PLATFORM);
+		fprintf(file, "\t\"numSamples\": %u,\n", config.numSamples);
+		fprintf(file, "\t\"minSampleMs\": %.3f,\n", config.minSampleMs);
+		fprintf(file, "\t\"benchmarks\": [\n");
+
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			const Result& result = results[i];
+
+			fprintf(file, "\t\t{\"name\": \"%s\", \"itemsPerIteration\": %llu, \"iterationsPerSample\": %llu, \"numSamples\": %u, \"minNs\": %.3f, \"medianNs\": %.3f, \"meanNs\": %.3f, \"maxNs\": %.3f, \"stdDevNs\": %.3f}%s\n",
+				result.name.c_str(),
+				static_cast<unsigned long long>(result.itemsPerIteration),
+				static_cast<unsigned long long>(result.iterationsPerSample),
+				result.numSamples,
+				result.minNs, result.medianNs, result.meanNs, result.maxNs, result.stdDevNs,
+				(i + 1 < results.size()) ? "," : "");
+		}
+
+		fprintf(file, "\t]\n");
+		fprintf(file, "}\n");
+
+		fclose(file);
+
+		return true;
+	}
+
+	bool ReadBaseline(const char* path, std::vector<Result>& outResults)
+	{
+		FILE* file = fopen(path, "r");
+
+		if (!file)
+		{
+			printf("Failed to open the baseline: %s\n", path);
+			return false;
+		}
+
+		char line[2048];
+
+		while (fgets(line, sizeof(line), file))
+		{
+			Result result;
+
+			if (ReadStringField(line, "\"name\"", result.name) && ReadNumberField(line, "\"medianNs\"", result.medianNs))
+			{
+				ReadNumberField(line, "\"minNs\"", result.minNs);
+				outResults.push_back(result);
+			}
+		}
+
+		fclose(file);
+
+		return true;
+	}
+
+	u32 CompareToBaseline(const std::vector<Result>& results, const std::vector<Result>& baseline, double thresholdPercent)
+	{
+		u32 numRegressions = 0;
+
+		printf("\n%-56s %14s %14s %10s\n", "Benchmark", "Baseline (ns)", "Current (ns)", "Change");
+
+		for (const Result& result : results)
+		{
+			auto iter = std::find_if(baseline.begin(), baseline.end(), [&result](const Result& baselineResult) {
+				return baselineResult.name == result.name;
+			});
+
+			if (iter == baseline.end() || iter->medianNs <= 0.0)
+			{
+				printf("%-56s %14s %14.1f %10s\n", result.name.c_str(), "-", result.medianNs, "new");
+				continue;
+			}
+
+			const double change = 100.0 * (result.medianNs - iter->medianNs) / iter->medianNs;
+			const bool regressed = change > thresholdPercent;
+
+			if (regressed)
+			{
+				++numRegressions;
+			}
+
+			printf("%-56s %14.1f %14.1f %+9.2f%%%s\n", result.name.c_str(), iter->medianNs, result.medianNs, change, regressed ? " REGRESSED" : "");
+		}
+
+		return numRegressions;
+	}
+}
@@ -0,0 +1,145 @@
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include "r2/Utils/Utils.h"
+#include "r2/Core/Memory/Memory.h"
+#include "r2/Core/Memory/Allocators/StackAllocator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace r2::bench
+{
+	struct Config
+	{
+		u32 numSamples = 15;
+		double minSampleMs = 5.0;
+		std::string filter;
+	};
+
+	//All of the times are per iteration of the benchmark. One iteration processes itemsPerIteration items (entries, allocations, entities etc.)
+	struct Result
+	{
+		std::string name;
+		u64 itemsPerIteration = 0;
+		u64 iterationsPerSample = 0;
+		u32 numSamples = 0;
+		double minNs = 0.0;
+		double medianNs = 0.0;
+		double meanNs = 0.0;
+		double maxNs = 0.0;
+		double stdDevNs = 0.0;
+	};
+
+	//Keeps the compiler from throwing away work that has no other side effects
+	void DoNotOptimize(u64 value);
+
+	inline void DoNotOptimize(float value)
+	{
+		u32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		DoNotOptimize(static_cast<u64>(bits));
+	}
+
+	template<typename T>
+	inline void DoNotOptimize(T* ptr)
+	{
+		DoNotOptimize(reinterpret_cast<u64>(ptr));
+	}
+
+	class Runner
+	{
+	public:
+		Runner(const Config& config, r2::mem::StackArena& arena)
+			:mConfig(config)
+			,mArena(arena)
+		{
+		}
+
+		//Times func(), which should do one iteration of the benchmark and leave everything the way it found it so it can be called again.
+		//The number of iterations per sample is doubled until a sample takes at least minSampleMs so that short benchmarks aren't just measuring the clock.
+		template<typename Func>
+		void Run(const char* name, u64 itemsPerIteration, Func&& func)
+		{
+			if (!ShouldRun(name))
+			{
+				return;
+			}
+
+			//warm up the caches and anything that's lazily initialized
+			func();
+
+			const double minSampleNs = mConfig.minSampleMs * 1000000.0;
+
+			u64 iterationsPerSample = 1;
+			double sampleNs = TimeIterations(iterationsPerSample, func);
+
+			while (sampleNs < minSampleNs && iterationsPerSample < (1ull << 30))
+			{
+				iterationsPerSample *= 2;
+				sampleNs = TimeIterations(iterationsPerSample, func);
+			}
+
+			std::vector<double> samples(std::max(mConfig.numSamples, 1u));
+
+			for (double& sample : samples)
+			{
+				sample = TimeIterations(iterationsPerSample, func) / static_cast<double>(iterationsPerSample);
+			}
+
+			AddResult(name, itemsPerIteration, iterationsPerSample, samples);
+		}
+
+		bool ShouldRun(const char* name) const;
+
+		inline r2::mem::StackArena& Arena() { return mArena; }
+		inline const Config& GetConfig() const { return mConfig; }
+		inline const std::vector<Result>& Results() const { return mResults; }
+
+	private:
+
+		template<typename Func>
+		double TimeIterations(u64 numIterations, Func& func)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			for (u64 i = 0; i < numIterations; ++i)
+			{
+				func();
+			}
+
+			const auto end = std::chrono::steady_clock::now();
+
+			return std::chrono::duration<double, std::nano>(end - start).count();
+		}
+
+		void AddResult(const char* name, u64 itemsPerIteration, u64 iterationsPerSample, std::vector<double>& samples);
+
+		Config mConfig;
+		r2::mem::StackArena& mArena;
+		std::vector<Result> mResults;
+	};
+
+	//Writes the results as JSON with one benchmark per line in the order they ran so runs can be diffed and compared with ReadBaseline
+	bool WriteJSON(const char* path, const Config& config, const std::vector<Result>& results);
+
+	//Reads back the name and median of every benchmark in a file written by WriteJSON
+	bool ReadBaseline(const char* path, std::vector<Result>& outResults);
+
+	//Prints how each result compares to the baseline's median. Returns the number of benchmarks that got slower by more than thresholdPercent
+	u32 CompareToBaseline(const std::vector<Result>& results, const std::vector<Result>& baseline, double thresholdPercent);
+
+	//Each group sets up its own data out of runner.Arena() and frees it before returning
+	void RunContainerBenchmarks(Runner& runner);
+	void RunAllocatorBenchmarks(Runner& runner);
+	void RunCommandBucketBenchmarks(Runner& runner);
+	void RunRenderBatchBenchmarks(Runner& runner);
+	void RunAnimationBenchmarks(Runner& runner);
+	void RunECSBenchmarks(Runner& runner);
+	void RunLevelLoadBenchmarks(Runner& runner);
+}
+
+#endif // __BENCHMARK_H__
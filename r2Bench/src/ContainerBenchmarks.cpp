@@ -0,0 +1,150 @@
+#include "Benchmark.h"
+#include "r2/Core/Containers/SArray.h"
+#include "r2/Core/Containers/SQueue.h"
+#include "r2/Core/Containers/SHashMap.h"
+#include "r2/Core/Containers/SFlatHashMap.h"
+#include <random>
+
+namespace r2::bench
+{
+	namespace
+	{
+		const u64 NUM_ITEMS = 4096;
+	}
+
+	void RunContainerBenchmarks(Runner& runner)
+	{
+		r2::mem::StackArena& arena = runner.Arena();
+
+		//asset names and entity ids are effectively random 64 bit keys
+		r2::SArray<u64>* keys = MAKE_SARRAY(arena, u64, NUM_ITEMS);
+		std::mt19937_64 rng(42);
+		for (u64 i = 0; i < NUM_ITEMS; ++i)
+		{
+			r2::sarr::Push(*keys, static_cast<u64>(rng() & ~0xFull));
+		}
+
+		r2::SArray<u64>* array = MAKE_SARRAY(arena, u64, NUM_ITEMS);
+
+		runner.Run("containers/SArray/Push", NUM_ITEMS, [&]() {
+			r2::sarr::Clear(*array);
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				r2::sarr::Push(*array, i);
+			}
+			DoNotOptimize(r2::sarr::Last(*array));
+		});
+
+		r2::sarr::Clear(*array);
+		r2::sarr::Copy(*array, *keys);
+
+		runner.Run("containers/SArray/Iterate", NUM_ITEMS, [&]() {
+			u64 sum = 0;
+			const u64 size = r2::sarr::Size(*array);
+			for (u64 i = 0; i < size; ++i)
+			{
+				sum += r2::sarr::At(*array, i);
+			}
+			DoNotOptimize(sum);
+		});
+
+		r2::SQueue<u64>* queue = MAKE_SQUEUE(arena, u64, NUM_ITEMS);
+
+		runner.Run("containers/SQueue/PushBackPopFront", NUM_ITEMS, [&]() {
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				r2::squeue::PushBack(*queue, i);
+			}
+
+			u64 sum = 0;
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				sum += r2::squeue::First(*queue);
+				r2::squeue::PopFront(*queue);
+			}
+			DoNotOptimize(sum);
+		});
+
+		r2::SHashMap<u64>* hashMap = MAKE_SHASHMAP(arena, u64, NUM_ITEMS * r2::SHashMap<u64>::LoadFactorMultiplier());
+
+		runner.Run("containers/SHashMap/SetRemove", NUM_ITEMS, [&]() {
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				r2::shashmap::Set(*hashMap, r2::sarr::At(*keys, i), i);
+			}
+
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				r2::shashmap::Remove(*hashMap, r2::sarr::At(*keys, i));
+			}
+		});
+
+		for (u64 i = 0; i < NUM_ITEMS; ++i)
+		{
+			r2::shashmap::Set(*hashMap, r2::sarr::At(*keys, i), i);
+		}
+
+		runner.Run("containers/SHashMap/Get", NUM_ITEMS, [&]() {
+			u64 sum = 0;
+			const u64 defaultValue = 0;
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				sum += r2::shashmap::Get(*hashMap, r2::sarr::At(*keys, i), defaultValue);
+			}
+			DoNotOptimize(sum);
+		});
+
+		runner.Run("containers/SHashMap/HasMiss", NUM_ITEMS, [&]() {
+			u64 sum = 0;
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				sum += r2::shashmap::Has(*hashMap, r2::sarr::At(*keys, i) + 1);
+			}
+			DoNotOptimize(sum);
+		});
+
+		r2::SFlatHashMap<u64>* flatHashMap = MAKE_SFLATHASHMAP(arena, u64, NUM_ITEMS);
+
+		runner.Run("containers/SFlatHashMap/SetRemove", NUM_ITEMS, [&]() {
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				r2::sflathashmap::Set(*flatHashMap, r2::sarr::At(*keys, i), i);
+			}
+
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				r2::sflathashmap::Remove(*flatHashMap, r2::sarr::At(*keys, i));
+			}
+		});
+
+		for (u64 i = 0; i < NUM_ITEMS; ++i)
+		{
+			r2::sflathashmap::Set(*flatHashMap, r2::sarr::At(*keys, i), i);
+		}
+
+		runner.Run("containers/SFlatHashMap/Get", NUM_ITEMS, [&]() {
+			u64 sum = 0;
+			const u64 defaultValue = 0;
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				sum += r2::sflathashmap::Get(*flatHashMap, r2::sarr::At(*keys, i), defaultValue);
+			}
+			DoNotOptimize(sum);
+		});
+
+		runner.Run("containers/SFlatHashMap/HasMiss", NUM_ITEMS, [&]() {
+			u64 sum = 0;
+			for (u64 i = 0; i < NUM_ITEMS; ++i)
+			{
+				sum += r2::sflathashmap::Has(*flatHashMap, r2::sarr::At(*keys, i) + 1);
+			}
+			DoNotOptimize(sum);
+		});
+
+		FREE(flatHashMap, arena);
+		FREE(hashMap, arena);
+		FREE(queue, arena);
+		FREE(array, arena);
+		FREE(keys, arena);
+	}
+}
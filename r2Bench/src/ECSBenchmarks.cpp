@@ -0,0 +1,179 @@
+#include "Benchmark.h"
+#include "r2/Core/Containers/SArray.h"
+#include "r2/Core/Containers/SHashMap.h"
+#include "r2/Utils/Hash.h"
+#include "r2/Core/Memory/Allocators/MallocAllocator.h"
+#include "r2/Game/ECSWorld/ECSWorld.h"
+#include "r2/Game/ECS/ECSCoordinator.h"
+#include "r2/Game/ECS/Components/InstanceComponent.h"
+#include "r2/Game/ECS/Components/TransformComponent.h"
+#include "r2/Game/ECS/Components/HierarchyComponent.h"
+#include "r2/Game/Level/Level.h"
+#include "r2/Game/Level/LevelData_generated.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+namespace r2::bench
+{
+	namespace
+	{
+		const u32 NUM_ENTITIES = 10000;
+		const u32 MAX_NUM_COMPONENTS = 8;
+		const u32 MAX_NUM_SYSTEMS = 4;
+
+		ecs::ECSCoordinator* MakeCoordinator(r2::mem::StackArena& arena, r2::mem::MallocArena& componentChunkArena)
+		{
+			ecs::ECSCoordinator* coordinator = ALLOC(ecs::ECSCoordinator, arena);
+
+			coordinator->Init<r2::mem::StackArena>(arena, &componentChunkArena, MAX_NUM_COMPONENTS, NUM_ENTITIES + 1, 1, MAX_NUM_SYSTEMS);
+
+			coordinator->RegisterComponent<r2::mem::StackArena, ecs::HierarchyComponent>(arena, "HeirarchyComponent", true, false, nullptr);
+			coordinator->RegisterComponent<r2::mem::StackArena, ecs::TransformComponent>(arena, "TransformComponent", true, false, nullptr);
+
+			return coordinator;
+		}
+
+		void FreeCoordinator(r2::mem::StackArena& arena, ecs::ECSCoordinator* coordinator)
+		{
+			coordinator->DestoryAllEntities();
+
+			coordinator->UnRegisterComponent<r2::mem::StackArena, ecs::TransformComponent>(arena);
+			coordinator->UnRegisterComponent<r2::mem::StackArena, ecs::HierarchyComponent>(arena);
+
+			coordinator->Shutdown<r2::mem::StackArena>(arena);
+
+			FREE(coordinator, arena);
+		}
+
+		//Every entity has a transform and every other one is parented to the entity made before it, like a scene with a lot of small hierarchies
+		void PopulateScene(ecs::ECSCoordinator& coordinator)
+		{
+			std::mt19937 rng(5);
+			std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+			ecs::Entity lastEntity = ecs::INVALID_ENTITY;
+
+			for (u32 i = 0; i < NUM_ENTITIES; ++i)
+			{
+				ecs::Entity entity = coordinator.CreateEntity();
+
+				ecs::TransformComponent transform;
+				transform.localTransform.position = glm::vec3(distribution(rng), distribution(rng), distribution(rng));
+				transform.accumTransform = transform.localTransform;
+				transform.modelMatrix = glm::mat4(1.0f);
+
+				coordinator.AddComponent<ecs::TransformComponent>(entity, transform);
+
+				if (i % 2)
+				{
+					ecs::HierarchyComponent hierarchy;
+					hierarchy.parent = lastEntity;
+
+					coordinator.AddComponent<ecs::HierarchyComponent>(entity, hierarchy);
+				}
+
+				lastEntity = entity;
+			}
+		}
+	}
+
+	void RunECSBenchmarks(Runner& runner)
+	{
+		r2::mem::StackArena& arena = runner.Arena();
+
+		r2::mem::utils::MemBoundary boundary;
+		r2::mem::MallocArena componentChunkArena(boundary);
+
+		ecs::ECSCoordinator* coordinator = MakeCoordinator(arena, componentChunkArena);
+
+		PopulateScene(*coordinator);
+
+		runner.Run("ecs/ForEach/Transform", NUM_ENTITIES, [&]() {
+			coordinator->ForEach<ecs::TransformComponent>([](ecs::Entity e, ecs::TransformComponent& transform) {
+				transform.modelMatrix = glm::translate(glm::mat4(1.0f), transform.localTransform.position);
+			});
+			DoNotOptimize(static_cast<u64>(coordinator->NumLivingEntities()));
+		});
+
+		runner.Run("ecs/ForEach/TransformHierarchy", NUM_ENTITIES / 2, [&]() {
+			coordinator->ForEach<ecs::TransformComponent, ecs::HierarchyComponent>([](ecs::Entity e, ecs::TransformComponent& transform, ecs::HierarchyComponent& hierarchy) {
+				transform.accumTransform.position = transform.localTransform.position + glm::vec3(static_cast<float>(hierarchy.parent));
+			});
+		});
+
+		runner.Run("ecs/ForEach/TransformOptionalHierarchy", NUM_ENTITIES, [&]() {
+			u64 numParented = 0;
+			coordinator->ForEach<ecs::TransformComponent, ecs::Optional<ecs::HierarchyComponent>>([&numParented](ecs::Entity e, ecs::TransformComponent& transform, ecs::HierarchyComponent* hierarchy) {
+				if (hierarchy)
+				{
+					++numParented;
+				}
+			});
+			DoNotOptimize(numParented);
+		});
+
+		FreeCoordinator(arena, coordinator);
+	}
+
+	void RunLevelLoadBenchmarks(Runner& runner)
+	{
+		r2::mem::StackArena& arena = runner.Arena();
+
+		r2::mem::utils::MemBoundary boundary;
+		r2::mem::MallocArena componentChunkArena(boundary);
+
+		ecs::ECSCoordinator* coordinator = MakeCoordinator(arena, componentChunkArena);
+
+		PopulateScene(*coordinator);
+
+		//Same layout that LevelPackDataUtils writes out for the editor's levels minus the asset references
+		flatbuffers::FlatBufferBuilder builder;
+
+		std::vector<flatbuffers::Offset<flat::EntityData>> entityVec;
+		std::vector<flatbuffers::Offset<flat::ComponentArrayData>> componentDataArray;
+
+		coordinator->SerializeECS(builder, entityVec, componentDataArray);
+
+		auto groupAssetName = flat::CreateAssetName(builder, 0, STRING_ID("bench_group"), builder.CreateString("bench_group"));
+
+		builder.Finish(flat::CreateLevelData(
+			builder,
+			1, 0, groupAssetName,
+			coordinator->NumLivingEntities(),
+			builder.CreateVector(entityVec),
+			builder.CreateVector(componentDataArray)));
+
+		coordinator->DestoryAllEntities();
+
+		const u8* levelDataBuffer = builder.GetBufferPointer();
+		const u64 levelDataSize = builder.GetSize();
+
+		r2::SArray<ecs::Entity>* levelEntities = MAKE_SARRAY(arena, ecs::Entity, NUM_ENTITIES);
+
+		r2::Level level;
+		level.Init(1, "bench_level", "bench_group", {}, nullptr, nullptr, nullptr, levelEntities, r2::LevelRenderSettings{});
+
+		ecs::ECSWorld ecsWorld;
+
+		runner.Run("level/LoadUnloadECSData", NUM_ENTITIES, [&]() {
+			flatbuffers::Verifier verifier(levelDataBuffer, levelDataSize);
+			const bool verified = flat::VerifyLevelDataBuffer(verifier);
+
+			R2_CHECK(verified, "The level data should always be valid");
+
+			const flat::LevelData* levelData = flat::GetLevelData(levelDataBuffer);
+
+			coordinator->LoadAllECSDataFromLevel(ecsWorld, level, levelData);
+			DoNotOptimize(static_cast<u64>(coordinator->NumLivingEntities()));
+
+			coordinator->UnloadAllECSDataFromLevel(level);
+			level.ClearAllEntities();
+		});
+
+		level.Shutdown();
+
+		FREE(levelEntities, arena);
+
+		FreeCoordinator(arena, coordinator);
+	}
+}
@@ -0,0 +1,254 @@
+#include "Benchmark.h"
+#include "r2/Core/Memory/Allocators/StackAllocator.h"
+#include "r2/Core/Containers/SQueue.h"
+#include "r2/Render/Renderer/CommandBucket.h"
+#include "r2/Render/Renderer/RenderKey.h"
+#include "r2/Render/Renderer/Renderer.h"
+#include "r2/Render/Camera/Camera.h"
+#include <random>
+
+namespace r2::bench
+{
+	namespace
+	{
+		//Does nothing when it's submitted so that only the bucket's recording, sorting and walking of the packets is measured
+		struct NullCommand
+		{
+			static const r2::draw::dispatch::BackendDispatchFunction DispatchFunc;
+			u32 value;
+		};
+
+		void NullDispatch(const void* data)
+		{
+			DoNotOptimize(static_cast<u64>(static_cast<const NullCommand*>(data)->value));
+		}
+
+		const r2::draw::dispatch::BackendDispatchFunction NullCommand::DispatchFunc = &NullDispatch;
+
+		void NullKeyDecoder(const r2::draw::key::Basic& key)
+		{
+		}
+
+		const u64 NUM_COMMANDS = 8192;
+		const u32 NUM_SUB_BUCKETS = 4;
+
+		//The synthetic scene - NUM_MODELS models drawn from NUM_MODEL_TYPES different meshes/materials spread out around the camera so some get culled
+		const u32 NUM_MODEL_TYPES = 16;
+		const u32 NUM_MESHES_PER_MODEL = 4;
+		const u32 NUM_MATERIALS_PER_MODEL = 4;
+		const u32 NUM_SHADER_EFFECT_PASSES = 16;
+		const u32 NUM_MODELS = 1024;
+		const u32 MAX_INSTANCES_PER_MODEL = 4;
+		const float SCENE_EXTENTS = 200.0f;
+		const u64 PRE_RENDER_ARENA_SIZE = Megabytes(16);
+	}
+
+	void RunCommandBucketBenchmarks(Runner& runner)
+	{
+		r2::mem::StackArena& arena = runner.Arena();
+
+		r2::SArray<r2::draw::key::Basic>* keys = MAKE_SARRAY(arena, r2::draw::key::Basic, NUM_COMMANDS);
+
+		std::mt19937_64 rng(1234);
+		for (u64 i = 0; i < NUM_COMMANDS; ++i)
+		{
+			r2::draw::key::Basic key;
+			key.keyValue = rng() | 1ull;
+			r2::sarr::Push(*keys, key);
+		}
+
+		r2::mem::StackArena* commandArena = MAKE_STACK_ARENA(arena, NUM_COMMANDS * r2::draw::cmdpkt::GetSize<NullCommand>(0) * 2 + Kilobytes(64));
+		r2::draw::CommandBucket<r2::draw::key::Basic>* bucket = MAKE_CMD_BUCKET(arena, r2::draw::key::Basic, NullKeyDecoder, NUM_COMMANDS);
+		r2::draw::CommandBucket<r2::draw::key::Basic>* parallelBucket = MAKE_PARALLEL_CMD_BUCKET(arena, r2::draw::key::Basic, NullKeyDecoder, NUM_COMMANDS, NUM_SUB_BUCKETS, NUM_COMMANDS / NUM_SUB_BUCKETS);
+
+		runner.Run("commandbucket/RecordSortSubmit", NUM_COMMANDS, [&]() {
+			for (u64 i = 0; i < NUM_COMMANDS; ++i)
+			{
+				NullCommand* cmd = r2::draw::cmdbkt::AddCommand<r2::draw::key::Basic, r2::mem::StackArena, NullCommand>(*commandArena, *bucket, r2::sarr::At(*keys, i), 0);
+				cmd->value = static_cast<u32>(i);
+			}
+
+			r2::draw::cmdbkt::Sort(*bucket);
+			r2::draw::cmdbkt::Submit(*bucket);
+			r2::draw::cmdbkt::ClearAll(*bucket);
+
+			RESET_ARENA(*commandArena);
+		});
+
+		runner.Run("commandbucket/RecordSortSubmitSubBuckets", NUM_COMMANDS, [&]() {
+			for (u64 i = 0; i < NUM_COMMANDS; ++i)
+			{
+				NullCommand* cmd = r2::draw::cmdbkt::AddCommand<r2::draw::key::Basic, r2::mem::StackArena, NullCommand>(*commandArena, *parallelBucket, static_cast<u32>(i % NUM_SUB_BUCKETS), r2::sarr::At(*keys, i), 0);
+				cmd->value = static_cast<u32>(i);
+			}
+
+			r2::draw::cmdbkt::Sort(*parallelBucket);
+			r2::draw::cmdbkt::Submit(*parallelBucket);
+			r2::draw::cmdbkt::ClearAll(*parallelBucket);
+
+			RESET_ARENA(*commandArena);
+		});
+
+		for (u64 i = 0; i < NUM_COMMANDS; ++i)
+		{
+			r2::draw::cmdbkt::AddCommand<r2::draw::key::Basic, r2::mem::StackArena, NullCommand>(*commandArena, *bucket, r2::sarr::At(*keys, i), 0)->value = static_cast<u32>(i);
+		}
+
+		runner.Run("commandbucket/Sort", NUM_COMMANDS, [&]() {
+			r2::draw::cmdbkt::Sort(*bucket);
+		});
+
+		runner.Run("commandbucket/Submit", NUM_COMMANDS, [&]() {
+			r2::draw::cmdbkt::Submit(*bucket);
+		});
+
+		r2::draw::cmdbkt::ClearAll(*bucket);
+		RESET_ARENA(*commandArena);
+
+		FREE_CMD_BUCKET(arena, r2::draw::key::Basic, parallelBucket);
+		FREE_CMD_BUCKET(arena, r2::draw::key::Basic, bucket);
+		FREE(commandArena, arena);
+		FREE(keys, arena);
+	}
+
+	void RunRenderBatchBenchmarks(Runner& runner)
+	{
+		r2::mem::StackArena& arena = runner.Arena();
+
+		r2::Camera* camera = ALLOC(r2::Camera, arena);
+		r2::cam::InitPerspectiveCam(*camera, 70.0f, 16.0f / 9.0f, 0.1f, SCENE_EXTENTS, glm::vec3(0.0f, -SCENE_EXTENTS * 0.5f, 10.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		r2::draw::SceneLighting* sceneLighting = ALLOC(r2::draw::SceneLighting, arena);
+
+		r2::draw::Renderer* renderer = ALLOC(r2::draw::Renderer, arena);
+		renderer->mnoptrRenderCam = camera;
+		renderer->mResolutionSize.width = 1920;
+		renderer->mResolutionSize.height = 1080;
+		renderer->mPreRenderStackArena = MAKE_STACK_ARENA(arena, PRE_RENDER_ARENA_SIZE);
+		renderer->mPrePostRenderCommandArena = MAKE_STACK_ARENA(arena, PRE_RENDER_ARENA_SIZE);
+
+		//The model types - each one has its own meshes with unit bounds
+		r2::SArray<r2::draw::vb::GPUModelRef>* modelRefs = MAKE_SARRAY(arena, r2::draw::vb::GPUModelRef, NUM_MODEL_TYPES);
+
+		for (u32 i = 0; i < NUM_MODEL_TYPES; ++i)
+		{
+			r2::draw::vb::GPUModelRef modelRef = {};
+			modelRef.gpuModelRefHandle = i + 1;
+			modelRef.meshEntries = MAKE_SARRAY(arena, r2::draw::vb::MeshEntry, NUM_MESHES_PER_MODEL);
+			modelRef.numMaterials = NUM_MATERIALS_PER_MODEL;
+			modelRef.numGLTFMeshes = NUM_MESHES_PER_MODEL;
+
+			for (u32 j = 0; j < NUM_MESHES_PER_MODEL; ++j)
+			{
+				r2::draw::vb::MeshEntry meshEntry = {};
+				meshEntry.gpuVertexEntry.start = (i * NUM_MESHES_PER_MODEL + j) * 1024;
+				meshEntry.gpuVertexEntry.size = 1024;
+				meshEntry.gpuIndexEntry.start = (i * NUM_MESHES_PER_MODEL + j) * 3072;
+				meshEntry.gpuIndexEntry.size = 3072;
+				meshEntry.materialIndex = j % NUM_MATERIALS_PER_MODEL;
+				meshEntry.meshBounds.origin = glm::vec3(0.0f);
+				meshEntry.meshBounds.extents = glm::vec3(1.0f);
+				meshEntry.meshBounds.radius = 1.0f;
+
+				//a synthetic LOD chain that halves the index count each level so SelectMeshLOD has something to pick from
+				meshEntry.numLODs = r2::draw::Mesh::MAX_NUM_LODS;
+				for (u32 lod = 0; lod < meshEntry.numLODs; ++lod)
+				{
+					meshEntry.lods[lod].firstIndex = 0;
+					meshEntry.lods[lod].numIndices = meshEntry.gpuIndexEntry.size >> lod;
+					meshEntry.lods[lod].error = lod == 0 ? 0.0f : 0.01f * static_cast<float>(1 << lod);
+				}
+
+				r2::sarr::Push(*modelRef.meshEntries, meshEntry);
+			}
+
+			r2::sarr::Push(*modelRefs, modelRef);
+		}
+
+		r2::draw::RenderBatch renderBatch;
+		renderBatch.gpuModelRefs = MAKE_SARRAY(arena, const r2::draw::vb::GPUModelRef*, NUM_MODELS);
+		renderBatch.drawState = MAKE_SARRAY(arena, r2::draw::cmd::DrawState, NUM_MODELS);
+		renderBatch.numInstances = MAKE_SARRAY(arena, u32, NUM_MODELS);
+		renderBatch.models = MAKE_SARRAY(arena, glm::mat4, NUM_MODELS * MAX_INSTANCES_PER_MODEL);
+		renderBatch.materialBatch.infos = MAKE_SARRAY(arena, r2::draw::MaterialBatch::Info, NUM_MODELS);
+		renderBatch.materialBatch.shaderEffectPasses = MAKE_SARRAY(arena, r2::draw::ShaderEffectPasses, NUM_SHADER_EFFECT_PASSES);
+#ifdef R2_EDITOR
+		renderBatch.entityIDs = MAKE_SARRAY(arena, u32, 1);
+#endif
+
+		for (u32 i = 0; i < NUM_SHADER_EFFECT_PASSES; ++i)
+		{
+			r2::draw::ShaderEffectPasses shaderEffectPasses;
+			shaderEffectPasses.meshPasses[flat::eMeshPass_FORWARD].staticShaderHandle = i + 1;
+			shaderEffectPasses.meshPasses[flat::eMeshPass_DEPTH].staticShaderHandle = NUM_SHADER_EFFECT_PASSES + 1;
+			r2::sarr::Push(*renderBatch.materialBatch.shaderEffectPasses, shaderEffectPasses);
+		}
+
+		std::mt19937 rng(99);
+		std::uniform_real_distribution<float> positionDistribution(-SCENE_EXTENTS, SCENE_EXTENTS);
+		std::uniform_int_distribution<u32> instanceDistribution(1, MAX_INSTANCES_PER_MODEL);
+
+		u32 numInstances = 0;
+
+		for (u32 i = 0; i < NUM_MODELS; ++i)
+		{
+			r2::sarr::Push(*renderBatch.gpuModelRefs, static_cast<const r2::draw::vb::GPUModelRef*>(&r2::sarr::At(*modelRefs, i % NUM_MODEL_TYPES)));
+
+			r2::draw::cmd::DrawState drawState = {};
+			drawState.layer = r2::draw::DL_WORLD;
+			drawState.depthEnabled = true;
+			drawState.depthWriteEnabled = true;
+			r2::sarr::Push(*renderBatch.drawState, drawState);
+
+			const u32 numModelInstances = instanceDistribution(rng);
+			r2::sarr::Push(*renderBatch.numInstances, numModelInstances);
+
+			r2::draw::MaterialBatch::Info info;
+			info.start = (i % (NUM_SHADER_EFFECT_PASSES / NUM_MATERIALS_PER_MODEL)) * NUM_MATERIALS_PER_MODEL;
+			info.numMaterials = NUM_MATERIALS_PER_MODEL;
+			r2::sarr::Push(*renderBatch.materialBatch.infos, info);
+
+			numInstances += numModelInstances;
+		}
+
+		for (u32 i = 0; i < numInstances; ++i)
+		{
+			const glm::vec3 position(positionDistribution(rng), positionDistribution(rng), positionDistribution(rng) * 0.1f);
+			r2::sarr::Push(*renderBatch.models, glm::translate(glm::mat4(1.0f), position));
+		}
+
+		renderer->mCPUCullingEnabled = true;
+
+		runner.Run("renderer/PopulateRenderData/Culled", NUM_MODELS, [&]() {
+			DoNotOptimize(static_cast<u64>(r2::draw::renderer::PopulateRenderData(*renderer, renderBatch, *sceneLighting)));
+		});
+
+		renderer->mCPUCullingEnabled = false;
+
+		runner.Run("renderer/PopulateRenderData/NoCulling", NUM_MODELS, [&]() {
+			DoNotOptimize(static_cast<u64>(r2::draw::renderer::PopulateRenderData(*renderer, renderBatch, *sceneLighting)));
+		});
+
+#ifdef R2_EDITOR
+		FREE(renderBatch.entityIDs, arena);
+#endif
+		FREE(renderBatch.materialBatch.shaderEffectPasses, arena);
+		FREE(renderBatch.materialBatch.infos, arena);
+		FREE(renderBatch.models, arena);
+		FREE(renderBatch.numInstances, arena);
+		FREE(renderBatch.drawState, arena);
+		FREE(renderBatch.gpuModelRefs, arena);
+
+		for (s32 i = NUM_MODEL_TYPES - 1; i >= 0; --i)
+		{
+			FREE(r2::sarr::At(*modelRefs, i).meshEntries, arena);
+		}
+
+		FREE(modelRefs, arena);
+		FREE(renderer->mPrePostRenderCommandArena, arena);
+		FREE(renderer->mPreRenderStackArena, arena);
+		FREE(renderer, arena);
+		FREE(sceneLighting, arena);
+		FREE(camera, arena);
+	}
+}
@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+#include "r2/Core/Memory/InternalEngineMemory.h"
+#include "cmdln/CommandLine.h"
+
+namespace
+{
+	struct Arguments
+	{
+		bool help = false;
+		std::string jsonPath;
+		std::string filter;
+		std::string baselinePath;
+		uint32_t numSamples = 15;
+		double minSampleMs = 5.0;
+		double threshold = 10.0;
+	};
+
+	const u64 ENGINE_MEMORY_SIZE = Megabytes(32);
+	const u64 PERMANENT_STORAGE_SIZE = Megabytes(4);
+	const u64 SINGLE_FRAME_STORAGE_SIZE = Megabytes(64);
+	const u64 BENCH_MEMORY_SIZE = Megabytes(512);
+}
+
+int main(int argc, char* argv[])
+{
+	Arguments arguments;
+	r2::cmdln::CommandLine args("r2Bench times the engine's containers, allocators and hot paths. Compare runs with --json and --baseline");
+
+	args.AddArgument({ "-h", "--help" }, &arguments.help, "Show help");
+	args.AddArgument({ "-j", "--json" }, &arguments.jsonPath, "Write the results as JSON to this file");
+	args.AddArgument({ "-f", "--filter" }, &arguments.filter, "Only run the benchmarks with this in their name");
+	args.AddArgument({ "-b", "--baseline" }, &arguments.baselinePath, "A JSON file from a previous run to compare against. Returns 1 if anything regressed");
+	args.AddArgument({ "-t", "--threshold" }, &arguments.threshold, "How much slower (in percent) the median can get before it counts as a regression. The default is 10");
+	args.AddArgument({ "-s", "--samples" }, &arguments.numSamples, "The number of samples to take of each benchmark. The default is 15");
+	args.AddArgument({ "-m", "--minSampleMs" }, &arguments.minSampleMs, "The minimum length of a sample in milliseconds. The default is 5");
+	args.Parse(argc, argv);
+
+	if (arguments.help)
+	{
+		args.PrintHelp();
+		return 0;
+	}
+
+	//The engine memory gives MEM_ENG_SCRATCH_PTR a single frame arena like it has in the engine
+	r2::mem::GlobalMemory::Init(2, ENGINE_MEMORY_SIZE, PERMANENT_STORAGE_SIZE, SINGLE_FRAME_STORAGE_SIZE);
+
+	auto benchAreaHandle = r2::mem::GlobalMemory::AddMemoryArea("BenchArea");
+	R2_CHECK(benchAreaHandle != r2::mem::MemoryArea::Invalid, "Failed to add the bench memory area");
+
+	r2::mem::MemoryArea* benchMemoryArea = r2::mem::GlobalMemory::GetMemoryArea(benchAreaHandle);
+	benchMemoryArea->Init(BENCH_MEMORY_SIZE, 0);
+
+	auto subAreaHandle = benchMemoryArea->AddSubArea(BENCH_MEMORY_SIZE);
+	R2_CHECK(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid, "Failed to add the bench sub area");
+
+	r2::mem::StackArena* benchArena = EMPLACE_STACK_ARENA(*benchMemoryArea->GetSubArea(subAreaHandle));
+
+	r2::bench::Config config;
+	config.numSamples = arguments.numSamples;
+	config.minSampleMs = arguments.minSampleMs;
+	config.filter = arguments.filter;
+
+	r2::bench::Runner runner(config, *benchArena);
+
+	printf("%-56s %17s %17s %11s %24s\n", "Benchmark", "Median", "Min", "StdDev", "Throughput");
+
+	r2::bench::RunContainerBenchmarks(runner);
+	r2::bench::RunAllocatorBenchmarks(runner);
+	r2::bench::RunCommandBucketBenchmarks(runner);
+	r2::bench::RunRenderBatchBenchmarks(runner);
+	r2::bench::RunAnimationBenchmarks(runner);
+	r2::bench::RunECSBenchmarks(runner);
+	r2::bench::RunLevelLoadBenchmarks(runner);
+
+	int result = 0;
+
+	if (!arguments.jsonPath.empty() && !r2::bench::WriteJSON(arguments.jsonPath.c_str(), config, runner.Results()))
+	{
+		result = 1;
+	}
+
+	if (!arguments.baselinePath.empty())
+	{
+		std::vector<r2::bench::Result> baseline;
+
+		if (!r2::bench::ReadBaseline(arguments.baselinePath.c_str(), baseline))
+		{
+			result = 1;
+		}
+		else if (r2::bench::CompareToBaseline(runner.Results(), baseline, arguments.threshold) > 0)
+		{
+			result = 1;
+		}
+	}
+
+	FREE_EMPLACED_ARENA(benchArena);
+
+	r2::mem::GlobalMemory::Shutdown();
+
+	return result;
+}
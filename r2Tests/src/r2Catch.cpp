@@ -17,8 +17,28 @@
 #include "r2/Core/Containers/SArray.h"
 #include "r2/Core/Containers/SQueue.h"
 #include "r2/Core/Containers/SHashMap.h"
+#include "r2/Core/Containers/SFlatHashMap.h"
 #include "r2/Core/File/PathUtils.h"
+#include "r2/Core/Math/DynamicAABBTree.h"
+#include "r2/Core/Math/Transform.h"
+#include "r2/Render/Renderer/CommandBucket.h"
+#include "r2/Render/Renderer/RenderKey.h"
+#include "r2/Render/Model/Light.h"
+#include "r2/Render/Animation/AnimationClip.h"
+#include "r2/Render/Animation/AnimationBatch.h"
+#include "r2/Render/Animation/TransformTrack.h"
+#include "r2/Render/Animation/Pose.h"
+#include "assetlib/MeshOptimize.h"
+#include "assetlib/AnimationCompression.h"
+#include <algorithm>
 #include <cstring>
+#include <thread>
+#include <atomic>
+#include <set>
+#include <unordered_map>
+#include <random>
+#include <array>
+#include <glm/gtc/constants.hpp>
 
 TEST_CASE("TEST GLOBAL MEMORY")
 {
@@ -564,6 +584,242 @@ TEST_CASE("Test Pool Memory Arena No Checking")
 }
 
 
+TEST_CASE("Test Pool Allocator Multithreaded")
+{
+    r2::mem::GlobalMemory::Init(1);
+    SECTION("Test Pool Allocator Concurrent Allocate and Free")
+    {
+        auto testAreaHandle = r2::mem::GlobalMemory::AddMemoryArea("TestArea");
+        
+        REQUIRE(testAreaHandle != r2::mem::MemoryArea::Invalid);
+        
+        r2::mem::MemoryArea* testMemoryArea = r2::mem::GlobalMemory::GetMemoryArea(testAreaHandle);
+        
+        REQUIRE(testMemoryArea != nullptr);
+        
+        auto result = testMemoryArea->Init(Megabytes(1));
+        
+        REQUIRE(result);
+        
+        auto subAreaHandle = testMemoryArea->AddSubArea(Kilobytes(64));
+        
+        REQUIRE(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid);
+        
+        r2::mem::utils::MemBoundary poolBoundary = testMemoryArea->SubAreaBoundary(subAreaHandle);
+        
+        poolBoundary.elementSize = 64;
+        poolBoundary.offset = 0;
+        poolBoundary.alignment = alignof(u64);
+        
+        r2::mem::PoolAllocator poolAllocator(poolBoundary);
+        
+        const u64 TOTAL_NUM_ELEMENTS = poolAllocator.TotalElements();
+        const u32 NUM_THREADS = 4;
+        const u32 NUM_ITERATIONS = 2000;
+        const u64 ELEMENTS_PER_THREAD = TOTAL_NUM_ELEMENTS / NUM_THREADS;
+        
+        std::vector<std::vector<void*>> threadElements(NUM_THREADS);
+        std::vector<std::thread> threads;
+        std::atomic<bool> corrupted{ false };
+        
+        //Each thread keeps taking and giving back elements and writes its index into the ones it owns so we can see if two threads ever get the same one
+        for (u32 t = 0; t < NUM_THREADS; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                std::vector<void*>& elements = threadElements[t];
+                elements.reserve(ELEMENTS_PER_THREAD);
+                
+                for (u32 i = 0; i < NUM_ITERATIONS; ++i)
+                {
+                    while (elements.size() < ELEMENTS_PER_THREAD)
+                    {
+                        void* pointer = poolAllocator.Allocate(poolBoundary.elementSize, poolBoundary.alignment, poolBoundary.offset);
+                        if (pointer == nullptr)
+                        {
+                            break;
+                        }
+                        
+                        memset(pointer, static_cast<int>(t), poolBoundary.elementSize);
+                        elements.push_back(pointer);
+                    }
+                    
+                    for (void* pointer : elements)
+                    {
+                        const u8* bytes = static_cast<const u8*>(pointer);
+                        for (u64 b = 0; b < poolBoundary.elementSize; ++b)
+                        {
+                            if (bytes[b] != t)
+                            {
+                                corrupted.store(true);
+                                return;
+                            }
+                        }
+                    }
+                    
+                    const size_t numToFree = elements.size() / 2;
+                    for (size_t j = 0; j < numToFree; ++j)
+                    {
+                        poolAllocator.Free(elements.back());
+                        elements.pop_back();
+                    }
+                }
+            });
+        }
+        
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        
+        REQUIRE_FALSE(corrupted.load());
+        
+        std::set<void*> uniqueElements;
+        u64 numElements = 0;
+        
+        for (u32 t = 0; t < NUM_THREADS; ++t)
+        {
+            for (void* pointer : threadElements[t])
+            {
+                const u8* bytes = static_cast<const u8*>(pointer);
+                REQUIRE(bytes[0] == t);
+                REQUIRE(bytes[poolBoundary.elementSize - 1] == t);
+                uniqueElements.insert(pointer);
+                ++numElements;
+            }
+        }
+        
+        REQUIRE(uniqueElements.size() == numElements);
+        REQUIRE(poolAllocator.NumElementsAllocated() == numElements);
+        
+        for (u32 t = 0; t < NUM_THREADS; ++t)
+        {
+            for (void* pointer : threadElements[t])
+            {
+                poolAllocator.Free(pointer);
+            }
+        }
+        
+        REQUIRE(poolAllocator.NumElementsAllocated() == 0);
+        
+        //Everything should be back in the free list
+        for (u64 i = 0; i < TOTAL_NUM_ELEMENTS; ++i)
+        {
+            REQUIRE(poolAllocator.Allocate(poolBoundary.elementSize, poolBoundary.alignment, poolBoundary.offset) != nullptr);
+        }
+        
+        REQUIRE(poolAllocator.Allocate(poolBoundary.elementSize, poolBoundary.alignment, poolBoundary.offset) == nullptr);
+        
+        poolAllocator.Reset();
+        
+        REQUIRE(poolAllocator.NumElementsAllocated() == 0);
+    }
+    r2::mem::GlobalMemory::Shutdown();
+}
+
+TEST_CASE("Test Thread Policies")
+{
+    r2::mem::GlobalMemory::Init(1);
+    SECTION("Test Mutex and Spin Lock Policies")
+    {
+        const u32 NUM_THREADS = 4;
+        const u32 NUM_ITERATIONS = 10000;
+        
+        r2::mem::MutexThreadPolicy mutexPolicy;
+        r2::mem::SpinLockThreadPolicy spinLockPolicy;
+        u64 mutexCounter = 0;
+        u64 spinLockCounter = 0;
+        
+        std::vector<std::thread> threads;
+        
+        for (u32 t = 0; t < NUM_THREADS; ++t)
+        {
+            threads.emplace_back([&]()
+            {
+                for (u32 i = 0; i < NUM_ITERATIONS; ++i)
+                {
+                    mutexPolicy.Enter();
+                    ++mutexCounter;
+                    mutexPolicy.Leave();
+                    
+                    spinLockPolicy.Enter();
+                    ++spinLockCounter;
+                    spinLockPolicy.Leave();
+                }
+            });
+        }
+        
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        
+        REQUIRE(mutexCounter == NUM_THREADS * NUM_ITERATIONS);
+        REQUIRE(spinLockCounter == NUM_THREADS * NUM_ITERATIONS);
+    }
+    
+    SECTION("Test Multithreaded Linear Arena")
+    {
+        auto testAreaHandle = r2::mem::GlobalMemory::AddMemoryArea("TestArea");
+        
+        REQUIRE(testAreaHandle != r2::mem::MemoryArea::Invalid);
+        
+        r2::mem::MemoryArea* testMemoryArea = r2::mem::GlobalMemory::GetMemoryArea(testAreaHandle);
+        
+        REQUIRE(testMemoryArea != nullptr);
+        
+        auto result = testMemoryArea->Init(Megabytes(1));
+        
+        REQUIRE(result);
+        
+        auto subAreaHandle = testMemoryArea->AddSubArea(Megabytes(1));
+        
+        REQUIRE(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid);
+        
+        r2::mem::MTLinearArena linearArena(*testMemoryArea->GetSubArea(subAreaHandle));
+        
+        const u32 NUM_THREADS = 4;
+        const u32 NUM_ALLOCATIONS = 256;
+        
+        std::vector<std::vector<u64*>> threadAllocations(NUM_THREADS);
+        std::vector<std::thread> threads;
+        
+        for (u32 t = 0; t < NUM_THREADS; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (u32 i = 0; i < NUM_ALLOCATIONS; ++i)
+                {
+                    u64* value = ALLOC(u64, linearArena);
+                    *value = static_cast<u64>(t) * NUM_ALLOCATIONS + i;
+                    threadAllocations[t].push_back(value);
+                }
+            });
+        }
+        
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        
+        std::set<u64*> uniqueAllocations;
+        
+        for (u32 t = 0; t < NUM_THREADS; ++t)
+        {
+            for (u32 i = 0; i < NUM_ALLOCATIONS; ++i)
+            {
+                REQUIRE(*threadAllocations[t][i] == static_cast<u64>(t) * NUM_ALLOCATIONS + i);
+                uniqueAllocations.insert(threadAllocations[t][i]);
+            }
+        }
+        
+        REQUIRE(uniqueAllocations.size() == NUM_THREADS * NUM_ALLOCATIONS);
+        
+        RESET_ARENA(linearArena);
+    }
+    r2::mem::GlobalMemory::Shutdown();
+}
+
 TEST_CASE("Test Malloc Allocator")
 {
     SECTION("Test Malloc Allocator")
@@ -750,6 +1006,11 @@ TEST_CASE("Test Free List")
         
         REQUIRE(tooBigOfAnAllocation == nullptr);
         
+        //Half of the memory is free but it's all in small blocks
+        REQUIRE(freeListAllocator.LargestFreeBlockSize() < Kilobytes(2) + overhead);
+        REQUIRE(freeListAllocator.FreeBlockSizeAfterFree(pointers[0]) == 2 * (Kilobytes(1) + overhead));
+        REQUIRE(freeListAllocator.FreeBlockSizeAfterFree(pointers[2]) == 3 * (Kilobytes(1) + overhead));
+        
         REQUIRE(pointers[0] != nullptr);
         freeListAllocator.Free(pointers[0]);
         
@@ -791,6 +1052,7 @@ TEST_CASE("Test Free List")
         
         REQUIRE(freeListAllocator.GetTotalBytesAllocated() == 0);
         REQUIRE(freeListAllocator.UnallocatedBytes() == Megabytes(1));
+        REQUIRE(freeListAllocator.LargestFreeBlockSize() == Megabytes(1));
     }
     
     r2::mem::GlobalMemory::Shutdown();
@@ -1321,6 +1583,216 @@ TEST_CASE("Test SHashMap")
     r2::mem::GlobalMemory::Shutdown();
 }
 
+TEST_CASE("Test SFlatHashMap")
+{
+    r2::mem::GlobalMemory::Init(1);
+    
+    auto testAreaHandle = r2::mem::GlobalMemory::AddMemoryArea("TestArea");
+    REQUIRE(testAreaHandle != r2::mem::MemoryArea::Invalid);
+    r2::mem::MemoryArea* testMemoryArea = r2::mem::GlobalMemory::GetMemoryArea(testAreaHandle);
+    REQUIRE(testMemoryArea != nullptr);
+    auto result = testMemoryArea->Init(Megabytes(1));
+    REQUIRE(result);
+    auto subAreaHandle = testMemoryArea->AddSubArea(Megabytes(1));
+    REQUIRE(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid);
+    
+    SECTION("Test sflathashmap functionality")
+    {
+        r2::mem::StackArena stackArena(*testMemoryArea->GetSubArea(subAreaHandle));
+        r2::SFlatHashMap<char>* hashMap = MAKE_SFLATHASHMAP(stackArena, char, 128);
+        
+        REQUIRE(hashMap != nullptr);
+        
+        const u64 key = 88;
+        const char& defaultChar = '~';
+        
+        REQUIRE(!r2::sflathashmap::Has(*hashMap, key));
+        REQUIRE(r2::sflathashmap::Get(*hashMap, key, defaultChar) == defaultChar);
+        
+        r2::sflathashmap::Set(*hashMap, key, 'c');
+        
+        REQUIRE(r2::sflathashmap::Has(*hashMap, key));
+        REQUIRE(r2::sflathashmap::Get(*hashMap, key, defaultChar) == 'c');
+        
+        r2::sflathashmap::Set(*hashMap, key, 'd');
+        
+        REQUIRE(r2::sflathashmap::Size(*hashMap) == 1);
+        REQUIRE(r2::sflathashmap::Get(*hashMap, key, defaultChar) == 'd');
+        
+        r2::sflathashmap::Remove(*hashMap, key);
+        
+        REQUIRE(!r2::sflathashmap::Has(*hashMap, key));
+        REQUIRE(r2::sflathashmap::Size(*hashMap) == 0);
+        
+        //keys that all land in the same slots with plain modulo
+        for (u64 i = 0; i < 128; ++i)
+        {
+            r2::sflathashmap::Set(*hashMap, i << 32, (char)i);
+        }
+        
+        REQUIRE(r2::sflathashmap::IsFull(*hashMap));
+        
+        for (u64 i = 0; i < 128; i += 2)
+        {
+            r2::sflathashmap::Remove(*hashMap, i << 32);
+        }
+        
+        for (u64 i = 0; i < 128; ++i)
+        {
+            const bool shouldHave = (i % 2) == 1;
+            REQUIRE(r2::sflathashmap::Has(*hashMap, i << 32) == shouldHave);
+            REQUIRE(r2::sflathashmap::Get(*hashMap, i << 32, defaultChar) == (shouldHave ? (char)i : defaultChar));
+        }
+        
+        u64 numEntries = 0;
+        for (auto iter = r2::sflathashmap::Begin(*hashMap); iter != r2::sflathashmap::End(*hashMap); ++iter)
+        {
+            REQUIRE(iter->value == (char)(iter->key >> 32));
+            ++numEntries;
+        }
+        
+        REQUIRE(numEntries == 64);
+        
+        r2::sflathashmap::Clear(*hashMap);
+        
+        REQUIRE(r2::sflathashmap::Size(*hashMap) == 0);
+        REQUIRE(!r2::sflathashmap::Has(*hashMap, 1ull << 32));
+        
+        FREE(hashMap, stackArena);
+    }
+    
+    SECTION("Test sflathashmap random operations")
+    {
+        r2::mem::StackArena stackArena(*testMemoryArea->GetSubArea(subAreaHandle));
+        
+        const u64 capacity = 1000;
+        r2::SFlatHashMap<s32>* hashMap = MAKE_SFLATHASHMAP(stackArena, s32, capacity);
+        
+        REQUIRE(hashMap != nullptr);
+        
+        std::unordered_map<u64, s32> expected;
+        std::mt19937_64 rng(1234);
+        
+        for (s32 i = 0; i < 100000; ++i)
+        {
+            const u64 key = rng() % (capacity * 2);
+            const u64 op = rng() % 3;
+            
+            if (op == 0 && expected.size() < capacity)
+            {
+                r2::sflathashmap::Set(*hashMap, key, i);
+                expected[key] = i;
+            }
+            else if (op == 1)
+            {
+                r2::sflathashmap::Remove(*hashMap, key);
+                expected.erase(key);
+            }
+            else
+            {
+                auto iter = expected.find(key);
+                const s32 expectedValue = iter == expected.end() ? -1 : iter->second;
+                REQUIRE(r2::sflathashmap::Get(*hashMap, key, -1) == expectedValue);
+            }
+            
+            REQUIRE(r2::sflathashmap::Size(*hashMap) == expected.size());
+        }
+        
+        FREE(hashMap, stackArena);
+    }
+    
+    r2::mem::GlobalMemory::Shutdown();
+}
+
+//Run with the [benchmark] tag to compare against SHashMap
+TEST_CASE("Benchmark SFlatHashMap vs SHashMap", "[.][benchmark]")
+{
+    r2::mem::GlobalMemory::Init(1);
+    
+    auto testAreaHandle = r2::mem::GlobalMemory::AddMemoryArea("TestArea");
+    REQUIRE(testAreaHandle != r2::mem::MemoryArea::Invalid);
+    r2::mem::MemoryArea* testMemoryArea = r2::mem::GlobalMemory::GetMemoryArea(testAreaHandle);
+    REQUIRE(testMemoryArea != nullptr);
+    auto result = testMemoryArea->Init(Megabytes(8));
+    REQUIRE(result);
+    auto subAreaHandle = testMemoryArea->AddSubArea(Megabytes(8));
+    REQUIRE(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid);
+    
+    r2::mem::StackArena stackArena(*testMemoryArea->GetSubArea(subAreaHandle));
+    
+    const u64 NUM_KEYS = 50000;
+    
+    //asset names are already hashes so use random 64 bit keys with the low bits cleared like aligned pointers/ids
+    std::vector<u64> keys(NUM_KEYS);
+    std::mt19937_64 rng(42);
+    for (u64& key : keys)
+    {
+        key = rng() & ~0xFFFull;
+    }
+    
+    r2::SHashMap<u64>* chainedMap = MAKE_SHASHMAP(stackArena, u64, NUM_KEYS * r2::SHashMap<u64>::LoadFactorMultiplier());
+    r2::SFlatHashMap<u64>* flatMap = MAKE_SFLATHASHMAP(stackArena, u64, NUM_KEYS);
+    
+    REQUIRE(chainedMap != nullptr);
+    REQUIRE(flatMap != nullptr);
+    
+    u64 sum = 0;
+    u64 defaultValue = 0;
+    
+    BENCHMARK("SHashMap insert, lookup and remove")
+    {
+        for (u64 key : keys)
+        {
+            r2::shashmap::Set(*chainedMap, key, key);
+        }
+        
+        for (u64 key : keys)
+        {
+            sum += r2::shashmap::Get(*chainedMap, key, defaultValue);
+        }
+        
+        for (u64 key : keys)
+        {
+            sum += r2::shashmap::Has(*chainedMap, key + 1);
+        }
+        
+        for (u64 key : keys)
+        {
+            r2::shashmap::Remove(*chainedMap, key);
+        }
+    }
+    
+    BENCHMARK("SFlatHashMap insert, lookup and remove")
+    {
+        for (u64 key : keys)
+        {
+            r2::sflathashmap::Set(*flatMap, key, key);
+        }
+        
+        for (u64 key : keys)
+        {
+            sum += r2::sflathashmap::Get(*flatMap, key, defaultValue);
+        }
+        
+        for (u64 key : keys)
+        {
+            sum += r2::sflathashmap::Has(*flatMap, key + 1);
+        }
+        
+        for (u64 key : keys)
+        {
+            r2::sflathashmap::Remove(*flatMap, key);
+        }
+    }
+    
+    REQUIRE(sum != 0);
+    
+    FREE(flatMap, stackArena);
+    FREE(chainedMap, stackArena);
+    
+    r2::mem::GlobalMemory::Shutdown();
+}
+
 TEST_CASE("Test Ring Buffer")
 {
     r2::mem::GlobalMemory::Init(1);
@@ -1587,3 +2059,1385 @@ TEST_CASE("Path Utils")
         REQUIRE(strcmp(tempBuf, "/subpath1/subpath2/subpath3") == 0);
     }
 }
+
+//Fills the main bucket and a few sub buckets with duplicate keys and checks the radix sort matches std::stable_sort on the gathered order
+template<typename T, class ARENA, typename KeyValueGenerator>
+void TestCommandBucketRadixSort(ARENA& arena, KeyValueGenerator generateKeyValue)
+{
+    using KeyValueType = decltype(T::keyValue);
+    using Entry = typename r2::draw::CommandBucket<T>::Entry;
+    
+    const u64 CAPACITY = 1000;
+    const u32 NUM_SUB_BUCKETS = 4;
+    const u64 SUB_BUCKET_CAPACITY = 500;
+    const u64 NUM_ENTRIES_PER_BUCKET[NUM_SUB_BUCKETS + 1] = {700, 500, 123, 0, 377};
+    
+    r2::draw::CommandBucket<T>* bucket = MAKE_PARALLEL_CMD_BUCKET(arena, T, nullptr, CAPACITY, NUM_SUB_BUCKETS, SUB_BUCKET_CAPACITY);
+    
+    REQUIRE(bucket != nullptr);
+    
+    std::mt19937_64 rng(4321);
+    
+    //only a few distinct key values so there are lots of duplicates spread across the buckets
+    std::vector<KeyValueType> keyValues(64);
+    for (KeyValueType& keyValue : keyValues)
+    {
+        keyValue = generateKeyValue(rng);
+    }
+    
+    //the data pointer is just a tag of the order the entries get gathered in (main bucket first, then each sub bucket)
+    std::vector<std::pair<KeyValueType, void*>> expected;
+    u64 tag = 1;
+    
+    for (u32 bucketIndex = 0; bucketIndex <= NUM_SUB_BUCKETS; ++bucketIndex)
+    {
+        r2::SArray<Entry>& entries = bucketIndex == 0 ? *bucket->entries : *bucket->subBuckets[bucketIndex - 1];
+        
+        for (u64 i = 0; i < NUM_ENTRIES_PER_BUCKET[bucketIndex]; ++i)
+        {
+            Entry entry;
+            entry.aKey.keyValue = keyValues[rng() % keyValues.size()];
+            entry.data = reinterpret_cast<void*>(tag++);
+            
+            r2::sarr::Push(entries, entry);
+            expected.push_back({ entry.aKey.keyValue, entry.data });
+        }
+    }
+    
+    REQUIRE(r2::draw::cmdbkt::NumEntries(*bucket) == expected.size());
+    
+    std::stable_sort(expected.begin(), expected.end(), [](const std::pair<KeyValueType, void*>& a, const std::pair<KeyValueType, void*>& b)
+    {
+        return a.first < b.first;
+    });
+    
+    r2::draw::cmdbkt::Sort(*bucket);
+    
+    REQUIRE(r2::sarr::Size(*bucket->sortedEntries) == expected.size());
+    
+    for (u64 i = 0; i < expected.size(); ++i)
+    {
+        const Entry* entry = r2::sarr::At(*bucket->sortedEntries, i);
+        REQUIRE(entry->aKey.keyValue == expected[i].first);
+        REQUIRE(entry->data == expected[i].second);
+    }
+    
+    FREE_CMD_BUCKET(arena, T, bucket);
+}
+
+TEST_CASE("Test Command Bucket Radix Sort")
+{
+    r2::mem::GlobalMemory::Init(1);
+    
+    auto testAreaHandle = r2::mem::GlobalMemory::AddMemoryArea("TestArea");
+    REQUIRE(testAreaHandle != r2::mem::MemoryArea::Invalid);
+    r2::mem::MemoryArea* testMemoryArea = r2::mem::GlobalMemory::GetMemoryArea(testAreaHandle);
+    REQUIRE(testMemoryArea != nullptr);
+    auto result = testMemoryArea->Init(Megabytes(1));
+    REQUIRE(result);
+    auto subAreaHandle = testMemoryArea->AddSubArea(Megabytes(1));
+    REQUIRE(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid);
+    
+    SECTION("Test Basic keys")
+    {
+        r2::mem::StackArena stackArena(*testMemoryArea->GetSubArea(subAreaHandle));
+        
+        TestCommandBucketRadixSort<r2::draw::key::Basic>(stackArena, [](std::mt19937_64& rng)
+        {
+            return static_cast<u64>(rng());
+        });
+    }
+    
+    SECTION("Test ShadowKey keys")
+    {
+        r2::mem::StackArena stackArena(*testMemoryArea->GetSubArea(subAreaHandle));
+        
+        //only the depth changes so the top byte pass gets skipped and we end up with an odd number of passes
+        TestCommandBucketRadixSort<r2::draw::key::ShadowKey>(stackArena, [](std::mt19937_64& rng)
+        {
+            using r2::draw::key::ShadowKey;
+            return static_cast<u32>(
+                ENCODE_KEY_VALUE(ShadowKey::NORMAL, ShadowKey::SHADOW_KEY_BITS_TYPE, ShadowKey::SHADOW_KEY_TYPE_OFFSET) |
+                ENCODE_KEY_VALUE(r2::draw::light::LightType::LT_DIRECTIONAL_LIGHT, ShadowKey::SHADOW_KEY_BITS_LIGHT_TYPE, ShadowKey::SHADOW_KEY_LIGHT_TYPE_OFFSET) |
+                ENCODE_KEY_VALUE(rng(), ShadowKey::SHADOW_KEY_BITS_DEPTH, ShadowKey::SHADOW_KEY_DEPTH_OFFSET));
+        });
+    }
+    
+    SECTION("Test DepthKey keys")
+    {
+        r2::mem::StackArena stackArena(*testMemoryArea->GetSubArea(subAreaHandle));
+        
+        TestCommandBucketRadixSort<r2::draw::key::DepthKey>(stackArena, [](std::mt19937_64& rng)
+        {
+            using r2::draw::key::DepthKey;
+            return static_cast<u32>(
+                ENCODE_KEY_VALUE(rng() % 3, DepthKey::DEPTH_KEY_BITS_DEPTH_TYPE, DepthKey::DEPTH_KEY_DEPTH_TYPE_OFFSET) |
+                ENCODE_KEY_VALUE(rng(), DepthKey::DEPTH_KEY_BITS_DRAW_LAYER, DepthKey::DEPTH_KEY_DRAW_LAYER_OFFSET) |
+                ENCODE_KEY_VALUE(rng(), DepthKey::DEPTH_KEY_BITS_SHADER_ID, DepthKey::DEPTH_KEY_SHADER_ID_OFFSET));
+        });
+    }
+    
+    r2::mem::GlobalMemory::Shutdown();
+}
+
+//Every proxy whose fat AABB overlaps the query - what the tree should report
+static std::set<s32> BruteForceQueryAABB(const r2::math::DynamicAABBTree& tree, const std::vector<s32>& proxyIds, const r2::math::AABB& query)
+{
+    std::set<s32> result;
+    
+    for (s32 proxyId : proxyIds)
+    {
+        if (r2::math::Overlaps(tree.GetFatAABB(proxyId), query))
+        {
+            result.insert(proxyId);
+        }
+    }
+    
+    return result;
+}
+
+static std::set<s32> TreeQueryAABB(const r2::math::DynamicAABBTree& tree, const r2::math::AABB& query)
+{
+    std::set<s32> result;
+    
+    tree.QueryAABB(query, [&result](s32 proxyId)
+    {
+        result.insert(proxyId);
+        return true;
+    });
+    
+    return result;
+}
+
+static r2::math::AABB RandomAABB(std::mt19937& rng, float worldExtent, float maxSize)
+{
+    std::uniform_real_distribution<float> position(-worldExtent, worldExtent);
+    std::uniform_real_distribution<float> size(0.1f, maxSize);
+    
+    const glm::vec3 minBounds(position(rng), position(rng), position(rng));
+    
+    return { minBounds, minBounds + glm::vec3(size(rng), size(rng), size(rng)) };
+}
+
+TEST_CASE("Test DynamicAABBTree")
+{
+    r2::mem::GlobalMemory::Init(1);
+    
+    auto testAreaHandle = r2::mem::GlobalMemory::AddMemoryArea("TestArea");
+    REQUIRE(testAreaHandle != r2::mem::MemoryArea::Invalid);
+    r2::mem::MemoryArea* testMemoryArea = r2::mem::GlobalMemory::GetMemoryArea(testAreaHandle);
+    REQUIRE(testMemoryArea != nullptr);
+    auto result = testMemoryArea->Init(Megabytes(1));
+    REQUIRE(result);
+    auto subAreaHandle = testMemoryArea->AddSubArea(Megabytes(1));
+    REQUIRE(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid);
+    
+    r2::mem::StackArena stackArena(*testMemoryArea->GetSubArea(subAreaHandle));
+    
+    SECTION("Test Create, Move and Destroy against brute force")
+    {
+        const u32 MAX_NUM_PROXIES = 256;
+        
+        r2::math::DynamicAABBTree tree;
+        REQUIRE(tree.Init(stackArena, MAX_NUM_PROXIES));
+        
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> displacement(-2.0f, 2.0f);
+        
+        std::vector<s32> proxyIds;
+        std::unordered_map<s32, r2::math::AABB> bounds;
+        
+        for (u32 i = 0; i < 200; ++i)
+        {
+            const r2::math::AABB aabb = RandomAABB(rng, 50.0f, 4.0f);
+            const s32 proxyId = tree.CreateProxy(aabb, i);
+            
+            REQUIRE(proxyId != r2::math::DynamicAABBTree::NULL_NODE);
+            proxyIds.push_back(proxyId);
+            bounds[proxyId] = aabb;
+        }
+        
+        for (u32 i = 0; i < 2000; ++i)
+        {
+            const u32 op = rng() % 8;
+            
+            if (op < 6 && !proxyIds.empty())
+            {
+                const s32 proxyId = proxyIds[rng() % proxyIds.size()];
+                const glm::vec3 d(displacement(rng), displacement(rng), displacement(rng));
+                
+                r2::math::AABB& aabb = bounds[proxyId];
+                aabb.minBounds += d;
+                aabb.maxBounds += d;
+                
+                tree.MoveProxy(proxyId, aabb, d);
+            }
+            else if (op == 6 && !proxyIds.empty())
+            {
+                const size_t index = rng() % proxyIds.size();
+                const s32 proxyId = proxyIds[index];
+                
+                tree.DestroyProxy(proxyId);
+                bounds.erase(proxyId);
+                proxyIds[index] = proxyIds.back();
+                proxyIds.pop_back();
+            }
+            else if (proxyIds.size() < MAX_NUM_PROXIES)
+            {
+                const r2::math::AABB aabb = RandomAABB(rng, 50.0f, 4.0f);
+                const s32 proxyId = tree.CreateProxy(aabb, 1000 + i);
+                
+                REQUIRE(proxyId != r2::math::DynamicAABBTree::NULL_NODE);
+                proxyIds.push_back(proxyId);
+                bounds[proxyId] = aabb;
+            }
+            
+            if (i % 100 == 0)
+            {
+                REQUIRE(tree.GetNumProxies() == proxyIds.size());
+                
+                for (s32 proxyId : proxyIds)
+                {
+                    REQUIRE(r2::math::Contains(tree.GetFatAABB(proxyId), bounds[proxyId]));
+                }
+                
+                for (u32 q = 0; q < 20; ++q)
+                {
+                    const r2::math::AABB query = RandomAABB(rng, 50.0f, 20.0f);
+                    REQUIRE(TreeQueryAABB(tree, query) == BruteForceQueryAABB(tree, proxyIds, query));
+                }
+            }
+        }
+        
+        for (s32 proxyId : proxyIds)
+        {
+            tree.DestroyProxy(proxyId);
+        }
+        
+        REQUIRE(tree.GetNumProxies() == 0);
+        REQUIRE(tree.GetHeight() == 0);
+        REQUIRE(TreeQueryAABB(tree, { glm::vec3(-100.0f), glm::vec3(100.0f) }).empty());
+        
+        tree.Shutdown(stackArena);
+    }
+    
+    SECTION("Test Rebuild keeps the proxy ids")
+    {
+        const u32 MAX_NUM_PROXIES = 128;
+        
+        r2::math::DynamicAABBTree tree;
+        REQUIRE(tree.Init(stackArena, MAX_NUM_PROXIES));
+        
+        std::mt19937 rng(42);
+        
+        std::vector<s32> proxyIds;
+        
+        for (u32 i = 0; i < MAX_NUM_PROXIES; ++i)
+        {
+            proxyIds.push_back(tree.CreateProxy(RandomAABB(rng, 50.0f, 4.0f), i));
+        }
+        
+        //move everything far enough that the tree gets loose after the refit
+        bool needsRefit = false;
+        for (s32 proxyId : proxyIds)
+        {
+            needsRefit |= tree.SetProxyAABB(proxyId, RandomAABB(rng, 50.0f, 4.0f));
+        }
+        
+        REQUIRE(needsRefit);
+        
+        tree.Refit();
+        
+        std::vector<r2::math::AABB> fatAABBs;
+        for (s32 proxyId : proxyIds)
+        {
+            fatAABBs.push_back(tree.GetFatAABB(proxyId));
+        }
+        
+        tree.Rebuild();
+        
+        REQUIRE(tree.GetNumProxies() == MAX_NUM_PROXIES);
+        
+        for (u32 i = 0; i < MAX_NUM_PROXIES; ++i)
+        {
+            REQUIRE(tree.GetUserData(proxyIds[i]) == i);
+            REQUIRE(tree.GetFatAABB(proxyIds[i]).minBounds == fatAABBs[i].minBounds);
+            REQUIRE(tree.GetFatAABB(proxyIds[i]).maxBounds == fatAABBs[i].maxBounds);
+        }
+        
+        for (u32 q = 0; q < 50; ++q)
+        {
+            const r2::math::AABB query = RandomAABB(rng, 50.0f, 20.0f);
+            REQUIRE(TreeQueryAABB(tree, query) == BruteForceQueryAABB(tree, proxyIds, query));
+        }
+        
+        //the free list has to survive the rebuild too
+        REQUIRE(tree.CreateProxy(RandomAABB(rng, 50.0f, 4.0f), 0) == r2::math::DynamicAABBTree::NULL_NODE);
+        
+        tree.DestroyProxy(proxyIds.back());
+        proxyIds.pop_back();
+        
+        const s32 newProxyId = tree.CreateProxy(RandomAABB(rng, 50.0f, 4.0f), 999);
+        REQUIRE(newProxyId != r2::math::DynamicAABBTree::NULL_NODE);
+        REQUIRE(tree.GetUserData(newProxyId) == 999);
+        proxyIds.push_back(newProxyId);
+        
+        for (u32 q = 0; q < 50; ++q)
+        {
+            const r2::math::AABB query = RandomAABB(rng, 50.0f, 20.0f);
+            REQUIRE(TreeQueryAABB(tree, query) == BruteForceQueryAABB(tree, proxyIds, query));
+        }
+        
+        tree.Shutdown(stackArena);
+    }
+    
+    SECTION("Test Raycast nearest hit ordering")
+    {
+        const u32 MAX_NUM_PROXIES = 128;
+        
+        r2::math::DynamicAABBTree tree;
+        REQUIRE(tree.Init(stackArena, MAX_NUM_PROXIES));
+        
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+        
+        std::vector<s32> proxyIds;
+        
+        for (u32 i = 0; i < MAX_NUM_PROXIES; ++i)
+        {
+            proxyIds.push_back(tree.CreateProxy(RandomAABB(rng, 20.0f, 4.0f), i));
+        }
+        
+        const float MAX_DISTANCE = 100.0f;
+        
+        for (u32 r = 0; r < 100; ++r)
+        {
+            const r2::math::Ray ray = r2::math::CreateRay(glm::vec3(-40.0f, direction(rng) * 10.0f, direction(rng) * 10.0f), glm::vec3(1.0f, direction(rng) * 0.5f, direction(rng) * 0.5f));
+            const glm::vec3 invDir = r2::math::InverseDirection(ray);
+            
+            auto HitDistance = [&tree, &ray, &invDir](s32 proxyId, float maxDistance, float& tHit)
+            {
+                const r2::math::AABB& aabb = tree.GetFatAABB(proxyId);
+                return r2::math::RayAABBIntersection(ray, invDir, aabb.minBounds, aabb.maxBounds, maxDistance, tHit);
+            };
+            
+            std::set<s32> expectedHits;
+            float nearestDistance = FLT_MAX;
+            
+            for (s32 proxyId : proxyIds)
+            {
+                float tHit = 0.0f;
+                if (HitDistance(proxyId, MAX_DISTANCE, tHit))
+                {
+                    expectedHits.insert(proxyId);
+                    nearestDistance = std::min(nearestDistance, tHit);
+                }
+            }
+            
+            //ignoring every proxy should visit all of the hits
+            std::set<s32> hits;
+            tree.Raycast(ray, MAX_DISTANCE, [&hits](const r2::math::Ray&, float, s32 proxyId)
+            {
+                hits.insert(proxyId);
+                return -1.0f;
+            });
+            
+            REQUIRE(hits == expectedHits);
+            
+            //clipping to each hit should end on the nearest one and never report anything past the current max distance
+            float closestDistance = FLT_MAX;
+            float lastMaxDistance = MAX_DISTANCE;
+            bool clippedCorrectly = true;
+            
+            tree.Raycast(ray, MAX_DISTANCE, [&](const r2::math::Ray&, float maxDistance, s32 proxyId)
+            {
+                float tHit = 0.0f;
+                
+                clippedCorrectly = clippedCorrectly && maxDistance <= lastMaxDistance && HitDistance(proxyId, maxDistance, tHit);
+                lastMaxDistance = maxDistance;
+                
+                if (!HitDistance(proxyId, maxDistance, tHit) || tHit <= 0.0f)
+                {
+                    return -1.0f;
+                }
+                
+                closestDistance = std::min(closestDistance, tHit);
+                return tHit;
+            });
+            
+            REQUIRE(clippedCorrectly);
+            
+            if (!expectedHits.empty() && nearestDistance > 0.0f)
+            {
+                REQUIRE(closestDistance == nearestDistance);
+            }
+            
+            //stopping should stop right away
+            u32 numCalls = 0;
+            tree.Raycast(ray, MAX_DISTANCE, [&numCalls](const r2::math::Ray&, float, s32)
+            {
+                ++numCalls;
+                return 0.0f;
+            });
+            
+            REQUIRE(numCalls == (expectedHits.empty() ? 0 : 1));
+        }
+        
+        tree.Shutdown(stackArena);
+    }
+    
+    SECTION("Test Refit on a degenerate tree")
+    {
+        //Each leaf is 12x further out than the last one so every binned SAH split peels off a single leaf, giving a chain of height N - 1.
+        //The leaf is always on the left which is the worst case for Refit's stack (2 entries per level + 1 = MaxNumNodes).
+        const u32 MAX_NUM_PROXIES = 20;
+        
+        r2::math::DynamicAABBTree tree;
+        REQUIRE(tree.Init(stackArena, MAX_NUM_PROXIES));
+        
+        std::vector<s32> proxyIds;
+        
+        for (u32 i = 0; i < MAX_NUM_PROXIES; ++i)
+        {
+            const glm::vec3 center(-powf(12.0f, static_cast<float>(i)), 0.0f, 0.0f);
+            proxyIds.push_back(tree.CreateProxy({ center - glm::vec3(0.5f), center + glm::vec3(0.5f) }, i));
+        }
+        
+        tree.Rebuild();
+        
+        REQUIRE(tree.GetHeight() == static_cast<s32>(MAX_NUM_PROXIES) - 1);
+        
+        //move the small ones so the internal nodes need refitting
+        for (u32 i = 0; i < 4; ++i)
+        {
+            const glm::vec3 center(0.0f, 10.0f * (i + 1), 0.0f);
+            REQUIRE(tree.SetProxyAABB(proxyIds[i], { center - glm::vec3(0.5f), center + glm::vec3(0.5f) }));
+        }
+        
+        tree.Refit();
+        
+        for (u32 i = 0; i < 4; ++i)
+        {
+            const glm::vec3 center(0.0f, 10.0f * (i + 1), 0.0f);
+            const r2::math::AABB query = { center - glm::vec3(0.1f), center + glm::vec3(0.1f) };
+            
+            REQUIRE(TreeQueryAABB(tree, query) == BruteForceQueryAABB(tree, proxyIds, query));
+            REQUIRE(TreeQueryAABB(tree, query).count(proxyIds[i]) == 1);
+        }
+        
+        tree.Shutdown(stackArena);
+    }
+    
+    r2::mem::GlobalMemory::Shutdown();
+}
+
+static std::vector<r2::draw::LightUploadRange> GetUploads(const r2::draw::LightDirtyRanges& dirtyRanges, s32 numLights)
+{
+    r2::draw::LightUploadRange uploadRanges[r2::draw::light::MAX_NUM_LIGHT_DIRTY_RANGES];
+    const u32 numUploadRanges = r2::draw::lightsys::GetLightUploadRanges(dirtyRanges, numLights, sizeof(r2::draw::PointLight), offsetof(r2::draw::SceneLighting, mPointLights), uploadRanges);
+    
+    return std::vector<r2::draw::LightUploadRange>(uploadRanges, uploadRanges + numUploadRanges);
+}
+
+static bool UploadsContainLight(const std::vector<r2::draw::LightUploadRange>& uploads, s32 lightIndex)
+{
+    const u64 lightOffset = offsetof(r2::draw::SceneLighting, mPointLights) + sizeof(r2::draw::PointLight) * lightIndex;
+    
+    for (const auto& upload : uploads)
+    {
+        if (lightOffset >= upload.offset && lightOffset + sizeof(r2::draw::PointLight) <= upload.offset + upload.size)
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+TEST_CASE("Test Light Dirty Ranges")
+{
+    const u64 lightSize = sizeof(r2::draw::PointLight);
+    const u64 lightsOffset = offsetof(r2::draw::SceneLighting, mPointLights);
+    const s32 numLights = static_cast<s32>(r2::draw::light::MAX_NUM_POINT_LIGHTS);
+    
+    SECTION("Neighbouring lights upload as one fill")
+    {
+        r2::draw::LightDirtyRanges dirtyRanges;
+        
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 5);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 7);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 6);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 4);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 6);
+        
+        const auto uploads = GetUploads(dirtyRanges, numLights);
+        
+        REQUIRE(uploads.size() == 1);
+        REQUIRE(uploads[0].offset == lightsOffset + lightSize * 4);
+        REQUIRE(uploads[0].size == lightSize * 4);
+    }
+    
+    SECTION("Scattered lights only upload what changed")
+    {
+        r2::draw::LightDirtyRanges dirtyRanges;
+        
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 4000);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 2);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 10);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 11);
+        
+        const auto uploads = GetUploads(dirtyRanges, numLights);
+        
+        REQUIRE(uploads.size() == 3);
+        REQUIRE(uploads[0].offset == lightsOffset + lightSize * 2);
+        REQUIRE(uploads[0].size == lightSize);
+        REQUIRE(uploads[1].offset == lightsOffset + lightSize * 10);
+        REQUIRE(uploads[1].size == lightSize * 2);
+        REQUIRE(uploads[2].offset == lightsOffset + lightSize * 4000);
+        REQUIRE(uploads[2].size == lightSize);
+    }
+    
+    SECTION("Running out of ranges merges the closest ones")
+    {
+        r2::draw::LightDirtyRanges dirtyRanges;
+        
+        for (u32 i = 0; i < r2::draw::light::MAX_NUM_LIGHT_DIRTY_RANGES; ++i)
+        {
+            r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, i * 100);
+        }
+        
+        //the closest gap is now between 300 and 303
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 303);
+        
+        const auto uploads = GetUploads(dirtyRanges, numLights);
+        
+        REQUIRE(uploads.size() == r2::draw::light::MAX_NUM_LIGHT_DIRTY_RANGES);
+        REQUIRE(uploads[3].offset == lightsOffset + lightSize * 300);
+        REQUIRE(uploads[3].size == lightSize * 4);
+        REQUIRE(uploads[4].offset == lightsOffset + lightSize * 400);
+        REQUIRE(uploads[4].size == lightSize);
+    }
+    
+    SECTION("Removed lights aren't uploaded")
+    {
+        r2::draw::LightDirtyRanges dirtyRanges;
+        
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 1);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 8);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 9);
+        r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, 20);
+        
+        const auto uploads = GetUploads(dirtyRanges, 9);
+        
+        REQUIRE(uploads.size() == 2);
+        REQUIRE(uploads[0].offset == lightsOffset + lightSize);
+        REQUIRE(uploads[0].size == lightSize);
+        REQUIRE(uploads[1].offset == lightsOffset + lightSize * 8);
+        REQUIRE(uploads[1].size == lightSize);
+        
+        REQUIRE(GetUploads(dirtyRanges, 0).empty());
+    }
+    
+    SECTION("Random lights are all uploaded in sorted, disjoint fills")
+    {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<s32> lightIndex(0, numLights - 1);
+        
+        for (u32 iteration = 0; iteration < 100; ++iteration)
+        {
+            r2::draw::LightDirtyRanges dirtyRanges;
+            std::vector<s32> dirtyLights;
+            
+            const u32 numDirtyLights = 1 + iteration % 40;
+            for (u32 i = 0; i < numDirtyLights; ++i)
+            {
+                const s32 index = lightIndex(rng);
+                dirtyLights.push_back(index);
+                r2::draw::lightsys::AddToDirtyRanges(dirtyRanges, index);
+            }
+            
+            const auto uploads = GetUploads(dirtyRanges, numLights);
+            
+            REQUIRE(!uploads.empty());
+            REQUIRE(uploads.size() <= r2::draw::light::MAX_NUM_LIGHT_DIRTY_RANGES);
+            
+            for (size_t i = 0; i < uploads.size(); ++i)
+            {
+                REQUIRE(uploads[i].size > 0);
+                REQUIRE(uploads[i].size % lightSize == 0);
+                REQUIRE((uploads[i].offset - lightsOffset) % lightSize == 0);
+                REQUIRE(uploads[i].offset + uploads[i].size <= lightsOffset + lightSize * numLights);
+                
+                if (i > 0)
+                {
+                    //touching ranges should have been merged
+                    REQUIRE(uploads[i - 1].offset + uploads[i - 1].size < uploads[i].offset);
+                }
+            }
+            
+            for (s32 index : dirtyLights)
+            {
+                REQUIRE(UploadsContainLight(uploads, index));
+            }
+            
+            //with fewer dirty lights than ranges we shouldn't upload anything else
+            std::set<s32> uniqueLights(dirtyLights.begin(), dirtyLights.end());
+            if (uniqueLights.size() <= r2::draw::light::MAX_NUM_LIGHT_DIRTY_RANGES)
+            {
+                u64 totalSize = 0;
+                for (const auto& upload : uploads)
+                {
+                    totalSize += upload.size;
+                }
+                
+                REQUIRE(totalSize == lightSize * uniqueLights.size());
+            }
+        }
+    }
+}
+
+struct MeshOptimizeTestVertex
+{
+    glm::vec3 position;
+    glm::vec3 normal;
+};
+
+//A UV sphere with its triangles shuffled so there's something to optimize
+static void MakeShuffledSphere(u32 numRings, u32 numSegments, std::vector<MeshOptimizeTestVertex>& vertices, std::vector<uint32_t>& indices, std::mt19937& rng)
+{
+    for (u32 ring = 0; ring <= numRings; ++ring)
+    {
+        const float phi = glm::pi<float>() * static_cast<float>(ring) / static_cast<float>(numRings);
+        
+        for (u32 segment = 0; segment <= numSegments; ++segment)
+        {
+            const float theta = glm::two_pi<float>() * static_cast<float>(segment) / static_cast<float>(numSegments);
+            const glm::vec3 normal(sinf(phi) * cosf(theta), sinf(phi) * sinf(theta), cosf(phi));
+            
+            vertices.push_back({ normal * 2.0f, normal });
+        }
+    }
+    
+    std::vector<std::array<uint32_t, 3>> triangles;
+    
+    for (u32 ring = 0; ring < numRings; ++ring)
+    {
+        for (u32 segment = 0; segment < numSegments; ++segment)
+        {
+            const uint32_t a = ring * (numSegments + 1) + segment;
+            const uint32_t b = a + numSegments + 1;
+            
+            triangles.push_back({ a, b, a + 1 });
+            triangles.push_back({ a + 1, b, b + 1 });
+        }
+    }
+    
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+    
+    for (const auto& triangle : triangles)
+    {
+        indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+}
+
+//Rotates the smallest index to the front so the same triangle with the same winding always compares equal
+static std::multiset<std::array<uint32_t, 3>> GetTriangleSet(const std::vector<uint32_t>& indices)
+{
+    std::multiset<std::array<uint32_t, 3>> triangles;
+    
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        std::array<uint32_t, 3> triangle = { indices[i], indices[i + 1], indices[i + 2] };
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.insert(triangle);
+    }
+    
+    return triangles;
+}
+
+TEST_CASE("Test Mesh Optimize")
+{
+    const uint32_t CACHE_SIZE = 16;
+    
+    std::mt19937 rng(42);
+    std::vector<MeshOptimizeTestVertex> vertices;
+    std::vector<uint32_t> indices;
+    
+    MakeShuffledSphere(24, 32, vertices, indices, rng);
+    
+    const float* positions = &vertices[0].position.x;
+    const size_t positionStride = sizeof(MeshOptimizeTestVertex);
+    
+    SECTION("Vertex cache optimization reorders the triangles and doesn't make the ACMR worse")
+    {
+        std::vector<uint32_t> optimized = indices;
+        r2::assets::assetlib::OptimizeVertexCache(optimized.data(), optimized.size(), vertices.size());
+        
+        REQUIRE(GetTriangleSet(optimized) == GetTriangleSet(indices));
+        
+        const float inputACMR = r2::assets::assetlib::CalculateACMR(indices.data(), indices.size(), vertices.size(), CACHE_SIZE);
+        const float optimizedACMR = r2::assets::assetlib::CalculateACMR(optimized.data(), optimized.size(), vertices.size(), CACHE_SIZE);
+        
+        REQUIRE(optimizedACMR <= inputACMR);
+    }
+    
+    SECTION("Overdraw optimization reorders the triangles and keeps the ACMR within the threshold")
+    {
+        std::vector<uint32_t> cacheOptimized = indices;
+        r2::assets::assetlib::OptimizeVertexCache(cacheOptimized.data(), cacheOptimized.size(), vertices.size());
+        
+        const float cacheOptimizedACMR = r2::assets::assetlib::CalculateACMR(cacheOptimized.data(), cacheOptimized.size(), vertices.size(), CACHE_SIZE);
+        
+        const float thresholds[] = { 1.0f, 1.05f };
+        
+        for (float threshold : thresholds)
+        {
+            std::vector<uint32_t> optimized = cacheOptimized;
+            r2::assets::assetlib::OptimizeOverdraw(optimized.data(), optimized.size(), positions, vertices.size(), positionStride, threshold);
+            
+            REQUIRE(GetTriangleSet(optimized) == GetTriangleSet(indices));
+            
+            const float optimizedACMR = r2::assets::assetlib::CalculateACMR(optimized.data(), optimized.size(), vertices.size(), CACHE_SIZE);
+            
+            REQUIRE(optimizedACMR <= cacheOptimizedACMR * threshold + 1e-5f);
+        }
+    }
+    
+    SECTION("Vertex fetch remap is a bijection in first use order")
+    {
+        //a vertex no triangle uses should end up at the back
+        const size_t numVertices = vertices.size() + 1;
+        
+        std::vector<uint32_t> remapped = indices;
+        std::vector<uint32_t> remap(numVertices);
+        r2::assets::assetlib::OptimizeVertexFetchRemap(remap.data(), remapped.data(), remapped.size(), numVertices);
+        
+        std::vector<bool> used(numVertices, false);
+        
+        for (uint32_t newIndex : remap)
+        {
+            REQUIRE(newIndex < numVertices);
+            REQUIRE(!used[newIndex]);
+            used[newIndex] = true;
+        }
+        
+        REQUIRE(remap[numVertices - 1] == numVertices - 1);
+        
+        uint32_t nextNewVertex = 0;
+        
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            REQUIRE(remapped[i] == remap[indices[i]]);
+            
+            if (remapped[i] == nextNewVertex)
+            {
+                ++nextNewVertex;
+            }
+            else
+            {
+                REQUIRE(remapped[i] < nextNewVertex);
+            }
+        }
+        
+        REQUIRE(nextNewVertex == vertices.size());
+    }
+    
+    SECTION("Simplifying keeps valid, unique triangles within the error")
+    {
+        const float targetErrors[] = { 0.0f, 0.05f, 0.2f, 0.6f };
+        
+        size_t lastNumIndices = indices.size();
+        
+        for (float targetError : targetErrors)
+        {
+            std::vector<uint32_t> simplified(indices.size());
+            float resultError = -1.0f;
+            
+            const size_t numSimplified = r2::assets::assetlib::SimplifyMesh(simplified.data(), indices.data(), indices.size(), positions, vertices.size(), positionStride, targetError, resultError);
+            simplified.resize(numSimplified);
+            
+            REQUIRE(numSimplified % 3 == 0);
+            REQUIRE(numSimplified <= lastNumIndices);
+            
+            for (uint32_t index : simplified)
+            {
+                REQUIRE(index < vertices.size());
+            }
+            
+            const auto triangles = GetTriangleSet(simplified);
+            std::set<std::array<uint32_t, 3>> uniqueTriangles(triangles.begin(), triangles.end());
+            
+            REQUIRE(uniqueTriangles.size() == triangles.size());
+            
+            for (const auto& triangle : triangles)
+            {
+                REQUIRE(triangle[0] != triangle[1]);
+                REQUIRE(triangle[1] != triangle[2]);
+                REQUIRE(triangle[0] != triangle[2]);
+            }
+            
+            //vertices only move to another vertex in the same grid cell
+            REQUIRE(resultError >= 0.0f);
+            REQUIRE(resultError <= targetError * sqrtf(3.0f) * 1.0001f);
+            
+            lastNumIndices = numSimplified;
+        }
+        
+        REQUIRE(lastNumIndices < indices.size());
+    }
+}
+
+static r2::math::Transform RandomTransform(std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    
+    r2::math::Transform t;
+    t.position = glm::vec3(position(rng), position(rng), position(rng));
+    //non-uniform on purpose
+    t.scale = glm::vec3(scale(rng), scale(rng), scale(rng));
+    t.rotation = glm::normalize(glm::quat(component(rng), component(rng), component(rng), component(rng)));
+    
+    return t;
+}
+
+static bool NearlyEqual(float a, float b)
+{
+    return fabsf(a - b) <= 1e-4f * std::max(1.0f, std::max(fabsf(a), fabsf(b)));
+}
+
+static bool NearlyEqual(const r2::math::Transform& a, const r2::math::Transform& b)
+{
+    for (u32 i = 0; i < 3; ++i)
+    {
+        if (!NearlyEqual(a.position[i], b.position[i]) || !NearlyEqual(a.scale[i], b.scale[i]))
+        {
+            return false;
+        }
+    }
+    
+    for (u32 i = 0; i < 4; ++i)
+    {
+        if (!NearlyEqual(a.rotation[i], b.rotation[i]))
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static bool NearlyEqual(const glm::mat4& a, const glm::mat4& b)
+{
+    for (u32 column = 0; column < 4; ++column)
+    {
+        for (u32 row = 0; row < 4; ++row)
+        {
+            if (!NearlyEqual(a[column][row], b[column][row]))
+            {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+TEST_CASE("Test Transform Combine4 and ToMatrix4")
+{
+    std::mt19937 rng(7);
+    
+    const r2::math::Transform untouchedTransform = { glm::vec3(-1.0f), glm::vec3(-1.0f), glm::quat(0.0f, 0.0f, 0.0f, 0.0f) };
+    const glm::mat4 untouchedMatrix = glm::mat4(-1.0f);
+    
+    for (u32 iteration = 0; iteration < 1000; ++iteration)
+    {
+        const u32 count = 1 + iteration % 4;
+        
+        r2::math::Transform a[4];
+        r2::math::Transform b[4];
+        r2::math::Transform r[4];
+        glm::mat4 m[4];
+        
+        const r2::math::Transform* aPtrs[4];
+        const r2::math::Transform* bPtrs[4];
+        r2::math::Transform* rPtrs[4];
+        const r2::math::Transform* rConstPtrs[4];
+        glm::mat4* mPtrs[4];
+        
+        //the lanes don't have to be in order or contiguous
+        for (u32 lane = 0; lane < 4; ++lane)
+        {
+            a[lane] = RandomTransform(rng);
+            b[lane] = RandomTransform(rng);
+            r[lane] = untouchedTransform;
+            m[lane] = untouchedMatrix;
+            
+            aPtrs[lane] = &a[3 - lane];
+            bPtrs[lane] = &b[lane];
+            rPtrs[lane] = &r[3 - lane];
+            rConstPtrs[lane] = rPtrs[lane];
+            mPtrs[lane] = &m[lane];
+        }
+        
+        r2::math::Combine4(aPtrs, bPtrs, rPtrs, count);
+        r2::math::ToMatrix4(rConstPtrs, mPtrs, count);
+        
+        for (u32 lane = 0; lane < 4; ++lane)
+        {
+            if (lane < count)
+            {
+                const r2::math::Transform expected = r2::math::Combine(*aPtrs[lane], *bPtrs[lane]);
+                
+                REQUIRE(NearlyEqual(*rPtrs[lane], expected));
+                REQUIRE(NearlyEqual(*mPtrs[lane], r2::math::ToMatrix(*rPtrs[lane])));
+            }
+            else
+            {
+                REQUIRE(NearlyEqual(*rPtrs[lane], untouchedTransform));
+                REQUIRE(NearlyEqual(*mPtrs[lane], untouchedMatrix));
+            }
+        }
+    }
+}
+
+const u32 ANIMATION_TEST_SAMPLE_RATE = 30;
+const float ANIMATION_TEST_DURATION = 2.0f;
+const u64 ANIMATION_TEST_ALIGNMENT = 16;
+
+template<typename T>
+static r2::SArray<T>* EmplaceAnimationTestArray(void** memoryPointer, u32 capacity)
+{
+    r2::SArray<T>* array = EMPLACE_SARRAY(*memoryPointer, T, capacity);
+    *memoryPointer = r2::mem::utils::AlignForward(r2::mem::utils::PointerAdd(*memoryPointer, r2::SArray<T>::MemorySize(capacity)), ANIMATION_TEST_ALIGNMENT);
+    return array;
+}
+
+//The same lookup table the asset converter builds for each track (UpdateIndexLookupTable in ModelConvert.cpp)
+static r2::SArray<u32>* MakeAnimationTestSampledFrames(void** memoryPointer, const std::vector<float>& times)
+{
+    const int numFrames = static_cast<int>(times.size());
+    if (numFrames <= 1)
+    {
+        return EmplaceAnimationTestArray<u32>(memoryPointer, 0);
+    }
+    
+    const float startTime = times.front();
+    const float duration = times.back() - startTime;
+    const u32 numSamples = static_cast<u32>(duration * static_cast<float>(ANIMATION_TEST_SAMPLE_RATE));
+    
+    r2::SArray<u32>* sampledFrames = EmplaceAnimationTestArray<u32>(memoryPointer, numSamples);
+    
+    for (u32 i = 0; i < numSamples; ++i)
+    {
+        const float time = (static_cast<float>(i) / static_cast<float>(numSamples - 1)) * duration + startTime;
+        u32 frameIndex = 0;
+        for (int j = numFrames - 1; j >= 0; --j)
+        {
+            if (time >= times[j])
+            {
+                frameIndex = static_cast<u32>(j);
+                if (static_cast<int>(frameIndex) >= numFrames - 2)
+                {
+                    frameIndex = numFrames - 2;
+                }
+                break;
+            }
+        }
+        
+        r2::sarr::Push(*sampledFrames, frameIndex);
+    }
+    
+    return sampledFrames;
+}
+
+template<typename T, unsigned int N>
+static r2::anim::Track<T, N>* MakeAnimationTestTrack(void** memoryPointer, const std::vector<r2::anim::Frame<N>>& frames, r2::anim::InterpolationType interpolation)
+{
+    r2::anim::Track<T, N>* track = new (*memoryPointer) r2::anim::Track<T, N>();
+    *memoryPointer = r2::mem::utils::AlignForward(r2::mem::utils::PointerAdd(*memoryPointer, sizeof(r2::anim::Track<T, N>)), ANIMATION_TEST_ALIGNMENT);
+    
+    track->mInterpolationType = interpolation;
+    track->mNumSamples = ANIMATION_TEST_SAMPLE_RATE;
+    track->mFrames = EmplaceAnimationTestArray<r2::anim::Frame<N>>(memoryPointer, static_cast<u32>(frames.size()));
+    
+    std::vector<float> times;
+    for (const auto& frame : frames)
+    {
+        r2::sarr::Push(*track->mFrames, frame);
+        times.push_back(static_cast<float>(frame.mTime));
+    }
+    
+    track->mSampledFrames = MakeAnimationTestSampledFrames(memoryPointer, times);
+    
+    return track;
+}
+
+//Every track covers the whole clip, the first and last keys are at 0 and ANIMATION_TEST_DURATION
+static std::vector<float> RandomKeyTimes(std::mt19937& rng, u32 numKeys)
+{
+    std::uniform_real_distribution<float> time(0.0f, ANIMATION_TEST_DURATION);
+    
+    std::vector<float> times;
+    times.push_back(0.0f);
+    for (u32 i = 2; i < numKeys; ++i)
+    {
+        times.push_back(time(rng));
+    }
+    
+    std::sort(times.begin() + 1, times.end());
+    
+    if (numKeys > 1)
+    {
+        times.push_back(ANIMATION_TEST_DURATION);
+    }
+    
+    return times;
+}
+
+static std::vector<r2::anim::VectorFrame> RandomVectorFrames(std::mt19937& rng, u32 numKeys, float minValue, float maxValue)
+{
+    std::uniform_real_distribution<float> value(minValue, maxValue);
+    std::uniform_real_distribution<float> slope(-2.0f, 2.0f);
+    
+    std::vector<r2::anim::VectorFrame> frames;
+    for (float time : RandomKeyTimes(rng, numKeys))
+    {
+        r2::anim::VectorFrame frame;
+        frame.mTime = time;
+        for (u32 c = 0; c < 3; ++c)
+        {
+            frame.mValue[c] = value(rng);
+            frame.mIn[c] = slope(rng);
+            frame.mOut[c] = slope(rng);
+        }
+        
+        frames.push_back(frame);
+    }
+    
+    return frames;
+}
+
+//A random walk so neighbouring keys are close together like they are in a real clip. Some keys are negated to test that
+//the short way around gets taken.
+static std::vector<r2::anim::QuatFrame> RandomQuatFrames(std::mt19937& rng, u32 numKeys)
+{
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angle(0.05f, 0.25f);
+    std::uniform_real_distribution<float> slope(-0.5f, 0.5f);
+    
+    glm::quat rotation = glm::normalize(glm::quat(component(rng), component(rng), component(rng), component(rng)));
+    
+    std::vector<r2::anim::QuatFrame> frames;
+    for (float time : RandomKeyTimes(rng, numKeys))
+    {
+        const glm::vec3 axis = glm::normalize(glm::vec3(component(rng), component(rng), component(rng)) + glm::vec3(0.0f, 0.0f, 1e-3f));
+        rotation = glm::normalize(rotation * glm::angleAxis(angle(rng), axis));
+        
+        const glm::quat key = component(rng) < -0.5f ? -rotation : rotation;
+        
+        r2::anim::QuatFrame frame;
+        frame.mTime = time;
+        const float values[4] = { key.x, key.y, key.z, key.w };
+        for (u32 c = 0; c < 4; ++c)
+        {
+            frame.mValue[c] = values[c];
+            frame.mIn[c] = slope(rng);
+            frame.mOut[c] = slope(rng);
+        }
+        
+        frames.push_back(frame);
+    }
+    
+    return frames;
+}
+
+static r2::anim::Pose MakeAnimationTestPose(void** memoryPointer, const std::vector<r2::math::Transform>& joints)
+{
+    r2::anim::Pose pose;
+    pose.mJointTransforms = EmplaceAnimationTestArray<r2::math::Transform>(memoryPointer, static_cast<u32>(joints.size()));
+    pose.mParents = EmplaceAnimationTestArray<s32>(memoryPointer, static_cast<u32>(joints.size()));
+    
+    for (const auto& joint : joints)
+    {
+        r2::sarr::Push(*pose.mJointTransforms, joint);
+        r2::sarr::Push(*pose.mParents, -1);
+    }
+    
+    return pose;
+}
+
+static bool SameRotation(const glm::quat& a, const glm::quat& b, float tolerance)
+{
+    return 1.0f - fabsf(glm::dot(a, b)) <= tolerance;
+}
+
+TEST_CASE("Test Animation SoA Sampling")
+{
+    std::mt19937 rng(11);
+    
+    //11 tracks so that the last group of 4 is only partly full
+    const u32 numJoints = 11;
+    const r2::anim::InterpolationType interpolations[] = { r2::anim::CONSTANT, r2::anim::LINEAR, r2::anim::CUBIC };
+    
+    std::vector<u8> memory(Megabytes(1));
+    void* memoryPointer = r2::mem::utils::AlignForward(memory.data(), ANIMATION_TEST_ALIGNMENT);
+    
+    r2::anim::AnimationClip clip;
+    clip.mStartTime = 0.0f;
+    clip.mEndTime = ANIMATION_TEST_DURATION;
+    clip.mTracks = EmplaceAnimationTestArray<r2::anim::TransformTrack*>(&memoryPointer, numJoints);
+    
+    std::uniform_int_distribution<u32> numKeys(2, 12);
+    
+    for (u32 i = 0; i < numJoints; ++i)
+    {
+        r2::anim::TransformTrack* transformTrack = new (memoryPointer) r2::anim::TransformTrack();
+        memoryPointer = r2::mem::utils::AlignForward(r2::mem::utils::PointerAdd(memoryPointer, sizeof(r2::anim::TransformTrack)), ANIMATION_TEST_ALIGNMENT);
+        
+        //the tracks aren't in joint order
+        transformTrack->mJointID = (i * 7) % numJoints;
+        transformTrack->mStartTime = 0.0f;
+        transformTrack->mEndTime = ANIMATION_TEST_DURATION;
+        
+        //a few tracks only have 1 key - those don't change the pose
+        transformTrack->mPosition = MakeAnimationTestTrack<glm::vec3, 3>(&memoryPointer, RandomVectorFrames(rng, i == 4 ? 1 : numKeys(rng), -5.0f, 5.0f), interpolations[i % 3]);
+        transformTrack->mRotation = MakeAnimationTestTrack<glm::quat, 4>(&memoryPointer, RandomQuatFrames(rng, i == 9 ? 1 : numKeys(rng)), interpolations[(i + 1) % 3]);
+        transformTrack->mScale = MakeAnimationTestTrack<glm::vec3, 3>(&memoryPointer, RandomVectorFrames(rng, i == 2 ? 1 : numKeys(rng), 0.5f, 2.0f), interpolations[(i + 2) % 3]);
+        
+        r2::sarr::Push(*clip.mTracks, transformTrack);
+    }
+    
+    r2::anim::AnimationClip soaClip = clip;
+    soaClip.mSoAClip = r2::anim::LoadSoAAnimationClip(&memoryPointer, soaClip);
+    
+    REQUIRE(soaClip.mSoAClip != nullptr);
+    REQUIRE(r2::mem::utils::PointerOffset(memory.data(), memoryPointer) <= memory.size());
+    
+    std::vector<r2::math::Transform> referencePose;
+    for (u32 j = 0; j < numJoints; ++j)
+    {
+        referencePose.push_back(RandomTransform(rng));
+    }
+    
+    r2::anim::Pose scalarPose = MakeAnimationTestPose(&memoryPointer, referencePose);
+    r2::anim::Pose soaPose = MakeAnimationTestPose(&memoryPointer, referencePose);
+    
+    std::vector<float> sampleTimes;
+    for (float time = -1.0f; time < 5.0f; time += 0.0137f)
+    {
+        sampleTimes.push_back(time);
+    }
+    
+    //right on the keys
+    for (u32 k = 0; k < r2::sarr::Size(*clip.mTracks->mData[0]->mPosition->mFrames); ++k)
+    {
+        sampleTimes.push_back(static_cast<float>(clip.mTracks->mData[0]->mPosition->mFrames->mData[k].mTime));
+    }
+    
+    for (bool loop : { false, true })
+    {
+        for (float time : sampleTimes)
+        {
+            const float scalarTime = clip.Sample(scalarPose, time, loop);
+            const float soaTime = r2::anim::SampleSoA(soaClip, soaPose, time, loop);
+            
+            REQUIRE(scalarTime == soaTime);
+            
+            for (u32 j = 0; j < numJoints; ++j)
+            {
+                const r2::math::Transform& expected = scalarPose.mJointTransforms->mData[j];
+                const r2::math::Transform& result = soaPose.mJointTransforms->mData[j];
+                
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    REQUIRE(NearlyEqual(expected.position[c], result.position[c]));
+                    REQUIRE(NearlyEqual(expected.scale[c], result.scale[c]));
+                }
+                
+                //SoA nlerps the rotations instead of slerping them
+                REQUIRE(SameRotation(expected.rotation, result.rotation, 1e-5f));
+            }
+        }
+    }
+}
+
+//Encodes the keys with the converter's quantizers, the same as CompressTrack in ModelConvert.cpp does after it reduces the keys
+template<typename T, unsigned int N>
+static r2::anim::Track<T, N>* MakeCompressedAnimationTestTrack(void** memoryPointer, const std::vector<r2::anim::Frame<N>>& frames, r2::anim::InterpolationType interpolation)
+{
+    r2::anim::Track<T, N>* track = new (*memoryPointer) r2::anim::Track<T, N>();
+    *memoryPointer = r2::mem::utils::AlignForward(r2::mem::utils::PointerAdd(*memoryPointer, sizeof(r2::anim::Track<T, N>)), ANIMATION_TEST_ALIGNMENT);
+    
+    const u32 numFrames = static_cast<u32>(frames.size());
+    
+    track->mInterpolationType = interpolation;
+    track->mNumSamples = ANIMATION_TEST_SAMPLE_RATE;
+    track->mCompressedTimes = EmplaceAnimationTestArray<float>(memoryPointer, numFrames);
+    track->mCompressedValues = EmplaceAnimationTestArray<u16>(memoryPointer, numFrames * 3);
+    
+    if constexpr (N == 3)
+    {
+        float rangeMax[3];
+        for (u32 c = 0; c < 3; ++c)
+        {
+            track->mRangeMin[c] = rangeMax[c] = frames.front().mValue[c];
+        }
+        
+        for (const auto& frame : frames)
+        {
+            for (u32 c = 0; c < 3; ++c)
+            {
+                track->mRangeMin[c] = std::min(track->mRangeMin[c], frame.mValue[c]);
+                rangeMax[c] = std::max(rangeMax[c], frame.mValue[c]);
+            }
+        }
+        
+        for (u32 c = 0; c < 3; ++c)
+        {
+            track->mRangeExtent[c] = rangeMax[c] - track->mRangeMin[c];
+        }
+    }
+    
+    std::vector<float> times;
+    for (const auto& frame : frames)
+    {
+        uint16_t values[3];
+        
+        if constexpr (N == 3)
+        {
+            r2::assets::assetlib::QuantizeVectorKey(frame.mValue, track->mRangeMin, track->mRangeExtent, values);
+        }
+        else
+        {
+            r2::assets::assetlib::QuantizeQuaternionKey(frame.mValue, values);
+        }
+        
+        for (u32 c = 0; c < 3; ++c)
+        {
+            r2::sarr::Push(*track->mCompressedValues, static_cast<u16>(values[c]));
+        }
+        
+        r2::sarr::Push(*track->mCompressedTimes, static_cast<float>(frame.mTime));
+        times.push_back(static_cast<float>(frame.mTime));
+    }
+    
+    track->mSampledFrames = MakeAnimationTestSampledFrames(memoryPointer, times);
+    
+    return track;
+}
+
+TEST_CASE("Test Animation Compression Round Trip")
+{
+    std::mt19937 rng(13);
+    
+    std::vector<u8> memory(Megabytes(1));
+    void* memoryPointer = r2::mem::utils::AlignForward(memory.data(), ANIMATION_TEST_ALIGNMENT);
+    
+    std::uniform_int_distribution<u32> numKeys(2, 16);
+    
+    std::vector<float> sampleTimes;
+    for (float time = -1.0f; time < 5.0f; time += 0.0173f)
+    {
+        sampleTimes.push_back(time);
+    }
+    
+    SECTION("Vector keys decode to within half a step of the range")
+    {
+        for (u32 trial = 0; trial < 20; ++trial)
+        {
+            std::vector<r2::anim::VectorFrame> frames = RandomVectorFrames(rng, numKeys(rng), -50.0f, 50.0f);
+            
+            //a component that doesn't change has no range at all
+            if (trial % 4 == 0)
+            {
+                for (auto& frame : frames)
+                {
+                    frame.mValue[1] = 3.0f;
+                }
+            }
+            
+            const r2::anim::InterpolationType interpolation = trial % 2 ? r2::anim::LINEAR : r2::anim::CONSTANT;
+            
+            const r2::anim::VectorTrack* track = MakeAnimationTestTrack<glm::vec3, 3>(&memoryPointer, frames, interpolation);
+            const r2::anim::VectorTrack* compressedTrack = MakeCompressedAnimationTestTrack<glm::vec3, 3>(&memoryPointer, frames, interpolation);
+            
+            REQUIRE(compressedTrack->IsCompressed());
+            REQUIRE(compressedTrack->Size() == track->Size());
+            
+            glm::vec3 tolerance;
+            for (u32 c = 0; c < 3; ++c)
+            {
+                tolerance[c] = 0.5f * compressedTrack->mRangeExtent[c] / 65535.0f + 1e-4f;
+            }
+            
+            for (u32 k = 0; k < track->Size(); ++k)
+            {
+                REQUIRE(compressedTrack->GetFrameTime(k) == track->GetFrameTime(k));
+                
+                const glm::vec3 difference = glm::abs(compressedTrack->GetFrameValue(k) - track->GetFrameValue(k));
+                REQUIRE(glm::all(glm::lessThanEqual(difference, tolerance)));
+            }
+            
+            for (bool loop : { false, true })
+            {
+                for (float time : sampleTimes)
+                {
+                    const glm::vec3 difference = glm::abs(compressedTrack->Sample(time, loop) - track->Sample(time, loop));
+                    REQUIRE(glm::all(glm::lessThanEqual(difference, tolerance)));
+                }
+            }
+            
+            REQUIRE(r2::mem::utils::PointerOffset(memory.data(), memoryPointer) <= memory.size());
+        }
+    }
+    
+    SECTION("Quaternion keys decode to the same rotation")
+    {
+        for (u32 trial = 0; trial < 20; ++trial)
+        {
+            const std::vector<r2::anim::QuatFrame> frames = RandomQuatFrames(rng, numKeys(rng));
+            const r2::anim::InterpolationType interpolation = trial % 2 ? r2::anim::LINEAR : r2::anim::CONSTANT;
+            
+            const r2::anim::QuatTrack* track = MakeAnimationTestTrack<glm::quat, 4>(&memoryPointer, frames, interpolation);
+            const r2::anim::QuatTrack* compressedTrack = MakeCompressedAnimationTestTrack<glm::quat, 4>(&memoryPointer, frames, interpolation);
+            
+            REQUIRE(compressedTrack->IsCompressed());
+            REQUIRE(compressedTrack->Size() == track->Size());
+            
+            for (u32 k = 0; k < track->Size(); ++k)
+            {
+                REQUIRE(compressedTrack->GetFrameTime(k) == track->GetFrameTime(k));
+                REQUIRE(SameRotation(compressedTrack->GetFrameValue(k), track->GetFrameValue(k), 1e-6f));
+            }
+            
+            for (bool loop : { false, true })
+            {
+                for (float time : sampleTimes)
+                {
+                    REQUIRE(SameRotation(compressedTrack->Sample(time, loop), track->Sample(time, loop), 1e-5f));
+                }
+            }
+            
+            REQUIRE(r2::mem::utils::PointerOffset(memory.data(), memoryPointer) <= memory.size());
+        }
+    }
+    
+    SECTION("Every component can be the one that gets dropped")
+    {
+        for (u32 largestIndex = 0; largestIndex < 4; ++largestIndex)
+        {
+            for (float sign : { 1.0f, -1.0f })
+            {
+                float rotation[4] = { 0.1f, -0.2f, 0.3f, 0.15f };
+                rotation[largestIndex] = 0.9f * sign;
+                
+                uint16_t values[3];
+                r2::assets::assetlib::QuantizeQuaternionKey(rotation, values);
+                
+                REQUIRE((((values[0] >> 15) << 1) | (values[1] >> 15)) == largestIndex);
+            }
+        }
+    }
+}
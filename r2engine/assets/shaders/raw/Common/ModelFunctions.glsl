@@ -10,6 +10,25 @@ mat4 GetStaticModel(uint drawID, uint localMeshIndex)
 	return models[drawID] * meshData.globalTransform; 
 }
 
+//Quantized meshes come in as unorm16 positions relative to the model bounds and octahedral snorm16 normals/tangents
+vec3 DecodeMeshPosition(MeshData meshData, vec3 position)
+{
+	return position * meshData.positionScale.xyz + meshData.positionBias.xyz;
+}
+
+vec3 DecodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+	float t = clamp(-n.z, 0.0, 1.0);
+	n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+	return normalize(n);
+}
+
+vec3 DecodeMeshDirection(MeshData meshData, vec3 direction)
+{
+	return meshData.positionScale.w > 0.0 ? DecodeOctahedral(direction.xy) : direction;
+}
+
 
 
 #endif
\ No newline at end of file
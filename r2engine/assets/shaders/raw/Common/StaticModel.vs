@@ -19,7 +19,9 @@ out VS_OUT
 
 void main()
 {
-    vec4 modelPos = GetStaticModel(DrawID, GetLocalMeshOrMaterialIndex(aTexCoord1)) * vec4(aPos, 1.0);
+    uint localMeshIndex = GetLocalMeshOrMaterialIndex(aTexCoord1);
+    vec3 position = DecodeMeshPosition(GetMeshData(DrawID, localMeshIndex), aPos);
+    vec4 modelPos = GetStaticModel(DrawID, localMeshIndex) * vec4(position, 1.0);
 	gl_Position = projection * view * modelPos;
 
     vs_out.materialIndex = GetLocalMeshOrMaterialIndex(aTexCoord);
@@ -7,6 +7,8 @@ struct MeshData
 {
 	mat4 globalTransform;
 	mat4 globalInvTransform;
+	vec4 positionScale; //w is 1 if the mesh uses quantized vertices
+	vec4 positionBias;
 };
 
 layout (std430, binding=10) buffer MeshDataBuffer
@@ -18,9 +18,11 @@ invariant gl_Position;
 
 void main()
 {
-	vec4 modelPos = GetStaticModel(DrawID, GetLocalMeshOrMaterialIndex(aTexCoord1)) * vec4(aPos, 1.0);
+	uint localMeshIndex = GetLocalMeshOrMaterialIndex(aTexCoord1);
+	MeshData mesh = GetMeshData(DrawID, localMeshIndex);
+	vec4 modelPos = GetStaticModel(DrawID, localMeshIndex) * vec4(DecodeMeshPosition(mesh, aPos), 1.0);
 	
-	vec4 Normal = vec4(mat3(transpose(inverse(models[DrawID]))) * aNormal, 0.0);
+	vec4 Normal = vec4(mat3(transpose(inverse(models[DrawID]))) * DecodeMeshDirection(mesh, aNormal), 0.0);
 
 	gl_Position = projection * view * (modelPos + Normal*0.05);
 
@@ -9,5 +9,7 @@
 
 void main()
 {
-	gl_Position = GetStaticModel(DrawID, GetLocalMeshOrMaterialIndex(aTexCoord1)) * vec4(aPos, 1.0);
+	uint localMeshIndex = GetLocalMeshOrMaterialIndex(aTexCoord1);
+	vec3 position = DecodeMeshPosition(GetMeshData(DrawID, localMeshIndex), aPos);
+	gl_Position = GetStaticModel(DrawID, localMeshIndex) * vec4(position, 1.0);
 }
\ No newline at end of file
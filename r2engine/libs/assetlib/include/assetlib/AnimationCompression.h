@@ -0,0 +1,16 @@
+#ifndef __ASSET_LIB_ANIMATION_COMPRESSION_H__
+#define __ASSET_LIB_ANIMATION_COMPRESSION_H__
+
+#include <cstdint>
+
+namespace r2::assets::assetlib
+{
+	//Quantizes value to 3 u16s across the range [rangeMin, rangeMin + rangeExtent]. Decodes as rangeMin + (v / 65535) * rangeExtent.
+	void QuantizeVectorKey(const float value[3], const float rangeMin[3], const float rangeExtent[3], uint16_t outValues[3]);
+
+	//Quantizes rotation (x, y, z, w) to 3 u16s with smallest three - the largest component is dropped and rebuilt from the other 3 since
+	//the quaternion is unit length. The 3 that are left get 15 bits each and the index of the dropped one goes in the top bit of the first 2.
+	void QuantizeQuaternionKey(const float rotation[4], uint16_t outValues[3]);
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef __ASSET_LIB_MESH_OPTIMIZE_H__
+#define __ASSET_LIB_MESH_OPTIMIZE_H__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace r2::assets::assetlib
+{
+	//Reorders the triangles of indices so they make better use of the post transform vertex cache (Forsyth's linear speed algorithm)
+	void OptimizeVertexCache(uint32_t* indices, size_t numIndices, size_t numVertices);
+
+	//Reorders the clusters of triangles that OptimizeVertexCache made so the outward facing ones come first, which cuts down on overdraw.
+	//The new order is only kept if its ACMR is within threshold * the ACMR of the current order. positionStride is in bytes.
+	void OptimizeOverdraw(uint32_t* indices, size_t numIndices, const float* positions, size_t numVertices, size_t positionStride, float threshold);
+
+	//Fills remap (numVertices long) with the new location of each vertex so that they're fetched in the order indices first uses them.
+	//Unused vertices are moved to the end. indices is rewritten to use the new locations.
+	void OptimizeVertexFetchRemap(uint32_t* remap, uint32_t* indices, size_t numIndices, size_t numVertices);
+
+	//Simplifies the triangles of indices by clustering the vertices on a grid with cells targetError big. Only existing vertices are referenced
+	//so the result can share the vertex buffer with the source. destination must hold numIndices. Returns the number of indices written and sets
+	//resultError to the furthest any vertex was moved.
+	size_t SimplifyMesh(uint32_t* destination, const uint32_t* indices, size_t numIndices, const float* positions, size_t numVertices, size_t positionStride, float targetError, float& resultError);
+
+	//Average number of vertex cache misses per triangle for a FIFO cache of cacheSize
+	float CalculateACMR(const uint32_t* indices, size_t numIndices, size_t numVertices, uint32_t cacheSize);
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define __ASSET_LIB_MODEL_CONVERT_H__
 
 #include <filesystem>
+#include <vector>
 
 namespace r2::assets::assetlib
 {
@@ -13,7 +14,11 @@ namespace r2::assets::assetlib
 		const std::filesystem::path& engineTexturePacksManifestFile,
 		const std::filesystem::path& texturePacksManifestFile,
 		bool forceRebuild,
-		uint32_t numAnimationSamples);
+		uint32_t numAnimationSamples,
+		bool compressAnimations = false,
+		float animationCompressionTolerance = 0.0005f,
+		bool quantizeVertices = false,
+		const std::vector<float>& lodErrorTargets = {});
 }
 
 #endif
\ No newline at end of file
@@ -23,7 +23,8 @@ struct RChannelMetaData FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_NUMBEROFSAMPLEDPOSITIONFRAMES = 10,
     VT_NUMBEROFSAMPLEDSCALEFRAMES = 12,
     VT_NUMBEROFSAMPLEDROTATIONFRAMES = 14,
-    VT_NUMBEROFANIMATIONSAMPLES = 16
+    VT_NUMBEROFANIMATIONSAMPLES = 16,
+    VT_ISCOMPRESSED = 18
   };
   uint32_t numPositionKeys() const {
     return GetField<uint32_t>(VT_NUMPOSITIONKEYS, 0);
@@ -67,6 +68,12 @@ struct RChannelMetaData FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   bool mutate_numberOfAnimationSamples(uint32_t _numberOfAnimationSamples) {
     return SetField<uint32_t>(VT_NUMBEROFANIMATIONSAMPLES, _numberOfAnimationSamples, 0);
   }
+  bool isCompressed() const {
+    return GetField<uint8_t>(VT_ISCOMPRESSED, 0) != 0;
+  }
+  bool mutate_isCompressed(bool _isCompressed) {
+    return SetField<uint8_t>(VT_ISCOMPRESSED, static_cast<uint8_t>(_isCompressed), 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint32_t>(verifier, VT_NUMPOSITIONKEYS) &&
@@ -76,6 +83,7 @@ struct RChannelMetaData FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<uint32_t>(verifier, VT_NUMBEROFSAMPLEDSCALEFRAMES) &&
            VerifyField<uint32_t>(verifier, VT_NUMBEROFSAMPLEDROTATIONFRAMES) &&
            VerifyField<uint32_t>(verifier, VT_NUMBEROFANIMATIONSAMPLES) &&
+           VerifyField<uint8_t>(verifier, VT_ISCOMPRESSED) &&
            verifier.EndTable();
   }
 };
@@ -105,6 +113,9 @@ struct RChannelMetaDataBuilder {
   void add_numberOfAnimationSamples(uint32_t numberOfAnimationSamples) {
     fbb_.AddElement<uint32_t>(RChannelMetaData::VT_NUMBEROFANIMATIONSAMPLES, numberOfAnimationSamples, 0);
   }
+  void add_isCompressed(bool isCompressed) {
+    fbb_.AddElement<uint8_t>(RChannelMetaData::VT_ISCOMPRESSED, static_cast<uint8_t>(isCompressed), 0);
+  }
   explicit RChannelMetaDataBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -125,7 +136,8 @@ inline flatbuffers::Offset<RChannelMetaData> CreateRChannelMetaData(
     uint32_t numberOfSampledPositionFrames = 0,
     uint32_t numberOfSampledScaleFrames = 0,
     uint32_t numberOfSampledRotationFrames = 0,
-    uint32_t numberOfAnimationSamples = 0) {
+    uint32_t numberOfAnimationSamples = 0,
+    bool isCompressed = false) {
   RChannelMetaDataBuilder builder_(_fbb);
   builder_.add_numberOfAnimationSamples(numberOfAnimationSamples);
   builder_.add_numberOfSampledRotationFrames(numberOfSampledRotationFrames);
@@ -134,6 +146,7 @@ inline flatbuffers::Offset<RChannelMetaData> CreateRChannelMetaData(
   builder_.add_numRotationKeys(numRotationKeys);
   builder_.add_numScaleKeys(numScaleKeys);
   builder_.add_numPositionKeys(numPositionKeys);
+  builder_.add_isCompressed(isCompressed);
   return builder_.Finish();
 }
 
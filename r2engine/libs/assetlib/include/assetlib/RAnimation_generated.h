@@ -31,6 +31,9 @@ struct VectorTrackBuilder;
 struct QuaternionTrack;
 struct QuaternionTrackBuilder;
 
+struct CompressedTrack;
+struct CompressedTrackBuilder;
+
 struct TransformTrack;
 struct TransformTrackBuilder;
 
@@ -547,6 +550,124 @@ inline flatbuffers::Offset<QuaternionTrack> CreateQuaternionTrackDirect(
       trackInfo);
 }
 
+struct CompressedTrack FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef CompressedTrackBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_TIMES = 4,
+    VT_VALUES = 6,
+    VT_RANGEMIN = 8,
+    VT_RANGEEXTENT = 10,
+    VT_TRACKINFO = 12
+  };
+  const flatbuffers::Vector<float> *times() const {
+    return GetPointer<const flatbuffers::Vector<float> *>(VT_TIMES);
+  }
+  flatbuffers::Vector<float> *mutable_times() {
+    return GetPointer<flatbuffers::Vector<float> *>(VT_TIMES);
+  }
+  const flatbuffers::Vector<uint16_t> *values() const {
+    return GetPointer<const flatbuffers::Vector<uint16_t> *>(VT_VALUES);
+  }
+  flatbuffers::Vector<uint16_t> *mutable_values() {
+    return GetPointer<flatbuffers::Vector<uint16_t> *>(VT_VALUES);
+  }
+  const flat::Vertex3 *rangeMin() const {
+    return GetStruct<const flat::Vertex3 *>(VT_RANGEMIN);
+  }
+  flat::Vertex3 *mutable_rangeMin() {
+    return GetStruct<flat::Vertex3 *>(VT_RANGEMIN);
+  }
+  const flat::Vertex3 *rangeExtent() const {
+    return GetStruct<const flat::Vertex3 *>(VT_RANGEEXTENT);
+  }
+  flat::Vertex3 *mutable_rangeExtent() {
+    return GetStruct<flat::Vertex3 *>(VT_RANGEEXTENT);
+  }
+  const flat::TrackInfo *trackInfo() const {
+    return GetPointer<const flat::TrackInfo *>(VT_TRACKINFO);
+  }
+  flat::TrackInfo *mutable_trackInfo() {
+    return GetPointer<flat::TrackInfo *>(VT_TRACKINFO);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_TIMES) &&
+           verifier.VerifyVector(times()) &&
+           VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) &&
+           VerifyField<flat::Vertex3>(verifier, VT_RANGEMIN) &&
+           VerifyField<flat::Vertex3>(verifier, VT_RANGEEXTENT) &&
+           VerifyOffset(verifier, VT_TRACKINFO) &&
+           verifier.VerifyTable(trackInfo()) &&
+           verifier.EndTable();
+  }
+};
+
+struct CompressedTrackBuilder {
+  typedef CompressedTrack Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_times(flatbuffers::Offset<flatbuffers::Vector<float>> times) {
+    fbb_.AddOffset(CompressedTrack::VT_TIMES, times);
+  }
+  void add_values(flatbuffers::Offset<flatbuffers::Vector<uint16_t>> values) {
+    fbb_.AddOffset(CompressedTrack::VT_VALUES, values);
+  }
+  void add_rangeMin(const flat::Vertex3 *rangeMin) {
+    fbb_.AddStruct(CompressedTrack::VT_RANGEMIN, rangeMin);
+  }
+  void add_rangeExtent(const flat::Vertex3 *rangeExtent) {
+    fbb_.AddStruct(CompressedTrack::VT_RANGEEXTENT, rangeExtent);
+  }
+  void add_trackInfo(flatbuffers::Offset<flat::TrackInfo> trackInfo) {
+    fbb_.AddOffset(CompressedTrack::VT_TRACKINFO, trackInfo);
+  }
+  explicit CompressedTrackBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  CompressedTrackBuilder &operator=(const CompressedTrackBuilder &);
+  flatbuffers::Offset<CompressedTrack> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<CompressedTrack>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<CompressedTrack> CreateCompressedTrack(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<float>> times = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint16_t>> values = 0,
+    const flat::Vertex3 *rangeMin = 0,
+    const flat::Vertex3 *rangeExtent = 0,
+    flatbuffers::Offset<flat::TrackInfo> trackInfo = 0) {
+  CompressedTrackBuilder builder_(_fbb);
+  builder_.add_trackInfo(trackInfo);
+  builder_.add_rangeExtent(rangeExtent);
+  builder_.add_rangeMin(rangeMin);
+  builder_.add_values(values);
+  builder_.add_times(times);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<CompressedTrack> CreateCompressedTrackDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<float> *times = nullptr,
+    const std::vector<uint16_t> *values = nullptr,
+    const flat::Vertex3 *rangeMin = 0,
+    const flat::Vertex3 *rangeExtent = 0,
+    flatbuffers::Offset<flat::TrackInfo> trackInfo = 0) {
+  auto times__ = times ? _fbb.CreateVector<float>(*times) : 0;
+  auto values__ = values ? _fbb.CreateVector<uint16_t>(*values) : 0;
+  return flat::CreateCompressedTrack(
+      _fbb,
+      times__,
+      values__,
+      rangeMin,
+      rangeExtent,
+      trackInfo);
+}
+
 struct TransformTrack FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef TransformTrackBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
@@ -555,7 +676,10 @@ struct TransformTrack FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_ROTATIONTRACK = 8,
     VT_SCALETRACK = 10,
     VT_STARTTIME = 12,
-    VT_ENDTIME = 14
+    VT_ENDTIME = 14,
+    VT_COMPRESSEDPOSITIONTRACK = 16,
+    VT_COMPRESSEDROTATIONTRACK = 18,
+    VT_COMPRESSEDSCALETRACK = 20
   };
   int32_t jointID() const {
     return GetField<int32_t>(VT_JOINTID, 0);
@@ -593,6 +717,24 @@ struct TransformTrack FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   bool mutate_endTime(float _endTime) {
     return SetField<float>(VT_ENDTIME, _endTime, 0.0f);
   }
+  const flat::CompressedTrack *compressedPositionTrack() const {
+    return GetPointer<const flat::CompressedTrack *>(VT_COMPRESSEDPOSITIONTRACK);
+  }
+  flat::CompressedTrack *mutable_compressedPositionTrack() {
+    return GetPointer<flat::CompressedTrack *>(VT_COMPRESSEDPOSITIONTRACK);
+  }
+  const flat::CompressedTrack *compressedRotationTrack() const {
+    return GetPointer<const flat::CompressedTrack *>(VT_COMPRESSEDROTATIONTRACK);
+  }
+  flat::CompressedTrack *mutable_compressedRotationTrack() {
+    return GetPointer<flat::CompressedTrack *>(VT_COMPRESSEDROTATIONTRACK);
+  }
+  const flat::CompressedTrack *compressedScaleTrack() const {
+    return GetPointer<const flat::CompressedTrack *>(VT_COMPRESSEDSCALETRACK);
+  }
+  flat::CompressedTrack *mutable_compressedScaleTrack() {
+    return GetPointer<flat::CompressedTrack *>(VT_COMPRESSEDSCALETRACK);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int32_t>(verifier, VT_JOINTID) &&
@@ -604,6 +746,12 @@ struct TransformTrack FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyTable(scaleTrack()) &&
            VerifyField<float>(verifier, VT_STARTTIME) &&
            VerifyField<float>(verifier, VT_ENDTIME) &&
+           VerifyOffset(verifier, VT_COMPRESSEDPOSITIONTRACK) &&
+           verifier.VerifyTable(compressedPositionTrack()) &&
+           VerifyOffset(verifier, VT_COMPRESSEDROTATIONTRACK) &&
+           verifier.VerifyTable(compressedRotationTrack()) &&
+           VerifyOffset(verifier, VT_COMPRESSEDSCALETRACK) &&
+           verifier.VerifyTable(compressedScaleTrack()) &&
            verifier.EndTable();
   }
 };
@@ -630,6 +778,15 @@ struct TransformTrackBuilder {
   void add_endTime(float endTime) {
     fbb_.AddElement<float>(TransformTrack::VT_ENDTIME, endTime, 0.0f);
   }
+  void add_compressedPositionTrack(flatbuffers::Offset<flat::CompressedTrack> compressedPositionTrack) {
+    fbb_.AddOffset(TransformTrack::VT_COMPRESSEDPOSITIONTRACK, compressedPositionTrack);
+  }
+  void add_compressedRotationTrack(flatbuffers::Offset<flat::CompressedTrack> compressedRotationTrack) {
+    fbb_.AddOffset(TransformTrack::VT_COMPRESSEDROTATIONTRACK, compressedRotationTrack);
+  }
+  void add_compressedScaleTrack(flatbuffers::Offset<flat::CompressedTrack> compressedScaleTrack) {
+    fbb_.AddOffset(TransformTrack::VT_COMPRESSEDSCALETRACK, compressedScaleTrack);
+  }
   explicit TransformTrackBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -649,8 +806,14 @@ inline flatbuffers::Offset<TransformTrack> CreateTransformTrack(
     flatbuffers::Offset<flat::QuaternionTrack> rotationTrack = 0,
     flatbuffers::Offset<flat::VectorTrack> scaleTrack = 0,
     float startTime = 0.0f,
-    float endTime = 0.0f) {
+    float endTime = 0.0f,
+    flatbuffers::Offset<flat::CompressedTrack> compressedPositionTrack = 0,
+    flatbuffers::Offset<flat::CompressedTrack> compressedRotationTrack = 0,
+    flatbuffers::Offset<flat::CompressedTrack> compressedScaleTrack = 0) {
   TransformTrackBuilder builder_(_fbb);
+  builder_.add_compressedScaleTrack(compressedScaleTrack);
+  builder_.add_compressedRotationTrack(compressedRotationTrack);
+  builder_.add_compressedPositionTrack(compressedPositionTrack);
   builder_.add_endTime(endTime);
   builder_.add_startTime(startTime);
   builder_.add_scaleTrack(scaleTrack);
@@ -59,29 +59,32 @@ inline const char *EnumNameMeshCompressionMode(MeshCompressionMode e) {
 enum VertexFormat {
   VertexFormat_UNKNOWN = 0,
   VertexFormat_P32N32UV32T32 = 1,
+  VertexFormat_P16N16UV16T16 = 2,
   VertexFormat_MIN = VertexFormat_UNKNOWN,
-  VertexFormat_MAX = VertexFormat_P32N32UV32T32
+  VertexFormat_MAX = VertexFormat_P16N16UV16T16
 };
 
-inline const VertexFormat (&EnumValuesVertexFormat())[2] {
+inline const VertexFormat (&EnumValuesVertexFormat())[3] {
   static const VertexFormat values[] = {
     VertexFormat_UNKNOWN,
-    VertexFormat_P32N32UV32T32
+    VertexFormat_P32N32UV32T32,
+    VertexFormat_P16N16UV16T16
   };
   return values;
 }
 
 inline const char * const *EnumNamesVertexFormat() {
-  static const char * const names[3] = {
+  static const char * const names[4] = {
     "UNKNOWN",
     "P32N32UV32T32",
+    "P16N16UV16T16",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameVertexFormat(VertexFormat e) {
-  if (flatbuffers::IsOutRange(e, VertexFormat_UNKNOWN, VertexFormat_P32N32UV32T32)) return "";
+  if (flatbuffers::IsOutRange(e, VertexFormat_UNKNOWN, VertexFormat_P16N16UV16T16)) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesVertexFormat()[index];
 }
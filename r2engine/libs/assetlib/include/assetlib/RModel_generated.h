@@ -12,6 +12,8 @@
 
 namespace flat {
 
+struct MeshLOD;
+
 struct RMesh;
 struct RMeshBuilder;
 
@@ -38,6 +40,42 @@ struct GLTFMeshInfoBuilder;
 struct RModel;
 struct RModelBuilder;
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) MeshLOD FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint32_t firstIndex_;
+  uint32_t numIndices_;
+  float error_;
+
+ public:
+  MeshLOD() {
+    memset(static_cast<void *>(this), 0, sizeof(MeshLOD));
+  }
+  MeshLOD(uint32_t _firstIndex, uint32_t _numIndices, float _error)
+      : firstIndex_(flatbuffers::EndianScalar(_firstIndex)),
+        numIndices_(flatbuffers::EndianScalar(_numIndices)),
+        error_(flatbuffers::EndianScalar(_error)) {
+  }
+  uint32_t firstIndex() const {
+    return flatbuffers::EndianScalar(firstIndex_);
+  }
+  void mutate_firstIndex(uint32_t _firstIndex) {
+    flatbuffers::WriteScalar(&firstIndex_, _firstIndex);
+  }
+  uint32_t numIndices() const {
+    return flatbuffers::EndianScalar(numIndices_);
+  }
+  void mutate_numIndices(uint32_t _numIndices) {
+    flatbuffers::WriteScalar(&numIndices_, _numIndices);
+  }
+  float error() const {
+    return flatbuffers::EndianScalar(error_);
+  }
+  void mutate_error(float _error) {
+    flatbuffers::WriteScalar(&error_, _error);
+  }
+};
+FLATBUFFERS_STRUCT_END(MeshLOD, 12);
+
 FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) Transform FLATBUFFERS_FINAL_CLASS {
  private:
   float position_[3];
@@ -189,7 +227,8 @@ struct RMesh FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef RMeshBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_MATERIALINDEX = 4,
-    VT_DATA = 6
+    VT_DATA = 6,
+    VT_LODS = 8
   };
   int32_t materialIndex() const {
     return GetField<int32_t>(VT_MATERIALINDEX, 0);
@@ -203,11 +242,19 @@ struct RMesh FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   flatbuffers::Vector<int8_t> *mutable_data() {
     return GetPointer<flatbuffers::Vector<int8_t> *>(VT_DATA);
   }
+  const flatbuffers::Vector<const flat::MeshLOD *> *lods() const {
+    return GetPointer<const flatbuffers::Vector<const flat::MeshLOD *> *>(VT_LODS);
+  }
+  flatbuffers::Vector<const flat::MeshLOD *> *mutable_lods() {
+    return GetPointer<flatbuffers::Vector<const flat::MeshLOD *> *>(VT_LODS);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int32_t>(verifier, VT_MATERIALINDEX) &&
            VerifyOffset(verifier, VT_DATA) &&
            verifier.VerifyVector(data()) &&
+           VerifyOffset(verifier, VT_LODS) &&
+           verifier.VerifyVector(lods()) &&
            verifier.EndTable();
   }
 };
@@ -222,6 +269,9 @@ struct RMeshBuilder {
   void add_data(flatbuffers::Offset<flatbuffers::Vector<int8_t>> data) {
     fbb_.AddOffset(RMesh::VT_DATA, data);
   }
+  void add_lods(flatbuffers::Offset<flatbuffers::Vector<const flat::MeshLOD *>> lods) {
+    fbb_.AddOffset(RMesh::VT_LODS, lods);
+  }
   explicit RMeshBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -237,8 +287,10 @@ struct RMeshBuilder {
 inline flatbuffers::Offset<RMesh> CreateRMesh(
     flatbuffers::FlatBufferBuilder &_fbb,
     int32_t materialIndex = 0,
-    flatbuffers::Offset<flatbuffers::Vector<int8_t>> data = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<int8_t>> data = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const flat::MeshLOD *>> lods = 0) {
   RMeshBuilder builder_(_fbb);
+  builder_.add_lods(lods);
   builder_.add_data(data);
   builder_.add_materialIndex(materialIndex);
   return builder_.Finish();
@@ -247,12 +299,15 @@ inline flatbuffers::Offset<RMesh> CreateRMesh(
 inline flatbuffers::Offset<RMesh> CreateRMeshDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     int32_t materialIndex = 0,
-    const std::vector<int8_t> *data = nullptr) {
+    const std::vector<int8_t> *data = nullptr,
+    const std::vector<flat::MeshLOD> *lods = nullptr) {
   auto data__ = data ? _fbb.CreateVector<int8_t>(*data) : 0;
+  auto lods__ = lods ? _fbb.CreateVectorOfStructs<flat::MeshLOD>(*lods) : 0;
   return flat::CreateRMesh(
       _fbb,
       materialIndex,
-      data__);
+      data__,
+      lods__);
 }
 
 struct AnimationData FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
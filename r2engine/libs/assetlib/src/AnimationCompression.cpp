@@ -0,0 +1,62 @@
+#include "assetlib/AnimationCompression.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <cmath>
+
+namespace r2::assets::assetlib
+{
+	namespace
+	{
+		constexpr float QUAT_COMPONENT_RANGE = 0.70710678118f; // 1/sqrt(2) - the largest the 3 smallest components of a unit quaternion can be
+		constexpr uint16_t QUAT_COMPONENT_MAX = 0x7FFF;
+		constexpr uint16_t VECTOR_COMPONENT_MAX = 0xFFFF;
+
+		uint16_t QuantizeUnit(float v, uint16_t maxValue)
+		{
+			return static_cast<uint16_t>(glm::clamp(v, 0.0f, 1.0f) * static_cast<float>(maxValue) + 0.5f);
+		}
+	}
+
+	void QuantizeVectorKey(const float value[3], const float rangeMin[3], const float rangeExtent[3], uint16_t outValues[3])
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			float normalized = rangeExtent[c] > 0.0f ? (value[c] - rangeMin[c]) / rangeExtent[c] : 0.0f;
+			outValues[c] = QuantizeUnit(normalized, VECTOR_COMPONENT_MAX);
+		}
+	}
+
+	void QuantizeQuaternionKey(const float rotation[4], uint16_t outValues[3])
+	{
+		glm::quat q = glm::normalize(glm::quat(rotation[3], rotation[0], rotation[1], rotation[2]));
+		float components[4] = { q.x, q.y, q.z, q.w };
+
+		uint32_t largestIndex = 0;
+		for (uint32_t c = 1; c < 4; ++c)
+		{
+			if (fabsf(components[c]) > fabsf(components[largestIndex]))
+			{
+				largestIndex = c;
+			}
+		}
+
+		//flip the quaternion so the dropped component is positive - q and -q are the same rotation
+		const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+		uint32_t next = 0;
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			if (c == largestIndex)
+			{
+				continue;
+			}
+
+			float normalized = (components[c] * sign + QUAT_COMPONENT_RANGE) / (2.0f * QUAT_COMPONENT_RANGE);
+			outValues[next++] = QuantizeUnit(normalized, QUAT_COMPONENT_MAX);
+		}
+
+		outValues[0] |= static_cast<uint16_t>((largestIndex >> 1) << 15);
+		outValues[1] |= static_cast<uint16_t>((largestIndex & 1) << 15);
+	}
+}
@@ -0,0 +1,564 @@
+#include "assetlib/MeshOptimize.h"
+
+#include <glm/glm.hpp>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace r2::assets::assetlib
+{
+	namespace
+	{
+		//Tuning values from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+		constexpr uint32_t VERTEX_CACHE_SIZE = 32;
+		constexpr float CACHE_DECAY_POWER = 1.5f;
+		constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+		constexpr float VALENCE_BOOST_SCALE = 2.0f;
+		constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+		//What we measure against - roughly what the hardware we care about has
+		constexpr uint32_t FIFO_CACHE_SIZE = 16;
+
+		constexpr uint32_t MAX_GRID_CELL = (1u << 21) - 1;
+		constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+		float VertexScore(int32_t cachePosition, uint32_t numActiveTriangles)
+		{
+			if (numActiveTriangles == 0)
+			{
+				//nothing left to draw with this vertex
+				return -1.0f;
+			}
+
+			float score = 0.0f;
+
+			if (cachePosition >= 0)
+			{
+				if (cachePosition < 3)
+				{
+					//used by the last triangle - don't favour it too much or we'll make strips
+					score = LAST_TRIANGLE_SCORE;
+				}
+				else
+				{
+					const float scaler = 1.0f / static_cast<float>(VERTEX_CACHE_SIZE - 3);
+					score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+				}
+			}
+
+			//boost the vertices with few triangles left so we finish them off instead of leaving lone triangles behind
+			score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(numActiveTriangles), -VALENCE_BOOST_POWER);
+
+			return score;
+		}
+
+		glm::vec3 GetPosition(const float* positions, size_t positionStride, size_t vertex)
+		{
+			const float* position = reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + vertex * positionStride);
+			return glm::vec3(position[0], position[1], position[2]);
+		}
+
+		struct TriangleHash
+		{
+			size_t operator()(const std::array<uint32_t, 3>& triangle) const
+			{
+				size_t hash = triangle[0];
+				hash = hash * 31 + triangle[1];
+				hash = hash * 31 + triangle[2];
+				return hash;
+			}
+		};
+	}
+
+	void OptimizeVertexCache(uint32_t* indices, size_t numIndices, size_t numVertices)
+	{
+		assert(numIndices % 3 == 0 && "Indices should be a list of triangles");
+
+		const size_t numTriangles = numIndices / 3;
+
+		if (numTriangles == 0)
+		{
+			return;
+		}
+
+		//Build the list of triangles each vertex is used by
+		std::vector<uint32_t> numActiveTriangles(numVertices, 0);
+
+		for (size_t i = 0; i < numIndices; ++i)
+		{
+			assert(indices[i] < numVertices && "Index is out of range of the vertices");
+			numActiveTriangles[indices[i]]++;
+		}
+
+		std::vector<uint32_t> triangleOffsets(numVertices, 0);
+		uint32_t offset = 0;
+
+		for (size_t v = 0; v < numVertices; ++v)
+		{
+			triangleOffsets[v] = offset;
+			offset += numActiveTriangles[v];
+		}
+
+		std::vector<uint32_t> vertexTriangles(numIndices);
+		{
+			std::vector<uint32_t> fillOffsets = triangleOffsets;
+
+			for (size_t t = 0; t < numTriangles; ++t)
+			{
+				for (size_t k = 0; k < 3; ++k)
+				{
+					vertexTriangles[fillOffsets[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+				}
+			}
+		}
+
+		std::vector<int32_t> cachePositions(numVertices, -1);
+		std::vector<float> vertexScores(numVertices, 0.0f);
+
+		for (size_t v = 0; v < numVertices; ++v)
+		{
+			vertexScores[v] = VertexScore(-1, numActiveTriangles[v]);
+		}
+
+		std::vector<float> triangleScores(numTriangles, 0.0f);
+		std::vector<bool> emitted(numTriangles, false);
+
+		int64_t bestTriangle = -1;
+		float bestScore = std::numeric_limits<float>::lowest();
+
+		for (size_t t = 0; t < numTriangles; ++t)
+		{
+			triangleScores[t] = vertexScores[indices[t * 3 + 0]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+
+			if (triangleScores[t] > bestScore)
+			{
+				bestScore = triangleScores[t];
+				bestTriangle = static_cast<int64_t>(t);
+			}
+		}
+
+		std::vector<uint32_t> result;
+		result.reserve(numIndices);
+
+		uint32_t cache[VERTEX_CACHE_SIZE + 3];
+		uint32_t newCache[VERTEX_CACHE_SIZE + 3];
+		size_t cacheSize = 0;
+		size_t nextUnemittedTriangle = 0;
+
+		while (result.size() < numIndices)
+		{
+			if (bestTriangle < 0)
+			{
+				//nothing in the cache is connected to what's left - start over from the next triangle we haven't drawn
+				while (emitted[nextUnemittedTriangle])
+				{
+					++nextUnemittedTriangle;
+				}
+
+				bestTriangle = static_cast<int64_t>(nextUnemittedTriangle);
+			}
+
+			const uint32_t* triangle = &indices[bestTriangle * 3];
+			emitted[bestTriangle] = true;
+
+			size_t newCacheSize = 0;
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				const uint32_t v = triangle[k];
+				result.push_back(v);
+
+				//remove the triangle from the vertex's active triangles
+				uint32_t* activeTriangles = &vertexTriangles[triangleOffsets[v]];
+				const uint32_t numActive = numActiveTriangles[v];
+
+				for (uint32_t j = 0; j < numActive; ++j)
+				{
+					if (activeTriangles[j] == static_cast<uint32_t>(bestTriangle))
+					{
+						activeTriangles[j] = activeTriangles[numActive - 1];
+						break;
+					}
+				}
+
+				numActiveTriangles[v]--;
+
+				if (std::find(newCache, newCache + newCacheSize, v) == newCache + newCacheSize)
+				{
+					newCache[newCacheSize++] = v;
+				}
+			}
+
+			for (size_t c = 0; c < cacheSize; ++c)
+			{
+				const uint32_t v = cache[c];
+
+				if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+				{
+					newCache[newCacheSize++] = v;
+				}
+			}
+
+			//Update the scores of everything that moved in the cache, including what got pushed out of it
+			for (size_t c = 0; c < newCacheSize; ++c)
+			{
+				const uint32_t v = newCache[c];
+
+				cachePositions[v] = c < VERTEX_CACHE_SIZE ? static_cast<int32_t>(c) : -1;
+
+				const float newScore = VertexScore(cachePositions[v], numActiveTriangles[v]);
+				const float scoreDelta = newScore - vertexScores[v];
+				vertexScores[v] = newScore;
+
+				const uint32_t* activeTriangles = &vertexTriangles[triangleOffsets[v]];
+
+				for (uint32_t j = 0; j < numActiveTriangles[v]; ++j)
+				{
+					triangleScores[activeTriangles[j]] += scoreDelta;
+				}
+			}
+
+			cacheSize = std::min(newCacheSize, static_cast<size_t>(VERTEX_CACHE_SIZE));
+			memcpy(cache, newCache, sizeof(uint32_t) * cacheSize);
+
+			//The next triangle is the best one that uses something in the cache
+			bestTriangle = -1;
+			bestScore = std::numeric_limits<float>::lowest();
+
+			for (size_t c = 0; c < cacheSize; ++c)
+			{
+				const uint32_t v = cache[c];
+				const uint32_t* activeTriangles = &vertexTriangles[triangleOffsets[v]];
+
+				for (uint32_t j = 0; j < numActiveTriangles[v]; ++j)
+				{
+					const uint32_t t = activeTriangles[j];
+
+					if (triangleScores[t] > bestScore)
+					{
+						bestScore = triangleScores[t];
+						bestTriangle = static_cast<int64_t>(t);
+					}
+				}
+			}
+		}
+
+		memcpy(indices, result.data(), sizeof(uint32_t) * numIndices);
+	}
+
+	void OptimizeOverdraw(uint32_t* indices, size_t numIndices, const float* positions, size_t numVertices, size_t positionStride, float threshold)
+	{
+		const size_t numTriangles = numIndices / 3;
+
+		if (numTriangles < 2)
+		{
+			return;
+		}
+
+		//Split the triangles into clusters wherever the cache has to start over - ie. none of the triangle's vertices are in it
+		std::vector<size_t> clusterStarts;
+		{
+			std::vector<uint32_t> cacheTimestamps(numVertices, 0);
+			uint32_t timestamp = FIFO_CACHE_SIZE + 1;
+
+			for (size_t t = 0; t < numTriangles; ++t)
+			{
+				uint32_t numMisses = 0;
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					const uint32_t v = indices[t * 3 + k];
+
+					if (timestamp - cacheTimestamps[v] > FIFO_CACHE_SIZE)
+					{
+						cacheTimestamps[v] = timestamp++;
+						++numMisses;
+					}
+				}
+
+				if (t == 0 || numMisses == 3)
+				{
+					clusterStarts.push_back(t);
+				}
+			}
+		}
+
+		if (clusterStarts.size() < 2)
+		{
+			return;
+		}
+
+		glm::vec3 meshCentroid = glm::vec3(0.0f);
+
+		for (size_t i = 0; i < numIndices; ++i)
+		{
+			meshCentroid += GetPosition(positions, positionStride, indices[i]);
+		}
+
+		meshCentroid /= static_cast<float>(numIndices);
+
+		struct Cluster
+		{
+			size_t firstTriangle;
+			size_t numTriangles;
+			float sortKey;
+		};
+
+		std::vector<Cluster> clusters(clusterStarts.size());
+
+		for (size_t c = 0; c < clusterStarts.size(); ++c)
+		{
+			const size_t firstTriangle = clusterStarts[c];
+			const size_t endTriangle = c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : numTriangles;
+
+			glm::vec3 centroid = glm::vec3(0.0f);
+			glm::vec3 normal = glm::vec3(0.0f);
+			float totalArea = 0.0f;
+
+			for (size_t t = firstTriangle; t < endTriangle; ++t)
+			{
+				const glm::vec3 p0 = GetPosition(positions, positionStride, indices[t * 3 + 0]);
+				const glm::vec3 p1 = GetPosition(positions, positionStride, indices[t * 3 + 1]);
+				const glm::vec3 p2 = GetPosition(positions, positionStride, indices[t * 3 + 2]);
+
+				//the length of the cross product is twice the area so this is area weighted
+				const glm::vec3 triangleNormal = glm::cross(p1 - p0, p2 - p0);
+				const float area = 0.5f * glm::length(triangleNormal);
+
+				normal += triangleNormal;
+				centroid += (p0 + p1 + p2) * (area / 3.0f);
+				totalArea += area;
+			}
+
+			const float normalLength = glm::length(normal);
+
+			clusters[c].firstTriangle = firstTriangle;
+			clusters[c].numTriangles = endTriangle - firstTriangle;
+			clusters[c].sortKey = 0.0f;
+
+			if (totalArea > 0.0f && normalLength > 0.0f)
+			{
+				//clusters facing away from the middle of the mesh are more likely to occlude the rest of it
+				clusters[c].sortKey = glm::dot(centroid / totalArea - meshCentroid, normal / normalLength);
+			}
+		}
+
+		std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b)
+		{
+			return a.sortKey > b.sortKey;
+		});
+
+		std::vector<uint32_t> result;
+		result.reserve(numIndices);
+
+		for (const auto& cluster : clusters)
+		{
+			result.insert(result.end(), indices + cluster.firstTriangle * 3, indices + (cluster.firstTriangle + cluster.numTriangles) * 3);
+		}
+
+		const float currentACMR = CalculateACMR(indices, numIndices, numVertices, FIFO_CACHE_SIZE);
+		const float newACMR = CalculateACMR(result.data(), numIndices, numVertices, FIFO_CACHE_SIZE);
+
+		if (newACMR <= currentACMR * threshold)
+		{
+			memcpy(indices, result.data(), sizeof(uint32_t) * numIndices);
+		}
+	}
+
+	void OptimizeVertexFetchRemap(uint32_t* remap, uint32_t* indices, size_t numIndices, size_t numVertices)
+	{
+		std::fill(remap, remap + numVertices, INVALID_INDEX);
+
+		uint32_t nextVertex = 0;
+
+		for (size_t i = 0; i < numIndices; ++i)
+		{
+			const uint32_t v = indices[i];
+
+			assert(v < numVertices && "Index is out of range of the vertices");
+
+			if (remap[v] == INVALID_INDEX)
+			{
+				remap[v] = nextVertex++;
+			}
+
+			indices[i] = remap[v];
+		}
+
+		for (size_t v = 0; v < numVertices; ++v)
+		{
+			if (remap[v] == INVALID_INDEX)
+			{
+				remap[v] = nextVertex++;
+			}
+		}
+	}
+
+	size_t SimplifyMesh(uint32_t* destination, const uint32_t* indices, size_t numIndices, const float* positions, size_t numVertices, size_t positionStride, float targetError, float& resultError)
+	{
+		resultError = 0.0f;
+
+		if (targetError <= 0.0f || numIndices == 0)
+		{
+			std::copy(indices, indices + numIndices, destination);
+			return numIndices;
+		}
+
+		glm::vec3 minBounds = glm::vec3(std::numeric_limits<float>::max());
+
+		for (size_t i = 0; i < numIndices; ++i)
+		{
+			minBounds = glm::min(minBounds, GetPosition(positions, positionStride, indices[i]));
+		}
+
+		struct Cell
+		{
+			glm::vec3 positionSum = glm::vec3(0.0f);
+			uint32_t numVertices = 0;
+			uint32_t representative = INVALID_INDEX;
+			float representativeDistance = std::numeric_limits<float>::max();
+		};
+
+		const float invCellSize = 1.0f / targetError;
+
+		std::vector<Cell> cells;
+		std::unordered_map<uint64_t, uint32_t> cellLookup;
+		std::vector<uint32_t> vertexCells(numVertices, INVALID_INDEX);
+
+		for (size_t i = 0; i < numIndices; ++i)
+		{
+			const uint32_t v = indices[i];
+
+			if (vertexCells[v] != INVALID_INDEX)
+			{
+				continue;
+			}
+
+			const glm::vec3 position = GetPosition(positions, positionStride, v);
+			const glm::vec3 gridPosition = glm::min((position - minBounds) * invCellSize, glm::vec3(static_cast<float>(MAX_GRID_CELL)));
+
+			const uint64_t key =
+				static_cast<uint64_t>(gridPosition.x) |
+				(static_cast<uint64_t>(gridPosition.y) << 21) |
+				(static_cast<uint64_t>(gridPosition.z) << 42);
+
+			auto iter = cellLookup.find(key);
+
+			if (iter == cellLookup.end())
+			{
+				iter = cellLookup.emplace(key, static_cast<uint32_t>(cells.size())).first;
+				cells.emplace_back();
+			}
+
+			Cell& cell = cells[iter->second];
+			cell.positionSum += position;
+			cell.numVertices++;
+
+			vertexCells[v] = iter->second;
+		}
+
+		//The vertex closest to the middle of its cell stands in for all of the others
+		for (size_t v = 0; v < numVertices; ++v)
+		{
+			if (vertexCells[v] == INVALID_INDEX)
+			{
+				continue;
+			}
+
+			Cell& cell = cells[vertexCells[v]];
+
+			const glm::vec3 delta = GetPosition(positions, positionStride, v) - cell.positionSum / static_cast<float>(cell.numVertices);
+			const float distance = glm::dot(delta, delta);
+
+			if (distance < cell.representativeDistance)
+			{
+				cell.representativeDistance = distance;
+				cell.representative = static_cast<uint32_t>(v);
+			}
+		}
+
+		for (size_t v = 0; v < numVertices; ++v)
+		{
+			if (vertexCells[v] == INVALID_INDEX)
+			{
+				continue;
+			}
+
+			const uint32_t representative = cells[vertexCells[v]].representative;
+
+			resultError = std::max(resultError, glm::length(GetPosition(positions, positionStride, v) - GetPosition(positions, positionStride, representative)));
+		}
+
+		std::unordered_set<std::array<uint32_t, 3>, TriangleHash> triangles;
+		size_t numResultIndices = 0;
+
+		for (size_t i = 0; i + 2 < numIndices; i += 3)
+		{
+			const uint32_t a = cells[vertexCells[indices[i + 0]]].representative;
+			const uint32_t b = cells[vertexCells[indices[i + 1]]].representative;
+			const uint32_t c = cells[vertexCells[indices[i + 2]]].representative;
+
+			//collapsed to a line or a point
+			if (a == b || b == c || a == c)
+			{
+				continue;
+			}
+
+			//rotate the smallest index to the front - keeps the winding but makes the same triangles compare equal
+			std::array<uint32_t, 3> key = { a, b, c };
+
+			if (b < a && b < c)
+			{
+				key = { b, c, a };
+			}
+			else if (c < a && c < b)
+			{
+				key = { c, a, b };
+			}
+
+			if (!triangles.insert(key).second)
+			{
+				continue;
+			}
+
+			destination[numResultIndices++] = a;
+			destination[numResultIndices++] = b;
+			destination[numResultIndices++] = c;
+		}
+
+		return numResultIndices;
+	}
+
+	float CalculateACMR(const uint32_t* indices, size_t numIndices, size_t numVertices, uint32_t cacheSize)
+	{
+		const size_t numTriangles = numIndices / 3;
+
+		if (numTriangles == 0)
+		{
+			return 0.0f;
+		}
+
+		std::vector<uint32_t> cacheTimestamps(numVertices, 0);
+		uint32_t timestamp = cacheSize + 1;
+		size_t numMisses = 0;
+
+		for (size_t i = 0; i < numIndices; ++i)
+		{
+			const uint32_t v = indices[i];
+
+			if (timestamp - cacheTimestamps[v] > cacheSize)
+			{
+				cacheTimestamps[v] = timestamp++;
+				++numMisses;
+			}
+		}
+
+		return static_cast<float>(numMisses) / static_cast<float>(numTriangles);
+	}
+}
@@ -112,7 +112,7 @@ namespace r2::assets::assetlib
 		Bounds bounds;
 
 		float min[3] = { std::numeric_limits<float>::max(),std::numeric_limits<float>::max(),std::numeric_limits<float>::max() };
-		float max[3] = { std::numeric_limits<float>::min(),std::numeric_limits<float>::min(),std::numeric_limits<float>::min() };
+		float max[3] = { std::numeric_limits<float>::lowest(),std::numeric_limits<float>::lowest(),std::numeric_limits<float>::lowest() };
 
 		for (int i = 0; i < numPositions; i++) 
 		{
@@ -6,6 +6,7 @@
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/string_cast.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include "Hash.h"
 
@@ -18,6 +19,8 @@
 #include "assetlib/RModelMetaData_generated.h"
 #include "assetlib/RModel_generated.h"
 #include "assetlib/ModelAsset.h"
+#include "assetlib/MeshOptimize.h"
+#include "assetlib/AnimationCompression.h"
 #include "assetlib/AssetUtils.h"
 
 #include <fastgltf/glm_element_traits.hpp>
@@ -25,8 +28,11 @@
 #include <fastgltf/tools.hpp>
 
 #include <unordered_map>
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include <map>
+#include <mutex>
 
 namespace fs = std::filesystem;
 
@@ -36,6 +42,13 @@ namespace r2::assets::assetlib
 
 	const float EPSILON = 0.00001f;
 
+	//Matches r2::draw::Mesh::MAX_NUM_LODS - LOD 0 is always the full mesh
+	const size_t MAX_NUM_MESH_LODS = 4;
+	//A LOD that doesn't remove at least this much of the previous one isn't worth the memory
+	const float MIN_LOD_REDUCTION = 0.25f;
+	//How much worse than the vertex cache order the overdraw order is allowed to make the ACMR
+	const float OVERDRAW_ACMR_THRESHOLD = 1.05f;
+
 	bool NearEq(float x, float y)
 	{
 		return fabsf(x - y) < EPSILON;
@@ -195,6 +208,18 @@ namespace r2::assets::assetlib
 		glm::vec3 texCoords1 = glm::vec3(0.0f);
 	};
 
+	//Matches r2::draw::QuantizedVertex (flat::VertexFormat_P16N16UV16T16)
+	struct QuantizedVertex
+	{
+		uint16_t position[4] = {};
+		int16_t normal[2] = {};
+		int16_t tangent[2] = {};
+		uint16_t texCoords0[4] = {};
+		uint16_t texCoords1[4] = {};
+	};
+
+	static_assert(sizeof(QuantizedVertex) == 32, "QuantizedVertex should be 32 bytes");
+
 	struct Pose
 	{
 		std::vector<int> parents;
@@ -444,11 +469,287 @@ namespace r2::assets::assetlib
 
 
 
+	//Animation compression
+	//Compressed tracks are always linear (or constant for step tracks). Cubic tracks get resampled into linear keys first, then
+	//every track has the keys removed that can be rebuilt from their neighbours within the tolerance and the rest get quantized to
+	//16 bits per component.
+	struct CompressedTrack
+	{
+		std::vector<uint32_t> mSampledFrames;
+		std::vector<float> mTimes;
+		std::vector<uint16_t> mValues;
+		glm::vec3 mRangeMin = glm::vec3(0);
+		glm::vec3 mRangeExtent = glm::vec3(0);
+		fastgltf::AnimationInterpolation interpolation;
+		unsigned int mNumberOfSamples = 0;
+	};
+
+	glm::vec3 LerpKey(const glm::vec3& a, const glm::vec3& b, float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	glm::quat LerpKey(const glm::quat& a, const glm::quat& b, float t)
+	{
+		glm::quat end = b;
+		if (glm::dot(a, end) < 0.0f)
+		{
+			end = -end;
+		}
+		return glm::slerp(a, end, t);
+	}
+
+	float KeyError(const glm::vec3& a, const glm::vec3& b)
+	{
+		glm::vec3 d = glm::abs(a - b);
+		return std::max(d.x, std::max(d.y, d.z));
+	}
+
+	float KeyError(const glm::quat& a, const glm::quat& b)
+	{
+		glm::quat other = b;
+		if (glm::dot(a, other) < 0.0f)
+		{
+			other = -other;
+		}
+
+		return std::max(std::max(fabsf(a.x - other.x), fabsf(a.y - other.y)), std::max(fabsf(a.z - other.z), fabsf(a.w - other.w)));
+	}
+
+	glm::vec3 HermiteKey(float t, const glm::vec3& p1, const glm::vec3& s1, const glm::vec3& p2, const glm::vec3& s2)
+	{
+		float tt = t * t;
+		float ttt = tt * t;
+		return p1 * (2.0f * ttt - 3.0f * tt + 1.0f) + p2 * (-2.0f * ttt + 3.0f * tt) + s1 * (ttt - 2.0f * tt + t) + s2 * (ttt - tt);
+	}
+
+	glm::quat HermiteKey(float t, const glm::quat& p1, const glm::quat& s1, const glm::quat& _p2, const glm::quat& s2)
+	{
+		float tt = t * t;
+		float ttt = tt * t;
+		glm::quat p2 = _p2;
+		if (glm::dot(p1, p2) < 0.0f)
+		{
+			p2 = -p2;
+		}
+		glm::quat result = p1 * (2.0f * ttt - 3.0f * tt + 1.0f) + p2 * (-2.0f * ttt + 3.0f * tt) + s1 * (ttt - 2.0f * tt + t) + s2 * (ttt - tt);
+		return glm::normalize(result);
+	}
+
+	//Same as what Track::SampleCubic does at runtime
+	template<typename T>
+	T SampleCubicTrack(const Track<T>& track, float time)
+	{
+		const size_t numFrames = track.mFrames.size();
+
+		size_t thisFrame = 0;
+		while (thisFrame + 2 < numFrames && time >= track.mFrames[thisFrame + 1].mTime)
+		{
+			++thisFrame;
+		}
+
+		const Frame<T>& frame1 = track.mFrames[thisFrame];
+		const Frame<T>& frame2 = track.mFrames[thisFrame + 1];
+		float frameDelta = frame2.mTime - frame1.mTime;
+		if (frameDelta <= 0.0f)
+		{
+			return frame1.mValue;
+		}
+
+		float t = glm::clamp((time - frame1.mTime) / frameDelta, 0.0f, 1.0f);
+		return HermiteKey(t, frame1.mValue, frame1.mOut * frameDelta, frame2.mValue, frame2.mIn * frameDelta);
+	}
+
+	template<typename T>
+	std::vector<Frame<T>> ResampleCubicTrack(const Track<T>& track, unsigned int numberOfSamples)
+	{
+		std::vector<Frame<T>> result;
+
+		const float startTime = track.mFrames.front().mTime;
+		const float endTime = track.mFrames.back().mTime;
+		const unsigned int numSamples = std::max(2u, (unsigned int)ceilf((endTime - startTime) * static_cast<float>(numberOfSamples)) + 1);
+
+		result.resize(numSamples);
+
+		for (unsigned int i = 0; i < numSamples; ++i)
+		{
+			float time = startTime + (endTime - startTime) * ((float)i / (float)(numSamples - 1));
+			result[i].mTime = time;
+			result[i].mValue = SampleCubicTrack(track, time);
+			result[i].mIn = result[i].mValue;
+			result[i].mOut = result[i].mValue;
+		}
+
+		return result;
+	}
+
+	//Greedily grows each linear segment until one of the keys it skips over is more than tolerance away from it
+	template<typename T>
+	std::vector<Frame<T>> ReduceLinearKeys(const std::vector<Frame<T>>& frames, float tolerance)
+	{
+		if (frames.size() <= 2)
+		{
+			return frames;
+		}
+
+		std::vector<Frame<T>> result;
+		result.push_back(frames.front());
+
+		size_t start = 0;
+		size_t end = 2;
+
+		while (end < frames.size())
+		{
+			bool withinTolerance = true;
+			const float duration = frames[end].mTime - frames[start].mTime;
+
+			for (size_t i = start + 1; i < end && withinTolerance; ++i)
+			{
+				float t = duration > 0.0f ? (frames[i].mTime - frames[start].mTime) / duration : 0.0f;
+				T approximation = LerpKey(frames[start].mValue, frames[end].mValue, t);
+				withinTolerance = KeyError(approximation, frames[i].mValue) <= tolerance;
+			}
+
+			if (!withinTolerance)
+			{
+				start = end - 1;
+				result.push_back(frames[start]);
+			}
+
+			++end;
+		}
+
+		result.push_back(frames.back());
+
+		return result;
+	}
+
+	//Step tracks only need a key where the value actually changes
+	template<typename T>
+	std::vector<Frame<T>> ReduceConstantKeys(const std::vector<Frame<T>>& frames, float tolerance)
+	{
+		if (frames.size() <= 2)
+		{
+			return frames;
+		}
+
+		std::vector<Frame<T>> result;
+		result.push_back(frames.front());
+
+		for (size_t i = 1; i + 1 < frames.size(); ++i)
+		{
+			if (KeyError(result.back().mValue, frames[i].mValue) > tolerance)
+			{
+				result.push_back(frames[i]);
+			}
+		}
+
+		result.push_back(frames.back());
+
+		return result;
+	}
+
+	void QuantizeKeys(const std::vector<Frame<glm::vec3>>& frames, CompressedTrack& compressedTrack)
+	{
+		glm::vec3 rangeMin = frames.front().mValue;
+		glm::vec3 rangeMax = frames.front().mValue;
+
+		for (const auto& frame : frames)
+		{
+			rangeMin = glm::min(rangeMin, frame.mValue);
+			rangeMax = glm::max(rangeMax, frame.mValue);
+		}
+
+		compressedTrack.mRangeMin = rangeMin;
+		compressedTrack.mRangeExtent = rangeMax - rangeMin;
+
+		for (const auto& frame : frames)
+		{
+			uint16_t values[3];
+			QuantizeVectorKey(glm::value_ptr(frame.mValue), glm::value_ptr(compressedTrack.mRangeMin), glm::value_ptr(compressedTrack.mRangeExtent), values);
+
+			compressedTrack.mValues.insert(compressedTrack.mValues.end(), values, values + 3);
+		}
+	}
+
+	void QuantizeKeys(const std::vector<Frame<glm::quat>>& frames, CompressedTrack& compressedTrack)
+	{
+		for (const auto& frame : frames)
+		{
+			const float rotation[4] = { frame.mValue.x, frame.mValue.y, frame.mValue.z, frame.mValue.w };
+
+			uint16_t values[3];
+			QuantizeQuaternionKey(rotation, values);
+
+			compressedTrack.mValues.insert(compressedTrack.mValues.end(), values, values + 3);
+		}
+	}
+
+	template<typename T>
+	CompressedTrack CompressTrack(const Track<T>& track, unsigned int numberOfSamples, float tolerance)
+	{
+		CompressedTrack compressedTrack;
+		compressedTrack.interpolation = track.interpolation;
+
+		if (track.mFrames.empty())
+		{
+			return compressedTrack;
+		}
+
+		Track<T> reducedTrack;
+		reducedTrack.interpolation = track.interpolation;
+		reducedTrack.mNumberOfSamples = 0;
+
+		if (track.interpolation == fastgltf::AnimationInterpolation::Step)
+		{
+			reducedTrack.mFrames = ReduceConstantKeys(track.mFrames, tolerance);
+		}
+		else if (track.interpolation == fastgltf::AnimationInterpolation::CubicSpline && track.mFrames.size() > 1)
+		{
+			reducedTrack.mFrames = ReduceLinearKeys(ResampleCubicTrack(track, numberOfSamples), tolerance);
+			reducedTrack.interpolation = fastgltf::AnimationInterpolation::Linear;
+		}
+		else
+		{
+			reducedTrack.mFrames = ReduceLinearKeys(track.mFrames, tolerance);
+		}
+
+		reducedTrack.UpdateIndexLookupTable(numberOfSamples);
+
+		compressedTrack.interpolation = reducedTrack.interpolation;
+		compressedTrack.mNumberOfSamples = reducedTrack.mNumberOfSamples;
+		compressedTrack.mSampledFrames = reducedTrack.mSampledFrames;
+
+		for (const auto& frame : reducedTrack.mFrames)
+		{
+			compressedTrack.mTimes.push_back(frame.mTime);
+		}
+
+		QuantizeKeys(reducedTrack.mFrames, compressedTrack);
+
+		return compressedTrack;
+	}
+
+	struct CompressedTransformTrack
+	{
+		CompressedTrack mPosition;
+		CompressedTrack mRotation;
+		CompressedTrack mScale;
+	};
+
+	struct MeshLOD
+	{
+		uint32_t firstIndex = 0;
+		uint32_t numIndices = 0;
+		float error = 0.0f;
+	};
+
 	struct Mesh
 	{
 		uint64_t hashName = 0;
 		std::vector<Vertex> vertices;
-		std::vector<uint32_t> indices;
+		std::vector<uint32_t> indices; //all of the LODs one after another
+		std::vector<MeshLOD> lods;
 		int materialIndex = -1;
 	};
 
@@ -633,7 +934,11 @@ namespace r2::assets::assetlib
 		ShaderParams shaderParams;
 	};
 
-	bool ConvertModelToFlatbuffer(Model& model, const fs::path& inputFilePath, const fs::path& outputPath, uint32_t numberOfSamples);
+	bool ConvertModelToFlatbuffer(Model& model, const fs::path& inputFilePath, const fs::path& outputPath, uint32_t numberOfSamples, bool compressAnimations, float animationCompressionTolerance, bool quantizeVertices);
+
+	std::vector<QuantizedVertex> QuantizeVertices(const std::vector<Vertex>& vertices, const glm::vec3& boundsMin, const glm::vec3& boundsSize);
+
+	void OptimizeMesh(Mesh& mesh, std::vector<BoneData>& animVertices, const std::vector<float>& lodErrorTargets);
 
 	bool ConvertGLTFModel(
 		const std::filesystem::path& inputFilePath,
@@ -643,7 +948,11 @@ namespace r2::assets::assetlib
 		const std::filesystem::path& engineTexturePacksManifestFile,
 		const std::filesystem::path& texturePacksManifestFile,
 		bool forceRebuild,
-		uint32_t numAnimationSamples);
+		uint32_t numAnimationSamples,
+		bool compressAnimations,
+		float animationCompressionTolerance,
+		bool quantizeVertices,
+		const std::vector<float>& lodErrorTargets);
 
 	//For loading the GLTF Skeleton
 	Pose LoadRestPose(const fastgltf::Asset& gltf, const std::unordered_map<size_t, Transform>& nodeLocalTransforms);
@@ -926,15 +1235,15 @@ namespace r2::assets::assetlib
 
 		if (materialData.transparencyType == flat::eTransparencyType_OPAQUE) //for now we use the same ones
 		{
-			materialData.shaderEffectPasses = g_shaderEffectPassesMap[OPAQUE_FORWARD_PASS];
+			materialData.shaderEffectPasses = g_shaderEffectPassesMap.at(OPAQUE_FORWARD_PASS);
 		}
 		else if (materialData.transparencyType == flat::eTransparencyType_MASK)
 		{
-			materialData.shaderEffectPasses = g_shaderEffectPassesMap[OPAQUE_ALPHA_DISCARD_FORWARD_PASS];
+			materialData.shaderEffectPasses = g_shaderEffectPassesMap.at(OPAQUE_ALPHA_DISCARD_FORWARD_PASS);
 		}
 		else if (materialData.transparencyType == flat::eTransparencyType_TRANSPARENT)
 		{
-			materialData.shaderEffectPasses = g_shaderEffectPassesMap[TRANSPARENT_FORWARD_PASS];
+			materialData.shaderEffectPasses = g_shaderEffectPassesMap.at(TRANSPARENT_FORWARD_PASS);
 		}
 		else
 		{
@@ -1556,8 +1865,13 @@ namespace r2::assets::assetlib
 		return true;
 	}
 
+	//models can be converted on multiple threads and they can share materials - only one model writes out its materials at a time
+	static std::mutex g_buildMaterialsMutex;
+
 	void BuildNewMaterials(const std::filesystem::path& rawMaterialOutputPath, const std::filesystem::path& binaryMaterialParamPacksManifestFile, const std::vector<MaterialData>& materialsToBuild, const std::vector<Sampler>& samplers)
 	{
+		std::lock_guard<std::mutex> lock(g_buildMaterialsMutex);
+
 		for (size_t i = 0; i < materialsToBuild.size(); ++i)
 		{
 			const MaterialData& materialData = materialsToBuild[i];
@@ -2203,7 +2517,11 @@ namespace r2::assets::assetlib
 		const std::filesystem::path& engineTexturePacksManifestFile,
 		const std::filesystem::path& texturePacksManifestFile,
 		bool forceRebuild,
-		uint32_t numAnimationSamples)
+		uint32_t numAnimationSamples,
+		bool compressAnimations,
+		float animationCompressionTolerance,
+		bool quantizeVertices,
+		const std::vector<float>& lodErrorTargets)
 	{
 		fastgltf::Parser parser{};
 
@@ -2596,6 +2914,8 @@ namespace r2::assets::assetlib
 					animVertices.push_back(animVertex);
 				}
 
+				OptimizeMesh(nextMesh, animVertices, lodErrorTargets);
+
 				if (skinForMesh)
 				{
 					animVertices = RearrangeMesh(animVertices, boneRemapping);
@@ -2609,7 +2929,7 @@ namespace r2::assets::assetlib
 
 		BuildNewMaterials(rawMaterialsParentDirectory, binaryMaterialParamPacksManifestFile, materialsToBuild, samplers);
 
-		return ConvertModelToFlatbuffer(model, inputFilePath, parentOutputDir, numAnimationSamples);
+		return ConvertModelToFlatbuffer(model, inputFilePath, parentOutputDir, numAnimationSamples, compressAnimations, animationCompressionTolerance, quantizeVertices);
 	}
 
 	bool ConvertModel(
@@ -2620,9 +2940,13 @@ namespace r2::assets::assetlib
 		const std::filesystem::path& engineTexturePacksManifestFile,
 		const std::filesystem::path& texturePacksManifestFile,
 		bool forceRebuild,
-		uint32_t numAnimationSamples)
+		uint32_t numAnimationSamples,
+		bool compressAnimations,
+		float animationCompressionTolerance,
+		bool quantizeVertices,
+		const std::vector<float>& lodErrorTargets)
 	{
-		return ConvertGLTFModel(inputFilePath, parentOutputDir, binaryMaterialParamPacksManifestFile, rawMaterialsParentDirectory, engineTexturePacksManifestFile, texturePacksManifestFile, forceRebuild, numAnimationSamples);
+		return ConvertGLTFModel(inputFilePath, parentOutputDir, binaryMaterialParamPacksManifestFile, rawMaterialsParentDirectory, engineTexturePacksManifestFile, texturePacksManifestFile, forceRebuild, numAnimationSamples, compressAnimations, animationCompressionTolerance, quantizeVertices, lodErrorTargets);
 	}
 
 	flat::InterpolationType GetInterpolationType(fastgltf::AnimationInterpolation fastgltfInterpolationType)
@@ -2643,11 +2967,215 @@ namespace r2::assets::assetlib
 		}
 	}
 
-	bool ConvertModelToFlatbuffer(Model& model, const fs::path& inputFilePath, const fs::path& outputPath, uint32_t numberOfSamples )
+	flatbuffers::Offset<flat::CompressedTrack> CreateFlatCompressedTrack(flatbuffers::FlatBufferBuilder& builder, const CompressedTrack& compressedTrack)
+	{
+		auto trackInfo = flat::CreateTrackInfo(builder, GetInterpolationType(compressedTrack.interpolation), compressedTrack.mNumberOfSamples, builder.CreateVector(compressedTrack.mSampledFrames));
+
+		flat::Vertex3 rangeMin(compressedTrack.mRangeMin.x, compressedTrack.mRangeMin.y, compressedTrack.mRangeMin.z);
+		flat::Vertex3 rangeExtent(compressedTrack.mRangeExtent.x, compressedTrack.mRangeExtent.y, compressedTrack.mRangeExtent.z);
+
+		return flat::CreateCompressedTrack(builder, builder.CreateVector(compressedTrack.mTimes), builder.CreateVector(compressedTrack.mValues), &rangeMin, &rangeExtent, trackInfo);
+	}
+
+	void EncodeOctahedral(const glm::vec3& v, int16_t encoded[2])
+	{
+		const float l1Norm = glm::abs(v.x) + glm::abs(v.y) + glm::abs(v.z);
+
+		glm::vec2 e = glm::vec2(0.0f);
+
+		if (l1Norm > 0.0f)
+		{
+			const glm::vec3 n = v / l1Norm;
+			e = glm::vec2(n.x, n.y);
+
+			//fold the lower hemisphere over the diagonals
+			if (n.z < 0.0f)
+			{
+				e.x = (1.0f - glm::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+				e.y = (1.0f - glm::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+			}
+		}
+
+		encoded[0] = static_cast<int16_t>(glm::packSnorm1x16(e.x));
+		encoded[1] = static_cast<int16_t>(glm::packSnorm1x16(e.y));
+	}
+
+	void PackHalf3(const glm::vec3& v, uint16_t packed[4])
+	{
+		packed[0] = glm::packHalf1x16(v.x);
+		packed[1] = glm::packHalf1x16(v.y);
+		packed[2] = glm::packHalf1x16(v.z);
+		packed[3] = 0;
+	}
+
+	std::vector<QuantizedVertex> QuantizeVertices(const std::vector<Vertex>& vertices, const glm::vec3& boundsMin, const glm::vec3& boundsSize)
+	{
+		std::vector<QuantizedVertex> quantizedVertices;
+		quantizedVertices.resize(vertices.size());
+
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			const Vertex& vertex = vertices[i];
+			QuantizedVertex& quantizedVertex = quantizedVertices[i];
+
+			for (int c = 0; c < 3; ++c)
+			{
+				//flat axes all map to the min
+				const float t = boundsSize[c] > 0.0f ? (vertex.position[c] - boundsMin[c]) / boundsSize[c] : 0.0f;
+				quantizedVertex.position[c] = glm::packUnorm1x16(t);
+			}
+
+			EncodeOctahedral(vertex.normal, quantizedVertex.normal);
+			EncodeOctahedral(vertex.tangent, quantizedVertex.tangent);
+
+			//z holds the material/mesh index which is exact as a half up to 2048
+			assert(vertex.texCoords0.z <= 2048.0f && vertex.texCoords1.z <= 2048.0f);
+			PackHalf3(vertex.texCoords0, quantizedVertex.texCoords0);
+			PackHalf3(vertex.texCoords1, quantizedVertex.texCoords1);
+		}
+
+		return quantizedVertices;
+	}
+
+	template<typename T>
+	std::vector<T> RemapVertices(const std::vector<T>& vertices, const std::vector<uint32_t>& remap)
+	{
+		std::vector<T> remappedVertices;
+		remappedVertices.resize(vertices.size());
+
+		for (size_t v = 0; v < vertices.size(); ++v)
+		{
+			remappedVertices[remap[v]] = vertices[v];
+		}
+
+		return remappedVertices;
+	}
+
+	void OptimizeMesh(Mesh& mesh, std::vector<BoneData>& animVertices, const std::vector<float>& lodErrorTargets)
+	{
+		const size_t numVertices = mesh.vertices.size();
+		const size_t numIndices = mesh.indices.size();
+
+		MeshLOD lod0;
+		lod0.numIndices = static_cast<uint32_t>(numIndices);
+
+		mesh.lods.clear();
+		mesh.lods.push_back(lod0);
+
+		if (numVertices == 0 || numIndices < 3)
+		{
+			return;
+		}
+
+		const size_t positionStride = sizeof(Vertex);
+
+		//Order the triangles for the vertex cache, then the vertices in the order the triangles use them
+		OptimizeVertexCache(mesh.indices.data(), numIndices, numVertices);
+		OptimizeOverdraw(mesh.indices.data(), numIndices, &mesh.vertices[0].position.x, numVertices, positionStride, OVERDRAW_ACMR_THRESHOLD);
+
+		std::vector<uint32_t> remap;
+		remap.resize(numVertices);
+
+		OptimizeVertexFetchRemap(remap.data(), mesh.indices.data(), numIndices, numVertices);
+
+		mesh.vertices = RemapVertices(mesh.vertices, remap);
+
+		//the bone data has to stay lined up with the vertices
+		if (animVertices.size() == numVertices)
+		{
+			animVertices = RemapVertices(animVertices, remap);
+		}
+
+		if (lodErrorTargets.empty())
+		{
+			return;
+		}
+
+		//The error targets are relative to the size of the mesh
+		glm::vec3 minBounds = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
+
+		for (const auto& vertex : mesh.vertices)
+		{
+			minBounds = glm::min(minBounds, vertex.position);
+			maxBounds = glm::max(maxBounds, vertex.position);
+		}
+
+		const glm::vec3 meshExtents = maxBounds - minBounds;
+		const float meshSize = std::max(meshExtents.x, std::max(meshExtents.y, meshExtents.z));
+
+		if (meshSize <= 0.0f)
+		{
+			return;
+		}
+
+		std::vector<float> sortedErrorTargets = lodErrorTargets;
+		std::sort(sortedErrorTargets.begin(), sortedErrorTargets.end());
+
+		std::vector<uint32_t> lodIndices;
+		lodIndices.resize(numIndices);
+
+		for (float lodErrorTarget : sortedErrorTargets)
+		{
+			if (mesh.lods.size() >= MAX_NUM_MESH_LODS)
+			{
+				break;
+			}
+
+			//Always simplify from LOD 0 so the error doesn't build up through the chain
+			float lodError = 0.0f;
+			const size_t numLODIndices = SimplifyMesh(lodIndices.data(), mesh.indices.data(), numIndices, &mesh.vertices[0].position.x, numVertices, positionStride, lodErrorTarget * meshSize, lodError);
+
+			if (numLODIndices == 0)
+			{
+				break;
+			}
+
+			const MeshLOD& prevLOD = mesh.lods.back();
+
+			if (static_cast<float>(numLODIndices) > static_cast<float>(prevLOD.numIndices) * (1.0f - MIN_LOD_REDUCTION))
+			{
+				continue;
+			}
+
+			OptimizeVertexCache(lodIndices.data(), numLODIndices, numVertices);
+
+			MeshLOD lod;
+			lod.firstIndex = static_cast<uint32_t>(mesh.indices.size());
+			lod.numIndices = static_cast<uint32_t>(numLODIndices);
+			lod.error = std::max(lodError, prevLOD.error);
+
+			mesh.indices.insert(mesh.indices.end(), lodIndices.begin(), lodIndices.begin() + numLODIndices);
+			mesh.lods.push_back(lod);
+		}
+	}
+
+	bool ConvertModelToFlatbuffer(Model& model, const fs::path& inputFilePath, const fs::path& outputPath, uint32_t numberOfSamples, bool compressAnimations, float animationCompressionTolerance, bool quantizeVertices)
 	{
 		//meta data
 		flatbuffers::FlatBufferBuilder builder;
 
+		//Compress the clips up front since the meta data needs the compressed key counts
+		std::vector<std::vector<CompressedTransformTrack>> compressedClips;
+
+		if (compressAnimations)
+		{
+			compressedClips.resize(model.clips.size());
+
+			for (size_t i = 0; i < model.clips.size(); ++i)
+			{
+				for (const auto& track : model.clips[i].mTracks)
+				{
+					CompressedTransformTrack compressedTrack;
+					compressedTrack.mPosition = CompressTrack(track.mPosition, numberOfSamples, animationCompressionTolerance);
+					compressedTrack.mRotation = CompressTrack(track.mRotation, numberOfSamples, animationCompressionTolerance);
+					compressedTrack.mScale = CompressTrack(track.mScale, numberOfSamples, animationCompressionTolerance);
+
+					compressedClips[i].push_back(compressedTrack);
+				}
+			}
+		}
+
 		std::vector<flatbuffers::Offset<flat::MeshInfo>> meshInfos;
 
 		const auto numMeshes = model.meshes.size();
@@ -2659,6 +3187,9 @@ namespace r2::assets::assetlib
 		uint32_t totalVertices = 0;
 		uint32_t totalIndices = 0;
 
+		const flat::VertexFormat vertexFormat = quantizeVertices ? flat::VertexFormat_P16N16UV16T16 : flat::VertexFormat_P32N32UV32T32;
+		const size_t vertexSize = quantizeVertices ? sizeof(QuantizedVertex) : sizeof(Vertex);
+
 		for (size_t i = 0; i < numMeshes; ++i)
 		{
 			std::vector<Position> meshPositions;
@@ -2692,13 +3223,13 @@ namespace r2::assets::assetlib
 				builder,
 				mesh.hashName,
 				flat::VertexOrdering_INTERLEAVED,
-				flat::VertexFormat_P32N32UV32T32,
-				numVertices * sizeof(Vertex),
+				vertexFormat,
+				numVertices * vertexSize,
 				numIndices * sizeof(uint32_t),
 				&flatBounds,
 				sizeof(uint32_t),
 				flat::MeshCompressionMode_LZ4,
-				numVertices * sizeof(Vertex) + numIndices * sizeof(uint32_t),
+				numVertices * vertexSize + numIndices * sizeof(uint32_t),
 				builder.CreateString(model.originalPath));
 
 			meshInfos.push_back(meshInfo);
@@ -2719,12 +3250,33 @@ namespace r2::assets::assetlib
 
 		char animationName[256];
 
-		for (const auto& clip : model.clips)
+		for (size_t clipIndex = 0; clipIndex < model.clips.size(); ++clipIndex)
 		{
+			const auto& clip = model.clips[clipIndex];
+
 			std::vector<flatbuffers::Offset<flat::RChannelMetaData>> channelMetaDatas;
 			channelMetaDatas.reserve(clip.mTracks.size());
-			for (const auto& track : clip.mTracks)
+			for (size_t trackIndex = 0; trackIndex < clip.mTracks.size(); ++trackIndex)
 			{
+				const auto& track = clip.mTracks[trackIndex];
+
+				if (compressAnimations)
+				{
+					const CompressedTransformTrack& compressedTrack = compressedClips[clipIndex][trackIndex];
+
+					channelMetaDatas.push_back(flat::CreateRChannelMetaData(
+						builder,
+						compressedTrack.mPosition.mTimes.size(),
+						compressedTrack.mScale.mTimes.size(),
+						compressedTrack.mRotation.mTimes.size(),
+						compressedTrack.mPosition.mSampledFrames.size(),
+						compressedTrack.mScale.mSampledFrames.size(),
+						compressedTrack.mRotation.mSampledFrames.size(),
+						numberOfSamples,
+						true));
+					continue;
+				}
+
 				channelMetaDatas.push_back(flat::CreateRChannelMetaData(
 					builder,
 					track.mPosition.mFrames.size(),
@@ -2787,6 +3339,10 @@ namespace r2::assets::assetlib
 		std::vector<std::vector< int8_t> > meshData;
 		meshData.resize(model.meshes.size());
 
+		//positions are stored relative to the model bounds - the loader rebuilds the same scale and bias from the meta data
+		const glm::vec3 quantizationMin = glm::vec3(modelBounds.origin[0] - modelBounds.extents[0], modelBounds.origin[1] - modelBounds.extents[1], modelBounds.origin[2] - modelBounds.extents[2]);
+		const glm::vec3 quantizationSize = 2.0f * glm::vec3(modelBounds.extents[0], modelBounds.extents[1], modelBounds.extents[2]);
+
 		for (size_t i = 0; i < numMeshesInModel; ++i)
 		{
 			auto& mesh = model.meshes[i];
@@ -2801,13 +3357,30 @@ namespace r2::assets::assetlib
 
 			meshData[i].resize(compressedSize);
 
-			pack_mesh(dataBuilder, modelMetaData, i, reinterpret_cast<char*>(meshData[i].data()), mesh.materialIndex, reinterpret_cast<char*>(mesh.vertices.data()), reinterpret_cast<char*>(mesh.indices.data()));
+			if (quantizeVertices)
+			{
+				std::vector<QuantizedVertex> quantizedVertices = QuantizeVertices(mesh.vertices, quantizationMin, quantizationSize);
+
+				pack_mesh(dataBuilder, modelMetaData, i, reinterpret_cast<char*>(meshData[i].data()), mesh.materialIndex, reinterpret_cast<char*>(quantizedVertices.data()), reinterpret_cast<char*>(mesh.indices.data()));
+			}
+			else
+			{
+				pack_mesh(dataBuilder, modelMetaData, i, reinterpret_cast<char*>(meshData[i].data()), mesh.materialIndex, reinterpret_cast<char*>(mesh.vertices.data()), reinterpret_cast<char*>(mesh.indices.data()));
+			}
 
 			compressedSize = modelMetaData->meshInfos()->Get(i)->compressedSize();
 
 			meshData[i].resize(compressedSize);
 
-			flatMeshes.push_back(flat::CreateRMesh(dataBuilder, mesh.materialIndex, dataBuilder.CreateVector(meshData[i])));
+			std::vector<flat::MeshLOD> flatLODs;
+			flatLODs.reserve(mesh.lods.size());
+
+			for (const auto& lod : mesh.lods)
+			{
+				flatLODs.push_back(flat::MeshLOD(lod.firstIndex, lod.numIndices, lod.error));
+			}
+
+			flatMeshes.push_back(flat::CreateRMesh(dataBuilder, mesh.materialIndex, dataBuilder.CreateVector(meshData[i]), dataBuilder.CreateVectorOfStructs(flatLODs)));
 		}
 
 		const auto numMaterialsInModel = model.materialNames.size();
@@ -2901,12 +3474,34 @@ namespace r2::assets::assetlib
 
 		std::vector<flatbuffers::Offset<flat::RAnimation>> flatAnimations;
 
-		for (const auto& clip : model.clips)
+		for (size_t clipIndex = 0; clipIndex < model.clips.size(); ++clipIndex)
 		{
+			const auto& clip = model.clips[clipIndex];
+
 			std::vector<flatbuffers::Offset<flat::TransformTrack>> transformTracks;
 
-			for (const auto& track : clip.mTracks)
+			for (size_t trackIndex = 0; trackIndex < clip.mTracks.size(); ++trackIndex)
 			{
+				const auto& track = clip.mTracks[trackIndex];
+
+				if (compressAnimations)
+				{
+					auto flatTransformTrack = flat::CreateTransformTrack(
+						dataBuilder,
+						track.mJointID,
+						0,
+						0,
+						0,
+						track.GetStartTime(),
+						track.GetEndTime(),
+						CreateFlatCompressedTrack(dataBuilder, compressedClips[clipIndex][trackIndex].mPosition),
+						CreateFlatCompressedTrack(dataBuilder, compressedClips[clipIndex][trackIndex].mRotation),
+						CreateFlatCompressedTrack(dataBuilder, compressedClips[clipIndex][trackIndex].mScale));
+
+					transformTracks.push_back(flatTransformTrack);
+					continue;
+				}
+
 				std::vector<flat::VectorKey> flatPositionKeys;
 				std::vector<flat::VectorKey> flatScaleKeys;
 				std::vector<flat::RotationKey> flatRotationKeys;
@@ -16,6 +16,11 @@ namespace r2::ibl
 		//typedef void (*Progress)(size_t, float, void*);
 		using Progress = std::function<void(size_t, float, void*)>;
 
+		//The filters split their rows across this many threads, 0 uses all of the cores (the default).
+		//Progress callbacks can be called from any of those threads.
+		static void SetNumThreads(size_t numThreads);
+		static size_t GetNumThreads();
+
 		//Implement roughness filter of the specular term
 		static void RoughnessFilter(
 			Cubemap& dst,
@@ -8,12 +8,63 @@
 #include <atomic>
 #include <algorithm>
 #include <random>
+#include <thread>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IBL_SSE2 1
+#include <emmintrin.h>
+#else
+#define IBL_SSE2 0
+#endif
 
 namespace
 {
 	const float PI = 3.14159f;
 	const float ONE_OVER_PI = 1.0f / PI;
+
+	size_t g_numThreads = 0;
+
+	size_t NumThreadsToUse()
+	{
+		return g_numThreads > 0 ? g_numThreads : std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	//Runs func(i) for every i in [0, count) on all of the threads (this one included). Indices are handed out one at a time
+	//since rows near the poles of the lower mips can take a lot longer than others.
+	template<typename Func>
+	void ParallelFor(size_t count, Func&& func)
+	{
+		std::atomic<size_t> next = 0;
+
+		auto worker = [&]()
+		{
+			for (size_t i = next++; i < count; i = next++)
+			{
+				func(i);
+			}
+		};
+
+		const size_t numWorkers = std::min(NumThreadsToUse(), count);
+
+		std::vector<std::thread> threads;
+
+		for (size_t i = 1; i < numWorkers; ++i)
+		{
+			threads.emplace_back(worker);
+		}
+
+		worker();
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	size_t PaddedSize(size_t size)
+	{
+		return (size + 3) & ~size_t(3);
+	}
 }
 
 namespace r2::ibl
@@ -80,78 +131,268 @@ namespace r2::ibl
 		return (2.0f + invAlpha) * std::pow(sin2h, invAlpha * 0.5f) / (2.0f * (float)PI);
 	}
 
-	static float DFV_Charlie_Uniform(float NoV, float linearRoughness, size_t numSamples) {
+	//Filter kernel samples in tangent space, stored as structure of arrays and padded to a multiple of 4 so the kernels
+	//can work on 4 samples at a time. The padding is all zeros.
+	struct FilterSamples
+	{
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> z;
+		std::vector<float> weight;
+		std::vector<float> lerp;
+		std::vector<uint8_t> l0;
+		std::vector<uint8_t> l1;
+		size_t count = 0;
+
+		void Push(const glm::vec3& L, float w, float lerpAmount, uint8_t level0, uint8_t level1)
+		{
+			x.push_back(L.x);
+			y.push_back(L.y);
+			z.push_back(L.z);
+			weight.push_back(w);
+			lerp.push_back(lerpAmount);
+			l0.push_back(level0);
+			l1.push_back(level1);
+			++count;
+		}
+
+		void Pad()
+		{
+			x.resize(PaddedSize(count), 0.0f);
+			y.resize(PaddedSize(count), 0.0f);
+			z.resize(PaddedSize(count), 0.0f);
+		}
+	};
+
+	//directions[i] = R * L[i] for all of the samples - directions needs to hold PaddedSize(samples.count) entries
+	static void RotateSamples(const glm::mat3& R, const FilterSamples& samples, glm::vec3* directions)
+	{
+		const size_t paddedCount = PaddedSize(samples.count);
+
+#if IBL_SSE2
+		const __m128 r00 = _mm_set1_ps(R[0].x), r01 = _mm_set1_ps(R[0].y), r02 = _mm_set1_ps(R[0].z);
+		const __m128 r10 = _mm_set1_ps(R[1].x), r11 = _mm_set1_ps(R[1].y), r12 = _mm_set1_ps(R[1].z);
+		const __m128 r20 = _mm_set1_ps(R[2].x), r21 = _mm_set1_ps(R[2].y), r22 = _mm_set1_ps(R[2].z);
+
+		alignas(16) float dx[4];
+		alignas(16) float dy[4];
+		alignas(16) float dz[4];
+
+		for (size_t i = 0; i < paddedCount; i += 4)
+		{
+			const __m128 lx = _mm_loadu_ps(&samples.x[i]);
+			const __m128 ly = _mm_loadu_ps(&samples.y[i]);
+			const __m128 lz = _mm_loadu_ps(&samples.z[i]);
+
+			_mm_store_ps(dx, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r00, lx), _mm_mul_ps(r10, ly)), _mm_mul_ps(r20, lz)));
+			_mm_store_ps(dy, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r01, lx), _mm_mul_ps(r11, ly)), _mm_mul_ps(r21, lz)));
+			_mm_store_ps(dz, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r02, lx), _mm_mul_ps(r12, ly)), _mm_mul_ps(r22, lz)));
+
+			for (size_t j = 0; j < 4; ++j)
+			{
+				directions[i + j] = glm::vec3(dx[j], dy[j], dz[j]);
+			}
+		}
+#else
+		for (size_t i = 0; i < paddedCount; ++i)
+		{
+			directions[i] = R * glm::vec3(samples.x[i], samples.y[i], samples.z[i]);
+		}
+#endif
+	}
+
+	static glm::vec3 AccumulateSamples(const std::vector<Cubemap>& levels, const FilterSamples& samples, const glm::vec3* directions)
+	{
+		glm::vec3 Li = glm::vec3(0);
+
+		for (size_t i = 0; i < samples.count; ++i)
+		{
+			const Cubemap::Texel c = Cubemap::TrilinearFilterAt(levels[samples.l0[i]], levels[samples.l1[i]], samples.lerp[i], directions[i]);
+
+			Li += glm::vec3(c.r, c.g, c.b) * samples.weight[i];
+		}
+
+		return Li;
+	}
+
+	//Half vectors of the DFG samples - V is always in the xz plane so only x and z are needed
+	struct HalfVectorSamples
+	{
+		std::vector<float> hx;
+		std::vector<float> hz;
+		std::vector<float> d; //only used by the cloth term
+		size_t count = 0;
+
+		explicit HalfVectorSamples(size_t numSamples)
+			:hx(PaddedSize(numSamples), 0.0f)
+			,hz(PaddedSize(numSamples), 0.0f)
+			,count(numSamples)
+		{
+		}
+	};
+
+#if IBL_SSE2
+	static inline __m128 Saturate4(__m128 v)
+	{
+		return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+	}
+
+	static inline float HorizontalSum(__m128 v)
+	{
+		__m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+		__m128 sums = _mm_add_ps(v, shuf);
+		shuf = _mm_movehl_ps(shuf, sums);
+		sums = _mm_add_ss(sums, shuf);
+		return _mm_cvtss_f32(sums);
+	}
+#endif
+
+	static float DFV_Charlie_Uniform(float NoV, float linearRoughness, const HalfVectorSamples& samples) {
+		const size_t numSamples = samples.count;
+		const float Vx = std::sqrt(1 - NoV * NoV);
+		const float Vz = NoV;
+
 		float r = 0.0;
-		const glm::vec3 V(std::sqrt(1 - NoV * NoV), 0, NoV);
+#if IBL_SSE2
+		const __m128 vx = _mm_set1_ps(Vx);
+		const __m128 vz = _mm_set1_ps(Vz);
+		const __m128 noV = _mm_set1_ps(NoV);
+		const __m128 two = _mm_set1_ps(2.0f);
+		const __m128 four = _mm_set1_ps(4.0f);
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		__m128 sum = _mm_setzero_ps();
+
+		for (size_t i = 0; i < samples.hx.size(); i += 4)
+		{
+			const __m128 hx = _mm_loadu_ps(&samples.hx[i]);
+			const __m128 hz = _mm_loadu_ps(&samples.hz[i]);
+			const __m128 d = _mm_loadu_ps(&samples.d[i]);
+
+			const __m128 VdotH = _mm_add_ps(_mm_mul_ps(vx, hx), _mm_mul_ps(vz, hz));
+			const __m128 VoH = Saturate4(VdotH);
+			const __m128 NoL = Saturate4(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(two, VdotH), hz), vz));
+
+			// VisibilityAshikhmin
+			const __m128 v = _mm_div_ps(one, _mm_mul_ps(four, _mm_sub_ps(_mm_add_ps(NoL, noV), _mm_mul_ps(NoL, noV))));
+			const __m128 contribution = _mm_mul_ps(_mm_mul_ps(v, d), _mm_mul_ps(NoL, VoH));
+
+			sum = _mm_add_ps(sum, _mm_and_ps(_mm_cmpgt_ps(NoL, _mm_setzero_ps()), contribution));
+		}
+
+		r = HorizontalSum(sum);
+#else
 		for (size_t i = 0; i < numSamples; i++) {
-			const glm::vec2 u = Hammersley(uint32_t(i), 1.0f / numSamples);
-			const glm::vec3 H = HemisphereUniformSample(u);
-			const glm::vec3 L = 2 * glm::dot(V, H) * H - V;
-			const float VoH = Saturate(glm::dot(V, H));
-			const float NoL = Saturate(L.z);
-			const float NoH = Saturate(H.z);
+			const float VdotH = Vx * samples.hx[i] + Vz * samples.hz[i];
+			const float VoH = Saturate(VdotH);
+			const float NoL = Saturate(2 * VdotH * samples.hz[i] - Vz);
 			if (NoL > 0) {
 				const float v = VisibilityAshikhmin(NoV, NoL, linearRoughness);
-				const float d = DistributionCharlie(NoH, linearRoughness);
-				r += v * d * NoL * VoH; // VoH comes from the Jacobian, 1/(4*VoH)
+				r += v * samples.d[i] * NoL * VoH; // VoH comes from the Jacobian, 1/(4*VoH)
 			}
 		}
+#endif
 		// uniform sampling, the PDF is 1/2pi, 4 comes from the Jacobian
 		return r * (4.0f * 2.0f * (float)PI / numSamples);
 	}
 
-	static glm::vec2 DFV(float NoV, float linearRoughness, size_t numSamples)
+	//Returns the sums of Vis * NoL * VoH / NoH (x) and of the same times Fc (y) over the samples, which DFV and DFV_Multiscatter
+	//combine differently
+	static glm::vec2 DFV_Sums(float NoV, float linearRoughness, const HalfVectorSamples& samples)
 	{
+		const float Vx = std::sqrt(1 - NoV * NoV);
+		const float Vz = NoV;
+		const float a2 = linearRoughness * linearRoughness;
+		//the view half of the height correlated GGX visibility is the same for every sample
+		const float lambdaV = std::sqrt((NoV - NoV * a2) * NoV + a2);
+
 		glm::vec2 r(0);
+#if IBL_SSE2
+		const __m128 vx = _mm_set1_ps(Vx);
+		const __m128 vz = _mm_set1_ps(Vz);
+		const __m128 noV = _mm_set1_ps(NoV);
+		const __m128 alpha2 = _mm_set1_ps(a2);
+		const __m128 lambdaV4 = _mm_set1_ps(lambdaV);
+		const __m128 two = _mm_set1_ps(2.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		__m128 sumV = _mm_setzero_ps();
+		__m128 sumFc = _mm_setzero_ps();
+
+		for (size_t i = 0; i < samples.hx.size(); i += 4)
+		{
+			const __m128 hx = _mm_loadu_ps(&samples.hx[i]);
+			const __m128 hz = _mm_loadu_ps(&samples.hz[i]);
+
+			const __m128 VdotH = _mm_add_ps(_mm_mul_ps(vx, hx), _mm_mul_ps(vz, hz));
+			const __m128 VoH = Saturate4(VdotH);
+			const __m128 NoL = Saturate4(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(two, VdotH), hz), vz));
+			const __m128 NoH = Saturate4(hz);
+
+			// Height-correlated GGX
+			const __m128 GGXL = _mm_mul_ps(noV, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(NoL, _mm_mul_ps(NoL, alpha2)), NoL), alpha2)));
+			const __m128 GGXV = _mm_mul_ps(NoL, lambdaV4);
+			const __m128 vis = _mm_div_ps(half, _mm_add_ps(GGXV, GGXL));
+
+			const __m128 v = _mm_mul_ps(_mm_mul_ps(vis, NoL), _mm_div_ps(VoH, NoH));
+
+			const __m128 oneMinusVoH = _mm_sub_ps(one, VoH);
+			const __m128 oneMinusVoH2 = _mm_mul_ps(oneMinusVoH, oneMinusVoH);
+			const __m128 Fc = _mm_mul_ps(_mm_mul_ps(oneMinusVoH2, oneMinusVoH2), oneMinusVoH);
+
+			//the padding and samples under the horizon can produce NaNs - the mask zeroes them
+			const __m128 mask = _mm_cmpgt_ps(NoL, _mm_setzero_ps());
 
-		const glm::vec3 V(std::sqrt(1 - NoV * NoV), 0, NoV);
-		for (size_t i = 0; i < numSamples; ++i)
+			sumV = _mm_add_ps(sumV, _mm_and_ps(mask, v));
+			sumFc = _mm_add_ps(sumFc, _mm_and_ps(mask, _mm_mul_ps(v, Fc)));
+		}
+
+		r.x = HorizontalSum(sumV);
+		r.y = HorizontalSum(sumFc);
+#else
+		for (size_t i = 0; i < samples.count; ++i)
 		{
-			const glm::vec2 u = Hammersley(uint32_t(i), 1.0f / numSamples);
-			const glm::vec3 H = HemisphereImportanceSampleDggx(u, linearRoughness);
-			const glm::vec3 L = 2.f * glm::dot(V, H) * H - V;
-			const float VoH = Saturate(glm::dot(V, H));
-			const float NoL = Saturate(L.z);
-			const float NoH = Saturate(H.z);
+			const float VdotH = Vx * samples.hx[i] + Vz * samples.hz[i];
+			const float VoH = Saturate(VdotH);
+			const float NoL = Saturate(2 * VdotH * samples.hz[i] - Vz);
+			const float NoH = Saturate(samples.hz[i]);
 
 			if (NoL > 0)
 			{
 				const float v = Visibility(NoV, NoL, linearRoughness) * NoL * (VoH / NoH);
 				const float Fc = std::pow(1.f - VoH, 5);
-				r.x += v * (1.0f - Fc);
+				r.x += v;
 				r.y += v * Fc;
 			}
 		}
-
-		return r * (4.0f / numSamples);
+#endif
+		return r;
 	}
 
-	static glm::vec2 DFV_Multiscatter(float NoV, float linearRoughness, size_t numSamples)
+	static glm::vec2 DFV(float NoV, float linearRoughness, const HalfVectorSamples& samples)
 	{
-		glm::vec2 r (0);
+		const glm::vec2 sums = DFV_Sums(NoV, linearRoughness, samples);
 
-		const glm::vec3 V(std::sqrt(1 - NoV * NoV), 0, NoV);
-		for (size_t i = 0; i < numSamples; ++i)
-		{
-			const glm::vec2 u = Hammersley(uint32_t(i), 1.0f / numSamples);
-			const glm::vec3 H = HemisphereImportanceSampleDggx(u, linearRoughness);
-			const glm::vec3 L = 2.f * glm::dot(V, H) * H - V;
-			const float VoH = Saturate(glm::dot(V, H));
-			const float NoL = Saturate(L.z);
-			const float NoH = Saturate(H.z);
+		return glm::vec2(sums.x - sums.y, sums.y) * (4.0f / samples.count);
+	}
 
-			if (NoL > 0)
-			{
-				const float v = Visibility(NoV, NoL, linearRoughness) * NoL * (VoH / NoH);
-				const float Fc = std::pow(1.f - VoH, 5);
-				r.x += v * Fc;
-				r.y += v;
-			}	
-		}
+	static glm::vec2 DFV_Multiscatter(float NoV, float linearRoughness, const HalfVectorSamples& samples)
+	{
+		const glm::vec2 sums = DFV_Sums(NoV, linearRoughness, samples);
+
+		return glm::vec2(sums.y, sums.x) * (4.0f / samples.count);
+	}
 
-		return r * (4.0f / numSamples);
+	void CubemapIBL::SetNumThreads(size_t numThreads)
+	{
+		g_numThreads = numThreads;
 	}
 
+	size_t CubemapIBL::GetNumThreads()
+	{
+		return NumThreadsToUse();
+	}
 
 	void CubemapIBL::RoughnessFilter(
 		Cubemap& dst,
@@ -171,14 +412,16 @@ namespace r2::ibl
 		const size_t dim0 = base.GetDimensions();
 		const float omegaP = (4.0f * (float)PI) / float(6 * dim0 * dim0);
 
-		uint32_t progress = 0;
+		std::atomic_uint progress = { 0 };
+
+		const size_t dim = dst.GetDimensions();
 
-		if (abs(linearRoughness) < 0.0001f)
+		if (std::abs(linearRoughness) < 0.0001f)
 		{
 			auto Scanline = [&](size_t y, Cubemap::Face f, Cubemap::Texel* data, size_t dim) {
 				if (updater)
 				{
-					size_t p = progress + 1;
+					size_t p = ++progress;
 					updater(0, (float)p / ((float)dim * 6.0f), userData);
 				}
 
@@ -192,19 +435,16 @@ namespace r2::ibl
 				}
 			};
 
-			size_t dim = dst.GetDimensions();
-
-			for (size_t faceIndex = 0; faceIndex < 6; faceIndex++) {
-				const Cubemap::Face f = (Cubemap::Face)faceIndex;
+			ParallelFor(6 * dim, [&](size_t row) {
+				const Cubemap::Face f = (Cubemap::Face)(row / dim);
+				const size_t y = row % dim;
 				Image& image(dst.GetImageForFace(f));
 
-				for (size_t y = 0; y < dim; y++) {
-					Cubemap::Texel* data = static_cast<Cubemap::Texel*>(image.GetPixelPtr(0, y));
-					
-					Scanline(y, f, data, dim);
-				}
-			}
-			
+				Cubemap::Texel* data = static_cast<Cubemap::Texel*>(image.GetPixelPtr(0, y));
+
+				Scanline(y, f, data, dim);
+			});
+
 			return;
 		}
 
@@ -261,21 +501,27 @@ namespace r2::ibl
 			return lhs.brdf_NoL < rhs.brdf_NoL;
 		});
 
-		struct State
+		//the samples are the same for every texel - only their rotation changes
+		FilterSamples samples;
+
+		for (const auto& entry : cache)
 		{
-			std::default_random_engine gen;
-			std::uniform_real_distribution<float> distribution{ -PI, PI };
-		};
+			samples.Push(entry.L, entry.brdf_NoL, entry.lerp, entry.l0, entry.l1);
+		}
 
-		auto Scanline = [&](State& state, size_t y, Cubemap::Face f, Cubemap::Texel* data, size_t dim) {
+		samples.Pad();
+
+		auto Scanline = [&](std::default_random_engine& gen, size_t y, Cubemap::Face f, Cubemap::Texel* data, size_t dim) {
 			if (updater)
 			{
-				size_t p = progress++;
+				size_t p = ++progress;
 				updater(0, (float)p / ((float)dim * 6.0f), userData);
 			}
 
+			std::uniform_real_distribution<float> distribution{ -PI, PI };
+			std::vector<glm::vec3> directions(PaddedSize(samples.count));
+
 			glm::mat3 R;
-			const size_t numSamples = cache.size();
 			for (size_t x = 0; x < dim; ++x, ++data)
 			{
 				const glm::vec2 p(Cubemap::Center(x, y));
@@ -288,40 +534,26 @@ namespace r2::ibl
 
 				glm::mat4 R4 = glm::mat4(R);
 				
-				R = glm::mat3(glm::rotate(R4, state.distribution(state.gen), glm::vec3(0,0,1)));
-
-				glm::vec3 Li = glm::vec3(0);
-				for (size_t sample = 0; sample < numSamples; ++sample)
-				{
-					const CacheEntry& e = cache[sample];
-					const glm::vec3 L(R* e.L);
-					const Cubemap& cmBase = levels[e.l0];;
-					const Cubemap& next = levels[e.l1];
-					const Cubemap::Texel c0 = Cubemap::TrilinearFilterAt(cmBase, next, e.lerp, L);
+				R = glm::mat3(glm::rotate(R4, distribution(gen), glm::vec3(0,0,1)));
 
-					Cubemap::Texel result = c0* e.brdf_NoL;
+				RotateSamples(R, samples, directions.data());
 
-					glm::vec3 resultglm{ result.r, result.g, result.b };
-					Li += resultglm;
-				}
-				Cubemap::WriteAt(data, Cubemap::Texel(Li));
+				Cubemap::WriteAt(data, Cubemap::Texel(AccumulateSamples(levels, samples, directions.data())));
 			}
 		};
 
-
-		State state;
-		size_t dim = dst.GetDimensions();
-
-		for (size_t faceIndex = 0; faceIndex < 6; faceIndex++) {
-			const Cubemap::Face f = (Cubemap::Face)faceIndex;
+		ParallelFor(6 * dim, [&](size_t row) {
+			const Cubemap::Face f = (Cubemap::Face)(row / dim);
+			const size_t y = row % dim;
 			Image& image(dst.GetImageForFace(f));
 
-			for (size_t y = 0; y < dim; y++) {
-				Cubemap::Texel* data = static_cast<Cubemap::Texel*>(image.GetPixelPtr(0, y));
+			Cubemap::Texel* data = static_cast<Cubemap::Texel*>(image.GetPixelPtr(0, y));
 
-				Scanline(state, y, f, data, dim);
-			}
-		}
+			//seeded per row so the result doesn't depend on which thread ran the row
+			std::default_random_engine gen(static_cast<std::default_random_engine::result_type>(row + 1));
+
+			Scanline(gen, y, f, data, dim);
+		});
 	}
 
 	void CubemapIBL::DFG(Image& dst, bool multiscatter, bool cloth)
@@ -331,28 +563,62 @@ namespace r2::ibl
 		const size_t height = dst.GetHeight();
 		const size_t width = dst.GetWidth();
 
-		for (size_t y = 0; y < height; y++)
+		constexpr size_t NUM_DFV_SAMPLES = 1024;
+		constexpr size_t NUM_CHARLIE_SAMPLES = 4096;
+
+		//uniform hemisphere samples don't depend on the roughness so one table serves the whole LUT
+		HalfVectorSamples charlieSamples(cloth ? NUM_CHARLIE_SAMPLES : 0);
+
+		for (size_t i = 0; i < charlieSamples.count; ++i)
+		{
+			const glm::vec3 H = HemisphereUniformSample(Hammersley(uint32_t(i), 1.0f / NUM_CHARLIE_SAMPLES));
+			charlieSamples.hx[i] = H.x;
+			charlieSamples.hz[i] = H.z;
+		}
+
+		ParallelFor(height, [&](size_t y)
 		{
 			Cubemap::Texel* data = static_cast<Cubemap::Texel*>(dst.GetPixelPtr(0, y));
 
 			const float h = (float)height;
 			const float coord = Saturate((h - y + 0.5f) / h);
 			const float linear_roughness = coord * coord;
+
+			//every texel in a row has the same roughness so the importance samples are shared across the row
+			HalfVectorSamples samples(NUM_DFV_SAMPLES);
+
+			for (size_t i = 0; i < NUM_DFV_SAMPLES; ++i)
+			{
+				const glm::vec3 H = HemisphereImportanceSampleDggx(Hammersley(uint32_t(i), 1.0f / NUM_DFV_SAMPLES), linear_roughness);
+				samples.hx[i] = H.x;
+				samples.hz[i] = H.z;
+			}
+
+			HalfVectorSamples rowCharlieSamples(0);
+
+			if (cloth)
+			{
+				rowCharlieSamples = charlieSamples;
+				rowCharlieSamples.d.resize(rowCharlieSamples.hx.size(), 0.0f);
+
+				for (size_t i = 0; i < rowCharlieSamples.count; ++i)
+				{
+					rowCharlieSamples.d[i] = DistributionCharlie(Saturate(rowCharlieSamples.hz[i]), linear_roughness);
+				}
+			}
+
 			for (size_t x = 0; x < width; ++x, ++data)
 			{
 				const float NoV = Saturate((x + 0.5f) / width);
-				glm::vec3 r = { dfvFunction(NoV, linear_roughness, 1024), 0 };
+				glm::vec3 r = { dfvFunction(NoV, linear_roughness, samples), 0 };
 				if (cloth)
 				{
-					r.b = float(DFV_Charlie_Uniform(NoV, linear_roughness, 4096));
+					r.b = float(DFV_Charlie_Uniform(NoV, linear_roughness, rowCharlieSamples));
 				}
 
 				*data = r;
 			}
-
-
-		}
-		
+		});
 	}
 
 	void CubemapIBL::DiffuseIrradiance(Cubemap& dst, const std::vector<Cubemap>& levels,
@@ -366,20 +632,9 @@ namespace r2::ibl
 		const size_t dim0 = base.GetDimensions();
 		const float omegaP = (4.0f * (float)PI) / float(6 * dim0 * dim0);
 
-		//std::atomic_uint progress = { 0 };
-		uint32_t progress = 0;
+		std::atomic_uint progress = { 0 };
 
-
-		struct CacheEntry 
-		{
-			glm::vec3 L;
-			float lerp;
-			uint8_t l0;
-			uint8_t l1;
-		};
-
-		std::vector<CacheEntry> cache;
-		cache.reserve(maxNumSamples);
+		FilterSamples samples;
 
 		for (size_t sampleIndex = 0; sampleIndex < maxNumSamples; ++sampleIndex)
 		{
@@ -400,53 +655,47 @@ namespace r2::ibl
 				uint8_t l0 = uint8_t(mipLevel);
 				uint8_t l1 = uint8_t(std::min(maxLevel, size_t(l0 + 1)));
 				float lerp = mipLevel - (float)l0;
-				cache.push_back({ L, lerp, l0, l1 });
+				samples.Push(L, 1.0f, lerp, l0, l1);
 			}
+		}
+
+		samples.Pad();
+
+		const size_t dim = dst.GetDimensions();
+
+		ParallelFor(6 * dim, [&](size_t row)
+		{
+			const Cubemap::Face f = (Cubemap::Face)(row / dim);
+			const size_t y = row % dim;
+			Image& image(dst.GetImageForFace(f));
 
-			const size_t dim = dst.GetDimensions();
+			Cubemap::Texel* data = static_cast<Cubemap::Texel*>(image.GetPixelPtr(0, y));
 
-			for (size_t faceIndex = 0; faceIndex < 6; faceIndex++) 
+			if (updater)
 			{
-				const Cubemap::Face f = (Cubemap::Face)faceIndex;
-				Image& image(dst.GetImageForFace(f));
+				size_t p = ++progress;
+				updater(0, (float)p / ((float)dim * 6.0f), userData);
+			}
 
-				for (size_t y = 0; y < dim; y++) 
-				{
-					Cubemap::Texel* data = static_cast<Cubemap::Texel*>(image.GetPixelPtr(0, y));
-					
-					if (updater)
-					{
-						progress++;
-						updater(0, (float)progress / ((float)dim * 6.0f), userData);
-					}
-
-					glm::mat3 R;
-					const size_t numSamples = cache.size();
-					for (size_t x = 0; x < dim; ++x, ++data)
-					{
-						const glm::vec2 p(Cubemap::Center(x, y));
-						const glm::vec3 N(dst.GetDirectionFor(f, p.x, p.y));
-
-						const glm::vec3 up = std::abs(N.z) < 0.999 ? glm::vec3(0, 0, 1) : glm::vec3(1, 0, 0);
-						R[0] = glm::normalize(glm::cross(up, N));
-						R[1] = glm::cross(N, R[0]);
-						R[2] = N;
-
-						Cubemap::Texel Li = Cubemap::Texel(0.0f);
-						for (size_t sample = 0; sample < numSamples; ++sample)
-						{
-							const CacheEntry& e = cache[sample];
-							const glm::vec3 L(R* e.L);
-							const Cubemap& cmBase = levels[e.l0];
-							const Cubemap& next = levels[e.l1];
-							const Cubemap::Texel c0 = Cubemap::TrilinearFilterAt(cmBase, next, e.lerp, L);
-							Li += c0;
-						}
-
-						Cubemap::WriteAt(data, Cubemap::Texel(Li* inumSamples));
-					}
-				}
+			std::vector<glm::vec3> directions(PaddedSize(samples.count));
+
+			glm::mat3 R;
+			for (size_t x = 0; x < dim; ++x, ++data)
+			{
+				const glm::vec2 p(Cubemap::Center(x, y));
+				const glm::vec3 N(dst.GetDirectionFor(f, p.x, p.y));
+
+				const glm::vec3 up = std::abs(N.z) < 0.999 ? glm::vec3(0, 0, 1) : glm::vec3(1, 0, 0);
+				R[0] = glm::normalize(glm::cross(up, N));
+				R[1] = glm::cross(N, R[0]);
+				R[2] = N;
+
+				RotateSamples(R, samples, directions.data());
+
+				const glm::vec3 Li = AccumulateSamples(levels, samples, directions.data());
+
+				Cubemap::WriteAt(data, Cubemap::Texel(Li * inumSamples));
 			}
-		}
+		});
 	}
-}
\ No newline at end of file
+}
@@ -11,6 +11,7 @@
 #include "r2/Platform/Platform.h"
 #include "r2/Core/Containers/SinglyLinkedList.h"
 #include "r2/Core/Events/AppEvent.h"
+#include "r2/Core/Jobs/JobSystem.h"
 
 namespace
 {
@@ -91,6 +92,11 @@ namespace r2
     {
         return false;
     }
+
+    u32 Application::GetMaxNumJobWorkerThreads() const
+    {
+        return r2::jobs::MAX_NUM_JOB_WORKER_THREADS;
+    }
     
     std::string Application::GetAppLogPath() const
     {
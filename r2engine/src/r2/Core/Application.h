@@ -91,6 +91,7 @@ namespace r2
         virtual bool ShouldScaleResolution() const;
         virtual bool IsWindowResizable() const;
         virtual bool WindowShouldBeMaximized() const;
+        virtual u32 GetMaxNumJobWorkerThreads() const;
 
         virtual std::string GetAppLogPath() const;
         virtual r2::asset::PathResolver GetPathResolver() const;
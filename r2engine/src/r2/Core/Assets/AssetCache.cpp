@@ -18,24 +18,37 @@
 #include "r2/Core/Memory/Allocators/MallocAllocator.h"
 #endif
 
-#define NOT_INITIALIZED !mAssetLRU || !mAssetMap || !mAssetLoaders
+#define NOT_INITIALIZED !mAssetIndexMap || !mAssetMap || !mAssetLoaders
 
 namespace r2::asset
 {
     
     const u32 AssetCache::LRU_CAPACITY;
     const u32 AssetCache::MAP_CAPACITY;
+    const s32 AssetCache::INVALID_INDEX;
+    const u32 AssetCache::MAX_EVICTION_CANDIDATES;
+    const u32 AssetCache::MAX_NUM_ASYNC_LOAD_REQUESTS;
+    const u32 AssetCache::DEFAULT_MAX_NUM_IN_FLIGHT_READS;
     
     AssetCache::AssetCache(u64 slot, const r2::mem::utils::MemBoundary& boundary)
-        : mAssetLRU(nullptr)
-        , mAssetMap(nullptr)
+        : mAssetMap(nullptr)
+        , mAssetIndexMap(nullptr)
         , mAssetLoaders(nullptr)
+        , mLRUHead(INVALID_INDEX)
+        , mLRUTail(INVALID_INDEX)
+        , mLRUSize(0)
+        , mLRUCapacity(0)
+        , mCompactionEnabled(false)
         , mDefaultLoader(nullptr)
         , mSlot(slot)
         , mAssetCacheArena(boundary)
         , mAssetBufferPoolPtr(nullptr)
         , mMemoryHighWaterMark(0)
         , mMemoryBoundary(boundary)
+        , mAsyncLoadRequests(nullptr)
+        , mNextAsyncLoadSequence(0)
+        , mNumInFlightReads(0)
+        , mMaxNumInFlightReads(DEFAULT_MAX_NUM_IN_FLIGHT_READS)
     {
         
     }
@@ -45,13 +58,20 @@ namespace r2::asset
 
         //Memory allocations for our lists and maps
         {
-            mAssetLRU = MAKE_SQUEUE(mAssetCacheArena, AssetHandle, lruCapacity);
             mAssetMap = MAKE_SARRAY(mAssetCacheArena, AssetBufferRef, mapCapacity);
+            mAssetIndexMap = MAKE_SHASHMAP(mAssetCacheArena, s32, mapCapacity * r2::SHashMap<s32>::LoadFactorMultiplier());
             mDefaultLoader = ALLOC(DefaultAssetLoader, mAssetCacheArena);
             mAssetLoaders = MAKE_SARRAY(mAssetCacheArena, AssetLoader*, lruCapacity);
             mAssetBufferPoolPtr = MAKE_POOL_ARENA(mAssetCacheArena, sizeof(AssetBuffer), alignof(AssetBuffer), lruCapacity);
+            mAsyncLoadRequests = ALLOC_ARRAYN(AsyncLoadRequest, MAX_NUM_ASYNC_LOAD_REQUESTS, mAssetCacheArena);
         }
 
+        //every asset in the map is in the LRU so we can't hold more than the map can
+        mLRUCapacity = std::min(lruCapacity, mapCapacity);
+        mLRUHead = INVALID_INDEX;
+        mLRUTail = INVALID_INDEX;
+        mLRUSize = 0;
+
         return true;
     }
     
@@ -70,6 +90,28 @@ namespace r2::asset
         PrintAssetMap();
         
 #endif
+        //Drop anything that hasn't started yet and let the rest finish so no job is left writing into our memory
+        for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+        {
+            if (mAsyncLoadRequests[i].mStage == ASYNC_LOAD_STAGE_QUEUED)
+            {
+                ReleaseAsyncLoadRequest(mAsyncLoadRequests[i]);
+            }
+        }
+
+        while (NumPendingAsyncLoads() > 0)
+        {
+            for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+            {
+                if (mAsyncLoadRequests[i].mStage != ASYNC_LOAD_STAGE_FREE && r2::jobs::IsInitialized())
+                {
+                    r2::jobs::WaitForCounter(mAsyncLoadRequests[i].mCounter);
+                }
+            }
+
+            Update();
+        }
+
         FlushAll();
 
         s32 numLoaders = static_cast<s32>(r2::sarr::Size(*mAssetLoaders) );
@@ -80,13 +122,15 @@ namespace r2::asset
         }
         
         FREE(mDefaultLoader, mAssetCacheArena);
-        FREE(mAssetLRU, mAssetCacheArena);
+        FREE(mAssetIndexMap, mAssetCacheArena);
         FREE(mAssetMap, mAssetCacheArena);
         FREE(mAssetLoaders, mAssetCacheArena);
         FREE(mAssetBufferPoolPtr, mAssetCacheArena);
+        FREE_ARRAY(mAsyncLoadRequests, mAssetCacheArena);
 
 
-        mAssetLRU = nullptr;
+        mAsyncLoadRequests = nullptr;
+        mAssetIndexMap = nullptr;
         mAssetMap = nullptr;
         mAssetLoaders = nullptr;
         mDefaultLoader = nullptr;
@@ -105,6 +149,22 @@ namespace r2::asset
         }
         
         AssetHandle handle = { asset.HashID(), mSlot };
+
+        //It's already on its way in - just finish it instead of loading it twice
+        const s32 asyncRequestIndex = FindAsyncLoadRequest(asset.HashID());
+        if (asyncRequestIndex != INVALID_INDEX)
+        {
+            AsyncAssetLoadHandle loadHandle;
+            loadHandle.assetHandle = handle;
+            loadHandle.requestIndex = static_cast<u32>(asyncRequestIndex);
+            loadHandle.generation = mAsyncLoadRequests[asyncRequestIndex].mGeneration;
+
+            if (WaitForAsyncLoad(loadHandle) != ASSET_LOAD_STATUS_LOADED)
+            {
+                return invalidHandle;
+            }
+        }
+
         AssetBufferRef theDefault;
         AssetBufferRef& bufferRef = Find(asset.HashID(), theDefault);
         
@@ -124,6 +184,260 @@ namespace r2::asset
         return handle;
     }
 
+    AsyncAssetLoadHandle AssetCache::LoadAssetAsync(const Asset& asset, AssetLoadPriority priority)
+    {
+        R2_CHECK(!NOT_INITIALIZED, "We haven't initialized the asset cache");
+
+        AsyncAssetLoadHandle loadHandle;
+
+        if (NOT_INITIALIZED)
+        {
+            return loadHandle;
+        }
+
+        loadHandle.assetHandle = { asset.HashID(), mSlot };
+
+        const s32 existingRequestIndex = FindAsyncLoadRequest(asset.HashID());
+
+        if (existingRequestIndex != INVALID_INDEX)
+        {
+            AsyncLoadRequest& existingRequest = mAsyncLoadRequests[existingRequestIndex];
+            existingRequest.mPriority = std::min(existingRequest.mPriority, priority);
+
+            loadHandle.requestIndex = static_cast<u32>(existingRequestIndex);
+            loadHandle.generation = existingRequest.mGeneration;
+            return loadHandle;
+        }
+
+        //Already loaded - generation 0 makes the status come straight from the cache
+        if (GetMapIndex(asset.HashID()) != INVALID_INDEX)
+        {
+            return loadHandle;
+        }
+
+        AssetFile* theAssetFile = lib::GetAssetFileForAsset(MENG.GetAssetLib(), asset);
+
+        if (!theAssetFile)
+        {
+            R2_CHECK(false, "Failed to find the asset file for asset: %llu", asset.HashID());
+            loadHandle.assetHandle = {};
+            return loadHandle;
+        }
+
+        AsyncLoadRequest* request = nullptr;
+        u32 requestIndex = 0;
+
+        for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+        {
+            if (mAsyncLoadRequests[i].mStage == ASYNC_LOAD_STAGE_FREE)
+            {
+                request = &mAsyncLoadRequests[i];
+                requestIndex = i;
+                break;
+            }
+        }
+
+        if (!request)
+        {
+            //@NOTE(Serge): we're out of requests - better to hitch than to drop the load
+            LoadAsset(asset);
+            return loadHandle;
+        }
+
+        request->mAsset = asset;
+        request->mAssetFile = theAssetFile;
+        request->mPriority = priority;
+        request->mSequence = mNextAsyncLoadSequence++;
+        request->mStage = ASYNC_LOAD_STAGE_QUEUED;
+
+        ++request->mGeneration;
+        if (request->mGeneration == 0)
+        {
+            request->mGeneration = 1;
+        }
+
+        loadHandle.requestIndex = requestIndex;
+        loadHandle.generation = request->mGeneration;
+
+        Update();
+
+        return loadHandle;
+    }
+
+    AssetLoadStatus AssetCache::GetAsyncLoadStatus(const AsyncAssetLoadHandle& loadHandle) const
+    {
+        if (NOT_INITIALIZED || IsInvalidAssetHandle(loadHandle.assetHandle))
+        {
+            return ASSET_LOAD_STATUS_INVALID;
+        }
+
+        if (loadHandle.generation != 0 && loadHandle.requestIndex < MAX_NUM_ASYNC_LOAD_REQUESTS)
+        {
+            const AsyncLoadRequest& request = mAsyncLoadRequests[loadHandle.requestIndex];
+
+            if (request.mGeneration == loadHandle.generation && request.mStage != ASYNC_LOAD_STAGE_FREE)
+            {
+                return request.mStage == ASYNC_LOAD_STAGE_QUEUED ? ASSET_LOAD_STATUS_QUEUED : ASSET_LOAD_STATUS_LOADING;
+            }
+        }
+
+        if (GetMapIndex(loadHandle.assetHandle.handle) != INVALID_INDEX)
+        {
+            return ASSET_LOAD_STATUS_LOADED;
+        }
+
+        return loadHandle.generation != 0 ? ASSET_LOAD_STATUS_FAILED : ASSET_LOAD_STATUS_INVALID;
+    }
+
+    AssetLoadStatus AssetCache::WaitForAsyncLoad(const AsyncAssetLoadHandle& loadHandle)
+    {
+        for (;;)
+        {
+            Update();
+
+            const AssetLoadStatus status = GetAsyncLoadStatus(loadHandle);
+
+            if (status != ASSET_LOAD_STATUS_QUEUED && status != ASSET_LOAD_STATUS_LOADING)
+            {
+                return status;
+            }
+
+            if (!r2::jobs::IsInitialized())
+            {
+                continue;
+            }
+
+            AsyncLoadRequest& request = mAsyncLoadRequests[loadHandle.requestIndex];
+
+            if (request.mStage != ASYNC_LOAD_STAGE_QUEUED)
+            {
+                r2::jobs::WaitForCounter(request.mCounter);
+                continue;
+            }
+
+            //Still queued behind other reads so wait for one of those to free up a spot
+            for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+            {
+                if (mAsyncLoadRequests[i].mStage == ASYNC_LOAD_STAGE_READING || mAsyncLoadRequests[i].mStage == ASYNC_LOAD_STAGE_PROCESSING)
+                {
+                    r2::jobs::WaitForCounter(mAsyncLoadRequests[i].mCounter);
+                    break;
+                }
+            }
+        }
+    }
+
+    void AssetCache::SetMaxNumInFlightReads(u32 maxNumInFlightReads)
+    {
+        R2_CHECK(maxNumInFlightReads > 0, "We need to be able to have at least one read in flight");
+        mMaxNumInFlightReads = std::max(maxNumInFlightReads, 1u);
+    }
+
+    u32 AssetCache::NumPendingAsyncLoads() const
+    {
+        u32 numPending = 0;
+
+        for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+        {
+            if (mAsyncLoadRequests[i].mStage != ASYNC_LOAD_STAGE_FREE)
+            {
+                ++numPending;
+            }
+        }
+
+        return numPending;
+    }
+
+    void AssetCache::Update()
+    {
+        if (NOT_INITIALIZED)
+        {
+            return;
+        }
+
+        //Move along the loads whose jobs are done
+        for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+        {
+            AsyncLoadRequest& request = mAsyncLoadRequests[i];
+
+            if (request.mStage != ASYNC_LOAD_STAGE_READING && request.mStage != ASYNC_LOAD_STAGE_PROCESSING)
+            {
+                continue;
+            }
+
+            if (request.mCounter.value.load(std::memory_order_acquire) > 0)
+            {
+                continue;
+            }
+
+            if (request.mStage == ASYNC_LOAD_STAGE_READING)
+            {
+                --mNumInFlightReads;
+
+                if (!request.mSucceeded)
+                {
+                    FailAsyncLoad(request);
+                }
+                else if (!request.mLoader->ShouldProcess())
+                {
+                    request.mAssetBuffer.Load(request.mRawBuffer, request.mRawSize);
+                    request.mAssetBufferIsMapped = request.mRawIsMapped;
+                    request.mRawBuffer = nullptr;
+                    FinishAsyncLoad(request);
+                }
+                else if (!StartAsyncProcess(request))
+                {
+                    FailAsyncLoad(request);
+                }
+            }
+            else if (request.mSucceeded)
+            {
+                FinishAsyncLoad(request);
+            }
+            else
+            {
+                FailAsyncLoad(request);
+            }
+        }
+
+        //Start new reads - critical loads first, then oldest first. Prefetches always leave a read open for critical loads.
+        while (mNumInFlightReads < mMaxNumInFlightReads)
+        {
+            AsyncLoadRequest* nextRequest = nullptr;
+
+            for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+            {
+                AsyncLoadRequest& request = mAsyncLoadRequests[i];
+
+                if (request.mStage != ASYNC_LOAD_STAGE_QUEUED || IsFileBusy(request.mAssetFile))
+                {
+                    continue;
+                }
+
+                if (request.mPriority == ASSET_LOAD_PRIORITY_PREFETCH && mMaxNumInFlightReads > 1 && mNumInFlightReads + 1 >= mMaxNumInFlightReads)
+                {
+                    continue;
+                }
+
+                if (!nextRequest || request.mPriority < nextRequest->mPriority ||
+                    (request.mPriority == nextRequest->mPriority && request.mSequence < nextRequest->mSequence))
+                {
+                    nextRequest = &request;
+                }
+            }
+
+            if (!nextRequest)
+            {
+                break;
+            }
+
+            if (!StartAsyncRead(*nextRequest))
+            {
+                FailAsyncLoad(*nextRequest);
+            }
+        }
+    }
+
     bool AssetCache::IsAssetLoaded(const Asset& asset)
     {
         return IsLoaded(asset);
@@ -217,13 +531,63 @@ namespace r2::asset
             return;
         }
         
-        const u64 size = r2::squeue::Size(*mAssetLRU);
+        const u64 size = mLRUSize;
         
         for (u64 i = 0; i < size; ++i)
         {
             FreeOneResource(true);
         }
     }
+
+    void AssetCache::CompactUnreferencedBuffers()
+    {
+        R2_CHECK(!NOT_INITIALIZED, "We haven't initialized the asset cache");
+        if (NOT_INITIALIZED)
+        {
+            return;
+        }
+
+        const u32 numAssetsInMap = r2::sarr::Size(*mAssetMap);
+
+        for (u32 i = 0; i < numAssetsInMap; ++i)
+        {
+            AssetBufferRef& assetBufferRef = r2::sarr::At(*mAssetMap, i);
+
+            if (assetBufferRef.mAssetBuffer == nullptr || assetBufferRef.mRefCount > 0 || assetBufferRef.mMappedFile != nullptr)
+            {
+                continue;
+            }
+
+            //@NOTE(Serge): processed assets can have pointers into their own buffer so only the raw ones can be moved
+            AssetLoader* loader = GetAssetLoader(assetBufferRef.mAsset.GetType());
+            if (loader != nullptr && loader->ShouldProcess())
+            {
+                continue;
+            }
+
+            AssetBuffer* assetBuffer = assetBufferRef.mAssetBuffer;
+            const u64 size = assetBuffer->Size();
+
+            byte* newBuffer = ALLOC_BYTESN(mAssetCacheArena, size, alignof(size_t));
+
+            if (newBuffer == nullptr)
+            {
+                continue;
+            }
+
+            //Only worth moving if it fills an earlier hole, otherwise we'd just be shuffling memory around
+            if (newBuffer < assetBuffer->Data())
+            {
+                memcpy(newBuffer, assetBuffer->Data(), size);
+                FREE(assetBuffer->MutableData(), mAssetCacheArena);
+                assetBuffer->Load(newBuffer, size);
+            }
+            else
+            {
+                FREE(newBuffer, mAssetCacheArena);
+            }
+        }
+    }
     
     int AssetCache::Preload(const char* pattern, AssetLoadProgressCallback callback)
     {
@@ -303,33 +667,62 @@ namespace r2::asset
             return nullptr;
         }
 
+        //An async load is reading from this file right now - let it finish before we move the file position around
+        while (IsFileBusy(theAssetFile))
+        {
+            for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS && r2::jobs::IsInitialized(); ++i)
+            {
+                if (mAsyncLoadRequests[i].mAssetFile == theAssetFile)
+                {
+                    r2::jobs::WaitForCounter(mAsyncLoadRequests[i].mCounter);
+                }
+            }
+
+            Update();
+        }
+
         if (!theAssetFile->IsOpen())
         {
             theAssetFile->Open();
         }
         
+        //Make sure there's a spot in the LRU before we start allocating
+        while (mLRUSize >= mLRUCapacity && mLRUSize > 0)
+        {
+            FreeOneResource(true);
+        }
+
         AssetHandle handle = { asset.HashID(), mSlot};
-        u64 rawAssetSize = theAssetFile->RawAssetSize(asset);
-        
-        bool result = MakeRoom(rawAssetSize);
-        
-        R2_CHECK(result, "We don't have enough room to fit %s!\n", theAssetFile->FilePath());
-        
-        byte* rawAssetBuffer = ALLOC_BYTESN(mAssetCacheArena, rawAssetSize, alignof(size_t));
-		
-        if (rawAssetBuffer == nullptr)
-		{
+        u64 rawAssetSize = 0;
+
+        //Memory mapped files let us use the asset where it is instead of copying it into the cache first
+        byte* rawAssetBuffer = const_cast<byte*>(theAssetFile->MapRawAsset(asset, rawAssetSize));
+        const bool rawIsMapped = rawAssetBuffer != nullptr;
+
+        if (!rawIsMapped)
+        {
+            rawAssetSize = theAssetFile->RawAssetSize(asset);
+
+            bool result = MakeRoom(rawAssetSize);
+
+            R2_CHECK(result, "We don't have enough room to fit %s!\n", theAssetFile->FilePath());
+
+            rawAssetBuffer = ALLOC_BYTESN(mAssetCacheArena, rawAssetSize, alignof(size_t));
+
+            if (rawAssetBuffer == nullptr)
+            {
 #ifdef R2_ASSET_CACHE_DEBUG
-			R2_CHECK(false, "Failed to get the raw data from the asset: %s\n", asset.Name().c_str());
+                R2_CHECK(false, "Failed to get the raw data from the asset: %s\n", asset.Name().c_str());
 #endif
-			return nullptr;
-		}
+                return nullptr;
+            }
 
-        R2_CHECK(rawAssetBuffer != nullptr, "failed to allocate asset handle: %lli of size: %llu", handle, rawAssetSize);
-        
-        mMemoryHighWaterMark = std::max(mMemoryHighWaterMark, mAssetCacheArena.TotalBytesAllocated());
+            R2_CHECK(rawAssetBuffer != nullptr, "failed to allocate asset handle: %lli of size: %llu", handle, rawAssetSize);
 
-        theAssetFile->LoadRawAsset(asset, rawAssetBuffer, (u32)rawAssetSize);
+            mMemoryHighWaterMark = std::max(mMemoryHighWaterMark, mAssetCacheArena.TotalBytesAllocated());
+
+            theAssetFile->LoadRawAsset(asset, rawAssetBuffer, (u32)rawAssetSize);
+        }
 
         AssetBuffer* assetBuffer = nullptr;
         
@@ -339,13 +732,17 @@ namespace r2::asset
 #endif
         if (assetBuffer == nullptr)
         {
+            FreeRawBuffer(theAssetFile, asset, rawAssetBuffer, rawIsMapped);
             theAssetFile->Close();
             return nullptr;
         }
         
+        AssetFile* mappedFile = nullptr;
+
         if (!loader->ShouldProcess())
         {
             assetBuffer->Load(rawAssetBuffer, rawAssetSize);
+            mappedFile = rawIsMapped ? theAssetFile : nullptr;
         }
         else
         {
@@ -391,16 +788,20 @@ namespace r2::asset
 				return nullptr;
 			}
 
-			FREE(rawAssetBuffer, mAssetCacheArena);
+            FreeRawBuffer(theAssetFile, asset, rawAssetBuffer, rawIsMapped);
         }
 
         AssetBufferRef bufferRef;
         bufferRef.mAssetBuffer = assetBuffer;
         bufferRef.mAsset = asset;
+        bufferRef.mMappedFile = mappedFile;
 
         r2::sarr::Push(*mAssetMap, bufferRef);
 
-        UpdateLRU(handle);
+        const s32 mapIndex = static_cast<s32>(r2::sarr::Size(*mAssetMap)) - 1;
+        r2::shashmap::Set(*mAssetIndexMap, asset.HashID(), mapIndex);
+
+        LinkLRUFront(mapIndex);
         
 #if ASSET_CACHE_DEBUG
         PrintAssetMap();
@@ -412,55 +813,73 @@ namespace r2::asset
     
     void AssetCache::UpdateLRU(AssetHandle handle)
     {
-        s64 lruIndex = GetLRUIndex(handle);
-        
-        if (lruIndex == -1)
-        {
-            if (r2::squeue::Space(*mAssetLRU) <= 0)
-            {
-                FreeOneResource(true);
-                //R2_CHECK(false, "AssetCache::UpdateLRU() - We have too many assets in our LRU");
-                return;
-            }
-            
-            r2::squeue::PushFront(*mAssetLRU, handle);
-        }
-        else
+        const s32 mapIndex = GetMapIndex(handle.handle);
+
+        if (mapIndex == INVALID_INDEX || mapIndex == mLRUHead)
         {
-            //otherwise move it to the front
-            r2::squeue::MoveToFront(*mAssetLRU, lruIndex);
+            return;
         }
+
+        UnlinkLRU(mapIndex);
+        LinkLRUFront(mapIndex);
     }
 
     AssetCache::AssetBufferRef& AssetCache::Find(u64 handle, AssetCache::AssetBufferRef& theDefault)
     {
-        const u32 numAssetsInMap = r2::sarr::Size(*mAssetMap);
+        const s32 mapIndex = GetMapIndex(handle);
 
-        for (u32 i = 0; i < numAssetsInMap; ++i)
+        if (mapIndex == INVALID_INDEX)
         {
-            auto& assetBufferRef = r2::sarr::At(*mAssetMap, i);
-            if (assetBufferRef.mAsset.HashID() == handle)
-            {
-                return assetBufferRef;
-            }
+            return theDefault;
         }
 
-        return theDefault;
+        return r2::sarr::At(*mAssetMap, mapIndex);
+    }
+
+    s32 AssetCache::GetMapIndex(u64 handle) const
+    {
+        return r2::shashmap::Get(*mAssetIndexMap, handle, INVALID_INDEX);
     }
 
     void AssetCache::RemoveAssetBuffer(u64 handle)
     {
-		const u32 numAssetsInMap = r2::sarr::Size(*mAssetMap);
+        const s32 mapIndex = GetMapIndex(handle);
 
-        for (u32 i = 0; i < numAssetsInMap; ++i)
+        if (mapIndex == INVALID_INDEX)
+        {
+            return;
+        }
+
+        const s32 lastIndex = static_cast<s32>(r2::sarr::Size(*mAssetMap)) - 1;
+
+        if (mapIndex != lastIndex)
         {
-            auto& assetBufferRef = r2::sarr::At(*mAssetMap, i);
-            if (assetBufferRef.mAsset.HashID() == handle)
+            //The last element is about to be swapped into mapIndex so anything pointing at it needs to point at mapIndex instead
+            const AssetBufferRef& lastRef = r2::sarr::At(*mAssetMap, lastIndex);
+
+            if (lastRef.mLRUPrev != INVALID_INDEX)
             {
-                r2::sarr::RemoveAndSwapWithLastElement(*mAssetMap, i);
-                break;
+                r2::sarr::At(*mAssetMap, lastRef.mLRUPrev).mLRUNext = mapIndex;
+            }
+            else if (mLRUHead == lastIndex)
+            {
+                mLRUHead = mapIndex;
+            }
+
+            if (lastRef.mLRUNext != INVALID_INDEX)
+            {
+                r2::sarr::At(*mAssetMap, lastRef.mLRUNext).mLRUPrev = mapIndex;
             }
+            else if (mLRUTail == lastIndex)
+            {
+                mLRUTail = mapIndex;
+            }
+
+            r2::shashmap::Set(*mAssetIndexMap, lastRef.mAsset.HashID(), mapIndex);
         }
+
+        r2::sarr::RemoveAndSwapWithLastElement(*mAssetMap, mapIndex);
+        r2::shashmap::Remove(*mAssetIndexMap, handle);
     }
     
     void AssetCache::Free(AssetHandle handle, bool forceFree)
@@ -492,13 +911,13 @@ namespace r2::asset
                     assetLoader->FreeAsset(*assetBufferRef.mAssetBuffer);
                 }
 
-                FREE(assetBufferRef.mAssetBuffer->MutableData(), mAssetCacheArena);
+                FreeRawBuffer(assetBufferRef.mMappedFile, theAsset, assetBufferRef.mAssetBuffer->MutableData(), assetBufferRef.mMappedFile != nullptr);
                 
                 FREE(assetBufferRef.mAssetBuffer, *mAssetBufferPoolPtr);
 
-                RemoveAssetBuffer(handle.handle);
-
                 RemoveFromLRU(handle);
+
+                RemoveAssetBuffer(handle.handle);
             }
         }
     }
@@ -506,21 +925,36 @@ namespace r2::asset
     bool AssetCache::MakeRoom(u64 amount)
     {
         const auto cacheMemorySize = mAssetCacheArena.MemorySize();
-        if(amount > cacheMemorySize)
+        const u64 requiredBlockSize = GetRequiredBlockSize(amount);
+
+        if(requiredBlockSize > cacheMemorySize)
         {
             R2_CHECK(false, "Can't even fit %llu into the total amount we have: %llu", amount, mAssetCacheArena.MemorySize());
             return false;
         }
+
+        bool triedCompacting = false;
         
-        while (amount > (cacheMemorySize - mAssetCacheArena.TotalBytesAllocated()))
+        //Having enough free bytes isn't enough, they need to be in one block or the allocation will still fail
+        while (mAssetCacheArena.LargestFreeBlockSize() < requiredBlockSize)
         {
-            if (r2::squeue::Size(*mAssetLRU) == 0)
+            if (mCompactionEnabled && !triedCompacting && mAssetCacheArena.UnallocatedBytes() >= requiredBlockSize)
+            {
+                triedCompacting = true;
+                CompactUnreferencedBuffers();
+                continue;
+            }
+
+            if (mLRUSize == 0)
             {
                 R2_CHECK(false, "We still don't have enough room to fit: %llu", amount);
                 return false;
             }
-            
-            FreeOneResource(true);
+
+            const s32 mapIndex = GetEvictionCandidate(requiredBlockSize);
+            const AssetBufferRef& assetBufferRef = r2::sarr::At(*mAssetMap, mapIndex);
+
+            Free({ assetBufferRef.mAsset.HashID(), mSlot }, true);
         }
         
         return true;
@@ -528,43 +962,369 @@ namespace r2::asset
     
     void AssetCache::FreeOneResource(bool forceFree)
     {
-        const u64 size = r2::squeue::Size(*mAssetLRU);
-        
-        if (size > 0)
+        if (mLRUTail != INVALID_INDEX)
         {
-            AssetHandle handle = r2::squeue::Last(*mAssetLRU);
+            AssetHandle handle = { r2::sarr::At(*mAssetMap, mLRUTail).mAsset.HashID(), mSlot };
             Free(handle, forceFree);
-            
-          //  RemoveFromLRU(handle);
         }
     }
-    
-    s64 AssetCache::GetLRUIndex(AssetHandle handle)
+
+    s32 AssetCache::GetEvictionCandidate(u64 requiredBlockSize)
     {
-        u64 queueSize = r2::squeue::Size(*mAssetLRU);
-        
-        for (u64 i = 0; i < queueSize; ++i)
+        //Look at the few least recently used assets and skip the ones that are still referenced. Take the first one that would open up a big
+        //enough block when freed, otherwise the one that grows the largest block the most. If they're all referenced we fall back to plain LRU.
+        s32 bestIndex = INVALID_INDEX;
+        u64 bestBlockSize = 0;
+        u32 numCandidates = 0;
+
+        for (s32 mapIndex = mLRUTail; mapIndex != INVALID_INDEX && numCandidates < MAX_EVICTION_CANDIDATES; mapIndex = r2::sarr::At(*mAssetMap, mapIndex).mLRUPrev)
         {
-            if ((*mAssetLRU)[i].handle == handle.handle)
+            const AssetBufferRef& assetBufferRef = r2::sarr::At(*mAssetMap, mapIndex);
+
+            ++numCandidates;
+
+            //Mapped assets don't take up any cache memory so getting rid of them won't make room
+            if (assetBufferRef.mRefCount > 0 || assetBufferRef.mMappedFile != nullptr)
+            {
+                continue;
+            }
+
+            const u64 freeBlockSize = mAssetCacheArena.FreeBlockSizeAfterFree(assetBufferRef.mAssetBuffer->MutableData());
+
+            if (freeBlockSize >= requiredBlockSize)
+            {
+                return mapIndex;
+            }
+
+            if (freeBlockSize > bestBlockSize)
             {
-                return i;
+                bestBlockSize = freeBlockSize;
+                bestIndex = mapIndex;
             }
         }
-        
-        return -1;
+
+        return bestIndex != INVALID_INDEX ? bestIndex : mLRUTail;
+    }
+
+    u64 AssetCache::GetRequiredBlockSize(u64 amount) const
+    {
+        u32 headerSize = 0;
+        u32 boundsChecking = 0;
+#ifdef R2_ASSET_PIPELINE
+        headerSize = r2::mem::MallocAllocator::HeaderSize();
+#else
+        headerSize = r2::mem::FreeListAllocator::HeaderSize();
+#endif
+#if defined(R2_DEBUG) || defined(R2_RELEASE)
+        boundsChecking = r2::mem::BasicBoundsChecking::SIZE_FRONT + r2::mem::BasicBoundsChecking::SIZE_BACK;
+#endif
+        return amount + headerSize + boundsChecking + alignof(size_t);
+    }
+
+    void AssetCache::LinkLRUFront(s32 mapIndex)
+    {
+        AssetBufferRef& assetBufferRef = r2::sarr::At(*mAssetMap, mapIndex);
+
+        assetBufferRef.mLRUPrev = INVALID_INDEX;
+        assetBufferRef.mLRUNext = mLRUHead;
+
+        if (mLRUHead != INVALID_INDEX)
+        {
+            r2::sarr::At(*mAssetMap, mLRUHead).mLRUPrev = mapIndex;
+        }
+
+        mLRUHead = mapIndex;
+
+        if (mLRUTail == INVALID_INDEX)
+        {
+            mLRUTail = mapIndex;
+        }
+
+        ++mLRUSize;
+    }
+
+    void AssetCache::UnlinkLRU(s32 mapIndex)
+    {
+        AssetBufferRef& assetBufferRef = r2::sarr::At(*mAssetMap, mapIndex);
+
+        if (assetBufferRef.mLRUPrev != INVALID_INDEX)
+        {
+            r2::sarr::At(*mAssetMap, assetBufferRef.mLRUPrev).mLRUNext = assetBufferRef.mLRUNext;
+        }
+        else
+        {
+            mLRUHead = assetBufferRef.mLRUNext;
+        }
+
+        if (assetBufferRef.mLRUNext != INVALID_INDEX)
+        {
+            r2::sarr::At(*mAssetMap, assetBufferRef.mLRUNext).mLRUPrev = assetBufferRef.mLRUPrev;
+        }
+        else
+        {
+            mLRUTail = assetBufferRef.mLRUPrev;
+        }
+
+        assetBufferRef.mLRUPrev = INVALID_INDEX;
+        assetBufferRef.mLRUNext = INVALID_INDEX;
+
+        --mLRUSize;
     }
     
     void AssetCache::RemoveFromLRU(AssetHandle handle)
     {
-        s64 lruIndex = GetLRUIndex(handle);
+        const s32 mapIndex = GetMapIndex(handle.handle);
         
-        if (lruIndex != -1)
+        if (mapIndex != INVALID_INDEX)
         {
-            r2::squeue::MoveToFront(*mAssetLRU, lruIndex);
-            r2::squeue::PopFront(*mAssetLRU);
+            UnlinkLRU(mapIndex);
         }
     }
     
+    s32 AssetCache::FindAsyncLoadRequest(u64 assetHandle) const
+    {
+        for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+        {
+            const AsyncLoadRequest& request = mAsyncLoadRequests[i];
+
+            if (request.mStage != ASYNC_LOAD_STAGE_FREE && request.mAsset.HashID() == assetHandle)
+            {
+                return static_cast<s32>(i);
+            }
+        }
+
+        return INVALID_INDEX;
+    }
+
+    bool AssetCache::IsFileBusy(const AssetFile* assetFile) const
+    {
+        //@NOTE(Serge): asset files keep their own read position so only one job at a time can read from one
+        for (u32 i = 0; i < MAX_NUM_ASYNC_LOAD_REQUESTS; ++i)
+        {
+            const AsyncLoadRequest& request = mAsyncLoadRequests[i];
+
+            if (request.mAssetFile == assetFile && (request.mStage == ASYNC_LOAD_STAGE_READING || request.mStage == ASYNC_LOAD_STAGE_PROCESSING))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool AssetCache::StartAsyncRead(AsyncLoadRequest& request)
+    {
+        request.mLoader = GetAssetLoader(request.mAsset.GetType());
+
+        if (request.mLoader == nullptr)
+        {
+            request.mLoader = mDefaultLoader;
+        }
+
+        //Opening can touch the file system's shared state so it stays on the main thread, only the read goes to a job
+        if (!request.mAssetFile->IsOpen())
+        {
+            request.mAssetFile->Open();
+        }
+
+        //Nothing to read for mapped files, the pages get faulted in wherever the data is first touched
+        request.mRawBuffer = const_cast<byte*>(request.mAssetFile->MapRawAsset(request.mAsset, request.mRawSize));
+
+        if (request.mRawBuffer != nullptr)
+        {
+            request.mRawIsMapped = true;
+            request.mSucceeded = true;
+            request.mStage = ASYNC_LOAD_STAGE_READING;
+            ++mNumInFlightReads;
+            return true;
+        }
+
+        request.mRawSize = request.mAssetFile->RawAssetSize(request.mAsset);
+
+        if (!MakeRoom(request.mRawSize))
+        {
+            return false;
+        }
+
+        request.mRawBuffer = ALLOC_BYTESN(mAssetCacheArena, request.mRawSize, alignof(size_t));
+
+        if (request.mRawBuffer == nullptr)
+        {
+            return false;
+        }
+
+        mMemoryHighWaterMark = std::max(mMemoryHighWaterMark, mAssetCacheArena.TotalBytesAllocated());
+
+        request.mStage = ASYNC_LOAD_STAGE_READING;
+        ++mNumInFlightReads;
+
+        RunAsyncLoadJob(request, ReadAssetJob);
+
+        return true;
+    }
+
+    bool AssetCache::StartAsyncProcess(AsyncLoadRequest& request)
+    {
+        u32 headerSize = 0;
+        u32 boundsChecking = 0;
+#ifdef R2_ASSET_PIPELINE
+        headerSize = r2::mem::MallocAllocator::HeaderSize();
+#else
+        headerSize = r2::mem::FreeListAllocator::HeaderSize();
+#endif
+#ifdef R2_DEBUG
+        boundsChecking = r2::mem::BasicBoundsChecking::SIZE_FRONT + r2::mem::BasicBoundsChecking::SIZE_BACK;
+#endif
+        const u64 ALIGNMENT = 16;
+
+        const u64 size = request.mLoader->GetLoadedAssetSize(request.mAssetFile->FilePath(), request.mRawBuffer, request.mRawSize, ALIGNMENT, headerSize, boundsChecking);
+
+        if (!MakeRoom(size))
+        {
+            return false;
+        }
+
+        byte* buffer = ALLOC_BYTESN(mAssetCacheArena, size, alignof(size_t));
+
+        if (!buffer)
+        {
+            return false;
+        }
+
+        mMemoryHighWaterMark = std::max(mMemoryHighWaterMark, mAssetCacheArena.TotalBytesAllocated());
+
+        request.mAssetBuffer.Load(buffer, size);
+
+        if (request.mLoader->CanLoadOnWorkerThread())
+        {
+            request.mStage = ASYNC_LOAD_STAGE_PROCESSING;
+            RunAsyncLoadJob(request, ProcessAssetJob);
+        }
+        else
+        {
+            request.mStage = ASYNC_LOAD_STAGE_PROCESSING_ON_MAIN_THREAD;
+            ProcessAssetJob(&request);
+            //the next Update will finish it
+            request.mStage = ASYNC_LOAD_STAGE_PROCESSING;
+        }
+
+        return true;
+    }
+
+    void AssetCache::FinishAsyncLoad(AsyncLoadRequest& request)
+    {
+        if (request.mRawBuffer)
+        {
+            FreeRawBuffer(request.mAssetFile, request.mAsset, request.mRawBuffer, request.mRawIsMapped);
+            request.mRawBuffer = nullptr;
+        }
+
+        while (mLRUSize >= mLRUCapacity && mLRUSize > 0)
+        {
+            FreeOneResource(true);
+        }
+
+        AssetBuffer* assetBuffer = ALLOC(AssetBuffer, *mAssetBufferPoolPtr);
+
+        if (assetBuffer == nullptr)
+        {
+            FailAsyncLoad(request);
+            return;
+        }
+
+        *assetBuffer = request.mAssetBuffer;
+
+        AssetBufferRef bufferRef;
+        bufferRef.mAssetBuffer = assetBuffer;
+        bufferRef.mAsset = request.mAsset;
+        bufferRef.mMappedFile = request.mAssetBufferIsMapped ? request.mAssetFile : nullptr;
+
+        r2::sarr::Push(*mAssetMap, bufferRef);
+
+        const s32 mapIndex = static_cast<s32>(r2::sarr::Size(*mAssetMap)) - 1;
+        r2::shashmap::Set(*mAssetIndexMap, request.mAsset.HashID(), mapIndex);
+
+        LinkLRUFront(mapIndex);
+
+        request.mAssetFile->Close();
+
+        ReleaseAsyncLoadRequest(request);
+    }
+
+    void AssetCache::FailAsyncLoad(AsyncLoadRequest& request)
+    {
+#ifdef R2_ASSET_CACHE_DEBUG
+        printf("Failed AssetCache async load: %s\n", request.mAsset.Name().c_str());
+#endif
+        if (request.mAssetBuffer.MutableData())
+        {
+            FreeRawBuffer(request.mAssetFile, request.mAsset, request.mAssetBuffer.MutableData(), request.mAssetBufferIsMapped);
+        }
+
+        if (request.mRawBuffer)
+        {
+            FreeRawBuffer(request.mAssetFile, request.mAsset, request.mRawBuffer, request.mRawIsMapped);
+        }
+
+        if (request.mAssetFile && request.mAssetFile->IsOpen())
+        {
+            request.mAssetFile->Close();
+        }
+
+        ReleaseAsyncLoadRequest(request);
+    }
+
+    void AssetCache::ReleaseAsyncLoadRequest(AsyncLoadRequest& request)
+    {
+        request.mAsset = Asset();
+        request.mAssetFile = nullptr;
+        request.mLoader = nullptr;
+        request.mRawBuffer = nullptr;
+        request.mRawSize = 0;
+        request.mAssetBuffer = AssetBuffer();
+        request.mSucceeded = false;
+        request.mRawIsMapped = false;
+        request.mAssetBufferIsMapped = false;
+        request.mStage = ASYNC_LOAD_STAGE_FREE;
+    }
+
+    void AssetCache::FreeRawBuffer(AssetFile* assetFile, const Asset& asset, byte* rawBuffer, bool isMapped)
+    {
+        if (isMapped)
+        {
+            assetFile->UnmapRawAsset(asset);
+        }
+        else
+        {
+            FREE(rawBuffer, mAssetCacheArena);
+        }
+    }
+
+    void AssetCache::RunAsyncLoadJob(AsyncLoadRequest& request, r2::jobs::JobFunc func)
+    {
+        if (r2::jobs::IsInitialized())
+        {
+            r2::jobs::Submit(func, &request, request.mCounter);
+        }
+        else
+        {
+            func(&request);
+        }
+    }
+
+    void AssetCache::ReadAssetJob(void* data)
+    {
+        AsyncLoadRequest* request = static_cast<AsyncLoadRequest*>(data);
+        const u64 bytesRead = request->mAssetFile->LoadRawAsset(request->mAsset, request->mRawBuffer, static_cast<u32>(request->mRawSize));
+        request->mSucceeded = bytesRead > 0;
+    }
+
+    void AssetCache::ProcessAssetJob(void* data)
+    {
+        AsyncLoadRequest* request = static_cast<AsyncLoadRequest*>(data);
+        request->mSucceeded = request->mLoader->LoadAsset(request->mAssetFile->FilePath(), request->mRawBuffer, request->mRawSize, request->mAssetBuffer);
+    }
+
     u64 AssetCache::MemoryHighWaterMark()
     {
         return mMemoryHighWaterMark;
@@ -584,13 +1344,13 @@ namespace r2::asset
         u64 poolSizeInBytes = lruCapacity * elementSize;
 
         return 
-            r2::mem::utils::GetMaxMemoryForAllocation(r2::SQueue<AssetHandle>::MemorySize(lruCapacity), alignment, headerSize, boundsChecking)  +
             r2::mem::utils::GetMaxMemoryForAllocation(SArray<AssetBufferRef>::MemorySize(mapCapacity), alignment, headerSize, boundsChecking) +
             r2::mem::utils::GetMaxMemoryForAllocation(sizeof(DefaultAssetLoader), alignment, headerSize, boundsChecking) +
             r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<AssetLoader*>::MemorySize(lruCapacity), alignment, headerSize, boundsChecking) +
-            r2::mem::utils::GetMaxMemoryForAllocation(r2::SHashMap<Asset>::MemorySize(mapCapacity), alignment, headerSize, boundsChecking) +
+            r2::mem::utils::GetMaxMemoryForAllocation(r2::SHashMap<s32>::MemorySize(mapCapacity * r2::SHashMap<s32>::LoadFactorMultiplier()), alignment, headerSize, boundsChecking) +
             r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::mem::PoolArena), alignment, headerSize, boundsChecking) +
             r2::mem::utils::GetMaxMemoryForAllocation(poolSizeInBytes, alignment, headerSize, boundsChecking) +
+            r2::mem::utils::GetMaxMemoryForAllocation(sizeof(AsyncLoadRequest) * (MAX_NUM_ASYNC_LOAD_REQUESTS + 1), alignment, headerSize, boundsChecking) +
             CalculateCacheSizeNeeded(assetCapacity, numAssets, alignment);
     }
 
@@ -617,13 +1377,9 @@ namespace r2::asset
     {
         printf("==========================PrintLRU==========================\n");
         printf("Asset Cache: %llu\n", mSlot);
-        u64 size = r2::squeue::Size(*mAssetLRU);
-        
-        AssetBufferRef defaultRef;
-        
-        for (u64 i = 0; i < size; ++i)
+        for (s32 mapIndex = mLRUHead; mapIndex != INVALID_INDEX; mapIndex = r2::sarr::At(*mAssetMap, mapIndex).mLRUNext)
         {
-            AssetBufferRef bufRef = Find((*mAssetLRU)[i].handle, defaultRef);
+            const AssetBufferRef& bufRef = r2::sarr::At(*mAssetMap, mapIndex);
             
             if (bufRef.mAssetBuffer != nullptr)
             {
@@ -644,13 +1400,11 @@ namespace r2::asset
         printf("==========================PrintAssetMap==========================\n");
         printf("Asset Cache: %llu\n", mSlot);
         
-        u64 size = r2::squeue::Size(*mAssetLRU);
-        
-        AssetBufferRef defaultRef;
+        const u32 size = r2::sarr::Size(*mAssetMap);
         
-        for (u64 i = 0; i < size; ++i)
+        for (u32 i = 0; i < size; ++i)
         {
-            AssetBufferRef bufRef = Find((*mAssetLRU)[i].handle, defaultRef);
+            const AssetBufferRef& bufRef = r2::sarr::At(*mAssetMap, i);
             
             if (bufRef.mAssetBuffer != nullptr)
             {
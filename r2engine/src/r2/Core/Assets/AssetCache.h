@@ -9,11 +9,12 @@
 #define AssetCache_h
 
 #include "r2/Core/Containers/SArray.h"
-#include "r2/Core/Containers/SQueue.h"
 #include "r2/Core/Containers/SHashMap.h"
 #include "r2/Core/Memory/Allocators/PoolAllocator.h"
 #include "r2/Core/Assets/AssetTypes.h"
 #include "r2/Core/Assets/AssetCacheRecord.h"
+#include "r2/Core/Assets/AssetBuffer.h"
+#include "r2/Core/Jobs/JobSystem.h"
 #include "r2/Core/File/FileTypes.h"
 #ifdef R2_ASSET_PIPELINE
 #include "r2/Core/Memory/Allocators/MallocAllocator.h"
@@ -42,6 +43,8 @@ namespace r2::asset
         
         static const u32 LRU_CAPACITY = 1024;
         static const u32 MAP_CAPACITY = 1024;
+        static const u32 MAX_NUM_ASYNC_LOAD_REQUESTS = 128;
+        static const u32 DEFAULT_MAX_NUM_IN_FLIGHT_READS = 4;
 
         explicit AssetCache(u64 slot, const r2::mem::utils::MemBoundary& boundary);
 
@@ -56,6 +59,19 @@ namespace r2::asset
         AssetHandle LoadAsset(const Asset& asset);
         bool IsAssetLoaded(const Asset& asset);
 
+        //Reads and processes the asset on the job threads. Update() has to be called on the main thread to move the loads along.
+        //Asking for an asset that's already loaded or already loading gives back a handle to that load.
+        AsyncAssetLoadHandle LoadAssetAsync(const Asset& asset, AssetLoadPriority priority = ASSET_LOAD_PRIORITY_CRITICAL);
+        //Once a load is done its request is recycled so this will report LOADED only while the asset is still in the cache
+        AssetLoadStatus GetAsyncLoadStatus(const AsyncAssetLoadHandle& loadHandle) const;
+        //Pumps the async loads and runs other jobs until this load is done
+        AssetLoadStatus WaitForAsyncLoad(const AsyncAssetLoadHandle& loadHandle);
+        void SetMaxNumInFlightReads(u32 maxNumInFlightReads);
+        u32 NumPendingAsyncLoads() const;
+
+        //Starts queued reads and finishes loads whose jobs are done. Main thread only.
+        void Update();
+
         AssetHandle ReloadAsset(const Asset& asset);
         void FreeAsset(const AssetHandle& handle);
 
@@ -65,6 +81,12 @@ namespace r2::asset
         bool ReturnAssetBuffer(const AssetCacheRecord& buffer);
         
         void FlushAll();
+
+        //Moves the buffers of unreferenced, unprocessed assets down into earlier holes in the cache so the free space coalesces.
+        //MakeRoom will do this on its own before evicting anything if compaction is enabled.
+        void CompactUnreferencedBuffers();
+        void SetCompactionEnabled(bool enabled) {mCompactionEnabled = enabled;}
+        bool IsCompactionEnabled() const {return mCompactionEnabled;}
         
         int Preload(const char* pattern, AssetLoadProgressCallback callback);
 
@@ -89,15 +111,51 @@ namespace r2::asset
         
         friend struct AssetCacheRecord;
 
+        static const s32 INVALID_INDEX = -1;
+        //How many of the least recently used assets we look at when deciding which one to evict
+        static const u32 MAX_EVICTION_CANDIDATES = 8;
+
+        //The LRU is an intrusive doubly linked list through the asset map. mLRUPrev/mLRUNext are indices into mAssetMap.
         struct AssetBufferRef
         {
             Asset mAsset;
             AssetBuffer* mAssetBuffer = nullptr;
             s32 mRefCount = 0;
+            s32 mLRUPrev = INVALID_INDEX;
+            s32 mLRUNext = INVALID_INDEX;
+            AssetFile* mMappedFile = nullptr; //the buffer is a view into this file's mapping rather than cache memory
         };
         
-        using AssetList = r2::SQueue<AssetHandle>*;
+        enum AsyncLoadStage : u32
+        {
+            ASYNC_LOAD_STAGE_FREE = 0,
+            ASYNC_LOAD_STAGE_QUEUED,
+            ASYNC_LOAD_STAGE_READING,
+            ASYNC_LOAD_STAGE_PROCESSING,
+            ASYNC_LOAD_STAGE_PROCESSING_ON_MAIN_THREAD //the loader can call back into the cache while in here so Update has to leave it alone
+        };
+
+        //Everything in here is only touched by the main thread except for the stage's job which owns the buffers until mCounter hits 0
+        struct AsyncLoadRequest
+        {
+            Asset mAsset;
+            AssetFile* mAssetFile = nullptr;
+            AssetLoader* mLoader = nullptr;
+            byte* mRawBuffer = nullptr;
+            u64 mRawSize = 0;
+            AssetBuffer mAssetBuffer;
+            r2::jobs::JobCounter mCounter;
+            u64 mSequence = 0;
+            u32 mGeneration = 0;
+            AsyncLoadStage mStage = ASYNC_LOAD_STAGE_FREE;
+            AssetLoadPriority mPriority = ASSET_LOAD_PRIORITY_CRITICAL;
+            bool mSucceeded = false;
+            bool mRawIsMapped = false;
+            bool mAssetBufferIsMapped = false;
+        };
+
         using AssetMap = r2::SArray<AssetBufferRef>*;
+        using AssetIndexMap = r2::SHashMap<s32>*;
         using AssetLoaderList = r2::SArray<AssetLoader*>*;
         using AssetFreedCallbackList = r2::SArray<AssetFreedCallback>*;
 
@@ -110,20 +168,42 @@ namespace r2::asset
         void UpdateLRU(AssetHandle handle);
 
         AssetBufferRef& Find(u64 handle, AssetBufferRef& theDefault);
+        s32 GetMapIndex(u64 handle) const;
         void RemoveAssetBuffer(u64 handle);
 
         void Free(AssetHandle handle, bool forceFree);
         bool MakeRoom(u64 amount);
         void FreeOneResource(bool forceFree);
-        s64 GetLRUIndex(AssetHandle handle);
+        s32 GetEvictionCandidate(u64 requiredBlockSize);
+        u64 GetRequiredBlockSize(u64 amount) const;
+        void LinkLRUFront(s32 mapIndex);
+        void UnlinkLRU(s32 mapIndex);
         void RemoveFromLRU(AssetHandle handle);
 
         u64 MemoryHighWaterMark();
 
-        AssetList mAssetLRU;
+        s32 FindAsyncLoadRequest(u64 assetHandle) const;
+        bool IsFileBusy(const AssetFile* assetFile) const;
+        bool StartAsyncRead(AsyncLoadRequest& request);
+        bool StartAsyncProcess(AsyncLoadRequest& request);
+        void FinishAsyncLoad(AsyncLoadRequest& request);
+        void FailAsyncLoad(AsyncLoadRequest& request);
+        void ReleaseAsyncLoadRequest(AsyncLoadRequest& request);
+        void FreeRawBuffer(AssetFile* assetFile, const Asset& asset, byte* rawBuffer, bool isMapped);
+        void RunAsyncLoadJob(AsyncLoadRequest& request, r2::jobs::JobFunc func);
+        static void ReadAssetJob(void* data);
+        static void ProcessAssetJob(void* data);
+
         AssetMap mAssetMap;
+        AssetIndexMap mAssetIndexMap;
         AssetLoaderList mAssetLoaders;
 
+        s32 mLRUHead;
+        s32 mLRUTail;
+        u32 mLRUSize;
+        u32 mLRUCapacity;
+        bool mCompactionEnabled;
+
         DefaultAssetLoader* mDefaultLoader;
         s64 mSlot;
         u64 mMemoryHighWaterMark;
@@ -131,6 +211,11 @@ namespace r2::asset
 
         r2::mem::PoolArena* mAssetBufferPoolPtr;
 
+        AsyncLoadRequest* mAsyncLoadRequests;
+        u64 mNextAsyncLoadSequence;
+        u32 mNumInFlightReads;
+        u32 mMaxNumInFlightReads;
+
 #ifdef R2_ASSET_PIPELINE
         //This is for debug only
         r2::mem::MallocArena mAssetCacheArena;
@@ -23,6 +23,10 @@ namespace r2::asset
         virtual u64 RawAssetSize(const Asset& asset) = 0;
         virtual u64 LoadRawAsset(const Asset& asset, byte* data, u32 dataBufSize) = 0;
         virtual u64 WriteRawAsset(const Asset& asset, const byte* data, u32 dataBufferSize, u32 offset) = 0;
+        //Zero copy access to the asset for files that can be read in place (memory mapped and uncompressed). Returns nullptr
+        //if the asset has to be read with LoadRawAsset. The view stays valid until UnmapRawAsset even if the file gets closed.
+        virtual const byte* MapRawAsset(const Asset& asset, u64& size) { return nullptr; }
+        virtual void UnmapRawAsset(const Asset& asset) {}
         virtual u64 NumAssets() = 0;
         virtual void GetAssetName(u64 index, char* name, u32 nameBuferSize) = 0;
         virtual u64 GetAssetHandle(u64 index) = 0;
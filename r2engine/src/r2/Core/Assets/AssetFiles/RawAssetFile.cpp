@@ -12,7 +12,7 @@
 
 namespace r2::asset
 {
-    RawAssetFile::RawAssetFile(): mFile(nullptr), mNumDirectoriesToIncludeInAssetHandle(0)
+    RawAssetFile::RawAssetFile(): mFile(nullptr), mMappedViewFile(nullptr), mNumMappedViews(0), mNumDirectoriesToIncludeInAssetHandle(0)
     {
         r2::util::PathCpy(mPath, "");
     }
@@ -23,6 +23,12 @@ namespace r2::asset
         {
             Close();
         }
+
+        R2_CHECK(mMappedViewFile == nullptr, "We still have %u views into %s", mNumMappedViews, mPath);
+        if (mMappedViewFile)
+        {
+            r2::fs::FileSystem::Close(mMappedViewFile);
+        }
     }
     
     bool RawAssetFile::Init(const char* path, u32 numDirectoriesToIncludeInAssetHandle)
@@ -64,6 +70,27 @@ namespace r2::asset
 
     bool RawAssetFile::Open(r2::fs::FileMode mode)
     {
+        const bool readOnly = !mode.IsSet(r2::fs::Mode::Write) && !mode.IsSet(r2::fs::Mode::Append) && !mode.IsSet(r2::fs::Mode::Recreate);
+
+        if (readOnly && mMappedViewFile)
+        {
+            mFile = mMappedViewFile;
+            return true;
+        }
+
+        //@NOTE(Serge): the asset pipeline rewrites the bin files while we're running so only map them when that can't happen
+#ifndef R2_ASSET_PIPELINE
+        if (readOnly)
+        {
+            r2::fs::DeviceConfig mappedConfig(r2::fs::DeviceStorage::MemoryMapped);
+            mFile = r2::fs::FileSystem::Open(mappedConfig, mPath, mode);
+            if (mFile)
+            {
+                return true;
+            }
+        }
+#endif
+
         r2::fs::DeviceConfig config;
 		mFile = r2::fs::FileSystem::Open(config, mPath, mode);
 		return mFile != nullptr;
@@ -71,6 +98,13 @@ namespace r2::asset
     
     bool RawAssetFile::Close()
     {
+        if (mFile != nullptr && mFile == mMappedViewFile)
+        {
+            //UnmapRawAsset closes it once all of the views are gone
+            mFile = nullptr;
+            return true;
+        }
+
         r2::fs::FileSystem::Close(mFile);
         mFile = nullptr;
         return true;
@@ -97,6 +131,44 @@ namespace r2::asset
         return mFile->Write(data, dataBufferSize);
     }
     
+    const byte* RawAssetFile::MapRawAsset(const Asset& asset, u64& size)
+    {
+        size = 0;
+
+        if (!mFile || !mFile->MappedData())
+        {
+            return nullptr;
+        }
+
+        if (mMappedViewFile != nullptr && mMappedViewFile != mFile)
+        {
+            return nullptr;
+        }
+
+        mMappedViewFile = mFile;
+        ++mNumMappedViews;
+
+        size = mFile->Size();
+        return mFile->MappedData();
+    }
+
+    void RawAssetFile::UnmapRawAsset(const Asset& asset)
+    {
+        R2_CHECK(mNumMappedViews > 0, "We don't have any views into %s", mPath);
+
+        if (mNumMappedViews == 0 || --mNumMappedViews > 0)
+        {
+            return;
+        }
+
+        if (mFile != mMappedViewFile)
+        {
+            r2::fs::FileSystem::Close(mMappedViewFile);
+        }
+
+        mMappedViewFile = nullptr;
+    }
+    
     u64 RawAssetFile::NumAssets()
     {
         return 1;
@@ -25,6 +25,8 @@ namespace r2::asset
         virtual u64 RawAssetSize(const r2::asset::Asset& asset) override;
         virtual u64 LoadRawAsset(const r2::asset::Asset& asset, byte* data, u32 dataBufSize) override;
         virtual u64 WriteRawAsset(const Asset& asset, const byte* data, u32 dataBufferSize, u32 offset) override;
+        virtual const byte* MapRawAsset(const Asset& asset, u64& size) override;
+        virtual void UnmapRawAsset(const Asset& asset) override;
         virtual u64 NumAssets() override;
         virtual void GetAssetName(u64 index, char* name, u32 nameBuferSize) override;
         virtual u64 GetAssetHandle(u64 index) override;
@@ -32,6 +34,8 @@ namespace r2::asset
     private:
         char mPath[r2::fs::FILE_PATH_LENGTH];
         r2::fs::File* mFile;
+        r2::fs::File* mMappedViewFile; //kept open past Close() while there are views into it
+        u32 mNumMappedViews;
         u32 mNumDirectoriesToIncludeInAssetHandle;
         u64 mAssetHandle;
     };
@@ -14,7 +14,7 @@
 
 namespace r2::asset
 {
-    ZipAssetFile::ZipAssetFile():mZipFile(nullptr)
+    ZipAssetFile::ZipAssetFile():mZipFile(nullptr), mMappedViewZipFile(nullptr), mNumMappedViews(0)
     {
         r2::util::PathCpy(mPath, "");
     }
@@ -25,6 +25,12 @@ namespace r2::asset
         {
             Close();
         }
+
+        R2_CHECK(mMappedViewZipFile == nullptr, "We still have %u views into %s", mNumMappedViews, mPath);
+        if (mMappedViewZipFile)
+        {
+            r2::fs::FileSystem::Close(mMappedViewZipFile);
+        }
     }
     
     bool ZipAssetFile::Init(const char* assetPath, r2::mem::AllocateFunc alloc, r2::mem::FreeFunc free)
@@ -57,9 +63,25 @@ namespace r2::asset
 
     bool ZipAssetFile::Open(r2::fs::FileMode mode)
     {
+        const bool readOnly = !mode.IsSet(r2::fs::Mode::Write) && !mode.IsSet(r2::fs::Mode::Append) && !mode.IsSet(r2::fs::Mode::Recreate);
+
+        if (readOnly && mMappedViewZipFile)
+        {
+            mZipFile = mMappedViewZipFile;
+            return true;
+        }
+
 		r2::fs::DeviceConfig zipConfig;
 		zipConfig.AddModifier(r2::fs::DeviceModifier::Zip);
 
+        //@NOTE(Serge): the asset pipeline rewrites the bin files while we're running so only map them when that can't happen
+#ifndef R2_ASSET_PIPELINE
+        if (readOnly)
+        {
+            zipConfig.SetDeviceStorage(r2::fs::DeviceStorage::MemoryMapped);
+        }
+#endif
+
 		mZipFile = (r2::fs::ZipFile*)r2::fs::FileSystem::Open(zipConfig, mPath, mode);
 
 		R2_CHECK(mZipFile != nullptr, "We should have a zip file!");
@@ -77,6 +99,14 @@ namespace r2::asset
         {
             return true;
         }
+
+        if (mZipFile == mMappedViewZipFile)
+        {
+            //UnmapRawAsset closes it once all of the views are gone
+            mZipFile = nullptr;
+            return true;
+        }
+
         r2::fs::FileSystem::Close(mZipFile);
         mZipFile = nullptr;
         return true;
@@ -123,6 +153,50 @@ namespace r2::asset
         return 0;
     }
 
+    const byte* ZipAssetFile::MapRawAsset(const Asset& asset, u64& size)
+    {
+        size = 0;
+
+        if (!(mZipFile && mZipFile->IsOpen()))
+        {
+            return nullptr;
+        }
+
+        if (mMappedViewZipFile != nullptr && mMappedViewZipFile != mZipFile)
+        {
+            return nullptr;
+        }
+
+        const byte* data = mZipFile->GetStoredFileDataByHash(asset.HashID(), size);
+
+        if (!data)
+        {
+            return nullptr;
+        }
+
+        mMappedViewZipFile = mZipFile;
+        ++mNumMappedViews;
+
+        return data;
+    }
+
+    void ZipAssetFile::UnmapRawAsset(const Asset& asset)
+    {
+        R2_CHECK(mNumMappedViews > 0, "We don't have any views into %s", mPath);
+
+        if (mNumMappedViews == 0 || --mNumMappedViews > 0)
+        {
+            return;
+        }
+
+        if (mZipFile != mMappedViewZipFile)
+        {
+            r2::fs::FileSystem::Close(mMappedViewZipFile);
+        }
+
+        mMappedViewZipFile = nullptr;
+    }
+
     u64 ZipAssetFile::NumAssets() 
     {
         bool opened = false;
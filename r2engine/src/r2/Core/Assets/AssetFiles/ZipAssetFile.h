@@ -36,6 +36,8 @@ namespace r2::asset
         virtual u64 RawAssetSize(const Asset& asset) override;
         virtual u64 LoadRawAsset(const Asset& asset, byte* data, u32 dataBufSize) override;
         virtual u64 WriteRawAsset(const Asset& asset, const  byte* data, u32 dataBufferSize, u32 offset) override;
+        virtual const byte* MapRawAsset(const Asset& asset, u64& size) override;
+        virtual void UnmapRawAsset(const Asset& asset) override;
         virtual u64 NumAssets() override;
         virtual void GetAssetName(u64 index, char* name, u32 nameBuferSize) override;
         virtual u64 GetAssetHandle(u64 index) override;
@@ -44,6 +46,8 @@ namespace r2::asset
     private:
         char mPath[r2::fs::FILE_PATH_LENGTH];
         r2::fs::ZipFile* mZipFile;
+        r2::fs::ZipFile* mMappedViewZipFile; //kept open past Close() while there are views into it
+        u32 mNumMappedViews;
         r2::mem::AllocateFunc mAlloc;
         r2::mem::FreeFunc mFree;
     };
@@ -25,6 +25,9 @@ namespace r2::asset
         virtual u64 GetLoadedAssetSize(const char* filePath, byte* rawBuffer, u64 size, u64 alignment, u32 header, u32 boundsChecking) = 0;
         virtual bool LoadAsset(const char* filePath, byte* rawBuffer, u64 rawSize, AssetBuffer& assetBuffer) = 0;
         virtual bool FreeAsset(const AssetBuffer& assetBuffer) = 0;
+        //Async loads only call LoadAsset from a job thread if this returns true - only opt in if LoadAsset doesn't touch shared state
+        //(ie. the model loader calls back into the AssetCache and the sound loader registers banks with the AudioEngine)
+        virtual bool CanLoadOnWorkerThread() const { return false; }
 
         //virtual bool 
         virtual ~AssetLoader(){}
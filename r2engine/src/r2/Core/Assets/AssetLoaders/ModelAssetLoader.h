@@ -23,6 +23,8 @@ namespace r2::asset
 		virtual u64 GetLoadedAssetSize(const char* filePath, byte* rawBuffer, u64 size, u64 alignment, u32 header, u32 boundsChecking) override;
 		virtual bool LoadAsset(const char* filePath, byte* rawBuffer, u64 rawSize, AssetBuffer& assetBuffer) override;
 		virtual bool FreeAsset(const AssetBuffer& assetBuffer) override;
+		//Loads the meshes through the AssetCache so it has to stay on the main thread
+		virtual bool CanLoadOnWorkerThread() const override { return false; }
 
 	private:
 		AssetCache* mnoptrAssetCache = nullptr;
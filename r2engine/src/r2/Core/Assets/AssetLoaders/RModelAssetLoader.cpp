@@ -13,13 +13,12 @@
 #include "r2/Render/Model/Materials/MaterialHelpers.h"
 #include "r2/Core/Math/MathUtils.h"
 #include "r2/Render/Animation/TransformTrack.h"
+#include "r2/Render/Animation/AnimationBatch.h"
 #ifdef R2_EDITOR
 #include "r2/Core/File/PathUtils.h"
 #endif
 
-#ifdef R2_DEBUG
-#include "R2/Utils/Timer.h"
-#endif
+#include "r2/Core/Profiler/Profiler.h"
 
 namespace r2::asset
 {
@@ -52,6 +51,20 @@ namespace r2::asset
 		return { v->v()->Get(0), v->v()->Get(1), v->v()->Get(2), v->v()->Get(3) };
 	}
 
+	u32 GetVertexSize(flat::VertexFormat vertexFormat)
+	{
+		switch (vertexFormat)
+		{
+		case flat::VertexFormat_P32N32UV32T32:
+			return sizeof(r2::draw::Vertex);
+		case flat::VertexFormat_P16N16UV16T16:
+			return sizeof(r2::draw::QuantizedVertex);
+		default:
+			R2_CHECK(false, "Unsupported vertex format: %s", flat::EnumNameVertexFormat(vertexFormat));
+			return 0;
+		}
+	}
+
 	RModelAssetLoader::RModelAssetLoader()
 	{
 
@@ -91,12 +104,19 @@ namespace r2::asset
 
 		for (flatbuffers::uoffset_t i = 0; i < metaData->meshInfos()->size(); ++i)
 		{
-			R2_CHECK(metaData->meshInfos()->Get(i)->vertexFormat() == flat::VertexFormat_P32N32UV32T32, "This is the only vertex format we accept right now");
+			const flat::VertexFormat vertexFormat = metaData->meshInfos()->Get(i)->vertexFormat();
 
-			u32 numVertices = metaData->meshInfos()->Get(i)->vertexBufferSize() / sizeof(r2::draw::Vertex);
+			u32 numVertices = metaData->meshInfos()->Get(i)->vertexBufferSize() / GetVertexSize(vertexFormat);
 			u32 numIndices = metaData->meshInfos()->Get(i)->indexBufferSize() / metaData->meshInfos()->Get(i)->sizeOfAnIndex();
 
-			meshDataSize += r2::draw::Mesh::MemorySize(numVertices, numIndices, alignment, header, boundsChecking);
+			if (vertexFormat == flat::VertexFormat_P16N16UV16T16)
+			{
+				meshDataSize += r2::draw::Mesh::QuantizedMemorySize(numVertices, numIndices, alignment, header, boundsChecking);
+			}
+			else
+			{
+				meshDataSize += r2::draw::Mesh::MemorySize(numVertices, numIndices, alignment, header, boundsChecking);
+			}
 
 			totalVertices += numVertices;
 		}
@@ -141,10 +161,42 @@ namespace r2::asset
 
 				bytes += r2::anim::AnimationClip::MemorySize(numChannels, memProperties);
 
+				u32 totalPositionKeys = 0;
+				u32 totalRotationKeys = 0;
+				u32 totalScaleKeys = 0;
+				u32 totalSampledPositions = 0;
+				u32 totalSampledRotations = 0;
+				u32 totalSampledScales = 0;
+				bool isCompressed = false;
+
 				for (u32 j = 0; j < numChannels; ++j)
 				{
 					const auto channelMetaData = channelsMetaData->Get(j);
 
+					totalPositionKeys += channelMetaData->numPositionKeys();
+					totalRotationKeys += channelMetaData->numRotationKeys();
+					totalScaleKeys += channelMetaData->numScaleKeys();
+					totalSampledPositions += channelMetaData->numberOfSampledPositionFrames();
+					totalSampledRotations += channelMetaData->numberOfSampledRotationFrames();
+					totalSampledScales += channelMetaData->numberOfSampledScaleFrames();
+
+					if (channelMetaData->isCompressed())
+					{
+						isCompressed = true;
+
+						bytes += anim::TransformTrack::CompressedMemorySize(
+							channelMetaData->numPositionKeys(),
+							channelMetaData->numScaleKeys(),
+							channelMetaData->numRotationKeys(),
+							channelMetaData->numberOfSampledPositionFrames(),
+							channelMetaData->numberOfSampledScaleFrames(),
+							channelMetaData->numberOfSampledRotationFrames(),
+							memProperties
+						);
+
+						continue;
+					}
+
 					bytes += anim::TransformTrack::MemorySize(
 						channelMetaData->numPositionKeys(),
 						channelMetaData->numScaleKeys(),
@@ -156,6 +208,16 @@ namespace r2::asset
 					);
 				}
 
+				//The packed copy of the keys that the batched animation evaluation samples from - compressed clips don't get one
+				if (!isCompressed)
+				{
+					bytes += anim::SoAAnimationClip::MemorySize(
+						numChannels,
+						totalPositionKeys, totalRotationKeys, totalScaleKeys,
+						totalSampledPositions, totalSampledRotations, totalSampledScales,
+						memProperties);
+				}
+
 				/*u64 bytes = r2::draw::Animation::MemorySize(numChannels, alignment, header, boundsChecking);
 
 				for (u32 j = 0; j < numChannels; ++j)
@@ -181,7 +243,7 @@ namespace r2::asset
 	bool RModelAssetLoader::LoadAsset(const char* filePath, byte* rawBuffer, u64 rawSize, AssetBuffer& assetBuffer)
 	{
 
-	//	PROFILE_SCOPE("RModelAssetLoader::LoadAsset");
+		R2_PROFILE_ZONE("RModelAssetLoader::LoadAsset");
 
 		void* dataPtr = assetBuffer.MutableData();
 
@@ -254,13 +316,31 @@ namespace r2::asset
 			r2::draw::Mesh* nextMeshPtr = new (startOfArrayPtr) r2::draw::Mesh();
 			startOfArrayPtr = r2::mem::utils::PointerAdd(startOfArrayPtr, sizeof(r2::draw::Mesh));
 
-			const auto numVertices = metaData->meshInfos()->Get(i)->vertexBufferSize() / sizeof(r2::draw::Vertex);
+			const flat::VertexFormat vertexFormat = metaData->meshInfos()->Get(i)->vertexFormat();
+			const bool isQuantized = vertexFormat == flat::VertexFormat_P16N16UV16T16;
+
+			R2_CHECK(i == 0 || isQuantized == model->hasQuantizedVertices, "All of the meshes of a model should have the same vertex format");
+			model->hasQuantizedVertices = isQuantized;
+
+			const auto numVertices = metaData->meshInfos()->Get(i)->vertexBufferSize() / GetVertexSize(vertexFormat);
 			const auto numIndices = metaData->meshInfos()->Get(i)->indexBufferSize() / metaData->meshInfos()->Get(i)->sizeOfAnIndex();
 
 			R2_CHECK(numIndices > 0, "We should have indices for this format");
 
-			nextMeshPtr->optrVertices = EMPLACE_SARRAY(startOfArrayPtr, r2::draw::Vertex, numVertices);
-			startOfArrayPtr = r2::mem::utils::PointerAdd(startOfArrayPtr, r2::SArray<r2::draw::Vertex>::MemorySize(numVertices));
+			char* vertexData = nullptr;
+
+			if (isQuantized)
+			{
+				nextMeshPtr->optrQuantizedVertices = EMPLACE_SARRAY(startOfArrayPtr, r2::draw::QuantizedVertex, numVertices);
+				startOfArrayPtr = r2::mem::utils::PointerAdd(startOfArrayPtr, r2::SArray<r2::draw::QuantizedVertex>::MemorySize(numVertices));
+				vertexData = reinterpret_cast<char*>(nextMeshPtr->optrQuantizedVertices->mData);
+			}
+			else
+			{
+				nextMeshPtr->optrVertices = EMPLACE_SARRAY(startOfArrayPtr, r2::draw::Vertex, numVertices);
+				startOfArrayPtr = r2::mem::utils::PointerAdd(startOfArrayPtr, r2::SArray<r2::draw::Vertex>::MemorySize(numVertices));
+				vertexData = reinterpret_cast<char*>(nextMeshPtr->optrVertices->mData);
+			}
 
 			nextMeshPtr->optrIndices = EMPLACE_SARRAY(startOfArrayPtr, u32, numIndices);
 			startOfArrayPtr = r2::mem::utils::PointerAdd(startOfArrayPtr, r2::SArray<u32>::MemorySize(numIndices));
@@ -270,11 +350,19 @@ namespace r2::asset
 				i,
 				reinterpret_cast<const char*>(modelData->meshes()->Get(i)->data()->Data()),
 				metaData->meshInfos()->Get(i)->compressedSize(),
-				reinterpret_cast<char*>(nextMeshPtr->optrVertices->mData),
+				vertexData,
 				reinterpret_cast<char*>(nextMeshPtr->optrIndices->mData));
 
 			nextMeshPtr->optrIndices->mSize = numIndices;
-			nextMeshPtr->optrVertices->mSize = numVertices;
+
+			if (isQuantized)
+			{
+				nextMeshPtr->optrQuantizedVertices->mSize = numVertices;
+			}
+			else
+			{
+				nextMeshPtr->optrVertices->mSize = numVertices;
+			}
 
 			nextMeshPtr->assetName = metaData->meshInfos()->Get(i)->meshName();
 			nextMeshPtr->materialIndex = modelData->meshes()->Get(i)->materialIndex();
@@ -284,9 +372,47 @@ namespace r2::asset
 			nextMeshPtr->objectBounds.origin = GetVec3FromFlatVec3(bounds->origin());
 			nextMeshPtr->objectBounds.extents = GetVec3FromFlatVec3(bounds->extents());
 
+			//older models don't have LODs so the whole index buffer is LOD 0
+			const auto* flatLODs = modelData->meshes()->Get(i)->lods();
+
+			if (flatLODs && flatLODs->size() > 0)
+			{
+				R2_CHECK(flatLODs->size() <= r2::draw::Mesh::MAX_NUM_LODS, "We have more LODs than we support - the rest will be ignored");
+
+				nextMeshPtr->numLODs = std::min(flatLODs->size(), r2::draw::Mesh::MAX_NUM_LODS);
+
+				for (u32 lodIndex = 0; lodIndex < nextMeshPtr->numLODs; ++lodIndex)
+				{
+					const flat::MeshLOD* flatLOD = flatLODs->Get(lodIndex);
+
+					R2_CHECK(flatLOD->firstIndex() + flatLOD->numIndices() <= numIndices, "The LOD is out of range of the mesh's indices");
+
+					nextMeshPtr->lods[lodIndex].firstIndex = flatLOD->firstIndex();
+					nextMeshPtr->lods[lodIndex].numIndices = flatLOD->numIndices();
+					nextMeshPtr->lods[lodIndex].error = flatLOD->error();
+				}
+			}
+			else
+			{
+				nextMeshPtr->numLODs = 1;
+				nextMeshPtr->lods[0].firstIndex = 0;
+				nextMeshPtr->lods[0].numIndices = numIndices;
+				nextMeshPtr->lods[0].error = 0.0f;
+			}
+
 			r2::sarr::Push(*model->optrMeshes, const_cast<const r2::draw::Mesh*>(nextMeshPtr));
 		}
 
+		if (model->hasQuantizedVertices)
+		{
+			//the converter quantizes the positions to the model bounds
+			const auto modelBounds = metaData->modelBounds();
+			const glm::vec3 extents = GetVec3FromFlatVec3(modelBounds->extents());
+
+			model->quantizedPositionScale = 2.0f * extents;
+			model->quantizedPositionBias = GetVec3FromFlatVec3(modelBounds->origin()) - extents;
+		}
+
 		if (metaData->isAnimatedModel())
 		{
 			model->optrBoneData = EMPLACE_SARRAY(startOfArrayPtr, r2::draw::BoneData, numVertices);
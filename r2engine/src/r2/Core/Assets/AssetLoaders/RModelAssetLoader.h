@@ -16,6 +16,7 @@ namespace r2::asset
 		virtual u64 GetLoadedAssetSize(const char* filePath, byte* rawBuffer, u64 size, u64 alignment, u32 header, u32 boundsChecking) override;
 		virtual bool LoadAsset(const char* filePath, byte* rawBuffer, u64 rawSize, AssetBuffer& assetBuffer) override;	
 		virtual bool FreeAsset(const AssetBuffer& assetBuffer) override;
+		virtual bool CanLoadOnWorkerThread() const override { return true; }
 	};
 }
 
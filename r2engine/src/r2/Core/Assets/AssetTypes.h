@@ -36,6 +36,29 @@ namespace r2::asset
 		bool operator==(const AssetHandle& assetHandle) const;
 	};
 
+	enum AssetLoadPriority : u32
+	{
+		ASSET_LOAD_PRIORITY_CRITICAL = 0, //needed for the level that's loading right now
+		ASSET_LOAD_PRIORITY_PREFETCH, //nice to have before it's needed, never allowed to take up all of the in flight reads
+		NUM_ASSET_LOAD_PRIORITIES
+	};
+
+	enum AssetLoadStatus : u32
+	{
+		ASSET_LOAD_STATUS_INVALID = 0,
+		ASSET_LOAD_STATUS_QUEUED,
+		ASSET_LOAD_STATUS_LOADING,
+		ASSET_LOAD_STATUS_LOADED,
+		ASSET_LOAD_STATUS_FAILED
+	};
+
+	struct AsyncAssetLoadHandle
+	{
+		AssetHandle assetHandle;
+		u32 requestIndex = 0;
+		u32 generation = 0; //0 is invalid
+	};
+
 	using AssetLoadProgressCallback = std::function<void(int, bool&)>;
 	using AssetFreedCallback = std::function<void(const r2::asset::AssetHandle& handle)>;
 	using AssetReloadedFunc = std::function<void(AssetHandle asset)>;
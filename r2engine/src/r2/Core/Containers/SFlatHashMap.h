@@ -0,0 +1,484 @@
+//
+//  SFlatHashMap.h
+//  r2engine
+//
+
+#ifndef SFlatHashMap_h
+#define SFlatHashMap_h
+
+#include "r2/Core/Memory/Memory.h"
+#include "r2/Core/Containers/SArray.h"
+#include "r2/Utils/Utils.h"
+#include <limits>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define R2_SFLATHASHMAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define MAKE_SFLATHASHMAP(arena, T, capacity) r2::sflathashmap::CreateSFlatHashMap<T>(arena, capacity, __FILE__, __LINE__, "")
+#define MAKE_SFLATHASHMAP_VERBOSE(arena, T, capacity, file, line, desc) r2::sflathashmap::CreateSFlatHashMap<T>(arena, capacity, file, line, desc)
+#define MAKE_SFLATHASHMAP_IN_PLACE(T, placement, capacity) r2::sflathashmap::CreateSFlatHashMapInPlace<T>(placement, capacity)
+
+namespace r2
+{
+    //Open addressing (Swiss table style) version of SHashMap.
+    //
+    //Entries are kept densely packed in mData (so Begin/End iterate the same way as SHashMap) and the table itself is
+    //an array of control bytes plus an array of indices into mData. Each control byte is either EMPTY or the low 7 bits
+    //of the key's hash, so a lookup compares 16 control bytes at a time and only touches mData for likely matches.
+    //
+    //Keys are run through a 64-bit mixer first, so keys that are already hashes (asset names etc.) don't cluster like they do with key % size.
+    //Collisions are resolved with linear probing and removal shifts the following entries back, so there are never any tombstones.
+    //
+    //Unlike SHashMap, capacity is the max number of entries the map can hold - the number of slots is sized from that.
+    //There is no smultihash equivalent - every key is unique.
+    template<typename T>
+    struct SFlatHashMap
+    {
+        struct HashMapEntry
+        {
+            u64 key;
+            T value;
+        };
+
+        static constexpr u64 GROUP_WIDTH = 16;
+
+        SFlatHashMap(): mCapacity(0), mNumSlots(0), mCtrl(nullptr), mSlots(nullptr), mData(nullptr){}
+        ~SFlatHashMap();
+        void Create(SArray<HashMapEntry>* dataArrayStart, HashMapEntry* dataStart, u32* slotsStart, u8* ctrlStart, u64 capacity);
+
+        SFlatHashMap(const SFlatHashMap& other) = delete;
+        SFlatHashMap& operator=(const SFlatHashMap& other) = delete;
+
+        SFlatHashMap(SFlatHashMap&& other) = delete;
+        SFlatHashMap& operator=(SFlatHashMap&& other) = delete;
+
+        static u64 MemorySize(u64 capacity);
+        static u64 NumSlots(u64 capacity);
+
+        u64 mCapacity;
+        u64 mNumSlots;
+        u8* mCtrl;
+        u32* mSlots;
+        SArray<HashMapEntry>* mData;
+    };
+
+    namespace sflathashmap
+    {
+        template<typename T> bool Has(const SFlatHashMap<T>& h, u64 key);
+
+        template<typename T> T& Get(SFlatHashMap<T>& h, u64 key, T& theDefault);
+
+        template<typename T> T& Get(SFlatHashMap<T>& h, u64 key, T& theDefault, bool& success); //success == true if it's not default
+
+        template<typename T> const T& Get(const SFlatHashMap<T>& h, u64 key, const T& theDefault);
+
+        template<typename T> void Set(SFlatHashMap<T>& h, u64 key, const T& value);
+
+        template<typename T> void Remove(SFlatHashMap<T>& h, u64 key);
+
+        template<typename T> void Clear(SFlatHashMap<T>& h);
+
+        template<typename T> u64 Size(const SFlatHashMap<T>& h);
+
+        template<typename T> const typename SFlatHashMap<T>::HashMapEntry* Begin(const SFlatHashMap<T>& h);
+
+        template<typename T> const typename SFlatHashMap<T>::HashMapEntry* End(const SFlatHashMap<T>& h);
+
+        template<typename T> typename SFlatHashMap<T>::HashMapEntry* Begin(SFlatHashMap<T>& h);
+
+        template<typename T> typename SFlatHashMap<T>::HashMapEntry* End(SFlatHashMap<T>& h);
+
+        template<typename T, class ARENA> SFlatHashMap<T>* CreateSFlatHashMap(ARENA& a, u64 capacity, const char* file, s32 line, const char* description);
+
+        template<typename T> SFlatHashMap<T>* CreateSFlatHashMapInPlace(void* hashMapPlacement, u64 capacity);
+
+        template<typename T> bool IsFull(const SFlatHashMap<T>& h);
+    }
+
+    namespace flathashmap_internal
+    {
+        const u64 END_OF_LIST = std::numeric_limits<u64>::max();
+        const u8 EMPTY = 0x80;
+
+        //MurmurHash3's fmix64 finalizer
+        inline u64 Mix(u64 key)
+        {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdULL;
+            key ^= key >> 33;
+            key *= 0xc4ceb9fe1a85ec53ULL;
+            key ^= key >> 33;
+            return key;
+        }
+
+        //H1 picks the home slot, H2 is what gets stored in the control byte
+        inline u64 H1(u64 hash) { return hash >> 7; }
+        inline u8 H2(u64 hash) { return static_cast<u8>(hash & 0x7F); }
+
+        inline u32 TrailingZeros(u32 mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<u32>(index);
+#else
+            return static_cast<u32>(__builtin_ctz(mask));
+#endif
+        }
+
+        //16 control bytes starting at some slot - each bit of the returned masks is one slot
+        struct Group
+        {
+#ifdef R2_SFLATHASHMAP_SSE2
+            explicit Group(const u8* ctrl)
+                :mCtrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+            {
+            }
+
+            u32 Match(u8 h2) const
+            {
+                return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), mCtrl)));
+            }
+
+            //EMPTY is the only control byte with the high bit set
+            u32 MatchEmpty() const
+            {
+                return static_cast<u32>(_mm_movemask_epi8(mCtrl));
+            }
+
+            __m128i mCtrl;
+#else
+            explicit Group(const u8* ctrl)
+            {
+                memcpy(mCtrl, ctrl, sizeof(mCtrl));
+            }
+
+            u32 Match(u8 h2) const
+            {
+                u32 mask = 0;
+                for (u32 i = 0; i < 16; ++i)
+                {
+                    mask |= static_cast<u32>(mCtrl[i] == h2) << i;
+                }
+                return mask;
+            }
+
+            u32 MatchEmpty() const
+            {
+                u32 mask = 0;
+                for (u32 i = 0; i < 16; ++i)
+                {
+                    mask |= static_cast<u32>(mCtrl[i] >> 7) << i;
+                }
+                return mask;
+            }
+
+            u8 mCtrl[16];
+#endif
+        };
+
+        //The first GROUP_WIDTH control bytes are mirrored after the end so a group can be loaded from any slot without wrapping
+        template<typename T> void SetCtrl(SFlatHashMap<T>& h, u64 slot, u8 value)
+        {
+            h.mCtrl[slot] = value;
+            if (slot < SFlatHashMap<T>::GROUP_WIDTH)
+            {
+                h.mCtrl[h.mNumSlots + slot] = value;
+            }
+        }
+
+        template<typename T> u64 FindSlot(const SFlatHashMap<T>& h, u64 key, u64 hash)
+        {
+            const u64 mask = h.mNumSlots - 1;
+            const u8 h2 = H2(hash);
+            u64 pos = H1(hash) & mask;
+
+            for (u64 probed = 0; probed < h.mNumSlots; probed += SFlatHashMap<T>::GROUP_WIDTH)
+            {
+                const Group group(h.mCtrl + pos);
+
+                for (u32 match = group.Match(h2); match != 0; match &= match - 1)
+                {
+                    const u64 slot = (pos + TrailingZeros(match)) & mask;
+                    if (h.mData->mData[h.mSlots[slot]].key == key)
+                    {
+                        return slot;
+                    }
+                }
+
+                //with linear probing an entry can never be past an empty slot from its home
+                if (group.MatchEmpty() != 0)
+                {
+                    return END_OF_LIST;
+                }
+
+                pos = (pos + SFlatHashMap<T>::GROUP_WIDTH) & mask;
+            }
+
+            return END_OF_LIST;
+        }
+
+        template<typename T> u64 FindEmptySlot(const SFlatHashMap<T>& h, u64 hash)
+        {
+            const u64 mask = h.mNumSlots - 1;
+            u64 pos = H1(hash) & mask;
+
+            for (u64 probed = 0; probed < h.mNumSlots; probed += SFlatHashMap<T>::GROUP_WIDTH)
+            {
+                const u32 empty = Group(h.mCtrl + pos).MatchEmpty();
+                if (empty != 0)
+                {
+                    return (pos + TrailingZeros(empty)) & mask;
+                }
+
+                pos = (pos + SFlatHashMap<T>::GROUP_WIDTH) & mask;
+            }
+
+            R2_CHECK(false, "The SFlatHashMap has no empty slots!");
+            return END_OF_LIST;
+        }
+
+        template<typename T> u64 FindOrFail(const SFlatHashMap<T>& h, u64 key)
+        {
+            const u64 slot = FindSlot(h, key, Mix(key));
+            return slot == END_OF_LIST ? END_OF_LIST : h.mSlots[slot];
+        }
+
+        template<typename T> u64 FindOrMake(SFlatHashMap<T>& h, u64 key)
+        {
+            const u64 hash = Mix(key);
+            const u64 slot = FindSlot(h, key, hash);
+
+            if (slot != END_OF_LIST)
+            {
+                return h.mSlots[slot];
+            }
+
+            R2_CHECK(r2::sarr::Size(*h.mData) < h.mCapacity, "The SFlatHashMap should not be full!");
+
+            const u64 emptySlot = FindEmptySlot(h, hash);
+
+            const u64 i = r2::sarr::Size(*h.mData);
+            typename SFlatHashMap<T>::HashMapEntry e;
+            e.key = key;
+            r2::sarr::Push(*h.mData, e);
+
+            SetCtrl(h, emptySlot, H2(hash));
+            h.mSlots[emptySlot] = static_cast<u32>(i);
+
+            return i;
+        }
+
+        //Backward shift deletion - move every entry after the hole back into it unless its home slot is between the hole and where it is now
+        template<typename T> void EraseSlot(SFlatHashMap<T>& h, u64 slot)
+        {
+            const u64 mask = h.mNumSlots - 1;
+            u64 hole = slot;
+            u64 next = (slot + 1) & mask;
+
+            while (h.mCtrl[next] != EMPTY)
+            {
+                const u64 home = H1(Mix(h.mData->mData[h.mSlots[next]].key)) & mask;
+
+                if (((next - home) & mask) >= ((next - hole) & mask))
+                {
+                    SetCtrl(h, hole, h.mCtrl[next]);
+                    h.mSlots[hole] = h.mSlots[next];
+                    hole = next;
+                }
+
+                next = (next + 1) & mask;
+            }
+
+            SetCtrl(h, hole, EMPTY);
+        }
+
+        template<typename T> void FindAndErase(SFlatHashMap<T>& h, u64 key)
+        {
+            const u64 slot = FindSlot(h, key, Mix(key));
+
+            if (slot == END_OF_LIST)
+            {
+                return;
+            }
+
+            const u64 i = h.mSlots[slot];
+
+            EraseSlot(h, slot);
+
+            //keep mData packed by moving the last entry into the removed one's place
+            const u64 last = r2::sarr::Size(*h.mData) - 1;
+            if (i != last)
+            {
+                h.mData->mData[i] = h.mData->mData[last];
+
+                const u64 lastSlot = FindSlot(h, h.mData->mData[i].key, Mix(h.mData->mData[i].key));
+                R2_CHECK(lastSlot != END_OF_LIST && h.mSlots[lastSlot] == last, "We should have found the last entry's slot");
+                h.mSlots[lastSlot] = static_cast<u32>(i);
+            }
+
+            r2::sarr::Pop(*h.mData);
+        }
+    }
+
+    namespace sflathashmap
+    {
+        template<typename T> bool Has(const SFlatHashMap<T>& h, u64 key)
+        {
+            return flathashmap_internal::FindOrFail(h, key) != flathashmap_internal::END_OF_LIST;
+        }
+
+        template<typename T> T& Get(SFlatHashMap<T>& h, u64 key, T& theDefault)
+        {
+            const u64 i = flathashmap_internal::FindOrFail(h, key);
+            return i == flathashmap_internal::END_OF_LIST ? theDefault : (*h.mData)[i].value;
+        }
+
+        template<typename T> T& Get(SFlatHashMap<T>& h, u64 key, T& theDefault, bool& success) //success == true if it's not default
+        {
+            success = false;
+
+            const u64 i = flathashmap_internal::FindOrFail(h, key);
+
+            if (i == flathashmap_internal::END_OF_LIST)
+            {
+                return theDefault;
+            }
+
+            success = true;
+
+            return (*h.mData)[i].value;
+        }
+
+        template<typename T> const T& Get(const SFlatHashMap<T>& h, u64 key, const T& theDefault)
+        {
+            const u64 i = flathashmap_internal::FindOrFail(h, key);
+            return i == flathashmap_internal::END_OF_LIST ? theDefault : ((*h.mData)[i]).value;
+        }
+
+        template<typename T> void Set(SFlatHashMap<T>& h, u64 key, const T& value)
+        {
+            const u64 i = flathashmap_internal::FindOrMake(h, key);
+            ((*h.mData)[i]).value = value;
+        }
+
+        template<typename T> void Remove(SFlatHashMap<T>& h, u64 key)
+        {
+            flathashmap_internal::FindAndErase(h, key);
+
+#ifdef R2_DEBUG
+            R2_CHECK(!r2::sflathashmap::Has(h, key), "We have a key: %llu that wasn't removed!", key);
+#endif
+        }
+
+        template<typename T> void Clear(SFlatHashMap<T>& h)
+        {
+            r2::sarr::Clear(*h.mData);
+            memset(h.mCtrl, flathashmap_internal::EMPTY, h.mNumSlots + SFlatHashMap<T>::GROUP_WIDTH);
+        }
+
+        template<typename T> u64 Size(const SFlatHashMap<T>& h)
+        {
+            return r2::sarr::Size(*h.mData);
+        }
+
+        template<typename T> const typename SFlatHashMap<T>::HashMapEntry* Begin(const SFlatHashMap<T>& h)
+        {
+            return r2::sarr::Begin(*h.mData);
+        }
+
+        template<typename T> const typename SFlatHashMap<T>::HashMapEntry* End(const SFlatHashMap<T>& h)
+        {
+            return r2::sarr::End(*h.mData);
+        }
+
+        template<typename T> typename SFlatHashMap<T>::HashMapEntry* Begin(SFlatHashMap<T>& h)
+        {
+            return r2::sarr::Begin(*h.mData);
+        }
+
+        template<typename T> typename SFlatHashMap<T>::HashMapEntry* End(SFlatHashMap<T>& h)
+        {
+            return r2::sarr::End(*h.mData);
+        }
+
+        template<typename T, class ARENA> SFlatHashMap<T>* CreateSFlatHashMap(ARENA& a, u64 capacity, const char* file, s32 line, const char* description)
+        {
+            const auto memSize = SFlatHashMap<T>::MemorySize(capacity);
+            void* hashMapPlacement = ALLOC_BYTES(a, memSize, alignof(typename SFlatHashMap<T>::HashMapEntry), file, line, description);
+
+            return CreateSFlatHashMapInPlace<T>(hashMapPlacement, capacity);
+        }
+
+        template<typename T> SFlatHashMap<T>* CreateSFlatHashMapInPlace(void* hashMapPlacement, u64 capacity)
+        {
+            using HashMapEntry = typename SFlatHashMap<T>::HashMapEntry;
+
+            SFlatHashMap<T>* h = new (hashMapPlacement) SFlatHashMap<T>();
+
+            SArray<HashMapEntry>* startOfDataArray = new (r2::mem::utils::PointerAdd(h, sizeof(SFlatHashMap<T>))) SArray<HashMapEntry>();
+
+            HashMapEntry* dataStart = (HashMapEntry*)r2::mem::utils::PointerAdd(startOfDataArray, sizeof(SArray<HashMapEntry>));
+
+            u32* slotsStart = (u32*)r2::mem::utils::PointerAdd(dataStart, sizeof(HashMapEntry) * capacity);
+
+            u8* ctrlStart = (u8*)r2::mem::utils::PointerAdd(slotsStart, sizeof(u32) * SFlatHashMap<T>::NumSlots(capacity));
+
+            h->Create(startOfDataArray, dataStart, slotsStart, ctrlStart, capacity);
+
+            return h;
+        }
+
+        template<typename T> bool IsFull(const SFlatHashMap<T>& h)
+        {
+            return r2::sarr::Size(*h.mData) >= h.mCapacity;
+        }
+    }
+
+    template<typename T>
+    SFlatHashMap<T>::~SFlatHashMap()
+    {
+        mData->~SArray();
+        mData = nullptr;
+        mSlots = nullptr;
+        mCtrl = nullptr;
+    }
+
+    //keep the load factor at or below 7/8 so probe sequences stay short and there's always an empty slot to stop on
+    template<typename T>
+    u64 SFlatHashMap<T>::NumSlots(u64 capacity)
+    {
+        return std::max(GROUP_WIDTH, r2::util::NextPowerOfTwo64Bit((capacity * 8 + 6) / 7 + 1));
+    }
+
+    template<typename T>
+    u64 SFlatHashMap<T>::MemorySize(u64 capacity)
+    {
+        const u64 numSlots = NumSlots(capacity);
+        return sizeof(SFlatHashMap<T>) + SArray<HashMapEntry>::MemorySize(capacity) + sizeof(u32) * numSlots + (numSlots + GROUP_WIDTH);
+    }
+
+    template<typename T>
+    void SFlatHashMap<T>::Create(SArray<HashMapEntry>* dataArrayStart, HashMapEntry* dataStart, u32* slotsStart, u8* ctrlStart, u64 capacity)
+    {
+        R2_CHECK(capacity < std::numeric_limits<u32>::max(), "SFlatHashMap only supports up to 2^32 - 1 entries");
+
+        mCapacity = capacity;
+        mNumSlots = NumSlots(capacity);
+        mData = dataArrayStart;
+        mData->Create(dataStart, capacity);
+        mSlots = slotsStart;
+        mCtrl = ctrlStart;
+
+        memset(mCtrl, flathashmap_internal::EMPTY, mNumSlots + GROUP_WIDTH);
+    }
+}
+
+#endif /* SFlatHashMap_h */
@@ -41,6 +41,7 @@
 #include "r2/Core/Assets/AssetFiles/ManifestAssetFile.h"
 #include "r2/Core/Layer/ECSLayer.h"
 #include "r2/Core/Input/InputState.h"
+#include "r2/Core/Jobs/JobSystem.h"
 
 #ifdef R2_DEBUG
 #include <chrono>
@@ -68,6 +69,9 @@ namespace
 {
     const u32 MAX_NUM_SHADERS = 512;
     const u32 ALIGNMENT = 16;
+    const u32 MAX_NUM_JOBS_PER_THREAD = 4096;
+    const u64 JOB_THREAD_SCRATCH_MEMORY_SIZE = Kilobytes(256);
+    const u32 NUM_EXTRA_PROFILER_THREADS = 4; //for the threads that aren't in the job system like the asset loading threads
 }
 
 namespace r2
@@ -487,6 +491,32 @@ namespace r2
 
             r2::mem::InternalEngineMemory& engineMem = r2::mem::GlobalMemory::EngineMemory();
 
+            //setup the job system - the main thread counts as one of the job threads
+            {
+                const u32 numCoresLeft = static_cast<u32>(std::max(CPLAT.NumLogicalCPUCores() - 1, 0));
+                const u32 numWorkerThreads = std::min({ numCoresLeft, noptrApp->GetMaxNumJobWorkerThreads(), r2::jobs::MAX_NUM_JOB_WORKER_THREADS });
+
+                bool jobSystemInitialized = r2::jobs::Init(engineMem.internalEngineMemoryHandle, numWorkerThreads, MAX_NUM_JOBS_PER_THREAD, JOB_THREAD_SCRATCH_MEMORY_SIZE);
+                if (!jobSystemInitialized)
+                {
+                    R2_CHECK(false, "We couldn't initialize the job system");
+                    return false;
+                }
+            }
+
+#ifdef R2_PROFILER
+            {
+                const u32 maxNumProfilerThreads = std::min(r2::jobs::NumThreads() + NUM_EXTRA_PROFILER_THREADS, r2::prof::MAX_NUM_PROFILER_THREADS);
+
+                bool profilerInitialized = r2::prof::Init(engineMem.internalEngineMemoryHandle, maxNumProfilerThreads, r2::prof::MAX_NUM_ZONES_PER_THREAD);
+                if (!profilerInitialized)
+                {
+                    R2_CHECK(false, "We couldn't initialize the profiler");
+                    return false;
+                }
+            }
+#endif
+
 			bool shaderSystemIntialized = r2::draw::shadersystem::Init(engineMem.internalEngineMemoryHandle, MAX_NUM_SHADERS, noptrApp->GetShaderManifestsPath().c_str(), internalShaderManifestPath, appMaterialPacksManifests.size() + 1); //@TODO(Serge): add 1 again
 			if (!shaderSystemIntialized)
 			{
@@ -506,7 +536,7 @@ namespace r2
                 mECSWorld->Init(engineMem.internalEngineMemoryHandle, noptrApp->GetMaxNumComponents(), noptrApp->GetMaxNumECSEntities(), noptrApp->GetMaxNumECSSystems(), noptrApp->GetECSWorldAuxMemory());
 
                 mLevelManager = ALLOC(LevelManager, *MEM_ENG_PERMANENT_PTR);
-                mLevelManager->Init(engineMem.internalEngineMemoryHandle, "Level Manager", 1000);
+                mLevelManager->Init(engineMem.internalEngineMemoryHandle, "Level Manager", 1000, noptrApp->GetMaxNumECSEntities());
             }
             
             //@TODO(Serge): don't use make unique!
@@ -555,7 +585,7 @@ namespace r2
     void Engine::Update()
     {
 
-     //   PROFILE_SCOPE("Engine::Update");
+        PROFILE_SCOPE("Engine::Update");
 
 #ifdef R2_ASSET_PIPELINE
 		mAssetCommandHandler.Update();
@@ -565,6 +595,10 @@ namespace r2
 
         r2::asset::lib::Update(*mAssetLib);
 
+        mGameAssetManager->Update();
+
+        mLevelManager->Update();
+
 		r2::draw::shadersystem::Update();
 	//	r2::draw::matsys::Update();
 
@@ -637,10 +671,18 @@ namespace r2
 #endif
 
         FREE((byte*)mAssetLibMemBoundary.location, *MEM_ENG_PERMANENT_PTR);
+
+#ifdef R2_PROFILER
+        r2::prof::Shutdown();
+#endif
+
+        r2::jobs::Shutdown();
     }
     
     void Engine::Render(float alpha)
     {
+        PROFILE_SCOPE("Engine::Render");
+
         if (!mMinimized)
         {
             mLayerStack.Render(alpha);
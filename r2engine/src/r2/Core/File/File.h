@@ -34,6 +34,9 @@ namespace r2::fs
         
         virtual bool IsOpen() const = 0;
         virtual s64 Size() const = 0;
+        
+        //Read only view of the whole file for files that live on a memory mapped device, nullptr for everything else
+        virtual const byte* MappedData() const {return nullptr;}
 
         //Not to be used by anyone except the file system!
         void SetFileDevice(FileStorageDevice* fileDevice) {mDevice = fileDevice;}
@@ -776,6 +776,71 @@ namespace r2::fs
         return ReadUncompressedFileData(buffer, bufferSize, fileIndex);
     }
     
+    const byte* ZipFile::GetStoredFileDataByHash(u64 hash, u64& size)
+    {
+        R2_CHECK(ZIP_FILE_INITIALIZED, "Zip File must be initialized through InitArchive()");
+        size = 0;
+        
+        if (!ZIP_FILE_INITIALIZED)
+        {
+            return nullptr;
+        }
+        
+        const byte* mappedData = mnoptrFile->MappedData();
+        
+        if (!mappedData)
+        {
+            return nullptr;
+        }
+        
+        u32 theDefault = UINT_MAX;
+        u32 fileIndex = r2::shashmap::Get(*mFileIndexLookup, hash, theDefault);
+        
+        if (fileIndex == theDefault)
+        {
+            return nullptr;
+        }
+        
+        ZipFileInfo info;
+        if (!GetFileInfo(fileIndex, info, nullptr))
+        {
+            return nullptr;
+        }
+        
+        if (info.isDirectory || info.method != 0 || info.compressedSize != info.uncompressedSize ||
+            (info.bitFlag & (R2_ZIP_GENERAL_PURPOSE_BIT_FLAG_IS_ENCRYPTED | R2_ZIP_GENERAL_PURPOSE_BIT_FLAG_USES_STRONG_ENCRYPTION | R2_ZIP_GENERAL_PURPOSE_BIT_FLAG_COMPRESSED_PATCH_FLAG)))
+        {
+            return nullptr;
+        }
+        
+        u64 curFileOffset = info.localHeaderOffset;
+        if (curFileOffset + R2_ZIP_LOCAL_DIR_HEADER_SIZE > mArchive.archiveSize)
+        {
+            R2_CHECK(false, "Invalid header or corrupted");
+            return nullptr;
+        }
+        
+        const byte* localHeader = mappedData + curFileOffset;
+        
+        if (MZ_READ_LE32(localHeader) != R2_ZIP_LOCAL_DIR_HEADER_SIG)
+        {
+            R2_CHECK(false, "Invalid header or corrupted");
+            return nullptr;
+        }
+        
+        curFileOffset += R2_ZIP_LOCAL_DIR_HEADER_SIZE + MZ_READ_LE16(localHeader + R2_ZIP_LDH_FILENAME_LEN_OFS) + MZ_READ_LE16(localHeader + R2_ZIP_LDH_EXTRA_LEN_OFS);
+        
+        if ((curFileOffset + info.uncompressedSize) > mArchive.archiveSize)
+        {
+            R2_CHECK(false, "Invalid header or corrupted");
+            return nullptr;
+        }
+        
+        size = info.uncompressedSize;
+        
+        return mappedData + curFileOffset;
+    }
+    
     bool ZipFile::ReadUncompressedFileData(void* buffer, u64 bufferSize, const char* filename)
     {
         R2_CHECK(ZIP_FILE_INITIALIZED, "Zip File must be initialized through InitArchive()");
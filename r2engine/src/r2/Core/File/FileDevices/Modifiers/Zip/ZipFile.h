@@ -115,6 +115,10 @@ namespace r2::fs
         bool ReadUncompressedFileData(void* buffer, u64 bufferSize, const char* filename);
         bool ReadUncompressedFileDataByHash(void* buffer, u64 bufferSize, u64 hash);
 
+        //Points straight at a file's data in the archive. Only works for entries that are stored without compression
+        //in an archive on a memory mapped device, returns nullptr otherwise. Valid for as long as the archive stays open.
+        const byte* GetStoredFileDataByHash(u64 hash, u64& size);
+
     private:
         
         bool InitReadArchive();
@@ -0,0 +1,54 @@
+//
+//  MemoryMappedFile.h
+//  r2engine
+//
+
+#ifndef MemoryMappedFile_h
+#define MemoryMappedFile_h
+
+#include "r2/Core/File/File.h"
+
+namespace r2
+{
+    namespace fs
+    {
+        //Read only file that's mapped into memory when it's opened. Reads are just copies out of the mapping and
+        //MappedData() hands out the mapping itself so callers can use the contents in place.
+        class R2_API MemoryMappedFile final: public File
+        {
+        public:
+
+            MemoryMappedFile();
+            ~MemoryMappedFile();
+
+            bool Open(const char* path, FileMode mode);
+            void Close();
+
+            virtual u64 Read(void* buffer, u64 length) override;
+            virtual u64 Read(void* buffer, u64 offset, u64 length) override;
+
+            //Always fails - mapped files are read only
+            virtual u64 Write(const void* buffer, u64 length) override;
+
+            virtual bool ReadAll(void* buffer) override;
+
+            virtual void Seek(u64 position) override;
+            virtual void SeekToEnd(void) override;
+            virtual void Skip(u64 bytes) override;
+            virtual s64 Tell(void) const override;
+
+            virtual bool IsOpen() const override;
+            virtual s64 Size() const override;
+
+            virtual const byte* MappedData() const override {return mData;}
+
+        private:
+            byte* mData;
+            u64 mSize;
+            u64 mPosition;
+            bool mIsOpen;
+        };
+    }
+}
+
+#endif /* MemoryMappedFile_h */
@@ -0,0 +1,102 @@
+//
+//  MemoryMappedFileStorageDevice.cpp
+//  r2engine
+//
+#include "r2pch.h"
+#if defined(R2_PLATFORM_LINUX)
+
+#include "r2/Core/File/FileDevices/Storage/MemoryMapped/MemoryMappedFileStorageDevice.h"
+#include "r2/Core/File/FileDevices/Storage/MemoryMapped/MemoryMappedFile.h"
+
+namespace r2::fs
+{
+    MemoryMappedFileStorageDevice::MemoryMappedFileStorageDevice()
+        : FileStorageDevice(DeviceStorage::MemoryMapped)
+    {
+
+    }
+
+    MemoryMappedFileStorageDevice::~MemoryMappedFileStorageDevice()
+    {
+        R2_CHECK(moptrFilePool == nullptr, "We haven't been unmounted yet!");
+    }
+
+    bool MemoryMappedFileStorageDevice::Mount(r2::mem::LinearArena& permanentStorage, u64 numFilesActive)
+    {
+        if (moptrFilePool)
+        {
+            return true;// we've already mounted
+        }
+
+        moptrFilePool = MAKE_POOL_ARENA(permanentStorage, sizeof(MemoryMappedFile), alignof(MemoryMappedFile), numFilesActive);
+        R2_CHECK(moptrFilePool != nullptr, "We couldn't allocate a pool of size: %llu\n", sizeof(MemoryMappedFile)*numFilesActive);
+
+        return moptrFilePool != nullptr;
+    }
+
+    bool MemoryMappedFileStorageDevice::Unmount(r2::mem::LinearArena& permanentStorage)
+    {
+        if (moptrFilePool == nullptr)
+        {
+            return true;
+        }
+
+        FREE(moptrFilePool, permanentStorage);
+        moptrFilePool = nullptr;
+
+        return true;
+    }
+
+    File* MemoryMappedFileStorageDevice::Open(const char* path, FileMode mode)
+    {
+        R2_CHECK(moptrFilePool != nullptr, "You never mounted MemoryMappedFileStorageDevice!");
+        if (moptrFilePool == nullptr)
+        {
+            R2_LOGW("Cannot open a file if we haven't been mounted yet!\n");
+            return nullptr;
+        }
+
+        MemoryMappedFile* mappedFile = ALLOC(MemoryMappedFile, *moptrFilePool);
+        R2_CHECK(mappedFile != nullptr, "We couldn't allocate a memory mapped file!");
+        if (mappedFile != nullptr && mappedFile->Open(path, mode))
+        {
+            mappedFile->SetFileDevice(this);
+            mappedFile->SetStorageDeviceConfig(GetStorageType());
+            return mappedFile;
+        }
+
+        if (mappedFile)
+        {
+            FREE(mappedFile, *moptrFilePool);
+        }
+
+#ifdef R2_DEBUG
+        printf("MemoryMappedFileStorageDevice::Open - Failed to open file: %s\n", path);
+#endif
+
+        return nullptr;
+    }
+
+    void MemoryMappedFileStorageDevice::Close(File* file)
+    {
+        R2_CHECK(moptrFilePool != nullptr, "You never mounted MemoryMappedFileStorageDevice!");
+
+        if (moptrFilePool == nullptr)
+        {
+            R2_LOGW("Cannot close a file if we haven't been mounted yet!\n");
+            return;
+        }
+
+        R2_CHECK(file != nullptr, "File passed in is nullptr!");
+
+        if (file)
+        {
+            MemoryMappedFile* mappedFile = static_cast<MemoryMappedFile*>(file);
+            mappedFile->Close();
+
+            FREE(mappedFile, *moptrFilePool);
+        }
+    }
+}
+
+#endif
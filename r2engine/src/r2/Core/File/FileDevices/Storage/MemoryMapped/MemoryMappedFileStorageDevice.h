@@ -0,0 +1,29 @@
+//
+//  MemoryMappedFileStorageDevice.h
+//  r2engine
+//
+
+#ifndef MemoryMappedFileStorageDevice_h
+#define MemoryMappedFileStorageDevice_h
+
+#include "r2/Core/File/FileDevices/FileDevice.h"
+#include "r2/Core/Memory/Allocators/LinearAllocator.h"
+#include "r2/Core/Memory/Allocators/PoolAllocator.h"
+
+namespace r2::fs
+{
+    //Only implemented on Linux for now. FileStorageArea doesn't mount one anywhere else and opening a
+    //DeviceStorage::MemoryMapped file falls back to the DiskFileStorageDevice.
+    class R2_API MemoryMappedFileStorageDevice: public FileStorageDevice
+    {
+    public:
+        MemoryMappedFileStorageDevice();
+        ~MemoryMappedFileStorageDevice();
+        virtual bool Mount(r2::mem::LinearArena& permanentStorage, u64 numFiles) override;
+        virtual bool Unmount(r2::mem::LinearArena& permanentStorage) override;
+        virtual File* Open(const char* path, FileMode mode) override;
+        virtual void Close(File* file) override;
+    };
+}
+
+#endif /* MemoryMappedFileStorageDevice_h */
@@ -9,6 +9,7 @@
 
 #include "r2/Core/File/DirectoryUtils.h"
 #include "r2/Core/File/FileDevices/Storage/Disk/DiskFileStorageDevice.h"
+#include "r2/Core/File/FileDevices/Storage/MemoryMapped/MemoryMappedFileStorageDevice.h"
 #include "r2/Core/File/FileDevices/Modifiers/Safe/SafeFileModifierDevice.h"
 #include "r2/Core/File/FileDevices/Modifiers/Zip/ZipFileModifierDevice.h"
 #include "r2/Core/File/File.h"
@@ -21,6 +22,7 @@ namespace r2::fs
 {
     FileStorageArea::FileStorageArea(const char* rootPath, u32 numFilesActive)
         : moptrStorageDevice(nullptr)
+        , moptrMappedStorageDevice(nullptr)
         , moptrModifiers(nullptr)
         , mNumFilesActive(numFilesActive)
     {
@@ -31,6 +33,7 @@ namespace r2::fs
     FileStorageArea::~FileStorageArea()
     {
         R2_CHECK(moptrStorageDevice == nullptr, "We never get unmounted!");
+        R2_CHECK(moptrMappedStorageDevice == nullptr, "We never get unmounted!");
         R2_CHECK(moptrModifiers == nullptr, "We never get unmounted!");
     }
     
@@ -48,6 +51,16 @@ namespace r2::fs
             DiskFileStorageDevice* diskDevice = static_cast<DiskFileStorageDevice*>(moptrStorageDevice);
             mounted = diskDevice->Mount(storage, mNumFilesActive);
         }
+
+#if defined(R2_PLATFORM_LINUX)
+        moptrMappedStorageDevice = ALLOC(MemoryMappedFileStorageDevice, storage);
+        R2_CHECK(moptrMappedStorageDevice != nullptr, "We couldn't allocate a MemoryMappedFileStorageDevice!\n");
+        if (moptrMappedStorageDevice)
+        {
+            MemoryMappedFileStorageDevice* mappedDevice = static_cast<MemoryMappedFileStorageDevice*>(moptrMappedStorageDevice);
+            mounted = mappedDevice->Mount(storage, mNumFilesActive) && mounted;
+        }
+#endif
         
         moptrModifiers = MAKE_SARRAY(storage, FileDeviceModifier*, 10);
         
@@ -91,6 +104,20 @@ namespace r2::fs
             moptrStorageDevice = nullptr;
         }
         
+#if defined(R2_PLATFORM_LINUX)
+        if (moptrMappedStorageDevice)
+        {
+            MemoryMappedFileStorageDevice* mappedDevice = static_cast<MemoryMappedFileStorageDevice*>(moptrMappedStorageDevice);
+            result = mappedDevice->Unmount(storage);
+            R2_CHECK(result, "We couldn't unmount our memory mapped storage device!");
+            if (result)
+            {
+                FREE(moptrMappedStorageDevice, storage);
+                moptrMappedStorageDevice = nullptr;
+            }
+        }
+#endif
+        
         auto size = r2::sarr::Size(*moptrModifiers);
         
         for (u64 i = 0; i < size; ++i)
@@ -108,6 +135,21 @@ namespace r2::fs
         return true;
     }
     
+    FileStorageDevice* FileStorageArea::GetFileStorageDevice(DeviceStorage storage)
+    {
+        if (storage == DeviceStorage::MemoryMapped)
+        {
+            return moptrMappedStorageDevice;
+        }
+        
+        if (moptrStorageDevice && moptrStorageDevice->GetStorageType() == storage)
+        {
+            return moptrStorageDevice;
+        }
+        
+        return nullptr;
+    }
+    
     bool FileStorageArea::FileExists(const char* filePath)
     {
         if (moptrStorageDevice == nullptr)
@@ -9,6 +9,7 @@
 #define FileStorageArea_h
 
 #include "r2/Core/Memory/Allocators/LinearAllocator.h"
+#include "r2/Core/File/FileTypes.h"
 
 namespace r2::fs
 {
@@ -36,10 +37,13 @@ namespace r2::fs
         
         inline const char* RootPath() const {return &mRootPath[0];}
         inline FileStorageDevice* GetFileStorageDevice() {return moptrStorageDevice;}
+        //nullptr if there's no device for that kind of storage on this platform
+        FileStorageDevice* GetFileStorageDevice(DeviceStorage storage);
         inline const FileDeviceModifierList* GetFileDeviceModifiers() {return moptrModifiers;}
 
     protected:
         FileStorageDevice* moptrStorageDevice;
+        FileStorageDevice* moptrMappedStorageDevice;
         FileDeviceModifierList* moptrModifiers;
         
     private:
@@ -27,11 +27,17 @@ namespace r2
             R2_CHECK(path != nullptr, "Path is nullptr!");
             R2_CHECK(path != "", "Path is empty");
             
-            FileStorageDevice* storageDevice = mFSArea.GetFileStorageDevice();
+            FileStorageDevice* storageDevice = mFSArea.GetFileStorageDevice(config.GetStorageDevice());
+            
+            //Not every platform can map files, read those ones off of the disk instead
+            if (storageDevice == nullptr && config.GetStorageDevice() == DeviceStorage::MemoryMapped)
+            {
+                storageDevice = mFSArea.GetFileStorageDevice();
+            }
+            
             R2_CHECK(storageDevice != nullptr, "File Storage device is nullptr!");
-            R2_CHECK(config.GetStorageDevice() == storageDevice->GetStorageType(), "Storage types do not match!");
             
-            if (storageDevice == nullptr && config.GetStorageDevice() == storageDevice->GetStorageType())
+            if (storageDevice == nullptr)
             {
                 R2_LOGE("Storage Device is null or we have a storage device mismatch");
                 return nullptr;
@@ -21,6 +21,7 @@ namespace r2::fs
         Disk,
         Memory,
         Net,
+        MemoryMapped,
         Count
     };
     
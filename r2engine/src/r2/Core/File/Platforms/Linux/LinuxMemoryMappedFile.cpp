@@ -0,0 +1,206 @@
+//
+//  LinuxMemoryMappedFile.cpp
+//  r2engine
+//
+
+#include "r2pch.h"
+#if defined(R2_PLATFORM_LINUX)
+
+#include "r2/Core/File/FileDevices/Storage/MemoryMapped/MemoryMappedFile.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace r2
+{
+    namespace fs
+    {
+        MemoryMappedFile::MemoryMappedFile()
+            : mData(nullptr)
+            , mSize(0)
+            , mPosition(0)
+            , mIsOpen(false)
+        {
+        }
+
+        MemoryMappedFile::~MemoryMappedFile()
+        {
+            if (IsOpen())
+            {
+                Close();
+            }
+        }
+
+        bool MemoryMappedFile::Open(const char* path, FileMode mode)
+        {
+            R2_CHECK(path != nullptr, "Null Path!");
+            R2_CHECK(path != "", "Empty path!");
+
+            if (IsOpen())
+            {
+                return true;
+            }
+
+            if (mode.IsSet(Mode::Write) || mode.IsSet(Mode::Append) || mode.IsSet(Mode::Recreate))
+            {
+                R2_LOGW("MemoryMappedFile::Open - memory mapped files are read only: %s\n", path);
+                return false;
+            }
+
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+            if (fd == -1)
+            {
+                return false;
+            }
+
+            struct stat fileStat;
+            if (fstat(fd, &fileStat) == -1)
+            {
+                close(fd);
+                return false;
+            }
+
+            mSize = static_cast<u64>(fileStat.st_size);
+            mData = nullptr;
+
+            //mmap doesn't do empty files, the file is still valid there's just nothing to map
+            if (mSize > 0)
+            {
+                void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                if (data == MAP_FAILED)
+                {
+                    close(fd);
+                    mSize = 0;
+                    return false;
+                }
+
+                //Assets are almost always read front to back in full so get the read ahead going now
+                madvise(data, mSize, MADV_WILLNEED);
+
+                mData = static_cast<byte*>(data);
+            }
+
+            //The mapping keeps its own reference to the file
+            close(fd);
+
+            mPosition = 0;
+            mIsOpen = true;
+
+            SetFilePath(path);
+            SetFileMode(mode);
+
+            return true;
+        }
+
+        void MemoryMappedFile::Close()
+        {
+            R2_CHECK(IsOpen(), "Trying to close a closed file?");
+
+            if (mData)
+            {
+                munmap(mData, mSize);
+            }
+
+            mData = nullptr;
+            mSize = 0;
+            mPosition = 0;
+            mIsOpen = false;
+            SetFileDevice(nullptr);
+        }
+
+        u64 MemoryMappedFile::Read(void* buffer, u64 length)
+        {
+            R2_CHECK(IsOpen(), "The file isn't open?");
+            R2_CHECK(buffer != nullptr, "The buffer is null?");
+            R2_CHECK(length > 0, "You should want to read more than 0 bytes!");
+
+            if (IsOpen() && buffer != nullptr && length > 0 && mPosition < mSize)
+            {
+                const u64 readBytes = std::min(length, mSize - mPosition);
+                memcpy(buffer, mData + mPosition, readBytes);
+                mPosition += readBytes;
+                return readBytes;
+            }
+
+            return 0;
+        }
+
+        u64 MemoryMappedFile::Read(void* buffer, u64 offset, u64 length)
+        {
+            R2_CHECK(IsOpen(), "The file isn't open?");
+            R2_CHECK(buffer != nullptr, "The buffer is null?");
+            R2_CHECK(length > 0, "You should want to read more than 0 bytes!");
+
+            if (IsOpen() && buffer != nullptr && length > 0 && offset + length <= mSize)
+            {
+                Seek(offset);
+                return Read(buffer, length);
+            }
+
+            return 0;
+        }
+
+        u64 MemoryMappedFile::Write(const void* buffer, u64 length)
+        {
+            R2_CHECK(false, "MemoryMappedFile is read only!");
+            return 0;
+        }
+
+        bool MemoryMappedFile::ReadAll(void* buffer)
+        {
+            R2_CHECK(IsOpen(), "The file isn't open?");
+            R2_CHECK(buffer != nullptr, "nullptr buffer?");
+
+            if (mSize == 0)
+            {
+                return IsOpen();
+            }
+
+            Seek(0);
+            u64 bytesRead = Read(buffer, mSize);
+
+            R2_CHECK(bytesRead == mSize, "We should have read the whole file!");
+            return bytesRead == mSize;
+        }
+
+        void MemoryMappedFile::Seek(u64 position)
+        {
+            R2_CHECK(IsOpen(), "The file should be open");
+            mPosition = std::min(position, mSize);
+        }
+
+        void MemoryMappedFile::SeekToEnd(void)
+        {
+            R2_CHECK(IsOpen(), "The file should be open");
+            mPosition = mSize;
+        }
+
+        void MemoryMappedFile::Skip(u64 bytes)
+        {
+            R2_CHECK(IsOpen(), "The file should be open");
+            mPosition = std::min(mPosition + bytes, mSize);
+        }
+
+        s64 MemoryMappedFile::Tell(void) const
+        {
+            R2_CHECK(IsOpen(), "The file should be open");
+            return static_cast<s64>(mPosition);
+        }
+
+        bool MemoryMappedFile::IsOpen() const
+        {
+            return mIsOpen;
+        }
+
+        s64 MemoryMappedFile::Size() const
+        {
+            R2_CHECK(IsOpen(), "The file should be open");
+            return static_cast<s64>(mSize);
+        }
+    }
+}
+
+#endif
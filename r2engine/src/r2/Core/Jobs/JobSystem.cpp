@@ -0,0 +1,456 @@
+#include "r2pch.h"
+#include "r2/Core/Jobs/JobSystem.h"
+#include "r2/Core/Memory/Allocators/LinearAllocator.h"
+#include "r2/Core/Memory/InternalEngineMemory.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace r2::jobs
+{
+	//Chase-Lev work stealing deque with a fixed capacity. Only the owning thread calls Push/Pop, any thread can call Steal.
+	//top and bottom are on their own cache lines since thieves hammer top while the owner works on bottom
+	struct JobDeque
+	{
+		alignas(64) std::atomic<s64> top{ 0 };
+		alignas(64) std::atomic<s64> bottom{ 0 };
+		alignas(64) Job* jobs = nullptr;
+		s64 mask = 0;
+	};
+
+	struct JobThread
+	{
+		JobDeque deque;
+		r2::mem::StackArena* scratchArena = nullptr;
+		std::thread thread;
+		u32 randomState = 0;
+	};
+
+	struct JobSystem
+	{
+		r2::mem::MemoryArea::Handle mMemoryAreaHandle = r2::mem::MemoryArea::Invalid;
+		r2::mem::MemoryArea::SubArea::Handle mSubAreaHandle = r2::mem::MemoryArea::SubArea::Invalid;
+		r2::mem::LinearArena* mLinearArena = nullptr;
+
+		JobThread* mThreads = nullptr;
+		u32 mNumThreads = 0;
+
+		//Jobs that are sitting in a deque and haven't been started yet. Sleeping workers only wake up for these.
+		std::atomic<s32> mNumQueuedJobs{ 0 };
+		std::atomic_bool mShutdown{ false };
+
+		std::mutex mSleepMutex;
+		std::condition_variable mWakeCondition;
+	};
+}
+
+namespace
+{
+	r2::jobs::JobSystem* s_optrJobSystem = nullptr;
+
+	thread_local u32 t_threadIndex = 0;
+
+	const u64 ALIGNMENT = 16;
+	const u32 NUM_SPINS_BEFORE_SLEEPING = 64;
+}
+
+namespace r2::jobs
+{
+	bool PushJob(JobDeque& deque, const Job& job)
+	{
+		const s64 b = deque.bottom.load(std::memory_order_relaxed);
+		const s64 t = deque.top.load(std::memory_order_acquire);
+
+		if (b - t > deque.mask)
+		{
+			return false;
+		}
+
+		deque.jobs[b & deque.mask] = job;
+
+		//release so a thief that sees the new bottom also sees the job
+		deque.bottom.store(b + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool PopJob(JobDeque& deque, Job& job)
+	{
+		const s64 b = deque.bottom.load(std::memory_order_relaxed) - 1;
+		deque.bottom.store(b, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		s64 t = deque.top.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			//empty
+			deque.bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		job = deque.jobs[b & deque.mask];
+
+		if (t != b)
+		{
+			return true;
+		}
+
+		//last job - race against any thieves for it
+		const bool won = deque.top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		deque.bottom.store(b + 1, std::memory_order_relaxed);
+
+		return won;
+	}
+
+	bool StealJob(JobDeque& deque, Job& job)
+	{
+		s64 t = deque.top.load(std::memory_order_acquire);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		const s64 b = deque.bottom.load(std::memory_order_acquire);
+
+		if (t >= b)
+		{
+			return false;
+		}
+
+		job = deque.jobs[t & deque.mask];
+
+		return deque.top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	void ExecuteJob(const Job& job)
+	{
+		job.func(job.data);
+
+		if (job.counter)
+		{
+			job.counter->value.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	}
+
+	u32 NextRandom(u32& state)
+	{
+		//xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	bool TryRunOneJob()
+	{
+		const u32 threadIndex = t_threadIndex;
+		JobThread& thisThread = s_optrJobSystem->mThreads[threadIndex];
+
+		Job job;
+
+		if (PopJob(thisThread.deque, job))
+		{
+			s_optrJobSystem->mNumQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			ExecuteJob(job);
+			return true;
+		}
+
+		const u32 numThreads = s_optrJobSystem->mNumThreads;
+		if (numThreads <= 1)
+		{
+			return false;
+		}
+
+		//start at a random victim so all of the thieves don't pile on to the same deque
+		const u32 startIndex = NextRandom(thisThread.randomState) % numThreads;
+
+		for (u32 i = 0; i < numThreads; ++i)
+		{
+			const u32 victimIndex = (startIndex + i) % numThreads;
+
+			if (victimIndex == threadIndex)
+			{
+				continue;
+			}
+
+			if (StealJob(s_optrJobSystem->mThreads[victimIndex].deque, job))
+			{
+				s_optrJobSystem->mNumQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				ExecuteJob(job);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void WorkerThreadProc(u32 threadIndex)
+	{
+		t_threadIndex = threadIndex;
+
+		//jobs that use MEM_ENG_SCRATCH_PTR get this thread's scratch arena instead of racing on the main thread's singleFrameArena
+		r2::mem::SetThreadScratchArena(s_optrJobSystem->mThreads[threadIndex].scratchArena);
+
+		u32 numSpins = 0;
+
+		while (!s_optrJobSystem->mShutdown.load(std::memory_order_acquire))
+		{
+			if (TryRunOneJob())
+			{
+				numSpins = 0;
+				continue;
+			}
+
+			if (++numSpins < NUM_SPINS_BEFORE_SLEEPING)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			numSpins = 0;
+
+			std::unique_lock<std::mutex> lock(s_optrJobSystem->mSleepMutex);
+			s_optrJobSystem->mWakeCondition.wait(lock, [] {
+				return s_optrJobSystem->mShutdown.load(std::memory_order_acquire) || s_optrJobSystem->mNumQueuedJobs.load(std::memory_order_acquire) > 0;
+			});
+		}
+
+		r2::mem::SetThreadScratchArena(nullptr);
+	}
+
+	bool Init(const r2::mem::MemoryArea::Handle memoryAreaHandle, u32 numWorkerThreads, u32 maxNumJobsPerThread, u64 scratchMemorySizePerThread)
+	{
+		R2_CHECK(memoryAreaHandle != r2::mem::MemoryArea::Invalid, "Memory Area handle is invalid");
+		R2_CHECK(s_optrJobSystem == nullptr, "Are you trying to initialize this system more than once?");
+		R2_CHECK(numWorkerThreads <= MAX_NUM_JOB_WORKER_THREADS, "We can have at most %u worker threads", MAX_NUM_JOB_WORKER_THREADS);
+		R2_CHECK(maxNumJobsPerThread > 0 && (maxNumJobsPerThread & (maxNumJobsPerThread - 1)) == 0, "maxNumJobsPerThread must be a power of 2");
+
+		if (memoryAreaHandle == r2::mem::MemoryArea::Invalid ||
+			s_optrJobSystem != nullptr)
+		{
+			return false;
+		}
+
+		r2::mem::MemoryArea* noptrMemArea = r2::mem::GlobalMemory::GetMemoryArea(memoryAreaHandle);
+		R2_CHECK(noptrMemArea != nullptr, "noptrMemArea is null?");
+		if (!noptrMemArea)
+		{
+			return false;
+		}
+
+		u64 memoryNeeded = GetMemorySize(numWorkerThreads, maxNumJobsPerThread, scratchMemorySizePerThread);
+		if (memoryNeeded > noptrMemArea->UnAllocatedSpace())
+		{
+			R2_CHECK(false, "We don't have enough space to allocate a new sub area for this system");
+			return false;
+		}
+
+		r2::mem::MemoryArea::SubArea::Handle subAreaHandle = noptrMemArea->AddSubArea(memoryNeeded, "Job System");
+
+		R2_CHECK(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid, "We have an invalid sub area");
+
+		if (subAreaHandle == r2::mem::MemoryArea::SubArea::Invalid)
+		{
+			return false;
+		}
+
+		r2::mem::MemoryArea::SubArea* noptrSubArea = noptrMemArea->GetSubArea(subAreaHandle);
+		R2_CHECK(noptrSubArea != nullptr, "noptrSubArea is null");
+		if (!noptrSubArea)
+		{
+			return false;
+		}
+
+		r2::mem::LinearArena* jobSystemArena = EMPLACE_LINEAR_ARENA(*noptrSubArea);
+
+		if (!jobSystemArena)
+		{
+			R2_CHECK(jobSystemArena != nullptr, "linearArena is null");
+			return false;
+		}
+
+		s_optrJobSystem = ALLOC(JobSystem, *jobSystemArena);
+
+		R2_CHECK(s_optrJobSystem != nullptr, "We couldn't allocate the job system!");
+
+		s_optrJobSystem->mMemoryAreaHandle = memoryAreaHandle;
+		s_optrJobSystem->mSubAreaHandle = subAreaHandle;
+		s_optrJobSystem->mLinearArena = jobSystemArena;
+		s_optrJobSystem->mNumThreads = numWorkerThreads + 1; //+1 for the main thread
+
+		s_optrJobSystem->mThreads = ALLOC_ARRAYN(JobThread, s_optrJobSystem->mNumThreads, *jobSystemArena);
+
+		for (u32 i = 0; i < s_optrJobSystem->mNumThreads; ++i)
+		{
+			JobThread& jobThread = s_optrJobSystem->mThreads[i];
+			jobThread.deque.jobs = ALLOC_ARRAYN(Job, maxNumJobsPerThread, *jobSystemArena);
+			jobThread.deque.mask = static_cast<s64>(maxNumJobsPerThread) - 1;
+			jobThread.scratchArena = MAKE_STACK_ARENA(*jobSystemArena, scratchMemorySizePerThread);
+			jobThread.randomState = 0x9E3779B9u * (i + 1);
+
+			R2_CHECK(jobThread.deque.jobs != nullptr && jobThread.scratchArena != nullptr, "We couldn't allocate the data for job thread: %u", i);
+		}
+
+		t_threadIndex = 0;
+
+		for (u32 i = 1; i < s_optrJobSystem->mNumThreads; ++i)
+		{
+			s_optrJobSystem->mThreads[i].thread = std::thread(WorkerThreadProc, i);
+		}
+
+		return true;
+	}
+
+	void Shutdown()
+	{
+		if (s_optrJobSystem == nullptr)
+		{
+			R2_CHECK(false, "We haven't initialized the job system yet!");
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_optrJobSystem->mSleepMutex);
+			s_optrJobSystem->mShutdown.store(true, std::memory_order_release);
+		}
+
+		s_optrJobSystem->mWakeCondition.notify_all();
+
+		for (u32 i = 1; i < s_optrJobSystem->mNumThreads; ++i)
+		{
+			if (s_optrJobSystem->mThreads[i].thread.joinable())
+			{
+				s_optrJobSystem->mThreads[i].thread.join();
+			}
+		}
+
+		r2::mem::LinearArena* jobSystemArena = s_optrJobSystem->mLinearArena;
+
+		for (s64 i = static_cast<s64>(s_optrJobSystem->mNumThreads) - 1; i >= 0; --i)
+		{
+			JobThread& jobThread = s_optrJobSystem->mThreads[i];
+			FREE(jobThread.scratchArena, *jobSystemArena);
+			FREE_ARRAY(jobThread.deque.jobs, *jobSystemArena);
+		}
+
+		FREE_ARRAY(s_optrJobSystem->mThreads, *jobSystemArena);
+
+		FREE(s_optrJobSystem, *jobSystemArena);
+		s_optrJobSystem = nullptr;
+
+		FREE_EMPLACED_ARENA(jobSystemArena);
+	}
+
+	bool IsInitialized()
+	{
+		return s_optrJobSystem != nullptr;
+	}
+
+	u64 GetMemorySize(u32 numWorkerThreads, u32 maxNumJobsPerThread, u64 scratchMemorySizePerThread)
+	{
+		u32 boundsChecking = 0;
+#ifdef R2_DEBUG
+		boundsChecking = r2::mem::BasicBoundsChecking::SIZE_FRONT + r2::mem::BasicBoundsChecking::SIZE_BACK;
+#endif
+		u32 headerSize = r2::mem::LinearAllocator::HeaderSize();
+
+		const u32 numThreads = numWorkerThreads + 1;
+
+		return
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::mem::LinearArena), ALIGNMENT, headerSize, boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(JobSystem), alignof(JobSystem), headerSize, boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(JobThread) * (numThreads + 1), alignof(JobThread), headerSize, boundsChecking) + //+1 for the array length header
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(Job) * (maxNumJobsPerThread + 1), alignof(Job), headerSize, boundsChecking) * numThreads +
+			(r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::mem::StackArena), ALIGNMENT, headerSize, boundsChecking) +
+			 r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::mem::StackAllocator) + scratchMemorySizePerThread, 64, headerSize, boundsChecking)) * numThreads;
+	}
+
+	u32 NumThreads()
+	{
+		return s_optrJobSystem ? s_optrJobSystem->mNumThreads : 1;
+	}
+
+	u32 GetThreadIndex()
+	{
+		return t_threadIndex;
+	}
+
+	r2::mem::StackArena& GetThreadScratchArena()
+	{
+		R2_CHECK(s_optrJobSystem != nullptr, "We haven't initialized the job system yet!");
+		return *s_optrJobSystem->mThreads[t_threadIndex].scratchArena;
+	}
+
+	void Submit(const Job* jobs, u32 numJobs, JobCounter& counter)
+	{
+		R2_CHECK(s_optrJobSystem != nullptr, "We haven't initialized the job system yet!");
+
+		if (numJobs == 0)
+		{
+			return;
+		}
+
+		counter.value.fetch_add(static_cast<s32>(numJobs), std::memory_order_relaxed);
+
+		JobDeque& deque = s_optrJobSystem->mThreads[t_threadIndex].deque;
+
+		u32 numPushed = 0;
+
+		for (u32 i = 0; i < numJobs; ++i)
+		{
+			Job job = jobs[i];
+			job.counter = &counter;
+
+			//count it before it's visible so a thief can't take it (and decrement) first
+			s_optrJobSystem->mNumQueuedJobs.fetch_add(1, std::memory_order_release);
+
+			if (PushJob(deque, job))
+			{
+				++numPushed;
+			}
+			else
+			{
+				//@NOTE(Serge): our deque is full - just run it now rather than fail
+				s_optrJobSystem->mNumQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				ExecuteJob(job);
+			}
+		}
+
+		if (numPushed > 0)
+		{
+			//@NOTE(Serge): taking the lock makes sure a worker that is about to sleep sees the new jobs before we notify
+			std::lock_guard<std::mutex> lock(s_optrJobSystem->mSleepMutex);
+		}
+
+		if (numPushed == 1)
+		{
+			s_optrJobSystem->mWakeCondition.notify_one();
+		}
+		else if (numPushed > 1)
+		{
+			s_optrJobSystem->mWakeCondition.notify_all();
+		}
+	}
+
+	void Submit(JobFunc func, void* data, JobCounter& counter)
+	{
+		Job job;
+		job.func = func;
+		job.data = data;
+
+		Submit(&job, 1, counter);
+	}
+
+	void WaitForCounter(JobCounter& counter)
+	{
+		R2_CHECK(s_optrJobSystem != nullptr, "We haven't initialized the job system yet!");
+
+		while (counter.value.load(std::memory_order_acquire) > 0)
+		{
+			if (!TryRunOneJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+}
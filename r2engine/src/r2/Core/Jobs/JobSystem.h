@@ -0,0 +1,119 @@
+#ifndef __JOB_SYSTEM_H__
+#define __JOB_SYSTEM_H__
+
+#include "r2/Core/Memory/Memory.h"
+#include "r2/Core/Memory/Allocators/StackAllocator.h"
+#include <atomic>
+
+namespace r2::jobs
+{
+	//Work stealing job system. Each thread (main thread + workers) owns a fixed size deque of jobs. A thread pushes and pops jobs
+	//from the bottom of its own deque and steals from the top of the other threads' deques when it runs out of work.
+	//
+	//Jobs can be submitted from the main thread or from inside of another job. Completion is tracked with a JobCounter which is
+	//decremented once a job has run. Waiting on a counter runs other jobs until the counter reaches 0 so it never blocks a worker.
+
+	using JobFunc = void (*)(void* data);
+
+	struct JobCounter
+	{
+		std::atomic<s32> value{ 0 };
+	};
+
+	struct Job
+	{
+		JobFunc func = nullptr;
+		void* data = nullptr;
+		JobCounter* counter = nullptr;
+	};
+
+	static const u32 MAX_NUM_JOB_WORKER_THREADS = 31;
+	static const u32 MAX_PARALLEL_FOR_BATCHES = 128;
+
+	bool Init(const r2::mem::MemoryArea::Handle memoryAreaHandle, u32 numWorkerThreads, u32 maxNumJobsPerThread, u64 scratchMemorySizePerThread);
+	void Shutdown();
+	bool IsInitialized();
+
+	u64 GetMemorySize(u32 numWorkerThreads, u32 maxNumJobsPerThread, u64 scratchMemorySizePerThread);
+
+	//The number of threads that run jobs including the main thread
+	u32 NumThreads();
+
+	//0 is the main thread, workers are 1 to NumThreads() - 1
+	u32 GetThreadIndex();
+
+	//Scratch memory for the calling thread. Only use it from the thread that owns it and free it in reverse order like any other StackArena
+	r2::mem::StackArena& GetThreadScratchArena();
+
+	void Submit(const Job* jobs, u32 numJobs, JobCounter& counter);
+	void Submit(JobFunc func, void* data, JobCounter& counter);
+
+	//Runs jobs on the calling thread until the counter reaches 0
+	void WaitForCounter(JobCounter& counter);
+
+	//func(u32 start, u32 end) is called for sub ranges of [0, count) across all of the threads. Returns once every range has been processed.
+	template<typename Func>
+	void ParallelFor(u32 count, u32 minBatchSize, const Func& func);
+}
+
+namespace r2::jobs
+{
+	template<typename Func>
+	void ParallelFor(u32 count, u32 minBatchSize, const Func& func)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (!IsInitialized())
+		{
+			func(0, count);
+			return;
+		}
+
+		struct Batch
+		{
+			const Func* func = nullptr;
+			u32 start = 0;
+			u32 end = 0;
+		};
+
+		const u32 maxNumBatches = std::min(NumThreads() * 4, MAX_PARALLEL_FOR_BATCHES);
+		const u32 batchSize = std::max(std::max(minBatchSize, 1u), (count + maxNumBatches - 1) / maxNumBatches);
+		const u32 numBatches = (count + batchSize - 1) / batchSize;
+
+		if (numBatches <= 1)
+		{
+			func(0, count);
+			return;
+		}
+
+		Batch batches[MAX_PARALLEL_FOR_BATCHES];
+		Job batchJobs[MAX_PARALLEL_FOR_BATCHES];
+
+		for (u32 i = 0; i < numBatches; ++i)
+		{
+			batches[i].func = &func;
+			batches[i].start = i * batchSize;
+			batches[i].end = std::min(count, batches[i].start + batchSize);
+
+			batchJobs[i].func = [](void* data)
+			{
+				const Batch* batch = static_cast<const Batch*>(data);
+				(*batch->func)(batch->start, batch->end);
+			};
+			batchJobs[i].data = &batches[i];
+		}
+
+		//the calling thread does the last batch itself instead of waiting for a worker to pick it up
+		JobCounter counter;
+		Submit(batchJobs, numBatches - 1, counter);
+
+		func(batches[numBatches - 1].start, batches[numBatches - 1].end);
+
+		WaitForCounter(counter);
+	}
+}
+
+#endif
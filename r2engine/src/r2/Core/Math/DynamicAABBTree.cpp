@@ -0,0 +1,708 @@
+#include "r2pch.h"
+#include "r2/Core/Math/DynamicAABBTree.h"
+
+namespace
+{
+	constexpr u32 NUM_SAH_BINS = 12;
+
+	struct SAHBin
+	{
+		r2::math::AABB aabb;
+		u32 count = 0;
+	};
+
+	r2::math::AABB EmptyAABB()
+	{
+		return { glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+	}
+
+	glm::vec3 Centroid(const r2::math::AABB& aabb)
+	{
+		return (aabb.minBounds + aabb.maxBounds) * 0.5f;
+	}
+}
+
+namespace r2::math
+{
+	DynamicAABBTree::DynamicAABBTree()
+		:mNodes(nullptr)
+		,mLeaves(nullptr)
+		,mTraversalStack(nullptr)
+		,mRoot(NULL_NODE)
+		,mFreeList(NULL_NODE)
+		,mNumProxies(0)
+		,mMaxNumProxies(0)
+	{
+	}
+
+	DynamicAABBTree::~DynamicAABBTree()
+	{
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		R2_CHECK(mNodes != nullptr, "We haven't initialized the DynamicAABBTree yet!");
+
+		r2::sarr::Fill(*mNodes, Node{});
+
+		const s32 numNodes = static_cast<s32>(r2::sarr::Size(*mNodes));
+
+		//chain all of the nodes into the free list
+		for (s32 i = 0; i < numNodes; ++i)
+		{
+			r2::sarr::At(*mNodes, i).parent = i + 1 < numNodes ? i + 1 : NULL_NODE;
+		}
+
+		mFreeList = 0;
+		mRoot = NULL_NODE;
+		mNumProxies = 0;
+	}
+
+	s32 DynamicAABBTree::CreateProxy(const AABB& aabb, u64 userData)
+	{
+		if (mNumProxies >= mMaxNumProxies)
+		{
+			return NULL_NODE;
+		}
+
+		const s32 proxyId = AllocateNode();
+
+		Node& node = r2::sarr::At(*mNodes, proxyId);
+		node.aabb.minBounds = aabb.minBounds - glm::vec3(AABB_MARGIN);
+		node.aabb.maxBounds = aabb.maxBounds + glm::vec3(AABB_MARGIN);
+		node.userData = userData;
+		node.height = 0;
+
+		InsertLeaf(proxyId);
+
+		++mNumProxies;
+
+		return proxyId;
+	}
+
+	void DynamicAABBTree::DestroyProxy(s32 proxyId)
+	{
+		R2_CHECK(proxyId >= 0 && proxyId < static_cast<s32>(r2::sarr::Size(*mNodes)), "Invalid proxy id: %i", proxyId);
+		R2_CHECK(r2::sarr::At(*mNodes, proxyId).IsLeaf() && r2::sarr::At(*mNodes, proxyId).height == 0, "proxyId: %i isn't a proxy", proxyId);
+
+		RemoveLeaf(proxyId);
+		FreeNode(proxyId);
+
+		--mNumProxies;
+	}
+
+	bool DynamicAABBTree::MoveProxy(s32 proxyId, const AABB& aabb, const glm::vec3& displacement)
+	{
+		R2_CHECK(proxyId >= 0 && proxyId < static_cast<s32>(r2::sarr::Size(*mNodes)), "Invalid proxy id: %i", proxyId);
+
+		Node& node = r2::sarr::At(*mNodes, proxyId);
+
+		R2_CHECK(node.IsLeaf() && node.height == 0, "proxyId: %i isn't a proxy", proxyId);
+
+		AABB fatAABB;
+		fatAABB.minBounds = aabb.minBounds - glm::vec3(AABB_MARGIN);
+		fatAABB.maxBounds = aabb.maxBounds + glm::vec3(AABB_MARGIN);
+
+		//predict where it's going so we don't have to reinsert it again next frame
+		const glm::vec3 d = displacement * AABB_DISPLACEMENT_MULTIPLIER;
+		fatAABB.minBounds += glm::min(d, glm::vec3(0.0f));
+		fatAABB.maxBounds += glm::max(d, glm::vec3(0.0f));
+
+		if (Contains(node.aabb, aabb))
+		{
+			//still inside of the fat AABB but it might have shrunk a lot (ie. it stopped moving) so don't let the fat AABB stay huge
+			AABB hugeAABB;
+			hugeAABB.minBounds = fatAABB.minBounds - glm::vec3(4.0f * AABB_MARGIN);
+			hugeAABB.maxBounds = fatAABB.maxBounds + glm::vec3(4.0f * AABB_MARGIN);
+
+			if (Contains(hugeAABB, node.aabb))
+			{
+				return false;
+			}
+		}
+
+		RemoveLeaf(proxyId);
+
+		node.aabb = fatAABB;
+
+		InsertLeaf(proxyId);
+
+		return true;
+	}
+
+	bool DynamicAABBTree::SetProxyAABB(s32 proxyId, const AABB& aabb)
+	{
+		R2_CHECK(proxyId >= 0 && proxyId < static_cast<s32>(r2::sarr::Size(*mNodes)), "Invalid proxy id: %i", proxyId);
+
+		Node& node = r2::sarr::At(*mNodes, proxyId);
+
+		R2_CHECK(node.IsLeaf() && node.height == 0, "proxyId: %i isn't a proxy", proxyId);
+
+		if (Contains(node.aabb, aabb))
+		{
+			return false;
+		}
+
+		node.aabb.minBounds = aabb.minBounds - glm::vec3(AABB_MARGIN);
+		node.aabb.maxBounds = aabb.maxBounds + glm::vec3(AABB_MARGIN);
+
+		return true;
+	}
+
+	void DynamicAABBTree::Refit()
+	{
+		if (mRoot == NULL_NODE)
+		{
+			return;
+		}
+
+		//post order traversal - a node is pushed once to visit its children and again (negated) to refit it after they're done
+		//@NOTE(Serge): each level down leaves 2 entries behind (the negated parent + the sibling) so this needs 2 * height + 1 entries.
+		//height <= numProxies - 1 so even a fully degenerate tree fits in MaxNumNodes - don't shrink mTraversalStack below that.
+		r2::SArray<s32>& stack = *mTraversalStack;
+		r2::sarr::Clear(stack);
+		r2::sarr::Push(stack, mRoot);
+
+		while (!r2::sarr::IsEmpty(stack))
+		{
+			const s32 entry = r2::sarr::Last(stack);
+			r2::sarr::Pop(stack);
+
+			if (entry < 0)
+			{
+				Node& node = r2::sarr::At(*mNodes, -entry - 1);
+				node.aabb = Union(r2::sarr::At(*mNodes, node.child1).aabb, r2::sarr::At(*mNodes, node.child2).aabb);
+				continue;
+			}
+
+			const Node& node = r2::sarr::At(*mNodes, entry);
+
+			if (node.IsLeaf())
+			{
+				continue;
+			}
+
+			r2::sarr::Push(stack, -entry - 1);
+			r2::sarr::Push(stack, node.child1);
+			r2::sarr::Push(stack, node.child2);
+		}
+	}
+
+	void DynamicAABBTree::Rebuild()
+	{
+		if (mRoot == NULL_NODE)
+		{
+			return;
+		}
+
+		//gather the leaves and free all of the internal nodes
+		r2::sarr::Clear(*mLeaves);
+
+		const s32 numNodes = static_cast<s32>(r2::sarr::Size(*mNodes));
+
+		for (s32 i = 0; i < numNodes; ++i)
+		{
+			Node& node = r2::sarr::At(*mNodes, i);
+
+			if (node.height < 0)
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				node.parent = NULL_NODE;
+				r2::sarr::Push(*mLeaves, i);
+			}
+			else
+			{
+				FreeNode(i);
+			}
+		}
+
+		mRoot = BuildSAH(0, static_cast<u32>(r2::sarr::Size(*mLeaves)));
+		r2::sarr::At(*mNodes, mRoot).parent = NULL_NODE;
+	}
+
+	u64 DynamicAABBTree::GetUserData(s32 proxyId) const
+	{
+		R2_CHECK(proxyId >= 0 && proxyId < static_cast<s32>(r2::sarr::Size(*mNodes)), "Invalid proxy id: %i", proxyId);
+		return r2::sarr::At(*mNodes, proxyId).userData;
+	}
+
+	const AABB& DynamicAABBTree::GetFatAABB(s32 proxyId) const
+	{
+		R2_CHECK(proxyId >= 0 && proxyId < static_cast<s32>(r2::sarr::Size(*mNodes)), "Invalid proxy id: %i", proxyId);
+		return r2::sarr::At(*mNodes, proxyId).aabb;
+	}
+
+	s32 DynamicAABBTree::GetHeight() const
+	{
+		if (mRoot == NULL_NODE)
+		{
+			return 0;
+		}
+
+		return r2::sarr::At(*mNodes, mRoot).height;
+	}
+
+	float DynamicAABBTree::GetAreaRatio() const
+	{
+		if (mRoot == NULL_NODE)
+		{
+			return 0.0f;
+		}
+
+		const float rootArea = SurfaceArea(r2::sarr::At(*mNodes, mRoot).aabb);
+
+		if (rootArea <= 0.0f)
+		{
+			return 0.0f;
+		}
+
+		float totalArea = 0.0f;
+
+		const u64 numNodes = r2::sarr::Size(*mNodes);
+
+		for (u64 i = 0; i < numNodes; ++i)
+		{
+			const Node& node = r2::sarr::At(*mNodes, i);
+
+			if (node.height <= 0)
+			{
+				continue;
+			}
+
+			totalArea += SurfaceArea(node.aabb);
+		}
+
+		return totalArea / rootArea;
+	}
+
+	s32 DynamicAABBTree::AllocateNode()
+	{
+		R2_CHECK(mFreeList != NULL_NODE, "We're out of nodes!");
+
+		const s32 nodeId = mFreeList;
+		Node& node = r2::sarr::At(*mNodes, nodeId);
+
+		mFreeList = node.parent;
+
+		node = Node{};
+		node.height = 0;
+
+		return nodeId;
+	}
+
+	void DynamicAABBTree::FreeNode(s32 nodeId)
+	{
+		Node& node = r2::sarr::At(*mNodes, nodeId);
+
+		node = Node{};
+		node.parent = mFreeList;
+
+		mFreeList = nodeId;
+	}
+
+	void DynamicAABBTree::InsertLeaf(s32 leaf)
+	{
+		if (mRoot == NULL_NODE)
+		{
+			mRoot = leaf;
+			r2::sarr::At(*mNodes, mRoot).parent = NULL_NODE;
+			return;
+		}
+
+		const AABB leafAABB = r2::sarr::At(*mNodes, leaf).aabb;
+
+		//Find the best sibling by walking down the cheaper side (SAH cost of making a new parent vs. pushing the leaf down)
+		s32 index = mRoot;
+
+		while (!r2::sarr::At(*mNodes, index).IsLeaf())
+		{
+			const Node& node = r2::sarr::At(*mNodes, index);
+
+			const float area = SurfaceArea(node.aabb);
+			const float combinedArea = SurfaceArea(Union(node.aabb, leafAABB));
+
+			//cost of creating a new parent for this node and the new leaf
+			const float cost = 2.0f * combinedArea;
+
+			//minimum cost of pushing the leaf further down the tree
+			const float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [this, &leafAABB, inheritanceCost](s32 childId)
+			{
+				const Node& child = r2::sarr::At(*mNodes, childId);
+				const float unionArea = SurfaceArea(Union(child.aabb, leafAABB));
+
+				if (child.IsLeaf())
+				{
+					return unionArea + inheritanceCost;
+				}
+
+				return (unionArea - SurfaceArea(child.aabb)) + inheritanceCost;
+			};
+
+			const float cost1 = descendCost(node.child1);
+			const float cost2 = descendCost(node.child2);
+
+			if (cost < cost1 && cost < cost2)
+			{
+				break;
+			}
+
+			index = cost1 < cost2 ? node.child1 : node.child2;
+		}
+
+		const s32 sibling = index;
+
+		const s32 oldParent = r2::sarr::At(*mNodes, sibling).parent;
+		const s32 newParent = AllocateNode();
+
+		{
+			Node& parentNode = r2::sarr::At(*mNodes, newParent);
+			const Node& siblingNode = r2::sarr::At(*mNodes, sibling);
+
+			parentNode.parent = oldParent;
+			parentNode.aabb = Union(leafAABB, siblingNode.aabb);
+			parentNode.height = siblingNode.height + 1;
+			parentNode.child1 = sibling;
+			parentNode.child2 = leaf;
+		}
+
+		if (oldParent != NULL_NODE)
+		{
+			Node& oldParentNode = r2::sarr::At(*mNodes, oldParent);
+
+			if (oldParentNode.child1 == sibling)
+			{
+				oldParentNode.child1 = newParent;
+			}
+			else
+			{
+				oldParentNode.child2 = newParent;
+			}
+		}
+		else
+		{
+			mRoot = newParent;
+		}
+
+		r2::sarr::At(*mNodes, sibling).parent = newParent;
+		r2::sarr::At(*mNodes, leaf).parent = newParent;
+
+		//walk back up fixing the heights and bounds
+		index = r2::sarr::At(*mNodes, leaf).parent;
+
+		while (index != NULL_NODE)
+		{
+			index = Balance(index);
+
+			Node& node = r2::sarr::At(*mNodes, index);
+			const Node& child1 = r2::sarr::At(*mNodes, node.child1);
+			const Node& child2 = r2::sarr::At(*mNodes, node.child2);
+
+			node.height = 1 + std::max(child1.height, child2.height);
+			node.aabb = Union(child1.aabb, child2.aabb);
+
+			index = node.parent;
+		}
+	}
+
+	void DynamicAABBTree::RemoveLeaf(s32 leaf)
+	{
+		if (leaf == mRoot)
+		{
+			mRoot = NULL_NODE;
+			return;
+		}
+
+		const s32 parent = r2::sarr::At(*mNodes, leaf).parent;
+		const Node& parentNode = r2::sarr::At(*mNodes, parent);
+		const s32 grandParent = parentNode.parent;
+		const s32 sibling = parentNode.child1 == leaf ? parentNode.child2 : parentNode.child1;
+
+		if (grandParent != NULL_NODE)
+		{
+			//connect the sibling to the grand parent and get rid of the parent
+			Node& grandParentNode = r2::sarr::At(*mNodes, grandParent);
+
+			if (grandParentNode.child1 == parent)
+			{
+				grandParentNode.child1 = sibling;
+			}
+			else
+			{
+				grandParentNode.child2 = sibling;
+			}
+
+			r2::sarr::At(*mNodes, sibling).parent = grandParent;
+			FreeNode(parent);
+
+			s32 index = grandParent;
+
+			while (index != NULL_NODE)
+			{
+				index = Balance(index);
+
+				Node& node = r2::sarr::At(*mNodes, index);
+				const Node& child1 = r2::sarr::At(*mNodes, node.child1);
+				const Node& child2 = r2::sarr::At(*mNodes, node.child2);
+
+				node.aabb = Union(child1.aabb, child2.aabb);
+				node.height = 1 + std::max(child1.height, child2.height);
+
+				index = node.parent;
+			}
+		}
+		else
+		{
+			mRoot = sibling;
+			r2::sarr::At(*mNodes, sibling).parent = NULL_NODE;
+			FreeNode(parent);
+		}
+
+		r2::sarr::At(*mNodes, leaf).parent = NULL_NODE;
+	}
+
+	s32 DynamicAABBTree::Balance(s32 iA)
+	{
+		Node* A = &r2::sarr::At(*mNodes, iA);
+
+		if (A->IsLeaf() || A->height < 2)
+		{
+			return iA;
+		}
+
+		const s32 iB = A->child1;
+		const s32 iC = A->child2;
+
+		Node* B = &r2::sarr::At(*mNodes, iB);
+		Node* C = &r2::sarr::At(*mNodes, iC);
+
+		const s32 balance = C->height - B->height;
+
+		//rotates "up" (the taller child of A) up to replace A
+		auto rotate = [this, iA, A](s32 iUp, Node* up, s32 iOther, Node* other)
+		{
+			const s32 iF = up->child1;
+			const s32 iG = up->child2;
+			Node* F = &r2::sarr::At(*mNodes, iF);
+			Node* G = &r2::sarr::At(*mNodes, iG);
+
+			//swap A and up
+			up->child1 = iA;
+			up->parent = A->parent;
+			A->parent = iUp;
+
+			if (up->parent != NULL_NODE)
+			{
+				Node& upParent = r2::sarr::At(*mNodes, up->parent);
+
+				if (upParent.child1 == iA)
+				{
+					upParent.child1 = iUp;
+				}
+				else
+				{
+					upParent.child2 = iUp;
+				}
+			}
+			else
+			{
+				mRoot = iUp;
+			}
+
+			const bool upWasChild2 = A->child2 == iUp;
+
+			//keep the taller of up's children under up and give the other one to A
+			s32 iKeep = iF;
+			s32 iGive = iG;
+			Node* keep = F;
+			Node* give = G;
+
+			if (F->height <= G->height)
+			{
+				iKeep = iG;
+				iGive = iF;
+				keep = G;
+				give = F;
+			}
+
+			up->child2 = iKeep;
+
+			if (upWasChild2)
+			{
+				A->child2 = iGive;
+			}
+			else
+			{
+				A->child1 = iGive;
+			}
+
+			give->parent = iA;
+
+			A->aabb = Union(other->aabb, give->aabb);
+			A->height = 1 + std::max(other->height, give->height);
+
+			up->aabb = Union(A->aabb, keep->aabb);
+			up->height = 1 + std::max(A->height, keep->height);
+		};
+
+		if (balance > 1)
+		{
+			rotate(iC, C, iB, B);
+			return iC;
+		}
+
+		if (balance < -1)
+		{
+			rotate(iB, B, iC, C);
+			return iB;
+		}
+
+		return iA;
+	}
+
+	s32 DynamicAABBTree::BuildSAH(u32 start, u32 end)
+	{
+		s32* leaves = r2::sarr::Begin(*mLeaves);
+
+		if (end - start == 1)
+		{
+			return leaves[start];
+		}
+
+		AABB centroidBounds = EmptyAABB();
+
+		for (u32 i = start; i < end; ++i)
+		{
+			const glm::vec3 c = Centroid(r2::sarr::At(*mNodes, leaves[i]).aabb);
+			centroidBounds.minBounds = glm::min(centroidBounds.minBounds, c);
+			centroidBounds.maxBounds = glm::max(centroidBounds.maxBounds, c);
+		}
+
+		const glm::vec3 centroidExtents = centroidBounds.maxBounds - centroidBounds.minBounds;
+
+		//find the cheapest split over all of the axes
+		float bestCost = FLT_MAX;
+		s32 bestAxis = -1;
+		u32 bestSplit = 0;
+
+		for (s32 axis = 0; axis < 3; ++axis)
+		{
+			if (centroidExtents[axis] <= 0.0f)
+			{
+				continue;
+			}
+
+			SAHBin bins[NUM_SAH_BINS];
+			for (u32 b = 0; b < NUM_SAH_BINS; ++b)
+			{
+				bins[b].aabb = EmptyAABB();
+			}
+
+			const float scale = static_cast<float>(NUM_SAH_BINS) / centroidExtents[axis];
+
+			for (u32 i = start; i < end; ++i)
+			{
+				const AABB& aabb = r2::sarr::At(*mNodes, leaves[i]).aabb;
+				const u32 b = std::min(NUM_SAH_BINS - 1, static_cast<u32>((Centroid(aabb)[axis] - centroidBounds.minBounds[axis]) * scale));
+
+				bins[b].aabb = Union(bins[b].aabb, aabb);
+				++bins[b].count;
+			}
+
+			//sweep from the right to get the cost of everything right of each split
+			float rightArea[NUM_SAH_BINS - 1];
+			u32 rightCount[NUM_SAH_BINS - 1];
+
+			AABB rightAABB = EmptyAABB();
+			u32 count = 0;
+
+			for (u32 b = NUM_SAH_BINS - 1; b > 0; --b)
+			{
+				rightAABB = Union(rightAABB, bins[b].aabb);
+				count += bins[b].count;
+
+				rightArea[b - 1] = count > 0 ? SurfaceArea(rightAABB) : 0.0f;
+				rightCount[b - 1] = count;
+			}
+
+			AABB leftAABB = EmptyAABB();
+			count = 0;
+
+			for (u32 b = 0; b < NUM_SAH_BINS - 1; ++b)
+			{
+				leftAABB = Union(leftAABB, bins[b].aabb);
+				count += bins[b].count;
+
+				if (count == 0 || rightCount[b] == 0)
+				{
+					continue;
+				}
+
+				const float cost = SurfaceArea(leftAABB) * count + rightArea[b] * rightCount[b];
+
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = b;
+				}
+			}
+		}
+
+		u32 mid = start + (end - start) / 2;
+
+		if (bestAxis != -1)
+		{
+			const float scale = static_cast<float>(NUM_SAH_BINS) / centroidExtents[bestAxis];
+			const float minBound = centroidBounds.minBounds[bestAxis];
+
+			const s32* splitPoint = std::partition(leaves + start, leaves + end, [this, bestAxis, bestSplit, scale, minBound](s32 leaf)
+			{
+				const glm::vec3 c = Centroid(r2::sarr::At(*mNodes, leaf).aabb);
+				return std::min(NUM_SAH_BINS - 1, static_cast<u32>((c[bestAxis] - minBound) * scale)) <= bestSplit;
+			});
+
+			mid = static_cast<u32>(splitPoint - leaves);
+		}
+
+		//all of the centroids are in the same place - just split them in half
+		if (mid == start || mid == end)
+		{
+			mid = start + (end - start) / 2;
+		}
+
+		const s32 child1 = BuildSAH(start, mid);
+		const s32 child2 = BuildSAH(mid, end);
+
+		const s32 nodeId = AllocateNode();
+
+		Node& node = r2::sarr::At(*mNodes, nodeId);
+		Node& child1Node = r2::sarr::At(*mNodes, child1);
+		Node& child2Node = r2::sarr::At(*mNodes, child2);
+
+		node.child1 = child1;
+		node.child2 = child2;
+		node.aabb = Union(child1Node.aabb, child2Node.aabb);
+		node.height = 1 + std::max(child1Node.height, child2Node.height);
+
+		child1Node.parent = nodeId;
+		child2Node.parent = nodeId;
+
+		return nodeId;
+	}
+
+	u64 DynamicAABBTree::MemorySize(u32 maxNumProxies, const r2::mem::utils::MemoryProperties& memProperties)
+	{
+		const u32 maxNumNodes = MaxNumNodes(maxNumProxies);
+
+		return
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Node>::MemorySize(maxNumNodes), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s32>::MemorySize(maxNumProxies), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s32>::MemorySize(maxNumNodes), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
+	}
+}
@@ -0,0 +1,399 @@
+#ifndef __DYNAMIC_AABB_TREE_H__
+#define __DYNAMIC_AABB_TREE_H__
+
+#define GLM_FORCE_INLINE
+#include <glm/glm.hpp>
+#include "r2/Core/Memory/Memory.h"
+#include "r2/Core/Containers/SArray.h"
+#include "r2/Core/Math/Frustum.h"
+#include "r2/Core/Math/Ray.h"
+
+namespace r2::math
+{
+	struct AABB
+	{
+		glm::vec3 minBounds = glm::vec3(0.0f);
+		glm::vec3 maxBounds = glm::vec3(0.0f);
+	};
+
+	inline AABB Union(const AABB& a, const AABB& b)
+	{
+		return { glm::min(a.minBounds, b.minBounds), glm::max(a.maxBounds, b.maxBounds) };
+	}
+
+	inline bool Contains(const AABB& outer, const AABB& inner)
+	{
+		return glm::all(glm::lessThanEqual(outer.minBounds, inner.minBounds)) && glm::all(glm::greaterThanEqual(outer.maxBounds, inner.maxBounds));
+	}
+
+	inline bool Overlaps(const AABB& a, const AABB& b)
+	{
+		return glm::all(glm::lessThanEqual(a.minBounds, b.maxBounds)) && glm::all(glm::greaterThanEqual(a.maxBounds, b.minBounds));
+	}
+
+	inline float SurfaceArea(const AABB& aabb)
+	{
+		const glm::vec3 d = aabb.maxBounds - aabb.minBounds;
+		return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+	}
+
+	//Dynamic bounding volume hierarchy (in the style of Box2D's b2DynamicTree) - every proxy is a leaf with a "fat" AABB
+	//so small movements don't change the tree at all. Internal nodes are kept balanced with AVL style rotations on insert/remove.
+	//
+	//There are two ways of updating proxies:
+	//	- MoveProxy removes and reinserts the leaf if it left its fat AABB. Best when only a few proxies move.
+	//	- SetProxyAABB just changes the leaf bounds and Refit fixes every internal node in one pass afterwards. Best when lots
+	//	  of proxies move at once, though the tree slowly gets worse so Rebuild (binned SAH) should be called when GetAreaRatio grows.
+	//
+	//Proxy ids are node indices and stay valid until DestroyProxy, even across Rebuild.
+	class DynamicAABBTree
+	{
+	public:
+		static constexpr s32 NULL_NODE = -1;
+
+		//How much the fat AABBs are grown by in each direction
+		static constexpr float AABB_MARGIN = 0.1f;
+		//How far ahead of a proxy's displacement the fat AABB is predicted
+		static constexpr float AABB_DISPLACEMENT_MULTIPLIER = 2.0f;
+
+		DynamicAABBTree();
+		~DynamicAABBTree();
+
+		template<class ARENA>
+		bool Init(ARENA& arena, u32 maxNumProxies)
+		{
+			const u32 maxNumNodes = MaxNumNodes(maxNumProxies);
+
+			mNodes = MAKE_SARRAY(arena, Node, maxNumNodes);
+			mLeaves = MAKE_SARRAY(arena, s32, maxNumProxies);
+			mTraversalStack = MAKE_SARRAY(arena, s32, maxNumNodes);
+
+			R2_CHECK(mNodes && mLeaves && mTraversalStack, "Couldn't allocate the DynamicAABBTree's data");
+
+			mMaxNumProxies = maxNumProxies;
+
+			Clear();
+
+			return true;
+		}
+
+		template<class ARENA>
+		void Shutdown(ARENA& arena)
+		{
+			FREE(mTraversalStack, arena);
+			FREE(mLeaves, arena);
+			FREE(mNodes, arena);
+
+			mTraversalStack = nullptr;
+			mLeaves = nullptr;
+			mNodes = nullptr;
+			mRoot = NULL_NODE;
+			mFreeList = NULL_NODE;
+			mNumProxies = 0;
+			mMaxNumProxies = 0;
+		}
+
+		//Removes every proxy
+		void Clear();
+
+		//Returns NULL_NODE if the tree is full
+		s32 CreateProxy(const AABB& aabb, u64 userData);
+		void DestroyProxy(s32 proxyId);
+
+		//Returns true if the proxy had to be reinserted. displacement is how far it moved this update and is used to predict the fat AABB.
+		bool MoveProxy(s32 proxyId, const AABB& aabb, const glm::vec3& displacement);
+
+		//Batch update - changes the leaf's bounds without touching the rest of the tree. Returns true if the bounds changed, in which case Refit must be called before querying.
+		bool SetProxyAABB(s32 proxyId, const AABB& aabb);
+
+		//Recomputes the bounds of every internal node bottom up
+		void Refit();
+
+		//Throws away the internal nodes and builds them again top down with a binned surface area heuristic
+		void Rebuild();
+
+		u64 GetUserData(s32 proxyId) const;
+		const AABB& GetFatAABB(s32 proxyId) const;
+
+		u32 GetNumProxies() const { return mNumProxies; }
+		u32 GetMaxNumProxies() const { return mMaxNumProxies; }
+		s32 GetHeight() const;
+
+		//Sum of the surface area of the internal nodes / surface area of the root. Lower is better - grows as Refit loosens the tree.
+		float GetAreaRatio() const;
+
+		//Every query's callback is bool(s32 proxyId) and returns false to stop the query early
+		template<typename Callback>
+		void QueryAABB(const AABB& aabb, Callback&& callback) const
+		{
+			Query([&aabb](const AABB& nodeAABB) { return Overlaps(nodeAABB, aabb); }, callback);
+		}
+
+		template<typename Callback>
+		void QuerySphere(const glm::vec3& center, float radius, Callback&& callback) const
+		{
+			const float radiusSquared = radius * radius;
+
+			Query([&center, radiusSquared](const AABB& nodeAABB)
+			{
+				const glm::vec3 closest = glm::clamp(center, nodeAABB.minBounds, nodeAABB.maxBounds);
+				const glm::vec3 d = closest - center;
+				return glm::dot(d, d) <= radiusSquared;
+			}, callback);
+		}
+
+		//Subtrees that are completely inside the frustum are reported without testing any more planes
+		template<typename Callback>
+		void QueryFrustum(const Frustum& frustum, Callback&& callback) const
+		{
+			if (mRoot == NULL_NODE)
+			{
+				return;
+			}
+
+			r2::SArray<s32>& stack = *mTraversalStack;
+			r2::sarr::Clear(stack);
+			r2::sarr::Push(stack, mRoot);
+
+			while (!r2::sarr::IsEmpty(stack))
+			{
+				const s32 nodeId = r2::sarr::Last(stack);
+				r2::sarr::Pop(stack);
+
+				const Node& node = r2::sarr::At(*mNodes, nodeId);
+
+				const glm::vec3 center = (node.aabb.minBounds + node.aabb.maxBounds) * 0.5f;
+				const glm::vec3 halfExtents = (node.aabb.maxBounds - node.aabb.minBounds) * 0.5f;
+
+				const FrustumContainment containment = ClassifyAABBInFrustum(frustum, center, halfExtents);
+
+				if (containment == FRUSTUM_OUTSIDE)
+				{
+					continue;
+				}
+
+				if (containment == FRUSTUM_INSIDE)
+				{
+					if (!ReportSubtree(nodeId, callback))
+					{
+						return;
+					}
+				}
+				else if (node.IsLeaf())
+				{
+					if (!callback(nodeId))
+					{
+						return;
+					}
+				}
+				else
+				{
+					r2::sarr::Push(stack, node.child1);
+					r2::sarr::Push(stack, node.child2);
+				}
+			}
+		}
+
+		//Callback is float(const Ray& ray, float maxDistance, s32 proxyId) and returns:
+		//	< 0 to ignore the proxy, 0 to stop the raycast, otherwise the new max distance (ie. the distance of a hit to only look for closer ones)
+		//Children are visited nearest first so closest hit queries can clip the rest of the tree quickly.
+		template<typename Callback>
+		void Raycast(const Ray& ray, float maxDistance, Callback&& callback) const
+		{
+			if (mRoot == NULL_NODE)
+			{
+				return;
+			}
+
+			const glm::vec3 invDir = InverseDirection(ray);
+
+			r2::SArray<s32>& stack = *mTraversalStack;
+			r2::sarr::Clear(stack);
+			r2::sarr::Push(stack, mRoot);
+
+			while (!r2::sarr::IsEmpty(stack))
+			{
+				const s32 nodeId = r2::sarr::Last(stack);
+				r2::sarr::Pop(stack);
+
+				const Node& node = r2::sarr::At(*mNodes, nodeId);
+
+				float tHit = 0.0f;
+				if (!RayAABBIntersection(ray, invDir, node.aabb.minBounds, node.aabb.maxBounds, maxDistance, tHit))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					const float value = callback(ray, maxDistance, nodeId);
+
+					if (value == 0.0f)
+					{
+						return;
+					}
+
+					if (value > 0.0f)
+					{
+						maxDistance = value;
+					}
+
+					continue;
+				}
+
+				const Node& child1 = r2::sarr::At(*mNodes, node.child1);
+				const Node& child2 = r2::sarr::At(*mNodes, node.child2);
+
+				float t1 = 0.0f;
+				float t2 = 0.0f;
+				const bool hit1 = RayAABBIntersection(ray, invDir, child1.aabb.minBounds, child1.aabb.maxBounds, maxDistance, t1);
+				const bool hit2 = RayAABBIntersection(ray, invDir, child2.aabb.minBounds, child2.aabb.maxBounds, maxDistance, t2);
+
+				//push the farther one first so the nearer one gets popped next
+				if (hit1 && hit2)
+				{
+					if (t1 <= t2)
+					{
+						r2::sarr::Push(stack, node.child2);
+						r2::sarr::Push(stack, node.child1);
+					}
+					else
+					{
+						r2::sarr::Push(stack, node.child1);
+						r2::sarr::Push(stack, node.child2);
+					}
+				}
+				else if (hit1)
+				{
+					r2::sarr::Push(stack, node.child1);
+				}
+				else if (hit2)
+				{
+					r2::sarr::Push(stack, node.child2);
+				}
+			}
+		}
+
+		static u32 MaxNumNodes(u32 maxNumProxies) { return maxNumProxies > 0 ? 2 * maxNumProxies - 1 : 1; }
+		static u64 MemorySize(u32 maxNumProxies, const r2::mem::utils::MemoryProperties& memProperties);
+
+	private:
+
+		struct Node
+		{
+			//fat AABB for leaves
+			AABB aabb;
+			u64 userData = 0;
+
+			//the next free node when the node is in the free list
+			s32 parent = NULL_NODE;
+			s32 child1 = NULL_NODE;
+			s32 child2 = NULL_NODE;
+
+			//leaves are 0, free nodes are -1
+			s32 height = -1;
+
+			bool IsLeaf() const { return child1 == NULL_NODE; }
+		};
+
+		//Generic traversal for the overlap queries - overlaps is bool(const AABB&)
+		template<typename OverlapTest, typename Callback>
+		void Query(OverlapTest&& overlaps, Callback& callback) const
+		{
+			if (mRoot == NULL_NODE)
+			{
+				return;
+			}
+
+			r2::SArray<s32>& stack = *mTraversalStack;
+			r2::sarr::Clear(stack);
+			r2::sarr::Push(stack, mRoot);
+
+			while (!r2::sarr::IsEmpty(stack))
+			{
+				const s32 nodeId = r2::sarr::Last(stack);
+				r2::sarr::Pop(stack);
+
+				const Node& node = r2::sarr::At(*mNodes, nodeId);
+
+				if (!overlaps(node.aabb))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					if (!callback(nodeId))
+					{
+						return;
+					}
+				}
+				else
+				{
+					r2::sarr::Push(stack, node.child1);
+					r2::sarr::Push(stack, node.child2);
+				}
+			}
+		}
+
+		//Reports every leaf under nodeId. Uses the top of the traversal stack so it can be called in the middle of a traversal.
+		template<typename Callback>
+		bool ReportSubtree(s32 nodeId, Callback& callback) const
+		{
+			r2::SArray<s32>& stack = *mTraversalStack;
+			const u64 base = r2::sarr::Size(stack);
+
+			r2::sarr::Push(stack, nodeId);
+
+			while (r2::sarr::Size(stack) > base)
+			{
+				const s32 id = r2::sarr::Last(stack);
+				r2::sarr::Pop(stack);
+
+				const Node& node = r2::sarr::At(*mNodes, id);
+
+				if (node.IsLeaf())
+				{
+					if (!callback(id))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					r2::sarr::Push(stack, node.child1);
+					r2::sarr::Push(stack, node.child2);
+				}
+			}
+
+			return true;
+		}
+
+		s32 AllocateNode();
+		void FreeNode(s32 nodeId);
+
+		void InsertLeaf(s32 leaf);
+		void RemoveLeaf(s32 leaf);
+
+		//Rotates nodeId's children if they're unbalanced and returns the new root of the subtree
+		s32 Balance(s32 nodeId);
+
+		//Builds a subtree over leaves[start, end) and returns its root
+		s32 BuildSAH(u32 start, u32 end);
+
+		r2::SArray<Node>* mNodes;
+
+		//scratch space for Rebuild
+		r2::SArray<s32>* mLeaves;
+
+		//@NOTE(Serge): shared by all of the queries so they can't be called from more than one thread at a time
+		r2::SArray<s32>* mTraversalStack;
+
+		s32 mRoot;
+		s32 mFreeList;
+		u32 mNumProxies;
+		u32 mMaxNumProxies;
+	};
+}
+
+#endif // __DYNAMIC_AABB_TREE_H__
@@ -0,0 +1,144 @@
+#include "r2pch.h"
+#include "r2/Core/Math/Frustum.h"
+
+namespace r2::math
+{
+	void NormalizePlane(Plane& plane)
+	{
+		const float length = glm::length(plane.normal);
+
+		if (length > 0.0f)
+		{
+			plane.normal /= length;
+			plane.distance /= length;
+		}
+	}
+
+	float SignedDistance(const Plane& plane, const glm::vec3& p)
+	{
+		return glm::dot(plane.normal, p) + plane.distance;
+	}
+
+	void ExtractFrustumPlanes(const glm::mat4& m, Frustum& frustum)
+	{
+		//glm is column major so m[col][row]
+		const glm::vec4 row0 = glm::vec4(m[0][0], m[1][0], m[2][0], m[3][0]);
+		const glm::vec4 row1 = glm::vec4(m[0][1], m[1][1], m[2][1], m[3][1]);
+		const glm::vec4 row2 = glm::vec4(m[0][2], m[1][2], m[2][2], m[3][2]);
+		const glm::vec4 row3 = glm::vec4(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+		const glm::vec4 planes[NUM_FRUSTUM_PLANES] =
+		{
+			row3 + row0,
+			row3 - row0,
+			row3 + row1,
+			row3 - row1,
+			row3 + row2,
+			row3 - row2
+		};
+
+		for (u32 i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+		{
+			frustum.planes[i].normal = glm::vec3(planes[i]);
+			frustum.planes[i].distance = planes[i].w;
+			NormalizePlane(frustum.planes[i]);
+		}
+	}
+
+	Frustum CreateFrustum(const glm::mat4& viewProj)
+	{
+		Frustum frustum;
+		ExtractFrustumPlanes(viewProj, frustum);
+		return frustum;
+	}
+
+	bool SphereInFrustum(const Frustum& frustum, const glm::vec3& center, float radius)
+	{
+		for (u32 i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+		{
+			if (SignedDistance(frustum.planes[i], center) < -radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool AABBInFrustum(const Frustum& frustum, const glm::vec3& center, const glm::vec3& halfExtents)
+	{
+		for (u32 i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+		{
+			const Plane& plane = frustum.planes[i];
+
+			//projected "radius" of the box onto the plane normal
+			const float r = halfExtents.x * fabsf(plane.normal.x) + halfExtents.y * fabsf(plane.normal.y) + halfExtents.z * fabsf(plane.normal.z);
+
+			if (SignedDistance(plane, center) < -r)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	FrustumContainment ClassifyAABBInFrustum(const Frustum& frustum, const glm::vec3& center, const glm::vec3& halfExtents)
+	{
+		FrustumContainment result = FRUSTUM_INSIDE;
+
+		for (u32 i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+		{
+			const Plane& plane = frustum.planes[i];
+
+			const float r = halfExtents.x * fabsf(plane.normal.x) + halfExtents.y * fabsf(plane.normal.y) + halfExtents.z * fabsf(plane.normal.z);
+			const float distance = SignedDistance(plane, center);
+
+			if (distance < -r)
+			{
+				return FRUSTUM_OUTSIDE;
+			}
+
+			if (distance < r)
+			{
+				result = FRUSTUM_INTERSECTS;
+			}
+		}
+
+		return result;
+	}
+
+	bool SweptSphereInFrustum(const Frustum& frustum, const glm::vec3& center, float radius, const glm::vec3& sweepDir)
+	{
+		for (u32 i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+		{
+			const Plane& plane = frustum.planes[i];
+
+			//only culled if it's outside of the plane and the sweep moves it further away from the plane
+			if (SignedDistance(plane, center) < -radius && glm::dot(plane.normal, sweepDir) <= 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void TransformAABB(const glm::mat4& mat, const glm::vec3& localCenter, const glm::vec3& localHalfExtents, glm::vec3& worldCenter, glm::vec3& worldHalfExtents)
+	{
+		worldCenter = glm::vec3(mat * glm::vec4(localCenter, 1.0f));
+
+		const glm::mat3 absMat = glm::mat3(glm::abs(glm::vec3(mat[0])), glm::abs(glm::vec3(mat[1])), glm::abs(glm::vec3(mat[2])));
+
+		worldHalfExtents = absMat * localHalfExtents;
+	}
+
+	float MaxScale(const glm::mat4& mat)
+	{
+		const float sx = glm::dot(glm::vec3(mat[0]), glm::vec3(mat[0]));
+		const float sy = glm::dot(glm::vec3(mat[1]), glm::vec3(mat[1]));
+		const float sz = glm::dot(glm::vec3(mat[2]), glm::vec3(mat[2]));
+
+		return sqrtf(glm::max(sx, glm::max(sy, sz)));
+	}
+}
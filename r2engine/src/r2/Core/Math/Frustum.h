@@ -0,0 +1,62 @@
+#ifndef __FRUSTUM_H__
+#define __FRUSTUM_H__
+
+#define GLM_FORCE_INLINE 
+#include <glm/glm.hpp>
+#include "r2/Utils/Utils.h"
+
+namespace r2::math
+{
+	//Plane in the form dot(normal, p) + distance = 0 with the normal pointing to the "inside" half space
+	struct Plane
+	{
+		glm::vec3 normal = glm::vec3(0.0f);
+		float distance = 0.0f;
+	};
+
+	enum FrustumPlane : u32
+	{
+		FRUSTUM_PLANE_LEFT = 0,
+		FRUSTUM_PLANE_RIGHT,
+		FRUSTUM_PLANE_BOTTOM,
+		FRUSTUM_PLANE_TOP,
+		FRUSTUM_PLANE_NEAR,
+		FRUSTUM_PLANE_FAR,
+		NUM_FRUSTUM_PLANES
+	};
+
+	struct Frustum
+	{
+		Plane planes[NUM_FRUSTUM_PLANES];
+	};
+
+	enum FrustumContainment : u32
+	{
+		FRUSTUM_OUTSIDE = 0,
+		FRUSTUM_INTERSECTS,
+		FRUSTUM_INSIDE
+	};
+
+	float SignedDistance(const Plane& plane, const glm::vec3& p);
+
+	//Gribb/Hartmann plane extraction - works for any projection * view matrix (OpenGL clip space)
+	void ExtractFrustumPlanes(const glm::mat4& viewProj, Frustum& frustum);
+	Frustum CreateFrustum(const glm::mat4& viewProj);
+
+	bool SphereInFrustum(const Frustum& frustum, const glm::vec3& center, float radius);
+	bool AABBInFrustum(const Frustum& frustum, const glm::vec3& center, const glm::vec3& halfExtents);
+
+	//Like AABBInFrustum but also tells us if the box is completely inside so hierarchies can skip testing everything under it
+	FrustumContainment ClassifyAABBInFrustum(const Frustum& frustum, const glm::vec3& center, const glm::vec3& halfExtents);
+
+	//True if the sphere moved along sweepDir (normalized, to infinity) touches the frustum. Used for shadow casters.
+	bool SweptSphereInFrustum(const Frustum& frustum, const glm::vec3& center, float radius, const glm::vec3& sweepDir);
+
+	//Transforms a local space AABB (center + half extents) by an affine matrix into a world space AABB
+	void TransformAABB(const glm::mat4& mat, const glm::vec3& localCenter, const glm::vec3& localHalfExtents, glm::vec3& worldCenter, glm::vec3& worldHalfExtents);
+
+	//Returns the largest axis scale of an affine matrix - used to scale bounding sphere radii
+	float MaxScale(const glm::mat4& mat);
+}
+
+#endif // __FRUSTUM_H__
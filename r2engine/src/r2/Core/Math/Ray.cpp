@@ -17,4 +17,37 @@ namespace r2::math
         aRay.direction = dir;
         return aRay;
     }
+    
+    glm::vec3 InverseDirection(const Ray& ray)
+    {
+        //division by 0 gives +/- infinity which the slab test handles correctly
+        return glm::vec3(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+    }
+    
+    bool RayAABBIntersection(const Ray& ray, const glm::vec3& invDir, const glm::vec3& minBounds, const glm::vec3& maxBounds, float maxDistance, float& tHit)
+    {
+        const glm::vec3 t0 = (minBounds - ray.origin) * invDir;
+        const glm::vec3 t1 = (maxBounds - ray.origin) * invDir;
+        
+        const glm::vec3 tNear = glm::min(t0, t1);
+        const glm::vec3 tFar = glm::max(t0, t1);
+        
+        //NaNs (0 * infinity when the origin is on a slab) fall through the comparisons below and are treated as not clipping
+        float tEnter = 0.0f;
+        float tExit = maxDistance;
+        
+        for (int i = 0; i < 3; ++i)
+        {
+            if (tNear[i] > tEnter) tEnter = tNear[i];
+            if (tFar[i] < tExit) tExit = tFar[i];
+        }
+        
+        if (tEnter > tExit)
+        {
+            return false;
+        }
+        
+        tHit = tEnter;
+        return true;
+    }
 }
@@ -21,6 +21,13 @@ namespace r2::math
     
     Ray CreateRay(const glm::vec3& origin, const glm::vec3& dir);
     
+    //1 / direction - computed once per ray so each box test is just multiplies
+    glm::vec3 InverseDirection(const Ray& ray);
+    
+    //Slab test against the box [minBounds, maxBounds]. Returns true if the ray hits it within [0, maxDistance] and sets tHit to the entry distance
+    //(0 if the origin is inside the box). maxDistance is in units of the ray's direction so it's world units for a normalized direction.
+    bool RayAABBIntersection(const Ray& ray, const glm::vec3& invDir, const glm::vec3& minBounds, const glm::vec3& maxBounds, float maxDistance, float& tHit);
+    
 }
 
 #endif /* Ray_h */
@@ -3,6 +3,68 @@
 #include "r2/Core/Math/MathUtils.h"
 #include "glm/gtc/type_ptr.hpp"
 #include "glm/gtx/matrix_decompose.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define R2_MATH_SSE
+#endif
+
+namespace
+{
+	//4 wide lanes used by Combine4/ToMatrix4 - each lane is a different transform
+#ifdef R2_MATH_SSE
+	using float4 = __m128;
+
+	inline float4 Set4(float a, float b, float c, float d) { return _mm_set_ps(d, c, b, a); }
+	inline void Store4(float* p, float4 v) { _mm_storeu_ps(p, v); }
+	inline float4 Splat4(float f) { return _mm_set1_ps(f); }
+	inline float4 Add4(float4 a, float4 b) { return _mm_add_ps(a, b); }
+	inline float4 Sub4(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+	inline float4 Mul4(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+#else
+	struct float4
+	{
+		float v[4];
+	};
+
+	inline float4 Set4(float a, float b, float c, float d) { return { a, b, c, d }; }
+	inline void Store4(float* p, float4 a) { for (u32 i = 0; i < 4; ++i) p[i] = a.v[i]; }
+	inline float4 Splat4(float f) { return { f, f, f, f }; }
+	inline float4 Add4(float4 a, float4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+	inline float4 Sub4(float4 a, float4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+	inline float4 Mul4(float4 a, float4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+#endif
+
+	struct Transform4
+	{
+		float4 px, py, pz;
+		float4 sx, sy, sz;
+		float4 qx, qy, qz, qw;
+	};
+
+	//lanes past count repeat the first transform so we never read garbage
+	inline Transform4 LoadTransform4(const r2::math::Transform* const t[4], u32 count)
+	{
+		const r2::math::Transform& t0 = *t[0];
+		const r2::math::Transform& t1 = count > 1 ? *t[1] : t0;
+		const r2::math::Transform& t2 = count > 2 ? *t[2] : t0;
+		const r2::math::Transform& t3 = count > 3 ? *t[3] : t0;
+
+		Transform4 r;
+		r.px = Set4(t0.position.x, t1.position.x, t2.position.x, t3.position.x);
+		r.py = Set4(t0.position.y, t1.position.y, t2.position.y, t3.position.y);
+		r.pz = Set4(t0.position.z, t1.position.z, t2.position.z, t3.position.z);
+		r.sx = Set4(t0.scale.x, t1.scale.x, t2.scale.x, t3.scale.x);
+		r.sy = Set4(t0.scale.y, t1.scale.y, t2.scale.y, t3.scale.y);
+		r.sz = Set4(t0.scale.z, t1.scale.z, t2.scale.z, t3.scale.z);
+		r.qx = Set4(t0.rotation.x, t1.rotation.x, t2.rotation.x, t3.rotation.x);
+		r.qy = Set4(t0.rotation.y, t1.rotation.y, t2.rotation.y, t3.rotation.y);
+		r.qz = Set4(t0.rotation.z, t1.rotation.z, t2.rotation.z, t3.rotation.z);
+		r.qw = Set4(t0.rotation.w, t1.rotation.w, t2.rotation.w, t3.rotation.w);
+		return r;
+	}
+}
+
 namespace r2::math
 {
 	inline glm::quat QuatMult(const glm::quat& Q1, const glm::quat& Q2)
@@ -278,6 +340,99 @@ namespace r2::math
 		return out;
 	}
 
+	void Combine4(const Transform* const a[4], const Transform* const b[4], Transform* const r[4], u32 count)
+	{
+		R2_CHECK(count > 0 && count <= 4, "count should be between 1 and 4");
+
+		const Transform4 ta = LoadTransform4(a, count);
+		const Transform4 tb = LoadTransform4(b, count);
+
+		//scale
+		const float4 sx = Mul4(ta.sx, tb.sx);
+		const float4 sy = Mul4(ta.sy, tb.sy);
+		const float4 sz = Mul4(ta.sz, tb.sz);
+
+		//rotation = QuatMult(b.rotation, a.rotation)
+		const float4 qx = Add4(Sub4(Add4(Mul4(ta.qx, tb.qw), Mul4(ta.qy, tb.qz)), Mul4(ta.qz, tb.qy)), Mul4(ta.qw, tb.qx));
+		const float4 qy = Add4(Add4(Sub4(Mul4(ta.qy, tb.qw), Mul4(ta.qx, tb.qz)), Mul4(ta.qz, tb.qx)), Mul4(ta.qw, tb.qy));
+		const float4 qz = Add4(Add4(Sub4(Mul4(ta.qx, tb.qy), Mul4(ta.qy, tb.qx)), Mul4(ta.qz, tb.qw)), Mul4(ta.qw, tb.qz));
+		const float4 qw = Sub4(Sub4(Sub4(Mul4(ta.qw, tb.qw), Mul4(ta.qx, tb.qx)), Mul4(ta.qy, tb.qy)), Mul4(ta.qz, tb.qz));
+
+		//position = a.position + QuatMult(a.rotation, b.position * a.scale)
+		const float4 vx = Mul4(tb.px, ta.sx);
+		const float4 vy = Mul4(tb.py, ta.sy);
+		const float4 vz = Mul4(tb.pz, ta.sz);
+
+		const float4 two = Splat4(2.0f);
+		const float4 tx = Mul4(two, Sub4(Mul4(ta.qy, vz), Mul4(ta.qz, vy)));
+		const float4 ty = Mul4(two, Sub4(Mul4(ta.qz, vx), Mul4(ta.qx, vz)));
+		const float4 tz = Mul4(two, Sub4(Mul4(ta.qx, vy), Mul4(ta.qy, vx)));
+
+		const float4 px = Add4(ta.px, Add4(Add4(vx, Mul4(ta.qw, tx)), Sub4(Mul4(ta.qy, tz), Mul4(ta.qz, ty))));
+		const float4 py = Add4(ta.py, Add4(Add4(vy, Mul4(ta.qw, ty)), Sub4(Mul4(ta.qz, tx), Mul4(ta.qx, tz))));
+		const float4 pz = Add4(ta.pz, Add4(Add4(vz, Mul4(ta.qw, tz)), Sub4(Mul4(ta.qx, ty), Mul4(ta.qy, tx))));
+
+		float lanes[10][4];
+		Store4(lanes[0], px); Store4(lanes[1], py); Store4(lanes[2], pz);
+		Store4(lanes[3], sx); Store4(lanes[4], sy); Store4(lanes[5], sz);
+		Store4(lanes[6], qx); Store4(lanes[7], qy); Store4(lanes[8], qz); Store4(lanes[9], qw);
+
+		for (u32 i = 0; i < count; ++i)
+		{
+			Transform& out = *r[i];
+			out.position = glm::vec3(lanes[0][i], lanes[1][i], lanes[2][i]);
+			out.scale = glm::vec3(lanes[3][i], lanes[4][i], lanes[5][i]);
+			out.rotation = glm::quat(lanes[9][i], lanes[6][i], lanes[7][i], lanes[8][i]);
+		}
+	}
+
+	void ToMatrix4(const Transform* const t[4], glm::mat4* const m[4], u32 count)
+	{
+		R2_CHECK(count > 0 && count <= 4, "count should be between 1 and 4");
+
+		const Transform4 tt = LoadTransform4(t, count);
+
+		const float4 one = Splat4(1.0f);
+		const float4 two = Splat4(2.0f);
+
+		const float4 xx = Mul4(tt.qx, tt.qx);
+		const float4 yy = Mul4(tt.qy, tt.qy);
+		const float4 zz = Mul4(tt.qz, tt.qz);
+		const float4 xy = Mul4(tt.qx, tt.qy);
+		const float4 xz = Mul4(tt.qx, tt.qz);
+		const float4 yz = Mul4(tt.qy, tt.qz);
+		const float4 wx = Mul4(tt.qw, tt.qx);
+		const float4 wy = Mul4(tt.qw, tt.qy);
+		const float4 wz = Mul4(tt.qw, tt.qz);
+
+		//same as rotating each axis with QuatMult then scaling it
+		float lanes[12][4];
+		Store4(lanes[0], Mul4(tt.sx, Sub4(one, Mul4(two, Add4(yy, zz)))));
+		Store4(lanes[1], Mul4(tt.sx, Mul4(two, Add4(xy, wz))));
+		Store4(lanes[2], Mul4(tt.sx, Mul4(two, Sub4(xz, wy))));
+
+		Store4(lanes[3], Mul4(tt.sy, Mul4(two, Sub4(xy, wz))));
+		Store4(lanes[4], Mul4(tt.sy, Sub4(one, Mul4(two, Add4(xx, zz)))));
+		Store4(lanes[5], Mul4(tt.sy, Mul4(two, Add4(yz, wx))));
+
+		Store4(lanes[6], Mul4(tt.sz, Mul4(two, Add4(xz, wy))));
+		Store4(lanes[7], Mul4(tt.sz, Mul4(two, Sub4(yz, wx))));
+		Store4(lanes[8], Mul4(tt.sz, Sub4(one, Mul4(two, Add4(xx, yy)))));
+
+		Store4(lanes[9], tt.px);
+		Store4(lanes[10], tt.py);
+		Store4(lanes[11], tt.pz);
+
+		for (u32 i = 0; i < count; ++i)
+		{
+			*m[i] = glm::mat4(
+				glm::vec4(lanes[0][i], lanes[1][i], lanes[2][i], 0.0f),
+				glm::vec4(lanes[3][i], lanes[4][i], lanes[5][i], 0.0f),
+				glm::vec4(lanes[6][i], lanes[7][i], lanes[8][i], 0.0f),
+				glm::vec4(lanes[9][i], lanes[10][i], lanes[11][i], 1.0f));
+		}
+	}
+
 #ifdef R2_DEBUG
 	void PrintTransform(const Transform& t)
 	{
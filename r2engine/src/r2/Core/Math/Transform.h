@@ -4,6 +4,7 @@
 #define GLM_FORCE_INLINE 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include "r2/Utils/Utils.h"
 
 
 namespace r2::math
@@ -24,6 +25,11 @@ namespace r2::math
 	glm::mat4 ToMatrix(const Transform& t);
 	Transform ToTransform(const glm::mat4& m);
 
+	//Same as Combine/ToMatrix but does count (1 to 4) transforms at once with SSE. The transforms don't need to be contiguous
+	//so these can be run on transforms inside of components.
+	void Combine4(const Transform* const a[4], const Transform* const b[4], Transform* const r[4], u32 count);
+	void ToMatrix4(const Transform* const t[4], glm::mat4* const m[4], u32 count);
+
 #ifdef R2_DEBUG
 	void PrintTransform(const Transform& t);
 #endif
@@ -138,6 +138,40 @@ namespace r2::mem
         return mTotalSize - mUsed;
     }
     
+    u64 FreeListAllocator::LargestFreeBlockSize() const
+    {
+        u64 largestBlockSize = 0;
+
+        for (const Node* it = mFreeList.head; it != nullptr; it = it->next)
+        {
+            largestBlockSize = std::max(largestBlockSize, static_cast<u64>(it->data.blockSize));
+        }
+
+        return largestBlockSize;
+    }
+
+    u64 FreeListAllocator::FreeBlockSizeAfterFree(void* memPtr) const
+    {
+        //Same block Free() would give back to the free list
+        const size_t headerAddress = (size_t)memPtr - sizeof(FreeListAllocator::AllocationHeader);
+        const FreeListAllocator::AllocationHeader* allocationHeader{ (FreeListAllocator::AllocationHeader*)headerAddress };
+
+        const size_t blockStart = headerAddress;
+        const size_t blockSize = allocationHeader->blockSize + allocationHeader->padding;
+
+        u64 freeBlockSize = blockSize;
+
+        for (const Node* it = mFreeList.head; it != nullptr && (size_t)it <= blockStart + blockSize; it = it->next)
+        {
+            if ((size_t)it + it->data.blockSize == blockStart || (size_t)it == blockStart + blockSize)
+            {
+                freeBlockSize += it->data.blockSize;
+            }
+        }
+
+        return freeBlockSize;
+    }
+    
     void FreeListAllocator::Coalescence(Node* previousNode, Node* freeNode)
     {
         if (freeNode->next != nullptr &&
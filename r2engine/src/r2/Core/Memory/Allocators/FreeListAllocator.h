@@ -23,6 +23,8 @@
 
 #define MAKE_FREELIST_ARENA(arena, capacity, policy) r2::mem::utils::CreateFreeListArena(arena, capacity, policy, __FILE__, __LINE__, "")
 
+#define MAKE_MT_FREELIST_ARENA(arena, capacity, policy) r2::mem::utils::CreateMTFreeListArena(arena, capacity, policy, __FILE__, __LINE__, "")
+
 #define EMPLACE_FREELIST_ARENA(subarea, policy) r2::mem::utils::EmplaceFreeListArena(subarea, policy, __FILE__, __LINE__, "")
 
 namespace r2::mem
@@ -57,6 +59,11 @@ namespace r2::mem
         inline const void* StartPtr() const {return mStart;}
         static u32 HeaderSize();
         u64 UnallocatedBytes() const;
+
+        //Fragmentation queries - both walk the free list
+        u64 LargestFreeBlockSize() const;
+        //The size of the contiguous free block we would get if memPtr was freed (including the free blocks on either side of it)
+        u64 FreeBlockSizeAfterFree(void* memPtr) const;
         
     private:
         
@@ -79,8 +86,10 @@ namespace r2::mem
     
 #if defined(R2_DEBUG) || defined(R2_RELEASE)
     typedef MemoryArena<FreeListAllocator, SingleThreadPolicy, BasicBoundsChecking, BasicMemoryTracking, BasicMemoryTagging> FreeListArena;
+    typedef MemoryArena<FreeListAllocator, MutexThreadPolicy, BasicBoundsChecking, BasicMemoryTracking, BasicMemoryTagging> MTFreeListArena;
 #else
     typedef MemoryArena<FreeListAllocator, SingleThreadPolicy, NoBoundsChecking, NoMemoryTracking, NoMemoryTagging> FreeListArena;
+    typedef MemoryArena<FreeListAllocator, MutexThreadPolicy, NoBoundsChecking, NoMemoryTracking, NoMemoryTagging> MTFreeListArena;
 #endif
 }
 
@@ -89,6 +98,8 @@ namespace r2::mem::utils
     template<class ARENA> r2::mem::FreeListAllocator* CreateFreeListAllocator(ARENA& arena, PlacementPolicy policy, u64 capacity, const char* file, s32 line, const char* description);
     
     template<class ARENA> r2::mem::FreeListArena* CreateFreeListArena(ARENA& arena, u64 capacity, PlacementPolicy policy, const char* file, s32 line, const char* description);
+
+    template<class ARENA> r2::mem::MTFreeListArena* CreateMTFreeListArena(ARENA& arena, u64 capacity, PlacementPolicy policy, const char* file, s32 line, const char* description);
     
     FreeListArena* EmplaceFreeListArena(MemoryArea::SubArea& subArea, PlacementPolicy policy, const char* file, s32 line, const char* description);
 }
@@ -134,6 +145,26 @@ namespace r2::mem::utils
         
         return freeListArena;
     }
+
+    template<class ARENA> r2::mem::MTFreeListArena* CreateMTFreeListArena(ARENA& arena, u64 capacity, PlacementPolicy policy, const char* file, s32 line, const char* description)
+    {
+        void* freeListArenaStartPtr = ALLOC_BYTES(arena, sizeof(MTFreeListArena) + capacity, CPLAT.CPUCacheLineSize(), file, line, description);
+
+        R2_CHECK(freeListArenaStartPtr != nullptr, "We shouldn't have null pool!");
+
+        void* boundaryStart = r2::mem::utils::PointerAdd(freeListArenaStartPtr, sizeof(MTFreeListArena));
+
+        utils::MemBoundary boundary;
+        boundary.location = boundaryStart;
+        boundary.size = capacity;
+        boundary.policy = policy;
+
+        MTFreeListArena* freeListArena = new (freeListArenaStartPtr) MTFreeListArena(boundary);
+
+        R2_CHECK(freeListArena != nullptr, "Couldn't placement new?");
+
+        return freeListArena;
+    }
 }
 
 #endif /* FreeListAllocator_h */
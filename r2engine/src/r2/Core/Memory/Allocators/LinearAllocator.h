@@ -20,6 +20,8 @@
 
 #define MAKE_LINEAR_ARENA(arena, capacity) r2::mem::utils::CreateLinearArena(arena, capacity, __FILE__, __LINE__, "")
 
+#define MAKE_MT_LINEAR_ARENA(arena, capacity) r2::mem::utils::CreateMTLinearArena(arena, capacity, __FILE__, __LINE__, "")
+
 #define EMPLACE_LINEAR_ARENA(subarea) r2::mem::utils::EmplaceLinearArena(subarea, __FILE__, __LINE__, "")
 
 #define EMPLACE_LINEAR_ARENA_IN_BOUNDARY(boundary) r2::mem::utils::EmplaceLinearArenaInMemoryBoundary(boundary, __FILE__, __LINE__, "")
@@ -56,8 +58,10 @@ namespace r2
         //@TODO(Serge): Add in more verbose tracking etc
 #if defined(R2_DEBUG) || defined(R2_RELEASE)
         typedef MemoryArena<LinearAllocator, SingleThreadPolicy, BasicBoundsChecking, BasicMemoryTracking, BasicMemoryTagging> LinearArena;
+        typedef MemoryArena<LinearAllocator, SpinLockThreadPolicy, BasicBoundsChecking, BasicMemoryTracking, BasicMemoryTagging> MTLinearArena;
 #else
         typedef MemoryArena<LinearAllocator, SingleThreadPolicy, NoBoundsChecking, NoMemoryTracking, NoMemoryTagging> LinearArena;
+        typedef MemoryArena<LinearAllocator, SpinLockThreadPolicy, NoBoundsChecking, NoMemoryTracking, NoMemoryTagging> MTLinearArena;
 #endif
     }
 }
@@ -67,6 +71,8 @@ namespace r2::mem::utils
     template<class ARENA> r2::mem::LinearAllocator* CreateLinearAllocator(ARENA& arena, u64 capacity, const char* file, s32 line, const char* description);
     
     template<class ARENA> r2::mem::LinearArena* CreateLinearArena(ARENA& arena, u64 capacity, const char* file, s32 line, const char* description);
+
+    template<class ARENA> r2::mem::MTLinearArena* CreateMTLinearArena(ARENA& arena, u64 capacity, const char* file, s32 line, const char* description);
     
     LinearArena* EmplaceLinearArena(MemoryArea::SubArea& subArea, const char* file, s32 line, const char* description);
 
@@ -113,6 +119,25 @@ namespace r2::mem::utils
         
         return linearArena;
     }
+
+    template<class ARENA> r2::mem::MTLinearArena* CreateMTLinearArena(ARENA& arena, u64 capacity, const char* file, s32 line, const char* description)
+    {
+        void* linearArenaStartPtr = ALLOC_BYTES(arena, sizeof(MTLinearArena) + capacity, CPLAT.CPUCacheLineSize(), file, line, description);
+
+        R2_CHECK(linearArenaStartPtr != nullptr, "We shouldn't have null pool!");
+
+        void* boundaryStart = r2::mem::utils::PointerAdd(linearArenaStartPtr, sizeof(MTLinearArena));
+
+        utils::MemBoundary linearBoundary;
+        linearBoundary.location = boundaryStart;
+        linearBoundary.size = capacity;
+
+        MTLinearArena* linearArena = new (linearArenaStartPtr) MTLinearArena(linearBoundary);
+
+        R2_CHECK(linearArena != nullptr, "Couldn't placement new?");
+
+        return linearArena;
+    }
     
     
 }
@@ -34,6 +34,9 @@ namespace r2::mem
         inline const void* StartPtr() const {return mBoundary.location;}
         static u32 HeaderSize() {return sizeof(utils::Header);}
         inline u64 UnallocatedBytes() const {return GetTotalMemory() - GetTotalBytesAllocated();}
+        //malloc doesn't fragment our memory so all of it is one block
+        inline u64 LargestFreeBlockSize() const {return UnallocatedBytes();}
+        inline u64 FreeBlockSizeAfterFree(void* memoryPtr) const {return UnallocatedBytes() + HeaderSize() + GetAllocationSize(memoryPtr);}
 
         
     private:
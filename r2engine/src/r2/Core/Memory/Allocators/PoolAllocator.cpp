@@ -37,16 +37,11 @@ namespace r2
             R2_CHECK(size <= mElementSize, "Size is greater than the element size");
             R2_CHECK(alignment <= mAlignment, "alignment is greater than the max alignment");
             
-            if (mNumAllocations + 1 > mFreeList.NumElements())
-            {
-                return nullptr;
-            }
-
             void* pointer = mFreeList.Obtain();
             
             if (pointer != nullptr)
             {
-                ++mNumAllocations;
+                mNumAllocations.fetch_add(1, std::memory_order_relaxed);
             }
             
             return pointer;
@@ -57,12 +52,13 @@ namespace r2
             R2_CHECK(ptr != nullptr, "Why are you passing a nullptr to free?");
             R2_CHECK(ptr >= mStart && ptr < mEnd, "Pointer should be within the pool!");
             mFreeList.Return(ptr);
-            --mNumAllocations;
+            mNumAllocations.fetch_sub(1, std::memory_order_relaxed);
         }
 
         void PoolAllocator::Reset(void)
         {
             mFreeList.Reset(mStart, mEnd, mElementSize, mAlignment, mOffset);
+            mNumAllocations.store(0, std::memory_order_relaxed);
         }
         
         u32 PoolAllocator::GetAllocationSize(void* memoryPtr) const
@@ -77,56 +73,86 @@ namespace r2
 
         void PoolAllocator::Freelist::Reset(void* start, void* end, u64 elementSize, u64 alignment, u64 offset)
         {
-			R2_CHECK(elementSize >= sizeof(Freelist), "elementSize must be greater than or equal to a freelist object which is %zu bytes", sizeof(Freelist));
+			R2_CHECK(elementSize >= sizeof(Node), "elementSize must be greater than or equal to a freelist node which is %zu bytes", sizeof(Node));
 			void* pointer = utils::PointerSubtract(utils::AlignForward(utils::PointerAdd(start, offset), alignment), offset);
 
-			union
-			{
-				void* as_void;
-				byte* as_byte;
-				Freelist* as_self;
-			};
+			byte* firstElement = (byte*)utils::PointerAdd(pointer, offset);
 
-			as_void = utils::PointerAdd(pointer, offset);
-
-			u64 totalMem = utils::PointerOffset(as_void, end);
+			u64 totalMem = utils::PointerOffset(firstElement, end);
 			u64 adjustment = totalMem % elementSize;
 
-			as_void = utils::PointerAdd(as_void, adjustment);
+			firstElement = (byte*)utils::PointerAdd(firstElement, adjustment);
 
-			totalMem = utils::PointerOffset(as_void, end);
+			totalMem = utils::PointerOffset(firstElement, end);
 			R2_CHECK(totalMem % elementSize == 0, "totalMem should be a multiple of elementSize");
-			mNumElements = totalMem / elementSize;
+			R2_CHECK(totalMem / elementSize < INVALID_INDEX, "We can only index %u elements in the pool", INVALID_INDEX);
 
-			mNext = as_self;
-			as_byte = (byte*)utils::PointerAdd(as_byte, elementSize);
+			mFirstElement = firstElement;
+			mElementSize = elementSize;
+			mNumElements = totalMem / elementSize;
 
-			Freelist* runner = mNext;
-			for (u64 i = 1; i < mNumElements; ++i)
+			for (u64 i = 0; i < mNumElements; ++i)
 			{
-				runner->mNext = as_self;
-				runner = as_self;
-				as_byte = (byte*)utils::PointerAdd(as_byte, elementSize);
+				const u32 next = (i + 1 < mNumElements) ? static_cast<u32>(i + 1) : INVALID_INDEX;
+				new (NodeAt(static_cast<u32>(i))) Node{ {next} };
 			}
+
+			mHead.store(mNumElements > 0 ? 0 : INVALID_INDEX, std::memory_order_release);
         }
         
         inline void* PoolAllocator::Freelist::Obtain(void)
         {
-            if (mNext == nullptr)
+            u64 head = mHead.load(std::memory_order_acquire);
+
+            for (;;)
             {
-                return nullptr;
+                const u32 index = static_cast<u32>(head);
+
+                if (index == INVALID_INDEX)
+                {
+                    return nullptr;
+                }
+
+                //@NOTE(Serge): another thread may have popped this node and handed it out already. Then next is garbage but the counter in the
+                //              head has moved on so the compare exchange fails and we try again.
+                const u32 next = NodeAt(index)->next.load(std::memory_order_relaxed);
+
+                if (mHead.compare_exchange_weak(head, MakeHead(head, next), std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    return NodeAt(index);
+                }
             }
-            
-            Freelist* head = mNext;
-            mNext = head->mNext;
-            return head;
         }
         
         inline void PoolAllocator::Freelist::Return(void* memoryPtr)
         {
-            Freelist* head = static_cast<Freelist*>(memoryPtr);
-            head->mNext = mNext;
-            mNext = head;
+            const u32 index = IndexOf(memoryPtr);
+            Node* node = new (memoryPtr) Node;
+
+            u64 head = mHead.load(std::memory_order_relaxed);
+
+            do
+            {
+                node->next.store(static_cast<u32>(head), std::memory_order_relaxed);
+            } while (!mHead.compare_exchange_weak(head, MakeHead(head, index), std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        inline PoolAllocator::Freelist::Node* PoolAllocator::Freelist::NodeAt(u32 index) const
+        {
+            return reinterpret_cast<Node*>(mFirstElement + static_cast<u64>(index) * mElementSize);
+        }
+
+        inline u32 PoolAllocator::Freelist::IndexOf(void* memoryPtr) const
+        {
+            const u64 offset = utils::PointerOffset(mFirstElement, memoryPtr);
+            R2_CHECK(offset % mElementSize == 0, "Pointer isn't at the start of an element in the pool!");
+            return static_cast<u32>(offset / mElementSize);
+        }
+
+        inline u64 PoolAllocator::Freelist::MakeHead(u64 oldHead, u32 index)
+        {
+            const u64 counter = (oldHead >> 32) + 1;
+            return (counter << 32) | static_cast<u64>(index);
         }
     }
 }
@@ -12,6 +12,7 @@
 #include "r2/Core/Memory/MemoryBoundsChecking.h"
 #include "r2/Core/Memory/MemoryTagging.h"
 #include "r2/Core/Memory/MemoryTracking.h"
+#include <atomic>
 
 #define MAKE_POOLA(arena, elementSize, capacity) r2::mem::utils::CreatePoolAllocator(arena, elementSize, capacity, __FILE__, __LINE__, "")
 
@@ -19,6 +20,8 @@
 
 #define MAKE_NO_CHECK_POOL_ARENA(arena, elementSize, capacity) r2::mem::utils::CreateNoCheckPoolArena(arena, elementSize, capacity, __FILE__, __LINE__, "")
 
+#define MAKE_MT_POOL_ARENA(arena, elementSize, alignment, capacity) r2::mem::utils::CreateMTPoolArena(arena, elementSize, alignment, capacity, __FILE__, __LINE__, "")
+
 #define EMPLACE_POOL_ARENA(subarea) r2::mem::utils::EmplacePoolArena(subarea, __FILE__, __LINE__, "")
 
 #define EMPLACE_POOL_ARENA_IN_BOUNDARY(boundary) r2::mem::utils::EmplacePoolArenaInMemoryBoundary(boundary, __FILE__, __LINE__, "")
@@ -28,6 +31,7 @@ namespace r2
 {
     namespace mem
     {
+        //Allocate and Free are lock-free so the allocator itself can be shared between threads. Reset is not thread safe.
         class PoolAllocator
         {
         public:
@@ -39,14 +43,16 @@ namespace r2
             void Reset(void);
             u32 GetAllocationSize(void* memoryPtr) const;
             u64 TotalElements() const {return mFreeList.NumElements();}
-            u64 NumElementsAllocated() const {return mNumAllocations;}
+            u64 NumElementsAllocated() const {return mNumAllocations.load(std::memory_order_relaxed);}
             //I think this is wrong since this doesn't take into account the alignment
-            inline u64 GetTotalBytesAllocated() const {return mElementSize * mNumAllocations;}
+            inline u64 GetTotalBytesAllocated() const {return mElementSize * NumElementsAllocated();}
             inline u64 GetTotalMemory() const {return utils::PointerOffset(mStart, mEnd);}
             inline const void* StartPtr() const {return mStart;}
             static inline u32 HeaderSize() {return 0;}
-            inline u64 UnallocatedBytes() const {return (TotalElements() - mNumAllocations)*mElementSize;}
+            inline u64 UnallocatedBytes() const {return (TotalElements() - NumElementsAllocated())*mElementSize;}
         private:
+            //Treiber stack of the free elements. The head packs the index of the first free element in the low 32 bits and a counter in
+            //the high 32 bits that changes on every push/pop so a compare exchange can't succeed on a stale head (ABA).
             class Freelist
             {
             public:
@@ -58,7 +64,20 @@ namespace r2
                 void Reset(void* start, void* end, u64 elementSize, u64 alignment, u64 offset);
 
             private:
-                Freelist* mNext;
+                struct Node
+                {
+                    std::atomic<u32> next;
+                };
+
+                static const u32 INVALID_INDEX = 0xFFFFFFFF;
+
+                inline Node* NodeAt(u32 index) const;
+                inline u32 IndexOf(void* memoryPtr) const;
+                static inline u64 MakeHead(u64 oldHead, u32 index);
+
+                std::atomic<u64> mHead;
+                byte* mFirstElement;
+                u64 mElementSize;
                 u64 mNumElements;
             };
             
@@ -68,7 +87,7 @@ namespace r2
             byte* mEnd;
             const u64 mElementSize;
             const u64 mAlignment;
-            u64 mNumAllocations;
+            std::atomic<u64> mNumAllocations;
             u64 mOffset;
         };
         
@@ -76,10 +95,16 @@ namespace r2
         typedef MemoryArena<PoolAllocator, SingleThreadPolicy, BasicBoundsChecking, BasicMemoryTracking, BasicMemoryTagging> PoolArena;
         
         typedef MemoryArena<PoolAllocator, SingleThreadPolicy, NoBoundsChecking, NoMemoryTracking, NoMemoryTagging> NoCheckPoolArena;
+
+        //The memory tracker isn't thread safe so we still need a lock while it's on
+        typedef MemoryArena<PoolAllocator, SpinLockThreadPolicy, BasicBoundsChecking, BasicMemoryTracking, BasicMemoryTagging> MTPoolArena;
 #else
         typedef MemoryArena<PoolAllocator, SingleThreadPolicy, NoBoundsChecking, NoMemoryTracking, NoMemoryTagging> PoolArena;
         
         typedef MemoryArena<PoolAllocator, SingleThreadPolicy, NoBoundsChecking, NoMemoryTracking, NoMemoryTagging> NoCheckPoolArena;
+
+        //No lock needed since the PoolAllocator is lock-free and there is no tracking
+        typedef MemoryArena<PoolAllocator, SingleThreadPolicy, NoBoundsChecking, NoMemoryTracking, NoMemoryTagging> MTPoolArena;
 #endif
     }
 }
@@ -91,6 +116,8 @@ namespace r2::mem::utils
     template<class ARENA> r2::mem::PoolArena* CreatePoolArena(ARENA& arena, u32 elementSize, u32 alignment, u64 capacity, const char* file, s32 line, const char* description);
     
     template<class ARENA> r2::mem::NoCheckPoolArena* CreateNoCheckPoolArena(ARENA& arena, u32 elementSize, u64 capacity, const char* file, s32 line, const char* description);
+
+    template<class ARENA> r2::mem::MTPoolArena* CreateMTPoolArena(ARENA& arena, u32 elementSize, u32 alignment, u64 capacity, const char* file, s32 line, const char* description);
     
     PoolArena* EmplacePoolArena(MemoryArea::SubArea& subArea, u32 elementSize, const char* file, s32 line, const char* description);
 
@@ -176,6 +203,35 @@ namespace r2::mem::utils
         
         return pool;
     }
+
+    template<class ARENA> r2::mem::MTPoolArena* CreateMTPoolArena(ARENA& arena, u32 elementSize, u32 alignment, u64 capacity, const char* file, s32 line, const char* description)
+    {
+#if defined(R2_DEBUG) || defined(R2_RELEASE)
+        elementSize = elementSize + BasicBoundsChecking::SIZE_BACK + BasicBoundsChecking::SIZE_FRONT;
+#endif
+        R2_CHECK(capacity > 0, "We should actually have some elements in the pool!");
+
+        u64 poolSizeInBytes = capacity * elementSize;
+
+        void* poolArenaStartPtr = ALLOC_BYTES(arena, sizeof(MTPoolArena) + poolSizeInBytes, alignment, file, line, description);
+
+        R2_CHECK(poolArenaStartPtr != nullptr, "We shouldn't have null pool!");
+
+        void* boundaryStart = r2::mem::utils::PointerAdd(poolArenaStartPtr, sizeof(MTPoolArena));
+
+        utils::MemBoundary poolBoundary;
+        poolBoundary.location = boundaryStart;
+        poolBoundary.size = poolSizeInBytes;
+        poolBoundary.elementSize = elementSize;
+        poolBoundary.alignment = alignment;
+        poolBoundary.offset = 0;
+
+        MTPoolArena* pool = new (poolArenaStartPtr) MTPoolArena(poolBoundary);
+
+        R2_CHECK(pool != nullptr, "Couldn't placement new?");
+
+        return pool;
+    }
 }
 
 #endif /* PoolAllocator_h */
@@ -20,6 +20,12 @@ namespace r2::mem
         LinearArena* permanentStorageArena = nullptr;
         StackArena* singleFrameArena = nullptr;
     };
+
+    //Returns the scratch arena registered for the calling thread or the engine's singleFrameArena if there isn't one
+    StackArena* ThreadScratchArena();
+
+    //Registers the scratch arena that MEM_ENG_SCRATCH_PTR resolves to on the calling thread. Pass nullptr to go back to the singleFrameArena
+    void SetThreadScratchArena(StackArena* scratchArena);
 }
 
 #endif /* InternalEngineMemory_h */
@@ -97,6 +97,23 @@ namespace r2
             
             return nullptr;
         }
+
+        static thread_local StackArena* t_threadScratchArena = nullptr;
+
+        StackArena* ThreadScratchArena()
+        {
+            if (t_threadScratchArena != nullptr)
+            {
+                return t_threadScratchArena;
+            }
+
+            return GlobalMemory::EngineMemory().singleFrameArena;
+        }
+
+        void SetThreadScratchArena(StackArena* scratchArena)
+        {
+            t_threadScratchArena = scratchArena;
+        }
         
         namespace utils
         {
@@ -10,6 +10,9 @@
 
 #include <vector>
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include "r2/Utils/Utils.h"
 #include "r2/Core/Logging/Log.h"
 
@@ -41,7 +44,9 @@
 
 
 #define MEM_ENG_PERMANENT_PTR r2::mem::GlobalMemory::EngineMemory().permanentStorageArena
-#define MEM_ENG_SCRATCH_PTR r2::mem::GlobalMemory::EngineMemory().singleFrameArena
+//Single frame scratch memory for the calling thread. This is the engine's singleFrameArena on the main thread and the thread's own
+//scratch arena on threads that registered one with r2::mem::SetThreadScratchArena (ie. job worker threads)
+#define MEM_ENG_SCRATCH_PTR r2::mem::ThreadScratchArena()
 
 #define STACK_BOUNDARY(array) r2::mem::utils::GetBoundary(&array, sizeof(array))
 
@@ -160,6 +165,39 @@ namespace r2
             inline void Enter() const {}
             inline void Leave() const {}
         };
+
+        //Blocks on an OS mutex. Use for arenas where the allocator does real work while holding the lock (ie. the FreeListAllocator)
+        class MutexThreadPolicy
+        {
+        public:
+            inline void Enter() { mMutex.lock(); }
+            inline void Leave() { mMutex.unlock(); }
+        private:
+            std::mutex mMutex;
+        };
+
+        //Busy waits on an atomic flag. Use for arenas where the critical section is only a few instructions (ie. bumping a pointer)
+        class SpinLockThreadPolicy
+        {
+        public:
+            inline void Enter()
+            {
+                u32 numSpins = 0;
+                while (mLocked.test_and_set(std::memory_order_acquire))
+                {
+                    if (++numSpins >= MAX_SPINS_BEFORE_YIELD)
+                    {
+                        numSpins = 0;
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            inline void Leave() { mLocked.clear(std::memory_order_release); }
+        private:
+            static const u32 MAX_SPINS_BEFORE_YIELD = 64;
+            std::atomic_flag mLocked = ATOMIC_FLAG_INIT;
+        };
         
         class MemoryArenaBase
         {
@@ -354,6 +392,17 @@ namespace r2
             {
                 return mAllocator.UnallocatedBytes();
             }
+
+            //Only usable with allocators that can report on their fragmentation (FreeListAllocator, MallocAllocator)
+            const u64 LargestFreeBlockSize() const
+            {
+                return mAllocator.LargestFreeBlockSize();
+            }
+
+            const u64 FreeBlockSizeAfterFree(void* ptr) const
+            {
+                return mAllocator.FreeBlockSizeAfterFree(static_cast<byte*>(ptr) - BoundsCheckingPolicy::SIZE_FRONT);
+            }
             
             AllocationPolicy& GetPolicyRef()
             {
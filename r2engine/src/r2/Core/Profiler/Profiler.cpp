@@ -0,0 +1,618 @@
+#include "r2pch.h"
+#include "r2/Core/Profiler/Profiler.h"
+#include "r2/Core/Memory/Allocators/LinearAllocator.h"
+#include "r2/Core/Memory/InternalEngineMemory.h"
+#include "r2/Core/File/FileSystem.h"
+#include "r2/Core/File/File.h"
+#include <atomic>
+#include <chrono>
+
+namespace r2::prof
+{
+	struct ZoneEvent
+	{
+		const char* name = nullptr;
+		u64 startNs = 0;
+		u64 endNs = 0;
+		u32 depth = 0;
+	};
+
+	struct OpenZone
+	{
+		const char* name = nullptr;
+		u64 startNs = 0;
+	};
+
+	//Only the owning thread writes to the ring and the stack. The main thread reads the ring up to writeIndex once a frame.
+	struct ProfilerThread
+	{
+		alignas(64) std::atomic<u64> writeIndex{ 0 };
+		u64 readIndex = 0;
+		ZoneEvent* events = nullptr;
+		OpenZone stack[MAX_ZONE_DEPTH];
+		u32 depth = 0;
+	};
+
+	struct Profiler
+	{
+		r2::mem::MemoryArea::Handle mMemoryAreaHandle = r2::mem::MemoryArea::Invalid;
+		r2::mem::MemoryArea::SubArea::Handle mSubAreaHandle = r2::mem::MemoryArea::SubArea::Invalid;
+		r2::mem::LinearArena* mLinearArena = nullptr;
+
+		ProfilerThread* mThreads = nullptr;
+		u32 mMaxNumThreads = 0;
+		std::atomic<u32> mNumThreads{ 0 };
+
+		u64 mMaxNumZonesPerThread = 0;
+		u64 mZoneIndexMask = 0;
+
+		std::atomic_bool mPaused{ false };
+		f64 mSpikeThresholdMs = 0.0;
+
+		u64 mStartNs = 0;
+		u64 mFrameStartNs = 0;
+		u64 mFrameIndex = 0;
+
+		ZoneStats mZoneStats[MAX_NUM_ZONE_STATS];
+		u32 mNumZoneStats = 0;
+
+		ZoneStats mSortedZoneStats[MAX_NUM_ZONE_STATS];
+
+		f64 mFrameHistory[NUM_FRAME_HISTORY];
+		u32 mNumFramesInHistory = 0;
+		u32 mNextFrameHistoryIndex = 0;
+
+		f64 mOrderedFrameHistory[NUM_FRAME_HISTORY];
+	};
+}
+
+namespace
+{
+	r2::prof::Profiler* s_optrProfiler = nullptr;
+
+	//Bumped on every Init so threads that had a slot in a previous run pick up a new one
+	u32 s_generation = 0;
+
+	thread_local u32 t_threadSlot = 0;
+	thread_local u32 t_threadSlotGeneration = 0;
+
+	const u64 ALIGNMENT = 16;
+	const u32 INVALID_THREAD_SLOT = 0xFFFFFFFF;
+	const u64 NUM_FRAMES_BEFORE_SPIKE_DETECTION = 60;
+	const char* const FRAME_ZONE_NAME = "Frame";
+
+	u64 NowNs()
+	{
+		return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	f64 NsToMs(u64 ns)
+	{
+		return static_cast<f64>(ns) / 1000000.0;
+	}
+}
+
+namespace r2::prof
+{
+	ProfilerThread* GetThread()
+	{
+		if (t_threadSlotGeneration != s_generation)
+		{
+			const u32 slot = s_optrProfiler->mNumThreads.fetch_add(1, std::memory_order_relaxed);
+			t_threadSlot = slot < s_optrProfiler->mMaxNumThreads ? slot : INVALID_THREAD_SLOT;
+			t_threadSlotGeneration = s_generation;
+		}
+
+		if (t_threadSlot == INVALID_THREAD_SLOT)
+		{
+			return nullptr;
+		}
+
+		return &s_optrProfiler->mThreads[t_threadSlot];
+	}
+
+	ZoneStats* FindOrAddZoneStats(const char* name)
+	{
+		//Most of the time the same zone has the same pointer, the same literal can end up with different pointers in different translation units though
+		for (u32 i = 0; i < s_optrProfiler->mNumZoneStats; ++i)
+		{
+			if (s_optrProfiler->mZoneStats[i].name == name)
+			{
+				return &s_optrProfiler->mZoneStats[i];
+			}
+		}
+
+		for (u32 i = 0; i < s_optrProfiler->mNumZoneStats; ++i)
+		{
+			if (strcmp(s_optrProfiler->mZoneStats[i].name, name) == 0)
+			{
+				return &s_optrProfiler->mZoneStats[i];
+			}
+		}
+
+		if (s_optrProfiler->mNumZoneStats >= MAX_NUM_ZONE_STATS)
+		{
+			return nullptr;
+		}
+
+		ZoneStats& newStats = s_optrProfiler->mZoneStats[s_optrProfiler->mNumZoneStats++];
+		newStats = {};
+		newStats.name = name;
+		newStats.depth = MAX_ZONE_DEPTH;
+
+		return &newStats;
+	}
+
+	void WriteJSONString(r2::fs::File& file, const char* str)
+	{
+		char buffer[256];
+		u32 size = 0;
+
+		for (const char* c = str; *c != '\0' && size < sizeof(buffer) - 2; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+			{
+				buffer[size++] = '\\';
+			}
+
+			buffer[size++] = *c;
+		}
+
+		file.Write(buffer, size);
+	}
+
+	bool Init(const r2::mem::MemoryArea::Handle memoryAreaHandle, u32 maxNumThreads, u32 maxNumZonesPerThread)
+	{
+		R2_CHECK(memoryAreaHandle != r2::mem::MemoryArea::Invalid, "Memory Area handle is invalid");
+		R2_CHECK(s_optrProfiler == nullptr, "Are you trying to initialize this system more than once?");
+		R2_CHECK(maxNumThreads > 0 && maxNumThreads <= MAX_NUM_PROFILER_THREADS, "We can profile at most %u threads", MAX_NUM_PROFILER_THREADS);
+		R2_CHECK(maxNumZonesPerThread > 0 && (maxNumZonesPerThread & (maxNumZonesPerThread - 1)) == 0, "maxNumZonesPerThread must be a power of 2");
+
+		if (memoryAreaHandle == r2::mem::MemoryArea::Invalid ||
+			s_optrProfiler != nullptr)
+		{
+			return false;
+		}
+
+		r2::mem::MemoryArea* noptrMemArea = r2::mem::GlobalMemory::GetMemoryArea(memoryAreaHandle);
+		R2_CHECK(noptrMemArea != nullptr, "noptrMemArea is null?");
+		if (!noptrMemArea)
+		{
+			return false;
+		}
+
+		u64 memoryNeeded = GetMemorySize(maxNumThreads, maxNumZonesPerThread);
+		if (memoryNeeded > noptrMemArea->UnAllocatedSpace())
+		{
+			R2_CHECK(false, "We don't have enough space to allocate a new sub area for this system");
+			return false;
+		}
+
+		r2::mem::MemoryArea::SubArea::Handle subAreaHandle = noptrMemArea->AddSubArea(memoryNeeded, "Profiler");
+
+		R2_CHECK(subAreaHandle != r2::mem::MemoryArea::SubArea::Invalid, "We have an invalid sub area");
+
+		if (subAreaHandle == r2::mem::MemoryArea::SubArea::Invalid)
+		{
+			return false;
+		}
+
+		r2::mem::MemoryArea::SubArea* noptrSubArea = noptrMemArea->GetSubArea(subAreaHandle);
+		R2_CHECK(noptrSubArea != nullptr, "noptrSubArea is null");
+		if (!noptrSubArea)
+		{
+			return false;
+		}
+
+		r2::mem::LinearArena* profilerArena = EMPLACE_LINEAR_ARENA(*noptrSubArea);
+
+		if (!profilerArena)
+		{
+			R2_CHECK(profilerArena != nullptr, "linearArena is null");
+			return false;
+		}
+
+		s_optrProfiler = ALLOC(Profiler, *profilerArena);
+
+		R2_CHECK(s_optrProfiler != nullptr, "We couldn't allocate the profiler!");
+
+		s_optrProfiler->mMemoryAreaHandle = memoryAreaHandle;
+		s_optrProfiler->mSubAreaHandle = subAreaHandle;
+		s_optrProfiler->mLinearArena = profilerArena;
+		s_optrProfiler->mMaxNumThreads = maxNumThreads;
+		s_optrProfiler->mMaxNumZonesPerThread = maxNumZonesPerThread;
+		s_optrProfiler->mZoneIndexMask = static_cast<u64>(maxNumZonesPerThread) - 1;
+
+		s_optrProfiler->mThreads = ALLOC_ARRAYN(ProfilerThread, maxNumThreads, *profilerArena);
+
+		for (u32 i = 0; i < maxNumThreads; ++i)
+		{
+			s_optrProfiler->mThreads[i].events = ALLOC_ARRAYN(ZoneEvent, maxNumZonesPerThread, *profilerArena);
+			R2_CHECK(s_optrProfiler->mThreads[i].events != nullptr, "We couldn't allocate the zones for profiler thread: %u", i);
+		}
+
+		s_optrProfiler->mStartNs = NowNs();
+		s_optrProfiler->mFrameStartNs = s_optrProfiler->mStartNs;
+
+		++s_generation;
+
+		//The calling thread is the main thread and always gets slot 0
+		GetThread();
+
+		return true;
+	}
+
+	void Shutdown()
+	{
+		if (s_optrProfiler == nullptr)
+		{
+			R2_CHECK(false, "We haven't initialized the profiler yet!");
+			return;
+		}
+
+		r2::mem::LinearArena* profilerArena = s_optrProfiler->mLinearArena;
+
+		for (s64 i = static_cast<s64>(s_optrProfiler->mMaxNumThreads) - 1; i >= 0; --i)
+		{
+			FREE_ARRAY(s_optrProfiler->mThreads[i].events, *profilerArena);
+		}
+
+		FREE_ARRAY(s_optrProfiler->mThreads, *profilerArena);
+
+		FREE(s_optrProfiler, *profilerArena);
+		s_optrProfiler = nullptr;
+
+		FREE_EMPLACED_ARENA(profilerArena);
+	}
+
+	bool IsInitialized()
+	{
+		return s_optrProfiler != nullptr;
+	}
+
+	u64 GetMemorySize(u32 maxNumThreads, u32 maxNumZonesPerThread)
+	{
+		u32 boundsChecking = 0;
+#ifdef R2_DEBUG
+		boundsChecking = r2::mem::BasicBoundsChecking::SIZE_FRONT + r2::mem::BasicBoundsChecking::SIZE_BACK;
+#endif
+		u32 headerSize = r2::mem::LinearAllocator::HeaderSize();
+
+		return
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::mem::LinearArena), ALIGNMENT, headerSize, boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(Profiler), alignof(Profiler), headerSize, boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(ProfilerThread) * (maxNumThreads + 1), alignof(ProfilerThread), headerSize, boundsChecking) + //+1 for the array length header
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(ZoneEvent) * (maxNumZonesPerThread + 1), alignof(ZoneEvent), headerSize, boundsChecking) * maxNumThreads;
+	}
+
+	void BeginFrame()
+	{
+		if (!s_optrProfiler)
+		{
+			return;
+		}
+
+		s_optrProfiler->mFrameStartNs = NowNs();
+		BeginZone(FRAME_ZONE_NAME);
+	}
+
+	void EndFrame()
+	{
+		if (!s_optrProfiler)
+		{
+			return;
+		}
+
+		EndZone();
+
+		if (s_optrProfiler->mPaused.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		const f64 frameMs = NsToMs(NowNs() - s_optrProfiler->mFrameStartNs);
+
+		for (u32 i = 0; i < s_optrProfiler->mNumZoneStats; ++i)
+		{
+			s_optrProfiler->mZoneStats[i].lastFrameMs = 0.0;
+			s_optrProfiler->mZoneStats[i].numCallsLastFrame = 0;
+		}
+
+		//Everything that finished since the last frame gets counted in this one, that includes zones that workers finished in between frames
+		const u32 numThreads = std::min(s_optrProfiler->mNumThreads.load(std::memory_order_relaxed), s_optrProfiler->mMaxNumThreads);
+
+		for (u32 i = 0; i < numThreads; ++i)
+		{
+			ProfilerThread& thread = s_optrProfiler->mThreads[i];
+
+			const u64 writeIndex = thread.writeIndex.load(std::memory_order_acquire);
+			u64 readIndex = thread.readIndex;
+
+			if (writeIndex - readIndex > s_optrProfiler->mMaxNumZonesPerThread)
+			{
+				readIndex = writeIndex - s_optrProfiler->mMaxNumZonesPerThread;
+			}
+
+			for (; readIndex < writeIndex; ++readIndex)
+			{
+				const ZoneEvent& event = thread.events[readIndex & s_optrProfiler->mZoneIndexMask];
+
+				ZoneStats* stats = FindOrAddZoneStats(event.name);
+				if (!stats)
+				{
+					continue;
+				}
+
+				stats->lastFrameMs += NsToMs(event.endNs - event.startNs);
+				stats->numCallsLastFrame++;
+				stats->depth = std::min(stats->depth, event.depth);
+			}
+
+			thread.readIndex = writeIndex;
+		}
+
+		for (u32 i = 0; i < s_optrProfiler->mNumZoneStats; ++i)
+		{
+			ZoneStats& stats = s_optrProfiler->mZoneStats[i];
+
+			if (stats.numCallsLastFrame == 0)
+			{
+				continue;
+			}
+
+			stats.minMs = stats.numFrames == 0 ? stats.lastFrameMs : std::min(stats.minMs, stats.lastFrameMs);
+			stats.maxMs = std::max(stats.maxMs, stats.lastFrameMs);
+			stats.totalMs += stats.lastFrameMs;
+			stats.numFrames++;
+		}
+
+		memcpy(s_optrProfiler->mSortedZoneStats, s_optrProfiler->mZoneStats, sizeof(ZoneStats) * s_optrProfiler->mNumZoneStats);
+
+		std::sort(s_optrProfiler->mSortedZoneStats, s_optrProfiler->mSortedZoneStats + s_optrProfiler->mNumZoneStats, [](const ZoneStats& s1, const ZoneStats& s2)
+		{
+			if (s1.depth != s2.depth)
+			{
+				return s1.depth < s2.depth;
+			}
+
+			return s1.lastFrameMs > s2.lastFrameMs;
+		});
+
+		s_optrProfiler->mFrameHistory[s_optrProfiler->mNextFrameHistoryIndex] = frameMs;
+		s_optrProfiler->mNextFrameHistoryIndex = (s_optrProfiler->mNextFrameHistoryIndex + 1) % NUM_FRAME_HISTORY;
+		s_optrProfiler->mNumFramesInHistory = std::min(s_optrProfiler->mNumFramesInHistory + 1, NUM_FRAME_HISTORY);
+
+		s_optrProfiler->mFrameIndex++;
+
+		//Stop recording right after the spike so the rings still have it in them when we go to write the trace
+		if (s_optrProfiler->mSpikeThresholdMs > 0.0 &&
+			s_optrProfiler->mFrameIndex > NUM_FRAMES_BEFORE_SPIKE_DETECTION &&
+			frameMs > s_optrProfiler->mSpikeThresholdMs)
+		{
+			R2_LOGI("Profiler - frame %llu took %f ms which is over the spike threshold of %f ms, pausing the profiler\n", s_optrProfiler->mFrameIndex, frameMs, s_optrProfiler->mSpikeThresholdMs);
+			SetPaused(true);
+		}
+	}
+
+	void BeginZone(const char* name)
+	{
+		if (!s_optrProfiler)
+		{
+			return;
+		}
+
+		ProfilerThread* thread = GetThread();
+		if (!thread)
+		{
+			return;
+		}
+
+		//We still keep track of the zones past the max depth so that the EndZones line up, we just don't record them
+		if (thread->depth < MAX_ZONE_DEPTH)
+		{
+			OpenZone& openZone = thread->stack[thread->depth];
+			openZone.name = name;
+			openZone.startNs = NowNs();
+		}
+
+		thread->depth++;
+	}
+
+	void EndZone()
+	{
+		if (!s_optrProfiler)
+		{
+			return;
+		}
+
+		ProfilerThread* thread = GetThread();
+		if (!thread)
+		{
+			return;
+		}
+
+		R2_CHECK(thread->depth > 0, "EndZone called without a matching BeginZone");
+		if (thread->depth == 0)
+		{
+			return;
+		}
+
+		thread->depth--;
+
+		//Zones still get pushed and popped while paused so we're balanced when we resume
+		if (thread->depth >= MAX_ZONE_DEPTH || s_optrProfiler->mPaused.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		const OpenZone& openZone = thread->stack[thread->depth];
+
+		const u64 writeIndex = thread->writeIndex.load(std::memory_order_relaxed);
+
+		ZoneEvent& event = thread->events[writeIndex & s_optrProfiler->mZoneIndexMask];
+		event.name = openZone.name;
+		event.startNs = openZone.startNs;
+		event.endNs = NowNs();
+		event.depth = thread->depth;
+
+		thread->writeIndex.store(writeIndex + 1, std::memory_order_release);
+	}
+
+	void SetPaused(bool paused)
+	{
+		if (!s_optrProfiler)
+		{
+			return;
+		}
+
+		if (!paused && s_optrProfiler->mPaused.load(std::memory_order_relaxed))
+		{
+			//Don't count the time we were paused for in the frame we resume in
+			s_optrProfiler->mFrameStartNs = NowNs();
+		}
+
+		s_optrProfiler->mPaused.store(paused, std::memory_order_relaxed);
+	}
+
+	bool IsPaused()
+	{
+		return s_optrProfiler && s_optrProfiler->mPaused.load(std::memory_order_relaxed);
+	}
+
+	void SetSpikeThresholdMs(f64 thresholdMs)
+	{
+		if (s_optrProfiler)
+		{
+			s_optrProfiler->mSpikeThresholdMs = thresholdMs;
+		}
+	}
+
+	f64 GetSpikeThresholdMs()
+	{
+		return s_optrProfiler ? s_optrProfiler->mSpikeThresholdMs : 0.0;
+	}
+
+	void ResetStats()
+	{
+		if (!s_optrProfiler)
+		{
+			return;
+		}
+
+		s_optrProfiler->mNumZoneStats = 0;
+		s_optrProfiler->mNumFramesInHistory = 0;
+		s_optrProfiler->mNextFrameHistoryIndex = 0;
+	}
+
+	const ZoneStats* GetZoneStats(u32& numZoneStats)
+	{
+		if (!s_optrProfiler)
+		{
+			numZoneStats = 0;
+			return nullptr;
+		}
+
+		numZoneStats = s_optrProfiler->mNumZoneStats;
+		return s_optrProfiler->mSortedZoneStats;
+	}
+
+	const f64* GetFrameHistory(u32& numFrames)
+	{
+		if (!s_optrProfiler)
+		{
+			numFrames = 0;
+			return nullptr;
+		}
+
+		numFrames = s_optrProfiler->mNumFramesInHistory;
+
+		const u32 firstFrameIndex = (s_optrProfiler->mNextFrameHistoryIndex + NUM_FRAME_HISTORY - numFrames) % NUM_FRAME_HISTORY;
+
+		for (u32 i = 0; i < numFrames; ++i)
+		{
+			s_optrProfiler->mOrderedFrameHistory[i] = s_optrProfiler->mFrameHistory[(firstFrameIndex + i) % NUM_FRAME_HISTORY];
+		}
+
+		return s_optrProfiler->mOrderedFrameHistory;
+	}
+
+	u64 GetFrameIndex()
+	{
+		return s_optrProfiler ? s_optrProfiler->mFrameIndex : 0;
+	}
+
+	bool WriteChromeTrace(const char* filePath)
+	{
+		R2_CHECK(filePath != nullptr, "filePath is null");
+
+		if (!s_optrProfiler || !filePath)
+		{
+			return false;
+		}
+
+		r2::fs::File* traceFile = r2::fs::FileSystem::Open(DISK_CONFIG, filePath, r2::fs::Write | r2::fs::Binary);
+
+		if (!traceFile)
+		{
+			R2_LOGE("Profiler - Failed to open the trace file: %s\n", filePath);
+			return false;
+		}
+
+		//Only safe to read the rings while nothing is recording. If we weren't paused already then pause for the write and resume afterwards.
+		const bool wasPaused = s_optrProfiler->mPaused.exchange(true, std::memory_order_relaxed);
+
+		char line[512];
+		bool first = true;
+
+		const char* header = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		traceFile->Write(header, strlen(header));
+
+		const u32 numThreads = std::min(s_optrProfiler->mNumThreads.load(std::memory_order_relaxed), s_optrProfiler->mMaxNumThreads);
+
+		for (u32 i = 0; i < numThreads; ++i)
+		{
+			ProfilerThread& thread = s_optrProfiler->mThreads[i];
+
+			if (i == 0)
+			{
+				snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Main Thread\"}}", first ? "" : ",\n", i);
+			}
+			else
+			{
+				snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}", first ? "" : ",\n", i, i);
+			}
+
+			traceFile->Write(line, strlen(line));
+			first = false;
+
+			const u64 writeIndex = thread.writeIndex.load(std::memory_order_acquire);
+			const u64 firstIndex = writeIndex > s_optrProfiler->mMaxNumZonesPerThread ? writeIndex - s_optrProfiler->mMaxNumZonesPerThread : 0;
+
+			for (u64 index = firstIndex; index < writeIndex; ++index)
+			{
+				const ZoneEvent& event = thread.events[index & s_optrProfiler->mZoneIndexMask];
+
+				const char* nameStart = ",\n{\"name\":\"";
+				traceFile->Write(nameStart, strlen(nameStart));
+
+				WriteJSONString(*traceFile, event.name);
+
+				snprintf(line, sizeof(line), "\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}",
+					static_cast<f64>(event.startNs - s_optrProfiler->mStartNs) / 1000.0,
+					static_cast<f64>(event.endNs - event.startNs) / 1000.0,
+					i);
+
+				traceFile->Write(line, strlen(line));
+			}
+		}
+
+		const char* footer = "\n]}\n";
+		traceFile->Write(footer, strlen(footer));
+
+		r2::fs::FileSystem::Close(traceFile);
+
+		s_optrProfiler->mPaused.store(wasPaused, std::memory_order_relaxed);
+
+		return true;
+	}
+}
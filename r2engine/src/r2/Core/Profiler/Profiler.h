@@ -0,0 +1,94 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "r2/Core/Memory/Memory.h"
+
+namespace r2::prof
+{
+	//Frame profiler for CPU zones. Every thread that records a zone gets its own slot with a ring buffer of completed zones
+	//and a stack of open ones so recording never takes a lock. Zone names must be static strings (string literals or __FUNCTION__)
+	//since only the pointer is stored.
+	//
+	//Once a frame ends the main thread sums up every zone recorded during it into per zone stats (min/avg/max time per frame).
+	//The ring buffers always hold the most recent zones so they can be written out as a Chrome trace (chrome://tracing or ui.perfetto.dev)
+	//to see what happened during a spike.
+
+	static const u32 MAX_NUM_PROFILER_THREADS = 64;
+	static const u32 MAX_NUM_ZONES_PER_THREAD = 4096;
+	static const u32 MAX_ZONE_DEPTH = 32;
+	static const u32 MAX_NUM_ZONE_STATS = 256;
+	static const u32 NUM_FRAME_HISTORY = 256;
+
+	struct ZoneStats
+	{
+		const char* name = nullptr;
+		u32 depth = 0; //the shallowest depth this zone has been seen at
+		u32 numCallsLastFrame = 0;
+		f64 lastFrameMs = 0.0;
+		f64 minMs = 0.0;
+		f64 maxMs = 0.0;
+		f64 totalMs = 0.0;
+		u64 numFrames = 0; //number of frames the zone showed up in since the last reset
+
+		f64 AverageMs() const { return numFrames > 0 ? totalMs / static_cast<f64>(numFrames) : 0.0; }
+	};
+
+	bool Init(const r2::mem::MemoryArea::Handle memoryAreaHandle, u32 maxNumThreads, u32 maxNumZonesPerThread);
+	void Shutdown();
+	bool IsInitialized();
+
+	u64 GetMemorySize(u32 maxNumThreads, u32 maxNumZonesPerThread);
+
+	//Should only be called from the main thread around everything done in a frame
+	void BeginFrame();
+	void EndFrame();
+
+	void BeginZone(const char* name);
+	void EndZone();
+
+	//Stops recording zones so the rings keep their contents. Recording pauses on its own once a frame takes longer than the spike threshold.
+	void SetPaused(bool paused);
+	bool IsPaused();
+
+	//0 turns off pausing on spikes
+	void SetSpikeThresholdMs(f64 thresholdMs);
+	f64 GetSpikeThresholdMs();
+
+	void ResetStats();
+
+	//Sorted by depth then by the time spent in the last frame
+	const ZoneStats* GetZoneStats(u32& numZoneStats);
+
+	//History of frame times in ms, oldest first. numFrames is how many of the NUM_FRAME_HISTORY entries are valid.
+	const f64* GetFrameHistory(u32& numFrames);
+	u64 GetFrameIndex();
+
+	//Writes everything in the ring buffers in the Chrome trace event format
+	bool WriteChromeTrace(const char* filePath);
+
+	struct ScopedZone
+	{
+		explicit ScopedZone(const char* name) { BeginZone(name); }
+		~ScopedZone() { EndZone(); }
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+	};
+}
+
+#define R2_PROFILE_CONCAT_INNER(a, b) a##b
+#define R2_PROFILE_CONCAT(a, b) R2_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef R2_PROFILER
+#define R2_PROFILE_ZONE(name) r2::prof::ScopedZone R2_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define R2_PROFILE_FUNCTION() R2_PROFILE_ZONE(__FUNCTION__)
+#define R2_PROFILE_BEGIN_FRAME() r2::prof::BeginFrame()
+#define R2_PROFILE_END_FRAME() r2::prof::EndFrame()
+#else
+#define R2_PROFILE_ZONE(name)
+#define R2_PROFILE_FUNCTION()
+#define R2_PROFILE_BEGIN_FRAME()
+#define R2_PROFILE_END_FRAME()
+#endif
+
+#endif // __PROFILER_H__
@@ -10,6 +10,7 @@
 #include "r2/Editor/EditorAssetBrowser/EditorLevelAssetPanel.h"
 #include "r2/Editor/EditorScenePanel.h"
 #include "r2/Editor/EditorLevelRenderSettingsPanel.h"
+#include "r2/Editor/EditorProfilerPanel.h"
 #include "r2/Editor/EditorEvents/EditorEvent.h"
 #include "r2/Editor/EditorEvents/EditorEntityEvents.h"
 #include "r2/Game/ECS/ECSCoordinator.h"
@@ -88,6 +89,9 @@ namespace r2
 		std::unique_ptr<edit::ScenePanel> scenePanel = std::make_unique<edit::ScenePanel>();
 		mEditorWidgets.push_back(std::move(scenePanel));
 
+		std::unique_ptr<edit::ProfilerPanel> profilerPanel = std::make_unique<edit::ProfilerPanel>();
+		mEditorWidgets.push_back(std::move(profilerPanel));
+
 
 		std::filesystem::path editorFolderPath = std::filesystem::path(R2_ENGINE_ASSET_PATH) / "editor";
 
@@ -18,7 +18,7 @@ namespace r2::edit
 		,mEntityToDestroy(entityToDestroy)
 		,mParentOfEntityToDestory(parentOfEntityToDestroy)
 	{
-		r2::SArray<ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, ecs::MAX_NUM_ENTITIES);
+		r2::SArray<ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, mnoptrEditor->GetSceneGraph().GetNumEntitiesInScene());
 
 		mnoptrEditor->GetSceneGraph().GetAllChildrenForEntity(mEntityToDestroy, *children);
 
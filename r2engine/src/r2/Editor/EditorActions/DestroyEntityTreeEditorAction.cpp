@@ -20,7 +20,7 @@ namespace r2::edit
 		:EditorAction(editor)
 		,mEntityTree{}
 	{
-		r2::SArray<ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, ecs::MAX_NUM_ENTITIES);
+		r2::SArray<ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, mnoptrEditor->GetSceneGraph().GetNumEntitiesInScene());
 
 		auto index = mnoptrEditor->GetSceneGraph().GetEntityIndex(entityToDestroy);
 
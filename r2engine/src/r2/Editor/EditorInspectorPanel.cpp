@@ -20,6 +20,8 @@
 #include "r2/Game/ECS/Components/TransformDirtyComponent.h"
 #include "r2/Game/ECS/Components/SelectionComponent.h"
 #include "r2/Editor/TransformWidgetInput.h"
+#include "r2/Game/ECSWorld/ECSWorld.h"
+#include "r2/Render/Camera/Camera.h"
 //@HACK: we need this to get the camera but we should be able to get it through the editor or something
 #include "r2/Render/Renderer/Renderer.h"
 #include <glm/gtc/type_ptr.hpp>
@@ -78,9 +80,15 @@ namespace r2::edit
 			{
 				if (e.MouseButton() == r2::io::MOUSE_BUTTON_LEFT)
 				{
-					r2::draw::renderer::EntityInstance entityInstance = r2::draw::renderer::ReadEntityInstanceAtMousePosition(e.XPos(), e.YPos());
+					//Pick with the scene graph's spatial index instead of reading back the picking render target which stalls the GPU
+					const r2::Camera* camera = r2::draw::renderer::GetRenderCamera();
 
-					mnoptrEditor->PostNewAction(std::make_unique<r2::edit::SelectedEntityEditorAction>(mnoptrEditor, entityInstance.entityId, entityInstance.instanceId, mSelectedEntity, mCurrentInstance));
+					const r2::math::Ray ray = r2::cam::CalculateRayFromMousePosition(*camera, e.XPos(), e.YPos());
+
+					ecs::SpatialRaycastHit hit;
+					MENG.GetECSWorld().GetSceneGraph().Raycast(ray, camera->farPlane, hit);
+
+					mnoptrEditor->PostNewAction(std::make_unique<r2::edit::SelectedEntityEditorAction>(mnoptrEditor, hit.entity, hit.instance, mSelectedEntity, mCurrentInstance));
 				}
 
 				
@@ -0,0 +1,151 @@
+#include "r2pch.h"
+
+#if defined(R2_EDITOR) && defined(R2_IMGUI)
+
+#include "r2/Editor/EditorProfilerPanel.h"
+#include "imgui.h"
+
+namespace r2::edit
+{
+	ProfilerPanel::ProfilerPanel()
+		:mSpikeThresholdMs(0.0f)
+	{
+		memset(mFrameHistory, 0, sizeof(mFrameHistory));
+		strcpy(mTraceFilePath, "r2_trace.json");
+	}
+
+	ProfilerPanel::~ProfilerPanel()
+	{
+	}
+
+	void ProfilerPanel::Init(Editor* noptrEditor)
+	{
+		mnoptrEditor = noptrEditor;
+		mSpikeThresholdMs = static_cast<float>(r2::prof::GetSpikeThresholdMs());
+	}
+
+	void ProfilerPanel::Shutdown()
+	{
+	}
+
+	void ProfilerPanel::OnEvent(evt::Event& e)
+	{
+	}
+
+	void ProfilerPanel::Update()
+	{
+	}
+
+	void ProfilerPanel::Render(u32 dockingSpaceID)
+	{
+		ImGui::SetNextWindowSize(ImVec2(600, 450), ImGuiCond_FirstUseEver);
+
+		bool open = true;
+
+		if (!ImGui::Begin("Profiler", &open))
+		{
+			ImGui::End();
+			return;
+		}
+
+		if (!r2::prof::IsInitialized())
+		{
+			ImGui::Text("The profiler isn't running - build with R2_PROFILER to turn it on");
+			ImGui::End();
+			return;
+		}
+
+		bool paused = r2::prof::IsPaused();
+		if (ImGui::Checkbox("Paused", &paused))
+		{
+			r2::prof::SetPaused(paused);
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("Reset"))
+		{
+			r2::prof::ResetStats();
+		}
+
+		ImGui::SetNextItemWidth(120.0f);
+		if (ImGui::InputFloat("Pause on frames over (ms), 0 is off", &mSpikeThresholdMs, 1.0f, 5.0f, "%.2f"))
+		{
+			mSpikeThresholdMs = std::max(mSpikeThresholdMs, 0.0f);
+			r2::prof::SetSpikeThresholdMs(mSpikeThresholdMs);
+		}
+
+		ImGui::InputText("##traceFilePath", mTraceFilePath, IM_ARRAYSIZE(mTraceFilePath));
+		ImGui::SameLine();
+		if (ImGui::Button("Write Chrome Trace"))
+		{
+			r2::prof::WriteChromeTrace(mTraceFilePath);
+		}
+
+		u32 numFrames = 0;
+		const f64* frameHistory = r2::prof::GetFrameHistory(numFrames);
+
+		float maxFrameMs = 0.0f;
+		for (u32 i = 0; i < numFrames; ++i)
+		{
+			mFrameHistory[i] = static_cast<float>(frameHistory[i]);
+			maxFrameMs = std::max(maxFrameMs, mFrameHistory[i]);
+		}
+
+		char overlay[64];
+		snprintf(overlay, sizeof(overlay), "last: %.3f ms max: %.3f ms", numFrames > 0 ? mFrameHistory[numFrames - 1] : 0.0f, maxFrameMs);
+		ImGui::PlotHistogram("##frameHistory", mFrameHistory, static_cast<int>(numFrames), 0, overlay, 0.0f, maxFrameMs * 1.1f, ImVec2(-1.0f, 80.0f));
+
+		u32 numZoneStats = 0;
+		const r2::prof::ZoneStats* zoneStats = r2::prof::GetZoneStats(numZoneStats);
+
+		const float TEXT_BASE_WIDTH = ImGui::CalcTextSize("M").x;
+
+		static ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_NoBordersInBody | ImGuiTableFlags_ScrollY;
+
+		if (ImGui::BeginTable("ZoneTable", 6, flags))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_NoHide);
+			ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed, TEXT_BASE_WIDTH * 6.0f);
+			ImGui::TableSetupColumn("Last (ms)", ImGuiTableColumnFlags_WidthFixed, TEXT_BASE_WIDTH * 9.0f);
+			ImGui::TableSetupColumn("Min (ms)", ImGuiTableColumnFlags_WidthFixed, TEXT_BASE_WIDTH * 9.0f);
+			ImGui::TableSetupColumn("Avg (ms)", ImGuiTableColumnFlags_WidthFixed, TEXT_BASE_WIDTH * 9.0f);
+			ImGui::TableSetupColumn("Max (ms)", ImGuiTableColumnFlags_WidthFixed, TEXT_BASE_WIDTH * 9.0f);
+			ImGui::TableHeadersRow();
+
+			for (u32 i = 0; i < numZoneStats; ++i)
+			{
+				const r2::prof::ZoneStats& stats = zoneStats[i];
+
+				ImGui::TableNextRow();
+
+				ImGui::TableNextColumn();
+				ImGui::Indent(TEXT_BASE_WIDTH * stats.depth);
+				ImGui::TextUnformatted(stats.name);
+				ImGui::Unindent(TEXT_BASE_WIDTH * stats.depth);
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.numCallsLastFrame);
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", stats.lastFrameMs);
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", stats.minMs);
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", stats.AverageMs());
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", stats.maxMs);
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifdef R2_EDITOR
+#ifndef __EDITOR_PROFILER_PANEL_H__
+#define __EDITOR_PROFILER_PANEL_H__
+
+#include "r2/Editor/EditorWidget.h"
+#include "r2/Core/Profiler/Profiler.h"
+
+namespace r2::edit
+{
+	class ProfilerPanel : public EditorWidget
+	{
+	public:
+		ProfilerPanel();
+		~ProfilerPanel();
+		virtual void Init(Editor* noptrEditor) override;
+		virtual void Shutdown() override;
+		virtual void OnEvent(evt::Event& e) override;
+		virtual void Update() override;
+		virtual void Render(u32 dockingSpaceID) override;
+
+	private:
+		float mFrameHistory[r2::prof::NUM_FRAME_HISTORY];
+		char mTraceFilePath[1024];
+		float mSpikeThresholdMs;
+	};
+}
+
+#endif
+#endif
@@ -107,7 +107,7 @@ namespace r2::edit
 	{
 		r2::ecs::SceneGraph& sceneGraph = mnoptrEditor->GetSceneGraph();
 
-		r2::SArray<ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, ecs::MAX_NUM_ENTITIES);
+		r2::SArray<ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, sceneGraph.GetNumEntitiesInScene());
 
 		sceneGraph.GetAllChildrenForEntity(parent.entity, *children);
 
@@ -135,8 +135,8 @@ namespace r2::edit
 
 			r2::ecs::SceneGraph& sceneGraph = mnoptrEditor->GetSceneGraph();
 
-			r2::SArray<ecs::Entity>* rootEntities = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, ecs::MAX_NUM_ENTITIES);
-			r2::SArray<u32>* rootIndices = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, u32, ecs::MAX_NUM_ENTITIES);
+			r2::SArray<ecs::Entity>* rootEntities = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, sceneGraph.GetNumEntitiesInScene());
+			r2::SArray<u32>* rootIndices = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, u32, sceneGraph.GetNumEntitiesInScene());
 
 			sceneGraph.GetAllTopLevelEntities(*rootEntities, *rootIndices);
 
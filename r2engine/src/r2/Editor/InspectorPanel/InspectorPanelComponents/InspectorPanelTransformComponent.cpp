@@ -121,12 +121,8 @@ namespace r2::edit
 
 		transform->rotation = glm::quat(glm::radians(eulerAngles));
 
-		if (needsUpdate && !coordinator->HasComponent<ecs::TransformDirtyComponent>(theEntity))
+		if (needsUpdate && !mnoptrEditor->GetSceneGraph().IsTransformDirty(theEntity))
 		{
-
-			ecs::TransformDirtyComponent transformDirtyComponent;
-			transformDirtyComponent.dirtyFlags = dirtyFlags;
-
 			mnoptrEditor->GetSceneGraph().UpdateTransformForEntity(theEntity, dirtyFlags);
 
 
@@ -5,9 +5,9 @@
 
 #include "r2/Game/ECS/Entity.h"
 #include "r2/Core/Containers/SArray.h"
-#include "r2/Core/Containers/SHashMap.h"
 #include "r2/Core/Memory/InternalEngineMemory.h"
 #include "r2/Core/Memory/Memory.h"
+#include "r2/Core/Memory/Allocators/MallocAllocator.h"
 #include "r2/Game/ECS/ComponentArrayData_generated.h"
 
 #include "r2/Game/ECS/Serialization/ComponentArraySerialization.h"
@@ -19,7 +19,12 @@
 
 namespace r2::ecs
 {
-	
+	//@NOTE(Serge): components are stored densely in fixed size chunks that get allocated as the array grows so we only pay for what we use
+	//				and pointers to components stay valid when the array grows. The entity of each dense component is kept in a parallel
+	//				chunked array, and the entity index -> dense index lookup is split into pages that only get allocated once an entity in
+	//				that range gets a component.
+	static const u32 COMPONENT_CHUNK_SIZE = 1024;
+	static const u32 ENTITY_TO_INDEX_PAGE_SIZE = 4096;
 
 	class IComponentArray
 	{
@@ -32,11 +37,14 @@ namespace r2::ecs
 		virtual std::string GetComponentName() const = 0;
 #endif
 		virtual b32 IsInstanced() const = 0;
+		virtual u32 NumComponents() const = 0;
+		//The entities of the dense components from chunkIndex * COMPONENT_CHUNK_SIZE on, in the same order as the components
+		virtual const Entity* GetEntityChunk(u32 chunkIndex, u32& numEntitiesInChunk) const = 0;
 		virtual flatbuffers::Offset<flat::ComponentArrayData> Serialize(flatbuffers::FlatBufferBuilder& builder) const = 0;
+		//entitySignatures is parallel to entityRemap.entities
 		virtual void DeSerializeForEntities(
 			ECSWorld& ecsWorld,
-			const r2::SArray<Entity>* entitiesToAddComponentsTo,
-			const r2::SArray<const flat::EntityData*>* refEntityData,
+			const SerializedEntityRemap& entityRemap,
 			r2::SArray<Signature>* entitySignatures,
 			ComponentType componentType,
 			const flat::ComponentArrayData* componentArrayData) = 0;
@@ -51,158 +59,228 @@ namespace r2::ecs
 
 		ComponentArray()
 			: mHashName (0)
-			, mComponentArray(nullptr)
-			, mEntityToIndexMap(nullptr)
-			, mIndexToEntityMap(nullptr)
+			, mnoptrChunkArena(nullptr)
+			, mComponentChunks(nullptr)
+			, mEntityChunks(nullptr)
+			, mEntityToIndexPages(nullptr)
+			, mNumComponents(0)
+			, mMaxNumEntities(0)
 		{
 		}
 
 		~ComponentArray()
 		{
-			R2_CHECK(mComponentArray == nullptr, "Should be null already");
-			R2_CHECK(mEntityToIndexMap == nullptr, "Should be null already");
-			R2_CHECK(mIndexToEntityMap == nullptr, "Should be null already");
+			R2_CHECK(mComponentChunks == nullptr, "Should be null already");
+			R2_CHECK(mEntityChunks == nullptr, "Should be null already");
+			R2_CHECK(mEntityToIndexPages == nullptr, "Should be null already");
 		}
 
 		template<class ARENA>
-		bool Init(ARENA& arena, u32 maxNumEntities, u64 hashName, const char* componentName, b32 isInstanced)
+		bool Init(ARENA& arena, r2::mem::MallocArena* chunkArena, u32 maxNumEntities, u64 hashName, const char* componentName, b32 isInstanced)
 		{
+			R2_CHECK(chunkArena != nullptr, "We need an arena to allocate the component chunks from");
+
 			mHashName = hashName;
 #ifdef R2_EDITOR
 			mComponentName = componentName;
 #endif
 			mIsInstanced = isInstanced;
 			mPadding = false;
-			mComponentArray = MAKE_SARRAY(arena, Component, maxNumEntities);
+			mnoptrChunkArena = chunkArena;
+			mNumComponents = 0;
+			mMaxNumEntities = maxNumEntities;
+
+			mComponentChunks = MAKE_SARRAY(arena, Component*, NumChunks(maxNumEntities));
 
-			if (mComponentArray == nullptr)
+			if (mComponentChunks == nullptr)
 			{
-				R2_CHECK(false, "Failed to create the component array!");
+				R2_CHECK(false, "Failed to create the component chunks!");
 				return false;
 			}
 
-			mEntityToIndexMap = MAKE_SARRAY(arena, s32, maxNumEntities+1);
-			if (!mEntityToIndexMap)
+			mEntityChunks = MAKE_SARRAY(arena, Entity*, NumChunks(maxNumEntities));
+
+			if (!mEntityChunks)
 			{
-				R2_CHECK(false, "Failed to create mEntityToIndexMap!");
+				R2_CHECK(false, "Failed to create the entity chunks!");
 				return false;
 			}
 
-			r2::sarr::Fill(*mEntityToIndexMap, static_cast<s32>(-1));
+			mEntityToIndexPages = MAKE_SARRAY(arena, s32*, NumPages(maxNumEntities));
 
-			mIndexToEntityMap = MAKE_SHASHMAP(arena, Entity, MAX_NUM_ENTITIES * r2::SHashMap<Entity>::LoadFactorMultiplier());
-			if (!mIndexToEntityMap)
+			if (!mEntityToIndexPages)
 			{
-				R2_CHECK(false, "Failed to create mIndexToEntityMap");
+				R2_CHECK(false, "Failed to create mEntityToIndexPages!");
 				return false;
 			}
 
+			r2::sarr::Fill(*mEntityToIndexPages, static_cast<s32*>(nullptr));
+
 			return true;
 		}
 
 		template<class ARENA>
 		void Shutdown(ARENA& arena)
 		{
-			R2_CHECK(r2::sarr::IsEmpty(*mComponentArray), "Should contain no more components at this point");
+			R2_CHECK(mNumComponents == 0, "Should contain no more components at this point");
+
+			FreeChunksAndPages();
 
-			FREE(mIndexToEntityMap, arena);
-			FREE(mEntityToIndexMap, arena);
-			FREE(mComponentArray, arena);
+			FREE(mEntityToIndexPages, arena);
+			FREE(mEntityChunks, arena);
+			FREE(mComponentChunks, arena);
 
-			mComponentArray = nullptr;
-			mEntityToIndexMap = nullptr;
-			mIndexToEntityMap = nullptr;
+			mComponentChunks = nullptr;
+			mEntityChunks = nullptr;
+			mEntityToIndexPages = nullptr;
 		}
 
 		void AddComponent(Entity entity, Component component)
 		{
-			R2_CHECK(mComponentArray != nullptr, "ComponentArray not initialized!");
-			R2_CHECK(mEntityToIndexMap != nullptr, "ComponentArray not initialized!");
-			R2_CHECK(mIndexToEntityMap != nullptr, "ComponentArray not initialized!");
+			R2_CHECK(mComponentChunks != nullptr, "ComponentArray not initialized!");
+			R2_CHECK(mEntityToIndexPages != nullptr, "ComponentArray not initialized!");
 
 			//first check to see if this entity already exists in this component array
-			R2_CHECK(r2::sarr::At(*mEntityToIndexMap, entity) == -1, "We already have a component associated with this entity");
+			R2_CHECK(GetDenseIndex(entity) == -1, "We already have a component associated with this entity");
+			R2_CHECK(mNumComponents < mMaxNumEntities, "We're out of space for components");
 
-			const auto index = static_cast<s32>(r2::sarr::Size(*mComponentArray));
-			r2::sarr::Push(*mComponentArray, component);
+			const auto index = static_cast<s32>(mNumComponents);
+
+			if (GetChunkIndex(index) == r2::sarr::Size(*mComponentChunks))
+			{
+				if (!AddChunk())
+				{
+					return;
+				}
+			}
 
-			r2::sarr::At(*mEntityToIndexMap, entity) = index;
+			ComponentAt(index) = component;
+			EntityAt(index) = entity;
+			++mNumComponents;
 
-			r2::shashmap::Set(*mIndexToEntityMap, index, entity);
+			SetDenseIndex(entity, index);
 		}
 
-		void RemoveComponent(Entity entity, FreeComponentFunc freeFunc)
+		//Adds count components at once for entities that don't have this component yet. The components get copied in a chunk at a time
+		//instead of one by one like AddComponent.
+		void AddComponents(const Entity* entities, const Component* components, u32 count)
 		{
-			R2_CHECK(r2::sarr::At(*mEntityToIndexMap, entity) != -1, "We should already have this entity in the component array");
+			R2_CHECK(mComponentChunks != nullptr, "ComponentArray not initialized!");
+			R2_CHECK(mEntityToIndexPages != nullptr, "ComponentArray not initialized!");
+			R2_CHECK(mNumComponents + count <= mMaxNumEntities, "We're out of space for components");
+
+			u32 numAdded = 0;
+
+			while (numAdded < count)
+			{
+				const u32 denseIndex = mNumComponents;
+
+				if (GetChunkIndex(denseIndex) == r2::sarr::Size(*mComponentChunks))
+				{
+					if (!AddChunk())
+					{
+						return;
+					}
+				}
+
+				const u32 numToCopy = std::min(count - numAdded, COMPONENT_CHUNK_SIZE - (denseIndex % COMPONENT_CHUNK_SIZE));
 
-			s32 defaultIndex = -1;
-			auto indexOfRemovedEntity = r2::sarr::At(*mEntityToIndexMap, entity);
-			R2_CHECK(indexOfRemovedEntity != defaultIndex, "This must exist!");
+#ifdef R2_DEBUG
+				for (u32 i = 0; i < numToCopy; ++i)
+				{
+					R2_CHECK(GetDenseIndex(entities[numAdded + i]) == -1, "We already have a component associated with this entity");
+				}
+#endif
+
+				Component* componentsDst = &ComponentAt(denseIndex);
+
+				if constexpr (std::is_trivially_copyable_v<Component>)
+				{
+					memcpy(componentsDst, components + numAdded, sizeof(Component) * numToCopy);
+				}
+				else
+				{
+					for (u32 i = 0; i < numToCopy; ++i)
+					{
+						componentsDst[i] = components[numAdded + i];
+					}
+				}
+
+				memcpy(&EntityAt(denseIndex), entities + numAdded, sizeof(Entity) * numToCopy);
+
+				mNumComponents += numToCopy;
+
+				for (u32 i = 0; i < numToCopy; ++i)
+				{
+					SetDenseIndex(entities[numAdded + i], static_cast<s32>(denseIndex + i));
+				}
+
+				numAdded += numToCopy;
+			}
+		}
+
+		void RemoveComponent(Entity entity, FreeComponentFunc freeFunc)
+		{
+			auto indexOfRemovedEntity = GetDenseIndex(entity);
+			R2_CHECK(indexOfRemovedEntity != -1, "We should already have this entity in the component array");
 
 			if (freeFunc)
 			{
-				Component& component = r2::sarr::At(*mComponentArray, indexOfRemovedEntity);
+				Component& component = ComponentAt(indexOfRemovedEntity);
 				freeFunc(&component);
 			}
 
-			s32 indexOfLastElement = r2::sarr::Size(*mComponentArray) - 1;
+			s32 indexOfLastElement = static_cast<s32>(mNumComponents) - 1;
 
-			const Entity& entityOfLastElement = r2::shashmap::Get(*mIndexToEntityMap, indexOfLastElement, INVALID_ENTITY);
+			const Entity entityOfLastElement = EntityAt(indexOfLastElement);
 			
 			R2_CHECK(entityOfLastElement != INVALID_ENTITY, "Should not be invalid");
 
-			r2::sarr::RemoveAndSwapWithLastElement(*mComponentArray, indexOfRemovedEntity);
-			
-			r2::sarr::At(*mEntityToIndexMap, entityOfLastElement) = indexOfRemovedEntity;
-			r2::shashmap::Set(*mIndexToEntityMap, indexOfRemovedEntity, entityOfLastElement);
+			ComponentAt(indexOfRemovedEntity) = ComponentAt(indexOfLastElement);
+			EntityAt(indexOfRemovedEntity) = entityOfLastElement;
+			EntityAt(indexOfLastElement) = INVALID_ENTITY;
+			--mNumComponents;
 
-			r2:sarr::At(*mEntityToIndexMap, entity) = -1;
-			r2::shashmap::Remove(*mIndexToEntityMap, indexOfLastElement);
+			SetDenseIndex(entityOfLastElement, indexOfRemovedEntity);
+			SetDenseIndex(entity, -1);
 		}
 
 		Component& GetComponent(Entity entity)
 		{
-			R2_CHECK(r2::sarr::At(*mEntityToIndexMap, entity) != -1, "We should already have this entity in the component array");
-
-			const s32 defaultIndex = -1;
-			s32 index = r2::sarr::At(*mEntityToIndexMap, entity);
-			R2_CHECK(index != defaultIndex, "Should never happen!");
+			s32 index = GetDenseIndex(entity);
+			R2_CHECK(index != -1, "We should already have this entity in the component array");
 
-			return r2::sarr::At(*mComponentArray, index);
+			return ComponentAt(index);
 		}
 
 		Component* GetComponentPtr(Entity entity)
 		{
-			const s32 defaultIndex = -1;
-			s32 index = r2::sarr::At(*mEntityToIndexMap, entity);
+			s32 index = GetDenseIndex(entity);
 
-			if (defaultIndex == index)
+			if (index == -1)
 			{
 				return nullptr;
 			}
 
-			return &r2::sarr::At(*mComponentArray, index);
+			return &ComponentAt(index);
 		}
 
 		void SetComponent(Entity entity, const Component& component, FreeComponentFunc freeFunc)
 		{
-			R2_CHECK(r2::sarr::At(*mEntityToIndexMap, entity) != -1, "We should already have this entity in the component array");
-
-			const s32 defaultIndex = -1;
-			s32 index = r2::sarr::At(*mEntityToIndexMap, entity);
-			R2_CHECK(index != defaultIndex, "Should never happen!");
+			s32 index = GetDenseIndex(entity);
+			R2_CHECK(index != -1, "We should already have this entity in the component array");
 
 			if (freeFunc)
 			{
-				freeFunc(&r2::sarr::At(*mComponentArray, index));
+				freeFunc(&ComponentAt(index));
 			}
 
-			r2::sarr::At(*mComponentArray, index) = component;
+			ComponentAt(index) = component;
 		}
 
 		void EntityDestroyed(Entity entity, FreeComponentFunc freeComponentFunc) override
 		{
-			if (r2::sarr::At(*mEntityToIndexMap, entity) != -1)
+			if (GetDenseIndex(entity) != -1)
 			{
 				RemoveComponent(entity, freeComponentFunc);
 			}
@@ -210,39 +288,65 @@ namespace r2::ecs
 
 		void DestoryAllEntities(FreeComponentFunc freeComponentFunc) override
 		{
-			const auto numComponents = r2::sarr::Size(*mComponentArray);
-
 			if (freeComponentFunc)
 			{
-				for (u32 i = 0; i < numComponents; ++i)
+				for (u32 i = 0; i < mNumComponents; ++i)
 				{
-					freeComponentFunc(&r2::sarr::At(*mComponentArray, i));
+					freeComponentFunc(&ComponentAt(i));
 				}
 			}
 
-			r2::sarr::Clear(*mComponentArray);
-			r2::sarr::Clear(*mEntityToIndexMap);
-			r2::sarr::Fill(*mEntityToIndexMap, static_cast<s32>(-1));
-			r2::shashmap::Clear(*mIndexToEntityMap);
+			mNumComponents = 0;
+
+			FreeChunksAndPages();
+		}
+
+		u32 NumComponents() const override
+		{
+			return mNumComponents;
+		}
+
+		const Entity* GetEntityChunk(u32 chunkIndex, u32& numEntitiesInChunk) const override
+		{
+			const u32 chunkStart = chunkIndex * COMPONENT_CHUNK_SIZE;
+
+			if (chunkStart >= mNumComponents)
+			{
+				numEntitiesInChunk = 0;
+				return nullptr;
+			}
+
+			numEntitiesInChunk = std::min(mNumComponents - chunkStart, COMPONENT_CHUNK_SIZE);
+
+			return r2::sarr::At(*mEntityChunks, chunkIndex);
+		}
+
+		Component& GetComponentAtIndex(u32 denseIndex)
+		{
+			R2_CHECK(denseIndex < mNumComponents, "denseIndex: %u is out of range", denseIndex);
+			return ComponentAt(denseIndex);
 		}
 
 		flatbuffers::Offset<flat::ComponentArrayData> Serialize(flatbuffers::FlatBufferBuilder& builder) const override
 		{
+			r2::SArray<Component>* components = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, Component, std::max(mNumComponents, 1u));
+
+			r2::SArray<flatbuffers::Offset<flat::EntityToIndexMapEntry>>* entityToIndexEntries = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, flatbuffers::Offset<flat::EntityToIndexMapEntry>, std::max(mNumComponents, 1u));
+
+			for (u32 i = 0; i < mNumComponents; ++i)
+			{
+				r2::sarr::Push(*components, ComponentAt(i));
+			}
+
 			flatbuffers::FlatBufferBuilder subFlatBufferBuilder;
-			SerializeComponentArray(subFlatBufferBuilder, *mComponentArray);
+			SerializeComponentArray(subFlatBufferBuilder, *components);
 			
 			auto componentArrayData = builder.CreateVector(subFlatBufferBuilder.GetBufferPointer(), subFlatBufferBuilder.GetSize());
 
-			r2::SArray<flatbuffers::Offset<flat::EntityToIndexMapEntry>>* entityToIndexEntries = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, flatbuffers::Offset<flat::EntityToIndexMapEntry>, r2::sarr::Capacity(*mEntityToIndexMap));
-
-			for (u32 i = 0; i < r2::sarr::Capacity(*mEntityToIndexMap); ++i)
+			for (u32 i = 0; i < mNumComponents; ++i)
 			{
-				auto index = r2::sarr::At(*mEntityToIndexMap, i);
-				if (index != -1)
-				{
-					auto entry = flat::CreateEntityToIndexMapEntry(builder, i, index);
-					r2::sarr::Push(*entityToIndexEntries, entry);
-				}
+				auto entry = flat::CreateEntityToIndexMapEntry(builder, GetEntityIndex(EntityAt(i)), static_cast<s32>(i));
+				r2::sarr::Push(*entityToIndexEntries, entry);
 			}
 
 			auto entityToIndexMapVec = builder.CreateVector(entityToIndexEntries->mData, entityToIndexEntries->mSize);
@@ -255,69 +359,73 @@ namespace r2::ecs
 			auto flatComponentArray = componentArrayDataBuilder.Finish();
 
 			FREE(entityToIndexEntries, *MEM_ENG_SCRATCH_PTR);
+			FREE(components, *MEM_ENG_SCRATCH_PTR);
 
 			return flatComponentArray;
 		}
 
 		void DeSerializeForEntities(
 			ECSWorld& ecsWorld,
-			const r2::SArray<Entity>* entitiesToAddComponentsTo,
-			const r2::SArray<const flat::EntityData*>* refEntityData,
+			const SerializedEntityRemap& entityRemap,
 			r2::SArray<Signature>* entitySignatures,
 			ComponentType componentType,
 			const flat::ComponentArrayData* componentArrayData) override
 		{
 			R2_CHECK(componentArrayData != nullptr, "Can't be nullptr");
-			R2_CHECK(entitiesToAddComponentsTo != nullptr, "Can't be nullptr");
-			R2_CHECK(refEntityData != nullptr, "Can't be nullptr");
-			const auto numEntitiesToAddComponentsTo = r2::sarr::Size(*entitiesToAddComponentsTo);
-			const auto numRefEntities = r2::sarr::Size(*refEntityData);
+			R2_CHECK(entityRemap.entities != nullptr, "Can't be nullptr");
+			R2_CHECK(entityRemap.entityIDToIndex != nullptr, "Can't be nullptr");
+			R2_CHECK(r2::sarr::Size(*entityRemap.entities) == r2::sarr::Size(*entitySignatures), "These should be the same");
 
-			R2_CHECK(numEntitiesToAddComponentsTo == numRefEntities, "These should be the same");
+			const auto* entityToIndexMap = componentArrayData->entityToIndexMap();
 
-			r2::SArray<Component>* tempComponents = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, Component, MAX_NUM_ENTITIES);
+			const u32 numSerializedComponents = entityToIndexMap ? entityToIndexMap->size() : 0;
+
+			r2::SArray<Component>* tempComponents = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, Component, std::max(numSerializedComponents, 1u));
 
 			R2_CHECK(mHashName == componentArrayData->componentType(), "These should be the same");
 
-			DeSerializeComponentArray(ecsWorld, *tempComponents, entitiesToAddComponentsTo, refEntityData, componentArrayData);
+			DeSerializeComponentArray(ecsWorld, *tempComponents, entityRemap, componentArrayData);
 
-			r2::SArray<Component>* realComponents = tempComponents;
+			const u32 numComponents = r2::sarr::Size(*tempComponents);
 
-			const auto* entityToIndexMap = componentArrayData->entityToIndexMap();
-
-			if (!r2::sarr::IsEmpty(*realComponents))
+			if (numComponents > 0)
 			{
-				for (flatbuffers::uoffset_t j = 0; j < entityToIndexMap->size(); ++j)
+				R2_CHECK(numComponents == numSerializedComponents, "Every component should have an entry in the entityToIndexMap");
+
+				r2::SArray<Entity>* entitiesToAdd = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, Entity, numSerializedComponents);
+
+				//Components are serialized in dense order so the entries almost always line up with the components and we can add them all at once
+				bool entriesInComponentOrder = true;
+
+				for (flatbuffers::uoffset_t j = 0; j < numSerializedComponents; ++j)
 				{
 					const auto* entry = entityToIndexMap->Get(j);
-					s32 componentIndex = -1;
 
-					s32 entitySignatureIndex = -1;
-					for (u32 i = 0; i < numRefEntities; ++i)
-					{
-						const flat::EntityData* entityData = r2::sarr::At(*refEntityData, i);
-
-						if (entry->entity() == entityData->entityID())
-						{
-							componentIndex = entry->index();
-							entitySignatureIndex = static_cast<s32>(i);
-							break;
-						}
-					}
+					const s32 entitySignatureIndex = GetSerializedEntityIndex(entry->entity(), entityRemap);
 
-					R2_CHECK(componentIndex != -1, "Should never happen");
 					R2_CHECK(entitySignatureIndex != -1, "Should never happen");
+					R2_CHECK(entry->index() >= 0 && static_cast<u32>(entry->index()) < numComponents, "Should never happen");
 
-					Entity e = r2::sarr::At(*entitiesToAddComponentsTo, entitySignatureIndex);
-
-					const auto& component = r2::sarr::At(*realComponents, componentIndex);
+					r2::sarr::Push(*entitiesToAdd, r2::sarr::At(*entityRemap.entities, entitySignatureIndex));
 
-					AddComponent(e, component);
+					r2::sarr::At(*entitySignatures, entitySignatureIndex).set(componentType, true);
 
-					auto& signature = r2::sarr::At(*entitySignatures, entitySignatureIndex);
+					entriesInComponentOrder = entriesInComponentOrder && entry->index() == static_cast<s32>(j);
+				}
 
-					signature.set(componentType, true);
+				if (entriesInComponentOrder)
+				{
+					AddComponents(r2::sarr::Begin(*entitiesToAdd), r2::sarr::Begin(*tempComponents), numComponents);
 				}
+				else
+				{
+					for (flatbuffers::uoffset_t j = 0; j < numSerializedComponents; ++j)
+					{
+						AddComponent(r2::sarr::At(*entitiesToAdd, j), r2::sarr::At(*tempComponents, entityToIndexMap->Get(j)->index()));
+					}
+				}
+
+				FREE(entitiesToAdd, *MEM_ENG_SCRATCH_PTR);
 			}
 
 			FREE(tempComponents, *MEM_ENG_SCRATCH_PTR);
@@ -338,15 +446,16 @@ namespace r2::ecs
 			return mIsInstanced;
 		}
 
+		//Only the chunk and page tables come out of the ECS arena, the chunks and pages themselves come from the chunk arena as they're needed
 		static u64 MemorySize(u32 maxNumEntities, u64 alignment, u32 headerSize, u32 boundsChecking)
 		{
 			u64 memorySize = 0;
 
 			memorySize += 
 				r2::mem::utils::GetMaxMemoryForAllocation(sizeof(ComponentArray<Component>), alignment, headerSize, boundsChecking) +
-				r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Component>::MemorySize(maxNumEntities), alignment, headerSize, boundsChecking) +
-				r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s32>::MemorySize(maxNumEntities+1), alignment, headerSize, boundsChecking) +
-				r2::mem::utils::GetMaxMemoryForAllocation(r2::SHashMap<Entity>::MemorySize(maxNumEntities * r2::SHashMap<u32>::LoadFactorMultiplier()), alignment, headerSize, boundsChecking);
+				r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Component*>::MemorySize(NumChunks(maxNumEntities)), alignment, headerSize, boundsChecking) +
+				r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Entity*>::MemorySize(NumChunks(maxNumEntities)), alignment, headerSize, boundsChecking) +
+				r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s32*>::MemorySize(NumPages(maxNumEntities)), alignment, headerSize, boundsChecking);
 
 			return memorySize;
 		}
@@ -360,15 +469,140 @@ namespace r2::ecs
 		}
 
 	private:
+
+		static u32 NumChunks(u32 maxNumEntities)
+		{
+			return std::max((maxNumEntities + COMPONENT_CHUNK_SIZE - 1) / COMPONENT_CHUNK_SIZE, 1u);
+		}
+
+		static u32 NumPages(u32 maxNumEntities)
+		{
+			//entity indices go from 1 to maxNumEntities inclusive
+			return (maxNumEntities + ENTITY_TO_INDEX_PAGE_SIZE) / ENTITY_TO_INDEX_PAGE_SIZE;
+		}
+
+		static u32 GetChunkIndex(u32 denseIndex)
+		{
+			return denseIndex / COMPONENT_CHUNK_SIZE;
+		}
+
+		Component& ComponentAt(u32 denseIndex) const
+		{
+			return r2::sarr::At(*mComponentChunks, denseIndex / COMPONENT_CHUNK_SIZE)[denseIndex % COMPONENT_CHUNK_SIZE];
+		}
+
+		Entity& EntityAt(u32 denseIndex) const
+		{
+			return r2::sarr::At(*mEntityChunks, denseIndex / COMPONENT_CHUNK_SIZE)[denseIndex % COMPONENT_CHUNK_SIZE];
+		}
+
+		//-1 if the entity doesn't have a component or if it's a stale handle to an index that's been reused
+		s32 GetDenseIndex(Entity entity) const
+		{
+			const u32 entityIndex = GetEntityIndex(entity);
+			const u32 pageIndex = entityIndex / ENTITY_TO_INDEX_PAGE_SIZE;
+
+			if (pageIndex >= r2::sarr::Size(*mEntityToIndexPages))
+			{
+				return -1;
+			}
+
+			const s32* page = r2::sarr::At(*mEntityToIndexPages, pageIndex);
+
+			if (!page)
+			{
+				return -1;
+			}
+
+			const s32 denseIndex = page[entityIndex % ENTITY_TO_INDEX_PAGE_SIZE];
+
+			if (denseIndex == -1 || EntityAt(denseIndex) != entity)
+			{
+				return -1;
+			}
+
+			return denseIndex;
+		}
+
+		void SetDenseIndex(Entity entity, s32 denseIndex)
+		{
+			const u32 entityIndex = GetEntityIndex(entity);
+			const u32 pageIndex = entityIndex / ENTITY_TO_INDEX_PAGE_SIZE;
+
+			R2_CHECK(pageIndex < r2::sarr::Size(*mEntityToIndexPages), "Entity index: %u is past the max number of entities", entityIndex);
+
+			s32*& page = r2::sarr::At(*mEntityToIndexPages, pageIndex);
+
+			if (!page)
+			{
+				if (denseIndex == -1)
+				{
+					return;
+				}
+
+				page = (s32*)(ALLOC_BYTESN(*mnoptrChunkArena, sizeof(s32) * ENTITY_TO_INDEX_PAGE_SIZE, alignof(s32)));
+				R2_CHECK(page != nullptr, "Failed to allocate an entity to index page");
+
+				for (u32 i = 0; i < ENTITY_TO_INDEX_PAGE_SIZE; ++i)
+				{
+					page[i] = -1;
+				}
+			}
+
+			page[entityIndex % ENTITY_TO_INDEX_PAGE_SIZE] = denseIndex;
+		}
+
+		bool AddChunk()
+		{
+			Component* componentChunk = (Component*)(ALLOC_BYTESN(*mnoptrChunkArena, sizeof(Component) * COMPONENT_CHUNK_SIZE, alignof(Component)));
+			Entity* entityChunk = (Entity*)(ALLOC_BYTESN(*mnoptrChunkArena, sizeof(Entity) * COMPONENT_CHUNK_SIZE, alignof(Entity)));
+
+			if (!componentChunk || !entityChunk)
+			{
+				R2_CHECK(false, "Failed to allocate a component chunk");
+				return false;
+			}
+
+			r2::sarr::Push(*mComponentChunks, componentChunk);
+			r2::sarr::Push(*mEntityChunks, entityChunk);
+
+			return true;
+		}
+
+		void FreeChunksAndPages()
+		{
+			for (u32 i = 0; i < r2::sarr::Size(*mComponentChunks); ++i)
+			{
+				FREE((byte*)r2::sarr::At(*mEntityChunks, i), *mnoptrChunkArena);
+				FREE((byte*)r2::sarr::At(*mComponentChunks, i), *mnoptrChunkArena);
+			}
+
+			r2::sarr::Clear(*mComponentChunks);
+			r2::sarr::Clear(*mEntityChunks);
+
+			for (u32 i = 0; i < r2::sarr::Size(*mEntityToIndexPages); ++i)
+			{
+				s32*& page = r2::sarr::At(*mEntityToIndexPages, i);
+				if (page)
+				{
+					FREE((byte*)page, *mnoptrChunkArena);
+					page = nullptr;
+				}
+			}
+		}
+
 		u64 mHashName;
 		b32 mIsInstanced;
 		b32 mPadding;
 #ifdef R2_EDITOR
 		std::string mComponentName;
 #endif
-		r2::SArray<Component>* mComponentArray;
-		r2::SArray<s32>* mEntityToIndexMap;
-		r2::SHashMap<Entity>* mIndexToEntityMap;
+		r2::mem::MallocArena* mnoptrChunkArena;
+		r2::SArray<Component*>* mComponentChunks;
+		r2::SArray<Entity*>* mEntityChunks;
+		r2::SArray<s32*>* mEntityToIndexPages;
+		u32 mNumComponents;
+		u32 mMaxNumEntities;
 	};
 }
 
@@ -35,6 +35,8 @@ namespace r2::ecs
 			, mComponentTypes(nullptr)
 			, mComponentHashNameMap(nullptr)
 			, mFreeComponentFuncMap(nullptr)
+			, mnoptrChunkArena(nullptr)
+			, mMaxNumEntities(0)
 		{
 		}
 
@@ -54,7 +56,7 @@ namespace r2::ecs
 			R2_CHECK(componentArray != nullptr, "componentArray is nullptr");
 			componentArray->mShouldSerialize = shouldSerialize;
 
-			bool isInitialized = componentArray->Init(arena, MAX_NUM_ENTITIES, componentTypeHash, componentName, isInstanced);
+			bool isInitialized = componentArray->Init(arena, mnoptrChunkArena, mMaxNumEntities, componentTypeHash, componentName, isInstanced);
 
 			R2_CHECK(isInitialized, "Couldn't initialize the componentArray!");
 
@@ -110,9 +112,13 @@ namespace r2::ecs
 		}
 
 		template<class ARENA>
-		bool Init(ARENA& arena, u32 maxNumComponents)
+		bool Init(ARENA& arena, r2::mem::MallocArena* chunkArena, u32 maxNumComponents, u32 maxNumEntities)
 		{
 			R2_CHECK(maxNumComponents > 0, "This should be non zero");
+			R2_CHECK(maxNumEntities > 0, "This should be non zero");
+
+			mnoptrChunkArena = chunkArena;
+			mMaxNumEntities = maxNumEntities;
 
 			mComponentArrays = MAKE_SARRAY(arena, IComponentArray*, maxNumComponents);
 
@@ -315,7 +321,7 @@ namespace r2::ecs
 			}
 		}
 
-		void DeSerialize(ECSWorld& ecsWorld, const r2::SArray<ecs::Entity>* ecsEntitiesToPopulate, const r2::SArray<const flat::EntityData*>* refEntityData, r2::SArray<Signature>* entitySignatures, const flatbuffers::Vector<flatbuffers::Offset<flat::ComponentArrayData>>* componentArrays)
+		void DeSerialize(ECSWorld& ecsWorld, const SerializedEntityRemap& entityRemap, r2::SArray<Signature>* entitySignatures, const flatbuffers::Vector<flatbuffers::Offset<flat::ComponentArrayData>>* componentArrays)
 		{
 			//We need the mComponentArrays to exist already because we have no reflection in order to load the component arrays from flatbuffers
 			R2_CHECK(componentArrays->size() <= r2::sarr::Size(*mComponentArrays), "Right now these should be the same or the flatbuffer data should have less (since we don't serialize all of them) - ie. mComponentArrays should exist already");
@@ -346,7 +352,7 @@ namespace r2::ecs
 				
 				R2_CHECK(componentTypeIndex != defaultIndex, "Should never happen");
 
-				componentArrayToLoad->DeSerializeForEntities(ecsWorld, ecsEntitiesToPopulate, refEntityData, entitySignatures, componentTypeIndex, componentArray);
+				componentArrayToLoad->DeSerializeForEntities(ecsWorld, entityRemap, entitySignatures, componentTypeIndex, componentArray);
 			}
 		}
 
@@ -449,12 +455,6 @@ namespace r2::ecs
 
 			return componentTypeHash;
 		}
-	private:
-		r2::SArray<IComponentArray*>* mComponentArrays;
-		r2::SHashMap<ComponentType>* mComponentTypes; //I guess these are the indices of the component arrays?
-		r2::SHashMap<u64>* mComponentHashNameMap;
-		r2::SHashMap<FreeComponentFunc>* mFreeComponentFuncMap;
-
 		template<typename Component>
 		ComponentArray<Component>* GetComponentArray()
 		{
@@ -464,6 +464,15 @@ namespace r2::ecs
 
 			return static_cast<ComponentArray<Component>*>(componentArrayI);
 		}
+
+	private:
+		r2::SArray<IComponentArray*>* mComponentArrays;
+		r2::SHashMap<ComponentType>* mComponentTypes; //I guess these are the indices of the component arrays?
+		r2::SHashMap<u64>* mComponentHashNameMap;
+		r2::SHashMap<FreeComponentFunc>* mFreeComponentFuncMap;
+		r2::mem::MallocArena* mnoptrChunkArena;
+		u32 mMaxNumEntities;
+
 	};
 }
 
@@ -3,6 +3,8 @@
 
 namespace r2::ecs
 {
+	//Not an actual component anymore - the SceneGraphTransformUpdateSystem keeps one of these per dirty entity along with a dirty bit
+	//so marking a transform dirty doesn't change the entity's signature. Use SceneGraph::SetTransformDirty to set it.
 	struct TransformDirtyComponent
 	{
 		unsigned int dirtyFlags = 0;
@@ -40,6 +40,11 @@ namespace r2::ecs
 		mSystemManager->DestoryAllEntities();
 	}
 
+	void ECSCoordinator::SortDeferredSystems()
+	{
+		mSystemManager->SortDeferredSystems();
+	}
+
 	const r2::SArray<Entity>& ECSCoordinator::GetAllLivingEntities()
 	{
 		return mEntityManager->GetCreatedEntities();
@@ -50,6 +55,16 @@ namespace r2::ecs
 		return mEntityManager->NumLivingEntities();
 	}
 
+	u32 ECSCoordinator::MaxNumEntities() const
+	{
+		return mEntityManager->MaxNumEntities();
+	}
+
+	bool ECSCoordinator::IsAlive(Entity entity) const
+	{
+		return mEntityManager->IsAlive(entity);
+	}
+
 	Signature& ECSCoordinator::GetSignature(Entity e)
 	{
 		return mEntityManager->GetSignature(e);
@@ -68,22 +83,38 @@ namespace r2::ecs
 
 		R2_CHECK(numLiveEntities == levelEntities->size(), "These should be the same");
 
-		r2::SArray<const flat::EntityData*>* flatEntities = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, const flat::EntityData*, numLiveEntities);
 		r2::SArray<Signature>* entitySignatures = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, Signature, numLiveEntities);
 
+		u32 maxSerializedEntityID = 0;
+
 		for (flatbuffers::uoffset_t i = 0; i < numLiveEntities; ++i)
 		{
 			//not sure how this should work - currently the entities might not match up perfectly (in terms of their values)
 			//but they should match in the sense that the entities will effectively be the same
 			Entity nextECSEntity = CreateEntity();
-			const flat::EntityData* nextFlatEntity = levelEntities->Get(i);
 
 			level.AddEntity(nextECSEntity);
-			r2::sarr::Push(*flatEntities, nextFlatEntity);	
 			r2::sarr::Push(*entitySignatures, {});
+
+			maxSerializedEntityID = std::max(maxSerializedEntityID, levelEntities->Get(i)->entityID());
+		}
+
+		//maps the serialized entity ids to the index of the entity in the level so the component arrays can look up their entities directly
+		r2::SArray<s32>* entityIDToIndex = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, s32, maxSerializedEntityID + 1);
+		r2::sarr::Fill(*entityIDToIndex, -1);
+
+		for (flatbuffers::uoffset_t i = 0; i < numLiveEntities; ++i)
+		{
+			s32& entityIndex = r2::sarr::At(*entityIDToIndex, levelEntities->Get(i)->entityID());
+			R2_CHECK(entityIndex == -1, "We have 2 entities with the same id in the level");
+			entityIndex = static_cast<s32>(i);
 		}
 
-		mComponentManager->DeSerialize(ecsWorld, level.GetEntities(), flatEntities, entitySignatures, flatLevelData->componentArrays());
+		SerializedEntityRemap entityRemap;
+		entityRemap.entities = level.GetEntities();
+		entityRemap.entityIDToIndex = entityIDToIndex;
+
+		mComponentManager->DeSerialize(ecsWorld, entityRemap, entitySignatures, flatLevelData->componentArrays());
 
 		//now set the entity signatures
 		const r2::SArray<ecs::Entity>* newEntities = level.GetEntities();
@@ -95,8 +126,8 @@ namespace r2::ecs
 
 		mSystemManager->DeSerializeEntitySignatures(level.GetEntities(), entitySignatures);
 
+		FREE(entityIDToIndex, *MEM_ENG_SCRATCH_PTR);
 		FREE(entitySignatures, *MEM_ENG_SCRATCH_PTR);
-		FREE(flatEntities, *MEM_ENG_SCRATCH_PTR);
 	}
 
 	void ECSCoordinator::UnloadAllECSDataFromLevel(const Level& level)
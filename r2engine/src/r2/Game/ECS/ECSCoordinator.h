@@ -6,6 +6,8 @@
 #include "r2/Game/ECS/Entity.h"
 #include "r2/Game/ECS/ComponentManager.h"
 #include "r2/Game/ECS/SystemManager.h"
+#include <tuple>
+#include <type_traits>
 
 namespace r2
 {
@@ -21,6 +23,28 @@ namespace r2::ecs
 {
 	class ECSWorld;
 
+	//Marks a component in ForEach as optional. The callback gets a pointer for it that's nullptr when the entity doesn't have one.
+	template<typename Component>
+	struct Optional
+	{
+	};
+
+	template<typename T>
+	struct QueryTraits
+	{
+		using ComponentType = T;
+		using ArgType = T&;
+		static constexpr bool IsOptional = false;
+	};
+
+	template<typename T>
+	struct QueryTraits<Optional<T>>
+	{
+		using ComponentType = T;
+		using ArgType = T*;
+		static constexpr bool IsOptional = true;
+	};
+
 	class ECSCoordinator
 	{
 	public:
@@ -28,7 +52,7 @@ namespace r2::ecs
 		~ECSCoordinator();
 
 		template<class ARENA>
-		bool Init(ARENA& arena, u32 maxNumComponents, u32 maxNumEntities, u32 startingEntity, u32 maxNumSystems)
+		bool Init(ARENA& arena, r2::mem::MallocArena* componentChunkArena, u32 maxNumComponents, u32 maxNumEntities, u32 startingEntity, u32 maxNumSystems)
 		{
 			mEntityManager = ALLOC(EntityManager, arena);
 
@@ -42,7 +66,7 @@ namespace r2::ecs
 
 			R2_CHECK(mComponentManager != nullptr, "Failed to create the ComponentManager");
 
-			bool componentManagerInitialized = mComponentManager->Init<ARENA>(arena, maxNumComponents);
+			bool componentManagerInitialized = mComponentManager->Init<ARENA>(arena, componentChunkArena, maxNumComponents, maxNumEntities);
 
 			R2_CHECK(componentManagerInitialized, "Failed to initialize the ComponentManager");
 
@@ -50,7 +74,7 @@ namespace r2::ecs
 
 			R2_CHECK(mSystemManager != nullptr, "Failed to create the SystemManager");
 
-			bool systemManagerInitialized = mSystemManager->Init<ARENA>(arena, maxNumSystems);
+			bool systemManagerInitialized = mSystemManager->Init<ARENA>(arena, maxNumSystems, maxNumEntities);
 			
 			R2_CHECK(systemManagerInitialized, "Failed to initialize the SystemManager");
 
@@ -75,9 +99,13 @@ namespace r2::ecs
 		Entity CreateEntity();
 		void DestroyEntity(Entity entity);
 		void DestoryAllEntities();
+
+		void SortDeferredSystems();
 		const r2::SArray<Entity>& GetAllLivingEntities();
 
 		u32 NumLivingEntities() const;
+		u32 MaxNumEntities() const;
+		bool IsAlive(Entity entity) const;
 
 		void LoadAllECSDataFromLevel(ECSWorld& ecsWorld, const Level& level, const flat::LevelData* levelData);
 		void UnloadAllECSDataFromLevel(const Level& level);
@@ -192,6 +220,50 @@ namespace r2::ecs
 			mComponentManager->SetComponent(entity, component);
 		}
 
+		//Calls func(entity, components...) for every entity that has all of the non optional components, ie.
+		//	ForEach<TransformComponent, RenderComponent, Optional<SkeletalAnimationComponent>>(
+		//		[](Entity e, TransformComponent& transform, RenderComponent& render, SkeletalAnimationComponent* animation) {...});
+		//
+		//@NOTE(Serge): this walks the dense chunks of the required component with the fewest components in order so that one is read linearly
+		//				and the rest are looked up by entity. The visiting order isn't stable so don't use it for things that need to be sorted
+		//				(ie. the scene graph). Don't add or remove any of the required components from inside of func.
+		template<typename... Components, typename Func>
+		void ForEach(Func&& func)
+		{
+			static_assert(sizeof...(Components) > 0, "We need at least one component to query");
+			static_assert((!QueryTraits<Components>::IsOptional || ...), "At least one of the components can't be optional");
+
+			std::tuple<ComponentArray<typename QueryTraits<Components>::ComponentType>*...> componentArrays{
+				mComponentManager->GetComponentArray<typename QueryTraits<Components>::ComponentType>()... };
+
+			Signature requiredSignature;
+			IComponentArray* leadArray = nullptr;
+
+			(AddToQuery<Components>(std::get<ComponentArray<typename QueryTraits<Components>::ComponentType>*>(componentArrays), requiredSignature, leadArray), ...);
+
+			const u32 numComponents = leadArray->NumComponents();
+
+			for (u32 chunkIndex = 0; chunkIndex * COMPONENT_CHUNK_SIZE < numComponents; ++chunkIndex)
+			{
+				u32 numEntitiesInChunk = 0;
+				const Entity* entities = leadArray->GetEntityChunk(chunkIndex, numEntitiesInChunk);
+
+				for (u32 i = 0; i < numEntitiesInChunk; ++i)
+				{
+					const Entity e = entities[i];
+
+					if ((mEntityManager->GetSignature(e) & requiredSignature) != requiredSignature)
+					{
+						continue;
+					}
+
+					const u32 denseIndex = chunkIndex * COMPONENT_CHUNK_SIZE + i;
+
+					func(e, GetQueryComponent<Components>(std::get<ComponentArray<typename QueryTraits<Components>::ComponentType>*>(componentArrays), leadArray, denseIndex, e)...);
+				}
+			}
+		}
+
 		template<typename Component>
 		ComponentType GetComponentType()
 		{
@@ -262,13 +334,45 @@ namespace r2::ecs
 		static u64 MemorySize(u32 maxNumComponents, u32 maxNumEntities, u32 maxNumSystems, u64 alignment, u32 headerSize, u32 boundsChecking);
 
 		template <typename SystemType>
-		static u64 MemorySizeOfSystemType(const r2::mem::utils::MemoryProperties& memProperties)
+		static u64 MemorySizeOfSystemType(u32 maxNumEntities, const r2::mem::utils::MemoryProperties& memProperties)
 		{
-			return SystemManager::MemorySizeOfSystemType<SystemType>(memProperties);
+			return SystemManager::MemorySizeOfSystemType<SystemType>(maxNumEntities, memProperties);
 		}
 
 	private:
 
+		template<typename QueryComponent, typename Component>
+		void AddToQuery(ComponentArray<Component>* componentArray, Signature& requiredSignature, IComponentArray*& leadArray)
+		{
+			if constexpr (!QueryTraits<QueryComponent>::IsOptional)
+			{
+				requiredSignature.set(mComponentManager->GetComponentType<Component>(), true);
+
+				if (!leadArray || componentArray->NumComponents() < leadArray->NumComponents())
+				{
+					leadArray = componentArray;
+				}
+			}
+		}
+
+		template<typename QueryComponent, typename Component>
+		static typename QueryTraits<QueryComponent>::ArgType GetQueryComponent(ComponentArray<Component>* componentArray, const IComponentArray* leadArray, u32 denseIndex, Entity e)
+		{
+			if constexpr (QueryTraits<QueryComponent>::IsOptional)
+			{
+				return componentArray->GetComponentPtr(e);
+			}
+			else
+			{
+				if (componentArray == leadArray)
+				{
+					return componentArray->GetComponentAtIndex(denseIndex);
+				}
+
+				return componentArray->GetComponent(e);
+			}
+		}
+
 		EntityManager* mEntityManager;
 		ComponentManager* mComponentManager;
 		SystemManager* mSystemManager;
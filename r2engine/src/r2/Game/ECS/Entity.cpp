@@ -8,7 +8,10 @@ namespace r2::ecs
 	EntityManager::EntityManager()
 		: mAvailbleEntities(nullptr)
 		, mCreatedEntities(nullptr)
+		, mCreatedEntityIndices(nullptr)
+		, mGenerations(nullptr)
 		, mEntitySignatures(nullptr)
+		, mMaxNumEntities(0)
 	{
 	}
 
@@ -35,6 +38,8 @@ namespace r2::ecs
 
 		r2::squeue::PopFront(*mAvailbleEntities);
 
+		r2::sarr::At(*mCreatedEntityIndices, GetEntityIndex(e)) = static_cast<u32>(r2::sarr::Size(*mCreatedEntities));
+
 		r2::sarr::Push(*mCreatedEntities, e);
 
 		return e;
@@ -55,15 +60,27 @@ namespace r2::ecs
 		}
 
 
-		s64 index = r2::sarr::IndexOf(*mCreatedEntities, entity);
+		if (!IsAlive(entity))
+		{
+			R2_CHECK(false, "Trying to destroy an entity that has already been destroyed");
+			return;
+		}
+
+		const u32 entityIndex = GetEntityIndex(entity);
+		const u32 createdIndex = r2::sarr::At(*mCreatedEntityIndices, entityIndex);
+
+		r2::sarr::At(*mEntitySignatures, entityIndex) = {};
 
-		R2_CHECK(index != -1, "Shouldn't ever happen");
+		//keep the index of the entity that gets swapped into the destroyed one's place up to date
+		const Entity lastEntity = r2::sarr::Last(*mCreatedEntities);
+		r2::sarr::At(*mCreatedEntityIndices, GetEntityIndex(lastEntity)) = createdIndex;
+		r2::sarr::At(*mCreatedEntityIndices, entityIndex) = INVALID_CREATED_INDEX;
 
-		r2::sarr::At(*mEntitySignatures, entity) = {};
+		r2::sarr::RemoveAndSwapWithLastElement(*mCreatedEntities, createdIndex);
 
-		r2::sarr::RemoveAndSwapWithLastElement(*mCreatedEntities, index);
+		const u32 nextGeneration = ++r2::sarr::At(*mGenerations, entityIndex);
 
-		r2::squeue::PushFront(*mAvailbleEntities, entity);
+		r2::squeue::PushFront(*mAvailbleEntities, MakeEntity(entityIndex, nextGeneration));
 	}
 
 	void EntityManager::DestoryAllEntities()
@@ -73,7 +90,12 @@ namespace r2::ecs
 
 		for (u32 i = 0; i < r2::sarr::Size(*mCreatedEntities); ++i)
 		{
-			r2::squeue::PushFront(*mAvailbleEntities, r2::sarr::At(*mCreatedEntities, i));
+			const u32 entityIndex = GetEntityIndex(r2::sarr::At(*mCreatedEntities, i));
+			const u32 nextGeneration = ++r2::sarr::At(*mGenerations, entityIndex);
+
+			r2::sarr::At(*mCreatedEntityIndices, entityIndex) = INVALID_CREATED_INDEX;
+
+			r2::squeue::PushFront(*mAvailbleEntities, MakeEntity(entityIndex, nextGeneration));
 		}
 
 		r2::sarr::Clear(*mCreatedEntities);
@@ -90,14 +112,32 @@ namespace r2::ecs
 		return r2::sarr::Size(*mCreatedEntities);
 	}
 
+	u32 EntityManager::MaxNumEntities() const
+	{
+		return mMaxNumEntities;
+	}
+
+	bool EntityManager::IsAlive(Entity entity) const
+	{
+		const u32 entityIndex = GetEntityIndex(entity);
+
+		if (entity == INVALID_ENTITY || entityIndex > mMaxNumEntities)
+		{
+			return false;
+		}
+
+		return r2::sarr::At(*mCreatedEntityIndices, entityIndex) != INVALID_CREATED_INDEX &&
+			r2::sarr::At(*mGenerations, entityIndex) == GetEntityGeneration(entity);
+	}
+
 	void EntityManager::SetSignature(Entity entity, Signature signature)
 	{
-		r2::sarr::At(*mEntitySignatures, entity) = signature;
+		r2::sarr::At(*mEntitySignatures, GetEntityIndex(entity)) = signature;
 	}
 
 	Signature& EntityManager::GetSignature(Entity entity)
 	{
-		return r2::sarr::At(*mEntitySignatures, entity);
+		return r2::sarr::At(*mEntitySignatures, GetEntityIndex(entity));
 	}
 
 	const r2::SArray<Entity>& EntityManager::GetCreatedEntities() const
@@ -112,7 +152,7 @@ namespace r2::ecs
 		for (u32 i = 0; i <numCreatedEntities; ++i)
 		{
 			Entity e = r2::sarr::At(*mCreatedEntities, i);
-			auto entityData = flat::CreateEntityData(builder, e);
+			auto entityData = flat::CreateEntityData(builder, GetEntityIndex(e));
 			entityVec.push_back(entityData);
 		}
 	}
@@ -122,7 +162,8 @@ namespace r2::ecs
 		return
 			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(EntityManager), alignment, headerSize, boundsChecking) +
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Entity>::MemorySize(maxEntities), alignment, headerSize, boundsChecking) +
-			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Signature>::MemorySize(maxEntities), alignment, headerSize, boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u32>::MemorySize(maxEntities + 1), alignment, headerSize, boundsChecking) * 2 +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Signature>::MemorySize(maxEntities + 1), alignment, headerSize, boundsChecking) +
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SQueue<Entity>::MemorySize(maxEntities), alignment, headerSize, boundsChecking);
 	}
 
@@ -131,23 +172,25 @@ namespace r2::ecs
 		return entity != INVALID_ENTITY;
 	}
 
-	Entity MapSerializedEntity(u32 entityToMap, const r2::SArray<Entity>* entities, const r2::SArray<const flat::EntityData*>* refEntities)
+	s32 GetSerializedEntityIndex(u32 serializedEntityID, const SerializedEntityRemap& entityRemap)
 	{
-		//We can't just map the entity directly since we don't guarantee the same entity values
-		s32 entityIndex = -1;
-		for (u32 j = 0; j < r2::sarr::Size(*refEntities); ++j)
+		if (!entityRemap.entityIDToIndex || serializedEntityID >= r2::sarr::Size(*entityRemap.entityIDToIndex))
 		{
-			if (r2::sarr::At(*refEntities, j)->entityID() == entityToMap)
-			{
-				entityIndex = j;
-				break;
-			}
+			return -1;
 		}
 
+		return r2::sarr::At(*entityRemap.entityIDToIndex, serializedEntityID);
+	}
+
+	Entity MapSerializedEntity(u32 entityToMap, const SerializedEntityRemap& entityRemap)
+	{
+		//We can't just map the entity directly since we don't guarantee the same entity values
+		const s32 entityIndex = GetSerializedEntityIndex(entityToMap, entityRemap);
+
 		Entity result = INVALID_ENTITY;
 		if (entityIndex != -1)
 		{
-			result = r2::sarr::At(*entities, entityIndex);
+			result = r2::sarr::At(*entityRemap.entities, entityIndex);
 		}
 
 		return result;
@@ -26,10 +26,29 @@ namespace r2::ecs
 		KEEP_GLOBAL
 	};
 
+	//@NOTE(Serge): the low 32 bits of an entity are its index and the high 32 bits are its generation. The generation gets bumped every time
+	//				an index is destroyed so old handles to a reused index can be detected with IsAlive. Only the index gets serialized.
 	using Entity = u64;
 	
 	static const Entity INVALID_ENTITY = 0;
-	static const u32 MAX_NUM_ENTITIES = 1000; //I dunno yet
+
+	//The default for a world, the actual max is what gets passed into ECSWorld::Init
+	static const u32 DEFAULT_MAX_NUM_ENTITIES = 65536;
+
+	inline u32 GetEntityIndex(Entity entity)
+	{
+		return static_cast<u32>(entity & 0xFFFFFFFF);
+	}
+
+	inline u32 GetEntityGeneration(Entity entity)
+	{
+		return static_cast<u32>(entity >> 32);
+	}
+
+	inline Entity MakeEntity(u32 index, u32 generation)
+	{
+		return (static_cast<Entity>(generation) << 32) | static_cast<Entity>(index);
+	}
 
 	class EntityManager
 	{
@@ -42,6 +61,8 @@ namespace r2::ecs
 		{
 			R2_CHECK(startingEntity > 0, "We can't use 0 as our starting entity since 0 means INVALID_ENTITY currently");
 
+			mMaxNumEntities = maxNumEntities;
+
 			mAvailbleEntities = MAKE_SQUEUE(arena, Entity, maxNumEntities);
 
 			if (!mAvailbleEntities)
@@ -52,7 +73,7 @@ namespace r2::ecs
 
 			for (Entity i = startingEntity; i < (maxNumEntities + 1); ++i) //@NOTE(Serge): adding one here to offset the fact that 0 isn't possible
 			{
-				r2::squeue::PushBack(*mAvailbleEntities, i);
+				r2::squeue::PushBack(*mAvailbleEntities, MakeEntity(static_cast<u32>(i), 0));
 			}
 
 			mCreatedEntities = MAKE_SARRAY(arena, Entity, maxNumEntities);
@@ -64,11 +85,39 @@ namespace r2::ecs
 				return false;
 			}
 
-			mEntitySignatures = MAKE_SARRAY(arena, Signature, maxNumEntities);
+			//Where each entity index is in mCreatedEntities so that destroying an entity doesn't have to search for it
+			mCreatedEntityIndices = MAKE_SARRAY(arena, u32, maxNumEntities + 1);
 
-			if ( !mEntitySignatures)
+			if (!mCreatedEntityIndices)
+			{
+				FREE(mCreatedEntities, arena);
+				FREE(mAvailbleEntities, arena);
+				R2_CHECK(false, "We couldn't allocate the mCreatedEntityIndices!");
+				return false;
+			}
+
+			r2::sarr::Fill(*mCreatedEntityIndices, INVALID_CREATED_INDEX);
+
+			mGenerations = MAKE_SARRAY(arena, u32, maxNumEntities + 1);
+
+			if (!mGenerations)
 			{
+				FREE(mCreatedEntityIndices, arena);
+				FREE(mCreatedEntities, arena);
 				FREE(mAvailbleEntities, arena);
+				R2_CHECK(false, "We couldn't allocate the mGenerations!");
+				return false;
+			}
+
+			r2::sarr::Fill(*mGenerations, 0u);
+
+			mEntitySignatures = MAKE_SARRAY(arena, Signature, maxNumEntities + 1);
+
+			if ( !mEntitySignatures)
+			{
+				FREE(mGenerations, arena);
+				FREE(mCreatedEntityIndices, arena);
+				FREE(mCreatedEntities, arena);
 				FREE(mAvailbleEntities, arena);
 				R2_CHECK(false, "We couldn't allocate the mEntitySignatures!");
 				return false;
@@ -85,6 +134,12 @@ namespace r2::ecs
 			FREE(mEntitySignatures, arena);
 			mEntitySignatures = nullptr;
 
+			FREE(mGenerations, arena);
+			mGenerations = nullptr;
+
+			FREE(mCreatedEntityIndices, arena);
+			mCreatedEntityIndices = nullptr;
+
 			FREE(mCreatedEntities, arena);
 			mCreatedEntities = nullptr;
 
@@ -97,6 +152,10 @@ namespace r2::ecs
 		void DestoryAllEntities();
 
 		u32 NumLivingEntities() const;
+		u32 MaxNumEntities() const;
+
+		//false for entities that have been destroyed even if their index has been reused since
+		bool IsAlive(Entity entity) const;
 		
 		void SetSignature(Entity entity, Signature signature);
 		Signature& GetSignature(Entity entity);
@@ -110,13 +169,27 @@ namespace r2::ecs
 
 
 	private:
+		static const u32 INVALID_CREATED_INDEX = 0xFFFFFFFF;
+
 		r2::SQueue<Entity>* mAvailbleEntities;
 		r2::SArray<Entity>* mCreatedEntities;
+		r2::SArray<u32>* mCreatedEntityIndices;
+		r2::SArray<u32>* mGenerations;
 		r2::SArray<Signature>* mEntitySignatures;
+		u32 mMaxNumEntities;
 	};
 
 
-	Entity MapSerializedEntity(u32 entityToMap, const r2::SArray<Entity>* entities, const r2::SArray<const flat::EntityData*>* refEntities);
+	//Built once when a level is loaded - maps the entity IDs the level was serialized with to the entities that were created for them
+	struct SerializedEntityRemap
+	{
+		const r2::SArray<Entity>* entities = nullptr;
+		const r2::SArray<s32>* entityIDToIndex = nullptr; //index into entities, -1 if the level doesn't have an entity with that ID
+	};
+
+	//-1 if the level doesn't have an entity with that ID
+	s32 GetSerializedEntityIndex(u32 serializedEntityID, const SerializedEntityRemap& entityRemap);
+	Entity MapSerializedEntity(u32 entityToMap, const SerializedEntityRemap& entityRemap);
 }
 
 #endif
\ No newline at end of file
@@ -29,7 +29,7 @@ namespace r2::ecs
 
 			flat::AudioListenerComponentDataBuilder audioListenerComponentBuilder(fbb);
 			audioListenerComponentBuilder.add_listener(flatAudioListener);
-			audioListenerComponentBuilder.add_entityToFollow(audioListenerComponent.entityToFollow);
+			audioListenerComponentBuilder.add_entityToFollow(GetEntityIndex(audioListenerComponent.entityToFollow));
 			
 			r2::sarr::Push(*audioListenerComponents, audioListenerComponentBuilder.Finish());
 		}
@@ -46,7 +46,7 @@ namespace r2::ecs
 	}
 
 	template<>
-	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<AudioListenerComponent>& components, const r2::SArray<Entity>* entities, const r2::SArray<const flat::EntityData*>* refEntities, const flat::ComponentArrayData* componentArrayData)
+	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<AudioListenerComponent>& components, const SerializedEntityRemap& entityRemap, const flat::ComponentArrayData* componentArrayData)
 	{
 		R2_CHECK(r2::sarr::Size(components) == 0, "Shouldn't have anything in there yet?");
 		R2_CHECK(componentArrayData != nullptr, "Shouldn't be nullptr");
@@ -59,7 +59,7 @@ namespace r2::ecs
 		{
 			const flat::AudioListenerComponentData* flatAudioListenerComponent = componentVector->Get(i);
 
-			Entity entityToFollow = MapSerializedEntity(flatAudioListenerComponent->entityToFollow(), entities, refEntities);
+			Entity entityToFollow = MapSerializedEntity(flatAudioListenerComponent->entityToFollow(), entityRemap);
 
 			AudioListenerComponent newAudioListenerComponent;
 			newAudioListenerComponent.entityToFollow = entityToFollow;
@@ -21,7 +21,7 @@ namespace r2::ecs
 	}
 
 	template<typename Component>
-	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<Component>& components, const r2::SArray<Entity>* entities, const r2::SArray<const flat::EntityData*>* refEntities, const flat::ComponentArrayData* componentArrayData)
+	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<Component>& components, const SerializedEntityRemap& entityRemap, const flat::ComponentArrayData* componentArrayData)
 	{
 		R2_CHECK(false, "You need to implement a deserializer for this type");
 	}
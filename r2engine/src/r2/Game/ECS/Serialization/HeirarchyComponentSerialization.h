@@ -29,7 +29,7 @@ namespace r2::ecs
 
 			flat::HeirarchyComponentDataBuilder heirarchyComponentBuilder(fbb);
 
-			heirarchyComponentBuilder.add_parent(heirarchyComponent.parent);
+			heirarchyComponentBuilder.add_parent(GetEntityIndex(heirarchyComponent.parent));
 
 			r2::sarr::Push(*heirarchyComponents, heirarchyComponentBuilder.Finish());
 		}
@@ -46,7 +46,7 @@ namespace r2::ecs
 	}
 
 	template<>
-	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<HierarchyComponent>& components, const r2::SArray<Entity>* entities, const r2::SArray<const flat::EntityData*>* refEntities, const flat::ComponentArrayData* componentArrayData)
+	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<HierarchyComponent>& components, const SerializedEntityRemap& entityRemap, const flat::ComponentArrayData* componentArrayData)
 	{
 		R2_CHECK(r2::sarr::Size(components) == 0, "Shouldn't have anything in there yet?");
 		R2_CHECK(componentArrayData != nullptr, "Shouldn't be nullptr");
@@ -59,7 +59,7 @@ namespace r2::ecs
 		{
 			const flat::HeirarchyComponentData* flatHeirarchyComponent = componentVector->Get(i);
 
-			Entity parent = MapSerializedEntity(flatHeirarchyComponent->parent(), entities, refEntities);
+			Entity parent = MapSerializedEntity(flatHeirarchyComponent->parent(), entityRemap);
 
 			HierarchyComponent heirarchyComponent;
 			heirarchyComponent.parent = parent;
@@ -130,7 +130,7 @@ namespace r2::ecs
 	}
 
 	template<>
-	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<SkeletalAnimationComponent>& components, const r2::SArray<Entity>* entities, const r2::SArray<const flat::EntityData*>* refEntities, const flat::ComponentArrayData* componentArrayData)
+	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<SkeletalAnimationComponent>& components, const SerializedEntityRemap& entityRemap, const flat::ComponentArrayData* componentArrayData)
 	{
 		const flat::SkeletalAnimationComponentArrayData* skeletalAnimationComponentArrayData = flatbuffers::GetRoot<flat::SkeletalAnimationComponentArrayData>(componentArrayData->componentArray()->data());
 
@@ -182,7 +182,7 @@ namespace r2::ecs
 	}
 
 	template<>
-	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<InstanceComponentT<SkeletalAnimationComponent>>& components, const r2::SArray<Entity>* entities, const r2::SArray<const flat::EntityData*>* refEntities, const flat::ComponentArrayData* componentArrayData)
+	inline void DeSerializeComponentArray(ECSWorld& ecsWorld, r2::SArray<InstanceComponentT<SkeletalAnimationComponent>>& components, const SerializedEntityRemap& entityRemap, const flat::ComponentArrayData* componentArrayData)
 	{
 		const flat::InstancedSkeletalAnimationComponentArrayData* instancedSkeletalAnimationComponentArrayData = flatbuffers::GetRoot<flat::InstancedSkeletalAnimationComponentArrayData>(componentArrayData->componentArray()->data());
 
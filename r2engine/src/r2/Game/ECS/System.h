@@ -13,12 +13,53 @@ namespace r2::ecs
 	struct System
 	{
 		r2::SArray<Entity>* mEntities = nullptr;
+
+		//Sparse set of the entity index -> index into mEntities (-1 if the entity isn't in this system)
+		//so that checking membership, adding and removing don't have to search mEntities
+		r2::SArray<s32>* mEntityIndices = nullptr;
+
+		//mKeepSorted keeps mEntities in order on every insert/remove (FindSortedPlacement or insertion order)
+		//mDeferSort instead just pushes/swaps entities in and sorts them by GetSortKey() once per frame in SystemManager::SortDeferredSystems()
 		bool mKeepSorted = false;
+		bool mDeferSort = false;
+		bool mNeedsSort = false;
 		ECSCoordinator* mnoptrCoordinator = nullptr;
 
 		virtual s32 FindSortedPlacement(Entity e) { return -1; }
+		virtual u64 GetSortKey(Entity e) const { return GetEntityIndex(e); }
+		//called after a deferred sort so the system can rebuild anything that depends on the order of mEntities
+		virtual void EntitiesSorted() {}
+		//called by the SystemManager after the entity's signature starts/stops matching this system (or it's destroyed)
+		virtual void EntityAdded(Entity e) {}
+		virtual void EntityRemoved(Entity e) {}
+		//called when every entity is removed at once without going through EntityRemoved
+		virtual void AllEntitiesRemoved() {}
 		virtual void Update() {}
 		virtual void Render() {}
+
+		s32 IndexOfEntity(Entity e) const
+		{
+			const u32 entityIndex = GetEntityIndex(e);
+
+			if (mEntityIndices == nullptr || entityIndex >= r2::sarr::Size(*mEntityIndices))
+			{
+				return -1;
+			}
+
+			const s32 index = r2::sarr::At(*mEntityIndices, entityIndex);
+
+			if (index == -1 || r2::sarr::At(*mEntities, index) != e)
+			{
+				return -1;
+			}
+
+			return index;
+		}
+
+		bool HasEntity(Entity e) const
+		{
+			return IndexOfEntity(e) != -1;
+		}
 	};
 }
 
@@ -2,12 +2,14 @@
 
 #include "r2/Game/ECS/SystemManager.h"
 #include "r2/Game/ECS/System.h"
+#include "r2/Core/Memory/InternalEngineMemory.h"
 
 namespace r2::ecs
 {
 	SystemManager::SystemManager()
 		: mSystems(nullptr)
 		, mSignatures(nullptr)
+		, mMaxNumEntities(0)
 	{
 	}
 	SystemManager::~SystemManager()
@@ -22,22 +24,13 @@ namespace r2::ecs
 
 		for (; iter != r2::shashmap::End(*mSystems); ++iter)
 		{
-			const auto& system = iter->value;
+			System* system = iter->value;
 
-			r2::SArray<Entity>* entities = iter->value->mEntities;
-
-			s64 index = r2::sarr::IndexOf(*entities, entity);
+			s32 index = system->IndexOfEntity(entity);
 			
 			if (index != -1)
 			{
-				if (!system->mKeepSorted)
-				{
-					r2::sarr::RemoveAndSwapWithLastElement(*entities, index);
-				}
-				else
-				{
-					RemoveEntityKeepSorted(system, entity, index);
-				}
+				RemoveEntityFromSystem(system, entity, index);
 			}
 		}
 	}
@@ -49,41 +42,25 @@ namespace r2::ecs
 		for (; iter != r2::shashmap::End(*mSystems); ++iter)
 		{
 			const auto& type = iter->key;
-			const auto& system = iter->value;
+			System* system = iter->value;
 
 			Signature emptySignature = {};
 			const Signature & systemSignature = r2::shashmap::Get(*mSignatures, type, emptySignature);
 
-			s64 index = r2::sarr::IndexOf(*system->mEntities, entity);
+			s32 index = system->IndexOfEntity(entity);
 
 			if ((entitySignature & systemSignature) == systemSignature)
 			{
 				if (index == -1)
 				{
-					s32 placement = system->FindSortedPlacement(entity);
-
-					if (system->mKeepSorted && placement != -1)
-					{
-						r2::sarr::Insert(*system->mEntities, placement, entity);
-					}
-					else
-					{
-						r2::sarr::Push(*system->mEntities, entity);
-					}
+					AddEntityToSystem(system, entity);
 				}
 			}
 			else
 			{
 				if (index != -1)
 				{
-					if (!system->mKeepSorted)
-					{
-						r2::sarr::RemoveAndSwapWithLastElement(*system->mEntities, index);
-					}
-					else
-					{
-						RemoveEntityKeepSorted(system, entity, index);
-					}
+					RemoveEntityFromSystem(system, entity, index);
 				}
 			}
 		}
@@ -91,12 +68,36 @@ namespace r2::ecs
 
 	void SystemManager::DeSerializeEntitySignatures(const r2::SArray<Entity>* entities, const r2::SArray<Signature>* entitySignatures)
 	{
+		//Loaded entities are brand new so we only ever add them. Going system by system means we only look up each system's signature once
+		//and deferred sort systems get sorted once at the end of the frame instead of per entity
 		const u32 numEntities = r2::sarr::Size(*entities);
-		for (u32 i = 0; i < numEntities; ++i)
+
+		R2_CHECK(numEntities == r2::sarr::Size(*entitySignatures), "These should be the same");
+
+		auto iter = r2::shashmap::Begin(*mSystems);
+
+		for (; iter != r2::shashmap::End(*mSystems); ++iter)
 		{
-			Entity e = r2::sarr::At(*entities, i);
+			const auto& type = iter->key;
+			System* system = iter->value;
 
-			EntitySignatureChanged(e, r2::sarr::At(*entitySignatures, i));
+			Signature emptySignature = {};
+			const Signature systemSignature = r2::shashmap::Get(*mSignatures, type, emptySignature);
+
+			for (u32 i = 0; i < numEntities; ++i)
+			{
+				if ((r2::sarr::At(*entitySignatures, i) & systemSignature) != systemSignature)
+				{
+					continue;
+				}
+
+				Entity e = r2::sarr::At(*entities, i);
+
+				if (system->IndexOfEntity(e) == -1)
+				{
+					AddEntityToSystem(system, e);
+				}
+			}
 		}
 	}
 
@@ -108,15 +109,144 @@ namespace r2::ecs
 			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(SystemManager), alignment, headerSize, boundsChecking) + //maybe not needed?
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SHashMap<System*>::MemorySize(maxNumSystems), alignment, headerSize, boundsChecking) +
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SHashMap<Signature>::MemorySize(maxNumSystems), alignment, headerSize, boundsChecking) +
-			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Entity>::MemorySize(maxNumEntities), alignment, headerSize, boundsChecking) * maxNumSystems
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Entity>::MemorySize(maxNumEntities), alignment, headerSize, boundsChecking) * maxNumSystems +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s32>::MemorySize(maxNumEntities + 1), alignment, headerSize, boundsChecking) * maxNumSystems
 			;
 
 		return memorySize;
 	}
 
-	void SystemManager::RemoveEntityKeepSorted(const System* system, Entity entity, s64 index)
+	void SystemManager::SortDeferredSystems()
 	{
-		r2::sarr::RemoveElementAtIndexShiftLeft(*system->mEntities, index);
+		auto iter = r2::shashmap::Begin(*mSystems);
+
+		for (; iter != r2::shashmap::End(*mSystems); ++iter)
+		{
+			System* system = iter->value;
+
+			if (system->mDeferSort && system->mNeedsSort)
+			{
+				SortSystem(system);
+			}
+		}
+	}
+
+	void SystemManager::AddEntityToSystem(System* system, Entity entity)
+	{
+		const u32 numEntities = static_cast<u32>(r2::sarr::Size(*system->mEntities));
+
+		s32 placement = -1;
+
+		if (system->mKeepSorted && !system->mDeferSort)
+		{
+			placement = system->FindSortedPlacement(entity);
+		}
+
+		if (placement != -1)
+		{
+			r2::sarr::Insert(*system->mEntities, placement, entity);
+
+			//everything after the placement moved up by one
+			for (u32 i = static_cast<u32>(placement); i <= numEntities; ++i)
+			{
+				r2::sarr::At(*system->mEntityIndices, GetEntityIndex(r2::sarr::At(*system->mEntities, i))) = static_cast<s32>(i);
+			}
+		}
+		else
+		{
+			r2::sarr::Push(*system->mEntities, entity);
+			r2::sarr::At(*system->mEntityIndices, GetEntityIndex(entity)) = static_cast<s32>(numEntities);
+
+			if (system->mDeferSort)
+			{
+				system->mNeedsSort = true;
+			}
+		}
+
+		system->EntityAdded(entity);
+	}
+
+	void SystemManager::RemoveEntityFromSystem(System* system, Entity entity, s32 index)
+	{
+		//let the system clean up while the entity is still in it
+		system->EntityRemoved(entity);
+
+		const u32 lastIndex = static_cast<u32>(r2::sarr::Size(*system->mEntities)) - 1;
+
+		r2::sarr::At(*system->mEntityIndices, GetEntityIndex(entity)) = -1;
+
+		if (system->mKeepSorted && !system->mDeferSort)
+		{
+			r2::sarr::RemoveElementAtIndexShiftLeft(*system->mEntities, index);
+
+			//everything after the removed entity moved down by one
+			for (u32 i = static_cast<u32>(index); i < lastIndex; ++i)
+			{
+				r2::sarr::At(*system->mEntityIndices, GetEntityIndex(r2::sarr::At(*system->mEntities, i))) = static_cast<s32>(i);
+			}
+
+			return;
+		}
+
+		r2::sarr::RemoveAndSwapWithLastElement(*system->mEntities, index);
+
+		if (static_cast<u32>(index) != lastIndex)
+		{
+			r2::sarr::At(*system->mEntityIndices, GetEntityIndex(r2::sarr::At(*system->mEntities, index))) = index;
+		}
+
+		if (system->mDeferSort)
+		{
+			system->mNeedsSort = true;
+		}
+	}
+
+	void SystemManager::SortSystem(System* system)
+	{
+		struct SortEntry
+		{
+			u64 key;
+			Entity entity;
+		};
+
+		const u32 numEntities = static_cast<u32>(r2::sarr::Size(*system->mEntities));
+
+		system->mNeedsSort = false;
+
+		if (numEntities <= 1)
+		{
+			system->EntitiesSorted();
+			return;
+		}
+
+		r2::SArray<SortEntry>* sortEntries = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, SortEntry, numEntities);
+
+		for (u32 i = 0; i < numEntities; ++i)
+		{
+			Entity e = r2::sarr::At(*system->mEntities, i);
+			r2::sarr::Push(*sortEntries, { system->GetSortKey(e), e });
+		}
+
+		std::sort(r2::sarr::Begin(*sortEntries), r2::sarr::End(*sortEntries), [](const SortEntry& a, const SortEntry& b)
+		{
+			if (a.key == b.key)
+			{
+				return GetEntityIndex(a.entity) < GetEntityIndex(b.entity);
+			}
+
+			return a.key < b.key;
+		});
+
+		for (u32 i = 0; i < numEntities; ++i)
+		{
+			Entity e = r2::sarr::At(*sortEntries, i).entity;
+			r2::sarr::At(*system->mEntities, i) = e;
+			r2::sarr::At(*system->mEntityIndices, GetEntityIndex(e)) = static_cast<s32>(i);
+		}
+
+		FREE(sortEntries, *MEM_ENG_SCRATCH_PTR);
+
+		system->EntitiesSorted();
 	}
 
 	void SystemManager::DestoryAllEntities()
@@ -126,6 +256,9 @@ namespace r2::ecs
 		for (iter; iter != r2::shashmap::End(*mSystems); ++iter)
 		{
 			r2::sarr::Clear(*iter->value->mEntities);
+			r2::sarr::Fill(*iter->value->mEntityIndices, -1);
+			iter->value->mNeedsSort = iter->value->mDeferSort;
+			iter->value->AllEntitiesRemoved();
 		}
 	}
 
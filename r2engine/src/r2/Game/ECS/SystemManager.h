@@ -17,8 +17,10 @@ namespace r2::ecs
 		~SystemManager();
 
 		template<class ARENA>
-		bool Init(ARENA& arena, u32 maxNumSystems)
+		bool Init(ARENA& arena, u32 maxNumSystems, u32 maxNumEntities)
 		{
+			mMaxNumEntities = maxNumEntities;
+
 			mSystems = MAKE_SHASHMAP(arena, System*, maxNumSystems * r2::SHashMap<System*>::LoadFactorMultiplier());
 
 			if (!mSystems)
@@ -71,7 +73,9 @@ namespace r2::ecs
 
 			SystemType* system = ALLOC(SystemType, arena);
 
-			system->mEntities = MAKE_SARRAY(arena, Entity, MAX_NUM_ENTITIES);
+			system->mEntities = MAKE_SARRAY(arena, Entity, mMaxNumEntities);
+			system->mEntityIndices = MAKE_SARRAY(arena, s32, mMaxNumEntities + 1);
+			r2::sarr::Fill(*system->mEntityIndices, -1);
 
 			r2::shashmap::Set(*mSystems, systemTypeHash, (System*)system);
 
@@ -97,6 +101,7 @@ namespace r2::ecs
 			r2::shashmap::Remove(*mSystems, systemTypeHash);
 			r2::shashmap::Remove(*mSignatures, systemTypeHash);
 
+			FREE(system->mEntityIndices, arena);
 			FREE(system->mEntities, arena);
 
 			FREE(system, arena);
@@ -153,33 +158,44 @@ namespace r2::ecs
 			for (u64 i = fromIndex; i != toIndex; i += direction)
 			{
 				const auto next = i + direction;
-				r2::sarr::At(*system->mEntities, i) = r2::sarr::At(*system->mEntities, next);
+				Entity nextEntity = r2::sarr::At(*system->mEntities, next);
+				r2::sarr::At(*system->mEntities, i) = nextEntity;
+				r2::sarr::At(*system->mEntityIndices, GetEntityIndex(nextEntity)) = static_cast<s32>(i);
 			}
 
 			r2::sarr::At(*system->mEntities, toIndex) = e;
+			r2::sarr::At(*system->mEntityIndices, GetEntityIndex(e)) = static_cast<s32>(toIndex);
 		}
 
+		//Sorts all of the systems that have mDeferSort set and had entities added/removed since the last time this was called.
+		//Should be called once per frame before the systems that care about the order update.
+		void SortDeferredSystems();
+
 		void DestoryAllEntities();
 
 		static u64 MemorySize(u32 maxNumSystems, u32 maxNumEntities, u32 alignment, u32 headerSize, u32 boundsChecking);
 
 		template<typename SystemType>
-		static u64 MemorySizeOfSystemType(const r2::mem::utils::MemoryProperties& memProperties)
+		static u64 MemorySizeOfSystemType(u32 maxNumEntities, const r2::mem::utils::MemoryProperties& memProperties)
 		{
 			u64 memorySize = 0;
 
 			memorySize += r2::mem::utils::GetMaxMemoryForAllocation(sizeof(SystemType), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
-			memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Entity>::MemorySize(MAX_NUM_ENTITIES), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
+			memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Entity>::MemorySize(maxNumEntities), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
+			memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s32>::MemorySize(maxNumEntities + 1), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
 
 			return memorySize;
 		}
 
 	private:
 
-		void RemoveEntityKeepSorted(const System* system, Entity entity, s64 index);
+		void AddEntityToSystem(System* system, Entity entity);
+		void RemoveEntityFromSystem(System* system, Entity entity, s32 index);
+		void SortSystem(System* system);
 
 		r2::SHashMap<System*>* mSystems;
 		r2::SHashMap<Signature>* mSignatures;
+		u32 mMaxNumEntities;
 	};
 }
 
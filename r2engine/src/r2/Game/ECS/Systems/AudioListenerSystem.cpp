@@ -10,6 +10,8 @@
 #include "r2/Platform/Platform.h"
 #include "r2/Core/Engine.h"
 #include "r2/Game/Level/LevelManager.h"
+#include "r2/Game/ECSWorld/ECSWorld.h"
+#include "r2/Game/SceneGraph/SceneGraph.h"
 
 
 namespace r2::ecs
@@ -42,6 +44,8 @@ namespace r2::ecs
 			audioEngine.SetNumListeners(numEntities);
 		}
 
+		const SceneGraph& sceneGraph = MENG.GetECSWorld().GetSceneGraph();
+
 		//now update the 3D attributes
 		for (u32 i = 0; i < numEntities; ++i)
 		{
@@ -50,14 +54,11 @@ namespace r2::ecs
 			AudioListenerComponent& listenerComponent = mnoptrCoordinator->GetComponent<AudioListenerComponent>(e);
 			TransformComponent& transformComponent = mnoptrCoordinator->GetComponent<TransformComponent>(e);
 
-			TransformDirtyComponent* transformDirtyComponent = mnoptrCoordinator->GetComponentPtr<TransformDirtyComponent>(e);
-
-			bool needsUpdate = transformDirtyComponent != nullptr;
+			bool needsUpdate = sceneGraph.IsTransformDirty(e);
 
 			if (listenerComponent.entityToFollow != r2::ecs::INVALID_ENTITY)
 			{
-				TransformDirtyComponent* followTransformDirtyComponent = mnoptrCoordinator->GetComponentPtr<TransformDirtyComponent>(listenerComponent.entityToFollow);
-				needsUpdate = followTransformDirtyComponent != nullptr;
+				needsUpdate = sceneGraph.IsTransformDirty(listenerComponent.entityToFollow);
 			}
 
 			if (!needsUpdate)
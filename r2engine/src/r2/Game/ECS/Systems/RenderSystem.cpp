@@ -42,39 +42,41 @@ namespace r2::ecs
 		R2_CHECK(mEntities != nullptr, "This should never happen");
 		R2_CHECK(mnoptrCoordinator != nullptr, "This should never happen");
 
-		const auto numEntities = r2::sarr::Size(*mEntities);
-
-		for (u32 i = 0; i < numEntities; ++i)
-		{
-			ecs::Entity e = r2::sarr::At(*mEntities, i);
-
-			const TransformComponent& transformComponent = mnoptrCoordinator->GetComponent<TransformComponent>(e);
-			const RenderComponent& renderComponent = mnoptrCoordinator->GetComponent<RenderComponent>(e);
-			const SkeletalAnimationComponent* animationComponent = mnoptrCoordinator->GetComponentPtr<SkeletalAnimationComponent>(e);
-
-			const InstanceComponentT<TransformComponent>* instancedTransformsComponent = mnoptrCoordinator->GetComponentPtr<InstanceComponentT<TransformComponent>>(e);
-			const InstanceComponentT<SkeletalAnimationComponent>* instancedAnimationComponent = mnoptrCoordinator->GetComponentPtr<InstanceComponentT<SkeletalAnimationComponent>>(e);
-
 #ifdef R2_EDITOR
-			bool hasSelectedComponent = mnoptrCoordinator->HasComponent<ecs::SelectionComponent>(e);
-
-			if (hasSelectedComponent)
+		mnoptrCoordinator->ForEach<TransformComponent, RenderComponent, Optional<SkeletalAnimationComponent>, Optional<InstanceComponentT<TransformComponent>>, Optional<InstanceComponentT<SkeletalAnimationComponent>>, Optional<SelectionComponent>>(
+			[this](ecs::Entity e,
+				const TransformComponent& transformComponent,
+				const RenderComponent& renderComponent,
+				const SkeletalAnimationComponent* animationComponent,
+				const InstanceComponentT<TransformComponent>* instancedTransformsComponent,
+				const InstanceComponentT<SkeletalAnimationComponent>* instancedAnimationComponent,
+				const SelectionComponent* selectionComponent)
+		{
+			if (selectionComponent)
 			{
-				const SelectionComponent& selectionComponent = mnoptrCoordinator->GetComponent<ecs::SelectionComponent>(e);
-				DrawRenderComponentSelected(e, selectionComponent, transformComponent, renderComponent, animationComponent, instancedTransformsComponent, instancedAnimationComponent);
+				DrawRenderComponentSelected(e, *selectionComponent, transformComponent, renderComponent, animationComponent, instancedTransformsComponent, instancedAnimationComponent);
 			}
-			else {
-#endif
-
+			else
+			{
 				DrawRenderComponent(e, transformComponent, renderComponent, animationComponent, instancedTransformsComponent, instancedAnimationComponent);
-
-#ifdef R2_EDITOR
 			}
-#endif // R2_EDITOR
 
+			ClearPerFrameData();
+		});
+#else
+		mnoptrCoordinator->ForEach<TransformComponent, RenderComponent, Optional<SkeletalAnimationComponent>, Optional<InstanceComponentT<TransformComponent>>, Optional<InstanceComponentT<SkeletalAnimationComponent>>>(
+			[this](ecs::Entity e,
+				const TransformComponent& transformComponent,
+				const RenderComponent& renderComponent,
+				const SkeletalAnimationComponent* animationComponent,
+				const InstanceComponentT<TransformComponent>* instancedTransformsComponent,
+				const InstanceComponentT<SkeletalAnimationComponent>* instancedAnimationComponent)
+		{
+			DrawRenderComponent(e, transformComponent, renderComponent, animationComponent, instancedTransformsComponent, instancedAnimationComponent);
 
 			ClearPerFrameData();
-		}
+		});
+#endif
 	}
 
 	void RenderSystem::DrawRenderComponent(
@@ -365,12 +367,12 @@ namespace r2::ecs
 		r2::sarr::Clear(*mBatch.boneTransforms);
 	}
 
-	u64 RenderSystem::MemorySize(u32 maxNumInstancesPerModel, u32 maxNumMaterialsPerModel, u32 maxNumShaderBoneTransforms, const r2::mem::utils::MemoryProperties& memorySizeStruct)
+	u64 RenderSystem::MemorySize(u32 maxNumEntities, u32 maxNumInstancesPerModel, u32 maxNumMaterialsPerModel, u32 maxNumShaderBoneTransforms, const r2::mem::utils::MemoryProperties& memorySizeStruct)
 	{
 		u64 memorySize = 0;
 		
 		memorySize +=
-			r2::ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::RenderSystem>(memorySizeStruct) +
+			r2::ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::RenderSystem>(maxNumEntities, memorySizeStruct) +
 			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::mem::StackArena), memorySizeStruct.alignment, memorySizeStruct.headerSize, memorySizeStruct.boundsChecking) +
 			RenderSystemGatherBatch::MemorySize(maxNumInstancesPerModel, maxNumMaterialsPerModel, maxNumShaderBoneTransforms, memorySizeStruct);
 		
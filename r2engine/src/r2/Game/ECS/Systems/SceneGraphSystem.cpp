@@ -30,12 +30,12 @@ namespace r2::ecs
 
 		ecs::Entity parent = heirarchyComponent.parent;
 
-		r2::SArray<ecs::Entity>* entities = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, ecs::MAX_NUM_ENTITIES);
+		r2::SArray<ecs::Entity>* entities = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, mnoptrSceneGraph->GetNumEntitiesInScene());
 		s32 indexToReturn = -1;
 
 		if (parent == ecs::INVALID_ENTITY)
 		{
-			r2::SArray<u32>* indices = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, u32, ecs::MAX_NUM_ENTITIES);
+			r2::SArray<u32>* indices = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, u32, mnoptrSceneGraph->GetNumEntitiesInScene());
 
 			mnoptrSceneGraph->GetAllTopLevelEntities(*entities, *indices);
 
@@ -65,7 +65,7 @@ namespace r2::ecs
 				ecs::Entity sibling = r2::sarr::At(*entities, i);
 				if (e < sibling)
 				{
-					indexToReturn = r2::sarr::IndexOf(*mEntities, sibling);
+					indexToReturn = IndexOfEntity(sibling);
 					break;
 				}
 			}
@@ -5,18 +5,78 @@
 #include "r2/Core/Math/Transform.h"
 #include "r2/Core/Memory/InternalEngineMemory.h"
 #include "r2/Core/Memory/Memory.h"
+#include "r2/Core/Jobs/JobSystem.h"
+#include "r2/Core/Profiler/Profiler.h"
 
 #include "r2/Game/ECS/Components/HierarchyComponent.h"
 #include "r2/Game/ECS/Components/TransformComponent.h"
 #include "r2/Game/ECS/Components/InstanceComponent.h"
-#include "r2/Game/ECS/Components/TransformDirtyComponent.h"
 #include "r2/Game/ECS/ECSCoordinator.h"
+#include "r2/Game/ECS/Systems/SpatialIndexSystem.h"
+
+namespace
+{
+	const r2::math::Transform s_identityTransform = {};
+
+	//Only a local transform change - accum = parent * local. Everything else (attach/detach/global changes) goes down the scalar path
+	inline bool IsLocalTransformUpdate(unsigned int dirtyFlags)
+	{
+		return
+			(dirtyFlags & r2::ecs::eTransformDirtyFlags::ATTACHED_TO_PARENT_DIRTY) == 0 &&
+			(dirtyFlags & r2::ecs::eTransformDirtyFlags::DETACHED_FROM_PARENT_DIRTY) == 0 &&
+			!((dirtyFlags & r2::ecs::eTransformDirtyFlags::GLOBAL_TRANSFORM_DIRTY) != 0 && (dirtyFlags & r2::ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY) == 0);
+	}
+
+	//Collects local transform updates until we have 4 of them then does them all at once with Combine4/ToMatrix4
+	struct TransformBatch
+	{
+		const r2::math::Transform* parents[4];
+		const r2::math::Transform* locals[4];
+		r2::math::Transform* accums[4];
+		glm::mat4* matrices[4];
+		u32 count = 0;
+
+		void Add(const r2::math::Transform* parent, r2::ecs::TransformComponent& transformComponent)
+		{
+			parents[count] = parent;
+			locals[count] = &transformComponent.localTransform;
+			accums[count] = &transformComponent.accumTransform;
+			matrices[count] = &transformComponent.modelMatrix;
+
+			if (++count == 4)
+			{
+				Flush();
+			}
+		}
+
+		void Flush()
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			r2::math::Combine4(parents, locals, accums, count);
+			r2::math::ToMatrix4(accums, matrices, count);
+
+			count = 0;
+		}
+	};
+}
 
 namespace r2::ecs
 {
 	SceneGraphTransformUpdateSystem::SceneGraphTransformUpdateSystem()
+		:mDirtyBits(nullptr)
+		,mDirtyData(nullptr)
+		,mParents(nullptr)
+		,mLevelStarts(nullptr)
+		,mWorkItems(nullptr)
+		,mNumDirty(0)
+		,mnoptrSpatialIndexSystem(nullptr)
 	{
-		mKeepSorted = true;
+		mKeepSorted = false;
+		mDeferSort = true;
 	}
 
 	SceneGraphTransformUpdateSystem::~SceneGraphTransformUpdateSystem()
@@ -26,77 +86,236 @@ namespace r2::ecs
 
 	void SceneGraphTransformUpdateSystem::Update()
 	{
+		R2_PROFILE_FUNCTION();
+
 		R2_CHECK(mnoptrCoordinator != nullptr, "Not sure why this should ever be nullptr?");
 		R2_CHECK(mEntities != nullptr, "Not sure why this should ever be nullptr?");
+		R2_CHECK(!mNeedsSort, "The ECSCoordinator should have sorted us before we update");
 
-		//Don't do anything if we have no entities since math::Combine and math::ToMatrix is fairly expensive
-		const auto numEntitiesToUpdate = r2::sarr::Size(*mEntities);
-		if (numEntitiesToUpdate == 0)
+		//Don't do anything if nothing is dirty since math::Combine and math::ToMatrix is fairly expensive
+		if (mNumDirty == 0)
 			return;
 
-		GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
+		const u32 numLevelStarts = static_cast<u32>(r2::sarr::Size(*mLevelStarts));
 
-		for (u32 i = 0; i < numEntitiesToUpdate; ++i)
+		//levels are done in order since each one needs the accumTransforms of the level above it
+		for (u32 level = 0; level + 1 < numLevelStarts; ++level)
 		{
-			//do the update of the matrices here
-			ecs::Entity entity = r2::sarr::At(*mEntities, i);
+			const u32 levelStart = r2::sarr::At(*mLevelStarts, level);
+			const u32 levelEnd = r2::sarr::At(*mLevelStarts, level + 1);
 
-			//get the hierarchy component and the transform component of the entity
-			const HierarchyComponent& entityHeirarchComponent = mnoptrCoordinator->GetComponent<HierarchyComponent>(entity);
-			TransformComponent& entityTransformComponent = mnoptrCoordinator->GetComponent<TransformComponent>(entity);
-			const TransformDirtyComponent& entityTransformDirtyComponent = mnoptrCoordinator->GetComponent<TransformDirtyComponent>(entity);
+			for (u32 i = levelStart; i < levelEnd; ++i)
+			{
+				const u32 entityIndex = GetEntityIndex(r2::sarr::At(*mEntities, i));
+				const Entity parent = r2::sarr::At(*mParents, i);
 
-			math::Transform parentTransform;
+				u64& dirtyWord = r2::sarr::At(*mDirtyBits, entityIndex / 64);
+				const u64 dirtyBit = 1ull << (entityIndex % 64);
 
-			//now get the transform component of the parent if it exists
-			if (entityHeirarchComponent.parent != INVALID_ENTITY)
-			{
-				TransformComponent& parentTransformComponent = mnoptrCoordinator->GetComponent<TransformComponent>(entityHeirarchComponent.parent);
-				parentTransform = parentTransformComponent.accumTransform;
-			}
+				if ((dirtyWord & dirtyBit) == 0)
+				{
+					//children of anything that was updated need to be updated as well
+					if (parent == INVALID_ENTITY || !IsDirty(parent))
+					{
+						continue;
+					}
 
-			UpdateEntityTransformComponent(parentTransform, entityHeirarchComponent, entityTransformDirtyComponent, entityTransformComponent);
+					dirtyWord |= dirtyBit;
 
-			glm::mat4 worldTransform =  math::ToMatrix(entityTransformComponent.accumTransform);
+					TransformDirtyComponent& dirty = r2::sarr::At(*mDirtyData, entityIndex);
+					dirty = {};
+					dirty.dirtyFlags = eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
+				}
 
-			entityTransformComponent.modelMatrix =  worldTransform;
+				AddWorkForEntity(i);
 
-			InstanceComponentT<TransformComponent>* instanceComponent = mnoptrCoordinator->GetComponentPtr<InstanceComponentT<TransformComponent>>(entity);
-			if (instanceComponent)
-			{
-				for (u32 j = 0; j < instanceComponent->numInstances; j++)
+				if (mnoptrSpatialIndexSystem)
 				{
-					TransformComponent& tranformComponent = r2::sarr::At(*instanceComponent->instances, j);
+					mnoptrSpatialIndexSystem->SetBoundsDirty(r2::sarr::At(*mEntities, i));
+				}
+			}
 
-					UpdateEntityTransformComponent(parentTransform, entityHeirarchComponent, entityTransformDirtyComponent, tranformComponent);
+			ProcessWorkItems();
+		}
 
-					glm::mat4 worldTransform = math::ToMatrix(tranformComponent.accumTransform);
+		r2::sarr::Fill(*mDirtyBits, static_cast<u64>(0));
+		mNumDirty = 0;
+	}
 
-					tranformComponent.modelMatrix = worldTransform;
-				}
+	u64 SceneGraphTransformUpdateSystem::GetSortKey(Entity e) const
+	{
+		const u64 maxDepth = r2::sarr::Size(*mEntities);
+		u64 depth = 0;
+
+		Entity parent = mnoptrCoordinator->GetComponent<HierarchyComponent>(e).parent;
+
+		while (parent != INVALID_ENTITY && depth < maxDepth)
+		{
+			++depth;
+			parent = mnoptrCoordinator->GetComponent<HierarchyComponent>(parent).parent;
+		}
+
+		return (depth << 32) | GetEntityIndex(e);
+	}
+
+	void SceneGraphTransformUpdateSystem::EntitiesSorted()
+	{
+		r2::sarr::Clear(*mParents);
+		r2::sarr::Clear(*mLevelStarts);
+
+		const u32 numEntities = static_cast<u32>(r2::sarr::Size(*mEntities));
+
+		u64 currentDepth = UINT64_MAX;
+
+		for (u32 i = 0; i < numEntities; ++i)
+		{
+			Entity e = r2::sarr::At(*mEntities, i);
+
+			r2::sarr::Push(*mParents, mnoptrCoordinator->GetComponent<HierarchyComponent>(e).parent);
+
+			const u64 depth = GetSortKey(e) >> 32;
+
+			if (depth != currentDepth)
+			{
+				r2::sarr::Push(*mLevelStarts, i);
+				currentDepth = depth;
 			}
 		}
 
-		//We need to make a copy here because we're changing the signature of the entities such that they won't belong 
-		//to our system anymore
-		if (numEntitiesToUpdate > 0)
+		if (numEntities > 0)
+		{
+			r2::sarr::Push(*mLevelStarts, numEntities);
+		}
+	}
+
+	bool SceneGraphTransformUpdateSystem::SetDirty(Entity e, const TransformDirtyComponent& dirty)
+	{
+		const u32 entityIndex = GetEntityIndex(e);
+
+		R2_CHECK(entityIndex < r2::sarr::Size(*mDirtyData), "Entity index is out of range");
+
+		u64& dirtyWord = r2::sarr::At(*mDirtyBits, entityIndex / 64);
+		const u64 dirtyBit = 1ull << (entityIndex % 64);
+
+		if ((dirtyWord & dirtyBit) != 0)
+		{
+			return false;
+		}
+
+		dirtyWord |= dirtyBit;
+		r2::sarr::At(*mDirtyData, entityIndex) = dirty;
+		++mNumDirty;
+
+		return true;
+	}
+
+	bool SceneGraphTransformUpdateSystem::IsDirty(Entity e) const
+	{
+		const u32 entityIndex = GetEntityIndex(e);
+
+		if (entityIndex >= r2::sarr::Size(*mDirtyData))
 		{
-			r2::SArray<Entity>* entitiesCopy = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, Entity, numEntitiesToUpdate);
+			return false;
+		}
+
+		return (r2::sarr::At(*mDirtyBits, entityIndex / 64) & (1ull << (entityIndex % 64))) != 0;
+	}
+
+	void SceneGraphTransformUpdateSystem::HierarchyChanged()
+	{
+		mNeedsSort = true;
+	}
+
+	void SceneGraphTransformUpdateSystem::SetSpatialIndexSystem(SpatialIndexSystem* spatialIndexSystem)
+	{
+		mnoptrSpatialIndexSystem = spatialIndexSystem;
+	}
+
+	void SceneGraphTransformUpdateSystem::AddWorkForEntity(u32 denseIndex)
+	{
+		Entity e = r2::sarr::At(*mEntities, denseIndex);
+		Entity parent = r2::sarr::At(*mParents, denseIndex);
+
+		TransformUpdateWork work;
+		work.transform = &mnoptrCoordinator->GetComponent<TransformComponent>(e);
+		work.instances = mnoptrCoordinator->GetComponentPtr<InstanceComponentT<TransformComponent>>(e);
+		work.hasParent = parent != INVALID_ENTITY;
+		work.parentTransform = work.hasParent ? &mnoptrCoordinator->GetComponent<TransformComponent>(parent).accumTransform : &s_identityTransform;
+		work.dirty = &r2::sarr::At(*mDirtyData, GetEntityIndex(e));
 
-			r2::sarr::Copy(*entitiesCopy, *mEntities);
+		const u32 numInstances = work.instances ? work.instances->numInstances : 0;
 
-			for (u32 i = 0; i < numEntitiesToUpdate; ++i)
+		//split up large instance counts so they can be spread across the job threads
+		u32 instanceStart = 0;
+		do
+		{
+			if (r2::sarr::Size(*mWorkItems) == r2::sarr::Capacity(*mWorkItems))
 			{
-				//remove the dirty flags
-				ecs::Entity e = r2::sarr::At(*entitiesCopy, i);
-				mnoptrCoordinator->RemoveComponent<ecs::TransformDirtyComponent>(e);
+				ProcessWorkItems();
 			}
 
-			FREE(entitiesCopy, *MEM_ENG_SCRATCH_PTR);
+			TransformUpdateWork item = work;
+			item.updateEntity = instanceStart == 0;
+			item.instanceStart = instanceStart;
+			item.instanceEnd = std::min(numInstances, instanceStart + INSTANCES_PER_WORK_ITEM);
+
+			r2::sarr::Push(*mWorkItems, item);
+
+			instanceStart = item.instanceEnd;
+
+		} while (instanceStart < numInstances);
+	}
+
+	void SceneGraphTransformUpdateSystem::ProcessWorkItems()
+	{
+		const u32 numWorkItems = static_cast<u32>(r2::sarr::Size(*mWorkItems));
+
+		if (numWorkItems == 0)
+		{
+			return;
 		}
+
+		const TransformUpdateWork* workItems = r2::sarr::Begin(*mWorkItems);
+
+		auto updateTransform = [this](const TransformUpdateWork& work, TransformComponent& transformComponent, TransformBatch& batch)
+		{
+			if (IsLocalTransformUpdate(work.dirty->dirtyFlags))
+			{
+				batch.Add(work.parentTransform, transformComponent);
+			}
+			else
+			{
+				UpdateEntityTransformComponent(*work.parentTransform, work.hasParent, *work.dirty, transformComponent);
+				transformComponent.modelMatrix = math::ToMatrix(transformComponent.accumTransform);
+			}
+		};
+
+		r2::jobs::ParallelFor(numWorkItems, 16, [workItems, &updateTransform](u32 start, u32 end)
+		{
+			TransformBatch batch;
+
+			for (u32 w = start; w < end; ++w)
+			{
+				const TransformUpdateWork& work = workItems[w];
+
+				if (work.updateEntity)
+				{
+					updateTransform(work, *work.transform, batch);
+				}
+
+				for (u32 j = work.instanceStart; j < work.instanceEnd; ++j)
+				{
+					updateTransform(work, r2::sarr::At(*work.instances->instances, j), batch);
+				}
+			}
+
+			batch.Flush();
+		});
+
+		r2::sarr::Clear(*mWorkItems);
 	}
 
-	void SceneGraphTransformUpdateSystem::UpdateEntityTransformComponent(const math::Transform& parentTransform, const HierarchyComponent& entityHeirarchComponent, const TransformDirtyComponent& entityTransformDirtyComponent, TransformComponent& entityTransformComponent)
+	void SceneGraphTransformUpdateSystem::UpdateEntityTransformComponent(const math::Transform& parentTransform, bool hasParent, const TransformDirtyComponent& entityTransformDirtyComponent, TransformComponent& entityTransformComponent) const
 	{
 		if ((entityTransformDirtyComponent.dirtyFlags & eTransformDirtyFlags::ATTACHED_TO_PARENT_DIRTY) == eTransformDirtyFlags::ATTACHED_TO_PARENT_DIRTY)
 		{
@@ -113,7 +332,7 @@ namespace r2::ecs
 			}
 			else
 			{
-				TransformComponent& oldParentTransform = mnoptrCoordinator->GetComponent<TransformComponent>(entityTransformDirtyComponent.parent);
+				const TransformComponent& oldParentTransform = mnoptrCoordinator->GetComponent<TransformComponent>(entityTransformDirtyComponent.parent);
 
 				entityTransformComponent.localTransform = math::Combine(math::Inverse(oldParentTransform.accumTransform), entityTransformComponent.accumTransform);
 
@@ -123,7 +342,7 @@ namespace r2::ecs
 		else if ((entityTransformDirtyComponent.dirtyFlags & eTransformDirtyFlags::GLOBAL_TRANSFORM_DIRTY) == eTransformDirtyFlags::GLOBAL_TRANSFORM_DIRTY &&
 			(entityTransformDirtyComponent.dirtyFlags & eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY) == 0)
 		{
-			if (entityHeirarchComponent.parent == INVALID_ENTITY)
+			if (!hasParent)
 			{
 				entityTransformComponent.localTransform = entityTransformComponent.accumTransform;
 			}
@@ -137,12 +356,25 @@ namespace r2::ecs
 		else
 		{
 			entityTransformComponent.accumTransform = entityTransformComponent.localTransform;
-			if (entityHeirarchComponent.parent != INVALID_ENTITY)
+			if (hasParent)
 			{
-				//@TODO(Serge): Need to figure out a way to optimize this - very slow at the moment
 				entityTransformComponent.accumTransform = math::Combine(parentTransform, entityTransformComponent.localTransform);
 			}
 		}
 	}
 
-}
\ No newline at end of file
+	u64 SceneGraphTransformUpdateSystem::MemorySize(u32 maxNumEntities, const r2::mem::utils::MemoryProperties& memProperties)
+	{
+		u64 memorySize = 0;
+
+		memorySize +=
+			r2::ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::SceneGraphTransformUpdateSystem>(maxNumEntities, memProperties) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u64>::MemorySize(NumDirtyBitWords(maxNumEntities)), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<TransformDirtyComponent>::MemorySize(maxNumEntities + 1), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<Entity>::MemorySize(maxNumEntities), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u32>::MemorySize(maxNumEntities + 1), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<TransformUpdateWork>::MemorySize(std::min(maxNumEntities, MAX_NUM_WORK_ITEMS)), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
+
+		return memorySize;
+	}
+}
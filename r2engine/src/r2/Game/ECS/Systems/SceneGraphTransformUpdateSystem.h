@@ -2,6 +2,8 @@
 #define __SCENE_GRAPH_TRANSFORM_UPDATE_SYSTEM_H__
 
 #include "r2/Game/ECS/System.h"
+#include "r2/Game/ECS/Components/TransformDirtyComponent.h"
+#include "r2/Core/Memory/Memory.h"
 
 namespace r2::math
 {
@@ -13,22 +15,110 @@ namespace r2::ecs
 
 	struct HierarchyComponent;
 	struct TransformComponent;
-	struct TransformDirtyComponent;
+	class SpatialIndexSystem;
+	template <typename T> struct InstanceComponentT;
 
-	//The purpose of this system is to update the modelMatrix of each entity if the entity needs it 
-	//ie. if there is a TransformDirtyComponent attached to the entity
+	//The purpose of this system is to update the modelMatrix of each entity if the entity needs it
+	//ie. if the entity's transform was marked dirty with SetDirty (SceneGraph::SetTransformDirty)
 	//this way, we only update modelMatrices when needed instead of every frame
+	//
+	//mEntities holds every entity in the scene graph sorted by depth (roots first) so each depth level can be updated in parallel
+	//once the level above it is done. Dirty entities are tracked with a bitset indexed by entity index instead of a component so
+	//marking/clearing dirty transforms doesn't change any signatures.
 	class SceneGraphTransformUpdateSystem : public System
 	{
 	public:
 
 		SceneGraphTransformUpdateSystem();
 		~SceneGraphTransformUpdateSystem();
+
+		template<class ARENA>
+		bool Init(ARENA& arena, u32 maxNumEntities)
+		{
+			mDirtyBits = MAKE_SARRAY(arena, u64, NumDirtyBitWords(maxNumEntities));
+			mDirtyData = MAKE_SARRAY(arena, TransformDirtyComponent, maxNumEntities + 1);
+			mParents = MAKE_SARRAY(arena, Entity, maxNumEntities);
+			mLevelStarts = MAKE_SARRAY(arena, u32, maxNumEntities + 1);
+			mWorkItems = MAKE_SARRAY(arena, TransformUpdateWork, std::min(maxNumEntities, MAX_NUM_WORK_ITEMS));
+
+			R2_CHECK(mDirtyBits && mDirtyData && mParents && mLevelStarts && mWorkItems, "Couldn't allocate the SceneGraphTransformUpdateSystem's data");
+
+			r2::sarr::Fill(*mDirtyBits, static_cast<u64>(0));
+			r2::sarr::Fill(*mDirtyData, TransformDirtyComponent{});
+			mNumDirty = 0;
+
+			return true;
+		}
+
+		template<class ARENA>
+		void Shutdown(ARENA& arena)
+		{
+			FREE(mWorkItems, arena);
+			FREE(mLevelStarts, arena);
+			FREE(mParents, arena);
+			FREE(mDirtyData, arena);
+			FREE(mDirtyBits, arena);
+
+			mWorkItems = nullptr;
+			mLevelStarts = nullptr;
+			mParents = nullptr;
+			mDirtyData = nullptr;
+			mDirtyBits = nullptr;
+		}
+
 		void Update() override;
 
+		//Sorts by depth in the hierarchy so that parents are always updated before their children
+		virtual u64 GetSortKey(Entity e) const override;
+		virtual void EntitiesSorted() override;
+
+		//Returns false if the entity was already dirty - the first dirty flags set in a frame win
+		bool SetDirty(Entity e, const TransformDirtyComponent& dirty);
+		bool IsDirty(Entity e) const;
+
+		//Call when an entity's parent changes so the depth levels get rebuilt
+		void HierarchyChanged();
+
+		//Every entity that gets its transform updated has its bounds marked dirty in the spatial index
+		void SetSpatialIndexSystem(SpatialIndexSystem* spatialIndexSystem);
+
+		static u64 MemorySize(u32 maxNumEntities, const r2::mem::utils::MemoryProperties& memProperties);
+
 	private:
 
-		void UpdateEntityTransformComponent(const r2::math::Transform& parentTransform, const HierarchyComponent& entityHeirarchComponent, const TransformDirtyComponent& entityTransformDirtyComponent, TransformComponent& entityTransformComponent);
+		static constexpr u32 MAX_NUM_WORK_ITEMS = 4096;
+		static constexpr u32 INSTANCES_PER_WORK_ITEM = 256;
+
+		struct TransformUpdateWork
+		{
+			TransformComponent* transform = nullptr;
+			InstanceComponentT<TransformComponent>* instances = nullptr;
+			const r2::math::Transform* parentTransform = nullptr;
+			const TransformDirtyComponent* dirty = nullptr;
+			bool hasParent = false;
+			bool updateEntity = false;
+			u32 instanceStart = 0;
+			u32 instanceEnd = 0;
+		};
+
+		static u32 NumDirtyBitWords(u32 maxNumEntities) { return (maxNumEntities + 1 + 63) / 64; }
+
+		void AddWorkForEntity(u32 denseIndex);
+		void ProcessWorkItems();
+
+		void UpdateEntityTransformComponent(const r2::math::Transform& parentTransform, bool hasParent, const TransformDirtyComponent& entityTransformDirtyComponent, TransformComponent& entityTransformComponent) const;
+
+		r2::SArray<u64>* mDirtyBits;
+		r2::SArray<TransformDirtyComponent>* mDirtyData;
+
+		//parallel to mEntities - rebuilt whenever the entities are sorted
+		r2::SArray<Entity>* mParents;
+		r2::SArray<u32>* mLevelStarts;
+
+		r2::SArray<TransformUpdateWork>* mWorkItems;
+		u32 mNumDirty;
+
+		SpatialIndexSystem* mnoptrSpatialIndexSystem;
 	};
 }
 
@@ -8,6 +8,11 @@
 #include "r2/Game/ECS/Components/InstanceComponent.h"
 #include "r2/Game/ECS/Components/SkeletalAnimationComponent.h"
 #include "r2/Render/Animation/Pose.h"
+#include "r2/Render/Animation/AnimationBatch.h"
+#include "r2/Render/Animation/AnimationClip.h"
+#include "r2/Core/Math/MathUtils.h"
+#include "r2/Core/Memory/InternalEngineMemory.h"
+#include "r2/Core/Profiler/Profiler.h"
 
 namespace r2::ecs
 {
@@ -24,12 +29,37 @@ namespace r2::ecs
 
 	void SkeletalAnimationSystem::Update()
 	{
+		R2_PROFILE_FUNCTION();
+
 		R2_CHECK(mnoptrCoordinator != nullptr, "Not sure why this should ever be nullptr?");
 		R2_CHECK(mEntities != nullptr, "Not sure why this should ever be nullptr?");
 
 		const auto numEntities = r2::sarr::Size(*mEntities);
 		auto deltaTime = r2::util::MillisecondsToSecondsF32(static_cast<float>(CPLAT.TickRate()));
 
+		if (numEntities == 0)
+		{
+			return;
+		}
+
+		u32 maxNumBatchInstances = 0;
+
+		mnoptrCoordinator->ForEach<SkeletalAnimationComponent, Optional<InstanceComponentT<SkeletalAnimationComponent>>>(
+			[&maxNumBatchInstances](Entity e, const SkeletalAnimationComponent& animationComponent, const InstanceComponentT<SkeletalAnimationComponent>* instancedAnimationComponent)
+		{
+			maxNumBatchInstances += 1;
+
+			if (instancedAnimationComponent && !animationComponent.shouldUseSameTransformsForAllInstances)
+			{
+				maxNumBatchInstances += instancedAnimationComponent->numInstances;
+			}
+		});
+
+		//@NOTE(Serge): the transitions and the times are handled here on the main thread since they can add/remove components. 
+		//				The sampling and the matrix palettes are the expensive part and those get done in one batch across all the threads.
+		r2::anim::AnimationBatchInstance* batchInstances = (r2::anim::AnimationBatchInstance*)ALLOC_BYTESN(*MEM_ENG_SCRATCH_PTR, sizeof(r2::anim::AnimationBatchInstance) * maxNumBatchInstances, alignof(r2::anim::AnimationBatchInstance));
+		u32 numBatchInstances = 0;
+
 		for (u32 i = 0; i < numEntities; ++i)
 		{
 			Entity e = r2::sarr::At(*mEntities, i);
@@ -38,34 +68,9 @@ namespace r2::ecs
 
 			AnimationTransitionComponent* animationTransitionComponent = mnoptrCoordinator->GetComponentPtr<AnimationTransitionComponent>(e);
 
-
-			r2::SArray<r2::draw::DebugBone>* debugBonesToUse = nullptr;
-#ifdef R2_DEBUG
-			DebugBoneComponent* debugBoneComponent = mnoptrCoordinator->GetComponentPtr<DebugBoneComponent>(e);
-			InstanceComponentT<DebugBoneComponent>* instancedDebugBoneComponent = mnoptrCoordinator->GetComponentPtr<InstanceComponentT<DebugBoneComponent>>(e);
-
-			if (debugBoneComponent)
-			{
-				R2_CHECK(debugBoneComponent->debugBones != nullptr, "These should not be null");
-				debugBonesToUse = debugBoneComponent->debugBones;
-			}
-#endif
-
 			R2_CHECK(animationComponent.shaderBones != nullptr, "These should not be null");
 
-			u32 numInstancesToAnimate = 1;
 			const u32 numShaderBones = r2::anim::pose::Size(*animationComponent.animModel->animSkeleton.mRestPose);
-			u32 totalNumShaderBones = numShaderBones;
-
-			if (instancedAnimationComponent)
-			{
-				const u32 numInstances = instancedAnimationComponent->numInstances;
-				if (!animationComponent.shouldUseSameTransformsForAllInstances)
-				{
-					numInstancesToAnimate += numInstances;
-					totalNumShaderBones += (numInstances * numShaderBones);
-				}
-			}
 
 			R2_CHECK(r2::sarr::Capacity(*animationComponent.shaderBones) == numShaderBones, "We don't have enough space in order to animate all of the instances of this anim model");
 
@@ -73,9 +78,12 @@ namespace r2::ecs
 
 			u32 offset = 0;
 
+			const r2::anim::AnimationClip* clip = nullptr;
+			float animationTime = animationComponent.animationTime;
+
 			if (animationComponent.currentAnimationIndex >= 0)
 			{
-				const r2::anim::AnimationClip* clip = r2::sarr::At(*animationComponent.animModel->optrAnimationClips, animationComponent.currentAnimationIndex);
+				clip = r2::sarr::At(*animationComponent.animModel->optrAnimationClips, animationComponent.currentAnimationIndex);
 
 				//@TODO(Serge): Right now we're just hard transitioning to the new animation. We need to implement the real crossfading 
 				if (animationTransitionComponent && animationTransitionComponent->nextAnimationIndex != animationComponent.currentAnimationIndex)
@@ -90,18 +98,20 @@ namespace r2::ecs
 					mnoptrCoordinator->RemoveComponent<r2::ecs::AnimationTransitionComponent>(e);
 				}
 
-				animationComponent.animationTime = r2::anim::PlayAnimationClip(*clip, *animationComponent.animationPose, deltaTime + animationComponent.animationTime, animationComponent.shouldLoop);
+				//The time the clip will end up at - the instances run off of it
+				animationTime = r2::math::NearZero(clip->GetDuration()) ? 0.0f : clip->AdjustTimeToFitRange(deltaTime + animationComponent.animationTime, animationComponent.shouldLoop);
 			}
-			
-			r2::anim::pose::GetMatrixPalette(*animationComponent.animationPose, animationComponent.animModel->animSkeleton, animationComponent.shaderBones, offset);
 
-#ifdef R2_DEBUG
-			if (debugBonesToUse)
-			{
-				r2::sarr::Clear(*debugBonesToUse);
-				r2::anim::pose::GetDebugBones(*animationComponent.animationPose, debugBonesToUse);
-			}
-#endif
+			r2::anim::AnimationBatchInstance& batchInstance = batchInstances[numBatchInstances++];
+			batchInstance = {};
+			batchInstance.clip = clip;
+			batchInstance.pose = animationComponent.animationPose;
+			batchInstance.skeleton = &animationComponent.animModel->animSkeleton;
+			batchInstance.outPalette = animationComponent.shaderBones;
+			batchInstance.paletteOffset = offset;
+			batchInstance.time = deltaTime + animationComponent.animationTime;
+			batchInstance.loop = animationComponent.shouldLoop;
+
 			if (instancedAnimationComponent && !animationComponent.shouldUseSameTransformsForAllInstances)
 			{
 				for (u32 j = 0; j < instancedAnimationComponent->numInstances; ++j)
@@ -112,13 +122,62 @@ namespace r2::ecs
 
 					R2_CHECK(r2::sarr::Capacity(*skeletalAnimationComponent.shaderBones) == numShaderBones, "We don't have enough space in order to animate all of the instances of this anim model");
 
+					r2::anim::AnimationBatchInstance& instanceBatchInstance = batchInstances[numBatchInstances++];
+					instanceBatchInstance = {};
+
 					if (skeletalAnimationComponent.currentAnimationIndex >= 0)
 					{
-						const r2::anim::AnimationClip* clip = r2::sarr::At(*skeletalAnimationComponent.animModel->optrAnimationClips, skeletalAnimationComponent.currentAnimationIndex);
-						skeletalAnimationComponent.animationTime = r2::anim::PlayAnimationClip(*clip, *skeletalAnimationComponent.animationPose, deltaTime + animationComponent.animationTime, skeletalAnimationComponent.shouldLoop);
+						instanceBatchInstance.clip = r2::sarr::At(*skeletalAnimationComponent.animModel->optrAnimationClips, skeletalAnimationComponent.currentAnimationIndex);
 					}
 
-					r2::anim::pose::GetMatrixPalette(*skeletalAnimationComponent.animationPose, skeletalAnimationComponent.animModel->animSkeleton, skeletalAnimationComponent.shaderBones, offset);
+					instanceBatchInstance.pose = skeletalAnimationComponent.animationPose;
+					instanceBatchInstance.skeleton = &skeletalAnimationComponent.animModel->animSkeleton;
+					instanceBatchInstance.outPalette = skeletalAnimationComponent.shaderBones;
+					instanceBatchInstance.paletteOffset = offset;
+					instanceBatchInstance.time = deltaTime + animationTime;
+					instanceBatchInstance.loop = skeletalAnimationComponent.shouldLoop;
+				}
+			}
+		}
+
+		r2::anim::EvaluateBatch(batchInstances, numBatchInstances);
+
+		u32 batchIndex = 0;
+
+		for (u32 i = 0; i < numEntities; ++i)
+		{
+			Entity e = r2::sarr::At(*mEntities, i);
+			SkeletalAnimationComponent& animationComponent = mnoptrCoordinator->GetComponent<SkeletalAnimationComponent>(e);
+			InstanceComponentT<SkeletalAnimationComponent>* instancedAnimationComponent = mnoptrCoordinator->GetComponentPtr<InstanceComponentT<SkeletalAnimationComponent>>(e);
+
+			const r2::anim::AnimationBatchInstance& batchInstance = batchInstances[batchIndex++];
+			if (batchInstance.clip)
+			{
+				animationComponent.animationTime = batchInstance.outTime;
+			}
+
+#ifdef R2_DEBUG
+			DebugBoneComponent* debugBoneComponent = mnoptrCoordinator->GetComponentPtr<DebugBoneComponent>(e);
+			InstanceComponentT<DebugBoneComponent>* instancedDebugBoneComponent = mnoptrCoordinator->GetComponentPtr<InstanceComponentT<DebugBoneComponent>>(e);
+
+			if (debugBoneComponent)
+			{
+				R2_CHECK(debugBoneComponent->debugBones != nullptr, "These should not be null");
+				r2::sarr::Clear(*debugBoneComponent->debugBones);
+				r2::anim::pose::GetDebugBones(*animationComponent.animationPose, debugBoneComponent->debugBones);
+			}
+#endif
+			if (instancedAnimationComponent && !animationComponent.shouldUseSameTransformsForAllInstances)
+			{
+				for (u32 j = 0; j < instancedAnimationComponent->numInstances; ++j)
+				{
+					SkeletalAnimationComponent& skeletalAnimationComponent = r2::sarr::At(*instancedAnimationComponent->instances, j);
+
+					const r2::anim::AnimationBatchInstance& instanceBatchInstance = batchInstances[batchIndex++];
+					if (instanceBatchInstance.clip)
+					{
+						skeletalAnimationComponent.animationTime = instanceBatchInstance.outTime;
+					}
 
 #ifdef R2_DEBUG
 					if (instancedDebugBoneComponent && j < instancedDebugBoneComponent->numInstances)
@@ -127,14 +186,9 @@ namespace r2::ecs
 
 						DebugBoneComponent& debugBonesComponent = r2::sarr::At(*instancedDebugBoneComponent->instances, j);
 
-						debugBonesToUse = debugBonesComponent.debugBones;
-						r2::sarr::Clear(*debugBonesToUse);
+						r2::sarr::Clear(*debugBonesComponent.debugBones);
 
-						r2::anim::pose::GetDebugBones(*skeletalAnimationComponent.animationPose, debugBonesToUse);
-					}
-					else
-					{
-						debugBonesToUse = nullptr;
+						r2::anim::pose::GetDebugBones(*skeletalAnimationComponent.animationPose, debugBonesComponent.debugBones);
 					}
 #endif
 				}
@@ -151,7 +205,10 @@ namespace r2::ecs
 				}
 			}
 #endif
-			
 		}
+
+		R2_CHECK(batchIndex == numBatchInstances, "We should have gone through all of the batch instances");
+
+		FREE(batchInstances, *MEM_ENG_SCRATCH_PTR);
 	}
-}
\ No newline at end of file
+}
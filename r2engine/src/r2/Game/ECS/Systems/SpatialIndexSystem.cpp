@@ -0,0 +1,448 @@
+#include "r2pch.h"
+
+#include "r2/Game/ECS/Systems/SpatialIndexSystem.h"
+
+#include "r2/Core/Profiler/Profiler.h"
+#include "r2/Game/ECS/ECSCoordinator.h"
+#include "r2/Game/ECS/Components/RenderComponent.h"
+#include "r2/Game/ECS/Components/TransformComponent.h"
+#include "r2/Game/ECS/Components/InstanceComponent.h"
+#include "r2/Render/Renderer/Renderer.h"
+
+namespace
+{
+	//the low 32 bits are the entity index and the high 32 bits are the instance
+	u64 MakeProxyUserData(u32 entityIndex, s32 instance)
+	{
+		return static_cast<u64>(entityIndex) | (static_cast<u64>(static_cast<u32>(instance)) << 32);
+	}
+
+	glm::vec3 Centroid(const r2::math::AABB& aabb)
+	{
+		return (aabb.minBounds + aabb.maxBounds) * 0.5f;
+	}
+
+	const glm::mat4& GetInstanceModelMatrix(r2::ecs::ECSCoordinator& coordinator, r2::ecs::Entity e, s32 instance)
+	{
+		if (instance == -1)
+		{
+			return coordinator.GetComponent<r2::ecs::TransformComponent>(e).modelMatrix;
+		}
+
+		const auto& instancedTransforms = coordinator.GetComponent<r2::ecs::InstanceComponentT<r2::ecs::TransformComponent>>(e);
+		return r2::sarr::At(*instancedTransforms.instances, instance).modelMatrix;
+	}
+}
+
+namespace r2::ecs
+{
+	SpatialIndexSystem::SpatialIndexSystem()
+		:mDirtyBits(nullptr)
+		,mEntityProxies(nullptr)
+		,mNextProxy(nullptr)
+		,mProxyBounds(nullptr)
+		,mNumDirty(0)
+		,mRebuildAreaRatio(0.0f)
+	{
+		mKeepSorted = false;
+	}
+
+	SpatialIndexSystem::~SpatialIndexSystem()
+	{
+
+	}
+
+	void SpatialIndexSystem::Update()
+	{
+		R2_PROFILE_FUNCTION();
+
+		R2_CHECK(mnoptrCoordinator != nullptr, "Not sure why this should ever be nullptr?");
+
+		if (mNumDirty == 0)
+		{
+			return;
+		}
+
+		//lots of dirty entities (ie. a level just loaded) - cheaper to fix the whole tree once than to move each proxy through it
+		const bool batchUpdate = static_cast<float>(mNumDirty) > static_cast<float>(mTree.GetNumProxies()) * BATCH_REFIT_FRACTION;
+
+		bool updatedAny = false;
+		u32 numStillDirty = 0;
+
+		const u32 numWords = static_cast<u32>(r2::sarr::Size(*mDirtyBits));
+
+		for (u32 w = 0; w < numWords; ++w)
+		{
+			u64& dirtyWord = r2::sarr::At(*mDirtyBits, w);
+
+			if (dirtyWord == 0)
+			{
+				continue;
+			}
+
+			for (u32 bit = 0; bit < 64; ++bit)
+			{
+				const u64 dirtyBit = 1ull << bit;
+
+				if ((dirtyWord & dirtyBit) == 0)
+				{
+					continue;
+				}
+
+				const s32 index = r2::sarr::At(*mEntityIndices, w * 64 + bit);
+
+				if (index != -1 && !UpdateEntityProxies(r2::sarr::At(*mEntities, index), batchUpdate))
+				{
+					++numStillDirty;
+					continue;
+				}
+
+				updatedAny = true;
+				dirtyWord &= ~dirtyBit;
+			}
+		}
+
+		mNumDirty = numStillDirty;
+
+		if (batchUpdate && updatedAny)
+		{
+			mTree.Refit();
+
+			if (mTree.GetAreaRatio() > mRebuildAreaRatio * REBUILD_AREA_RATIO_GROWTH)
+			{
+				Rebuild();
+			}
+		}
+	}
+
+	void SpatialIndexSystem::EntityAdded(Entity e)
+	{
+		SetBoundsDirty(e);
+	}
+
+	void SpatialIndexSystem::EntityRemoved(Entity e)
+	{
+		DestroyEntityProxies(e);
+
+		const u32 entityIndex = GetEntityIndex(e);
+
+		u64& dirtyWord = r2::sarr::At(*mDirtyBits, entityIndex / 64);
+		const u64 dirtyBit = 1ull << (entityIndex % 64);
+
+		if ((dirtyWord & dirtyBit) != 0)
+		{
+			dirtyWord &= ~dirtyBit;
+			--mNumDirty;
+		}
+	}
+
+	void SpatialIndexSystem::AllEntitiesRemoved()
+	{
+		mTree.Clear();
+
+		r2::sarr::Fill(*mDirtyBits, static_cast<u64>(0));
+		r2::sarr::Fill(*mEntityProxies, math::DynamicAABBTree::NULL_NODE);
+		r2::sarr::Fill(*mNextProxy, math::DynamicAABBTree::NULL_NODE);
+
+		mNumDirty = 0;
+		mRebuildAreaRatio = 0.0f;
+	}
+
+	void SpatialIndexSystem::SetBoundsDirty(Entity e)
+	{
+		if (!HasEntity(e))
+		{
+			return;
+		}
+
+		const u32 entityIndex = GetEntityIndex(e);
+
+		u64& dirtyWord = r2::sarr::At(*mDirtyBits, entityIndex / 64);
+		const u64 dirtyBit = 1ull << (entityIndex % 64);
+
+		if ((dirtyWord & dirtyBit) == 0)
+		{
+			dirtyWord |= dirtyBit;
+			++mNumDirty;
+		}
+	}
+
+	void SpatialIndexSystem::Rebuild()
+	{
+		R2_PROFILE_FUNCTION();
+
+		mTree.Rebuild();
+		mRebuildAreaRatio = mTree.GetAreaRatio();
+	}
+
+	bool SpatialIndexSystem::Raycast(const math::Ray& ray, float maxDistance, SpatialRaycastHit& hit) const
+	{
+		bool found = false;
+
+		mTree.Raycast(ray, maxDistance, [this, &hit, &found](const math::Ray& ray, float maxDistance, s32 proxyId)
+		{
+			const SpatialQueryResult result = GetProxyResult(proxyId);
+
+			const RenderComponent& renderComponent = mnoptrCoordinator->GetComponent<RenderComponent>(result.entity);
+			const draw::vb::GPUModelRef* gpuModelRef = r2::draw::renderer::GetGPUModelRef(renderComponent.gpuModelRefHandle);
+
+			const glm::mat4& modelMatrix = GetInstanceModelMatrix(*mnoptrCoordinator, result.entity, result.instance);
+
+			if (!gpuModelRef || glm::determinant(glm::mat3(modelMatrix)) == 0.0f)
+			{
+				return -1.0f;
+			}
+
+			//the world space AABB is loose for rotated meshes so test each mesh's bounds in model space instead.
+			//An affine transform keeps the ray's parameterization so the distances are still in world units.
+			const glm::mat4 inverseModelMatrix = glm::inverse(modelMatrix);
+			const math::Ray localRay = math::CreateRay(glm::vec3(inverseModelMatrix * glm::vec4(ray.origin, 1.0f)), glm::vec3(inverseModelMatrix * glm::vec4(ray.direction, 0.0f)));
+			const glm::vec3 localInvDir = math::InverseDirection(localRay);
+
+			float closest = maxDistance;
+			bool hitMesh = false;
+
+			const u32 numMeshes = static_cast<u32>(r2::sarr::Size(*gpuModelRef->meshEntries));
+
+			for (u32 i = 0; i < numMeshes; ++i)
+			{
+				const draw::Bounds& meshBounds = r2::sarr::At(*gpuModelRef->meshEntries, i).meshBounds;
+				const glm::vec3 minBounds = meshBounds.origin - meshBounds.extents;
+				const glm::vec3 maxBounds = meshBounds.origin + meshBounds.extents;
+
+				//@NOTE(Serge): the bounds are all we test so a mesh we're inside of (ie. the room the camera is in) would always be the closest hit at 0.
+				//				Skip it so we pick what's in front of the camera instead.
+				if (glm::all(glm::greaterThanEqual(localRay.origin, minBounds)) && glm::all(glm::lessThanEqual(localRay.origin, maxBounds)))
+				{
+					continue;
+				}
+
+				float t = 0.0f;
+				if (math::RayAABBIntersection(localRay, localInvDir, minBounds, maxBounds, closest, t))
+				{
+					closest = t;
+					hitMesh = true;
+				}
+			}
+
+			if (!hitMesh)
+			{
+				return -1.0f;
+			}
+
+			hit.entity = result.entity;
+			hit.instance = result.instance;
+			hit.distance = closest;
+			found = true;
+
+			//clip the rest of the tree to this hit - never 0 since the meshes containing the origin were skipped
+			return closest;
+		});
+
+		return found;
+	}
+
+	void SpatialIndexSystem::QueryAABB(const math::AABB& aabb, r2::SArray<SpatialQueryResult>& results) const
+	{
+		mTree.QueryAABB(aabb, [this, &aabb, &results](s32 proxyId)
+		{
+			if (!math::Overlaps(r2::sarr::At(*mProxyBounds, proxyId), aabb))
+			{
+				return true;
+			}
+
+			if (!r2::sarr::HasRoom(results))
+			{
+				return false;
+			}
+
+			r2::sarr::Push(results, GetProxyResult(proxyId));
+			return true;
+		});
+	}
+
+	void SpatialIndexSystem::QuerySphere(const glm::vec3& center, float radius, r2::SArray<SpatialQueryResult>& results) const
+	{
+		mTree.QuerySphere(center, radius, [this, &center, radius, &results](s32 proxyId)
+		{
+			const math::AABB& bounds = r2::sarr::At(*mProxyBounds, proxyId);
+			const glm::vec3 d = glm::clamp(center, bounds.minBounds, bounds.maxBounds) - center;
+
+			if (glm::dot(d, d) > radius * radius)
+			{
+				return true;
+			}
+
+			if (!r2::sarr::HasRoom(results))
+			{
+				return false;
+			}
+
+			r2::sarr::Push(results, GetProxyResult(proxyId));
+			return true;
+		});
+	}
+
+	void SpatialIndexSystem::QueryFrustum(const math::Frustum& frustum, r2::SArray<SpatialQueryResult>& results) const
+	{
+		mTree.QueryFrustum(frustum, [this, &frustum, &results](s32 proxyId)
+		{
+			const math::AABB& bounds = r2::sarr::At(*mProxyBounds, proxyId);
+
+			if (!math::AABBInFrustum(frustum, Centroid(bounds), (bounds.maxBounds - bounds.minBounds) * 0.5f))
+			{
+				return true;
+			}
+
+			if (!r2::sarr::HasRoom(results))
+			{
+				return false;
+			}
+
+			r2::sarr::Push(results, GetProxyResult(proxyId));
+			return true;
+		});
+	}
+
+	bool SpatialIndexSystem::UpdateEntityProxies(Entity e, bool batchUpdate)
+	{
+		const RenderComponent& renderComponent = mnoptrCoordinator->GetComponent<RenderComponent>(e);
+		const draw::vb::GPUModelRef* gpuModelRef = r2::draw::renderer::GetGPUModelRef(renderComponent.gpuModelRefHandle);
+
+		if (!gpuModelRef || !gpuModelRef->meshEntries || r2::sarr::Size(*gpuModelRef->meshEntries) == 0)
+		{
+			return false;
+		}
+
+		//model space bounds of all of the meshes together
+		glm::vec3 localMin = glm::vec3(FLT_MAX);
+		glm::vec3 localMax = glm::vec3(-FLT_MAX);
+
+		const u32 numMeshes = static_cast<u32>(r2::sarr::Size(*gpuModelRef->meshEntries));
+
+		for (u32 i = 0; i < numMeshes; ++i)
+		{
+			const draw::Bounds& meshBounds = r2::sarr::At(*gpuModelRef->meshEntries, i).meshBounds;
+
+			localMin = glm::min(localMin, meshBounds.origin - meshBounds.extents);
+			localMax = glm::max(localMax, meshBounds.origin + meshBounds.extents);
+		}
+
+		const glm::vec3 localCenter = (localMin + localMax) * 0.5f;
+		const glm::vec3 localHalfExtents = (localMax - localMin) * 0.5f;
+
+		const TransformComponent& transformComponent = mnoptrCoordinator->GetComponent<TransformComponent>(e);
+		const InstanceComponentT<TransformComponent>* instancedTransforms = mnoptrCoordinator->GetComponentPtr<InstanceComponentT<TransformComponent>>(e);
+
+		const s32 numInstances = instancedTransforms ? static_cast<s32>(instancedTransforms->numInstances) : 0;
+		const u32 entityIndex = GetEntityIndex(e);
+
+		s32* link = &r2::sarr::At(*mEntityProxies, entityIndex);
+
+		for (s32 instance = -1; instance < numInstances; ++instance)
+		{
+			const glm::mat4& modelMatrix = instance == -1 ? transformComponent.modelMatrix : r2::sarr::At(*instancedTransforms->instances, instance).modelMatrix;
+
+			glm::vec3 worldCenter;
+			glm::vec3 worldHalfExtents;
+			math::TransformAABB(modelMatrix, localCenter, localHalfExtents, worldCenter, worldHalfExtents);
+
+			const math::AABB bounds = { worldCenter - worldHalfExtents, worldCenter + worldHalfExtents };
+
+			s32 proxyId = *link;
+
+			if (proxyId == math::DynamicAABBTree::NULL_NODE)
+			{
+				proxyId = mTree.CreateProxy(bounds, MakeProxyUserData(entityIndex, instance));
+
+				if (proxyId == math::DynamicAABBTree::NULL_NODE)
+				{
+					R2_CHECK(false, "We're out of spatial index proxies! We have: %u", mTree.GetMaxNumProxies());
+					break;
+				}
+
+				*link = proxyId;
+				r2::sarr::At(*mNextProxy, proxyId) = math::DynamicAABBTree::NULL_NODE;
+			}
+			else if (batchUpdate)
+			{
+				mTree.SetProxyAABB(proxyId, bounds);
+			}
+			else
+			{
+				mTree.MoveProxy(proxyId, bounds, worldCenter - Centroid(r2::sarr::At(*mProxyBounds, proxyId)));
+			}
+
+			r2::sarr::At(*mProxyBounds, proxyId) = bounds;
+
+			link = &r2::sarr::At(*mNextProxy, proxyId);
+		}
+
+		//anything left over is for instances that were removed
+		s32 proxyId = *link;
+		*link = math::DynamicAABBTree::NULL_NODE;
+
+		while (proxyId != math::DynamicAABBTree::NULL_NODE)
+		{
+			const s32 nextProxyId = r2::sarr::At(*mNextProxy, proxyId);
+
+			mTree.DestroyProxy(proxyId);
+			r2::sarr::At(*mNextProxy, proxyId) = math::DynamicAABBTree::NULL_NODE;
+
+			proxyId = nextProxyId;
+		}
+
+		return true;
+	}
+
+	void SpatialIndexSystem::DestroyEntityProxies(Entity e)
+	{
+		s32& firstProxyId = r2::sarr::At(*mEntityProxies, GetEntityIndex(e));
+
+		s32 proxyId = firstProxyId;
+		firstProxyId = math::DynamicAABBTree::NULL_NODE;
+
+		while (proxyId != math::DynamicAABBTree::NULL_NODE)
+		{
+			const s32 nextProxyId = r2::sarr::At(*mNextProxy, proxyId);
+
+			mTree.DestroyProxy(proxyId);
+			r2::sarr::At(*mNextProxy, proxyId) = math::DynamicAABBTree::NULL_NODE;
+
+			proxyId = nextProxyId;
+		}
+	}
+
+	SpatialQueryResult SpatialIndexSystem::GetProxyResult(s32 proxyId) const
+	{
+		const u64 userData = mTree.GetUserData(proxyId);
+
+		const u32 entityIndex = static_cast<u32>(userData & 0xFFFFFFFF);
+		const s32 index = r2::sarr::At(*mEntityIndices, entityIndex);
+
+		R2_CHECK(index != -1, "Proxy: %i belongs to an entity that isn't in the SpatialIndexSystem anymore", proxyId);
+
+		SpatialQueryResult result;
+		result.entity = r2::sarr::At(*mEntities, index);
+		result.instance = static_cast<s32>(static_cast<u32>(userData >> 32));
+
+		return result;
+	}
+
+	u64 SpatialIndexSystem::MemorySize(u32 maxNumEntities, u32 maxNumProxies, const r2::mem::utils::MemoryProperties& memProperties)
+	{
+		const u32 maxNumNodes = math::DynamicAABBTree::MaxNumNodes(maxNumProxies);
+
+		u64 memorySize = 0;
+
+		memorySize +=
+			r2::ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::SpatialIndexSystem>(maxNumEntities, memProperties) +
+			math::DynamicAABBTree::MemorySize(maxNumProxies, memProperties) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u64>::MemorySize(NumDirtyBitWords(maxNumEntities)), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s32>::MemorySize(maxNumEntities + 1), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s32>::MemorySize(maxNumNodes), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<math::AABB>::MemorySize(maxNumNodes), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
+
+		return memorySize;
+	}
+}
@@ -0,0 +1,143 @@
+#ifndef __SPATIAL_INDEX_SYSTEM_H__
+#define __SPATIAL_INDEX_SYSTEM_H__
+
+#include "r2/Game/ECS/System.h"
+#include "r2/Core/Memory/Memory.h"
+#include "r2/Core/Math/DynamicAABBTree.h"
+
+namespace r2::ecs
+{
+	struct SpatialQueryResult
+	{
+		Entity entity = INVALID_ENTITY;
+		s32 instance = -1; //-1 is the entity itself, otherwise the index into its InstanceComponentT<TransformComponent>
+	};
+
+	struct SpatialRaycastHit
+	{
+		Entity entity = INVALID_ENTITY;
+		s32 instance = -1;
+		float distance = 0.0f;
+	};
+
+	//Keeps a DynamicAABBTree of the world space bounds of every entity (and instance) with a RenderComponent.
+	//
+	//The SceneGraphTransformUpdateSystem marks the entities it updates with SetBoundsDirty and Update brings their proxies up to date.
+	//When only a few entities moved their proxies are moved in the tree one at a time, otherwise the leaves are all updated in place and
+	//the tree is refit in one pass, then rebuilt with SAH once refitting has made it too loose.
+	//
+	//Query results are per entity instance and use the tight (not fat) bounds, except Raycast which tests against each mesh's bounds in model space.
+	class SpatialIndexSystem : public System
+	{
+	public:
+
+		SpatialIndexSystem();
+		~SpatialIndexSystem();
+
+		template<class ARENA>
+		bool Init(ARENA& arena, u32 maxNumEntities, u32 maxNumProxies)
+		{
+			const u32 maxNumNodes = math::DynamicAABBTree::MaxNumNodes(maxNumProxies);
+
+			bool result = mTree.Init(arena, maxNumProxies);
+
+			mDirtyBits = MAKE_SARRAY(arena, u64, NumDirtyBitWords(maxNumEntities));
+			mEntityProxies = MAKE_SARRAY(arena, s32, maxNumEntities + 1);
+			mNextProxy = MAKE_SARRAY(arena, s32, maxNumNodes);
+			mProxyBounds = MAKE_SARRAY(arena, math::AABB, maxNumNodes);
+
+			R2_CHECK(result && mDirtyBits && mEntityProxies && mNextProxy && mProxyBounds, "Couldn't allocate the SpatialIndexSystem's data");
+
+			r2::sarr::Fill(*mDirtyBits, static_cast<u64>(0));
+			r2::sarr::Fill(*mEntityProxies, math::DynamicAABBTree::NULL_NODE);
+			r2::sarr::Fill(*mNextProxy, math::DynamicAABBTree::NULL_NODE);
+			r2::sarr::Fill(*mProxyBounds, math::AABB{});
+
+			mNumDirty = 0;
+			mRebuildAreaRatio = 0.0f;
+
+			return result;
+		}
+
+		template<class ARENA>
+		void Shutdown(ARENA& arena)
+		{
+			FREE(mProxyBounds, arena);
+			FREE(mNextProxy, arena);
+			FREE(mEntityProxies, arena);
+			FREE(mDirtyBits, arena);
+
+			mProxyBounds = nullptr;
+			mNextProxy = nullptr;
+			mEntityProxies = nullptr;
+			mDirtyBits = nullptr;
+
+			mTree.Shutdown(arena);
+		}
+
+		void Update() override;
+
+		virtual void EntityAdded(Entity e) override;
+		virtual void EntityRemoved(Entity e) override;
+		virtual void AllEntitiesRemoved() override;
+
+		//The entity's bounds will be recalculated in the next Update. Does nothing if the entity isn't in this system.
+		void SetBoundsDirty(Entity e);
+
+		//Builds the whole tree again with SAH
+		void Rebuild();
+
+		//Finds the closest entity instance hit by the ray within maxDistance. Meshes whose bounds contain the ray's origin are ignored.
+		bool Raycast(const math::Ray& ray, float maxDistance, SpatialRaycastHit& hit) const;
+
+		//These add to results until it's full
+		void QueryAABB(const math::AABB& aabb, r2::SArray<SpatialQueryResult>& results) const;
+		void QuerySphere(const glm::vec3& center, float radius, r2::SArray<SpatialQueryResult>& results) const;
+		void QueryFrustum(const math::Frustum& frustum, r2::SArray<SpatialQueryResult>& results) const;
+
+		const math::DynamicAABBTree& GetTree() const { return mTree; }
+
+		//One proxy for every entity and instance, capped at MAX_NUM_PROXIES. maxNumInstancesPerModel is per instanced component and the instanced
+		//component arrays can hold one of those for every entity, so that's what the instances can add up to
+		static u32 MaxNumProxies(u32 maxNumEntities, u32 maxNumInstancesPerModel)
+		{
+			const u64 maxNumInstances = static_cast<u64>(maxNumEntities) * maxNumInstancesPerModel;
+			return static_cast<u32>(std::min<u64>(maxNumEntities + maxNumInstances, MAX_NUM_PROXIES));
+		}
+		static u64 MemorySize(u32 maxNumEntities, u32 maxNumProxies, const r2::mem::utils::MemoryProperties& memProperties);
+
+	private:
+
+		static constexpr u32 MAX_NUM_PROXIES = 1u << 16;
+
+		//If more than this fraction of the proxies are dirty in a frame we update the leaves in place and refit instead of moving them one at a time
+		static constexpr float BATCH_REFIT_FRACTION = 0.1f;
+		//Rebuild with SAH once refitting has made the tree's area ratio this much worse than right after the last rebuild
+		static constexpr float REBUILD_AREA_RATIO_GROWTH = 1.5f;
+
+		static u32 NumDirtyBitWords(u32 maxNumEntities) { return (maxNumEntities + 1 + 63) / 64; }
+
+		//Returns false if the entity's model isn't loaded yet so it should stay dirty
+		bool UpdateEntityProxies(Entity e, bool batchUpdate);
+		void DestroyEntityProxies(Entity e);
+
+		//Finds the entity that owns the proxy from the entity index stored in its user data
+		SpatialQueryResult GetProxyResult(s32 proxyId) const;
+
+		math::DynamicAABBTree mTree;
+
+		r2::SArray<u64>* mDirtyBits;
+
+		//entity index -> first proxy (the entity itself, followed by its instances in order through mNextProxy)
+		r2::SArray<s32>* mEntityProxies;
+
+		//These are indexed by proxy id
+		r2::SArray<s32>* mNextProxy;
+		r2::SArray<math::AABB>* mProxyBounds;
+
+		u32 mNumDirty;
+		float mRebuildAreaRatio;
+	};
+}
+
+#endif // __SPATIAL_INDEX_SYSTEM_H__
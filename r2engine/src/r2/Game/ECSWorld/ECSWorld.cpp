@@ -25,6 +25,7 @@
 #include "r2/Game/ECS/Systems/SkeletalAnimationSystem.h"
 #include "r2/Game/ECS/Systems/SceneGraphSystem.h"
 #include "r2/Game/ECS/Systems/SceneGraphTransformUpdateSystem.h"
+#include "r2/Game/ECS/Systems/SpatialIndexSystem.h"
 #include "r2/Game/ECS/Systems/LightingUpdateSystem.h"
 
 #ifdef R2_DEBUG
@@ -56,6 +57,7 @@ namespace r2::ecs
 		,moptrAudioEmitterSystem(nullptr)
 		,moptrSceneGraphSystem(nullptr)
 		,moptrSceneGraphTransformUpdateSystem(nullptr)
+		,moptrSpatialIndexSystem(nullptr)
 #ifdef R2_DEBUG
 		,moptrDebugRenderSystem(nullptr)
 		,moptrDebugBonesRenderSystem(nullptr)
@@ -105,14 +107,14 @@ namespace r2::ecs
 
 		R2_CHECK(mECSCoordinator != nullptr, "We couldn't allocate the ECSCoordinator");
 
-		bool result = mECSCoordinator->Init<r2::mem::StackArena>(*mArena, maxNumComponents, maxNumEntities, 1, maxNumSystems);
+		bool result = mECSCoordinator->Init<r2::mem::StackArena>(*mArena, &mMallocArena, maxNumComponents, maxNumEntities, 1, maxNumSystems);
 
 		R2_CHECK(result, "We couldn't Init the mECSCoordinator!");
 
 		RegisterEngineComponents();
 		RegisterEngineSystems();
 		
-		bool sceneGraphInitialized = mSceneGraph.Init(moptrSceneGraphSystem, moptrSceneGraphTransformUpdateSystem, mECSCoordinator);
+		bool sceneGraphInitialized = mSceneGraph.Init(moptrSceneGraphSystem, moptrSceneGraphTransformUpdateSystem, moptrSpatialIndexSystem, mECSCoordinator);
 		R2_CHECK(sceneGraphInitialized, "The scene graph didn't initialize?");
 
 
@@ -151,6 +153,9 @@ namespace r2::ecs
 
 		moptrAudioListenerSystem->Update();
 
+		//Systems like the SceneGraphTransformUpdateSystem only get sorted here instead of every time an entity is added to them
+		mECSCoordinator->SortDeferredSystems();
+
 		mSceneGraph.Update();
 
 		moptrSkeletalAnimationSystem->Update();
@@ -206,14 +211,18 @@ namespace r2::ecs
 
 
 		//making some temp entities for use when getting entities with specific component types
-		r2::SArray<ecs::Entity>* tempEntities = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, MAX_NUM_ENTITIES);
+		r2::SArray<ecs::Entity>* tempEntities = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, std::max(mECSCoordinator->NumLivingEntities(), 1u));
 
 		ecs::TransformDirtyComponent dirty;
 		dirty.dirtyFlags = ecs::eTransformDirtyFlags::GLOBAL_TRANSFORM_DIRTY | ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
 
 		mECSCoordinator->GetAllEntitiesWithComponent(mECSCoordinator->GetComponentType<ecs::TransformComponent>(), *tempEntities);
 
-		mECSCoordinator->AddComponentToAllEntities<ecs::TransformDirtyComponent>(dirty, *tempEntities);
+		const auto numTransformEntities = r2::sarr::Size(*tempEntities);
+		for (u32 i = 0; i < numTransformEntities; ++i)
+		{
+			mSceneGraph.SetTransformDirty(r2::sarr::At(*tempEntities, i), dirty);
+		}
 
 
 		mECSCoordinator->GetAllEntitiesWithComponent(mECSCoordinator->GetComponentType<ecs::PointLightComponent>(), *tempEntities);
@@ -559,7 +568,6 @@ namespace r2::ecs
 
 		mECSCoordinator->RegisterComponent<mem::StackArena, ecs::HierarchyComponent>(*mArena, "HeirarchyComponent", true, false, nullptr);
 		mECSCoordinator->RegisterComponent<mem::StackArena, ecs::TransformComponent>(*mArena, "TransformComponent", true, false, nullptr);
-		mECSCoordinator->RegisterComponent<mem::StackArena, ecs::TransformDirtyComponent>(*mArena, "TransformDirtyComponent", false, false, nullptr);
 		mECSCoordinator->RegisterComponent<mem::StackArena, ecs::RenderComponent>(*mArena, "RenderComponent", true, false, freeRenderComponentFunc);
 		mECSCoordinator->RegisterComponent<mem::StackArena, ecs::SkeletalAnimationComponent>(*mArena, "SkeletalAnimationComponent", true, false, freeSkeletalAnimationComponentFunc);
 		mECSCoordinator->RegisterComponent<mem::StackArena, ecs::AudioListenerComponent>(*mArena, "AudioListenerComponent", true, false, nullptr);
@@ -624,7 +632,6 @@ namespace r2::ecs
 
 		mECSCoordinator->UnRegisterComponent<mem::StackArena, ecs::SkeletalAnimationComponent>(*mArena);
 		mECSCoordinator->UnRegisterComponent<mem::StackArena, ecs::RenderComponent>(*mArena);
-		mECSCoordinator->UnRegisterComponent<mem::StackArena, ecs::TransformDirtyComponent>(*mArena);
 		mECSCoordinator->UnRegisterComponent<mem::StackArena, ecs::TransformComponent>(*mArena);
 		mECSCoordinator->UnRegisterComponent<mem::StackArena, ecs::HierarchyComponent>(*mArena);
 	}
@@ -732,10 +739,26 @@ namespace r2::ecs
 		ecs::Signature systemUpdateSignature;
 		systemUpdateSignature.set(heirarchyComponentType);
 		systemUpdateSignature.set(transformComponentType);
-		systemUpdateSignature.set(mECSCoordinator->GetComponentType<ecs::TransformDirtyComponent>());
 
 		mECSCoordinator->SetSystemSignature<ecs::SceneGraphTransformUpdateSystem>(systemUpdateSignature);
 
+		moptrSceneGraphTransformUpdateSystem->Init<mem::StackArena>(*mArena, mECSCoordinator->MaxNumEntities());
+
+		moptrSpatialIndexSystem = (ecs::SpatialIndexSystem*)mECSCoordinator->RegisterSystem<r2::mem::StackArena, ecs::SpatialIndexSystem>(*mArena);
+
+		if (moptrSpatialIndexSystem == nullptr)
+		{
+			R2_CHECK(false, "Couldn't register the SpatialIndexSystem");
+			return;
+		}
+
+		ecs::Signature spatialIndexSystemSignature;
+		spatialIndexSystemSignature.set(transformComponentType);
+		spatialIndexSystemSignature.set(renderComponentType);
+
+		mECSCoordinator->SetSystemSignature<ecs::SpatialIndexSystem>(spatialIndexSystemSignature);
+
+		moptrSpatialIndexSystem->Init<mem::StackArena>(*mArena, mECSCoordinator->MaxNumEntities(), r2::ecs::SpatialIndexSystem::MaxNumProxies(mECSCoordinator->MaxNumEntities(), maxNumInstances));
 
 
 
@@ -757,6 +780,9 @@ namespace r2::ecs
 	void ECSWorld::UnRegisterEngineSystems()
 	{
 		mECSCoordinator->UnRegisterSystem<mem::StackArena, ecs::LightingUpdateSystem>(*mArena);
+		moptrSpatialIndexSystem->Shutdown<mem::StackArena>(*mArena);
+		mECSCoordinator->UnRegisterSystem<mem::StackArena, ecs::SpatialIndexSystem>(*mArena);
+		moptrSceneGraphTransformUpdateSystem->Shutdown<mem::StackArena>(*mArena);
 		mECSCoordinator->UnRegisterSystem<mem::StackArena, ecs::SceneGraphTransformUpdateSystem>(*mArena);
 		mECSCoordinator->UnRegisterSystem<mem::StackArena, ecs::SceneGraphSystem>(*mArena);
 
@@ -830,25 +856,25 @@ namespace r2::ecs
 
 		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::mem::StackArena), ALIGNMENT, stackHeaderSize, boundsChecking);
 		memorySize += r2::ecs::ECSCoordinator::MemorySize(maxNumComponents, maxNumEntities, maxNumSystems, ALIGNMENT, stackHeaderSize, boundsChecking);
-		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::SkeletalAnimationSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
-		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::AudioListenerSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
-		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::AudioEmitterSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
-		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::SceneGraphSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
-		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::SceneGraphTransformUpdateSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::SkeletalAnimationSystem>(maxNumEntities, memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::AudioListenerSystem>(maxNumEntities, memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::AudioEmitterSystem>(maxNumEntities, memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::SceneGraphSystem>(maxNumEntities, memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+		memorySize += r2::ecs::SceneGraphTransformUpdateSystem::MemorySize(maxNumEntities, memProperties);
+		memorySize += r2::ecs::SpatialIndexSystem::MemorySize(maxNumEntities, r2::ecs::SpatialIndexSystem::MaxNumProxies(maxNumEntities, maxNumInstances), memProperties);
 		
-		memorySize += r2::ecs::RenderSystem::MemorySize(maxNumInstances, avgMaxNumMeshesPerModel*maxNumModels, maxNumBones, memProperties);
-		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::LightingUpdateSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+		memorySize += r2::ecs::RenderSystem::MemorySize(maxNumEntities, maxNumInstances, avgMaxNumMeshesPerModel*maxNumModels, maxNumBones, memProperties);
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::LightingUpdateSystem>(maxNumEntities, memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
 		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<AppSystem>::MemorySize(maxNumSystems), ALIGNMENT, stackHeaderSize, boundsChecking);
 
 #ifdef R2_DEBUG
-		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::DebugRenderSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
-		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::DebugBonesRenderSystem>(memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::DebugRenderSystem>(maxNumEntities, memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(ecs::ECSCoordinator::MemorySizeOfSystemType<r2::ecs::DebugBonesRenderSystem>(maxNumEntities, memProperties), ALIGNMENT, stackHeaderSize, boundsChecking);
 #endif // R2_DEBUG
 
 		//add all of the Engine Component memory here
 		memorySize += ComponentArray<HierarchyComponent>::MemorySize(maxNumEntities, ALIGNMENT, stackHeaderSize, boundsChecking);
 		memorySize += ComponentArray<TransformComponent>::MemorySize(maxNumEntities, ALIGNMENT, stackHeaderSize, boundsChecking);
-		memorySize += ComponentArray<TransformDirtyComponent>::MemorySize(maxNumEntities, ALIGNMENT, stackHeaderSize, boundsChecking);
 		memorySize += ComponentArray<RenderComponent>::MemorySize(maxNumEntities, ALIGNMENT, stackHeaderSize, boundsChecking);
 		memorySize += ComponentArray<SkeletalAnimationComponent>::MemorySize(maxNumEntities, ALIGNMENT, stackHeaderSize, boundsChecking);
 
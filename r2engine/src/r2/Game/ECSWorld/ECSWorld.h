@@ -37,6 +37,7 @@ namespace r2::ecs
 	class AudioEmitterSystem;
 	class SceneGraphSystem;
 	class SceneGraphTransformUpdateSystem;
+	class SpatialIndexSystem;
 	class LightingUpdateSystem;
 
 #ifdef R2_DEBUG
@@ -156,6 +157,7 @@ namespace r2::ecs
 
 		r2::ecs::SceneGraphSystem* moptrSceneGraphSystem;
 		r2::ecs::SceneGraphTransformUpdateSystem* moptrSceneGraphTransformUpdateSystem;
+		r2::ecs::SpatialIndexSystem* moptrSpatialIndexSystem;
 
 		r2::ecs::LightingUpdateSystem* moptrLightingUpdateSystem;
 
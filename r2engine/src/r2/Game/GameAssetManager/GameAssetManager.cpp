@@ -82,6 +82,46 @@ namespace r2
 		return mAssetCache->LoadAsset(asset);
 	}
 
+	r2::asset::AsyncAssetLoadHandle GameAssetManager::LoadAssetAsync(const r2::asset::Asset& asset, r2::asset::AssetLoadPriority priority)
+	{
+		if (!mAssetCache)
+		{
+			R2_CHECK(false, "Asset Cache is nullptr");
+			return {};
+		}
+
+		return mAssetCache->LoadAssetAsync(asset, priority);
+	}
+
+	r2::asset::AssetLoadStatus GameAssetManager::GetAsyncLoadStatus(const r2::asset::AsyncAssetLoadHandle& loadHandle) const
+	{
+		if (!mAssetCache)
+		{
+			return r2::asset::ASSET_LOAD_STATUS_INVALID;
+		}
+
+		return mAssetCache->GetAsyncLoadStatus(loadHandle);
+	}
+
+	r2::asset::AssetLoadStatus GameAssetManager::WaitForAsyncLoad(const r2::asset::AsyncAssetLoadHandle& loadHandle)
+	{
+		if (!mAssetCache)
+		{
+			R2_CHECK(false, "Asset Cache is nullptr");
+			return r2::asset::ASSET_LOAD_STATUS_INVALID;
+		}
+
+		return mAssetCache->WaitForAsyncLoad(loadHandle);
+	}
+
+	void GameAssetManager::Update()
+	{
+		if (mAssetCache)
+		{
+			mAssetCache->Update();
+		}
+	}
+
 	void GameAssetManager::UnloadAsset(const u64 assethandle)
 	{
 		if (!mAssetCache)
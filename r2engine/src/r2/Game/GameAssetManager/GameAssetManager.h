@@ -98,9 +98,15 @@ namespace r2
 		static u64 MemorySizeForGameAssetManager(u32 numFiles, u32 alignment, u32 headerSize);
 		static u64 CacheMemorySize(u32 numAssets, u32 assetCapacity, u32 alignment, u32 headerSize, u32 boundsChecking, u32 lruCapacity, u32 mapCapacity);
 
-		//@TODO(Serge): probably want more types of loads for threading and stuff, for now keep it simple
 		r2::asset::AssetHandle LoadAsset(const r2::asset::Asset& asset);
 
+		//Loads the asset on the job threads, poll or wait on the handle to know when it's ready
+		r2::asset::AsyncAssetLoadHandle LoadAssetAsync(const r2::asset::Asset& asset, r2::asset::AssetLoadPriority priority = r2::asset::ASSET_LOAD_PRIORITY_CRITICAL);
+		r2::asset::AssetLoadStatus GetAsyncLoadStatus(const r2::asset::AsyncAssetLoadHandle& loadHandle) const;
+		r2::asset::AssetLoadStatus WaitForAsyncLoad(const r2::asset::AsyncAssetLoadHandle& loadHandle);
+
+		void Update();
+
 		template<typename T>
 		T* LoadAndGetAsset(const r2::asset::Asset& asset)
 		{
@@ -12,6 +12,7 @@ namespace r2
 		,mMaterials(nullptr)
 		,mSoundBanks(nullptr)
 		,mEntities(nullptr)
+		,mnoptrEntityArena(nullptr)
 	{
 		r2::util::PathCpy(mLevelName, "");
 		r2::util::PathCpy(mGroupName, "");
@@ -57,6 +58,7 @@ namespace r2
 		mMaterials = nullptr;
 		mSoundBanks = nullptr;
 		mEntities = nullptr;
+		mnoptrEntityArena = nullptr;
 
 		r2::util::PathCpy(mLevelName, "");
 		r2::util::PathCpy(mGroupName, "");
@@ -142,6 +144,21 @@ namespace r2
 
 	void Level::AddEntity(ecs::Entity e) const
 	{
+		if (r2::sarr::Size(*mEntities) == r2::sarr::Capacity(*mEntities))
+		{
+			R2_CHECK(mnoptrEntityArena != nullptr, "We don't have an arena to grow the level's entities with");
+
+			r2::SArray<ecs::Entity>* newEntities = MAKE_SARRAY(*mnoptrEntityArena, ecs::Entity, std::max<u64>(r2::sarr::Capacity(*mEntities) * 2, 1));
+
+			R2_CHECK(newEntities != nullptr, "Failed to grow the level's entities");
+
+			r2::sarr::Copy(*newEntities, *mEntities);
+
+			FREE(mEntities, *mnoptrEntityArena);
+
+			mEntities = newEntities;
+		}
+
 		r2::sarr::Push(*mEntities, e);
 	}
 
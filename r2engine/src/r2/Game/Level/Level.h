@@ -3,6 +3,7 @@
 
 #include "r2/Utils/Utils.h"
 #include "r2/Core/Memory/Memory.h"
+#include "r2/Core/Memory/Allocators/FreeListAllocator.h"
 #include "r2/Core/Assets/AssetTypes.h"
 #include "r2/Game/ECS/Entity.h"
 #include "r2/Render/Model/Materials/MaterialTypes.h"
@@ -56,6 +57,7 @@ namespace r2
 		r2::SArray<r2::asset::AssetName>* GetSoundBankAssetNames() const;
 		r2::SArray<ecs::Entity>* GetEntities() const;
 
+		//Grows the entity array out of the level's entity arena if it's full
 		void AddEntity(ecs::Entity e) const;
 		void RemoveEntity(ecs::Entity e) const;
 		void ClearAllEntities() const;
@@ -89,7 +91,8 @@ namespace r2
 		r2::SArray<r2::mat::MaterialName>* mMaterials;
 		r2::SArray<r2::asset::AssetName>* mSoundBanks;
 
-		r2::SArray<ecs::Entity>* mEntities;
+		mutable r2::SArray<ecs::Entity>* mEntities;
+		r2::mem::FreeListArena* mnoptrEntityArena;
 	};
 }
 
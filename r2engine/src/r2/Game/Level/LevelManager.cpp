@@ -31,15 +31,33 @@ namespace r2
 	const u32 LevelManager::MAX_NUM_ANIMATIONS = 500;
 	const u32 LevelManager::MAX_NUM_TEXTURE_PACKS = 100;
 	const u32 LevelManager::MAX_NUM_SOUND_BANKS = 50;
+	const u32 LevelManager::INITIAL_NUM_LEVEL_ENTITIES = 256;
+	const u32 LevelManager::MAX_NUM_LEVEL_STREAMS = 8;
+	const u32 LevelManager::MAX_NUM_STREAMING_LEVELS = 64;
+	const f64 LevelManager::DEFAULT_LEVEL_STREAM_FRAME_BUDGET_MS = 4.0;
+
+	namespace
+	{
+		bool IsAsyncLoadPending(r2::asset::AssetLoadStatus status)
+		{
+			return status == r2::asset::ASSET_LOAD_STATUS_QUEUED || status == r2::asset::ASSET_LOAD_STATUS_LOADING;
+		}
+	}
 
 	
 	LevelManager::LevelManager()
 		:mMemoryAreaHandle(r2::mem::MemoryArea::Invalid)
 		,mSubAreaHandle(r2::mem::MemoryArea::SubArea::Invalid)
 		,mMaxNumLevels(0)
+		,mMaxNumEntities(0)
 		,mArena(nullptr)
 		,mLoadedLevels(nullptr)
 		,mLevelArena(nullptr)
+		,mLevelStreams(nullptr)
+		,mStreamingLevels(nullptr)
+		,mStreamingOrigin(0.0f)
+		,mHasStreamingOrigin(false)
+		,mLevelStreamFrameBudgetMs(DEFAULT_LEVEL_STREAM_FRAME_BUDGET_MS)
 		, mCurrentLevel (-1)
 	{
 
@@ -52,7 +70,8 @@ namespace r2
 	bool LevelManager::Init(
 		r2::mem::MemoryArea::Handle memoryAreaHandle,
 		const char* areaName,
-		u32 maxNumLevels)
+		u32 maxNumLevels,
+		u32 maxNumEntities)
 	{
 		R2_CHECK(memoryAreaHandle != r2::mem::MemoryArea::Invalid, "We need a valid memory area");
 
@@ -67,7 +86,7 @@ namespace r2
 		r2::mem::MemoryArea* memoryArea = r2::mem::GlobalMemory::GetMemoryArea(memoryAreaHandle);
 		R2_CHECK(memoryArea != nullptr, "Memory area is null?");
 
-		u64 subAreaSize = MemorySize(maxNumLevels, MAX_NUM_MODELS, MAX_NUM_ANIMATIONS, MAX_NUM_TEXTURE_PACKS, ecs::MAX_NUM_ENTITIES, MAX_NUM_SOUND_BANKS, memProperties);
+		u64 subAreaSize = MemorySize(maxNumLevels, MAX_NUM_MODELS, MAX_NUM_ANIMATIONS, MAX_NUM_TEXTURE_PACKS, MAX_NUM_SOUND_BANKS, maxNumEntities, memProperties);
 		u64 unallocated = memoryArea->UnAllocatedSpace();
 		if (unallocated < subAreaSize)
 		{
@@ -88,11 +107,13 @@ namespace r2
 		R2_CHECK(mArena != nullptr, "We couldn't emplace the stack arena!");
 
 		mMaxNumLevels = maxNumLevels;
+		mMaxNumEntities = maxNumEntities;
 
 		//Make free list arena
 		u32 freeListArenaSize = 0;
 		freeListArenaSize += (r2::SArray<r2::asset::AssetHandle>::MemorySize(MAX_NUM_MODELS) + r2::SArray<r2::asset::AssetHandle>::MemorySize(MAX_NUM_ANIMATIONS))* maxNumLevels;
 		freeListArenaSize += r2::SArray<u64>::MemorySize(MAX_NUM_TEXTURE_PACKS) * maxNumLevels;
+		freeListArenaSize += static_cast<u32>(LevelEntitiesMemorySize(maxNumLevels, maxNumEntities));
 
 		mLevelArena = MAKE_FREELIST_ARENA(*mArena, freeListArenaSize, r2::mem::FIND_BEST);
 		R2_CHECK(mLevelArena != nullptr, "We couldn't make the level arena");
@@ -102,6 +123,16 @@ namespace r2
 
 		mLoadedLevels = MAKE_SARRAY(*mArena, Level, maxNumLevels);
 
+		mLevelStreams = ALLOC_ARRAYN(LevelStreamRequest, MAX_NUM_LEVEL_STREAMS, *mArena);
+		R2_CHECK(mLevelStreams != nullptr, "We couldn't allocate the level streams");
+
+		for (u32 i = 0; i < MAX_NUM_LEVEL_STREAMS; ++i)
+		{
+			mLevelStreams[i].assetLoads = MAKE_SARRAY(*mArena, r2::asset::AsyncAssetLoadHandle, MAX_NUM_MODELS + MAX_NUM_SOUND_BANKS);
+		}
+
+		mStreamingLevels = MAKE_SARRAY(*mArena, StreamingLevel, MAX_NUM_STREAMING_LEVELS);
+
 		//@TODO(Serge): add in the level files from the path
 		//GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
 		//r2::asset::FileList fileList = gameAssetManager.GetFileList();
@@ -123,6 +154,16 @@ namespace r2
 
 	void LevelManager::Shutdown()
 	{
+		//finish anything that's still streaming so the loads don't outlive us - the levels get unloaded below
+		for (u32 i = 0; i < MAX_NUM_LEVEL_STREAMS; ++i)
+		{
+			LevelStreamRequest& request = mLevelStreams[i];
+			if (request.stage != LEVEL_STREAM_STAGE_INVALID)
+			{
+				WaitForLevelStream({ request.levelName, i, request.generation });
+			}
+		}
+
 		u32 numLevels = r2::sarr::Size(*mLoadedLevels);
 
 		for (u32 i = 0; i < numLevels; ++i)
@@ -133,6 +174,15 @@ namespace r2
 
 		r2::sarr::Clear(*mLoadedLevels);
 
+		FREE(mStreamingLevels, *mArena);
+
+		for (s32 i = static_cast<s32>(MAX_NUM_LEVEL_STREAMS) - 1; i >= 0; --i)
+		{
+			FREE(mLevelStreams[i].assetLoads, *mArena);
+		}
+
+		FREE_ARRAY(mLevelStreams, *mArena);
+
 		FREE(mLoadedLevels, *mArena);
 
 		FREE(mLevelArena, *mArena);
@@ -144,12 +194,18 @@ namespace r2
 
 	Level* LevelManager::MakeNewLevel(const char* levelNameStr, const char* groupName, LevelName levelName, const r2::Camera& defaultCamera)
 	{
+		if (!HasRoomForLevel())
+		{
+			R2_CHECK(false, "We can only have %u levels loaded at once", mMaxNumLevels);
+			return nullptr;
+		}
+
 		Level newLevel;
 
 		r2::SArray<r2::asset::AssetName>* modelAssets = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, MAX_NUM_MODELS);
 		r2::SArray<r2::mat::MaterialName>* materials = MAKE_SARRAY(*mLevelArena, r2::mat::MaterialName, MAX_NUM_TEXTURE_PACKS);
 		r2::SArray<r2::asset::AssetName>* soundBanks = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, MAX_NUM_SOUND_BANKS);
-		r2::SArray<ecs::Entity>* entities = MAKE_SARRAY(*mLevelArena, ecs::Entity, ecs::MAX_NUM_ENTITIES);
+		r2::SArray<ecs::Entity>* entities = MAKE_SARRAY(*mLevelArena, ecs::Entity, INITIAL_NUM_LEVEL_ENTITIES);
 
 		LevelRenderSettings newLevelRenderSettings;
 		newLevelRenderSettings.Init(*mLevelArena);
@@ -166,6 +222,7 @@ namespace r2
 		//@NOTE(Serge): sort of weird we're doing this but it's only when we make new levels for the editor
 		//				we may want to have this method only for R2_EDITOR/R2_ASSET_PIPELINE
 		newLevel.Init(1, levelNameStr, groupName, levelName, modelAssets, materials, soundBanks, entities, newLevelRenderSettings);
+		newLevel.mnoptrEntityArena = mLevelArena;
 
 		r2::sarr::Push(*mLoadedLevels, newLevel);
 
@@ -187,8 +244,6 @@ namespace r2
 			return nullptr;
 		}
 
-		Level defaultLevel = {};
-
 		s32 index = -1;
 		Level* theLevel = FindLoadedLevel(levelName, index);
 
@@ -197,6 +252,13 @@ namespace r2
 			return theLevel;
 		}
 
+		const s32 streamIndex = FindLevelStream(levelName);
+		if (streamIndex != -1)
+		{
+			mLevelStreams[streamIndex].makeCurrent = true;
+			return WaitForLevelStream({ levelName, static_cast<u32>(streamIndex), mLevelStreams[streamIndex].generation });
+		}
+
 		r2::GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
 		r2::asset::AssetLib& assetLib = MENG.GetAssetLib();
 
@@ -207,70 +269,317 @@ namespace r2
 			return nullptr;
 		}
 
+		if (!HasRoomForLevel())
+		{
+			R2_CHECK(false, "We can only have %u levels loaded at once", mMaxNumLevels);
+			return nullptr;
+		}
+
 		const byte* levelData = gameAssetManager.LoadAndGetAssetConst<byte>(levelAsset);
 
 		const flat::LevelData* flatLevelData = flat::GetLevelData(levelData);
 
 		Level newLevel;
 
-#ifdef R2_ASSET_PIPELINE
-		r2::SArray<r2::asset::AssetName>* modelAssets = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, MAX_NUM_MODELS);
-		r2::SArray<r2::mat::MaterialName>* texturePackAssets = MAKE_SARRAY(*mLevelArena, r2::mat::MaterialName, MAX_NUM_TEXTURE_PACKS);
-		r2::SArray<r2::asset::AssetName>* soundBanks = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, MAX_NUM_SOUND_BANKS);
-#else
-		r2::SArray<r2::asset::AssetName>* modelAssets = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, flatLevelData->modelFilePaths()->size());
-		r2::SArray<r2::mat::MaterialName>* texturePackAssets = MAKE_SARRAY(*mLevelArena, r2::mat::MaterialName, flatLevelData->materialNames()->size() * r2::draw::tex::NUM_TEXTURE_TYPES);
-		r2::SArray<r2::asset::AssetName>* soundBanks = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, flatLevelData->soundPaths()->size());
-#endif
-		
-		r2::SArray<ecs::Entity>* entities = MAKE_SARRAY(*mLevelArena, ecs::Entity, ecs::MAX_NUM_ENTITIES);
+		MakeLevel(levelName, flatLevelData, newLevel);
 
+		LoadLevelData(newLevel, flatLevelData);
 
-		//@TEMPORARY until we have actual serialization for level render settings
-		LevelRenderSettings levelRenderSettings;
-		levelRenderSettings.Init(*mLevelArena);
+		return FinishLoadingLevel(newLevel, flatLevelData, true);
+	}
 
+	r2::LevelStreamHandle LevelManager::LoadLevelAsync(const char* levelURI, bool makeCurrent)
+	{
+		LevelName levelName = r2::asset::MakeAssetNameFromPath(levelURI, r2::asset::LEVEL);
 
-		r2::Camera camera;
-		const auto displaySize = CENG.DisplaySize();
+		return LoadLevelAsync(levelName, makeCurrent);
+	}
 
-		auto aspect = static_cast<float>(displaySize.width) / static_cast<float>(displaySize.height);
-		//@TODO(Serge): temporary
-		r2::cam::InitPerspectiveCam(camera, 70.0f, aspect, 0.1f, 1000.0f, glm::vec3(5.0f, -8.0f, 7.0f), glm::normalize(glm::vec3(4.0f, 3.0f, 0.0f) - glm::vec3(5.0f, -8.0f, 7.0f)));
-		levelRenderSettings.AddCamera(
-			camera
-#ifdef R2_EDITOR
-			,"Default"
-#endif
-		);
-		levelRenderSettings.SetCurrentCamera(0);
-		
-		newLevel.Init(
-			flatLevelData->version(),
-			flatLevelData->levelAsset()->assetName()->stringName()->c_str(),
-			flatLevelData->groupAssetName()->stringName()->c_str(),
-			levelName,
-			modelAssets,
-			texturePackAssets,
-			soundBanks,
-			entities, levelRenderSettings);
+	r2::LevelStreamHandle LevelManager::LoadLevelAsync(LevelName levelName, bool makeCurrent)
+	{
+		LevelStreamHandle handle;
+		handle.levelName = levelName;
 
-		LoadLevelData(newLevel, flatLevelData);
+		if (!mLoadedLevels)
+		{
+			R2_CHECK(false, "We haven't initialized the LevelManager yet");
+			return handle;
+		}
 
-		r2::ecs::ECSWorld& ecsWorld = MENG.GetECSWorld();
+		if (IsLevelLoaded(levelName))
+		{
+			return handle;
+		}
 
-		ecsWorld.LoadLevel(newLevel, flatLevelData);
+		const s32 streamIndex = FindLevelStream(levelName);
+		if (streamIndex != -1)
+		{
+			mLevelStreams[streamIndex].makeCurrent = mLevelStreams[streamIndex].makeCurrent || makeCurrent;
+			handle.index = static_cast<u32>(streamIndex);
+			handle.generation = mLevelStreams[streamIndex].generation;
+			return handle;
+		}
 
-		r2::sarr::Push(*mLoadedLevels, newLevel);
+		const auto levelAsset = r2::asset::Asset(levelName, r2::asset::LEVEL);
+
+		if (!r2::asset::lib::HasAsset(MENG.GetAssetLib(), levelAsset))
+		{
+			return handle;
+		}
 
-		//@TODO(Serge): probably not correct - need to think about this
-		r2::draw::renderer::SetRenderCamera(levelRenderSettings.GetCurrentCamera());
+		//@NOTE(Serge): the level only gets its slot in mLoadedLevels when it finishes, so reserve it here by counting the in flight streams
+		if (!HasRoomForLevel())
+		{
+			R2_CHECK(false, "We can only have %u levels loaded at once", mMaxNumLevels);
+			return handle;
+		}
 
-		SetCurrentLevel(newLevel.GetLevelHandle());
+		for (u32 i = 0; i < MAX_NUM_LEVEL_STREAMS; ++i)
+		{
+			LevelStreamRequest& request = mLevelStreams[i];
 
-		MPLAT.ResetAccumulator();
-		
-		return &r2::sarr::Last(*mLoadedLevels);
+			if (request.stage != LEVEL_STREAM_STAGE_INVALID)
+			{
+				continue;
+			}
+
+			request.level = Level();
+			request.levelName = levelName;
+			request.flatLevelData = nullptr;
+			request.levelDataLoad = CENG.GetGameAssetManager().LoadAssetAsync(levelAsset);
+			r2::sarr::Clear(*request.assetLoads);
+			request.numAssetsLoaded = 0;
+			request.nextItem = 0;
+			request.makeCurrent = makeCurrent;
+			request.stage = LEVEL_STREAM_STAGE_LOADING_LEVEL_DATA;
+
+			//0 is reserved for levels that didn't need a stream
+			if (++request.generation == 0)
+			{
+				request.generation = 1;
+			}
+
+			handle.index = i;
+			handle.generation = request.generation;
+
+			return handle;
+		}
+
+		R2_CHECK(false, "We're already streaming in %u levels", MAX_NUM_LEVEL_STREAMS);
+		return handle;
+	}
+
+	r2::LevelStreamProgress LevelManager::GetLevelStreamProgress(const LevelStreamHandle& handle) const
+	{
+		LevelStreamProgress result;
+
+		if (!mLevelStreams)
+		{
+			return result;
+		}
+
+		if (handle.generation == 0 || handle.index >= MAX_NUM_LEVEL_STREAMS || mLevelStreams[handle.index].generation != handle.generation ||
+			mLevelStreams[handle.index].stage == LEVEL_STREAM_STAGE_INVALID)
+		{
+			s32 index = -1;
+			result.level = const_cast<LevelManager*>(this)->FindLoadedLevel(handle.levelName, index);
+			if (result.level)
+			{
+				result.stage = LEVEL_STREAM_STAGE_DONE;
+				result.progress = 1.0f;
+			}
+
+			return result;
+		}
+
+		const LevelStreamRequest& request = mLevelStreams[handle.index];
+
+		result.stage = request.stage;
+
+		//each stage counts for the same amount of progress
+		const f32 numStages = static_cast<f32>(LEVEL_STREAM_STAGE_DONE - LEVEL_STREAM_STAGE_LOADING_LEVEL_DATA);
+		f32 stageProgress = 0.0f;
+
+		switch (request.stage)
+		{
+		case LEVEL_STREAM_STAGE_LOADING_ASSETS:
+		{
+			const u32 numAssets = r2::sarr::Size(*request.assetLoads);
+			stageProgress = numAssets > 0 ? static_cast<f32>(request.numAssetsLoaded) / static_cast<f32>(numAssets) : 1.0f;
+		}
+		break;
+		case LEVEL_STREAM_STAGE_UPLOADING_MODELS:
+		{
+			const u32 numModels = request.flatLevelData->modelFilePaths()->size();
+			stageProgress = numModels > 0 ? static_cast<f32>(request.nextItem) / static_cast<f32>(numModels) : 1.0f;
+		}
+		break;
+		case LEVEL_STREAM_STAGE_LOADING_MATERIALS:
+		{
+			const u32 numMaterials = request.flatLevelData->materialNames()->size();
+			stageProgress = numMaterials > 0 ? static_cast<f32>(request.nextItem) / static_cast<f32>(numMaterials) : 1.0f;
+		}
+		break;
+		default:
+			break;
+		}
+
+		if (request.stage == LEVEL_STREAM_STAGE_DONE || request.stage == LEVEL_STREAM_STAGE_FAILED)
+		{
+			result.progress = 1.0f;
+		}
+		else
+		{
+			result.progress = (static_cast<f32>(request.stage - LEVEL_STREAM_STAGE_LOADING_LEVEL_DATA) + stageProgress) / numStages;
+		}
+
+		return result;
+	}
+
+	Level* LevelManager::WaitForLevelStream(const LevelStreamHandle& handle)
+	{
+		if (!mLevelStreams)
+		{
+			return nullptr;
+		}
+
+		if (handle.generation != 0 && handle.index < MAX_NUM_LEVEL_STREAMS && mLevelStreams[handle.index].generation == handle.generation)
+		{
+			LevelStreamRequest& request = mLevelStreams[handle.index];
+
+			while (request.stage != LEVEL_STREAM_STAGE_INVALID &&
+				request.stage != LEVEL_STREAM_STAGE_DONE &&
+				request.stage != LEVEL_STREAM_STAGE_FAILED)
+			{
+				AdvanceLevelStream(request, std::numeric_limits<f64>::max(), true);
+			}
+
+			if (request.stage != LEVEL_STREAM_STAGE_INVALID)
+			{
+				ReleaseLevelStream(request);
+			}
+		}
+
+		return GetLevel(handle.levelName);
+	}
+
+	bool LevelManager::IsStreamingLevels() const
+	{
+		if (!mLevelStreams)
+		{
+			return false;
+		}
+
+		for (u32 i = 0; i < MAX_NUM_LEVEL_STREAMS; ++i)
+		{
+			if (mLevelStreams[i].stage != LEVEL_STREAM_STAGE_INVALID)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void LevelManager::SetLevelStreamFrameBudget(f64 budgetMs)
+	{
+		mLevelStreamFrameBudgetMs = std::max(budgetMs, 0.0);
+	}
+
+	bool LevelManager::AddStreamingLevel(LevelName levelName, const glm::vec3& center, f32 loadRadius, f32 unloadRadius)
+	{
+		if (!mStreamingLevels)
+		{
+			R2_CHECK(false, "We haven't initialized the LevelManager yet");
+			return false;
+		}
+
+		R2_CHECK(unloadRadius >= loadRadius, "The unload radius should be at least the load radius otherwise the level will keep getting loaded and unloaded");
+
+		StreamingLevel streamingLevel;
+		streamingLevel.levelName = levelName;
+		streamingLevel.center = center;
+		streamingLevel.loadRadius = loadRadius;
+		streamingLevel.unloadRadius = std::max(loadRadius, unloadRadius);
+
+		const u32 numStreamingLevels = r2::sarr::Size(*mStreamingLevels);
+		for (u32 i = 0; i < numStreamingLevels; ++i)
+		{
+			if (r2::sarr::At(*mStreamingLevels, i).levelName == levelName)
+			{
+				r2::sarr::At(*mStreamingLevels, i) = streamingLevel;
+				return true;
+			}
+		}
+
+		if (numStreamingLevels == r2::sarr::Capacity(*mStreamingLevels))
+		{
+			R2_CHECK(false, "We can only have %u streaming levels", MAX_NUM_STREAMING_LEVELS);
+			return false;
+		}
+
+		r2::sarr::Push(*mStreamingLevels, streamingLevel);
+
+		return true;
+	}
+
+	void LevelManager::RemoveStreamingLevel(LevelName levelName)
+	{
+		if (!mStreamingLevels)
+		{
+			return;
+		}
+
+		const u32 numStreamingLevels = r2::sarr::Size(*mStreamingLevels);
+		for (u32 i = 0; i < numStreamingLevels; ++i)
+		{
+			if (r2::sarr::At(*mStreamingLevels, i).levelName == levelName)
+			{
+				r2::sarr::RemoveAndSwapWithLastElement(*mStreamingLevels, i);
+				return;
+			}
+		}
+	}
+
+	void LevelManager::SetStreamingOrigin(const glm::vec3& origin)
+	{
+		mStreamingOrigin = origin;
+		mHasStreamingOrigin = true;
+	}
+
+	void LevelManager::Update()
+	{
+		if (!mLevelStreams)
+		{
+			return;
+		}
+
+		UpdateStreamingLevels();
+
+		//the job threads do the heavy lifting, this is just to keep the main thread stages from taking over the frame
+		const f64 deadline = CENG.GetTicks() + mLevelStreamFrameBudgetMs;
+
+		for (u32 i = 0; i < MAX_NUM_LEVEL_STREAMS; ++i)
+		{
+			LevelStreamRequest& request = mLevelStreams[i];
+
+			if (request.stage == LEVEL_STREAM_STAGE_INVALID)
+			{
+				continue;
+			}
+
+			while (request.stage != LEVEL_STREAM_STAGE_DONE &&
+				request.stage != LEVEL_STREAM_STAGE_FAILED &&
+				AdvanceLevelStream(request, deadline, false) &&
+				CENG.GetTicks() < deadline)
+			{
+			}
+
+			if (request.stage == LEVEL_STREAM_STAGE_DONE || request.stage == LEVEL_STREAM_STAGE_FAILED)
+			{
+				ReleaseLevelStream(request);
+			}
+		}
 	}
 
 	void LevelManager::UnloadLevel(const Level* level)
@@ -311,23 +620,52 @@ namespace r2
 		{
 			mCurrentLevel = -1;
 		}
+		else if (mCurrentLevel == static_cast<s32>(r2::sarr::Size(*mLoadedLevels)) - 1)
+		{
+			//the current level is about to be swapped into the unloaded level's spot
+			mCurrentLevel = index;
+		}
 
 		r2::sarr::RemoveAndSwapWithLastElement(*mLoadedLevels, index);
 
 		UnLoadLevelData(copyOfLevel);
 
-		copyOfLevel.mLevelRenderSettings.Shutdown<r2::mem::FreeListArena>(*mLevelArena);
+		FreeLevel(copyOfLevel);
+	}
 
-		FREE(copyOfLevel.mEntities, *mLevelArena);
-		FREE(copyOfLevel.mSoundBanks, *mLevelArena);
-		FREE(copyOfLevel.mMaterials, *mLevelArena);
-		FREE(copyOfLevel.mModelAssets, *mLevelArena);
+	void LevelManager::FreeLevel(Level& level)
+	{
+		level.mLevelRenderSettings.Shutdown<r2::mem::FreeListArena>(*mLevelArena);
+
+		FREE(level.mEntities, *mLevelArena);
+		FREE(level.mSoundBanks, *mLevelArena);
+		FREE(level.mMaterials, *mLevelArena);
+		FREE(level.mModelAssets, *mLevelArena);
 
 		r2::GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
 
-		gameAssetManager.UnloadAsset(copyOfLevel.GetLevelHandle());
+		gameAssetManager.UnloadAsset(level.GetLevelHandle());
 		
-		copyOfLevel.Shutdown();
+		level.Shutdown();
+	}
+
+	bool LevelManager::HasRoomForLevel() const
+	{
+		u32 numLevels = r2::sarr::Size(*mLoadedLevels);
+
+		for (u32 i = 0; i < MAX_NUM_LEVEL_STREAMS; ++i)
+		{
+			const LevelStreamStage stage = mLevelStreams[i].stage;
+
+			if (stage != LEVEL_STREAM_STAGE_INVALID &&
+				stage != LEVEL_STREAM_STAGE_DONE &&
+				stage != LEVEL_STREAM_STAGE_FAILED)
+			{
+				++numLevels;
+			}
+		}
+
+		return numLevels < mMaxNumLevels;
 	}
 
 
@@ -405,24 +743,121 @@ namespace r2
 		return nullptr;
 	}
 
-	void LevelManager::LoadLevelData(Level& level, const flat::LevelData* levelData)
+	void LevelManager::MakeLevel(LevelName levelName, const flat::LevelData* flatLevelData, Level& newLevel)
 	{
-		r2::SArray<r2::asset::AssetName>* modelAssets = level.mModelAssets;
-		r2::SArray<r2::mat::MaterialName>* materials = level.mMaterials;
-		r2::SArray<r2::asset::AssetName>* soundBanks = level.mSoundBanks;
+#ifdef R2_ASSET_PIPELINE
+		r2::SArray<r2::asset::AssetName>* modelAssets = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, MAX_NUM_MODELS);
+		r2::SArray<r2::mat::MaterialName>* texturePackAssets = MAKE_SARRAY(*mLevelArena, r2::mat::MaterialName, MAX_NUM_TEXTURE_PACKS);
+		r2::SArray<r2::asset::AssetName>* soundBanks = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, MAX_NUM_SOUND_BANKS);
+#else
+		r2::SArray<r2::asset::AssetName>* modelAssets = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, flatLevelData->modelFilePaths()->size());
+		r2::SArray<r2::mat::MaterialName>* texturePackAssets = MAKE_SARRAY(*mLevelArena, r2::mat::MaterialName, flatLevelData->materialNames()->size() * r2::draw::tex::NUM_TEXTURE_TYPES);
+		r2::SArray<r2::asset::AssetName>* soundBanks = MAKE_SARRAY(*mLevelArena, r2::asset::AssetName, flatLevelData->soundPaths()->size());
+#endif
+		
+		const u32 numLevelEntities = flatLevelData->entities() ? flatLevelData->entities()->size() : 0;
+		R2_CHECK(numLevelEntities <= mMaxNumEntities, "Level has %u entities but the ECSWorld can only have %u", numLevelEntities, mMaxNumEntities);
+
+		r2::SArray<ecs::Entity>* entities = MAKE_SARRAY(*mLevelArena, ecs::Entity, std::max(numLevelEntities, INITIAL_NUM_LEVEL_ENTITIES));
+
+
+		//@TEMPORARY until we have actual serialization for level render settings
+		LevelRenderSettings levelRenderSettings;
+		levelRenderSettings.Init(*mLevelArena);
+
+
+		r2::Camera camera;
+		const auto displaySize = CENG.DisplaySize();
+
+		auto aspect = static_cast<float>(displaySize.width) / static_cast<float>(displaySize.height);
+		//@TODO(Serge): temporary
+		r2::cam::InitPerspectiveCam(camera, 70.0f, aspect, 0.1f, 1000.0f, glm::vec3(5.0f, -8.0f, 7.0f), glm::normalize(glm::vec3(4.0f, 3.0f, 0.0f) - glm::vec3(5.0f, -8.0f, 7.0f)));
+		levelRenderSettings.AddCamera(
+			camera
+#ifdef R2_EDITOR
+			,"Default"
+#endif
+		);
+		levelRenderSettings.SetCurrentCamera(0);
+		
+		newLevel.Init(
+			flatLevelData->version(),
+			flatLevelData->levelAsset()->assetName()->stringName()->c_str(),
+			flatLevelData->groupAssetName()->stringName()->c_str(),
+			levelName,
+			modelAssets,
+			texturePackAssets,
+			soundBanks,
+			entities, levelRenderSettings);
+		newLevel.mnoptrEntityArena = mLevelArena;
+	}
+
+	Level* LevelManager::FinishLoadingLevel(Level& newLevel, const flat::LevelData* flatLevelData, bool makeCurrent)
+	{
+		if (!r2::sarr::HasRoom(*mLoadedLevels))
+		{
+			R2_CHECK(false, "We can only have %u levels loaded at once", mMaxNumLevels);
+
+			UnLoadLevelData(newLevel);
+			FreeLevel(newLevel);
+
+			return nullptr;
+		}
+
+		r2::ecs::ECSWorld& ecsWorld = MENG.GetECSWorld();
+
+		ecsWorld.LoadLevel(newLevel, flatLevelData);
+
+		r2::sarr::Push(*mLoadedLevels, newLevel);
 
+		Level& loadedLevel = r2::sarr::Last(*mLoadedLevels);
+
+		if (makeCurrent)
+		{
+			//@TODO(Serge): probably not correct - need to think about this
+			r2::draw::renderer::SetRenderCamera(loadedLevel.mLevelRenderSettings.GetCurrentCamera());
+
+			SetCurrentLevel(loadedLevel.GetLevelHandle());
+
+			MPLAT.ResetAccumulator();
+		}
+
+		return &loadedLevel;
+	}
+
+	void LevelManager::LoadLevelData(Level& level, const flat::LevelData* levelData)
+	{
 		f64 start = CENG.GetTicks();
 
-		r2::GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
-		r2::draw::TexturePacksCache& texturePacksCache = CENG.GetTexturePacksCache();
+		LoadLevelModels(level, levelData, 0, levelData->modelFilePaths()->size());
 
-		const auto* modelFiles = levelData->modelFilePaths();
+		f64 endModelLoading = CENG.GetTicks();
 
-		const flatbuffers::uoffset_t numModelFiles = modelFiles->size();
+		LoadLevelSoundBanks(level, levelData);
 
-		f64 startModelLoading = start;
+		f64 endSoundLoading = CENG.GetTicks();
+
+		LoadLevelMaterials(level, levelData, 0, levelData->materialNames()->size());
 
-		for (flatbuffers::uoffset_t i = 0; i < numModelFiles; ++i)
+		f64 end = CENG.GetTicks();
+		
+#ifdef R2_DEBUG
+		printf("Model loading took: %f\n", endModelLoading - start);
+		printf("Sound loading took: %f\n", endSoundLoading - endModelLoading);
+		printf("Material loading took: %f\n", end - endSoundLoading);
+		printf("Total load time: %f\n", end - start);
+#endif
+	}
+
+	void LevelManager::LoadLevelModels(Level& level, const flat::LevelData* levelData, u32 start, u32 end)
+	{
+		r2::SArray<r2::asset::AssetName>* modelAssets = level.mModelAssets;
+
+		r2::GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
+
+		const auto* modelFiles = levelData->modelFilePaths();
+
+		for (flatbuffers::uoffset_t i = start; i < end; ++i)
 		{
 			r2::asset::AssetName modelAssetName;
 			r2::asset::MakeAssetNameFromFlatAssetName(modelFiles->Get(i), modelAssetName);
@@ -432,15 +867,17 @@ namespace r2
 			const r2::draw::Model* model = gameAssetManager.LoadAndGetAssetConst<r2::draw::Model>(modelAsset);
 			r2::draw::renderer::UploadModel(model);
 		}
+	}
 
-		f64 endModelLoading = CENG.GetTicks();
+	void LevelManager::LoadLevelSoundBanks(Level& level, const flat::LevelData* levelData)
+	{
+		r2::SArray<r2::asset::AssetName>* soundBanks = level.mSoundBanks;
 
-		f64 soundLoading = endModelLoading;
+		r2::GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
 
 		const auto* soundPaths = levelData->soundPaths();
 		const flatbuffers::uoffset_t numSoundPaths = soundPaths->size();
 
-		char soundBankFilePath[r2::fs::FILE_PATH_LENGTH];
 		for (flatbuffers::uoffset_t i = 0; i < numSoundPaths; ++i)
 		{
 			r2::asset::AssetName soundAssetName;
@@ -448,116 +885,281 @@ namespace r2
 			gameAssetManager.LoadAsset(r2::asset::Asset(soundAssetName, r2::asset::SOUND));
 			r2::sarr::Push(*soundBanks, soundAssetName);
 		}
+	}
 
-		f64 endSoundLoading = CENG.GetTicks();
-		f64 startMaterialLoading = endSoundLoading;
+	void LevelManager::LoadLevelMaterials(Level& level, const flat::LevelData* levelData, u32 start, u32 end)
+	{
+		r2::SArray<r2::mat::MaterialName>* materials = level.mMaterials;
 
-		f64 materialGatherStart;
-		f64 materialGatherEnd;
+		r2::draw::TexturePacksCache& texturePacksCache = CENG.GetTexturePacksCache();
 
-		f64 materialDiskLoadStart;
-		f64 materialDiskLoadEnd;
+		//@TODO(Serge): probably all of this will change when we do the texture refactor
+		const auto* materialNames = levelData->materialNames();
 
-		f64 materialUploadStart;
-		f64 materialUploadEnd;
+		const u32 numMaterials = end - start;
 
-		f64 totalTextureUploadTime = 0;
-		//load the materials
-		//@TODO(Serge): probably all of this will change when we do the texture refactor
+		if (numMaterials == 0)
 		{
+			return;
+		}
+
+		r2::SArray<const flat::Material*>* materialsToLoad = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, const flat::Material*, numMaterials);
+
+		u32 numTexturesTotal = 0;
+
+		//gather all the materials
+		for (flatbuffers::uoffset_t i = start; i < end; ++i)
+		{
+			const flat::MaterialName* flatMaterialName = materialNames->Get(i);
+
+			r2::mat::MaterialName materialName = r2::mat::MakeMaterialNameFromFlatMaterial(flatMaterialName);
 
-			materialGatherStart = CENG.GetTicks();
-			const auto* materialNames = levelData->materialNames();
+			const flat::Material* material = r2::mat::GetMaterialForMaterialName(materialName);
 
-			const flatbuffers::uoffset_t numMaterials = materialNames->size();
+			R2_CHECK(material != nullptr, "This should never be nullptr");
 
-			r2::SArray<const flat::Material*>* materialsToLoad = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, const flat::Material*, numMaterials);
+			numTexturesTotal = std::max(material->shaderParams()->textureParams()->size(), numTexturesTotal);
 
-			u32 numTexturesTotal = 0;
-			u32 numCubemapTexturesTotal = numMaterials;
+			r2::sarr::Push(*materialsToLoad, material);
 
-			//gather all the materials
-			for (flatbuffers::uoffset_t i = 0; i < numMaterials; ++i)
+			r2::sarr::Push(*materials, materialName);
+		}
+
+		//Load from disk
+		for (u32 i = 0; i < numMaterials; ++i)
+		{
+			bool result = r2::draw::texche::LoadMaterialTextures(texturePacksCache, r2::sarr::At(*materialsToLoad, i));
+			R2_CHECK(result, "Should always work");
+		}
+
+		//load to gpu
+		r2::SArray<r2::draw::tex::Texture>* gameTextures = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, r2::draw::tex::Texture, numTexturesTotal);
+		r2::SArray<r2::draw::tex::CubemapTexture>* gameCubemaps = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, r2::draw::tex::CubemapTexture, numTexturesTotal);
+
+		r2::draw::RenderMaterialCache* renderMaterialCache = r2::draw::renderer::GetRenderMaterialCache();
+		for (u32 i = 0; i < numMaterials; ++i)
+		{
+			const flat::Material* material = r2::sarr::At(*materialsToLoad, i);
+			bool result = r2::draw::texche::GetTexturesForFlatMaterial(texturePacksCache, material, gameTextures, gameCubemaps);
+			R2_CHECK(result, "Should always work");
+
+			r2::SArray<r2::draw::tex::Texture>* texturesToUse = nullptr;
+			if (r2::sarr::Size(*gameTextures) > 0)
 			{
-				const flat::MaterialName* flatMaterialName = materialNames->Get(i);
+				texturesToUse = gameTextures;
+			}
 
-				r2::mat::MaterialName materialName = r2::mat::MakeMaterialNameFromFlatMaterial(flatMaterialName);
+			r2::draw::tex::CubemapTexture* cubemapTexture = nullptr;
+			if (r2::sarr::Size(*gameCubemaps) > 0)
+			{
+				cubemapTexture = &r2::sarr::At(*gameCubemaps, 0);
+			}
 
-				const flat::Material* material = r2::mat::GetMaterialForMaterialName(materialName);
+			r2::draw::rmat::UploadMaterialTextureParams(*renderMaterialCache, material, texturesToUse, cubemapTexture, false);
 
-				R2_CHECK(material != nullptr, "This should never be nullptr");
+			r2::sarr::Clear(*gameTextures);
+			r2::sarr::Clear(*gameCubemaps);
+		}
 
-				numTexturesTotal = std::max(material->shaderParams()->textureParams()->size(), numTexturesTotal);
+		FREE(gameCubemaps, *MEM_ENG_SCRATCH_PTR);
+		FREE(gameTextures, *MEM_ENG_SCRATCH_PTR);
 
-				r2::sarr::Push(*materialsToLoad, material);
+		FREE(materialsToLoad, *MEM_ENG_SCRATCH_PTR);
+	}
 
-				r2::sarr::Push(*materials, materialName);
+	s32 LevelManager::FindLevelStream(LevelName levelName) const
+	{
+		for (u32 i = 0; i < MAX_NUM_LEVEL_STREAMS; ++i)
+		{
+			if (mLevelStreams[i].stage != LEVEL_STREAM_STAGE_INVALID && mLevelStreams[i].levelName == levelName)
+			{
+				return static_cast<s32>(i);
 			}
+		}
+
+		return -1;
+	}
+
+	bool LevelManager::AdvanceLevelStream(LevelStreamRequest& request, f64 deadline, bool wait)
+	{
+		r2::GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
+
+		switch (request.stage)
+		{
+		case LEVEL_STREAM_STAGE_LOADING_LEVEL_DATA:
+		{
+			r2::asset::AssetLoadStatus status = gameAssetManager.GetAsyncLoadStatus(request.levelDataLoad);
+
+			if (IsAsyncLoadPending(status))
+			{
+				if (!wait)
+				{
+					return false;
+				}
+
+				status = gameAssetManager.WaitForAsyncLoad(request.levelDataLoad);
+			}
+
+			if (status == r2::asset::ASSET_LOAD_STATUS_FAILED)
+			{
+				R2_CHECK(false, "Failed to load the level data");
+				request.stage = LEVEL_STREAM_STAGE_FAILED;
+				return true;
+			}
+
+			//the load is finished so this is just getting it out of the cache
+			const byte* levelData = gameAssetManager.LoadAndGetAssetConst<byte>(r2::asset::Asset(request.levelName, r2::asset::LEVEL));
+			request.flatLevelData = flat::GetLevelData(levelData);
+
+			MakeLevel(request.levelName, request.flatLevelData, request.level);
 
-			materialGatherEnd = CENG.GetTicks();
-			materialDiskLoadStart = materialGatherEnd;
-			//Load from disk
-			for (u32 i = 0; i < numMaterials; ++i)
+			//kick off the reads for everything we can load off of the main thread
+			const auto* modelFiles = request.flatLevelData->modelFilePaths();
+			const auto* soundPaths = request.flatLevelData->soundPaths();
+
+			for (flatbuffers::uoffset_t i = 0; i < modelFiles->size() && r2::sarr::Size(*request.assetLoads) < r2::sarr::Capacity(*request.assetLoads); ++i)
 			{
-				bool result = r2::draw::texche::LoadMaterialTextures(texturePacksCache, r2::sarr::At(*materialsToLoad, i));
-				R2_CHECK(result, "Should always work");
+				r2::asset::AssetName modelAssetName;
+				r2::asset::MakeAssetNameFromFlatAssetName(modelFiles->Get(i), modelAssetName);
+				r2::sarr::Push(*request.assetLoads, gameAssetManager.LoadAssetAsync(r2::asset::Asset(modelAssetName, r2::asset::RMODEL)));
 			}
 
-			materialDiskLoadEnd = CENG.GetTicks();
-			materialUploadStart = materialDiskLoadEnd;
+			for (flatbuffers::uoffset_t i = 0; i < soundPaths->size() && r2::sarr::Size(*request.assetLoads) < r2::sarr::Capacity(*request.assetLoads); ++i)
+			{
+				r2::asset::AssetName soundAssetName;
+				r2::asset::MakeAssetNameFromFlatAssetName(soundPaths->Get(i), soundAssetName);
+				r2::sarr::Push(*request.assetLoads, gameAssetManager.LoadAssetAsync(r2::asset::Asset(soundAssetName, r2::asset::SOUND)));
+			}
 
-			//load to gpu
-			r2::SArray<r2::draw::tex::Texture>* gameTextures = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, r2::draw::tex::Texture, numTexturesTotal);
-			r2::SArray<r2::draw::tex::CubemapTexture>* gameCubemaps = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, r2::draw::tex::CubemapTexture, numTexturesTotal);
+			request.numAssetsLoaded = 0;
+			request.stage = LEVEL_STREAM_STAGE_LOADING_ASSETS;
+			return true;
+		}
+		case LEVEL_STREAM_STAGE_LOADING_ASSETS:
+		{
+			//any asset that failed or got evicted in the meantime will just be loaded synchronously when we upload it
+			const u32 numAssetLoads = r2::sarr::Size(*request.assetLoads);
 
-			r2::draw::RenderMaterialCache* renderMaterialCache = r2::draw::renderer::GetRenderMaterialCache();
-			for (u32 i = 0; i < numMaterials; ++i)
+			for (; request.numAssetsLoaded < numAssetLoads; ++request.numAssetsLoaded)
 			{
-				const flat::Material* material = r2::sarr::At(*materialsToLoad, i);
-				bool result = r2::draw::texche::GetTexturesForFlatMaterial(texturePacksCache, material, gameTextures, gameCubemaps);
-				R2_CHECK(result, "Should always work");
+				const r2::asset::AsyncAssetLoadHandle& loadHandle = r2::sarr::At(*request.assetLoads, request.numAssetsLoaded);
 
-				r2::SArray<r2::draw::tex::Texture>* texturesToUse = nullptr;
-				if (r2::sarr::Size(*gameTextures) > 0)
+				if (IsAsyncLoadPending(gameAssetManager.GetAsyncLoadStatus(loadHandle)))
 				{
-					texturesToUse = gameTextures;
+					if (!wait)
+					{
+						return false;
+					}
+
+					gameAssetManager.WaitForAsyncLoad(loadHandle);
 				}
+			}
 
-				r2::draw::tex::CubemapTexture* cubemapTexture = nullptr;
-				if (r2::sarr::Size(*gameCubemaps) > 0)
+			request.nextItem = 0;
+			request.stage = LEVEL_STREAM_STAGE_UPLOADING_MODELS;
+			return true;
+		}
+		case LEVEL_STREAM_STAGE_UPLOADING_MODELS:
+		{
+			const u32 numModels = request.flatLevelData->modelFilePaths()->size();
+
+			while (request.nextItem < numModels)
+			{
+				LoadLevelModels(request.level, request.flatLevelData, request.nextItem, request.nextItem + 1);
+				++request.nextItem;
+
+				if (request.nextItem < numModels && CENG.GetTicks() >= deadline)
 				{
-					cubemapTexture = &r2::sarr::At(*gameCubemaps, 0);
+					return false;
 				}
+			}
+
+			//these were loaded on the job threads so this is just adding them to the level
+			LoadLevelSoundBanks(request.level, request.flatLevelData);
 
-				f64 texParamUploadStart = CENG.GetTicks();
-				r2::draw::rmat::UploadMaterialTextureParams(*renderMaterialCache, material, texturesToUse, cubemapTexture, false);
-				f64 texParamUploadEnd = CENG.GetTicks();
-				totalTextureUploadTime += (texParamUploadEnd - texParamUploadStart);
+			request.nextItem = 0;
+			request.stage = LEVEL_STREAM_STAGE_LOADING_MATERIALS;
+			return true;
+		}
+		case LEVEL_STREAM_STAGE_LOADING_MATERIALS:
+		{
+			const u32 numMaterials = request.flatLevelData->materialNames()->size();
+
+			while (request.nextItem < numMaterials)
+			{
+				LoadLevelMaterials(request.level, request.flatLevelData, request.nextItem, request.nextItem + 1);
+				++request.nextItem;
 
-				r2::sarr::Clear(*gameTextures);
-				r2::sarr::Clear(*gameCubemaps);
+				if (request.nextItem < numMaterials && CENG.GetTicks() >= deadline)
+				{
+					return false;
+				}
 			}
 
-			FREE(gameCubemaps, *MEM_ENG_SCRATCH_PTR);
-			FREE(gameTextures, *MEM_ENG_SCRATCH_PTR);
+			request.nextItem = 0;
+			request.stage = LEVEL_STREAM_STAGE_LOADING_ENTITIES;
+			return true;
+		}
+		case LEVEL_STREAM_STAGE_LOADING_ENTITIES:
+		{
+			if (!FinishLoadingLevel(request.level, request.flatLevelData, request.makeCurrent))
+			{
+				request.stage = LEVEL_STREAM_STAGE_FAILED;
+				return true;
+			}
 
-			FREE(materialsToLoad, *MEM_ENG_SCRATCH_PTR);
+			request.stage = LEVEL_STREAM_STAGE_DONE;
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
 
-			materialUploadEnd = CENG.GetTicks();
+	void LevelManager::ReleaseLevelStream(LevelStreamRequest& request)
+	{
+		request.level = Level();
+		request.flatLevelData = nullptr;
+		request.levelDataLoad = {};
+		r2::sarr::Clear(*request.assetLoads);
+		request.numAssetsLoaded = 0;
+		request.nextItem = 0;
+		request.stage = LEVEL_STREAM_STAGE_INVALID;
+	}
+
+	void LevelManager::UpdateStreamingLevels()
+	{
+		if (!mHasStreamingOrigin)
+		{
+			return;
 		}
 
-		f64 end = materialUploadEnd;
-		
-#ifdef R2_DEBUG
-		printf("Model loading took: %f\n", endModelLoading - startModelLoading);
-		printf("Sound loading took: %f\n", endSoundLoading - soundLoading);
-		printf("Material Gather took: %f\n", materialGatherEnd - materialGatherStart);
-		printf("Material disk load took: %f\n", materialDiskLoadEnd - materialDiskLoadStart);
-		printf("Material upload took: %f\n", materialUploadEnd - materialUploadStart);
-		printf("Material loading took: %f\n", end - startMaterialLoading);
-		printf("Texture param upload took: %f\n", totalTextureUploadTime);
-		printf("Total load time: %f\n", end - start);
-#endif
+		const u32 numStreamingLevels = r2::sarr::Size(*mStreamingLevels);
+
+		for (u32 i = 0; i < numStreamingLevels; ++i)
+		{
+			const StreamingLevel& streamingLevel = r2::sarr::At(*mStreamingLevels, i);
+
+			const f32 distance = glm::length(mStreamingOrigin - streamingLevel.center);
+
+			if (distance <= streamingLevel.loadRadius)
+			{
+				//if we're full, leave it for a later frame once something gets unloaded
+				if (!IsLevelLoaded(streamingLevel.levelName) && FindLevelStream(streamingLevel.levelName) == -1 && HasRoomForLevel())
+				{
+					LoadLevelAsync(streamingLevel.levelName, false);
+				}
+			}
+			else if (distance > streamingLevel.unloadRadius)
+			{
+				//anything still streaming in gets unloaded once it's done
+				Level* level = GetLevel(streamingLevel.levelName);
+				if (level)
+				{
+					UnloadLevel(level);
+				}
+			}
+		}
 	}
 
 	void LevelManager::UnLoadLevelData(const Level& level)
@@ -715,7 +1317,8 @@ namespace r2
 
 		u64 freeListArenaSize = r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::mem::FreeListArena), memProperties.alignment, stackHeaderSize, memProperties.boundsChecking);
 
-		freeListArenaSize += Level::MemorySize(maxNumModels, maxNumTexturePacks, maxNumEntities, maxNumSoundBanks, lvlArenaMemProps) * maxNumLevels;
+		freeListArenaSize += Level::MemorySize(maxNumModels, maxNumTexturePacks, maxNumSoundBanks, 0, lvlArenaMemProps) * maxNumLevels;
+		freeListArenaSize += LevelEntitiesMemorySize(maxNumLevels, maxNumEntities);
 		
 		memorySize += freeListArenaSize;
 		
@@ -723,9 +1326,21 @@ namespace r2
 		
 		memorySize += hashMapSize;
 
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(sizeof(LevelStreamRequest) * (MAX_NUM_LEVEL_STREAMS + 1), memProperties.alignment, stackHeaderSize, memProperties.boundsChecking);
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<r2::asset::AsyncAssetLoadHandle>::MemorySize(maxNumModels + maxNumSoundBanks), memProperties.alignment, stackHeaderSize, memProperties.boundsChecking) * MAX_NUM_LEVEL_STREAMS;
+		memorySize += r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<StreamingLevel>::MemorySize(MAX_NUM_STREAMING_LEVELS), memProperties.alignment, stackHeaderSize, memProperties.boundsChecking);
+
 		return memorySize;
 	}
 
+	u64 LevelManager::LevelEntitiesMemorySize(u32 maxNumLevels, u32 maxNumEntities)
+	{
+		//@NOTE(Serge): every level starts with room for INITIAL_NUM_LEVEL_ENTITIES and grows as needed. All of the loaded levels together can't have
+		//				more entities than the ECSWorld so we only need room for that many once, plus the old array while growing.
+		return r2::SArray<ecs::Entity>::MemorySize(INITIAL_NUM_LEVEL_ENTITIES) * maxNumLevels +
+			r2::SArray<ecs::Entity>::MemorySize(maxNumEntities) * 2;
+	}
+
 #ifdef R2_ASSET_PIPELINE
 	void LevelManager::ImportSoundToLevel(Level* level, const r2::asset::AssetName& assetName)
 	{
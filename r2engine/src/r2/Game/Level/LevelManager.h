@@ -23,6 +23,32 @@ namespace r2
 
 	using LevelGroup = r2::SArray<Level*>*;
 
+	enum LevelStreamStage : u32
+	{
+		LEVEL_STREAM_STAGE_INVALID = 0,
+		LEVEL_STREAM_STAGE_LOADING_LEVEL_DATA, //reading the level file on the job threads
+		LEVEL_STREAM_STAGE_LOADING_ASSETS, //reading + processing the level's models and sound banks on the job threads
+		LEVEL_STREAM_STAGE_UPLOADING_MODELS, //main thread, spread across frames
+		LEVEL_STREAM_STAGE_LOADING_MATERIALS, //main thread, spread across frames
+		LEVEL_STREAM_STAGE_LOADING_ENTITIES, //main thread
+		LEVEL_STREAM_STAGE_DONE,
+		LEVEL_STREAM_STAGE_FAILED
+	};
+
+	struct LevelStreamHandle
+	{
+		LevelName levelName;
+		u32 index = 0;
+		u32 generation = 0; //0 means the level was already loaded (or couldn't be found) when the stream was asked for
+	};
+
+	struct LevelStreamProgress
+	{
+		LevelStreamStage stage = LEVEL_STREAM_STAGE_INVALID;
+		f32 progress = 0.0f; //0 to 1
+		Level* level = nullptr; //only set once the stage is LEVEL_STREAM_STAGE_DONE
+	};
+
 	class LevelManager
 	{
 	public:
@@ -33,6 +59,10 @@ namespace r2
 		static const u32 MAX_NUM_ANIMATIONS;
 		static const u32 MAX_NUM_TEXTURE_PACKS;
 		static const u32 MAX_NUM_SOUND_BANKS;
+		static const u32 INITIAL_NUM_LEVEL_ENTITIES;
+		static const u32 MAX_NUM_LEVEL_STREAMS;
+		static const u32 MAX_NUM_STREAMING_LEVELS;
+		static const f64 DEFAULT_LEVEL_STREAM_FRAME_BUDGET_MS;
 
 		LevelManager();
 		~LevelManager();
@@ -40,7 +70,8 @@ namespace r2
 		bool Init(
 			r2::mem::MemoryArea::Handle memoryAreaHandle,
 			const char* areaName,
-			u32 maxNumLevels);
+			u32 maxNumLevels,
+			u32 maxNumEntities);
 		void Shutdown();
 
 		Level* MakeNewLevel(const char* levelNameStr, const char* groupName, LevelName levelName, const r2::Camera& defaultCamera);
@@ -48,6 +79,25 @@ namespace r2
 		Level* LoadLevel(const char* levelURI);
 		Level* LoadLevel(LevelName levelName);
 
+		//Loads the level over multiple frames instead of all at once. The level file, models and sound banks are read and processed
+		//on the job threads and the main thread work (uploads, materials and entities) is spread across Update() calls within the frame budget.
+		//Once a stream is done its request is recycled so the progress will only report LEVEL_STREAM_STAGE_DONE while the level is still loaded.
+		LevelStreamHandle LoadLevelAsync(const char* levelURI, bool makeCurrent = true);
+		LevelStreamHandle LoadLevelAsync(LevelName levelName, bool makeCurrent = true);
+		LevelStreamProgress GetLevelStreamProgress(const LevelStreamHandle& handle) const;
+		//Finishes the stream right away on the calling thread
+		Level* WaitForLevelStream(const LevelStreamHandle& handle);
+		bool IsStreamingLevels() const;
+		void SetLevelStreamFrameBudget(f64 budgetMs);
+
+		//Sub levels are streamed in once the streaming origin is within loadRadius of their center and unloaded once it's further than unloadRadius
+		bool AddStreamingLevel(LevelName levelName, const glm::vec3& center, f32 loadRadius, f32 unloadRadius);
+		void RemoveStreamingLevel(LevelName levelName);
+		void SetStreamingOrigin(const glm::vec3& origin);
+
+		//Moves the level streams along. Main thread only.
+		void Update();
+
 		Level* GetLevel(const char* levelURI);
 		Level* GetLevel(LevelName levelName);
 
@@ -84,18 +134,64 @@ namespace r2
 	private:
 		
 		Level* FindLoadedLevel(LevelName levelname, s32& index);
+		static u64 LevelEntitiesMemorySize(u32 maxNumLevels, u32 maxNumEntities);
+		struct LevelStreamRequest
+		{
+			Level level;
+			LevelName levelName;
+			const flat::LevelData* flatLevelData = nullptr;
+			r2::asset::AsyncAssetLoadHandle levelDataLoad;
+			r2::SArray<r2::asset::AsyncAssetLoadHandle>* assetLoads = nullptr;
+			u32 numAssetsLoaded = 0;
+			u32 nextItem = 0; //the next model/material to upload
+			u32 generation = 0;
+			LevelStreamStage stage = LEVEL_STREAM_STAGE_INVALID;
+			bool makeCurrent = true;
+		};
+
+		struct StreamingLevel
+		{
+			LevelName levelName;
+			glm::vec3 center = glm::vec3(0.0f);
+			f32 loadRadius = 0.0f;
+			f32 unloadRadius = 0.0f;
+		};
+
+		void MakeLevel(LevelName levelName, const flat::LevelData* flatLevelData, Level& newLevel);
+		Level* FinishLoadingLevel(Level& newLevel, const flat::LevelData* flatLevelData, bool makeCurrent);
+
 		void LoadLevelData(Level& level, const flat::LevelData* levelData);
+		void LoadLevelModels(Level& level, const flat::LevelData* levelData, u32 start, u32 end);
+		void LoadLevelSoundBanks(Level& level, const flat::LevelData* levelData);
+		void LoadLevelMaterials(Level& level, const flat::LevelData* levelData, u32 start, u32 end);
 		void UnLoadLevelData(const Level& level);
+		void FreeLevel(Level& level);
+
+		//Counts the levels that are loaded plus the ones still streaming in since both need a slot in mLoadedLevels and mLevelArena
+		bool HasRoomForLevel() const;
+
+		s32 FindLevelStream(LevelName levelName) const;
+		//Returns true if the stream moved to its next stage. If wait is true, pending async loads are waited on instead of checked next frame
+		bool AdvanceLevelStream(LevelStreamRequest& request, f64 deadline, bool wait);
+		void ReleaseLevelStream(LevelStreamRequest& request);
+		void UpdateStreamingLevels();
 
 		r2::mem::MemoryArea::Handle mMemoryAreaHandle;
 		r2::mem::MemoryArea::SubArea::Handle mSubAreaHandle; 
 		u32 mMaxNumLevels;
+		u32 mMaxNumEntities;
 		
 		r2::mem::StackArena* mArena;
 		r2::mem::FreeListArena* mLevelArena;
 
 		r2::SArray<Level>* mLoadedLevels;
 
+		LevelStreamRequest* mLevelStreams;
+		r2::SArray<StreamingLevel>* mStreamingLevels;
+		glm::vec3 mStreamingOrigin;
+		bool mHasStreamingOrigin;
+		f64 mLevelStreamFrameBudgetMs;
+
 		s32 mCurrentLevel;
 	};
 }
@@ -8,6 +8,7 @@
 #include "r2/Game/ECS/Components/TransformDirtyComponent.h"
 #include "r2/Game/ECS/Systems/SceneGraphSystem.h"
 #include "r2/Game/ECS/Systems/SceneGraphTransformUpdateSystem.h"
+#include "r2/Game/ECS/Systems/SpatialIndexSystem.h"
 #include "R2/Game/ECS/Components/LightUpdateComponent.h"
 
 namespace r2::ecs
@@ -16,6 +17,7 @@ namespace r2::ecs
 		:mnoptrECSCoordinator(nullptr)
 		,mnoptrSceneGraphSystem(nullptr) 
 		,mnoptrSceneGraphTransformUpdateSystem(nullptr)
+		,mnoptrSpatialIndexSystem(nullptr)
 	{
 	}
 
@@ -26,17 +28,20 @@ namespace r2::ecs
 		R2_CHECK(mnoptrSceneGraphTransformUpdateSystem == nullptr, "We haven't initialized the SceneGraph yet!");
 	}
 
-	bool SceneGraph::Init(ecs::SceneGraphSystem* sceneGraphSystem, ecs::SceneGraphTransformUpdateSystem* sceneGraphtransformUpdateSystem, ecs::ECSCoordinator* coordinator)
+	bool SceneGraph::Init(ecs::SceneGraphSystem* sceneGraphSystem, ecs::SceneGraphTransformUpdateSystem* sceneGraphtransformUpdateSystem, ecs::SpatialIndexSystem* spatialIndexSystem, ecs::ECSCoordinator* coordinator)
 	{
 		R2_CHECK(sceneGraphSystem != nullptr, "sceneGraphSystem is nullptr");
 		R2_CHECK(sceneGraphtransformUpdateSystem != nullptr, "sceneGraphtransformUpdateSystem is nullptr");
+		R2_CHECK(spatialIndexSystem != nullptr, "spatialIndexSystem is nullptr");
 		R2_CHECK(coordinator != nullptr, "coordinator is nullptr");
 
 		mnoptrSceneGraphSystem = sceneGraphSystem;
 		mnoptrSceneGraphTransformUpdateSystem = sceneGraphtransformUpdateSystem;
+		mnoptrSpatialIndexSystem = spatialIndexSystem;
 		mnoptrECSCoordinator = coordinator;
 
 		mnoptrSceneGraphSystem->SetSceneGraph(this);
+		mnoptrSceneGraphTransformUpdateSystem->SetSpatialIndexSystem(mnoptrSpatialIndexSystem);
 
 		return true;
 	}
@@ -44,13 +49,19 @@ namespace r2::ecs
 	void SceneGraph::Shutdown()
 	{
 		mnoptrSceneGraphSystem = nullptr;
+		mnoptrSceneGraphTransformUpdateSystem->SetSpatialIndexSystem(nullptr);
+
 		mnoptrSceneGraphTransformUpdateSystem = nullptr;
+		mnoptrSpatialIndexSystem = nullptr;
 		mnoptrECSCoordinator = nullptr;
 	}
 
 	void SceneGraph::Update()
 	{
 		mnoptrSceneGraphTransformUpdateSystem->Update();
+
+		//has to be after the transforms are updated since it uses the new model matrices
+		mnoptrSpatialIndexSystem->Update();
 	}
 
 	ecs::Entity SceneGraph::CreateEntity()
@@ -79,7 +90,7 @@ namespace r2::ecs
 		ecs::TransformDirtyComponent dirty;
 		dirty.dirtyFlags = ecs::eTransformDirtyFlags::GLOBAL_TRANSFORM_DIRTY | ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
 
-		mnoptrECSCoordinator->AddComponent<ecs::TransformDirtyComponent>(newEntity, dirty);
+		SetTransformDirty(newEntity, dirty);
 
 		return newEntity;
 	}
@@ -115,15 +126,15 @@ namespace r2::ecs
 		heirarchyComponent.parent = parent;
 		
 
+		//the depth of the entity (and its subtree) changed
+		mnoptrSceneGraphTransformUpdateSystem->HierarchyChanged();
+
 		//We need to update the transforms of the entity
-		if (!mnoptrECSCoordinator->HasComponent<ecs::TransformDirtyComponent>(entity))
-		{
-			ecs::TransformDirtyComponent transformDirty;
-			transformDirty.dirtyFlags = ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY | ecs::eTransformDirtyFlags::ATTACHED_TO_PARENT_DIRTY;
-			transformDirty.hierarchyAttachmentType = attachmentType;
+		ecs::TransformDirtyComponent transformDirty;
+		transformDirty.dirtyFlags = ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY | ecs::eTransformDirtyFlags::ATTACHED_TO_PARENT_DIRTY;
+		transformDirty.hierarchyAttachmentType = attachmentType;
 
-			mnoptrECSCoordinator->AddComponent<ecs::TransformDirtyComponent>(entity, transformDirty);
-		}
+		SetTransformDirty(entity, transformDirty);
 
 
 		//essentially what we need to do here is to sort the entities in the SceneGraphSystem such that
@@ -135,7 +146,7 @@ namespace r2::ecs
 
 		if (numEntities > 1)
 		{
-			r2::SArray<UpdatedEntity>* entitiesToUpdate = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, UpdatedEntity, ecs::MAX_NUM_ENTITIES);
+			r2::SArray<UpdatedEntity>* entitiesToUpdate = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, UpdatedEntity, numEntities);
 
 			for (s32 i = static_cast<s32>(numEntities) - 1; i >= 0; --i)
 			{
@@ -148,7 +159,7 @@ namespace r2::ecs
 					continue;
 				}
 
-				s64 parentIndex = r2::sarr::IndexOf(*mnoptrSceneGraphSystem->mEntities, heirarchy.parent);
+				s64 parentIndex = mnoptrSceneGraphSystem->IndexOfEntity(heirarchy.parent);
 
 				R2_CHECK(parentIndex != -1, "Not sure how this would happen?");
 
@@ -170,9 +181,7 @@ namespace r2::ecs
 			for (size_t i = 0; i < numEntitiesToUpdate; i++)
 			{
 				const UpdatedEntity& updateEntity = r2::sarr::At(*entitiesToUpdate, i);
-				ecs::Entity e = updateEntity.e;
-				s32 index = updateEntity.index;
-				SetDirtyFlagOnHeirarchy(e, index);
+				SetDirtyFlagOnHeirarchy(updateEntity.e);
 			}
 
 			FREE(entitiesToUpdate, *MEM_ENG_SCRATCH_PTR);
@@ -191,19 +200,14 @@ namespace r2::ecs
 
 		heirarchyComponent.parent = ecs::INVALID_ENTITY;
 
-		//We need to update the transforms of the entity
-		if (!mnoptrECSCoordinator->HasComponent<ecs::TransformDirtyComponent>(entity))
-		{
-			ecs::TransformDirtyComponent transformDirty;
-			transformDirty.dirtyFlags = ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
-			transformDirty.parent = oldParent;
-			transformDirty.hierarchyAttachmentType = attachmentType;
-			mnoptrECSCoordinator->AddComponent<ecs::TransformDirtyComponent>(entity, transformDirty);
-		}
-
-		s64 index = r2::sarr::IndexOf(*mnoptrSceneGraphSystem->mEntities, entity);
+		mnoptrSceneGraphTransformUpdateSystem->HierarchyChanged();
 
-		SetDirtyFlagOnHeirarchy(entity, index);
+		//We need to update the transforms of the entity
+		ecs::TransformDirtyComponent transformDirty;
+		transformDirty.dirtyFlags = ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
+		transformDirty.parent = oldParent;
+		transformDirty.hierarchyAttachmentType = attachmentType;
+		SetTransformDirty(entity, transformDirty);
 	}
 
 	void SceneGraph::DetachChildren(ecs::Entity parent, eHierarchyAttachmentType attachmentType)
@@ -212,7 +216,7 @@ namespace r2::ecs
 		R2_CHECK(mnoptrSceneGraphSystem != nullptr, "We haven't initialized the SceneGraph yet!");
 		R2_CHECK(mnoptrSceneGraphTransformUpdateSystem != nullptr, "We haven't initialized the SceneGraph yet!");
 
-		r2::SArray<ecs::Entity>* entitiesToUpdate = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, ecs::MAX_NUM_ENTITIES);
+		r2::SArray<ecs::Entity>* entitiesToUpdate = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, GetNumEntitiesInScene());
 
 		const auto numEntities = r2::sarr::Size(*mnoptrSceneGraphSystem->mEntities);
 
@@ -237,36 +241,52 @@ namespace r2::ecs
 		FREE(entitiesToUpdate, *MEM_ENG_SCRATCH_PTR);
 	}
 
-	void SceneGraph::SetDirtyFlagOnHeirarchy(ecs::Entity entity, u32 startingIndex)
+	void SceneGraph::SetDirtyFlagOnHeirarchy(ecs::Entity entity)
 	{
 		R2_CHECK(mnoptrECSCoordinator != nullptr, "We haven't initialized the SceneGraph yet!");
 		R2_CHECK(mnoptrSceneGraphSystem != nullptr, "We haven't initialized the SceneGraph yet!");
 		R2_CHECK(mnoptrSceneGraphTransformUpdateSystem != nullptr, "We haven't initialized the SceneGraph yet!");
 
-		if (!mnoptrECSCoordinator->HasComponent<ecs::TransformDirtyComponent>(entity))
-		{
-			ecs::TransformDirtyComponent c;
-			c.dirtyFlags = ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
-			mnoptrECSCoordinator->AddComponent<ecs::TransformDirtyComponent>(entity, c);
-		}
+		//the SceneGraphTransformUpdateSystem marks the children of dirty entities dirty as it goes down the hierarchy
+		ecs::TransformDirtyComponent c;
+		c.dirtyFlags = ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY;
+		SetTransformDirty(entity, c);
+	}
 
-		const auto numEntities = r2::sarr::Size(*mnoptrSceneGraphSystem->mEntities);
+	void SceneGraph::SetTransformDirty(ecs::Entity entity, const ecs::TransformDirtyComponent& dirty)
+	{
+		R2_CHECK(mnoptrSceneGraphTransformUpdateSystem != nullptr, "We haven't initialized the SceneGraph yet!");
+		mnoptrSceneGraphTransformUpdateSystem->SetDirty(entity, dirty);
+	}
 
-		for (size_t i = startingIndex+1; i < numEntities; i++)
-		{
-			ecs::Entity e = r2::sarr::At(*mnoptrSceneGraphSystem->mEntities, i);
+	bool SceneGraph::IsTransformDirty(ecs::Entity entity) const
+	{
+		R2_CHECK(mnoptrSceneGraphTransformUpdateSystem != nullptr, "We haven't initialized the SceneGraph yet!");
+		return mnoptrSceneGraphTransformUpdateSystem->IsDirty(entity);
+	}
 
-			const auto& heirarchy = mnoptrECSCoordinator->GetComponent<ecs::HierarchyComponent>(e);
+	bool SceneGraph::Raycast(const math::Ray& ray, float maxDistance, ecs::SpatialRaycastHit& hit) const
+	{
+		R2_CHECK(mnoptrSpatialIndexSystem != nullptr, "We haven't initialized the SceneGraph yet!");
+		return mnoptrSpatialIndexSystem->Raycast(ray, maxDistance, hit);
+	}
 
-			if (heirarchy.parent == ecs::INVALID_ENTITY)
-			{
-				continue;
-			}
-			else if (heirarchy.parent == entity)
-			{
-				SetDirtyFlagOnHeirarchy(e, i);
-			}
-		}
+	void SceneGraph::QueryAABB(const math::AABB& aabb, r2::SArray<ecs::SpatialQueryResult>& results) const
+	{
+		R2_CHECK(mnoptrSpatialIndexSystem != nullptr, "We haven't initialized the SceneGraph yet!");
+		mnoptrSpatialIndexSystem->QueryAABB(aabb, results);
+	}
+
+	void SceneGraph::QuerySphere(const glm::vec3& center, float radius, r2::SArray<ecs::SpatialQueryResult>& results) const
+	{
+		R2_CHECK(mnoptrSpatialIndexSystem != nullptr, "We haven't initialized the SceneGraph yet!");
+		mnoptrSpatialIndexSystem->QuerySphere(center, radius, results);
+	}
+
+	void SceneGraph::QueryFrustum(const math::Frustum& frustum, r2::SArray<ecs::SpatialQueryResult>& results) const
+	{
+		R2_CHECK(mnoptrSpatialIndexSystem != nullptr, "We haven't initialized the SceneGraph yet!");
+		mnoptrSpatialIndexSystem->QueryFrustum(frustum, results);
 	}
 
 	void SceneGraph::GetAllChildrenForEntity(ecs::Entity parent, r2::SArray<ecs::Entity>& children)
@@ -331,19 +351,7 @@ namespace r2::ecs
 
 	s32 SceneGraph::GetEntityIndex(ecs::Entity entity)
 	{
-		s32 numEntities = r2::sarr::Size(*mnoptrSceneGraphSystem->mEntities);
-
-		for (s32 i = 0; i < numEntities; ++i)
-		{
-			ecs::Entity e = r2::sarr::At(*mnoptrSceneGraphSystem->mEntities, i);
-
-			if (e == entity)
-			{
-				return i;
-			}
-		}
-
-		return -1;
+		return mnoptrSceneGraphSystem->IndexOfEntity(entity);
 	}
 
 	ecs::Entity SceneGraph::GetParent(ecs::Entity entity)
@@ -352,6 +360,11 @@ namespace r2::ecs
 		return heirarchyComponent.parent;
 	}
 
+	u32 SceneGraph::GetNumEntitiesInScene() const
+	{
+		return static_cast<u32>(r2::sarr::Size(*mnoptrSceneGraphSystem->mEntities));
+	}
+
 	r2::ecs::ECSCoordinator* SceneGraph::GetECSCoordinator() const
 	{
 		return mnoptrECSCoordinator;
@@ -359,10 +372,9 @@ namespace r2::ecs
 
 	void SceneGraph::UpdateTransformForEntity(ecs::Entity entity, ecs::eTransformDirtyFlags dirtyFlags)
 	{
-		if (!mnoptrECSCoordinator->HasComponent<ecs::TransformDirtyComponent>(entity))
-		{
-			mnoptrECSCoordinator->AddComponent<ecs::TransformDirtyComponent>(entity, { dirtyFlags });
-		}
+		ecs::TransformDirtyComponent transformDirty;
+		transformDirty.dirtyFlags = dirtyFlags;
+		SetTransformDirty(entity, transformDirty);
 
 
 		//@TODO(Serge): Hack for the editor! Clean up 
@@ -389,26 +401,6 @@ namespace r2::ecs
 			LightUpdateComponent& lightUpdateComponent = mnoptrECSCoordinator->GetComponent<ecs::LightUpdateComponent>(entity);
 			lightUpdateComponent.flags.Set(SPOT_LIGHT_UPDATE);
 		}
-
-
-		//@TODO(Serge): might be useful for the scene graph to have this memory pre-allocated at all times - dunno
-		r2::SArray<ecs::Entity>* children = MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, ecs::Entity, ecs::MAX_NUM_ENTITIES);
-
-		GetAllChildrenForEntity(entity, *children);
-
-		const auto numChildren = r2::sarr::Size(*children);
-
-		for (u32 i = 0; i < numChildren; ++i)
-		{
-			ecs::Entity child = r2::sarr::At(*children, i);
-
-			if (!mnoptrECSCoordinator->HasComponent<ecs::TransformDirtyComponent>(child))
-			{
-				mnoptrECSCoordinator->AddComponent<ecs::TransformDirtyComponent>(child, { ecs::eTransformDirtyFlags::LOCAL_TRANSFORM_DIRTY });
-			}
-		}
-
-		FREE( children, *MEM_ENG_SCRATCH_PTR);
 	}
 
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define __SCENE_GRAPH_H__
 
 #include "r2/Game/ECS/Entity.h"
+#include "r2/Game/ECS/Systems/SpatialIndexSystem.h"
 
 namespace flat
 {
@@ -17,8 +18,10 @@ namespace r2::ecs
 {
 	class SceneGraphSystem;
 	class SceneGraphTransformUpdateSystem;
+	class SpatialIndexSystem;
 	class ECSCoordinator;
 	class ECSWorld;
+	struct TransformDirtyComponent;
 
 	class SceneGraph
 	{
@@ -27,7 +30,7 @@ namespace r2::ecs
 		~SceneGraph();
 
 		
-		bool Init(ecs::SceneGraphSystem* sceneGraphSystem, ecs::SceneGraphTransformUpdateSystem* sceneGraphtransformUpdateSystem, ecs::ECSCoordinator* coordinator);
+		bool Init(ecs::SceneGraphSystem* sceneGraphSystem, ecs::SceneGraphTransformUpdateSystem* sceneGraphtransformUpdateSystem, ecs::SpatialIndexSystem* spatialIndexSystem, ecs::ECSCoordinator* coordinator);
 		void Shutdown();
 
 		void Update();
@@ -44,12 +47,23 @@ namespace r2::ecs
 		void GetAllEntitiesInSubTree(ecs::Entity parent, u32 parentIndex, r2::SArray<ecs::Entity>& entities);
 		void GetAllTopLevelEntities(r2::SArray<ecs::Entity>& entities, r2::SArray<u32>& indices);
 		void GetAllEntitiesInScene(r2::SArray<ecs::Entity>& entities);
+		u32 GetNumEntitiesInScene() const;
 		s32 GetEntityIndex(ecs::Entity entity);
 		ecs::Entity GetParent(ecs::Entity entity);
 
 		void UpdateTransformForEntity(ecs::Entity entity, ecs::eTransformDirtyFlags dirtyFlags);
+
+		//Marks the entity's transform to be recalculated in the next Update (along with all of its children). Does nothing if it's already dirty this frame.
+		void SetTransformDirty(ecs::Entity entity, const ecs::TransformDirtyComponent& dirty);
+		bool IsTransformDirty(ecs::Entity entity) const;
 		//void UpdateTransformInstanceForEntity(ecs::Entity entity, ecs::eTransformDirtyFlags dirtyFlags, s32 instance);
 
+		//Spatial queries over the bounds of every entity instance with a RenderComponent - up to date as of the last Update
+		bool Raycast(const math::Ray& ray, float maxDistance, ecs::SpatialRaycastHit& hit) const;
+		void QueryAABB(const math::AABB& aabb, r2::SArray<ecs::SpatialQueryResult>& results) const;
+		void QuerySphere(const glm::vec3& center, float radius, r2::SArray<ecs::SpatialQueryResult>& results) const;
+		void QueryFrustum(const math::Frustum& frustum, r2::SArray<ecs::SpatialQueryResult>& results) const;
+
 		ecs::ECSCoordinator* GetECSCoordinator() const;
 
 	private:
@@ -60,11 +74,12 @@ namespace r2::ecs
 			s32 index = -1;
 		};
 
-		void SetDirtyFlagOnHeirarchy(ecs::Entity entity, u32 startingIndex);
+		void SetDirtyFlagOnHeirarchy(ecs::Entity entity);
 
 		ecs::ECSCoordinator* mnoptrECSCoordinator;
 		ecs::SceneGraphSystem* mnoptrSceneGraphSystem;
 		ecs::SceneGraphTransformUpdateSystem* mnoptrSceneGraphTransformUpdateSystem;
+		ecs::SpatialIndexSystem* mnoptrSpatialIndexSystem;
 	};
 }
 
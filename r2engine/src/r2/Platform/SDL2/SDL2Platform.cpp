@@ -33,12 +33,20 @@
 #include "backends/imgui_impl_sdl2.h"
 #endif
 #include "r2/Utils/Timer.h"
+#include "r2/Core/Profiler/Profiler.h"
 
 namespace
 {
     const u32 MAX_NUM_FILES = 1024;
     const u32 MAX_NUM_STORAGE_AREAS = 8;
     const f64 k_millisecondsToSeconds = 1000.;
+
+    //the profiler's per thread ring buffers come out of internal engine memory too
+#ifdef R2_PROFILER
+    const u64 PROFILER_MEMORY = r2::prof::GetMemorySize(r2::prof::MAX_NUM_PROFILER_THREADS, r2::prof::MAX_NUM_ZONES_PER_THREAD);
+#else
+    const u64 PROFILER_MEMORY = 0;
+#endif
 }
 
 namespace r2
@@ -50,10 +58,11 @@ namespace r2
     const u64 SDL2Platform::MAX_NUM_MEMORY_AREAS = 16;
     
     //@NOTE: Increase as needed for dev
+    //@NOTE: includes 12 megs for the job system threads and the profiler's memory
 #ifdef R2_DEBUG
-    const u64 SDL2Platform::TOTAL_INTERNAL_ENGINE_MEMORY = Megabytes(360);
+    const u64 SDL2Platform::TOTAL_INTERNAL_ENGINE_MEMORY = Megabytes(372) + PROFILER_MEMORY;
 #elif R2_RELEASE || R2_PUBLISH
-    const u64 SDL2Platform::TOTAL_INTERNAL_ENGINE_MEMORY = Megabytes(216);
+    const u64 SDL2Platform::TOTAL_INTERNAL_ENGINE_MEMORY = Megabytes(228) + PROFILER_MEMORY;
 #endif
     //@NOTE: Should never exceed the above memory
     const u64 SDL2Platform::TOTAL_INTERNAL_PERMANENT_MEMORY = Megabytes(8);
@@ -342,6 +351,7 @@ namespace r2
 
         while (mRunning)
         {
+            R2_PROFILE_BEGIN_FRAME();
 
 			u64 newTime = SDL_GetPerformanceCounter();
 			f64 delta = (f64(newTime - currentTime) * k_millisecondsToSeconds) / (f64)k_frequency;
@@ -474,6 +484,8 @@ namespace r2
             
             r2::mem::GlobalMemory::EngineMemory().singleFrameArena->GetPolicyRef().Reset();
 
+            R2_PROFILE_END_FRAME();
+
 #if defined( R2_DEBUG ) || defined(R2_RELEASE) || defined(R2_PUBLISH)
             frames++;
             totalFrames++;
@@ -0,0 +1,519 @@
+#include "r2pch.h"
+
+#include "r2/Render/Animation/AnimationBatch.h"
+#include "r2/Render/Animation/AnimationClip.h"
+#include "r2/Render/Animation/TransformTrack.h"
+#include "r2/Render/Animation/Pose.h"
+#include "r2/Render/Animation/Skeleton.h"
+#include "r2/Core/Math/MathUtils.h"
+#include "r2/Core/Jobs/JobSystem.h"
+#include "r2/Core/Memory/InternalEngineMemory.h"
+#include "r2/Core/Profiler/Profiler.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define R2_ANIM_SSE
+#endif
+
+namespace
+{
+#ifdef R2_ANIM_SSE
+	using float4 = __m128;
+
+	inline float4 Load4(const float* p) { return _mm_load_ps(p); }
+	inline void Store4(float* p, float4 v) { _mm_store_ps(p, v); }
+	inline float4 Splat4(float f) { return _mm_set1_ps(f); }
+	inline float4 Add4(float4 a, float4 b) { return _mm_add_ps(a, b); }
+	inline float4 Sub4(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+	inline float4 Mul4(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+	inline float4 Div4(float4 a, float4 b) { return _mm_div_ps(a, b); }
+	inline float4 Sqrt4(float4 a) { return _mm_sqrt_ps(a); }
+	inline float4 Negate4(float4 a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+	inline float4 LessThan4(float4 a, float4 b) { return _mm_cmplt_ps(a, b); }
+	//mask ? b : a
+	inline float4 Select4(float4 a, float4 b, float4 mask) { return _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b)); }
+#else
+	struct float4
+	{
+		float v[4];
+	};
+
+	inline float4 Load4(const float* p) { return { p[0], p[1], p[2], p[3] }; }
+	inline void Store4(float* p, float4 a) { for (u32 i = 0; i < 4; ++i) p[i] = a.v[i]; }
+	inline float4 Splat4(float f) { return { f, f, f, f }; }
+	inline float4 Add4(float4 a, float4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+	inline float4 Sub4(float4 a, float4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+	inline float4 Mul4(float4 a, float4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+	inline float4 Div4(float4 a, float4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] /= b.v[i]; return a; }
+	inline float4 Sqrt4(float4 a) { for (u32 i = 0; i < 4; ++i) a.v[i] = sqrtf(a.v[i]); return a; }
+	inline float4 Negate4(float4 a) { for (u32 i = 0; i < 4; ++i) a.v[i] = -a.v[i]; return a; }
+	inline float4 LessThan4(float4 a, float4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] = a.v[i] < b.v[i] ? 1.0f : 0.0f; return a; }
+	inline float4 Select4(float4 a, float4 b, float4 mask) { for (u32 i = 0; i < 4; ++i) a.v[i] = mask.v[i] != 0.0f ? b.v[i] : a.v[i]; return a; }
+#endif
+
+	//mInterpolation is made of u8s - pad after every array so the ones after it stay aligned
+	constexpr u64 SOA_ARRAY_ALIGNMENT = alignof(r2::SArray<float>);
+
+	template<typename T>
+	r2::SArray<T>* EmplaceArray(void** memoryPointer, u32 capacity)
+	{
+		r2::SArray<T>* array = EMPLACE_SARRAY(*memoryPointer, T, capacity);
+		*memoryPointer = r2::mem::utils::AlignForward(r2::mem::utils::PointerAdd(*memoryPointer, r2::SArray<T>::MemorySize(capacity)), SOA_ARRAY_ALIGNMENT);
+		return array;
+	}
+
+	template<typename T>
+	u64 ArrayMemorySize(u32 capacity, const r2::mem::utils::MemoryProperties& memProperties)
+	{
+		return r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<T>::MemorySize(capacity) + SOA_ARRAY_ALIGNMENT, memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
+	}
+}
+
+namespace r2::anim
+{
+	u64 SoAChannel::MemorySize(u32 numTracks, u32 numKeys, u32 numSampledFrames, u32 numComponents, const r2::mem::utils::MemoryProperties& memProperties)
+	{
+		return
+			ArrayMemorySize<u32>(numTracks, memProperties) +
+			ArrayMemorySize<InterpolationType>(numTracks, memProperties) +
+			ArrayMemorySize<float>(numTracks, memProperties) * 2 +
+			ArrayMemorySize<u32>(numTracks, memProperties) +
+			ArrayMemorySize<u32>(numTracks + 1, memProperties) * 2 +
+			ArrayMemorySize<u32>(numSampledFrames, memProperties) +
+			ArrayMemorySize<float>(numKeys, memProperties) * (1 + numComponents * 3);
+	}
+
+	u64 SoAAnimationClip::MemorySize(
+		u32 numTracks,
+		u32 numPositionKeys, u32 numRotationKeys, u32 numScaleKeys,
+		u32 numSampledPositions, u32 numSampledRotations, u32 numSampledScales,
+		const r2::mem::utils::MemoryProperties& memProperties)
+	{
+		return
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(SoAAnimationClip) + SOA_ARRAY_ALIGNMENT, memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			SoAChannel::MemorySize(numTracks, numPositionKeys, numSampledPositions, 3, memProperties) +
+			SoAChannel::MemorySize(numTracks, numRotationKeys, numSampledRotations, 4, memProperties) +
+			SoAChannel::MemorySize(numTracks, numScaleKeys, numSampledScales, 3, memProperties);
+	}
+
+	template<typename T, unsigned int N>
+	static void LoadSoAChannel(void** memoryPointer, SoAChannel& channel, const AnimationClip& clip, Track<T, N>* TransformTrack::* member)
+	{
+		//Only tracks with more than 1 key change the pose, the same as TransformTrack::Sample
+		u32 numTracks = 0;
+		u32 numKeys = 0;
+		u32 numSampledFrames = 0;
+
+		for (u32 i = 0; i < clip.Size(); ++i)
+		{
+			const Track<T, N>* track = clip.mTracks->mData[i]->*member;
+			if (track && track->Size() > 1)
+			{
+				++numTracks;
+				numKeys += track->Size();
+				numSampledFrames += r2::sarr::Size(*track->mSampledFrames);
+			}
+		}
+
+		channel.mJointIDs = EmplaceArray<u32>(memoryPointer, numTracks);
+		channel.mInterpolation = EmplaceArray<InterpolationType>(memoryPointer, numTracks);
+		channel.mStartTimes = EmplaceArray<float>(memoryPointer, numTracks);
+		channel.mEndTimes = EmplaceArray<float>(memoryPointer, numTracks);
+		channel.mNumSamples = EmplaceArray<u32>(memoryPointer, numTracks);
+		channel.mKeyOffsets = EmplaceArray<u32>(memoryPointer, numTracks + 1);
+		channel.mSampledFrameOffsets = EmplaceArray<u32>(memoryPointer, numTracks + 1);
+		channel.mSampledFrames = EmplaceArray<u32>(memoryPointer, numSampledFrames);
+		channel.mTimes = EmplaceArray<float>(memoryPointer, numKeys);
+
+		for (u32 c = 0; c < N; ++c)
+		{
+			channel.mValues[c] = EmplaceArray<float>(memoryPointer, numKeys);
+			channel.mIn[c] = EmplaceArray<float>(memoryPointer, numKeys);
+			channel.mOut[c] = EmplaceArray<float>(memoryPointer, numKeys);
+		}
+
+		r2::sarr::Push(*channel.mKeyOffsets, 0u);
+		r2::sarr::Push(*channel.mSampledFrameOffsets, 0u);
+
+		for (u32 i = 0; i < clip.Size(); ++i)
+		{
+			const TransformTrack* transformTrack = clip.mTracks->mData[i];
+			const Track<T, N>* track = transformTrack->*member;
+
+			if (!track || track->Size() <= 1)
+			{
+				continue;
+			}
+
+			r2::sarr::Push(*channel.mJointIDs, transformTrack->mJointID);
+			r2::sarr::Push(*channel.mInterpolation, track->mInterpolationType);
+			r2::sarr::Push(*channel.mStartTimes, track->GetStartTime());
+			r2::sarr::Push(*channel.mEndTimes, track->GetEndTime());
+			r2::sarr::Push(*channel.mNumSamples, track->mNumSamples);
+
+			const u32 trackSize = track->Size();
+			for (u32 k = 0; k < trackSize; ++k)
+			{
+				const Frame<N>& frame = track->mFrames->mData[k];
+
+				r2::sarr::Push(*channel.mTimes, static_cast<float>(frame.mTime));
+
+				for (u32 c = 0; c < N; ++c)
+				{
+					r2::sarr::Push(*channel.mValues[c], frame.mValue[c]);
+					r2::sarr::Push(*channel.mIn[c], frame.mIn[c]);
+					r2::sarr::Push(*channel.mOut[c], frame.mOut[c]);
+				}
+			}
+
+			const u32 numTrackSampledFrames = r2::sarr::Size(*track->mSampledFrames);
+			for (u32 s = 0; s < numTrackSampledFrames; ++s)
+			{
+				r2::sarr::Push(*channel.mSampledFrames, track->mSampledFrames->mData[s]);
+			}
+
+			r2::sarr::Push(*channel.mKeyOffsets, static_cast<u32>(r2::sarr::Size(*channel.mTimes)));
+			r2::sarr::Push(*channel.mSampledFrameOffsets, static_cast<u32>(r2::sarr::Size(*channel.mSampledFrames)));
+		}
+	}
+
+	SoAAnimationClip* LoadSoAAnimationClip(void** memoryPointer, const AnimationClip& clip)
+	{
+		//Compressed clips are sampled straight from their quantized keys - unpacking them here would undo the compression
+		for (u32 i = 0; i < clip.Size(); ++i)
+		{
+			const TransformTrack* track = clip.mTracks->mData[i];
+			if (track->mPosition->IsCompressed() || track->mRotation->IsCompressed() || track->mScale->IsCompressed())
+			{
+				return nullptr;
+			}
+		}
+
+		*memoryPointer = r2::mem::utils::AlignForward(*memoryPointer, SOA_ARRAY_ALIGNMENT);
+
+		SoAAnimationClip* newSoAClip = new (*memoryPointer) SoAAnimationClip();
+		*memoryPointer = r2::mem::utils::PointerAdd(*memoryPointer, sizeof(SoAAnimationClip));
+
+		LoadSoAChannel(memoryPointer, newSoAClip->mPositions, clip, &TransformTrack::mPosition);
+		LoadSoAChannel(memoryPointer, newSoAClip->mRotations, clip, &TransformTrack::mRotation);
+		LoadSoAChannel(memoryPointer, newSoAClip->mScales, clip, &TransformTrack::mScale);
+
+		return newSoAClip;
+	}
+
+	//Track::FrameIndex on the packed keys
+	static s32 FrameIndex(const SoAChannel& channel, u32 track, u32 keyOffset, u32 numKeys, float time, bool loop)
+	{
+		const float* times = channel.mTimes->mData + keyOffset;
+		const float startTime = channel.mStartTimes->mData[track];
+		const float duration = channel.mEndTimes->mData[track] - startTime;
+
+		if (duration <= 0.0f)
+		{
+			return -1;
+		}
+
+		if (loop)
+		{
+			time = fmodf(time - startTime, duration);
+			if (time < 0.0f)
+			{
+				time += duration;
+			}
+			time += startTime;
+		}
+		else
+		{
+			if (time <= startTime)
+			{
+				return 0;
+			}
+			if (time >= times[numKeys - 2])
+			{
+				return (s32)numKeys - 2;
+			}
+		}
+
+		const u32 sampledOffset = channel.mSampledFrameOffsets->mData[track];
+		const u32 numSampledFrames = channel.mSampledFrameOffsets->mData[track + 1] - sampledOffset;
+
+		float t = time / duration;
+		u32 index = (u32)(t * (float)(duration * channel.mNumSamples->mData[track]));
+		if (index >= numSampledFrames)
+		{
+			return -1;
+		}
+
+		return (s32)channel.mSampledFrames->mData[sampledOffset + index];
+	}
+
+	static float AdjustTimeToFitTrack(const SoAChannel& channel, u32 track, float time, bool loop)
+	{
+		const float startTime = channel.mStartTimes->mData[track];
+		const float endTime = channel.mEndTimes->mData[track];
+		const float duration = endTime - startTime;
+
+		if (loop)
+		{
+			time = fmodf(time - startTime, duration);
+			if (time < 0.0f)
+			{
+				time += duration;
+			}
+
+			return time + startTime;
+		}
+
+		return glm::clamp(time, startTime, endTime);
+	}
+
+	//Samples 4 tracks of the channel at a time. The frame lookups are scalar, the interpolation is done for all 4 lanes at once.
+	//writeFunc(jointID, const float* values, u32 stride) gets called for each of the tracks that sampled successfully.
+	template<u32 N, typename WriteFunc>
+	static void SampleChannel(const SoAChannel& channel, float time, bool loop, const WriteFunc& writeFunc)
+	{
+		const u32 numTracks = static_cast<u32>(r2::sarr::Size(*channel.mJointIDs));
+
+		for (u32 base = 0; base < numTracks; base += 4)
+		{
+			const u32 numLanes = std::min(4u, numTracks - base);
+
+			alignas(16) float p1[N][4] = {};
+			alignas(16) float p2[N][4] = {};
+			alignas(16) float s1[N][4] = {};
+			alignas(16) float s2[N][4] = {};
+			alignas(16) float t[4] = {};
+			alignas(16) float cubic[4] = {};
+			bool valid[4] = { false, false, false, false };
+
+			for (u32 lane = 0; lane < numLanes; ++lane)
+			{
+				const u32 track = base + lane;
+				const u32 keyOffset = channel.mKeyOffsets->mData[track];
+				const u32 numKeys = channel.mKeyOffsets->mData[track + 1] - keyOffset;
+				const InterpolationType interpolation = channel.mInterpolation->mData[track];
+
+				const s32 frame = FrameIndex(channel, track, keyOffset, numKeys, time, loop);
+
+				if (interpolation == CONSTANT)
+				{
+					if (frame < 0 || frame >= (s32)numKeys)
+					{
+						continue;
+					}
+
+					for (u32 c = 0; c < N; ++c)
+					{
+						p1[c][lane] = p2[c][lane] = channel.mValues[c]->mData[keyOffset + frame];
+					}
+
+					valid[lane] = true;
+					continue;
+				}
+
+				if (frame < 0 || frame >= (s32)numKeys - 1)
+				{
+					continue;
+				}
+
+				const u32 thisKey = keyOffset + frame;
+				const u32 nextKey = thisKey + 1;
+				const float thisTime = channel.mTimes->mData[thisKey];
+				const float frameDelta = channel.mTimes->mData[nextKey] - thisTime;
+
+				if (frameDelta <= 0.0f)
+				{
+					continue;
+				}
+
+				const float trackTime = AdjustTimeToFitTrack(channel, track, time, loop);
+				t[lane] = glm::clamp((trackTime - thisTime) / frameDelta, 0.0f, 1.0f);
+
+				for (u32 c = 0; c < N; ++c)
+				{
+					p1[c][lane] = channel.mValues[c]->mData[thisKey];
+					p2[c][lane] = channel.mValues[c]->mData[nextKey];
+				}
+
+				if (interpolation == CUBIC)
+				{
+					cubic[lane] = 1.0f;
+
+					for (u32 c = 0; c < N; ++c)
+					{
+						s1[c][lane] = channel.mOut[c]->mData[thisKey] * frameDelta;
+						s2[c][lane] = channel.mIn[c]->mData[nextKey] * frameDelta;
+					}
+				}
+
+				valid[lane] = true;
+			}
+
+			float4 a[N], b[N];
+			for (u32 c = 0; c < N; ++c)
+			{
+				a[c] = Load4(p1[c]);
+				b[c] = Load4(p2[c]);
+			}
+
+			if constexpr (N == 4)
+			{
+				//Take the short way around - same as math::Neighborhood
+				float4 dot = Mul4(a[0], b[0]);
+				for (u32 c = 1; c < N; ++c)
+				{
+					dot = Add4(dot, Mul4(a[c], b[c]));
+				}
+
+				const float4 flip = LessThan4(dot, Splat4(0.0f));
+				for (u32 c = 0; c < N; ++c)
+				{
+					b[c] = Select4(b[c], Negate4(b[c]), flip);
+				}
+			}
+
+			const float4 tv = Load4(t);
+			const float4 cubicMask = LessThan4(Splat4(0.0f), Load4(cubic));
+			const float4 tt = Mul4(tv, tv);
+			const float4 ttt = Mul4(tt, tv);
+			const float4 two = Splat4(2.0f);
+			const float4 three = Splat4(3.0f);
+			const float4 h1 = Add4(Sub4(Mul4(two, ttt), Mul4(three, tt)), Splat4(1.0f));
+			const float4 h2 = Add4(Negate4(Mul4(two, ttt)), Mul4(three, tt));
+			const float4 h3 = Add4(Sub4(ttt, Mul4(two, tt)), tv);
+			const float4 h4 = Sub4(ttt, tt);
+
+			float4 result[N];
+			for (u32 c = 0; c < N; ++c)
+			{
+				const float4 linear = Add4(a[c], Mul4(Sub4(b[c], a[c]), tv));
+				const float4 hermite = Add4(Add4(Mul4(a[c], h1), Mul4(b[c], h2)), Add4(Mul4(Load4(s1[c]), h3), Mul4(Load4(s2[c]), h4)));
+				result[c] = Select4(linear, hermite, cubicMask);
+			}
+
+			if constexpr (N == 4)
+			{
+				//nlerp instead of slerp, the keys are close enough together that it's not noticeable
+				float4 lengthSq = Mul4(result[0], result[0]);
+				for (u32 c = 1; c < N; ++c)
+				{
+					lengthSq = Add4(lengthSq, Mul4(result[c], result[c]));
+				}
+
+				//the invalid lanes are all 0 - keep them from turning into NaNs
+				const float4 length = Select4(Splat4(1.0f), Sqrt4(lengthSq), LessThan4(Splat4(0.0f), lengthSq));
+				for (u32 c = 0; c < N; ++c)
+				{
+					result[c] = Div4(result[c], length);
+				}
+			}
+
+			alignas(16) float out[N][4];
+			for (u32 c = 0; c < N; ++c)
+			{
+				Store4(out[c], result[c]);
+			}
+
+			for (u32 lane = 0; lane < numLanes; ++lane)
+			{
+				if (valid[lane])
+				{
+					writeFunc(channel.mJointIDs->mData[base + lane], &out[0][lane], 4);
+				}
+			}
+		}
+	}
+
+	float SampleSoA(const AnimationClip& clip, Pose& outPose, float inTime, bool loop)
+	{
+		if (!clip.mSoAClip)
+		{
+			return clip.Sample(outPose, inTime, loop);
+		}
+
+		if (math::NearZero(clip.GetDuration()))
+		{
+			return 0.0f;
+		}
+
+		inTime = clip.AdjustTimeToFitRange(inTime, loop);
+
+		math::Transform* joints = outPose.mJointTransforms->mData;
+
+		SampleChannel<3>(clip.mSoAClip->mPositions, inTime, loop, [joints](u32 jointID, const float* v, u32 stride)
+		{
+			joints[jointID].position = glm::vec3(v[0], v[stride], v[2 * stride]);
+		});
+
+		SampleChannel<4>(clip.mSoAClip->mRotations, inTime, loop, [joints](u32 jointID, const float* v, u32 stride)
+		{
+			joints[jointID].rotation = glm::quat(v[3 * stride], v[0], v[stride], v[2 * stride]);
+		});
+
+		SampleChannel<3>(clip.mSoAClip->mScales, inTime, loop, [joints](u32 jointID, const float* v, u32 stride)
+		{
+			joints[jointID].scale = glm::vec3(v[0], v[stride], v[2 * stride]);
+		});
+
+		return inTime;
+	}
+
+	void EvaluateBatch(AnimationBatchInstance* instances, u32 numInstances)
+	{
+		if (numInstances == 0)
+		{
+			return;
+		}
+
+		R2_PROFILE_FUNCTION();
+
+		//Instances that write into the same palette bump its size so they have to stay on the same thread - split the batch up
+		//into runs of instances that share a palette and spread the runs out instead.
+		u32* runStarts = (u32*)ALLOC_BYTESN(*MEM_ENG_SCRATCH_PTR, sizeof(u32) * (numInstances + 1), alignof(u32));
+		u32 numRuns = 0;
+
+		for (u32 i = 0; i < numInstances; ++i)
+		{
+			if (i == 0 || instances[i].outPalette != instances[i - 1].outPalette)
+			{
+				runStarts[numRuns++] = i;
+			}
+		}
+
+		runStarts[numRuns] = numInstances;
+
+		r2::jobs::ParallelFor(numRuns, 4, [instances, runStarts](u32 startRun, u32 endRun)
+		{
+			R2_PROFILE_ZONE("EvaluateBatch Range");
+
+			const u32 start = runStarts[startRun];
+			const u32 end = runStarts[endRun];
+
+			u32 maxNumJoints = 1;
+			for (u32 i = start; i < end; ++i)
+			{
+				maxNumJoints = std::max(maxNumJoints, pose::Size(*instances[i].pose));
+			}
+
+			//One set of scratch globals for the whole range instead of one per palette
+			math::Transform* globalTransforms = (math::Transform*)ALLOC_BYTESN(*MEM_ENG_SCRATCH_PTR, sizeof(math::Transform) * maxNumJoints, alignof(math::Transform));
+
+			for (u32 i = start; i < end; ++i)
+			{
+				AnimationBatchInstance& instance = instances[i];
+				instance.outTime = instance.time;
+
+				if (instance.clip)
+				{
+					instance.outTime = SampleSoA(*instance.clip, *instance.pose, instance.time, instance.loop);
+				}
+
+				pose::GetMatrixPalette(*instance.pose, *instance.skeleton, instance.outPalette, instance.paletteOffset, globalTransforms);
+			}
+
+			FREE(globalTransforms, *MEM_ENG_SCRATCH_PTR);
+		});
+
+		FREE(runStarts, *MEM_ENG_SCRATCH_PTR);
+	}
+}
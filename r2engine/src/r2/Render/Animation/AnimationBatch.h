@@ -0,0 +1,87 @@
+#ifndef __ANIMATION_BATCH_H__
+#define __ANIMATION_BATCH_H__
+
+#include "r2/Render/Animation/Track.h"
+
+namespace r2::mem::utils
+{
+	struct MemoryProperties;
+}
+
+namespace r2::draw
+{
+	struct ShaderBoneTransform;
+}
+
+namespace r2::math
+{
+	struct Transform;
+}
+
+namespace r2::anim
+{
+	struct AnimationClip;
+	struct Pose;
+	struct Skeleton;
+
+	//One channel (position, rotation or scale) of every track in a clip that actually animates it. The keys of all of the tracks
+	//are packed back to back with each component in its own array so that 4 joints can be sampled at once.
+	struct SoAChannel
+	{
+		r2::SArray<u32>* mJointIDs = nullptr;
+		r2::SArray<InterpolationType>* mInterpolation = nullptr;
+		r2::SArray<float>* mStartTimes = nullptr;
+		r2::SArray<float>* mEndTimes = nullptr;
+		r2::SArray<u32>* mNumSamples = nullptr;
+
+		//numTracks + 1 entries, track i's keys are [mKeyOffsets[i], mKeyOffsets[i+1])
+		r2::SArray<u32>* mKeyOffsets = nullptr;
+		r2::SArray<u32>* mSampledFrameOffsets = nullptr;
+		r2::SArray<u32>* mSampledFrames = nullptr;
+
+		r2::SArray<float>* mTimes = nullptr;
+		r2::SArray<float>* mValues[4] = {};
+		r2::SArray<float>* mIn[4] = {};
+		r2::SArray<float>* mOut[4] = {};
+
+		static u64 MemorySize(u32 numTracks, u32 numKeys, u32 numSampledFrames, u32 numComponents, const r2::mem::utils::MemoryProperties& memProperties);
+	};
+
+	struct SoAAnimationClip
+	{
+		SoAChannel mPositions;
+		SoAChannel mRotations;
+		SoAChannel mScales;
+
+		static u64 MemorySize(
+			u32 numTracks,
+			u32 numPositionKeys, u32 numRotationKeys, u32 numScaleKeys,
+			u32 numSampledPositions, u32 numSampledRotations, u32 numSampledScales,
+			const r2::mem::utils::MemoryProperties& memProperties);
+	};
+
+	//Returns nullptr for compressed clips, SampleSoA falls back to AnimationClip::Sample for those
+	SoAAnimationClip* LoadSoAAnimationClip(void** memoryPointer, const AnimationClip& clip);
+
+	//Same result as AnimationClip::Sample except that rotations are nlerped instead of slerped
+	float SampleSoA(const AnimationClip& clip, Pose& outPose, float inTime, bool loop);
+
+	struct AnimationBatchInstance
+	{
+		const AnimationClip* clip = nullptr; //nullptr just builds the palette from the pose as is
+		Pose* pose = nullptr;
+		const Skeleton* skeleton = nullptr;
+		r2::SArray<r2::draw::ShaderBoneTransform>* outPalette = nullptr;
+		u32 paletteOffset = 0;
+		float time = 0.0f;
+		bool loop = false;
+
+		float outTime = 0.0f;
+	};
+
+	//Samples every instance's clip into its pose and builds its matrix palette. Instances are spread over the job system's threads
+	//so each instance needs its own pose. Instances that share a palette need to be next to each other in the batch.
+	void EvaluateBatch(AnimationBatchInstance* instances, u32 numInstances);
+}
+
+#endif
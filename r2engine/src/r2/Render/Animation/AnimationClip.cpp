@@ -4,6 +4,7 @@
 #include "r2/Render/Animation/TransformTrack.h"
 #include "r2/Core/Math/MathUtils.h"
 #include "r2/Render/Animation/Pose.h"
+#include "r2/Render/Animation/AnimationBatch.h"
 #include "assetlib/RAnimation_generated.h"
 
 namespace r2::anim
@@ -101,6 +102,8 @@ namespace r2::anim
 			r2::sarr::Push(*newAnimationClip->mTracks, nextTransformTrack);
 		}
 
+		newAnimationClip->mSoAClip = LoadSoAAnimationClip(memoryPointer, *newAnimationClip);
+
 		r2::asset::MakeAssetNameFromFlatAssetName(rAnimation->assetName(), newAnimationClip->mAssetName);
 		newAnimationClip->mStartTime = rAnimation->startTime();
 		newAnimationClip->mEndTime = rAnimation->endTime();
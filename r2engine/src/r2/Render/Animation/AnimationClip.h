@@ -17,6 +17,7 @@ namespace r2::anim
 {
 	struct TransformTrack;
 	struct Pose;
+	struct SoAAnimationClip;
 
 	struct AnimationClip
 	{
@@ -24,6 +25,7 @@ namespace r2::anim
 		float mStartTime;
 		float mEndTime;
 		r2::SArray<TransformTrack*>* mTracks;
+		SoAAnimationClip* mSoAClip = nullptr;
 
 		float AdjustTimeToFitRange(float inTime, bool loop) const;
 		float GetDuration() const;
@@ -37,13 +37,25 @@ namespace r2::anim
 		}
 
 		void GetMatrixPalette(const Pose& pose, const Skeleton& skeleton, r2::SArray<r2::draw::ShaderBoneTransform>* out, u32 offset)
+		{
+			r2::SArray<math::Transform>* tempTransforms =MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, math::Transform, pose.mJointTransforms->mSize);
+
+			GetMatrixPalette(pose, skeleton, out, offset, tempTransforms->mData);
+
+			FREE(tempTransforms, *MEM_ENG_SCRATCH_PTR);
+		}
+
+		void GetMatrixPalette(const Pose& pose, const Skeleton& skeleton, r2::SArray<r2::draw::ShaderBoneTransform>* out, u32 offset, math::Transform* globalTransforms)
 		{
 			s32 size = (s32)Size(pose);
 			R2_CHECK((s32)r2::sarr::Capacity(*out) >= size, "The matrix palette is too small. We need: %i and have: %i", size, r2::sarr::Capacity(*out));
 			R2_CHECK(static_cast<s32>(r2::sarr::Capacity(*out)) - offset >= size, "The matrix palette is too small. We have %i slots left and we need %i!", static_cast<s32>(r2::sarr::Capacity(*out)) - offset, size);
+			R2_CHECK(globalTransforms != nullptr, "We need somewhere to put the global transforms");
 
-			r2::SArray<math::Transform>* tempTransforms =MAKE_SARRAY(*MEM_ENG_SCRATCH_PTR, math::Transform, pose.mJointTransforms->mSize);
-			r2::sarr::Fill(*tempTransforms, math::Transform{});
+			for (s32 i = 0; i < size; ++i)
+			{
+				globalTransforms[i] = math::Transform{};
+			}
 
 			for (s32 i = 0; i < size; ++i)
 			{
@@ -54,22 +66,20 @@ namespace r2::anim
 
 				if (parent >= 0)
 				{
-					nextTransform = math::Combine(tempTransforms->mData[parent], nextTransform);
+					nextTransform = math::Combine(globalTransforms[parent], nextTransform);
 				}
 
-				tempTransforms->mData[i] = nextTransform;
+				globalTransforms[i] = nextTransform;
 				out->mData[i + offset].invBindPose = r2::sarr::At(*skeleton.mInvBindPose, i);
 
 			}
 
 			for (s32 j = 0; j < size; ++j)
 			{
-				out->mData[j + offset].transform = math::ToMatrix(tempTransforms->mData[j]);
+				out->mData[j + offset].transform = math::ToMatrix(globalTransforms[j]);
 			}
 
 			out->mSize += size;
-			
-			FREE(tempTransforms, *MEM_ENG_SCRATCH_PTR);
 		}
 
 #if defined( R2_DEBUG ) || defined(R2_EDITOR)
@@ -45,6 +45,9 @@ namespace r2::anim
 
 		void GetMatrixPalette(const Pose& pose, const Skeleton& skeleton, r2::SArray<r2::draw::ShaderBoneTransform>* out, u32 offset);
 
+		//Same as above but uses globalTransforms (at least Size(pose) long) as its scratch space instead of allocating any
+		void GetMatrixPalette(const Pose& pose, const Skeleton& skeleton, r2::SArray<r2::draw::ShaderBoneTransform>* out, u32 offset, math::Transform* globalTransforms);
+
 #if defined( R2_DEBUG ) || defined(R2_EDITOR)
 		void GetDebugBones(const Pose& pose, r2::SArray<r2::draw::DebugBone>* outDebugBones);
 #endif
@@ -19,6 +19,16 @@ namespace r2::anim
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u32>::MemorySize(numSampledFrames), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
 	}
 
+	template<typename T, unsigned int N>
+	u64 r2::anim::Track<T, N>::CompressedMemorySize(u32 numFrames, u32 numSampledFrames, const r2::mem::utils::MemoryProperties& memProperties)
+	{
+		return
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(Track<T, N>), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<float>::MemorySize(numFrames), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u16>::MemorySize(numFrames * 3), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u32>::MemorySize(numSampledFrames), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking);
+	}
+
 	template<typename T, unsigned int N>
 	r2::anim::Frame<N>& r2::anim::Track<T, N>::operator[](unsigned int index)
 	{
@@ -28,7 +38,7 @@ namespace r2::anim
 	template<typename T, unsigned int N>
 	T r2::anim::Track<T, N>::Sample(float time, bool looping) const
 	{
-		if (mInterpolationType == LINEAR)
+		if (mInterpolationType == LINEAR || (mInterpolationType == CUBIC && IsCompressed()))
 		{
 			return SampleLinear(time, looping);
 		}
@@ -40,28 +50,61 @@ namespace r2::anim
 		return SampleCubic(time, looping);
 	}
 
+	template<typename T, unsigned int N>
+	bool r2::anim::Track<T, N>::IsCompressed() const
+	{
+		return mCompressedTimes != nullptr;
+	}
+
 	template<typename T, unsigned int N>
 	u32 r2::anim::Track<T, N>::Size() const
 	{
+		if (IsCompressed())
+		{
+			return r2::sarr::Size(*mCompressedTimes);
+		}
+
 		return r2::sarr::Size(*mFrames);
 	}
 
+	template<typename T, unsigned int N>
+	float r2::anim::Track<T, N>::GetFrameTime(u32 index) const
+	{
+		if (IsCompressed())
+		{
+			return mCompressedTimes->mData[index];
+		}
+
+		return mFrames->mData[index].mTime;
+	}
+
+	template<typename T, unsigned int N>
+	T r2::anim::Track<T, N>::GetFrameValue(u32 index) const
+	{
+		if (IsCompressed())
+		{
+			return Decompress(index);
+		}
+
+		return Cast(&mFrames->mData[index].mValue[0]);
+	}
+
 	template<typename T, unsigned int N>
 	float r2::anim::Track<T, N>::GetEndTime() const
 	{
-		return mFrames->mData[mFrames->mSize - 1].mTime;
+		return GetFrameTime(Size() - 1);
 	}
 
 	template<typename T, unsigned int N>
 	float r2::anim::Track<T, N>::GetStartTime() const
 	{
-		return mFrames->mData[0].mTime;
+		return GetFrameTime(0);
 	}
 
 	template<typename T, unsigned int N>
 	float r2::anim::Track<T, N>::AdjustTimeToFitTrack(float time, bool looping) const
 	{
-		u32 size = (u32)r2::sarr::Size(*mFrames);
+		u32 size = Size();
 		if (size <= 1)
 		{
 			return 0.0f;
@@ -105,7 +148,7 @@ namespace r2::anim
 	template<typename T, unsigned int N>
 	s32 r2::anim::Track<T, N>::FrameIndex(float time, bool looping) const
 	{
-		u32 size = r2::sarr::Size(*mFrames);
+		u32 size = Size();
 		if (size <= 1)
 		{
 			return -1;
@@ -130,7 +173,7 @@ namespace r2::anim
 			{
 				return 0;
 			}
-			if (time >= mFrames->mData[size - 2].mTime)
+			if (time >= GetFrameTime(size - 2))
 			{
 				return (int)size - 2;
 			}
@@ -204,7 +247,7 @@ namespace r2::anim
 	T r2::anim::Track<T, N>::SampleLinear(float time, bool looping) const
 	{
 		int thisFrame = FrameIndex(time, looping);
-		if (thisFrame < 0 || thisFrame >= (int)r2::sarr::Size(*mFrames) - 1)
+		if (thisFrame < 0 || thisFrame >= (int)Size() - 1)
 		{
 
 			return T();
@@ -213,8 +256,8 @@ namespace r2::anim
 		int nextFrame = thisFrame + 1;
 
 		float trackTime = AdjustTimeToFitTrack(time, looping);
-		float thisTime = mFrames->mData[thisFrame].mTime;
-		float frameDelta = mFrames->mData[nextFrame].mTime - thisTime;
+		float thisTime = GetFrameTime(thisFrame);
+		float frameDelta = GetFrameTime(nextFrame) - thisTime;
 		if (frameDelta <= 0.0f)
 		{
 			return T();
@@ -222,8 +265,8 @@ namespace r2::anim
 
 		float t = (trackTime - thisTime) / frameDelta;
 		t = glm::clamp(t, 0.0f, 1.0f);
-		T start = Cast(&mFrames->mData[thisFrame].mValue[0]);
-		T end = Cast(&mFrames->mData[nextFrame].mValue[0]);
+		T start = GetFrameValue(thisFrame);
+		T end = GetFrameValue(nextFrame);
 
 		return math::Interpolate(start, end, t);
 	}
@@ -232,12 +275,12 @@ namespace r2::anim
 	T r2::anim::Track<T, N>::SampleConstant(float time, bool looping) const
 	{
 		int frame = FrameIndex(time, looping);
-		if (frame < 0 || frame >= (int)r2::sarr::Size(*mFrames))
+		if (frame < 0 || frame >= (int)Size())
 		{
 			return T();
 		}
 
-		return Cast(&mFrames->mData[frame].mValue[0]);
+		return GetFrameValue(frame);
 	}
 
 	template<> float Track<float, 1>::Cast(float* value) const
@@ -256,6 +299,48 @@ namespace r2::anim
 		return glm::normalize(r);
 	}
 
+	template<> float Track<float, 1>::Decompress(u32 index) const
+	{
+		R2_CHECK(false, "We don't compress scalar tracks");
+		return 0.0f;
+	}
+
+	template<> glm::vec3 Track<glm::vec3, 3>::Decompress(u32 index) const
+	{
+		const u16* values = &mCompressedValues->mData[index * 3];
+
+		return glm::vec3(
+			mRangeMin[0] + (static_cast<float>(values[0]) / 65535.0f) * mRangeExtent[0],
+			mRangeMin[1] + (static_cast<float>(values[1]) / 65535.0f) * mRangeExtent[1],
+			mRangeMin[2] + (static_cast<float>(values[2]) / 65535.0f) * mRangeExtent[2]);
+	}
+
+	template<> glm::quat Track<glm::quat, 4>::Decompress(u32 index) const
+	{
+		//smallest three - the index of the largest component is in the top bit of the first 2 values
+		constexpr float COMPONENT_RANGE = 0.70710678118f;
+		const u16* values = &mCompressedValues->mData[index * 3];
+
+		const u32 largestIndex = ((values[0] >> 15) << 1) | (values[1] >> 15);
+
+		float smallest[3];
+		float sumOfSquares = 0.0f;
+		for (u32 i = 0; i < 3; ++i)
+		{
+			smallest[i] = (static_cast<float>(values[i] & 0x7FFF) / 32767.0f) * (2.0f * COMPONENT_RANGE) - COMPONENT_RANGE;
+			sumOfSquares += smallest[i] * smallest[i];
+		}
+
+		float components[4];
+		u32 next = 0;
+		for (u32 i = 0; i < 4; ++i)
+		{
+			components[i] = (i == largestIndex) ? sqrtf(std::max(0.0f, 1.0f - sumOfSquares)) : smallest[next++];
+		}
+
+		return glm::normalize(glm::quat(components[3], components[0], components[1], components[2]));
+	}
+
 	VectorTrack* LoadVectorTrack(void** memoryPointer, const flat::VectorTrack* flatVectorTrack)
 	{
 		VectorTrack* newVectorTrack = nullptr;
@@ -384,4 +469,66 @@ namespace r2::anim
 
 		return newQuatTrack;
 	}
+
+	template<typename T, unsigned int N>
+	static Track<T, N>* LoadCompressedTrack(void** memoryPointer, const flat::CompressedTrack* flatCompressedTrack)
+	{
+		const auto flatTimes = flatCompressedTrack->times();
+		const auto flatValues = flatCompressedTrack->values();
+		const auto sampledKeys = flatCompressedTrack->trackInfo()->sampledKeys();
+
+		const auto numFrames = flatTimes->size();
+		const auto numSampledKeys = sampledKeys->size();
+
+		R2_CHECK(flatValues->size() == numFrames * 3, "We should have 3 values per key");
+
+		Track<T, N>* newTrack = new (*memoryPointer) Track<T, N>();
+		*memoryPointer = r2::mem::utils::PointerAdd(*memoryPointer, sizeof(Track<T, N>));
+
+		newTrack->mCompressedTimes = EMPLACE_SARRAY(*memoryPointer, float, numFrames);
+		*memoryPointer = r2::mem::utils::PointerAdd(*memoryPointer, r2::SArray<float>::MemorySize(numFrames));
+
+		newTrack->mCompressedValues = EMPLACE_SARRAY(*memoryPointer, u16, numFrames * 3);
+		*memoryPointer = r2::mem::utils::PointerAdd(*memoryPointer, r2::SArray<u16>::MemorySize(numFrames * 3));
+
+		newTrack->mSampledFrames = EMPLACE_SARRAY(*memoryPointer, u32, numSampledKeys);
+		*memoryPointer = r2::mem::utils::PointerAdd(*memoryPointer, r2::SArray<u32>::MemorySize(numSampledKeys));
+
+		memcpy(newTrack->mCompressedTimes->mData, flatTimes->data(), sizeof(float) * numFrames);
+		newTrack->mCompressedTimes->mSize = numFrames;
+
+		memcpy(newTrack->mCompressedValues->mData, flatValues->data(), sizeof(u16) * numFrames * 3);
+		newTrack->mCompressedValues->mSize = numFrames * 3;
+
+		for (flatbuffers::uoffset_t i = 0; i < numSampledKeys; ++i)
+		{
+			r2::sarr::Push(*newTrack->mSampledFrames, sampledKeys->Get(i));
+		}
+
+		if (flatCompressedTrack->rangeMin() && flatCompressedTrack->rangeExtent())
+		{
+			newTrack->mRangeMin[0] = flatCompressedTrack->rangeMin()->x();
+			newTrack->mRangeMin[1] = flatCompressedTrack->rangeMin()->y();
+			newTrack->mRangeMin[2] = flatCompressedTrack->rangeMin()->z();
+
+			newTrack->mRangeExtent[0] = flatCompressedTrack->rangeExtent()->x();
+			newTrack->mRangeExtent[1] = flatCompressedTrack->rangeExtent()->y();
+			newTrack->mRangeExtent[2] = flatCompressedTrack->rangeExtent()->z();
+		}
+
+		newTrack->mInterpolationType = static_cast<InterpolationType>(flatCompressedTrack->trackInfo()->interpolation());
+		newTrack->mNumSamples = flatCompressedTrack->trackInfo()->numberOfSamples();
+
+		return newTrack;
+	}
+
+	VectorTrack* LoadCompressedVectorTrack(void** memoryPointer, const flat::CompressedTrack* flatCompressedTrack)
+	{
+		return LoadCompressedTrack<glm::vec3, 3>(memoryPointer, flatCompressedTrack);
+	}
+
+	QuatTrack* LoadCompressedQuatTrack(void** memoryPointer, const flat::CompressedTrack* flatCompressedTrack)
+	{
+		return LoadCompressedTrack<glm::quat, 4>(memoryPointer, flatCompressedTrack);
+	}
 }
\ No newline at end of file
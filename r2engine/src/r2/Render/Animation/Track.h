@@ -10,6 +10,7 @@ namespace flat
 {
 	struct VectorTrack;
 	struct QuaternionTrack;
+	struct CompressedTrack;
 }
 
 namespace r2::anim
@@ -30,14 +31,24 @@ namespace r2::anim
 		InterpolationType mInterpolationType = LINEAR;
 		unsigned int mNumSamples = 0;
 
+		//Compressed tracks have no mFrames. Their keys are quantized to 3 u16s each (see RAnimation.fbs) and are always linear or constant
+		r2::SArray<float>* mCompressedTimes = nullptr;
+		r2::SArray<u16>* mCompressedValues = nullptr;
+		float mRangeMin[3] = { 0.0f, 0.0f, 0.0f };
+		float mRangeExtent[3] = { 0.0f, 0.0f, 0.0f };
+
 		Frame<N>& operator[](unsigned int index);
 
+		bool IsCompressed() const;
 		float GetStartTime() const;
 		float GetEndTime() const;
+		float GetFrameTime(u32 index) const;
+		T GetFrameValue(u32 index) const;
 		u32 Size() const;
 		T Sample(float time, bool looping) const;
 
 		static u64 MemorySize(u32 numFrames, u32 numSampledFrames, const r2::mem::utils::MemoryProperties& memoryProperties);
+		static u64 CompressedMemorySize(u32 numFrames, u32 numSampledFrames, const r2::mem::utils::MemoryProperties& memoryProperties);
 	private:
 
 		T SampleConstant(float time, bool looping) const;
@@ -49,6 +60,7 @@ namespace r2::anim
 		s32 FrameIndex(float time, bool looping) const;
 		float AdjustTimeToFitTrack(float t, bool looping) const;
 		T Cast(float* value) const;
+		T Decompress(u32 index) const;
 	};
 
 	typedef Track<float, 1u> ScalarTrack;
@@ -57,6 +69,8 @@ namespace r2::anim
 
 	VectorTrack* LoadVectorTrack(void** memoryPointer, const flat::VectorTrack* flatVectorTrack);
 	QuatTrack* LoadQuatTrack(void** memoryPointer, const flat::QuaternionTrack* flatQuatTrack);
+	VectorTrack* LoadCompressedVectorTrack(void** memoryPointer, const flat::CompressedTrack* flatCompressedTrack);
+	QuatTrack* LoadCompressedQuatTrack(void** memoryPointer, const flat::CompressedTrack* flatCompressedTrack);
 }
 
 #endif
\ No newline at end of file
@@ -46,14 +46,33 @@ namespace r2::anim
 			;
 	}
 
+	u64 TransformTrack::CompressedMemorySize(u32 numPositionFrames, u32 numScaleFrames, u32 numRotationFrames, u32 numSampledPositions, u32 numSampledScales, u32 numSampledRotations, const r2::mem::utils::MemoryProperties& memProperties)
+	{
+		return
+			r2::mem::utils::GetMaxMemoryForAllocation(sizeof(TransformTrack), memProperties.alignment, memProperties.headerSize, memProperties.boundsChecking) +
+			VectorTrack::CompressedMemorySize(numPositionFrames, numSampledPositions, memProperties) +
+			VectorTrack::CompressedMemorySize(numScaleFrames, numSampledScales, memProperties) +
+			QuatTrack::CompressedMemorySize(numRotationFrames, numSampledRotations, memProperties)
+			;
+	}
+
 	r2::anim::TransformTrack* LoadTransformTrack(void** memoryPointer, const flat::TransformTrack* flatTransformTrack)
 	{
 		TransformTrack* newTransformTrack = new (*memoryPointer) TransformTrack();
 		*memoryPointer = r2::mem::utils::PointerAdd(*memoryPointer, sizeof(TransformTrack));
 
-		newTransformTrack->mPosition = LoadVectorTrack(memoryPointer, flatTransformTrack->positionTrack());
-		newTransformTrack->mScale = LoadVectorTrack(memoryPointer, flatTransformTrack->scaleTrack());
-		newTransformTrack->mRotation = LoadQuatTrack(memoryPointer, flatTransformTrack->rotationTrack());
+		if (flatTransformTrack->compressedPositionTrack())
+		{
+			newTransformTrack->mPosition = LoadCompressedVectorTrack(memoryPointer, flatTransformTrack->compressedPositionTrack());
+			newTransformTrack->mScale = LoadCompressedVectorTrack(memoryPointer, flatTransformTrack->compressedScaleTrack());
+			newTransformTrack->mRotation = LoadCompressedQuatTrack(memoryPointer, flatTransformTrack->compressedRotationTrack());
+		}
+		else
+		{
+			newTransformTrack->mPosition = LoadVectorTrack(memoryPointer, flatTransformTrack->positionTrack());
+			newTransformTrack->mScale = LoadVectorTrack(memoryPointer, flatTransformTrack->scaleTrack());
+			newTransformTrack->mRotation = LoadQuatTrack(memoryPointer, flatTransformTrack->rotationTrack());
+		}
 
 		newTransformTrack->mJointID = flatTransformTrack->jointID();
 		newTransformTrack->mStartTime = flatTransformTrack->startTime();
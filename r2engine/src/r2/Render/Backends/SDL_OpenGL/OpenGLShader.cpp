@@ -23,6 +23,7 @@
 #include <string.h>
 
 #include "r2/Utils/Hash.h"
+#include "r2/Platform/Platform.h"
 
 //Don't love using these...
 #include <string>
@@ -67,6 +68,21 @@ namespace r2::draw::shader
 
     const ShaderHandle InvalidShader = 0;
 
+    //@NOTE(Serge): Program binaries are only valid for the driver that made them, so the cache key is a hash of the
+    //              preprocessed sources plus the driver strings. Any change to a shader part or its defines misses the cache.
+    constexpr u32 PROGRAM_BINARY_CACHE_MAGIC = 0x52325042; //R2PB
+    constexpr u32 PROGRAM_BINARY_CACHE_VERSION = 1;
+
+    struct ProgramBinaryCacheHeader
+    {
+        u32 magic = 0;
+        u32 version = 0;
+        u64 sourceHash = 0;
+        u64 driverHash = 0;
+        u32 binaryFormat = 0;
+        u32 binarySize = 0;
+    };
+
     void Use(const Shader& shader)
     {
         glUseProgram(shader.shaderProg);
@@ -278,6 +294,9 @@ namespace r2::draw::shader
 
 		GLuint shaderProgram = glCreateProgram();
 
+		//So we can save the program to the program binary cache after linking
+		glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 		GLuint vertexShaderHandle;
 		if (r2::sarr::Size(*vertexShaderStrings) > 0)
 		{
@@ -479,6 +498,273 @@ namespace r2::draw::shader
     {
         strcpy(fullPath, shadersystem::FindShaderPathByName(shaderName));
     }
+
+    //Matches lines like: #version 450 core
+    bool IsVersionLine(const char* line)
+    {
+        const char* versionDirective = "#version ";
+        const size_t versionDirectiveLength = strlen(versionDirective);
+
+        if (strncmp(line, versionDirective, versionDirectiveLength) != 0)
+        {
+            return false;
+        }
+
+        const char* version = line + versionDirectiveLength;
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            if (!isdigit(static_cast<unsigned char>(version[i])))
+            {
+                return false;
+            }
+        }
+
+        return strcmp(version + 3, " core") == 0;
+    }
+
+    //Matches lines like: #include "Common/Defines.glsl" and returns the start and length of the path between the quotes
+    bool ParseIncludeLine(const char* line, const char*& includePath, size_t& includePathLength)
+    {
+        const char* includeDirective = "#include \"";
+        const size_t includeDirectiveLength = strlen(includeDirective);
+
+        if (strncmp(line, includeDirective, includeDirectiveLength) != 0)
+        {
+            return false;
+        }
+
+        const char* pathStart = line + includeDirectiveLength;
+        const char* closingQuote = strrchr(pathStart, '"');
+
+        if (!closingQuote)
+        {
+            return false;
+        }
+
+        for (const char* c = closingQuote + 1; *c != '\0'; ++c)
+        {
+            if (*c != ' ' && *c != '\t')
+            {
+                return false;
+            }
+        }
+
+        includePath = pathStart;
+        includePathLength = closingQuote - pathStart;
+
+        return true;
+    }
+
+    u64 GetDriverHash()
+    {
+        static u64 s_driverHash = 0;
+
+        if (s_driverHash == 0)
+        {
+            r2::utils::fnv1a_64 hasher;
+
+            const GLenum driverStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+
+            for (GLenum driverString : driverStrings)
+            {
+                const char* str = reinterpret_cast<const char*>(glGetString(driverString));
+
+                if (str)
+                {
+                    hasher.update(str, strlen(str));
+                }
+            }
+
+            s_driverHash = hasher.digest();
+        }
+
+        return s_driverHash;
+    }
+
+    bool IsProgramBinaryCacheSupported()
+    {
+        static s32 s_numProgramBinaryFormats = -1;
+
+        if (s_numProgramBinaryFormats < 0)
+        {
+            GLint numFormats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+            s_numProgramBinaryFormats = numFormats;
+        }
+
+        return s_numProgramBinaryFormats > 0;
+    }
+
+    u64 HashShaderSources(const r2::SArray<char*>* shaderStageParts[], u32 numStages)
+    {
+        r2::utils::fnv1a_64 hasher;
+
+        for (u32 stage = 0; stage < numStages; ++stage)
+        {
+            //so moving a part from one stage to the next changes the hash
+            hasher.update(&stage, sizeof(stage));
+
+            const auto numParts = r2::sarr::Size(*shaderStageParts[stage]);
+
+            for (u64 i = 0; i < numParts; ++i)
+            {
+                const char* part = r2::sarr::At(*shaderStageParts[stage], i);
+                hasher.update(part, strlen(part));
+            }
+        }
+
+        return hasher.digest();
+    }
+
+    void GetProgramBinaryCachePath(u64 sourceHash, char* path)
+    {
+        static std::string s_programBinaryCacheDirectory;
+
+        if (s_programBinaryCacheDirectory.empty())
+        {
+            s_programBinaryCacheDirectory = CPLAT.AppPath() + "shader_cache/";
+
+            if (!r2::fs::FileSystem::DirExists(s_programBinaryCacheDirectory.c_str()))
+            {
+                bool created = r2::fs::FileSystem::CreateDirectory(s_programBinaryCacheDirectory.c_str(), true);
+                R2_CHECK(created, "Failed to create the shader cache directory: %s", s_programBinaryCacheDirectory.c_str());
+            }
+        }
+
+        snprintf(path, fs::FILE_PATH_LENGTH, "%s%016llx.bin", s_programBinaryCacheDirectory.c_str(), static_cast<unsigned long long>(sourceHash));
+    }
+
+    //Returns 0 if the program isn't in the cache or the driver rejected the cached binary
+    u32 LoadProgramFromBinaryCache(u64 sourceHash)
+    {
+        if (!IsProgramBinaryCacheSupported())
+        {
+            return 0;
+        }
+
+        char cachePath[fs::FILE_PATH_LENGTH];
+        GetProgramBinaryCachePath(sourceHash, cachePath);
+
+        if (!r2::fs::FileSystem::FileExists(cachePath))
+        {
+            return 0;
+        }
+
+        r2::fs::File* cacheFile = r2::fs::FileSystem::Open(DISK_CONFIG, cachePath, r2::fs::Read | r2::fs::Binary);
+
+        if (!cacheFile)
+        {
+            return 0;
+        }
+
+        ProgramBinaryCacheHeader header;
+        const u64 fileSize = cacheFile->Size();
+
+        bool valid = fileSize >= sizeof(header) && cacheFile->Read(&header, sizeof(header)) == sizeof(header) &&
+            header.magic == PROGRAM_BINARY_CACHE_MAGIC &&
+            header.version == PROGRAM_BINARY_CACHE_VERSION &&
+            header.sourceHash == sourceHash &&
+            header.driverHash == GetDriverHash() &&
+            header.binarySize > 0 &&
+            fileSize - sizeof(header) == header.binarySize;
+
+        u32 shaderProgram = 0;
+
+        if (valid)
+        {
+            void* binary = ALLOC_BYTESN(*MEM_ENG_SCRATCH_PTR, header.binarySize, sizeof(u64));
+
+            if (binary && cacheFile->Read(binary, header.binarySize) == header.binarySize)
+            {
+                shaderProgram = glCreateProgram();
+                glProgramBinary(shaderProgram, header.binaryFormat, binary, header.binarySize);
+
+                //The driver can reject binaries it made itself (ie. after an update that didn't change the version string)
+                int lparams = -1;
+                glGetProgramiv(shaderProgram, GL_LINK_STATUS, &lparams);
+
+                if (GL_TRUE != lparams)
+                {
+                    glDeleteProgram(shaderProgram);
+                    shaderProgram = 0;
+                }
+            }
+
+            if (binary)
+            {
+                FREE(binary, *MEM_ENG_SCRATCH_PTR);
+            }
+        }
+
+        r2::fs::FileSystem::Close(cacheFile);
+
+        if (!shaderProgram)
+        {
+            //Stale entry, it'll be written again once we've compiled from source
+            r2::fs::FileSystem::DeleteFile(cachePath);
+        }
+
+        return shaderProgram;
+    }
+
+    void SaveProgramToBinaryCache(u32 shaderProgram, u64 sourceHash)
+    {
+        if (!IsProgramBinaryCacheSupported())
+        {
+            return;
+        }
+
+        GLint binarySize = 0;
+        glGetProgramiv(shaderProgram, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+
+        if (binarySize <= 0)
+        {
+            return;
+        }
+
+        void* binary = ALLOC_BYTESN(*MEM_ENG_SCRATCH_PTR, binarySize, sizeof(u64));
+
+        if (!binary)
+        {
+            R2_CHECK(false, "Could not allocate: %d bytes", binarySize);
+            return;
+        }
+
+        ProgramBinaryCacheHeader header;
+        header.magic = PROGRAM_BINARY_CACHE_MAGIC;
+        header.version = PROGRAM_BINARY_CACHE_VERSION;
+        header.sourceHash = sourceHash;
+        header.driverHash = GetDriverHash();
+
+        GLenum binaryFormat = 0;
+        GLsizei actualSize = 0;
+        glGetProgramBinary(shaderProgram, binarySize, &actualSize, &binaryFormat, binary);
+
+        header.binaryFormat = binaryFormat;
+        header.binarySize = actualSize;
+
+        if (actualSize > 0)
+        {
+            char cachePath[fs::FILE_PATH_LENGTH];
+            GetProgramBinaryCachePath(sourceHash, cachePath);
+
+            r2::fs::File* cacheFile = r2::fs::FileSystem::Open(DISK_CONFIG, cachePath, r2::fs::Write | r2::fs::Binary);
+
+            if (cacheFile)
+            {
+                cacheFile->Write(&header, sizeof(header));
+                cacheFile->Write(binary, actualSize);
+                r2::fs::FileSystem::Close(cacheFile);
+            }
+            else
+            {
+                R2_LOGE("Failed to open the shader cache file: %s\n", cachePath);
+            }
+        }
+
+        FREE(binary, *MEM_ENG_SCRATCH_PTR);
+    }
 #ifdef R2_DEBUG
     void UpdateShaderDebugInfo(const char* saveptr1, size_t& numLines, size_t& includeLines, size_t& globalLines, bool incrementGlobalLines, size_t debugIndex, const char* file)
     {
@@ -549,10 +835,6 @@ namespace r2::draw::shader
 
         r2::sarr::Push(*tempAllocations, (void*)shaderFileDataCopy);
 
-		static std::regex includeExpression("^#include \".*\"[ \t]*$");
-		static std::regex filePathExpression("\".*\"");
-        static std::regex versionExpression("^#version [0-9][0-9][0-9] core$");
-
         char* shaderParsedOutIncludes = (char*)ALLOC_BYTESN(*MEM_ENG_SCRATCH_PTR, lengthOfShaderFile + 32 + 50 * fs::FILE_PATH_LENGTH, sizeof(char)); //+32 for each potential '\0' in the file
         shaderParsedOutIncludes[0] = '\0';
         u32 lengthOfParsedShaderData = 0;
@@ -592,7 +874,7 @@ namespace r2::draw::shader
         while (pch != nullptr)
         {
 
-            if (!hasPassedVersion && std::regex_match(pch, versionExpression))
+            if (!hasPassedVersion && IsVersionLine(pch))
             {
                 u32 strLen = strlen(pch);
 
@@ -655,7 +937,10 @@ namespace r2::draw::shader
 				continue;
             }
 
-            if (!std::regex_match(pch, includeExpression))
+            const char* includePath = nullptr;
+            size_t includePathLength = 0;
+
+            if (!ParseIncludeLine(pch, includePath, includePathLength))
             {
                 u32 strLen = strlen(pch);
 
@@ -674,34 +959,11 @@ namespace r2::draw::shader
                 continue;
             }
 
-            std::smatch match;
-            std::string pchString = std::string(pch);
-            if (!std::regex_search(pchString, match, filePathExpression))
-            {
-                u32 strLen = strlen(pch);
-
-				strcat(&shaderParsedOutIncludes[currentOffset], pch);
-
-				strcat(&shaderParsedOutIncludes[currentOffset], "\n");
-
-				lengthOfParsedShaderData += strLen + 1;
-
-#ifdef R2_DEBUG
-				UpdateShaderDebugInfo(saveptr1, g_shaderDebugInfo[debugIndex][shaderFilePath].shaderParts.back().numLines, g_shaderDebugInfo[debugIndex][shaderFilePath].includeLines, globalLines, true, debugIndex, shaderFilePath);
-#endif
-
-                pch = strtok_s(NULL, delimiter, &saveptr1);
-
-                continue;
-            }
-
-            std::string stringMatch(match[0]);
-
-            char* quotelessPath = (char*)ALLOC_BYTESN(*MEM_ENG_SCRATCH_PTR, stringMatch.size() - 1, sizeof(char));
+            char* quotelessPath = (char*)ALLOC_BYTESN(*MEM_ENG_SCRATCH_PTR, includePathLength + 1, sizeof(char));
 
-            strncpy(quotelessPath, stringMatch.c_str() + 1, stringMatch.size()-2); //make sure not to include the quotes
+            strncpy(quotelessPath, includePath, includePathLength);
 
-            quotelessPath[stringMatch.size() - 2] = '\0';
+            quotelessPath[includePathLength] = '\0';
             
             r2::sarr::Push(*tempAllocations, (void*)quotelessPath);
 
@@ -945,7 +1207,20 @@ namespace r2::draw::shader
 #endif
         }
         
-        u32 shaderProg = CreateShaderProgramFromStrings(vertexShaderParts, fragmentShaderParts, geometryShaderParts, computeShaderParts);
+        const r2::SArray<char*>* shaderStageParts[] = { vertexShaderParts, fragmentShaderParts, geometryShaderParts, computeShaderParts };
+        const u64 sourceHash = HashShaderSources(shaderStageParts, COUNT_OF(shaderStageParts));
+
+        u32 shaderProg = LoadProgramFromBinaryCache(sourceHash);
+
+        if (!shaderProg)
+        {
+            shaderProg = CreateShaderProgramFromStrings(vertexShaderParts, fragmentShaderParts, geometryShaderParts, computeShaderParts);
+
+            if (shaderProg)
+            {
+                SaveProgramToBinaryCache(shaderProg, sourceHash);
+            }
+        }
         
         if (!shaderProg)
         {
@@ -81,6 +81,9 @@ namespace
 		case r2::draw::ShaderDataType::Int4:     return GL_INT;
 		case r2::draw::ShaderDataType::Bool:     return GL_BOOL;
 		case r2::draw::ShaderDataType::UInt64:	 return GL_UNSIGNED_INT64_ARB;
+		case r2::draw::ShaderDataType::Short2:   return GL_SHORT;
+		case r2::draw::ShaderDataType::UShort4:  return GL_UNSIGNED_SHORT;
+		case r2::draw::ShaderDataType::Half4:    return GL_HALF_FLOAT;
 		case r2::draw::ShaderDataType::None:     break;
 		}
 
@@ -612,6 +615,11 @@ namespace r2::draw::rendererimpl
 			{
 				glVertexArrayAttribIFormat(layoutId, vertexAttribId, element.GetComponentCount(), ShaderDataTypeToOpenGLBaseType(element.type), element.offset);
 			}
+			else if (element.type >= ShaderDataType::Short2 && element.type <= ShaderDataType::Half4)
+			{
+				//@NOTE(Serge): packed formats are converted to float by the vertex fetch so the shader still reads vecN
+				glVertexArrayAttribFormat(layoutId, vertexAttribId, element.GetComponentCount(), ShaderDataTypeToOpenGLBaseType(element.type), element.normalized ? GL_TRUE : GL_FALSE, element.offset);
+			}
 
 			glVertexArrayAttribBinding(layoutId, vertexAttribId, element.bufferIndex);
 
@@ -966,6 +974,23 @@ namespace r2::draw::rendererimpl
 		glNamedBufferSubData(vBufferHandle, offset, size, data);
 	}
 
+	void UpdateQuantizedVertexBuffer(VertexBufferHandle vBufferHandle, u64 offset, const QuantizedVertex* vertices, u64 numVertices, const glm::vec3& positionScale, const glm::vec3& positionBias)
+	{
+		const u64 size = numVertices * sizeof(r2::draw::Vertex);
+
+		//decode straight into the buffer so we never need a full precision copy of the mesh on the CPU
+		r2::draw::Vertex* mappedVertices = static_cast<r2::draw::Vertex*>(glMapNamedBufferRange(vBufferHandle, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+
+		R2_CHECK(mappedVertices != nullptr, "Failed to map the vertex buffer!");
+
+		for (u64 i = 0; i < numVertices; ++i)
+		{
+			mappedVertices[i] = r2::draw::DequantizeVertex(vertices[i], positionScale, positionBias);
+		}
+
+		glUnmapNamedBuffer(vBufferHandle);
+	}
+
 	void UpdateIndexBuffer(IndexBufferHandle iBufferHandle, u64 offset, const void* data, u64 size)
 	{
 		glNamedBufferSubData(iBufferHandle, offset, size, data);
@@ -153,22 +153,140 @@ namespace r2::draw::lightsys
 
 	void ClearModifiedLights(LightSystem& system)
 	{
-		r2::sarr::Clear(*system.mMetaData.mPointLightsModifiedList);
-		r2::sarr::Clear(*system.mMetaData.mDirectionLightsModifiedList);
-		r2::sarr::Clear(*system.mMetaData.mSpotLightsModifiedList);
+		system.mMetaData.mPointLightsDirtyRanges.numRanges = 0;
+		system.mMetaData.mDirectionLightsDirtyRanges.numRanges = 0;
+		system.mMetaData.mSpotLightsDirtyRanges.numRanges = 0;
 		system.mMetaData.mShouldUpdateSkyLight = false;
 	}
 
+	void AddToDirtyRanges(LightDirtyRanges& dirtyRanges, s64 lightIndex)
+	{
+		const s32 index = static_cast<s32>(lightIndex);
+
+		//first range that ends at or after the light - the light goes in it, right before it or merges it with the previous one
+		u32 i = 0;
+		while (i < dirtyRanges.numRanges && dirtyRanges.ranges[i].end < index)
+		{
+			++i;
+		}
+
+		if (i < dirtyRanges.numRanges && dirtyRanges.ranges[i].start <= index + 1)
+		{
+			LightDirtyRange& range = dirtyRanges.ranges[i];
+
+			if (index < range.end)
+			{
+				range.start = std::min(range.start, index);
+				return;
+			}
+
+			//index == range.end so we grow the end and might now touch the next range
+			range.end = index + 1;
+
+			if (i + 1 < dirtyRanges.numRanges && dirtyRanges.ranges[i + 1].start <= range.end)
+			{
+				range.end = dirtyRanges.ranges[i + 1].end;
+
+				for (u32 j = i + 1; j + 1 < dirtyRanges.numRanges; ++j)
+				{
+					dirtyRanges.ranges[j] = dirtyRanges.ranges[j + 1];
+				}
+
+				--dirtyRanges.numRanges;
+			}
+
+			return;
+		}
+
+		if (dirtyRanges.numRanges == light::MAX_NUM_LIGHT_DIRTY_RANGES)
+		{
+			//out of ranges - merge whichever neighbours (including the new light) have the smallest gap between them
+			LightDirtyRange newRange;
+			newRange.start = index;
+			newRange.end = index + 1;
+
+			auto GetRange = [&](u32 k) -> const LightDirtyRange& {
+				return k < i ? dirtyRanges.ranges[k] : (k == i ? newRange : dirtyRanges.ranges[k - 1]);
+			};
+
+			u32 closest = 0;
+			s32 smallestGap = std::numeric_limits<s32>::max();
+
+			for (u32 k = 0; k < light::MAX_NUM_LIGHT_DIRTY_RANGES; ++k)
+			{
+				const s32 gap = GetRange(k + 1).start - GetRange(k).end;
+				if (gap < smallestGap)
+				{
+					smallestGap = gap;
+					closest = k;
+				}
+			}
+
+			LightDirtyRange merged[light::MAX_NUM_LIGHT_DIRTY_RANGES];
+
+			for (u32 k = 0, m = 0; k <= light::MAX_NUM_LIGHT_DIRTY_RANGES; ++k)
+			{
+				if (k == closest + 1)
+				{
+					merged[m - 1].end = GetRange(k).end;
+				}
+				else
+				{
+					merged[m++] = GetRange(k);
+				}
+			}
+
+			for (u32 k = 0; k < light::MAX_NUM_LIGHT_DIRTY_RANGES; ++k)
+			{
+				dirtyRanges.ranges[k] = merged[k];
+			}
+
+			return;
+		}
+
+		for (u32 j = dirtyRanges.numRanges; j > i; --j)
+		{
+			dirtyRanges.ranges[j] = dirtyRanges.ranges[j - 1];
+		}
+
+		dirtyRanges.ranges[i].start = index;
+		dirtyRanges.ranges[i].end = index + 1;
+		++dirtyRanges.numRanges;
+	}
+
+	u32 GetLightUploadRanges(const LightDirtyRanges& dirtyRanges, s32 numLights, u64 lightSize, u64 lightsOffset, LightUploadRange uploadRanges[light::MAX_NUM_LIGHT_DIRTY_RANGES])
+	{
+		u32 numUploadRanges = 0;
+
+		for (u32 i = 0; i < dirtyRanges.numRanges; ++i)
+		{
+			const LightDirtyRange& range = dirtyRanges.ranges[i];
+			const s32 end = std::min(range.end, numLights);
+
+			if (range.start >= end)
+			{
+				//the ranges are sorted so everything after this was removed too
+				break;
+			}
+
+			uploadRanges[numUploadRanges].offset = lightsOffset + lightSize * range.start;
+			uploadRanges[numUploadRanges].size = lightSize * (end - range.start);
+			++numUploadRanges;
+		}
+
+		return numUploadRanges;
+	}
+
 	bool Update(LightSystem& system, const Camera& cam, glm::vec3& lightProjRadius)
 	{
 
-		const auto numDirLightsToUpdate = r2::sarr::Size(*system.mMetaData.mDirectionLightsModifiedList);
-		const auto numPointLightsToUpdate = r2::sarr::Size(*system.mMetaData.mPointLightsModifiedList);
-		const auto numSpotLightsToUpdate = r2::sarr::Size(*system.mMetaData.mSpotLightsModifiedList);
+		const bool dirLightsModified = system.mMetaData.mDirectionLightsDirtyRanges.numRanges > 0;
+		const bool pointLightsModified = system.mMetaData.mPointLightsDirtyRanges.numRanges > 0;
+		const bool spotLightsModified = system.mMetaData.mSpotLightsDirtyRanges.numRanges > 0;
 
-		bool needsUpdate = numDirLightsToUpdate > 0 || numPointLightsToUpdate > 0 || numSpotLightsToUpdate > 0 || system.mMetaData.mShouldUpdateSkyLight;
+		bool needsUpdate = dirLightsModified || pointLightsModified || spotLightsModified || system.mMetaData.mShouldUpdateSkyLight;
 
-		if (numDirLightsToUpdate > 0)
+		if (dirLightsModified)
 		{
 			system.mSceneLighting.numShadowCastingDirectionLights = 0;
 			for (s32 i = 0; i < system.mSceneLighting.mNumDirectionLights; ++i)
@@ -181,7 +299,7 @@ namespace r2::draw::lightsys
 			}
 		}
 
-		if (numPointLightsToUpdate > 0)
+		if (pointLightsModified)
 		{
 			system.mSceneLighting.numShadowCastingPointLights = 0;
 			for (s32 i = 0; i < system.mSceneLighting.mNumPointLights; ++i)
@@ -194,7 +312,7 @@ namespace r2::draw::lightsys
 			}
 		}
 
-		if (numSpotLightsToUpdate > 0)
+		if (spotLightsModified)
 		{
 			system.mSceneLighting.numShadowCastingSpotLights = 0;
 			for (s32 i = 0; i < system.mSceneLighting.mNumSpotLights; ++i)
@@ -207,26 +325,23 @@ namespace r2::draw::lightsys
 			}
 		}
 
-		if(needsUpdate)
-			ClearModifiedLights(system);
-
 		return needsUpdate;
 	}
 
 
 	void SetShouldUpdatePointLight(LightSystem& system, s64 lightIndex)
 	{
-		r2::sarr::Push(*system.mMetaData.mPointLightsModifiedList, lightIndex);
+		AddToDirtyRanges(system.mMetaData.mPointLightsDirtyRanges, lightIndex);
 	}
 
 	void SetShouldUpdateDirectionLight(LightSystem& system, s64 lightIndex)
 	{
-		r2::sarr::Push(*system.mMetaData.mDirectionLightsModifiedList, lightIndex);
+		AddToDirtyRanges(system.mMetaData.mDirectionLightsDirtyRanges, lightIndex);
 	}
 
 	void SetShouldUpdateSpotLight(LightSystem& system, s64 lightIndex)
 	{
-		r2::sarr::Push(*system.mMetaData.mSpotLightsModifiedList, lightIndex);
+		AddToDirtyRanges(system.mMetaData.mSpotLightsDirtyRanges, lightIndex);
 	}
 
 	void SetShouldUpdateSkyLight(LightSystem& system)
@@ -765,10 +880,6 @@ namespace r2::draw
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SHashMap<s64>::MemorySize(light::MAX_NUM_POINT_LIGHTS * r2::SHashMap<u32>::LoadFactorMultiplier()), alignment, headerSize, boundsChecking) +
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SHashMap<s64>::MemorySize(light::MAX_NUM_SPOT_LIGHTS * r2::SHashMap<u32>::LoadFactorMultiplier()), alignment, headerSize, boundsChecking) +
 
-			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s64>::MemorySize(light::MAX_NUM_DIRECTIONAL_LIGHTS), alignment, headerSize, boundsChecking) +
-			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s64>::MemorySize(light::MAX_NUM_POINT_LIGHTS), alignment, headerSize, boundsChecking) +
-			r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<s64>::MemorySize(light::MAX_NUM_SPOT_LIGHTS), alignment, headerSize, boundsChecking) +
-
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SQueue<s64>::MemorySize(light::MAX_NUM_DIRECTIONAL_LIGHTS), alignment, headerSize, boundsChecking) +
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SQueue<s64>::MemorySize(light::MAX_NUM_POINT_LIGHTS), alignment, headerSize, boundsChecking) +
 			r2::mem::utils::GetMaxMemoryForAllocation(r2::SQueue<s64>::MemorySize(light::MAX_NUM_SPOT_LIGHTS), alignment, headerSize, boundsChecking);
@@ -36,6 +36,8 @@ namespace r2::draw
 		constexpr u32 NUM_SPOTLIGHT_SHADOW_PAGES = MAX_NUM_SPOT_LIGHTS;
 		constexpr u32 NUM_POINTLIGHT_SHADOW_PAGES = MAX_NUM_POINT_LIGHTS;
 		constexpr u32 NUM_DIRECTIONLIGHT_SHADOW_PAGES = MAX_NUM_SHADOW_MAP_PAGES;
+
+		constexpr u32 MAX_NUM_LIGHT_DIRTY_RANGES = 8;
 	}
 
 	using LightSystemHandle = s64;
@@ -128,15 +130,37 @@ namespace r2::draw
 		s64 mShadowCastingSpotLights[light::MAX_NUM_SHADOW_MAP_PAGES];
 	};
 
+	//The lights in [start, end) changed since they were last uploaded. Empty when end <= start
+	struct LightDirtyRange
+	{
+		s32 start = 0;
+		s32 end = 0;
+	};
+
+	//Sorted, non-touching runs of lights that changed since they were last uploaded. When we run out of runs the two closest ones get merged
+	//so scattered edits upload a few small pieces instead of everything between the lowest and highest changed light
+	struct LightDirtyRanges
+	{
+		LightDirtyRange ranges[light::MAX_NUM_LIGHT_DIRTY_RANGES];
+		u32 numRanges = 0;
+	};
+
+	//A piece of a light array to upload into the Lighting constant buffer, both in bytes
+	struct LightUploadRange
+	{
+		u64 offset = 0;
+		u64 size = 0;
+	};
+
 	struct SceneLightMetaData
 	{
 		r2::SHashMap<s64>* mPointLightMap = nullptr;
 		r2::SHashMap<s64>* mDirectionLightMap = nullptr;
 		r2::SHashMap<s64>* mSpotLightMap = nullptr;
 
-		r2::SArray<s64>* mPointLightsModifiedList = nullptr;
-		r2::SArray<s64>* mDirectionLightsModifiedList = nullptr;
-		r2::SArray<s64>* mSpotLightsModifiedList = nullptr;
+		LightDirtyRanges mPointLightsDirtyRanges;
+		LightDirtyRanges mDirectionLightsDirtyRanges;
+		LightDirtyRanges mSpotLightsDirtyRanges;
 
 		r2::SQueue<s64>* mPointLightIDs = nullptr;
 		r2::SQueue<s64>* mDirectionlightIDs = nullptr;
@@ -173,7 +197,15 @@ namespace r2::draw
 	{
 		void Init(s64 pointLightID, s64 directionLightID, s64 spotLightID);
 
+		//Returns true if any lighting changed. The dirty ranges are kept so only the changed lights need to be uploaded, call ClearModifiedLights after uploading them
 		bool Update(LightSystem& system, const Camera& cam, glm::vec3& lightProjRadius);
+		void ClearModifiedLights(LightSystem& system);
+
+		void AddToDirtyRanges(LightDirtyRanges& dirtyRanges, s64 lightIndex);
+
+		//Turns the dirty ranges of a light array that starts at lightsOffset in the constant buffer into the pieces to upload. Lights at or past numLights were removed
+		//so they're skipped. Returns the number of uploadRanges filled in
+		u32 GetLightUploadRanges(const LightDirtyRanges& dirtyRanges, s32 numLights, u64 lightSize, u64 lightsOffset, LightUploadRange uploadRanges[light::MAX_NUM_LIGHT_DIRTY_RANGES]);
 
 		template <class ARENA>
 		LightSystem* CreateLightSystem(ARENA& arena);
@@ -236,19 +268,6 @@ namespace r2::draw
 			R2_CHECK(lightSystem->mMetaData.mSpotLightMap != nullptr, "We couldn't create the light system!");
 
 
-			lightSystem->mMetaData.mPointLightsModifiedList = MAKE_SARRAY(arena, s64, light::MAX_NUM_POINT_LIGHTS);
-
-			R2_CHECK(lightSystem->mMetaData.mPointLightsModifiedList != nullptr, "We couldn't create the modified list of the lights!");
-
-			lightSystem->mMetaData.mDirectionLightsModifiedList = MAKE_SARRAY(arena, s64, light::MAX_NUM_DIRECTIONAL_LIGHTS);
-
-			R2_CHECK(lightSystem->mMetaData.mDirectionLightsModifiedList != nullptr, "We couldn't create the modified list of the lights!");
-
-			lightSystem->mMetaData.mSpotLightsModifiedList = MAKE_SARRAY(arena, s64, light::MAX_NUM_SPOT_LIGHTS);
-
-			R2_CHECK(lightSystem->mMetaData.mSpotLightsModifiedList != nullptr, "We couldn't create the modified list of the lights!");
-
-
 			lightSystem->mMetaData.mPointLightIDs = MAKE_SQUEUE(arena, s64, light::MAX_NUM_POINT_LIGHTS);
 
 			R2_CHECK(lightSystem->mMetaData.mPointLightIDs != nullptr, "We couldn't create the mPointLightIDs");
@@ -285,6 +304,7 @@ namespace r2::draw
 
 			InitLightIDs(*lightSystem);
 			ClearShadowMapPages(*lightSystem);
+			ClearModifiedLights(*lightSystem);
 
 			return lightSystem;
 		}
@@ -303,10 +323,6 @@ namespace r2::draw
 			FREE(system->mMetaData.mDirectionlightIDs, arena);
 			FREE(system->mMetaData.mPointLightIDs, arena);
 
-			FREE(system->mMetaData.mSpotLightsModifiedList, arena);
-			FREE(system->mMetaData.mDirectionLightsModifiedList, arena);
-			FREE(system->mMetaData.mPointLightsModifiedList, arena);
-			
 			FREE(system->mMetaData.mSpotLightMap, arena);
 			FREE(system->mMetaData.mDirectionLightMap, arena);
 			FREE(system->mMetaData.mPointLightMap, arena);
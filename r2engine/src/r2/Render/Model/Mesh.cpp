@@ -16,4 +16,22 @@ namespace r2::draw
             r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<r2::draw::Vertex>::MemorySize(numVertices), alignment, headerSize, boundsChecking) +
             r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u32>::MemorySize(numIndices), alignment, headerSize, boundsChecking);
     }
+
+    u64 Mesh::QuantizedMemorySize(u64 numVertices, u64 numIndices, u64 alignment, u64 headerSize, u64 boundsChecking)
+    {
+        return
+            r2::mem::utils::GetMaxMemoryForAllocation(sizeof(r2::draw::Mesh), alignment, headerSize, boundsChecking) +
+            r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<r2::draw::QuantizedVertex>::MemorySize(numVertices), alignment, headerSize, boundsChecking) +
+            r2::mem::utils::GetMaxMemoryForAllocation(r2::SArray<u32>::MemorySize(numIndices), alignment, headerSize, boundsChecking);
+    }
+
+    u64 GetNumVertices(const Mesh& mesh)
+    {
+        if (mesh.optrQuantizedVertices)
+        {
+            return r2::sarr::Size(*mesh.optrQuantizedVertices);
+        }
+
+        return r2::sarr::Size(*mesh.optrVertices);
+    }
 }
@@ -22,16 +22,31 @@ namespace r2::draw
 		float radius;
 	};
 
+    struct MeshLOD
+    {
+        u32 firstIndex = 0; //relative to the start of the mesh's indices
+        u32 numIndices = 0;
+        float error = 0.0f; //how far in model space this LOD can be from LOD 0
+    };
+
     struct Mesh
     {
+        static constexpr u32 MAX_NUM_LODS = 4;
+
         u64 assetName = 0;
         r2::SArray<r2::draw::Vertex>* optrVertices = nullptr;
+        r2::SArray<r2::draw::QuantizedVertex>* optrQuantizedVertices = nullptr; //only one of these is set
         r2::SArray<u32>* optrIndices = nullptr;
         u32 materialIndex = 0;
         Bounds objectBounds; //in model space
+        MeshLOD lods[MAX_NUM_LODS]; //the indices of every LOD are in optrIndices one after another
+        u32 numLODs = 0;
 
         static u64 MemorySize(u64 numVertices, u64 numIndices, u64 alignment, u64 headerSize, u64 boundsChecking);
+        static u64 QuantizedMemorySize(u64 numVertices, u64 numIndices, u64 alignment, u64 headerSize, u64 boundsChecking);
     };
+
+    u64 GetNumVertices(const Mesh& mesh);
 }
 
 #endif /* Mesh_h */
\ No newline at end of file
@@ -80,6 +80,11 @@ namespace r2::draw
         glm::mat4 globalInverseTransform; 
 		glm::mat4 globalTransform;
 
+		//@NOTE(Serge): for models with QuantizedVertex meshes - position = quantizedPosition * quantizedPositionScale + quantizedPositionBias
+		b32 hasQuantizedVertices = false;
+		glm::vec3 quantizedPositionScale = glm::vec3(1.0f);
+		glm::vec3 quantizedPositionBias = glm::vec3(0.0f);
+
 		static u64 ModelMemorySize(u64 numMeshes, u64 numMaterials, u64 alignment, u32 headerSize, u32 boundsChecking);
 
 		static u64 MemorySize(u32 numMeshes, u32 numMaterials, u32 numJoints, u32 boneDataSize, u32 numAnimations, u32 numGLTFMeshes, u32 alignment, u32 headerSize, u32 boundsChecking);
@@ -35,6 +35,16 @@ namespace r2::draw::dispatch
 		rendererimpl::UpdateVertexBuffer(realData->vertexBufferHandle, realData->offset, realData->data, realData->dataSize);
 	}
 
+	void FillQuantizedVertexBuffer(const void* data)
+	{
+		const r2::draw::cmd::FillQuantizedVertexBuffer* realData = static_cast<const r2::draw::cmd::FillQuantizedVertexBuffer*>(data);
+		R2_CHECK(realData != nullptr, "We don't have any of the real data?");
+
+		rendererimpl::UpdateQuantizedVertexBuffer(realData->vertexBufferHandle, realData->offset, static_cast<const r2::draw::QuantizedVertex*>(realData->data), realData->numVertices,
+			glm::vec3(realData->positionScale[0], realData->positionScale[1], realData->positionScale[2]),
+			glm::vec3(realData->positionBias[0], realData->positionBias[1], realData->positionBias[2]));
+	}
+
 	void FillIndexBuffer(const void* data)
 	{
 		const r2::draw::cmd::FillIndexBuffer* realData = static_cast<const r2::draw::cmd::FillIndexBuffer*>(data);
@@ -12,6 +12,7 @@ namespace r2::draw::dispatch
 	void ClearBuffers(const void* data);
 	void DrawIndexed(const void* data);
 	void FillVertexBuffer(const void* data);
+	void FillQuantizedVertexBuffer(const void* data);
 	void FillIndexBuffer(const void* data);
 	void CopyBuffer(const void* data);
 	void DeleteBuffer(const void* data);
@@ -292,6 +292,9 @@ namespace r2::draw
             case ShaderDataType::UInt3:     return 4 * 3;
             case ShaderDataType::UInt4:     return 4 * 4;
             case ShaderDataType::UInt64:    return 8;
+            case ShaderDataType::Short2:    return 2 * 2;
+            case ShaderDataType::UShort4:   return 2 * 4;
+            case ShaderDataType::Half4:     return 2 * 4;
             case ShaderDataType::None:
                 break;
         }
@@ -321,6 +324,9 @@ namespace r2::draw
         case ShaderDataType::UInt2:   return 2;
         case ShaderDataType::UInt3:   return 3;
         case ShaderDataType::UInt4:   return 4;
+        case ShaderDataType::Short2:  return 2;
+        case ShaderDataType::UShort4: return 4;
+        case ShaderDataType::Half4:   return 4;
 		case ShaderDataType::None:    break;
 		}
 
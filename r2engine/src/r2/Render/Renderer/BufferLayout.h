@@ -44,6 +44,10 @@ namespace r2::draw
         UInt2,
         UInt3,
         UInt4,
+        //vertex attributes only - read as floats in the shader (use BufferElement::normalized for unorm/snorm)
+        Short2,
+        UShort4,
+        Half4,
     };
     
     enum class VertexType
@@ -8,8 +8,10 @@
 #include "r2/Render/Renderer/BackendDispatch.h"
 #include "r2/Render/Renderer/CommandPacket.h"
 #include <algorithm>
+#include <type_traits>
 
 #define MAKE_CMD_BUCKET(arena, key, keydecoder, capacity) r2::draw::cmdbkt::CreateCommandBucket<key>(arena, capacity, keydecoder, __FILE__, __LINE__, "")
+#define MAKE_PARALLEL_CMD_BUCKET(arena, key, keydecoder, capacity, numSubBuckets, subBucketCapacity) r2::draw::cmdbkt::CreateCommandBucket<key>(arena, capacity, keydecoder, numSubBuckets, subBucketCapacity, __FILE__, __LINE__, "")
 #define FREE_CMD_BUCKET(arena, key, bkt) r2::draw::cmdbkt::DestroyCommandBucket<key>(arena, bkt, __FILE__, __LINE__, "")
 
 namespace r2::draw
@@ -27,11 +29,22 @@ namespace r2::draw
 			void* data = nullptr;
 		};
 
+		static const u32 MAX_NUM_SUB_BUCKETS = 16;
+
 		static u64 MemorySize(u64 capacity);
+		static u64 MemorySize(u64 capacity, u32 numSubBuckets, u64 subBucketCapacity);
 
 		r2::SArray<Entry>* entries = nullptr;
 		r2::SArray<Entry*>* sortedEntries = nullptr;
 
+		//Each recording thread gets its own sub bucket so it can add commands without any locking.
+		//The sub buckets are merged into sortedEntries when the bucket is sorted.
+		u32 numSubBuckets = 0;
+		r2::SArray<Entry>* subBuckets[MAX_NUM_SUB_BUCKETS] = {};
+
+		//scratch space for the radix sort
+		r2::SArray<Entry*>* tempSortedEntries = nullptr;
+
 		KeyDecoderFunc KeyDecoder = nullptr;
 	};
 
@@ -42,6 +55,9 @@ namespace r2::draw
 			//1) we store a pointer to the arena for each Entry
 			//2) we circumvent the tracking of the allocation somehow
 		template<typename T, class ARENA, class CMD> CMD* AddCommand(ARENA& arena, CommandBucket<T>& bkt, T key, u64 auxMem);
+
+		//For recording from multiple threads - each thread must use its own subBucketIndex and its own arena
+		template<typename T, class ARENA, class CMD> CMD* AddCommand(ARENA& arena, CommandBucket<T>& bkt, u32 subBucketIndex, T key, u64 auxMem);
 		template<class OLDCMD, class NEWCMD, class ARENA> NEWCMD* AppendCommand(ARENA& arena, OLDCMD* appendTo, u64 auxMem);
 		template<typename T> void Close(CommandBucket<T>& bkt);
 
@@ -51,6 +67,9 @@ namespace r2::draw
 		template<typename T> using CompareFunction = bool (*)(const T & a, const T & b);
 		template<typename T> inline void Sort(CommandBucket<T>& bkt, CompareFunction<T> cmp);
 
+		//Merges the sub buckets and sorts on keyValue with an LSD radix sort. Entries with equal keys stay in the order they were added (main bucket first, then each sub bucket in order)
+		template<typename T> inline void Sort(CommandBucket<T>& bkt);
+
 		template<typename T> void Submit(CommandBucket<T>& bkt);
 
 		//@TODO(Serge): implement methods for setting Render Targets
@@ -59,6 +78,7 @@ namespace r2::draw
 		template<typename T> inline u64 Capacity(const CommandBucket<T>& bkt);
 
 		template<typename T, class ARENA> CommandBucket<T>* CreateCommandBucket(ARENA& arena, u64 capacity, typename CommandBucket<T>::KeyDecoderFunc decoderFunc, const char* file, s32 line, const char* description);
+		template<typename T, class ARENA> CommandBucket<T>* CreateCommandBucket(ARENA& arena, u64 capacity, typename CommandBucket<T>::KeyDecoderFunc decoderFunc, u32 numSubBuckets, u64 subBucketCapacity, const char* file, s32 line, const char* description);
 		template<typename T, class ARENA> void DestroyCommandBucket(ARENA& arena, CommandBucket<T>* cmdBkt, const char* file, s32 line, const char* description);
 	}
 
@@ -75,7 +95,7 @@ namespace r2::draw
 				newEntry.aKey = key;
 				newEntry.data = packet;
 
-				//this is where we would do any locking/atomics etc
+				//@NOTE(Serge): not thread safe - use the sub bucket version of AddCommand when recording from multiple threads
 				r2::sarr::Push(*bkt.entries, newEntry);
 			}
 			
@@ -85,6 +105,24 @@ namespace r2::draw
 			return cmdpkt::GetCommand<CMD>(packet);
 		}
 
+		template<typename T, class ARENA, class CMD> CMD* AddCommand(ARENA& arena, CommandBucket<T>& bkt, u32 subBucketIndex, T key, u64 auxMem)
+		{
+			R2_CHECK(subBucketIndex < bkt.numSubBuckets, "subBucketIndex: %u is out of range, we only have: %u sub buckets", subBucketIndex, bkt.numSubBuckets);
+
+			CommandPacket packet = cmdpkt::Create<CMD, ARENA>(arena, auxMem);
+
+			CommandBucket<T>::Entry newEntry;
+			newEntry.aKey = key;
+			newEntry.data = packet;
+
+			r2::sarr::Push(*bkt.subBuckets[subBucketIndex], newEntry);
+
+			cmdpkt::StoreNextCommandPacket(packet, nullptr);
+			cmdpkt::StoreBackendDispatchFunction(packet, CMD::DispatchFunc);
+
+			return cmdpkt::GetCommand<CMD>(packet);
+		}
+
 		template<class OLDCMD, class NEWCMD, class ARENA> 
 		NEWCMD* AppendCommand(ARENA& arena, OLDCMD* appendTo, u64 auxMem)
 		{
@@ -108,10 +146,13 @@ namespace r2::draw
 		{
 			R2_CHECK(bkt.entries != nullptr, "entries is nullptr!");
 
-			const u64 numEntries = r2::sarr::Size(*bkt.entries);
-
 			r2::sarr::Clear(*bkt.sortedEntries);
 			r2::sarr::Clear(*bkt.entries);
+
+			for (u32 i = 0; i < bkt.numSubBuckets; ++i)
+			{
+				r2::sarr::Clear(*bkt.subBuckets[i]);
+			}
 		}
 
 		inline void SubmitPacket(CommandPacket packet)
@@ -123,7 +164,7 @@ namespace r2::draw
 
 		template<typename T> void Submit(CommandBucket<T>& bkt)
 		{
-			const u64 numEntries = r2::sarr::Size(*bkt.entries);
+			const u64 numEntries = r2::sarr::Size(*bkt.sortedEntries);
 
 			for (u64 i = 0; i < numEntries; ++i)
 			{
@@ -148,7 +189,15 @@ namespace r2::draw
 		template<typename T> inline u64 NumEntries(const CommandBucket<T>& bkt)
 		{
 			R2_CHECK(bkt.entries != nullptr, "entries is nullptr!");
-			return r2::sarr::Size(*bkt.entries);
+
+			u64 numEntries = r2::sarr::Size(*bkt.entries);
+
+			for (u32 i = 0; i < bkt.numSubBuckets; ++i)
+			{
+				numEntries += r2::sarr::Size(*bkt.subBuckets[i]);
+			}
+
+			return numEntries;
 		}
 
 		template<typename T> inline u64 Capacity(const CommandBucket<T>& bkt)
@@ -157,26 +206,126 @@ namespace r2::draw
 			return r2::sarr::Capacity(*bkt.entries);
 		}
 
-		template<typename T> inline void Sort(CommandBucket<T>& bkt, CompareFunction<T> cmp)
+		template<typename T> inline void GatherEntries(CommandBucket<T>& bkt)
 		{
 			R2_CHECK(bkt.entries != nullptr, "entries is nullptr!");
 
+			r2::sarr::Clear(*bkt.sortedEntries);
+
 			const u64 numEntries = r2::sarr::Size(*bkt.entries);
 
 			for (u64 i = 0; i < numEntries; ++i)
 			{
-				r2::sarr::Push(*bkt.sortedEntries, & r2::sarr::At(*bkt.entries, i));
+				r2::sarr::Push(*bkt.sortedEntries, &r2::sarr::At(*bkt.entries, i));
 			}
 
+			for (u32 subBucketIndex = 0; subBucketIndex < bkt.numSubBuckets; ++subBucketIndex)
+			{
+				r2::SArray<typename CommandBucket<T>::Entry>& subBucket = *bkt.subBuckets[subBucketIndex];
+				const u64 numSubBucketEntries = r2::sarr::Size(subBucket);
+
+				for (u64 i = 0; i < numSubBucketEntries; ++i)
+				{
+					r2::sarr::Push(*bkt.sortedEntries, &r2::sarr::At(subBucket, i));
+				}
+			}
+		}
+
+		template<typename T> inline void Sort(CommandBucket<T>& bkt, CompareFunction<T> cmp)
+		{
+			GatherEntries(bkt);
+
 			std::sort(r2::sarr::Begin(*bkt.sortedEntries), r2::sarr::End(*bkt.sortedEntries), [cmp](const CommandBucket<T>::Entry* a, const CommandBucket<T>::Entry* b)
 				{
 					return cmp(a->aKey, b->aKey);
 				});
 		}
 
+		template<typename T> inline void Sort(CommandBucket<T>& bkt)
+		{
+			using KeyValueType = decltype(T::keyValue);
+			using Entry = typename CommandBucket<T>::Entry;
+
+			static_assert(std::is_unsigned<KeyValueType>::value, "Radix sort only works on unsigned key values");
+
+			constexpr u32 RADIX_BITS = 8;
+			constexpr u32 RADIX_SIZE = 1 << RADIX_BITS;
+			constexpr u32 RADIX_MASK = RADIX_SIZE - 1;
+			constexpr u32 NUM_PASSES = sizeof(KeyValueType);
+
+			GatherEntries(bkt);
+
+			const u64 numEntries = r2::sarr::Size(*bkt.sortedEntries);
+
+			if (numEntries <= 1)
+			{
+				return;
+			}
+
+			R2_CHECK(bkt.tempSortedEntries != nullptr && r2::sarr::Capacity(*bkt.tempSortedEntries) >= numEntries, "We don't have enough scratch space to sort!");
+
+			//build all of the histograms in one read pass
+			u32 histograms[NUM_PASSES][RADIX_SIZE] = {};
+
+			Entry** src = r2::sarr::Begin(*bkt.sortedEntries);
+			Entry** dst = r2::sarr::Begin(*bkt.tempSortedEntries);
+
+			for (u64 i = 0; i < numEntries; ++i)
+			{
+				const KeyValueType keyValue = src[i]->aKey.keyValue;
+
+				for (u32 pass = 0; pass < NUM_PASSES; ++pass)
+				{
+					++histograms[pass][(keyValue >> (pass * RADIX_BITS)) & RADIX_MASK];
+				}
+			}
+
+			for (u32 pass = 0; pass < NUM_PASSES; ++pass)
+			{
+				u32* histogram = histograms[pass];
+
+				//if every key has the same digit then this pass wouldn't change anything - usually the case for the upper bits
+				const u32 firstDigit = (src[0]->aKey.keyValue >> (pass * RADIX_BITS)) & RADIX_MASK;
+				if (histogram[firstDigit] == numEntries)
+				{
+					continue;
+				}
+
+				u32 offset = 0;
+				for (u32 digit = 0; digit < RADIX_SIZE; ++digit)
+				{
+					const u32 count = histogram[digit];
+					histogram[digit] = offset;
+					offset += count;
+				}
+
+				for (u64 i = 0; i < numEntries; ++i)
+				{
+					const u32 digit = (src[i]->aKey.keyValue >> (pass * RADIX_BITS)) & RADIX_MASK;
+					dst[histogram[digit]++] = src[i];
+				}
+
+				std::swap(src, dst);
+			}
+
+			if (src != r2::sarr::Begin(*bkt.sortedEntries))
+			{
+				memcpy(r2::sarr::Begin(*bkt.sortedEntries), src, sizeof(Entry*) * numEntries);
+			}
+		}
+
 		template<typename T, class ARENA> CommandBucket<T>* CreateCommandBucket(ARENA& arena, u64 capacity, typename CommandBucket<T>::KeyDecoderFunc decoderFunc, const char* file, s32 line, const char* description)
 		{
-			CommandBucket<T>* cmdBkt = new (ALLOC_BYTES(arena, CommandBucket<T>::MemorySize(capacity), alignof(u64), file, line, description)) CommandBucket<T>;
+			return CreateCommandBucket<T, ARENA>(arena, capacity, decoderFunc, 0, 0, file, line, description);
+		}
+
+		template<typename T, class ARENA> CommandBucket<T>* CreateCommandBucket(ARENA& arena, u64 capacity, typename CommandBucket<T>::KeyDecoderFunc decoderFunc, u32 numSubBuckets, u64 subBucketCapacity, const char* file, s32 line, const char* description)
+		{
+			R2_CHECK(numSubBuckets <= CommandBucket<T>::MAX_NUM_SUB_BUCKETS, "We can only have %u sub buckets", CommandBucket<T>::MAX_NUM_SUB_BUCKETS);
+
+			const u64 totalCapacity = capacity + numSubBuckets * subBucketCapacity;
+
+			CommandBucket<T>* cmdBkt = new (ALLOC_BYTES(arena, CommandBucket<T>::MemorySize(capacity, numSubBuckets, subBucketCapacity), alignof(u64), file, line, description)) CommandBucket<T>;
 
 			r2::SArray<CommandBucket<T>::Entry>* startOfArray = new (r2::mem::utils::PointerAdd(cmdBkt, sizeof(CommandBucket<T>))) r2::SArray<CommandBucket<T>::Entry>();
 
@@ -186,13 +335,33 @@ namespace r2::draw
 
 			CommandBucket<T>::Entry** startOfSortedData = (typename CommandBucket<T>::Entry**)r2::mem::utils::PointerAdd(startOfSortedArray, sizeof(r2::SArray<CommandBucket<T>::Entry*>));
 
+			r2::SArray<CommandBucket<T>::Entry*>* startOfTempSortedArray = new (r2::mem::utils::PointerAdd(startOfSortedData, sizeof(CommandBucket<T>::Entry*) * totalCapacity)) r2::SArray<CommandBucket<T>::Entry*>();
+
+			CommandBucket<T>::Entry** startOfTempSortedData = (typename CommandBucket<T>::Entry**)r2::mem::utils::PointerAdd(startOfTempSortedArray, sizeof(r2::SArray<CommandBucket<T>::Entry*>));
 
 			cmdBkt->entries = startOfArray;
 			cmdBkt->entries->Create(dataStart, capacity);
 
 			cmdBkt->sortedEntries = startOfSortedArray;
-			cmdBkt->sortedEntries->Create(startOfSortedData, capacity);
+			cmdBkt->sortedEntries->Create(startOfSortedData, totalCapacity);
+
+			cmdBkt->tempSortedEntries = startOfTempSortedArray;
+			cmdBkt->tempSortedEntries->Create(startOfTempSortedData, totalCapacity);
 
+			void* nextSubBucket = r2::mem::utils::PointerAdd(startOfTempSortedData, sizeof(CommandBucket<T>::Entry*) * totalCapacity);
+
+			cmdBkt->numSubBuckets = numSubBuckets;
+
+			for (u32 i = 0; i < numSubBuckets; ++i)
+			{
+				r2::SArray<CommandBucket<T>::Entry>* subBucket = new (nextSubBucket) r2::SArray<CommandBucket<T>::Entry>();
+				CommandBucket<T>::Entry* subBucketData = (CommandBucket<T>::Entry*)r2::mem::utils::PointerAdd(subBucket, sizeof(r2::SArray<CommandBucket<T>::Entry>));
+
+				subBucket->Create(subBucketData, subBucketCapacity);
+				cmdBkt->subBuckets[i] = subBucket;
+
+				nextSubBucket = r2::mem::utils::PointerAdd(subBucketData, sizeof(CommandBucket<T>::Entry) * subBucketCapacity);
+			}
 
 			cmdBkt->KeyDecoder = decoderFunc;
 
@@ -212,9 +381,18 @@ namespace r2::draw
 	template<typename T>
 	u64 CommandBucket<T>::MemorySize(u64 capacity)
 	{
+		return MemorySize(capacity, 0, 0);
+	}
+
+	template<typename T>
+	u64 CommandBucket<T>::MemorySize(u64 capacity, u32 numSubBuckets, u64 subBucketCapacity)
+	{
+		const u64 totalCapacity = capacity + numSubBuckets * subBucketCapacity;
+
 		return sizeof(CommandBucket<T>) +
 			r2::SArray<CommandBucket<T>::Entry>::MemorySize(capacity) +
-			r2::SArray<CommandBucket<T>::Entry*>::MemorySize(capacity);
+			r2::SArray<CommandBucket<T>::Entry*>::MemorySize(totalCapacity) * 2 + //sorted + radix sort scratch
+			r2::SArray<CommandBucket<T>::Entry>::MemorySize(subBucketCapacity) * numSubBuckets;
 	}
 
 }
@@ -8,6 +8,7 @@ namespace r2::draw::cmd
 	const r2::draw::dispatch::BackendDispatchFunction ClearBuffers::DispatchFunc = &r2::draw::dispatch::ClearBuffers;
 	const r2::draw::dispatch::BackendDispatchFunction DrawIndexed::DispatchFunc = &r2::draw::dispatch::DrawIndexed;
 	const r2::draw::dispatch::BackendDispatchFunction FillVertexBuffer::DispatchFunc = &r2::draw::dispatch::FillVertexBuffer;
+	const r2::draw::dispatch::BackendDispatchFunction FillQuantizedVertexBuffer::DispatchFunc = &r2::draw::dispatch::FillQuantizedVertexBuffer;
 	const r2::draw::dispatch::BackendDispatchFunction FillIndexBuffer::DispatchFunc = &r2::draw::dispatch::FillIndexBuffer;
 	const r2::draw::dispatch::BackendDispatchFunction CopyBuffer::DispatchFunc = &r2::draw::dispatch::CopyBuffer;
 	const r2::draw::dispatch::BackendDispatchFunction DeleteBuffer::DispatchFunc = &r2::draw::dispatch::DeleteBuffer;
@@ -32,6 +33,7 @@ namespace r2::draw::cmd
 			sizeof(r2::draw::cmd::ClearBuffers),
 			sizeof(r2::draw::cmd::DrawIndexed),
 			sizeof(r2::draw::cmd::FillVertexBuffer),
+			sizeof(r2::draw::cmd::FillQuantizedVertexBuffer),
 			sizeof(r2::draw::cmd::FillIndexBuffer),
 			sizeof(r2::draw::cmd::CopyBuffer),
 			sizeof(r2::draw::cmd::DeleteBuffer),
@@ -92,6 +92,21 @@ namespace r2::draw::cmd
 	};
 	static_assert(std::is_pod<FillVertexBuffer>::value == true, "FillVertexBuffer must be a POD.");
 
+	//Expands QuantizedVertex data to Vertex as it's written into the vertex buffer
+	struct FillQuantizedVertexBuffer
+	{
+		static const r2::draw::dispatch::BackendDispatchFunction DispatchFunc;
+
+		r2::draw::VertexBufferHandle vertexBufferHandle;
+
+		u64 offset;
+		u64 numVertices;
+		const void* data;
+		float positionScale[3];
+		float positionBias[3];
+	};
+	static_assert(std::is_pod<FillQuantizedVertexBuffer>::value == true, "FillQuantizedVertexBuffer must be a POD.");
+
 	struct FillIndexBuffer
 	{
 		static const r2::draw::dispatch::BackendDispatchFunction DispatchFunc;
@@ -0,0 +1,170 @@
+#include "r2pch.h"
+#include "r2/Render/Renderer/Culling.h"
+#include "r2/Render/Camera/Camera.h"
+
+namespace r2::draw::cull
+{
+	void BuildCullingVolumes(CullingVolumes& volumes, const Camera& camera, const SceneLighting& sceneLighting, bool enabled)
+	{
+		volumes.enabled = enabled;
+		volumes.numDirectionLights = 0;
+		volumes.numSpotLights = 0;
+		volumes.numPointLights = 0;
+
+		volumes.activePasses = VISIBLE_CAMERA;
+
+		if (sceneLighting.numShadowCastingDirectionLights > 0)
+		{
+			volumes.activePasses |= ShadowVisibilityBit(light::LT_DIRECTIONAL_LIGHT);
+		}
+
+		if (sceneLighting.numShadowCastingSpotLights > 0)
+		{
+			volumes.activePasses |= ShadowVisibilityBit(light::LT_SPOT_LIGHT);
+		}
+
+		if (sceneLighting.numShadowCastingPointLights > 0)
+		{
+			volumes.activePasses |= ShadowVisibilityBit(light::LT_POINT_LIGHT);
+		}
+
+		if (!enabled)
+		{
+			return;
+		}
+
+		math::ExtractFrustumPlanes(camera.vp, volumes.cameraFrustum);
+
+		for (s32 i = 0; i < sceneLighting.numShadowCastingDirectionLights; ++i)
+		{
+			const DirectionLight& dirLight = sceneLighting.mDirectionLights[sceneLighting.mShadowCastingDirectionLights[i]];
+
+			volumes.directionLightDirections[volumes.numDirectionLights++] = glm::normalize(glm::vec3(dirLight.direction));
+		}
+
+		for (s32 i = 0; i < sceneLighting.numShadowCastingSpotLights; ++i)
+		{
+			const SpotLight& spotLight = sceneLighting.mSpotLights[sceneLighting.mShadowCastingSpotLights[i]];
+
+			volumes.spotLightSpheres[volumes.numSpotLights] = glm::vec4(glm::vec3(spotLight.position), spotLight.lightProperties.intensity);
+			volumes.spotLightDirections[volumes.numSpotLights] = glm::vec4(glm::normalize(glm::vec3(spotLight.direction)), spotLight.direction.w);
+			++volumes.numSpotLights;
+		}
+
+		for (s32 i = 0; i < sceneLighting.numShadowCastingPointLights; ++i)
+		{
+			const PointLight& pointLight = sceneLighting.mPointLights[sceneLighting.mShadowCastingPointLights[i]];
+
+			volumes.pointLightSpheres[volumes.numPointLights++] = glm::vec4(glm::vec3(pointLight.position), pointLight.lightProperties.intensity);
+		}
+	}
+
+	bool SphereIntersectsSphere(const glm::vec4& sphere, const glm::vec3& center, float radius)
+	{
+		const glm::vec3 diff = glm::vec3(sphere) - center;
+		const float r = sphere.w + radius;
+
+		return glm::dot(diff, diff) <= r * r;
+	}
+
+	//Conservative sphere vs cone test. The cone's range is the radius of the sphere and its half angle is acos(cosAngle)
+	bool SphereIntersectsCone(const glm::vec4& coneSphere, const glm::vec4& coneDirection, const glm::vec3& center, float radius)
+	{
+		const glm::vec3 v = center - glm::vec3(coneSphere);
+		const float vLenSq = glm::dot(v, v);
+		const float v1Len = glm::dot(v, glm::vec3(coneDirection));
+
+		if (v1Len > coneSphere.w + radius || v1Len < -radius)
+		{
+			return false;
+		}
+
+		const float cosAngle = glm::clamp(coneDirection.w, -1.0f, 1.0f);
+		const float sinAngle = sqrtf(1.0f - cosAngle * cosAngle);
+		const float distanceToClosestPoint = cosAngle * sqrtf(glm::max(vLenSq - v1Len * v1Len, 0.0f)) - v1Len * sinAngle;
+
+		return distanceToClosestPoint <= radius;
+	}
+
+	VisibilityMask CullBounds(const CullingVolumes& volumes, const Bounds& meshBounds, const glm::mat4& modelMatrix)
+	{
+		//no bounds means we can't say anything about it so it's always visible
+		if (!volumes.enabled || meshBounds.radius <= 0.0f)
+		{
+			return volumes.activePasses;
+		}
+
+		VisibilityMask mask = VISIBLE_NONE;
+
+		const glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(meshBounds.origin, 1.0f));
+		const float radius = meshBounds.radius * math::MaxScale(modelMatrix);
+
+		if (math::SphereInFrustum(volumes.cameraFrustum, center, radius))
+		{
+			glm::vec3 worldCenter;
+			glm::vec3 worldHalfExtents;
+			math::TransformAABB(modelMatrix, meshBounds.origin, meshBounds.extents, worldCenter, worldHalfExtents);
+
+			if (math::AABBInFrustum(volumes.cameraFrustum, worldCenter, worldHalfExtents))
+			{
+				mask |= VISIBLE_CAMERA;
+			}
+		}
+
+		for (u32 i = 0; i < volumes.numDirectionLights; ++i)
+		{
+			if (math::SweptSphereInFrustum(volumes.cameraFrustum, center, radius, volumes.directionLightDirections[i]))
+			{
+				mask |= ShadowVisibilityBit(light::LT_DIRECTIONAL_LIGHT);
+				break;
+			}
+		}
+
+		for (u32 i = 0; i < volumes.numSpotLights; ++i)
+		{
+			if (SphereIntersectsCone(volumes.spotLightSpheres[i], volumes.spotLightDirections[i], center, radius))
+			{
+				mask |= ShadowVisibilityBit(light::LT_SPOT_LIGHT);
+				break;
+			}
+		}
+
+		for (u32 i = 0; i < volumes.numPointLights; ++i)
+		{
+			if (SphereIntersectsSphere(volumes.pointLightSpheres[i], center, radius))
+			{
+				mask |= ShadowVisibilityBit(light::LT_POINT_LIGHT);
+				break;
+			}
+		}
+
+		return mask & volumes.activePasses;
+	}
+
+	void ResetStats(CullingStats& stats)
+	{
+		stats = {};
+	}
+
+	void AddToStats(CullingStats& stats, VisibilityMask mask)
+	{
+		++stats.numMeshesTested;
+
+		if (mask == VISIBLE_NONE)
+		{
+			++stats.numMeshesFullyCulled;
+		}
+
+		for (u32 pass = 0; pass < NUM_CULL_PASSES; ++pass)
+		{
+			if (mask & (1 << pass))
+			{
+				++stats.numMeshesSubmitted[pass];
+			}
+			else
+			{
+				++stats.numMeshesCulled[pass];
+			}
+		}
+	}
+}
@@ -0,0 +1,85 @@
+#ifndef __CULLING_H__
+#define __CULLING_H__
+
+#include "r2/Utils/Utils.h"
+#include "r2/Core/Math/Frustum.h"
+#include "r2/Render/Model/Mesh.h"
+#include "r2/Render/Model/Light.h"
+
+namespace r2
+{
+	struct Camera;
+}
+
+namespace r2::draw::cull
+{
+	using VisibilityMask = u8;
+
+	//One bit for the camera and one bit per shadow casting light type (indexed by light::LightType)
+	constexpr VisibilityMask VISIBLE_NONE = 0;
+	constexpr VisibilityMask VISIBLE_CAMERA = 1 << 0;
+
+	constexpr VisibilityMask ShadowVisibilityBit(light::LightType lightType)
+	{
+		return static_cast<VisibilityMask>(1 << (lightType + 1));
+	}
+
+	constexpr VisibilityMask VISIBLE_ALL = VISIBLE_CAMERA |
+		ShadowVisibilityBit(light::LT_DIRECTIONAL_LIGHT) |
+		ShadowVisibilityBit(light::LT_SPOT_LIGHT) |
+		ShadowVisibilityBit(light::LT_POINT_LIGHT);
+
+	enum CullPass : u32
+	{
+		CULL_PASS_CAMERA = 0,
+		CULL_PASS_DIRECTION_LIGHT_SHADOWS,
+		CULL_PASS_SPOT_LIGHT_SHADOWS,
+		CULL_PASS_POINT_LIGHT_SHADOWS,
+		NUM_CULL_PASSES
+	};
+
+	struct CullingStats
+	{
+		u32 numMeshesTested = 0;
+		u32 numMeshesFullyCulled = 0;
+		u32 numMeshesSubmitted[NUM_CULL_PASSES] = {};
+		u32 numMeshesCulled[NUM_CULL_PASSES] = {};
+	};
+
+	//Everything we need to cull a frame. Built once per frame in PreRender from the camera and the scene lighting.
+	struct CullingVolumes
+	{
+		math::Frustum cameraFrustum;
+
+		//@NOTE(Serge): the cascade matrices are computed on the GPU (SDSM) so on the CPU we use the camera frustum 
+		//				extruded along the light direction which contains all of the cascades
+		glm::vec3 directionLightDirections[light::MAX_NUM_SHADOW_MAP_PAGES];
+		u32 numDirectionLights = 0;
+
+		//xyz - position, w - radius (the shadow far plane)
+		glm::vec4 spotLightSpheres[light::MAX_NUM_SHADOW_MAP_PAGES];
+		//xyz - direction, w - cosine of the outer cutoff
+		glm::vec4 spotLightDirections[light::MAX_NUM_SHADOW_MAP_PAGES];
+		u32 numSpotLights = 0;
+
+		//xyz - position, w - radius (the shadow far plane)
+		glm::vec4 pointLightSpheres[light::MAX_NUM_SHADOW_MAP_PAGES];
+		u32 numPointLights = 0;
+
+		//The passes that will actually draw this frame - the camera plus the light types that have at least one shadow caster.
+		//Meshes are never marked visible in the other passes, even when culling is disabled.
+		VisibilityMask activePasses = VISIBLE_ALL;
+
+		b32 enabled = true;
+	};
+
+	void BuildCullingVolumes(CullingVolumes& volumes, const Camera& camera, const SceneLighting& sceneLighting, bool enabled);
+
+	//Returns which passes the mesh (in model space) transformed by modelMatrix is visible in
+	VisibilityMask CullBounds(const CullingVolumes& volumes, const Bounds& meshBounds, const glm::mat4& modelMatrix);
+
+	void ResetStats(CullingStats& stats);
+	void AddToStats(CullingStats& stats, VisibilityMask mask);
+}
+
+#endif // __CULLING_H__
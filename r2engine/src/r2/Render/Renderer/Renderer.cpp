@@ -34,6 +34,8 @@
 namespace
 {
 	const u32 MAX_NUM_DRAWS = 2 << 15;
+	//Each mesh can be written once for the camera and once per shadow casting light type
+	const u32 MAX_NUM_SUB_COMMANDS = MAX_NUM_DRAWS * (1 + r2::draw::light::NUM_LIGHT_TYPES);
 	
 	const u32 AVG_NUM_OF_MESHES_PER_MODEL = 64;
 	const u32 MAX_NUMBER_OF_MODELS_LOADED_AT_ONE_TIME = 1024;
@@ -49,8 +51,10 @@ namespace
 	const u32 REDUCE_TILE_DIM = 128;
 	const float DILATION_FACTOR = 10.0f / float(r2::draw::light::SHADOW_MAP_SIZE);
 	const float EDGE_SOFTENING_AMOUNT = 0.02f;
+	const float MESH_LOD_MAX_PIXEL_ERROR = 1.0f;
 	const u32 STATIC_MODELS_VERTEX_LAYOUT_SIZE = Megabytes(16);
 	const u32 ANIM_MODELS_VERTEX_LAYOUT_SIZE = Megabytes(16);
+	const u32 QUANTIZED_STATIC_MODELS_VERTEX_LAYOUT_SIZE = Megabytes(8);
 
 	const u32 MAX_NUM_CONSTANT_BUFFERS = 16; //?
 	const u32 MAX_NUM_CONSTANT_BUFFER_LOCKS = MAX_NUM_DRAWS;
@@ -473,6 +477,10 @@ namespace r2::draw::renderer
 	void SetColorGradingContribution(Renderer& renderer, float contribution);
 	float GetColorGradingContribution(Renderer& renderer);
 
+	void SetCPUCullingEnabled(Renderer& renderer, bool enabled);
+	bool IsCPUCullingEnabled(Renderer& renderer);
+	const cull::CullingStats& GetCullingStats(Renderer& renderer);
+
 	//Camera and Lighting
 	void SetRenderCamera(Renderer& renderer, Camera* cameraPtr);
 	Camera* GetRenderCamera(Renderer& renderer);
@@ -642,6 +650,7 @@ namespace r2::draw::renderer
 
 	vb::VertexBufferLayoutHandle AddStaticModelLayout(Renderer& renderer, const std::initializer_list<u64>& vertexLayoutSizes, u64 indexSize);
 	vb::VertexBufferLayoutHandle AddAnimatedModelLayout(Renderer& renderer, const std::initializer_list<u64>& vertexLayoutSizes, u64 indexSize);
+	vb::VertexBufferLayoutHandle AddQuantizedStaticModelLayout(Renderer& renderer, const std::initializer_list<u64>& vertexLayoutSizes, u64 indexSize);
 
 	ConstantConfigHandle AddConstantBufferLayout(Renderer& renderer, ConstantBufferLayout::Type type, const std::initializer_list<ConstantBufferElement>& elements);
 	ConstantConfigHandle AddModelsLayout(Renderer& renderer, ConstantBufferLayout::Type type);
@@ -657,7 +666,7 @@ namespace r2::draw::renderer
 	ConstantConfigHandle AddDispatchComputeIndirectLayout(Renderer& renderer);
 	ConstantConfigHandle AddMeshDataLayout(Renderer& renderer);
 
-	void InitializeVertexLayouts(Renderer& renderer, u32 staticVertexLayoutSizeInBytes, u32 animVertexLayoutSizeInBytes);
+	void InitializeVertexLayouts(Renderer& renderer, u32 staticVertexLayoutSizeInBytes, u32 animVertexLayoutSizeInBytes, u32 quantizedStaticVertexLayoutSizeInBytes);
 	bool GenerateConstantBuffers(Renderer& renderer, const r2::SArray<ConstantBufferLayoutConfiguration>* constantBufferConfigs);
 
 	template <class T>
@@ -1231,7 +1240,7 @@ namespace r2::draw::renderer
 
 		R2_CHECK(loadedModels, "We didn't load the models for the engine!");
 
-		InitializeVertexLayouts(*newRenderer, STATIC_MODELS_VERTEX_LAYOUT_SIZE, ANIM_MODELS_VERTEX_LAYOUT_SIZE);
+		InitializeVertexLayouts(*newRenderer, STATIC_MODELS_VERTEX_LAYOUT_SIZE, ANIM_MODELS_VERTEX_LAYOUT_SIZE, QUANTIZED_STATIC_MODELS_VERTEX_LAYOUT_SIZE);
 
 		
 		GameAssetManager& gameAssetManager = CENG.GetGameAssetManager();
@@ -1505,26 +1514,26 @@ namespace r2::draw::renderer
 		//}
 
 		//printf("================================================\n");
-		cmdbkt::Sort(*renderer.mDepthPrePassBucket, key::CompareDepthKey);
-		cmdbkt::Sort(*renderer.mDepthPrePassShadowBucket, key::CompareDepthKey);
-		cmdbkt::Sort(*renderer.mClustersBucket, key::CompareBasicKey);
-		cmdbkt::Sort(*renderer.mAmbientOcclusionBucket, key::CompareDepthKey);
-		cmdbkt::Sort(*renderer.mAmbientOcclusionDenoiseBucket, key::CompareDepthKey);
-		cmdbkt::Sort(*renderer.mAmbientOcclusionTemporalDenoiseBucket, key::CompareDepthKey);
-		cmdbkt::Sort(*renderer.mPreRenderBucket, r2::draw::key::CompareBasicKey);
-		cmdbkt::Sort(*renderer.mShadowBucket, key::CompareShadowKey);
-		cmdbkt::Sort(*renderer.mCommandBucket, r2::draw::key::CompareBasicKey);
-		cmdbkt::Sort(*renderer.mTransparentBucket, r2::draw::key::CompareBasicKey);
-		cmdbkt::Sort(*renderer.mSSRBucket, r2::draw::key::CompareBasicKey);
+		cmdbkt::Sort(*renderer.mDepthPrePassBucket);
+		cmdbkt::Sort(*renderer.mDepthPrePassShadowBucket);
+		cmdbkt::Sort(*renderer.mClustersBucket);
+		cmdbkt::Sort(*renderer.mAmbientOcclusionBucket);
+		cmdbkt::Sort(*renderer.mAmbientOcclusionDenoiseBucket);
+		cmdbkt::Sort(*renderer.mAmbientOcclusionTemporalDenoiseBucket);
+		cmdbkt::Sort(*renderer.mPreRenderBucket);
+		cmdbkt::Sort(*renderer.mShadowBucket);
+		cmdbkt::Sort(*renderer.mCommandBucket);
+		cmdbkt::Sort(*renderer.mTransparentBucket);
+		cmdbkt::Sort(*renderer.mSSRBucket);
 #ifdef R2_EDITOR
-		cmdbkt::Sort(*renderer.mEditorPickingBucket, r2::draw::key::CompareBasicKey);
+		cmdbkt::Sort(*renderer.mEditorPickingBucket);
 #endif
-		cmdbkt::Sort(*renderer.mFinalBucket, r2::draw::key::CompareBasicKey);
-		cmdbkt::Sort(*renderer.mPostRenderBucket, r2::draw::key::CompareBasicKey);
+		cmdbkt::Sort(*renderer.mFinalBucket);
+		cmdbkt::Sort(*renderer.mPostRenderBucket);
 #ifdef R2_DEBUG
-		cmdbkt::Sort(*renderer.mPreDebugCommandBucket, r2::draw::key::CompareDebugKey);
-		cmdbkt::Sort(*renderer.mDebugCommandBucket, r2::draw::key::CompareDebugKey);
-		cmdbkt::Sort(*renderer.mPostDebugCommandBucket, r2::draw::key::CompareDebugKey);
+		cmdbkt::Sort(*renderer.mPreDebugCommandBucket);
+		cmdbkt::Sort(*renderer.mDebugCommandBucket);
+		cmdbkt::Sort(*renderer.mPostDebugCommandBucket);
 #endif
 		//for (u64 i = 0; i < numEntries; ++i)
 		//{
@@ -1786,10 +1795,11 @@ namespace r2::draw::renderer
 		rendererimpl::SetDepthClearColor(color);
 	}
 
-	void InitializeVertexLayouts(Renderer& renderer, u32 staticModelLayoutSize, u32 animatedModelLayoutSize)
+	void InitializeVertexLayouts(Renderer& renderer, u32 staticModelLayoutSize, u32 animatedModelLayoutSize, u32 quantizedStaticModelLayoutSize)
 	{
 		AddStaticModelLayout(renderer, { staticModelLayoutSize }, staticModelLayoutSize);
 		AddAnimatedModelLayout(renderer, { animatedModelLayoutSize, animatedModelLayoutSize }, animatedModelLayoutSize);
+		AddQuantizedStaticModelLayout(renderer, { quantizedStaticModelLayoutSize }, quantizedStaticModelLayoutSize);
 
 		renderer.mVPMatricesConfigHandle = AddConstantBufferLayout(renderer, r2::draw::ConstantBufferLayout::Type::Small, {
 			{r2::draw::ShaderDataType::Mat4, "projection"},
@@ -2198,6 +2208,60 @@ namespace r2::draw::renderer
 
 		return renderer.mAnimVertexModelConfigHandle;
 	}
+
+	vb::VertexBufferLayoutHandle AddQuantizedStaticModelLayout(Renderer& renderer, const std::initializer_list<u64>& vertexLayoutSizes, u64 indexSize)
+	{
+		if (renderer.mVertexBufferLayoutSystem == nullptr)
+		{
+			R2_CHECK(false, "We haven't initialized the renderer yet!");
+			return vb::InvalidVertexBufferLayoutHandle;
+		}
+
+		auto numVertexLayouts = vertexLayoutSizes.size();
+		r2::draw::BufferLayoutConfiguration layoutConfig;
+
+		//@NOTE(Serge): matches r2::draw::QuantizedVertex - same attribute locations as the static layout so the static shaders can read both
+		layoutConfig.layout = BufferLayout(
+			{
+				{r2::draw::ShaderDataType::UShort4, "aPos", 0, true},
+				{r2::draw::ShaderDataType::Short2, "aNormal", 0, true},
+				{r2::draw::ShaderDataType::Short2, "aTangent", 0, true},
+				{r2::draw::ShaderDataType::Half4, "aTexCoord0"},
+				{r2::draw::ShaderDataType::Half4, "aTexCoord1"},
+			}
+		);
+
+		R2_CHECK(layoutConfig.layout.GetStride(0) == sizeof(r2::draw::QuantizedVertex), "Layout doesn't match QuantizedVertex!");
+
+		size_t i = 0;
+		for (u64 layoutSize : vertexLayoutSizes)
+		{
+			layoutConfig.vertexBufferConfigs[i] =
+			{
+				(u32)layoutSize,
+				r2::draw::VertexDrawTypeStatic
+			};
+			++i;
+		}
+
+		layoutConfig.indexBufferConfig =
+		{
+			(u32)indexSize,
+			r2::draw::VertexDrawTypeStatic
+		};
+
+		layoutConfig.useDrawIDs = true;
+		layoutConfig.maxDrawCount = MAX_NUM_DRAWS;
+		layoutConfig.numVertexConfigs = numVertexLayouts;
+
+		vb::VertexBufferLayoutHandle quantizedStaticVertexModelHandle = vbsys::AddVertexBufferLayout(*renderer.mVertexBufferLayoutSystem, layoutConfig);
+
+		r2::sarr::Push(*renderer.mVertexBufferLayoutHandles, quantizedStaticVertexModelHandle);
+
+		renderer.mQuantizedStaticVertexModelConfigHandle = quantizedStaticVertexModelHandle;
+
+		return renderer.mQuantizedStaticVertexModelConfigHandle;
+	}
 #ifdef R2_DEBUG
 	vb::VertexBufferLayoutHandle AddDebugDrawLayout(Renderer& renderer)
 	{
@@ -2343,7 +2407,7 @@ namespace r2::draw::renderer
 			r2::draw::VertexDrawTypeDynamic
 		};
 
-		subCommands.layout.InitForSubCommands(r2::draw::CB_FLAG_WRITE | r2::draw::CB_FLAG_MAP_PERSISTENT | CB_FLAG_MAP_COHERENT, r2::draw::CB_CREATE_FLAG_DYNAMIC_STORAGE, MAX_NUM_DRAWS);
+		subCommands.layout.InitForSubCommands(r2::draw::CB_FLAG_WRITE | r2::draw::CB_FLAG_MAP_PERSISTENT | CB_FLAG_MAP_COHERENT, r2::draw::CB_CREATE_FLAG_DYNAMIC_STORAGE, MAX_NUM_SUB_COMMANDS);
 
 		r2::sarr::Push(*renderer.mConstantLayouts, subCommands);
 
@@ -2639,7 +2703,7 @@ namespace r2::draw::renderer
 			r2::draw::VertexDrawTypeDynamic
 		};
 
-		meshData.layout.InitForMeshData(r2::draw::CB_FLAG_WRITE | r2::draw::CB_FLAG_MAP_PERSISTENT | CB_FLAG_MAP_COHERENT, r2::draw::CB_CREATE_FLAG_DYNAMIC_STORAGE, sizeof(glm::mat4)*2, MAX_NUM_DRAWS);
+		meshData.layout.InitForMeshData(r2::draw::CB_FLAG_WRITE | r2::draw::CB_FLAG_MAP_PERSISTENT | CB_FLAG_MAP_COHERENT, r2::draw::CB_CREATE_FLAG_DYNAMIC_STORAGE, sizeof(MeshRenderData), MAX_NUM_DRAWS);
 
 		r2::sarr::Push(*renderer.mConstantLayouts, meshData);
 
@@ -2890,6 +2954,22 @@ namespace r2::draw::renderer
 	//	r2::sarr::Push(*s_optrRenderer->mEngineModelRefs, GetDefaultModelRef(QUAD));
 	}
 
+	vb::VertexBufferLayoutHandle GetVertexModelConfigHandle(const Renderer& renderer, const Model& model)
+	{
+		if (model.optrBoneData != nullptr)
+		{
+			//@NOTE(Serge): the skinned shaders don't dequantize yet so quantized animated models get expanded on upload
+			return renderer.mAnimVertexModelConfigHandle;
+		}
+
+		if (model.hasQuantizedVertices)
+		{
+			return renderer.mQuantizedStaticVertexModelConfigHandle;
+		}
+
+		return renderer.mStaticVertexModelConfigHandle;
+	}
+
 	vb::GPUModelRefHandle UploadModel(Renderer& renderer, const Model* model)
 	{
 		if (!renderer.mVertexBufferLayoutSystem || !renderer.mVertexBufferLayoutHandles)
@@ -2905,12 +2985,7 @@ namespace r2::draw::renderer
 			return cachedHandle;
 		}
 
-		vb::VertexBufferLayoutHandle configHandleToUse = renderer.mStaticVertexModelConfigHandle;
-
-		if (model->optrBoneData > 0)
-		{
-			configHandleToUse = renderer.mAnimVertexModelConfigHandle;
-		}
+		vb::VertexBufferLayoutHandle configHandleToUse = GetVertexModelConfigHandle(renderer, *model);
 
 		vb::GPUModelRefHandle result = vbsys::UploadModelToVertexBuffer(*renderer.mVertexBufferLayoutSystem, configHandleToUse, *model, renderer.mPreRenderBucket, renderer.mPrePostRenderCommandArena);
 
@@ -2970,13 +3045,15 @@ namespace r2::draw::renderer
 
 		const auto startingModelRefOffset = r2::sarr::Size(modelRefs);
 
-		vb::VertexBufferLayoutHandle configHandleToUse = renderer.mStaticVertexModelConfigHandle;
-		if (isAnimated)
+		//static models can be split between the full precision and quantized layouts
+		const auto numModels = r2::sarr::Size(models);
+
+		for (u32 i = 0; i < numModels; ++i)
 		{
-			configHandleToUse = renderer.mAnimVertexModelConfigHandle;
-		}
+			const Model* model = r2::sarr::At(models, i);
 
-		vbsys::UploadAllModels(*renderer.mVertexBufferLayoutSystem, configHandleToUse, models, modelRefs, renderer.mPreRenderBucket, renderer.mPrePostRenderCommandArena);
+			r2::sarr::Push(modelRefs, vbsys::UploadModelToVertexBuffer(*renderer.mVertexBufferLayoutSystem, GetVertexModelConfigHandle(renderer, *model), *model, renderer.mPreRenderBucket, renderer.mPrePostRenderCommandArena));
+		}
 		
 		const auto numModelRefs = r2::sarr::Size(modelRefs);
 
@@ -3198,12 +3275,35 @@ namespace r2::draw::renderer
 
 	}
 
-	void UpdateSceneLighting(Renderer& renderer, const r2::draw::LightSystem& lightSystem)
+	template<typename T>
+	void AddFillSceneLightsCommand(Renderer& renderer, ConstantBufferHandle lightBufferHandle, const T* lights, const LightDirtyRanges& dirtyRanges, s32 numLights, u64 lightsOffset)
 	{
+		LightUploadRange uploadRanges[light::MAX_NUM_LIGHT_DIRTY_RANGES];
+		const u32 numUploadRanges = lightsys::GetLightUploadRanges(dirtyRanges, numLights, sizeof(T), lightsOffset, uploadRanges);
 
+		for (u32 i = 0; i < numUploadRanges; ++i)
+		{
+			const byte* lightData = reinterpret_cast<const byte*>(lights) + (uploadRanges[i].offset - lightsOffset);
+			AddFillConstantBufferCommandFull(renderer, lightBufferHandle, lightData, uploadRanges[i].size, uploadRanges[i].offset);
+		}
+	}
+
+	void UpdateSceneLighting(Renderer& renderer, const r2::draw::LightSystem& lightSystem)
+	{
 		ConstantBufferHandle lightBufferHandle = r2::sarr::At(*renderer.mConstantBufferHandles, renderer.mLightingConfigHandle);
 
-		AddFillConstantBufferCommandFull(renderer, lightBufferHandle, &lightSystem.mSceneLighting, sizeof(lightSystem.mSceneLighting), 0);
+		const SceneLighting& sceneLighting = lightSystem.mSceneLighting;
+		const SceneLightMetaData& metaData = lightSystem.mMetaData;
+
+		//@NOTE(Serge): SceneLighting is megabytes because of the light arrays so we only upload the lights that changed.
+		//				This relies on the shader's Lighting buffer having the same layout as SceneLighting
+		AddFillSceneLightsCommand(renderer, lightBufferHandle, sceneLighting.mPointLights, metaData.mPointLightsDirtyRanges, sceneLighting.mNumPointLights, offsetof(SceneLighting, mPointLights));
+		AddFillSceneLightsCommand(renderer, lightBufferHandle, sceneLighting.mDirectionLights, metaData.mDirectionLightsDirtyRanges, sceneLighting.mNumDirectionLights, offsetof(SceneLighting, mDirectionLights));
+		AddFillSceneLightsCommand(renderer, lightBufferHandle, sceneLighting.mSpotLights, metaData.mSpotLightsDirtyRanges, sceneLighting.mNumSpotLights, offsetof(SceneLighting, mSpotLights));
+
+		//Everything after the light arrays is small (the sky light, the light counts and the shadow casting lights) so always upload all of it
+		constexpr u64 skyLightOffset = offsetof(SceneLighting, mSkyLight);
+		AddFillConstantBufferCommandFull(renderer, lightBufferHandle, &sceneLighting.mSkyLight, sizeof(SceneLighting) - skyLightOffset, skyLightOffset);
 	}
 
 	template<class ARENA, typename T>
@@ -3246,10 +3346,78 @@ namespace r2::draw::renderer
 		ShaderEffectPasses shaderEffectPasses;
 		cmd::DrawState drawState;
 		b32 isDynamic = false;
+		b32 isQuantized = false;
 		r2::SArray<cmd::DrawBatchSubCommand>* subCommands = nullptr;
 		r2::SArray<CameraDepth>* cameraDepths = nullptr;
+		r2::SArray<cull::VisibilityMask>* visibilityMasks = nullptr; //parallel to subCommands
+		u32 numCameraSubCommands = 0;
+		u32 numShadowSubCommands[light::NUM_LIGHT_TYPES] = {};
 	};
 
+	bool IsCullableDrawLayer(DrawLayer layer)
+	{
+		return layer == DL_WORLD || layer == DL_CHARACTER || layer == DL_TRANSPARENT;
+	}
+
+	//Picks the coarsest LOD whose error stays under MESH_LOD_MAX_PIXEL_ERROR pixels for the closest instance of the mesh
+	u32 SelectMeshLOD(const Renderer& renderer, const vb::MeshEntry& meshEntry, const r2::SArray<glm::mat4>& models, u32 firstInstance, u32 numInstances)
+	{
+		if (meshEntry.numLODs <= 1 || renderer.mnoptrRenderCam == nullptr || renderer.mResolutionSize.height == 0)
+		{
+			return 0;
+		}
+
+		const Camera& camera = *renderer.mnoptrRenderCam;
+		const bool isOrthographic = camera.proj[3][3] == 1.0f;
+
+		//proj[1][1] takes us to NDC, then half the screen height takes us to pixels
+		const float pixelsPerUnitAtDistance1 = 0.5f * static_cast<float>(renderer.mResolutionSize.height) * camera.proj[1][1];
+
+		float maxPixelsPerUnit = 0.0f;
+
+		for (u32 i = 0; i < numInstances; ++i)
+		{
+			const glm::mat4& instanceMatrix = r2::sarr::At(models, firstInstance + i);
+
+			const glm::vec3 axisX = glm::vec3(instanceMatrix[0]);
+			const glm::vec3 axisY = glm::vec3(instanceMatrix[1]);
+			const glm::vec3 axisZ = glm::vec3(instanceMatrix[2]);
+			const float scale = glm::sqrt(glm::max(glm::dot(axisX, axisX), glm::max(glm::dot(axisY, axisY), glm::dot(axisZ, axisZ))));
+
+			float pixelsPerUnit = pixelsPerUnitAtDistance1 * scale;
+
+			if (!isOrthographic)
+			{
+				const glm::vec3 center = glm::vec3(instanceMatrix * glm::vec4(meshEntry.meshBounds.origin, 1.0f));
+				const float distance = glm::length(center - camera.position) - meshEntry.meshBounds.radius * scale;
+
+				if (distance <= 0.0f)
+				{
+					//we're inside of the bounds
+					return 0;
+				}
+
+				pixelsPerUnit /= distance;
+			}
+
+			maxPixelsPerUnit = glm::max(maxPixelsPerUnit, pixelsPerUnit);
+		}
+
+		u32 lod = 0;
+
+		for (u32 i = 1; i < meshEntry.numLODs; ++i)
+		{
+			if (meshEntry.lods[i].error * maxPixelsPerUnit > MESH_LOD_MAX_PIXEL_ERROR)
+			{
+				break;
+			}
+
+			lod = i;
+		}
+
+		return lod;
+	}
+
 
 
 	void PopulateRenderDataFromRenderBatch(
@@ -3273,6 +3441,12 @@ namespace r2::draw::renderer
 			const cmd::DrawState& drawState = r2::sarr::At(*renderBatch.drawState, modelIndex);
 			u32 drawStateHash = utils::HashBytes32(&drawState, sizeof(drawState));
 
+			//@NOTE(Serge): quantized models are in a different vertex buffer layout so they can't share a batch with the full precision ones
+			if (modelRef->isQuantized)
+			{
+				drawStateHash = utils::HashBytes32(&drawStateHash, sizeof(drawStateHash));
+			}
+
 			const glm::mat4& modelMatrix = r2::sarr::At(*renderBatch.models, modelIndex);
 			const u32 numMeshRefs = r2::sarr::Size(*modelRef->meshEntries);
 			const u32 numInstances = r2::sarr::At(*renderBatch.numInstances, modelIndex);
@@ -3282,6 +3456,8 @@ namespace r2::draw::renderer
 			//@TODO(Serge): somehow make this fast for each mesh - dunno how to do that right now
 			u32 cameraDepthToModel = GetCameraDepth(renderer, {}, modelMatrix);
 
+			const bool cullable = IsCullableDrawLayer(drawState.layer);
+
 			u32 entityID = 0;
 			EntityInstanceBatchOffset entityInstanceBatchOffset;
 #ifdef R2_EDITOR
@@ -3320,6 +3496,27 @@ namespace r2::draw::renderer
 			for (u32 meshRefIndex = 0; meshRefIndex < numMeshRefs; ++meshRefIndex)
 			{
 				const vb::MeshEntry& meshRef = r2::sarr::At(*modelRef->meshEntries, meshRefIndex);
+
+				//The mesh is kept for a pass if any of its instances are visible in that pass
+				cull::VisibilityMask visibilityMask = renderer.mCullingVolumes.activePasses;
+
+				if (cullable)
+				{
+					visibilityMask = cull::VISIBLE_NONE;
+
+					for (u32 i = 0; i < numInstances && visibilityMask != renderer.mCullingVolumes.activePasses; ++i)
+					{
+						const glm::mat4& instanceMatrix = r2::sarr::At(*renderBatch.models, numModelInstances + i);
+						visibilityMask |= cull::CullBounds(renderer.mCullingVolumes, meshRef.meshBounds, instanceMatrix);
+					}
+				}
+
+				cull::AddToStats(renderer.mCullingStats, visibilityMask);
+
+				if (visibilityMask == cull::VISIBLE_NONE)
+				{
+					continue;
+				}
 				
 				const ShaderEffectPasses& shaderEffectPasses = r2::sarr::At(*renderBatch.materialBatch.shaderEffectPasses, meshRef.materialIndex + materialBatchInfo.start); 
 
@@ -3369,10 +3566,12 @@ namespace r2::draw::renderer
 
 					drawCommandData->shaderEffectPasses = shaderEffectPasses;
 					drawCommandData->isDynamic = modelRef->isAnimated;
+					drawCommandData->isQuantized = modelRef->isQuantized;
 					drawCommandData->drawState = drawState;
 					drawCommandData->drawState.layer = drawLayerToUse;
 					drawCommandData->subCommands = MAKE_SARRAY(*renderer.mPreRenderStackArena, cmd::DrawBatchSubCommand, drawCommandBatchSize);
 					drawCommandData->cameraDepths = MAKE_SARRAY(*renderer.mPrePostRenderCommandArena, CameraDepth, drawCommandBatchSize);
+					drawCommandData->visibilityMasks = MAKE_SARRAY(*renderer.mPreRenderStackArena, cull::VisibilityMask, drawCommandBatchSize);
 					
 					r2::sarr::Push(*tempAllocations, (void*)drawCommandData->cameraDepths);
 					r2::sarr::Push(*tempAllocations, (void*)drawCommandData->subCommands);
@@ -3382,15 +3581,32 @@ namespace r2::draw::renderer
 
 				R2_CHECK(drawCommandData != nullptr, "This shouldn't be nullptr!");
 
+				//@NOTE(Serge): the shadow passes use the same LOD as the camera
+				const u32 lodIndex = cullable ? SelectMeshLOD(renderer, meshRef, *renderBatch.models, numModelInstances, numInstances) : 0;
+				const MeshLOD& meshLOD = meshRef.lods[lodIndex];
+
 				r2::draw::cmd::DrawBatchSubCommand subCommand;
 				subCommand.baseInstance = baseInstanceOffset + numModelInstances;
 				subCommand.baseVertex = meshRef.gpuVertexEntry.start;
-				subCommand.firstIndex = meshRef.gpuIndexEntry.start;
+				subCommand.firstIndex = meshRef.gpuIndexEntry.start + meshLOD.firstIndex;
 				subCommand.instanceCount = numInstances;
-				subCommand.count = meshRef.gpuIndexEntry.size;
+				subCommand.count = meshLOD.numIndices;
 
 				r2::sarr::Push(*drawCommandData->subCommands, subCommand);
+				r2::sarr::Push(*drawCommandData->visibilityMasks, visibilityMask);
+
+				if (visibilityMask & cull::VISIBLE_CAMERA)
+				{
+					++drawCommandData->numCameraSubCommands;
+				}
 
+				for (u32 lightType = 0; lightType < light::NUM_LIGHT_TYPES; ++lightType)
+				{
+					if (visibilityMask & cull::ShadowVisibilityBit(static_cast<light::LightType>(lightType)))
+					{
+						++drawCommandData->numShadowSubCommands[lightType];
+					}
+				}
 
 				CameraDepth cameraDepth;
 				cameraDepth.cameraDepth = cameraDepthToModel;
@@ -3403,9 +3619,51 @@ namespace r2::draw::renderer
 		}
 	}
 
+	u32 PopulateRenderData(Renderer& renderer, const RenderBatch& renderBatch, const SceneLighting& sceneLighting)
+	{
+		R2_CHECK(renderer.mnoptrRenderCam != nullptr, "We need a camera to cull and sort against");
+
+		const u64 numModels = r2::sarr::Size(*renderBatch.gpuModelRefs);
+
+		u64 drawCommandBatchSize = 0;
+		u32 numInstances = 0;
+
+		for (u64 i = 0; i < numModels; ++i)
+		{
+			drawCommandBatchSize += r2::sarr::Size(*r2::sarr::At(*renderBatch.gpuModelRefs, i)->meshEntries);
+			numInstances += r2::sarr::At(*renderBatch.numInstances, i);
+		}
+
+		r2::SArray<void*>* tempAllocations = MAKE_SARRAY(*renderer.mPreRenderStackArena, void*, 100 + numModels);
+		r2::SArray<glm::uvec4>* materialOffsetsPerObject = MAKE_SARRAY(*renderer.mPreRenderStackArena, glm::uvec4, std::max(numInstances, 1u));
+		r2::SHashMap<DrawCommandData*>* shaderDrawCommandData = MAKE_SHASHMAP(*renderer.mPreRenderStackArena, DrawCommandData*, std::max<u64>(drawCommandBatchSize, 1) * r2::SHashMap<DrawCommandData>::LoadFactorMultiplier());
+
+		cull::ResetStats(renderer.mCullingStats);
+		cull::BuildCullingVolumes(renderer.mCullingVolumes, *renderer.mnoptrRenderCam, sceneLighting, renderer.mCPUCullingEnabled);
+
+		u32 materialOffset = 0;
+		u32 meshOffset = 0;
+		PopulateRenderDataFromRenderBatch(renderer, tempAllocations, renderBatch, shaderDrawCommandData, renderer.mRenderMaterialsToRender, materialOffsetsPerObject, materialOffset, 0, drawCommandBatchSize, meshOffset);
+
+		u32 numSubCommands = 0;
+
+		for (auto iter = r2::shashmap::Begin(*shaderDrawCommandData); iter != r2::shashmap::End(*shaderDrawCommandData); ++iter)
+		{
+			if (iter->value != nullptr)
+			{
+				numSubCommands += static_cast<u32>(r2::sarr::Size(*iter->value->subCommands));
+			}
+		}
+
+		RESET_ARENA(*renderer.mPreRenderStackArena);
+		RESET_ARENA(*renderer.mPrePostRenderCommandArena);
+
+		return numSubCommands;
+	}
+
 	void PreRender(Renderer& renderer)
 	{
-	//	PROFILE_SCOPE("PreRender");
+		PROFILE_SCOPE("PreRender");
 		//PreRender should be setting up the batches to render
 		static int MAX_NUM_GEOMETRY_SHADER_INVOCATIONS = shader::GetMaxNumberOfGeometryShaderInvocations();
 		const s32 numDirectionLights = renderer.mLightSystem->mSceneLighting.mNumDirectionLights;
@@ -3420,6 +3678,7 @@ namespace r2::draw::renderer
 
 		BufferLayoutHandle animVertexBufferLayoutHandle = vbsys::GetBufferLayoutHandle(*renderer.mVertexBufferLayoutSystem, r2::sarr::At(*renderer.mVertexBufferLayoutHandles, VBL_ANIMATED));
 		BufferLayoutHandle staticVertexBufferLayoutHandle = vbsys::GetBufferLayoutHandle(*renderer.mVertexBufferLayoutSystem, r2::sarr::At(*renderer.mVertexBufferLayoutHandles, VBL_STATIC));
+		BufferLayoutHandle quantizedStaticVertexBufferLayoutHandle = vbsys::GetBufferLayoutHandle(*renderer.mVertexBufferLayoutSystem, r2::sarr::At(*renderer.mVertexBufferLayoutHandles, VBL_STATIC_QUANTIZED));
 		BufferLayoutHandle finalBatchVertexBufferLayoutHandle = vbsys::GetBufferLayoutHandle(*renderer.mVertexBufferLayoutSystem, r2::sarr::At(*renderer.mVertexBufferLayoutHandles, VBL_FINAL));
 
 		const RenderBatch& staticRenderBatch = r2::sarr::At(*renderer.mRenderBatches, DrawType::STATIC);
@@ -3506,6 +3765,9 @@ namespace r2::draw::renderer
 
 		r2::sarr::Push(*tempAllocations, (void*)shaderDrawCommandData);
 
+		cull::ResetStats(renderer.mCullingStats);
+		cull::BuildCullingVolumes(renderer.mCullingVolumes, *renderer.mnoptrRenderCam, renderer.mLightSystem->mSceneLighting, renderer.mCPUCullingEnabled);
+
 		u32 materialOffset = 0;
 		u32 meshOffset = 0;
 		PopulateRenderDataFromRenderBatch(renderer, tempAllocations, dynamicRenderBatch, shaderDrawCommandData, renderMaterials, materialOffsetsPerObject, materialOffset, 0, dynamicDrawCommandBatchSize, meshOffset);
@@ -3692,7 +3954,25 @@ namespace r2::draw::renderer
 
 		cmd::FillConstantBuffer* subCommandsCMD = nullptr;
 
-		const u64 subCommandsMemorySize = sizeof(cmd::DrawBatchSubCommand) * (totalSubCommands + 1); //+ 1 for final batch
+		//Each batch writes its camera visible range followed by one range per shadow casting light type. Culled meshes aren't written at all.
+		u64 numSubCommandsToUpload = 0;
+
+		for (auto countIter = r2::shashmap::Begin(*shaderDrawCommandData); countIter != r2::shashmap::End(*shaderDrawCommandData); ++countIter)
+		{
+			const DrawCommandData* drawCommandData = countIter->value;
+			if (drawCommandData != nullptr)
+			{
+				numSubCommandsToUpload += drawCommandData->numCameraSubCommands;
+				for (u32 lightType = 0; lightType < light::NUM_LIGHT_TYPES; ++lightType)
+				{
+					numSubCommandsToUpload += drawCommandData->numShadowSubCommands[lightType];
+				}
+			}
+		}
+
+		R2_CHECK(numSubCommandsToUpload + 1 <= MAX_NUM_SUB_COMMANDS, "We have %llu sub commands to upload but the sub commands buffer only holds %u", numSubCommandsToUpload + 1, MAX_NUM_SUB_COMMANDS);
+
+		const u64 subCommandsMemorySize = sizeof(cmd::DrawBatchSubCommand) * (numSubCommandsToUpload + 1); //+ 1 for final batch
 
 		subCommandsCMD = AppendCommand<cmd::FillConstantBuffer, cmd::FillConstantBuffer, mem::StackArena>(*renderer.mPrePostRenderCommandArena, prevFillCMD, subCommandsMemorySize);
 
@@ -3722,20 +4002,50 @@ namespace r2::draw::renderer
 
 				const u32 numSubCommandsInBatch = static_cast<u32>(r2::sarr::Size(*drawCommandData->subCommands));
 
+				BatchRenderOffsets batchOffsets;
+
+				batchOffsets.shaderEffectPasses = drawCommandData->shaderEffectPasses;
+				batchOffsets.subCommandsOffset = subCommandsOffset;
+				batchOffsets.numSubCommands = drawCommandData->numCameraSubCommands;
+				batchOffsets.isDynamic = drawCommandData->isDynamic;
+				batchOffsets.isQuantized = drawCommandData->isQuantized;
+
 				for (u32 i = 0; i < numSubCommandsInBatch; ++i)
 				{
 					u32 index = r2::sarr::At(*drawCommandData->cameraDepths, i).index;
 
+					if ((r2::sarr::At(*drawCommandData->visibilityMasks, index) & cull::VISIBLE_CAMERA) == 0)
+					{
+						continue;
+					}
+
 					memcpy(mem::utils::PointerAdd(subCommandsAuxMemory, subCommandsMemoryOffset), &r2::sarr::At(*drawCommandData->subCommands, index), sizeof(cmd::DrawBatchSubCommand));
 					subCommandsMemoryOffset += sizeof(cmd::DrawBatchSubCommand);
 				}
 
-				BatchRenderOffsets batchOffsets;
+				subCommandsOffset += drawCommandData->numCameraSubCommands;
 
-				batchOffsets.shaderEffectPasses = drawCommandData->shaderEffectPasses;
-				batchOffsets.subCommandsOffset = subCommandsOffset;
-				batchOffsets.numSubCommands = numSubCommandsInBatch;
-				batchOffsets.isDynamic = drawCommandData->isDynamic;
+				//shadow passes don't care about depth order so keep the submission order
+				for (u32 lightType = 0; lightType < light::NUM_LIGHT_TYPES; ++lightType)
+				{
+					const cull::VisibilityMask shadowBit = cull::ShadowVisibilityBit(static_cast<light::LightType>(lightType));
+
+					batchOffsets.shadowSubCommandsOffset[lightType] = subCommandsOffset;
+					batchOffsets.numShadowSubCommands[lightType] = drawCommandData->numShadowSubCommands[lightType];
+
+					for (u32 i = 0; i < numSubCommandsInBatch; ++i)
+					{
+						if ((r2::sarr::At(*drawCommandData->visibilityMasks, i) & shadowBit) == 0)
+						{
+							continue;
+						}
+
+						memcpy(mem::utils::PointerAdd(subCommandsAuxMemory, subCommandsMemoryOffset), &r2::sarr::At(*drawCommandData->subCommands, i), sizeof(cmd::DrawBatchSubCommand));
+						subCommandsMemoryOffset += sizeof(cmd::DrawBatchSubCommand);
+					}
+
+					subCommandsOffset += drawCommandData->numShadowSubCommands[lightType];
+				}
 
 				memcpy(&batchOffsets.drawState, &drawCommandData->drawState, sizeof(cmd::DrawState));
 
@@ -3743,7 +4053,8 @@ namespace r2::draw::renderer
 				batchOffsets.blendingFunctionKeyValue = key::GetBlendingFunctionKeyValue(drawCommandData->drawState.blendState);
 				
 
-				R2_CHECK(batchOffsets.numSubCommands > 0, "We should have a count!");
+				//@NOTE(Serge): numSubCommands can be 0 here if the batch only survived culling for the shadow passes
+				R2_CHECK(numSubCommandsInBatch > 0, "We should have a count!");
 
 				if (drawCommandData->isDynamic)
 				{
@@ -3753,8 +4064,6 @@ namespace r2::draw::renderer
 				{
 					r2::sarr::Push(*staticRenderBatchesOffsets, batchOffsets);
 				}
-
-				subCommandsOffset += numSubCommandsInBatch;
 			}
 		}
 
@@ -3948,83 +4257,86 @@ namespace r2::draw::renderer
 		for (u64 i = 0; i < numStaticDrawBatches; ++i)
 		{
 			const auto& batchOffset = r2::sarr::At(*staticRenderBatchesOffsets, i);
+			const BufferLayoutHandle batchVertexBufferLayoutHandle = batchOffset.isQuantized ? quantizedStaticVertexBufferLayoutHandle : staticVertexBufferLayoutHandle;
 
-			ShaderHandle shaderToUse = batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_FORWARD].staticShaderHandle;
-			if (batchOffset.drawState.layer == DL_TRANSPARENT)
+			if (batchOffset.numSubCommands > 0)
 			{
-				shaderToUse = batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_TRANSPARENT].staticShaderHandle;
-			}
+				ShaderHandle shaderToUse = batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_FORWARD].staticShaderHandle;
+				if (batchOffset.drawState.layer == DL_TRANSPARENT)
+				{
+					shaderToUse = batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_TRANSPARENT].staticShaderHandle;
+				}
 
-			key::Basic key = key::GenerateBasicKey(key::Basic::FSL_GAME, 0, batchOffset.drawState.layer, batchOffset.blendingFunctionKeyValue, batchOffset.cameraDepth, shaderToUse);
+				key::Basic key = key::GenerateBasicKey(key::Basic::FSL_GAME, 0, batchOffset.drawState.layer, batchOffset.blendingFunctionKeyValue, batchOffset.cameraDepth, shaderToUse);
 
-			cmd::DrawBatch* drawBatch = nullptr;
+				cmd::DrawBatch* drawBatch = nullptr;
 
-			if (batchOffset.drawState.layer != DL_TRANSPARENT)
-			{
-				drawBatch = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mCommandBucket, key, 0);
-				drawBatch->state.depthFunction = EQUAL;
-				cmd::SetDefaultBlendState(drawBatch->state.blendState);
-			}
-			else
-			{
-				//@TODO(Serge): change to mTransparentBucket
-				drawBatch = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mTransparentBucket, key, 0);
-				drawBatch->state.depthFunction = LESS;
-				
-				//now setup all of the blend state to make transparency work
-				SetDefaultTransparencyBlendState(drawBatch->state.blendState);
-			}
+				if (batchOffset.drawState.layer != DL_TRANSPARENT)
+				{
+					drawBatch = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mCommandBucket, key, 0);
+					drawBatch->state.depthFunction = EQUAL;
+					cmd::SetDefaultBlendState(drawBatch->state.blendState);
+				}
+				else
+				{
+					//@TODO(Serge): change to mTransparentBucket
+					drawBatch = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mTransparentBucket, key, 0);
+					drawBatch->state.depthFunction = LESS;
 
-			drawBatch->state.depthWriteEnabled = false;
-			drawBatch->batchHandle = subCommandsConstantBufferHandle;
-			drawBatch->bufferLayoutHandle = staticVertexBufferLayoutHandle;
-			drawBatch->numSubCommands = batchOffset.numSubCommands;
-			R2_CHECK(drawBatch->numSubCommands > 0, "We should have a count!");
-			drawBatch->startCommandIndex = batchOffset.subCommandsOffset;
-			drawBatch->primitiveType = PrimitiveType::TRIANGLES;
-			drawBatch->subCommands = nullptr;
-			drawBatch->state.depthEnabled = batchOffset.drawState.depthEnabled;
-			drawBatch->state.cullState = batchOffset.drawState.cullState;
-			
-			drawBatch->state.polygonOffsetEnabled = false;
-			drawBatch->state.polygonOffset = glm::vec2(0);
-			drawBatch->state.stencilState = batchOffset.drawState.stencilState;
-			
-			
-			if (batchOffset.drawState.layer == DL_SKYBOX)
-			{
-				drawBatch->state.depthFunction = LEQUAL;
-			}
+					//now setup all of the blend state to make transparency work
+					SetDefaultTransparencyBlendState(drawBatch->state.blendState);
+				}
 
-#ifdef R2_EDITOR
-			//@TODO(Serge): make a shader for the skybox for picking
-			if (batchOffset.drawState.layer != DL_SKYBOX)
-			{
-				key::Basic staticEditorPickingKey = key::GenerateBasicKey(key::Basic::FSL_GAME, 0, batchOffset.drawState.layer, 0, batchOffset.cameraDepth, renderer.mEntityColorShader[0]);
+				drawBatch->state.depthWriteEnabled = false;
+				drawBatch->batchHandle = subCommandsConstantBufferHandle;
+				drawBatch->bufferLayoutHandle = batchVertexBufferLayoutHandle;
+				drawBatch->numSubCommands = batchOffset.numSubCommands;
+				R2_CHECK(drawBatch->numSubCommands > 0, "We should have a count!");
+				drawBatch->startCommandIndex = batchOffset.subCommandsOffset;
+				drawBatch->primitiveType = PrimitiveType::TRIANGLES;
+				drawBatch->subCommands = nullptr;
+				drawBatch->state.depthEnabled = batchOffset.drawState.depthEnabled;
+				drawBatch->state.cullState = batchOffset.drawState.cullState;
 
-				cmd::DrawBatch* editorPickingDrawBatchCMD = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mEditorPickingBucket, staticEditorPickingKey, 0);
-				editorPickingDrawBatchCMD->state.depthFunction = EQUAL;
+				drawBatch->state.polygonOffsetEnabled = false;
+				drawBatch->state.polygonOffset = glm::vec2(0);
+				drawBatch->state.stencilState = batchOffset.drawState.stencilState;
 
-				editorPickingDrawBatchCMD->state.depthWriteEnabled = false;
-				editorPickingDrawBatchCMD->batchHandle = subCommandsConstantBufferHandle;
-				editorPickingDrawBatchCMD->bufferLayoutHandle = staticVertexBufferLayoutHandle;
-				editorPickingDrawBatchCMD->numSubCommands = batchOffset.numSubCommands;
-				R2_CHECK(editorPickingDrawBatchCMD->numSubCommands > 0, "We should have a count!");
-				editorPickingDrawBatchCMD->startCommandIndex = batchOffset.subCommandsOffset;
-				editorPickingDrawBatchCMD->primitiveType = PrimitiveType::TRIANGLES;
-				editorPickingDrawBatchCMD->subCommands = nullptr;
-				editorPickingDrawBatchCMD->state.depthEnabled = batchOffset.drawState.depthEnabled;
-				editorPickingDrawBatchCMD->state.cullState = batchOffset.drawState.cullState;
 
-				editorPickingDrawBatchCMD->state.polygonOffsetEnabled = false;
-				editorPickingDrawBatchCMD->state.polygonOffset = glm::vec2(0);
+				if (batchOffset.drawState.layer == DL_SKYBOX)
+				{
+					drawBatch->state.depthFunction = LEQUAL;
+				}
 
-				cmd::SetDefaultStencilState(editorPickingDrawBatchCMD->state.stencilState);
-				cmd::SetDefaultBlendState(editorPickingDrawBatchCMD->state.blendState);
-			}
-			
-#endif
+#ifdef R2_EDITOR
+				//@TODO(Serge): make a shader for the skybox for picking
+				if (batchOffset.drawState.layer != DL_SKYBOX)
+				{
+					key::Basic staticEditorPickingKey = key::GenerateBasicKey(key::Basic::FSL_GAME, 0, batchOffset.drawState.layer, 0, batchOffset.cameraDepth, renderer.mEntityColorShader[0]);
+
+					cmd::DrawBatch* editorPickingDrawBatchCMD = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mEditorPickingBucket, staticEditorPickingKey, 0);
+					editorPickingDrawBatchCMD->state.depthFunction = EQUAL;
+
+					editorPickingDrawBatchCMD->state.depthWriteEnabled = false;
+					editorPickingDrawBatchCMD->batchHandle = subCommandsConstantBufferHandle;
+					editorPickingDrawBatchCMD->bufferLayoutHandle = batchVertexBufferLayoutHandle;
+					editorPickingDrawBatchCMD->numSubCommands = batchOffset.numSubCommands;
+					R2_CHECK(editorPickingDrawBatchCMD->numSubCommands > 0, "We should have a count!");
+					editorPickingDrawBatchCMD->startCommandIndex = batchOffset.subCommandsOffset;
+					editorPickingDrawBatchCMD->primitiveType = PrimitiveType::TRIANGLES;
+					editorPickingDrawBatchCMD->subCommands = nullptr;
+					editorPickingDrawBatchCMD->state.depthEnabled = batchOffset.drawState.depthEnabled;
+					editorPickingDrawBatchCMD->state.cullState = batchOffset.drawState.cullState;
+
+					editorPickingDrawBatchCMD->state.polygonOffsetEnabled = false;
+					editorPickingDrawBatchCMD->state.polygonOffset = glm::vec2(0);
+
+					cmd::SetDefaultStencilState(editorPickingDrawBatchCMD->state.stencilState);
+					cmd::SetDefaultBlendState(editorPickingDrawBatchCMD->state.blendState);
+				}
 
+#endif
+			}
 
 			if (batchOffset.drawState.layer != DL_SKYBOX)
 			{
@@ -4034,7 +4346,7 @@ namespace r2::draw::renderer
 
 				//@TODO(Serge): we don't loop over each cascade in the geometry shader for some reason so we have to do this extra divide by NUM_FRUSTUM_SPLITS, we should probably loop in there and update
 
-				const u32 numDirectionShadowBatchesNeeded = static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingDirectionLights / ((float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS / (float)cam::NUM_FRUSTUM_SPLITS)), numShadowCastingDirectionLights > 0 ? 1.0f : 0.0f));
+				const u32 numDirectionShadowBatchesNeeded = batchOffset.numShadowSubCommands[light::LT_DIRECTIONAL_LIGHT] == 0 ? 0 : static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingDirectionLights / ((float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS / (float)cam::NUM_FRUSTUM_SPLITS)), numShadowCastingDirectionLights > 0 ? 1.0f : 0.0f));
 
 				for (u32 i = 0; i < numDirectionShadowBatchesNeeded; ++i)
 				{
@@ -4045,10 +4357,10 @@ namespace r2::draw::renderer
 					cmd::DrawBatch* shadowDrawBatch = AppendCommand<cmd::ConstantUint, cmd::DrawBatch, mem::StackArena>(*renderer.mShadowArena, directionLightBatchIndexUpdateCMD, 0);
 
 					shadowDrawBatch->batchHandle = subCommandsConstantBufferHandle;
-					shadowDrawBatch->bufferLayoutHandle = staticVertexBufferLayoutHandle;
-					shadowDrawBatch->numSubCommands = batchOffset.numSubCommands;
+					shadowDrawBatch->bufferLayoutHandle = batchVertexBufferLayoutHandle;
+					shadowDrawBatch->numSubCommands = batchOffset.numShadowSubCommands[light::LT_DIRECTIONAL_LIGHT];
 					R2_CHECK(shadowDrawBatch->numSubCommands > 0, "We should have a count!");
-					shadowDrawBatch->startCommandIndex = batchOffset.subCommandsOffset;
+					shadowDrawBatch->startCommandIndex = batchOffset.shadowSubCommandsOffset[light::LT_DIRECTIONAL_LIGHT];
 					shadowDrawBatch->primitiveType = PrimitiveType::TRIANGLES;
 					shadowDrawBatch->subCommands = nullptr;
 					shadowDrawBatch->state.depthEnabled = true;
@@ -4066,7 +4378,7 @@ namespace r2::draw::renderer
 					cmd::SetDefaultBlendState(shadowDrawBatch->state.blendState);
 				}
 
-				const u32 numSpotLightShadowBatchesNeeded = static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingSpotLights / (float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS), numShadowCastingSpotLights > 0 ? 1.0f : 0.0f));
+				const u32 numSpotLightShadowBatchesNeeded = batchOffset.numShadowSubCommands[light::LT_SPOT_LIGHT] == 0 ? 0 : static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingSpotLights / (float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS), numShadowCastingSpotLights > 0 ? 1.0f : 0.0f));
 
 				key::ShadowKey spotLightShadowKey = key::GenerateShadowKey(key::ShadowKey::NORMAL, 0, 0, false, light::LightType::LT_SPOT_LIGHT, batchOffset.cameraDepth);
 
@@ -4079,10 +4391,10 @@ namespace r2::draw::renderer
 					cmd::DrawBatch* shadowDrawBatch = AppendCommand<cmd::ConstantUint, cmd::DrawBatch, mem::StackArena>(*renderer.mShadowArena, spotLightBatchIndexUpdateCMD, 0);
 
 					shadowDrawBatch->batchHandle = subCommandsConstantBufferHandle;
-					shadowDrawBatch->bufferLayoutHandle = staticVertexBufferLayoutHandle;
-					shadowDrawBatch->numSubCommands = batchOffset.numSubCommands;
+					shadowDrawBatch->bufferLayoutHandle = batchVertexBufferLayoutHandle;
+					shadowDrawBatch->numSubCommands = batchOffset.numShadowSubCommands[light::LT_SPOT_LIGHT];
 					R2_CHECK(shadowDrawBatch->numSubCommands > 0, "We should have a count!");
-					shadowDrawBatch->startCommandIndex = batchOffset.subCommandsOffset;
+					shadowDrawBatch->startCommandIndex = batchOffset.shadowSubCommandsOffset[light::LT_SPOT_LIGHT];
 					shadowDrawBatch->primitiveType = PrimitiveType::TRIANGLES;
 					shadowDrawBatch->subCommands = nullptr;
 					shadowDrawBatch->state.depthEnabled = true;
@@ -4100,7 +4412,7 @@ namespace r2::draw::renderer
 
 				}
 
-				const u32 numPointLightShadowBatchesNeeded = static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingPointLights / (float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS), numShadowCastingPointLights > 0 ? 1.0f : 0.0f));
+				const u32 numPointLightShadowBatchesNeeded = batchOffset.numShadowSubCommands[light::LT_POINT_LIGHT] == 0 ? 0 : static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingPointLights / (float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS), numShadowCastingPointLights > 0 ? 1.0f : 0.0f));
 
 				key::ShadowKey plShadowKey = key::GenerateShadowKey(key::ShadowKey::POINT_LIGHT, 0, 0, false, light::LightType::LT_POINT_LIGHT, batchOffset.cameraDepth);
 
@@ -4113,10 +4425,10 @@ namespace r2::draw::renderer
 					cmd::DrawBatch* shadowDrawBatch = AppendCommand<cmd::ConstantUint, cmd::DrawBatch, mem::StackArena>(*renderer.mShadowArena, pointLightBatchIndexUpdateCMD, 0);
 
 					shadowDrawBatch->batchHandle = subCommandsConstantBufferHandle;
-					shadowDrawBatch->bufferLayoutHandle = staticVertexBufferLayoutHandle;
-					shadowDrawBatch->numSubCommands = batchOffset.numSubCommands;
+					shadowDrawBatch->bufferLayoutHandle = batchVertexBufferLayoutHandle;
+					shadowDrawBatch->numSubCommands = batchOffset.numShadowSubCommands[light::LT_POINT_LIGHT];
 					R2_CHECK(shadowDrawBatch->numSubCommands > 0, "We should have a count!");
-					shadowDrawBatch->startCommandIndex = batchOffset.subCommandsOffset;
+					shadowDrawBatch->startCommandIndex = batchOffset.shadowSubCommandsOffset[light::LT_POINT_LIGHT];
 					shadowDrawBatch->primitiveType = PrimitiveType::TRIANGLES;
 					shadowDrawBatch->subCommands = nullptr;
 					shadowDrawBatch->state.depthEnabled = true;
@@ -4135,11 +4447,11 @@ namespace r2::draw::renderer
 
 				key::DepthKey zppKey = key::GenerateDepthKey(key::DepthKey::NORMAL, 0, batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_DEPTH].staticShaderHandle, r2::draw::DrawLayer::DL_WORLD);
 
-				if (batchOffset.drawState.layer != DL_TRANSPARENT)
+				if (batchOffset.drawState.layer != DL_TRANSPARENT && batchOffset.numSubCommands > 0)
 				{
 					cmd::DrawBatch* zppDrawBatch = AddCommand<key::DepthKey, cmd::DrawBatch, mem::StackArena>(*renderer.mShadowArena, *renderer.mDepthPrePassBucket, zppKey, 0);
 					zppDrawBatch->batchHandle = subCommandsConstantBufferHandle;
-					zppDrawBatch->bufferLayoutHandle = staticVertexBufferLayoutHandle;
+					zppDrawBatch->bufferLayoutHandle = batchVertexBufferLayoutHandle;
 					zppDrawBatch->numSubCommands = batchOffset.numSubCommands;
 					R2_CHECK(zppDrawBatch->numSubCommands > 0, "We should have a count!");
 					zppDrawBatch->startCommandIndex = batchOffset.subCommandsOffset;
@@ -4166,7 +4478,7 @@ namespace r2::draw::renderer
 
 					cmd::DrawBatch* zppShadowsDrawBatch = AddCommand<key::DepthKey, cmd::DrawBatch, mem::StackArena>(*renderer.mShadowArena, *renderer.mDepthPrePassShadowBucket, zppKey, 0);
 					zppShadowsDrawBatch->batchHandle = subCommandsConstantBufferHandle;
-					zppShadowsDrawBatch->bufferLayoutHandle = staticVertexBufferLayoutHandle;
+					zppShadowsDrawBatch->bufferLayoutHandle = batchVertexBufferLayoutHandle;
 					zppShadowsDrawBatch->numSubCommands = batchOffset.numSubCommands;
 					R2_CHECK(zppShadowsDrawBatch->numSubCommands > 0, "We should have a count!");
 					zppShadowsDrawBatch->startCommandIndex = batchOffset.subCommandsOffset;
@@ -4198,69 +4510,72 @@ namespace r2::draw::renderer
 		{
 			const auto& batchOffset = r2::sarr::At(*dynamicRenderBatchesOffsets, i);
 
-			ShaderHandle shaderToUse = batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_FORWARD].dynamicShaderHandle;
-			if (batchOffset.drawState.layer == DL_TRANSPARENT)
+			if (batchOffset.numSubCommands > 0)
 			{
-				shaderToUse = batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_TRANSPARENT].dynamicShaderHandle;
-			}
+				ShaderHandle shaderToUse = batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_FORWARD].dynamicShaderHandle;
+				if (batchOffset.drawState.layer == DL_TRANSPARENT)
+				{
+					shaderToUse = batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_TRANSPARENT].dynamicShaderHandle;
+				}
 
-			key::Basic key = key::GenerateBasicKey(key::Basic::FSL_GAME, 0, batchOffset.drawState.layer, batchOffset.blendingFunctionKeyValue, batchOffset.cameraDepth, shaderToUse);
+				key::Basic key = key::GenerateBasicKey(key::Basic::FSL_GAME, 0, batchOffset.drawState.layer, batchOffset.blendingFunctionKeyValue, batchOffset.cameraDepth, shaderToUse);
 
-			cmd::DrawBatch* drawBatch = nullptr;
+				cmd::DrawBatch* drawBatch = nullptr;
 
-			if (batchOffset.drawState.layer != DL_TRANSPARENT)
-			{
-				drawBatch = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mCommandBucket, key, 0);
-				drawBatch->state.depthFunction = EQUAL;
-				
-				cmd::SetDefaultBlendState(drawBatch->state.blendState);
-			}
-			else
-			{
-				drawBatch = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mTransparentBucket, key, 0);
-				drawBatch->state.depthFunction = LESS;
-				
-				SetDefaultTransparencyBlendState(drawBatch->state.blendState);
-			}
+				if (batchOffset.drawState.layer != DL_TRANSPARENT)
+				{
+					drawBatch = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mCommandBucket, key, 0);
+					drawBatch->state.depthFunction = EQUAL;
+
+					cmd::SetDefaultBlendState(drawBatch->state.blendState);
+				}
+				else
+				{
+					drawBatch = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mTransparentBucket, key, 0);
+					drawBatch->state.depthFunction = LESS;
+
+					SetDefaultTransparencyBlendState(drawBatch->state.blendState);
+				}
+
+				drawBatch->state.depthWriteEnabled = false;
+				drawBatch->batchHandle = subCommandsConstantBufferHandle;
+				drawBatch->bufferLayoutHandle = animVertexBufferLayoutHandle;
+				drawBatch->numSubCommands = batchOffset.numSubCommands;
+				R2_CHECK(drawBatch->numSubCommands > 0, "We should have a count!");
+				drawBatch->startCommandIndex = batchOffset.subCommandsOffset;
+				drawBatch->primitiveType = PrimitiveType::TRIANGLES;
+				drawBatch->subCommands = nullptr;
+				drawBatch->state.depthEnabled = batchOffset.drawState.depthEnabled;
+				drawBatch->state.cullState = batchOffset.drawState.cullState;
 
-			drawBatch->state.depthWriteEnabled = false;
-			drawBatch->batchHandle = subCommandsConstantBufferHandle;
-			drawBatch->bufferLayoutHandle = animVertexBufferLayoutHandle;
-			drawBatch->numSubCommands = batchOffset.numSubCommands;
-			R2_CHECK(drawBatch->numSubCommands > 0, "We should have a count!");
-			drawBatch->startCommandIndex = batchOffset.subCommandsOffset;
-			drawBatch->primitiveType = PrimitiveType::TRIANGLES;
-			drawBatch->subCommands = nullptr;
-			drawBatch->state.depthEnabled = batchOffset.drawState.depthEnabled;
-			drawBatch->state.cullState = batchOffset.drawState.cullState;
-
-			drawBatch->state.polygonOffsetEnabled = false;
-			drawBatch->state.polygonOffset = glm::vec2(0);
-			drawBatch->state.stencilState = batchOffset.drawState.stencilState;
+				drawBatch->state.polygonOffsetEnabled = false;
+				drawBatch->state.polygonOffset = glm::vec2(0);
+				drawBatch->state.stencilState = batchOffset.drawState.stencilState;
 
 #ifdef R2_EDITOR
-			key::Basic dynamicEditorPickingKey = key::GenerateBasicKey(key::Basic::FSL_GAME, 0, batchOffset.drawState.layer, 0, batchOffset.cameraDepth, renderer.mEntityColorShader[1]);
-
-			cmd::DrawBatch* editorPickingDrawBatchCMD = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mEditorPickingBucket, dynamicEditorPickingKey, 0);
-			editorPickingDrawBatchCMD->state.depthFunction = EQUAL;
-
-			editorPickingDrawBatchCMD->state.depthWriteEnabled = false;
-			editorPickingDrawBatchCMD->batchHandle = subCommandsConstantBufferHandle;
-			editorPickingDrawBatchCMD->bufferLayoutHandle = animVertexBufferLayoutHandle;
-			editorPickingDrawBatchCMD->numSubCommands = batchOffset.numSubCommands;
-			R2_CHECK(editorPickingDrawBatchCMD->numSubCommands > 0, "We should have a count!");
-			editorPickingDrawBatchCMD->startCommandIndex = batchOffset.subCommandsOffset;
-			editorPickingDrawBatchCMD->primitiveType = PrimitiveType::TRIANGLES;
-			editorPickingDrawBatchCMD->subCommands = nullptr;
-			editorPickingDrawBatchCMD->state.depthEnabled = batchOffset.drawState.depthEnabled;
-			editorPickingDrawBatchCMD->state.cullState = batchOffset.drawState.cullState;
-
-			editorPickingDrawBatchCMD->state.polygonOffsetEnabled = false;
-			editorPickingDrawBatchCMD->state.polygonOffset = glm::vec2(0);
-
-			cmd::SetDefaultStencilState(editorPickingDrawBatchCMD->state.stencilState);
-			cmd::SetDefaultBlendState(editorPickingDrawBatchCMD->state.blendState);
+				key::Basic dynamicEditorPickingKey = key::GenerateBasicKey(key::Basic::FSL_GAME, 0, batchOffset.drawState.layer, 0, batchOffset.cameraDepth, renderer.mEntityColorShader[1]);
+
+				cmd::DrawBatch* editorPickingDrawBatchCMD = AddCommand<key::Basic, cmd::DrawBatch, mem::StackArena>(*renderer.mCommandArena, *renderer.mEditorPickingBucket, dynamicEditorPickingKey, 0);
+				editorPickingDrawBatchCMD->state.depthFunction = EQUAL;
+
+				editorPickingDrawBatchCMD->state.depthWriteEnabled = false;
+				editorPickingDrawBatchCMD->batchHandle = subCommandsConstantBufferHandle;
+				editorPickingDrawBatchCMD->bufferLayoutHandle = animVertexBufferLayoutHandle;
+				editorPickingDrawBatchCMD->numSubCommands = batchOffset.numSubCommands;
+				R2_CHECK(editorPickingDrawBatchCMD->numSubCommands > 0, "We should have a count!");
+				editorPickingDrawBatchCMD->startCommandIndex = batchOffset.subCommandsOffset;
+				editorPickingDrawBatchCMD->primitiveType = PrimitiveType::TRIANGLES;
+				editorPickingDrawBatchCMD->subCommands = nullptr;
+				editorPickingDrawBatchCMD->state.depthEnabled = batchOffset.drawState.depthEnabled;
+				editorPickingDrawBatchCMD->state.cullState = batchOffset.drawState.cullState;
+
+				editorPickingDrawBatchCMD->state.polygonOffsetEnabled = false;
+				editorPickingDrawBatchCMD->state.polygonOffset = glm::vec2(0);
+
+				cmd::SetDefaultStencilState(editorPickingDrawBatchCMD->state.stencilState);
+				cmd::SetDefaultBlendState(editorPickingDrawBatchCMD->state.blendState);
 #endif
+			}
 
 
 			//memcpy(&drawBatch->state.blendState, &batchOffset.drawState.blendState, sizeof(BlendState));
@@ -4272,7 +4587,7 @@ namespace r2::draw::renderer
 				key::ShadowKey directionShadowKey = key::GenerateShadowKey(key::ShadowKey::NORMAL, 0, 0, true, light::LightType::LT_DIRECTIONAL_LIGHT, batchOffset.cameraDepth);
 
 				//@TODO(Serge): we don't loop over each cascade in the geometry shader for some reason so we have to do this extra divide by NUM_FRUSTUM_SPLITS, we should probably loop in there and update
-				const u32 numDirectionShadowBatchesNeeded = static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingDirectionLights / ((float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS / (float)cam::NUM_FRUSTUM_SPLITS)), numShadowCastingDirectionLights > 0 ? 1.0f : 0.0f));
+				const u32 numDirectionShadowBatchesNeeded = batchOffset.numShadowSubCommands[light::LT_DIRECTIONAL_LIGHT] == 0 ? 0 : static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingDirectionLights / ((float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS / (float)cam::NUM_FRUSTUM_SPLITS)), numShadowCastingDirectionLights > 0 ? 1.0f : 0.0f));
 
 				for (u32 i = 0; i < numDirectionShadowBatchesNeeded; ++i)
 				{
@@ -4284,9 +4599,9 @@ namespace r2::draw::renderer
 
 					shadowDrawBatch->batchHandle = subCommandsConstantBufferHandle;
 					shadowDrawBatch->bufferLayoutHandle = animVertexBufferLayoutHandle;
-					shadowDrawBatch->numSubCommands = batchOffset.numSubCommands;
+					shadowDrawBatch->numSubCommands = batchOffset.numShadowSubCommands[light::LT_DIRECTIONAL_LIGHT];
 					R2_CHECK(shadowDrawBatch->numSubCommands > 0, "We should have a count!");
-					shadowDrawBatch->startCommandIndex = batchOffset.subCommandsOffset;
+					shadowDrawBatch->startCommandIndex = batchOffset.shadowSubCommandsOffset[light::LT_DIRECTIONAL_LIGHT];
 					shadowDrawBatch->primitiveType = PrimitiveType::TRIANGLES;
 					shadowDrawBatch->subCommands = nullptr;
 					shadowDrawBatch->state.depthEnabled = true;
@@ -4303,7 +4618,7 @@ namespace r2::draw::renderer
 					cmd::SetDefaultBlendState(shadowDrawBatch->state.blendState);
 				}
 
-				const u32 numSpotLightShadowBatchesNeeded = static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingSpotLights / (float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS), numShadowCastingSpotLights > 0 ? 1.0f : 0.0f));
+				const u32 numSpotLightShadowBatchesNeeded = batchOffset.numShadowSubCommands[light::LT_SPOT_LIGHT] == 0 ? 0 : static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingSpotLights / (float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS), numShadowCastingSpotLights > 0 ? 1.0f : 0.0f));
 
 				key::ShadowKey spotLightShadowKey = key::GenerateShadowKey(key::ShadowKey::NORMAL, 0, 0, true, light::LightType::LT_SPOT_LIGHT, batchOffset.cameraDepth);
 
@@ -4317,9 +4632,9 @@ namespace r2::draw::renderer
 
 					shadowDrawBatch->batchHandle = subCommandsConstantBufferHandle;
 					shadowDrawBatch->bufferLayoutHandle = animVertexBufferLayoutHandle;
-					shadowDrawBatch->numSubCommands = batchOffset.numSubCommands;
+					shadowDrawBatch->numSubCommands = batchOffset.numShadowSubCommands[light::LT_SPOT_LIGHT];
 					R2_CHECK(shadowDrawBatch->numSubCommands > 0, "We should have a count!");
-					shadowDrawBatch->startCommandIndex = batchOffset.subCommandsOffset;
+					shadowDrawBatch->startCommandIndex = batchOffset.shadowSubCommandsOffset[light::LT_SPOT_LIGHT];
 					shadowDrawBatch->primitiveType = PrimitiveType::TRIANGLES;
 					shadowDrawBatch->subCommands = nullptr;
 					shadowDrawBatch->state.depthEnabled = true;
@@ -4336,7 +4651,7 @@ namespace r2::draw::renderer
 					cmd::SetDefaultBlendState(shadowDrawBatch->state.blendState);
 				}
 
-				const u32 numPointLightShadowBatchesNeeded = static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingPointLights / (float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS), numShadowCastingPointLights > 0 ? 1.0f : 0.0f));
+				const u32 numPointLightShadowBatchesNeeded = batchOffset.numShadowSubCommands[light::LT_POINT_LIGHT] == 0 ? 0 : static_cast<u32>(glm::max(glm::ceil((float)numShadowCastingPointLights / (float)MAX_NUM_GEOMETRY_SHADER_INVOCATIONS), numShadowCastingPointLights > 0 ? 1.0f : 0.0f));
 
 				key::ShadowKey plShadowKey = key::GenerateShadowKey(key::ShadowKey::POINT_LIGHT, 0, 0, true, light::LightType::LT_POINT_LIGHT, batchOffset.cameraDepth);
 
@@ -4350,9 +4665,9 @@ namespace r2::draw::renderer
 
 					shadowDrawBatch->batchHandle = subCommandsConstantBufferHandle;
 					shadowDrawBatch->bufferLayoutHandle = animVertexBufferLayoutHandle;
-					shadowDrawBatch->numSubCommands = batchOffset.numSubCommands;
+					shadowDrawBatch->numSubCommands = batchOffset.numShadowSubCommands[light::LT_POINT_LIGHT];
 					R2_CHECK(shadowDrawBatch->numSubCommands > 0, "We should have a count!");
-					shadowDrawBatch->startCommandIndex = batchOffset.subCommandsOffset;
+					shadowDrawBatch->startCommandIndex = batchOffset.shadowSubCommandsOffset[light::LT_POINT_LIGHT];
 					shadowDrawBatch->primitiveType = PrimitiveType::TRIANGLES;
 					shadowDrawBatch->subCommands = nullptr;
 					shadowDrawBatch->state.depthEnabled = true;
@@ -4371,7 +4686,7 @@ namespace r2::draw::renderer
 
 				key::DepthKey zppKey = key::GenerateDepthKey(key::DepthKey::NORMAL, 0, batchOffset.shaderEffectPasses.meshPasses[flat::eMeshPass_DEPTH].dynamicShaderHandle, r2::draw::DrawLayer::DL_CHARACTER);
 
-				if (batchOffset.drawState.layer != DL_TRANSPARENT)
+				if (batchOffset.drawState.layer != DL_TRANSPARENT && batchOffset.numSubCommands > 0)
 				{
 					cmd::DrawBatch* zppDrawBatch = AddCommand<key::DepthKey, cmd::DrawBatch, mem::StackArena>(*renderer.mShadowArena, *renderer.mDepthPrePassBucket, zppKey, 0);
 					zppDrawBatch->batchHandle = subCommandsConstantBufferHandle;
@@ -6097,6 +6412,35 @@ namespace r2::draw::renderer
 		renderer.mShaderVectors.fovAspectResXResY = glm::vec4(camera.fov, camera.aspectRatio, renderer.mResolutionSize.width, renderer.mResolutionSize.height);
 	}
 
+	void PushMeshRenderData(r2::SArray<MeshRenderData>& meshRenderDatas, const vb::GPUModelRef& gpuModelRef, const Model& model)
+	{
+		MeshRenderData meshRenderData = {};
+
+		//@NOTE(Serge): only set the dequantization if the vertices are actually quantized on the GPU (animated models get expanded)
+		if (gpuModelRef.isQuantized)
+		{
+			meshRenderData.positionScale = glm::vec4(model.quantizedPositionScale, 1.0f);
+			meshRenderData.positionBias = glm::vec4(model.quantizedPositionBias, 0.0f);
+		}
+
+		if (model.optrGLTFMeshInfos)
+		{
+			const auto numMeshInfos = r2::sarr::Size(*model.optrGLTFMeshInfos);
+			for (u32 i = 0; i < numMeshInfos; ++i)
+			{
+				const auto& gltfMeshInfo = r2::sarr::At(*model.optrGLTFMeshInfos, i);
+				meshRenderData.globalInvTransform = gltfMeshInfo.meshGlobalInv;
+				meshRenderData.globalTransform = gltfMeshInfo.meshGlobal;
+
+				r2::sarr::Push(meshRenderDatas, meshRenderData);
+			}
+		}
+		else
+		{
+			r2::sarr::Push(meshRenderDatas, meshRenderData);
+		}
+	}
+
 	void DrawModel(
 		Renderer& renderer,
 		u32 entityID,
@@ -6154,24 +6498,7 @@ namespace r2::draw::renderer
 
 		RenderBatch& batch = r2::sarr::At(*renderer.mRenderBatches, drawType);
 
-		if (model->optrGLTFMeshInfos)
-		{
-			const auto numMeshInfos = r2::sarr::Size(*model->optrGLTFMeshInfos);
-			for (u32 i = 0; i < numMeshInfos; ++i)
-			{
-				MeshRenderData meshRenderData;
-				const auto& gltfMeshInfo = r2::sarr::At(*model->optrGLTFMeshInfos, i);
-				meshRenderData.globalInvTransform = gltfMeshInfo.meshGlobalInv;
-				meshRenderData.globalTransform = gltfMeshInfo.meshGlobal;
-
-				r2::sarr::Push(*batch.meshRenderData, meshRenderData);
-			}
-		}
-		else
-		{
-			MeshRenderData meshRenderData = {};
-			r2::sarr::Push(*batch.meshRenderData, meshRenderData);
-		}
+		PushMeshRenderData(*batch.meshRenderData, *gpuModelRef, *model);
 
 		r2::sarr::Push(*batch.gpuModelRefs, gpuModelRef);
 
@@ -6379,24 +6706,7 @@ namespace r2::draw::renderer
 
 			RenderBatch& batch = r2::sarr::At(*renderer.mRenderBatches, drawType);
 
-			if (model->optrGLTFMeshInfos)
-			{
-				const auto numMeshInfos = r2::sarr::Size(*model->optrGLTFMeshInfos);
-				for (u32 j = 0; j < numMeshInfos; ++j)
-				{
-					MeshRenderData meshRenderData;
-					const auto& gltfMeshInfo = r2::sarr::At(*model->optrGLTFMeshInfos, j);
-					meshRenderData.globalInvTransform = gltfMeshInfo.meshGlobalInv;
-					meshRenderData.globalTransform = gltfMeshInfo.meshGlobal;
-
-					r2::sarr::Push(*batch.meshRenderData, meshRenderData);
-				}
-			}
-			else
-			{
-				MeshRenderData meshRenderData = {};
-				r2::sarr::Push(*batch.meshRenderData, meshRenderData);
-			}
+			PushMeshRenderData(*batch.meshRenderData, *gpuModelRef, *model);
 		}
 
 #ifdef R2_EDITOR
@@ -6614,9 +6924,9 @@ namespace r2::draw::renderer
 
 					subCommand.baseInstance = debugConstantsOffset + instanceOffset;
 					subCommand.baseVertex = meshEntry.gpuVertexEntry.start;
-					subCommand.firstIndex = meshEntry.gpuIndexEntry.start;
+					subCommand.firstIndex = meshEntry.gpuIndexEntry.start + meshEntry.lods[0].firstIndex;
 					subCommand.instanceCount = numInstances;
-					subCommand.count = meshEntry.gpuIndexEntry.size;
+					subCommand.count = meshEntry.lods[0].numIndices;
 
 					r2::sarr::Push(*debugDrawCommandData->debugModelDrawBatchCommands, subCommand);
 				}
@@ -7304,11 +7614,14 @@ namespace r2::draw::renderer
 		{
 			const Mesh* mesh = r2::sarr::At(*model->optrMeshes, i);
 
-			const u64 numVertices = r2::sarr::Size(*mesh->optrVertices);
+			const u64 numVertices = GetNumVertices(*mesh);
 
 			for (u64 v = 0; v < numVertices; ++v)
 			{
-				const draw::Vertex& vertex = r2::sarr::At(*mesh->optrVertices, v);
+				//quantized meshes don't have optrVertices
+				const draw::Vertex vertex = mesh->optrQuantizedVertices ?
+					DequantizeVertex(r2::sarr::At(*mesh->optrQuantizedVertices, v), model->quantizedPositionScale, model->quantizedPositionBias) :
+					r2::sarr::At(*mesh->optrVertices, v);
 
 				//@TODO(Serge): all this matrix multiply is slow....
 				glm::vec3 initialPosition = glm::vec3(transform * glm::vec4(vertex.position, 1));
@@ -8988,6 +9301,21 @@ namespace r2::draw::renderer
 		return renderer.mColorCorrectionData.mColorGradingContribution;
 	}
 
+	void SetCPUCullingEnabled(Renderer& renderer, bool enabled)
+	{
+		renderer.mCPUCullingEnabled = enabled;
+	}
+
+	bool IsCPUCullingEnabled(Renderer& renderer)
+	{
+		return renderer.mCPUCullingEnabled;
+	}
+
+	const cull::CullingStats& GetCullingStats(Renderer& renderer)
+	{
+		return renderer.mCullingStats;
+	}
+
 	void UpdateColorCorrectionIfNeeded(Renderer& renderer)
 	{
 		if (renderer.mColorCorrectionNeedsUpdate)
@@ -9224,6 +9552,7 @@ namespace r2::draw::renderer
 		if (lightingNeedsUpdate)
 		{
 			UpdateSceneLighting(renderer, *renderer.mLightSystem);
+			lightsys::ClearModifiedLights(*renderer.mLightSystem);
 		}
 
 		if (USE_SDSM_SHADOWS)
@@ -9850,6 +10179,21 @@ namespace r2::draw::renderer
 		return GetColorGradingContribution(MENG.GetCurrentRendererRef());
 	}
 
+	void SetCPUCullingEnabled(bool enabled)
+	{
+		SetCPUCullingEnabled(MENG.GetCurrentRendererRef(), enabled);
+	}
+
+	bool IsCPUCullingEnabled()
+	{
+		return IsCPUCullingEnabled(MENG.GetCurrentRendererRef());
+	}
+
+	const cull::CullingStats& GetCullingStats()
+	{
+		return GetCullingStats(MENG.GetCurrentRendererRef());
+	}
+
 	//------------------------------------------------------------------------------
 
 #ifdef R2_DEBUG
@@ -16,6 +16,7 @@
 #include "r2/Render/Model/Light.h"
 #include "r2/Render/Renderer/VertexBufferLayoutSystem.h"
 #include "r2/Render/Model/RenderMaterials/RenderMaterialCache.h"
+#include "r2/Render/Renderer/Culling.h"
 
 namespace r2
 {
@@ -88,6 +89,7 @@ namespace r2::draw
 	{
 		VBL_STATIC = 0,
 		VBL_ANIMATED,
+		VBL_STATIC_QUANTIZED,
 #if defined R2_DEBUG
 		VBL_DEBUG_LINES,
 #endif
@@ -102,6 +104,9 @@ namespace r2::draw
 	{
 		glm::mat4 globalTransform = glm::mat4(1);
 		glm::mat4 globalInvTransform = glm::mat4(1);
+		//@NOTE(Serge): for meshes uploaded as QuantizedVertex - position = aPos * positionScale + positionBias, positionScale.w = 1 means octahedral normals/tangents
+		glm::vec4 positionScale = glm::vec4(1, 1, 1, 0);
+		glm::vec4 positionBias = glm::vec4(0);
 	};
 
 	struct RenderBatch
@@ -149,9 +154,13 @@ struct BatchRenderOffsets
 		cmd::DrawState drawState;
 		u32 subCommandsOffset = 0;
 		u32 numSubCommands = 0;
+		//compacted ranges of the sub commands that survived culling for each shadow casting light type
+		u32 shadowSubCommandsOffset[light::NUM_LIGHT_TYPES] = {};
+		u32 numShadowSubCommands[light::NUM_LIGHT_TYPES] = {};
 		u32 cameraDepth;
 		u32 depthFunction;
 		b32 isDynamic = false;
+		b32 isQuantized = false;
 		u8 blendingFunctionKeyValue = key::TR_OPAQUE;
 
 	};
@@ -346,6 +355,7 @@ struct BatchRenderOffsets
 
 		vb::VertexBufferLayoutHandle mStaticVertexModelConfigHandle = vb::InvalidVertexBufferLayoutHandle;
 		vb::VertexBufferLayoutHandle mAnimVertexModelConfigHandle = vb::InvalidVertexBufferLayoutHandle;
+		vb::VertexBufferLayoutHandle mQuantizedStaticVertexModelConfigHandle = vb::InvalidVertexBufferLayoutHandle;
 
 		ConstantConfigHandle mSurfacesConfigHandle = InvalidConstantConfigHandle;
 		ConstantConfigHandle mModelConfigHandle = InvalidConstantConfigHandle;
@@ -518,6 +528,11 @@ struct BatchRenderOffsets
 
 		r2::mem::StackArena* mPreRenderStackArena = nullptr;
 
+		//------------BEGIN Culling data-----------
+		cull::CullingVolumes mCullingVolumes;
+		cull::CullingStats mCullingStats;
+		b32 mCPUCullingEnabled = true;
+		//------------END Culling data-------------
 
 		//------------END Drawing Stuff--------------
 
@@ -641,6 +656,12 @@ namespace r2::draw::renderer
 	void Shutdown(Renderer* renderer);
 	u64 MemorySize(u64 renderTargetsMemorySize);
 
+	//The part of PreRender that turns a render batch into draw command data - it builds the culling volumes from renderer.mnoptrRenderCam and sceneLighting
+	//(culling is skipped if renderer.mCPUCullingEnabled is false) the same way PreRender does and sorts by renderer.mnoptrRenderCam.
+	//Returns the number of sub commands it made. It resets mPreRenderStackArena and mPrePostRenderCommandArena when it's done so don't call it in the middle of a frame.
+	//Used by r2Bench to measure the batching without a GPU.
+	u32 PopulateRenderData(Renderer& renderer, const RenderBatch& renderBatch, const SceneLighting& sceneLighting);
+
 	
 	//events
 	void WindowResized(Renderer& renderer, u32 windowWidth, u32 windowHeight, u32 resolutionX, u32 resolutionY, float scaleX, float scaleY, float xOffset, float yOffset);
@@ -755,6 +776,11 @@ namespace r2::draw::renderer
 	float GetColorGradingContribution();
 	bool IsColorGradingEnabled();
 
+	//Culling
+	void SetCPUCullingEnabled(bool enabled);
+	bool IsCPUCullingEnabled();
+	const cull::CullingStats& GetCullingStats();
+
 	///More draw functions...
 	ShaderHandle GetShadowDepthShaderHandle(bool isDynamic, light::LightType lightType);
 	ShaderHandle GetDepthShaderHandle(bool isDynamic);
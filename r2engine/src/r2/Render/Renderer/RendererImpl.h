@@ -5,6 +5,7 @@
 #include "r2/Render/Renderer/RendererTypes.h"
 #include "r2/Render/Renderer/BufferLayout.h"
 #include "r2/Render/Renderer/Commands.h"
+#include "r2/Render/Renderer/Vertex.h"
 
 
 #define MAX_RENDER_TARGETS r2::draw::cmd::SetRenderTargetMipLevel::MAX_NUMBER_OF_TEXTURE_ATTACHMENTS
@@ -112,6 +113,7 @@ namespace r2::draw::rendererimpl
 	void DrawIndexed(BufferLayoutHandle layoutId, VertexBufferHandle vBufferHandle, IndexBufferHandle iBufferHandle, u32 numIndices, u32 startingIndex);
 	void DrawIndexedCommands(BufferLayoutHandle layoutId, ConstantBufferHandle batchHandle, void* cmds, u32 count, u32 offset, u32 stride = 0, PrimitiveType primitivetype = PrimitiveType::TRIANGLES);
 	void UpdateVertexBuffer(VertexBufferHandle vBufferHandle, u64 offset, const void* data, u64 size);
+	void UpdateQuantizedVertexBuffer(VertexBufferHandle vBufferHandle, u64 offset, const QuantizedVertex* vertices, u64 numVertices, const glm::vec3& positionScale, const glm::vec3& positionBias);
 	void UpdateIndexBuffer(IndexBufferHandle iBufferHandle, u64 offset, const void* data, u64 size);
 	void CopyBuffer(u32 readBuffer, u32 writeBuffer, u32 readOffset, u32 writeOffset, u32 size);
 	void UpdateConstantBuffer(ConstantBufferHandle cBufferHandle, r2::draw::ConstantBufferLayout::Type type, b32 isPersistent, u64 offset, void* data, u64 size);
@@ -0,0 +1,43 @@
+#include "r2pch.h"
+
+#include "r2/Render/Renderer/Vertex.h"
+#include "glm/gtc/packing.hpp"
+
+namespace r2::draw
+{
+	static glm::vec3 DecodeOctahedral(s16 x, s16 y)
+	{
+		glm::vec3 n = glm::vec3(glm::unpackSnorm1x16(static_cast<u16>(x)), glm::unpackSnorm1x16(static_cast<u16>(y)), 0.0f);
+		n.z = 1.0f - glm::abs(n.x) - glm::abs(n.y);
+
+		//fold the lower hemisphere back out
+		const float t = glm::clamp(-n.z, 0.0f, 1.0f);
+		n.x += n.x >= 0.0f ? -t : t;
+		n.y += n.y >= 0.0f ? -t : t;
+
+		return glm::normalize(n);
+	}
+
+	static glm::vec3 UnpackHalf3(const u16 v[4])
+	{
+		return glm::vec3(glm::unpackHalf1x16(v[0]), glm::unpackHalf1x16(v[1]), glm::unpackHalf1x16(v[2]));
+	}
+
+	Vertex DequantizeVertex(const QuantizedVertex& quantizedVertex, const glm::vec3& positionScale, const glm::vec3& positionBias)
+	{
+		Vertex vertex;
+
+		const glm::vec3 position = glm::vec3(
+			glm::unpackUnorm1x16(quantizedVertex.position[0]),
+			glm::unpackUnorm1x16(quantizedVertex.position[1]),
+			glm::unpackUnorm1x16(quantizedVertex.position[2]));
+
+		vertex.position = position * positionScale + positionBias;
+		vertex.normal = DecodeOctahedral(quantizedVertex.normal[0], quantizedVertex.normal[1]);
+		vertex.tangent = DecodeOctahedral(quantizedVertex.tangent[0], quantizedVertex.tangent[1]);
+		vertex.texCoords0 = UnpackHalf3(quantizedVertex.texCoords0);
+		vertex.texCoords1 = UnpackHalf3(quantizedVertex.texCoords1);
+
+		return vertex;
+	}
+}
@@ -8,6 +8,7 @@
 #ifndef Vertex_h
 #define Vertex_h
 
+#include "r2/Utils/Utils.h"
 #include "glm/glm.hpp"
 
 namespace r2::draw
@@ -21,6 +22,24 @@ namespace r2::draw
         glm::vec3 texCoords1 = glm::vec3(0.0f);
 	};
 
+    //flat::VertexFormat_P16N16UV16T16 - 32 bytes instead of 60
+    //position is unorm16 relative to the model's quantization bounds (w is padding)
+    //normal and tangent are octahedral encoded snorm16
+    //texCoords are half floats with the material/local mesh index in z like Vertex (w is padding)
+    struct QuantizedVertex
+    {
+        u16 position[4] = {};
+        s16 normal[2] = {};
+        s16 tangent[2] = {};
+        u16 texCoords0[4] = {};
+        u16 texCoords1[4] = {};
+    };
+
+    static_assert(sizeof(QuantizedVertex) == 32, "QuantizedVertex should match the layout of flat::VertexFormat_P16N16UV16T16");
+
+    //position = quantized position * positionScale + positionBias
+    Vertex DequantizeVertex(const QuantizedVertex& quantizedVertex, const glm::vec3& positionScale, const glm::vec3& positionBias);
+
 #ifdef R2_DEBUG
     struct DebugVertex
     {
@@ -300,9 +300,12 @@ namespace r2::draw::vbsys
 
 	vb::GPUModelRefHandle UploadModelToVertexBufferInternal(vb::VertexBufferLayoutSystem& system, const vb::VertexBufferLayoutHandle& handle, const r2::draw::Model& model, const r2::SArray<BoneData>* boneData, u32 numBones, CommandBucket<key::Basic>* uploadBucket, r2::mem::StackArena* commandBucketArena);
 
+	u32 GetVertexSize(const vb::VertexBufferLayout& vertexBufferLayout);
 	u64 FillVertexBufferCommand(cmd::FillVertexBuffer* cmd, const Mesh& mesh, VertexBufferHandle handle, u64 offset);
+	u64 FillQuantizedVertexBufferCommand(cmd::FillQuantizedVertexBuffer* cmd, const Model& model, const Mesh& mesh, VertexBufferHandle handle, u64 offset);
 	u64 FillBonesBufferCommand(cmd::FillVertexBuffer* cmd, const r2::SArray<r2::draw::BoneData>* boneData, VertexBufferHandle handle, u64 offset);
 	u64 FillIndexBufferCommand(cmd::FillIndexBuffer* cmd, const Mesh& mesh, IndexBufferHandle handle, u64 offset);
+	void SetMeshEntryLODs(vb::MeshEntry& meshEntry, const Mesh& mesh);
 
 
 	BufferLayoutHandle GetBufferLayoutHandle(const vb::VertexBufferLayoutSystem& system, const vb::VertexBufferLayoutHandle& handle)
@@ -602,6 +605,13 @@ namespace r2::draw::vbsys
 		modelRef->gpuModelRefHandle = vb::GenerateModelRefHandle(handle, gpuRefIndex, vb::VertexBufferLayoutSystem::g_GPUModelSalt++);
 		modelRef->assetName = model.assetName;
 		modelRef->isAnimated = boneData && numBones > 0;
+
+		//@NOTE(Serge): quantized meshes are uploaded as is if the layout is QuantizedVertex sized, otherwise the backend expands them to r2::draw::Vertex
+		const u32 vertexSize = GetVertexSize(*vertexBufferLayout);
+		R2_CHECK(vertexSize == sizeof(r2::draw::Vertex) || (vertexSize == sizeof(r2::draw::QuantizedVertex) && model.hasQuantizedVertices), "Model doesn't match the vertex layout!");
+
+		modelRef->isQuantized = model.hasQuantizedVertices && vertexSize == sizeof(r2::draw::QuantizedVertex);
+		const bool expandQuantizedVertices = model.hasQuantizedVertices && !modelRef->isQuantized;
 		modelRef->numGLTFMeshes = 0;
 		if (model.optrGLTFMeshInfos)
 		{
@@ -610,7 +620,7 @@ namespace r2::draw::vbsys
 
 		vb::GPUBufferEntry vertexEntry;
 		vb::GPUBufferEntry indexEntry;
-		u32 numVertices0 = r2::sarr::Size(*model.optrMeshes->mData[0]->optrVertices);
+		u32 numVertices0 = GetNumVertices(*model.optrMeshes->mData[0]);
 		u32 numIndices0 = r2::sarr::Size(*model.optrMeshes->mData[0]->optrIndices);
 		
 		u32 totalNumVertices = numVertices0;
@@ -619,11 +629,11 @@ namespace r2::draw::vbsys
 		for (u32 i = 1; i < r2::sarr::Size(*model.optrMeshes); ++i)
 		{
 			const auto* mesh = r2::sarr::At(*model.optrMeshes, i);
-			totalNumVertices += r2::sarr::Size(*mesh->optrVertices);
+			totalNumVertices += GetNumVertices(*mesh);
 			totalNumIndices += r2::sarr::Size(*mesh->optrIndices);
 		}
 		
-		u32 totalMeshSizeInBytes = totalNumVertices * sizeof(r2::draw::Vertex);
+		u32 totalMeshSizeInBytes = totalNumVertices * vertexSize;
 		u32 totalIndicesSizeInBytes = totalNumIndices * sizeof(u32);
 
 		bool vertexNeedsToGrow = vb::gpubuf::AllocateEntry(vertexBufferLayout->vertexBuffers[0], totalMeshSizeInBytes, vertexEntry);
@@ -704,55 +714,100 @@ namespace r2::draw::vbsys
 				vertexBufferLayout->gpuLayout.drawIDHandle);
 		}
 
-		r2::sarr::At(*modelRef->meshEntries, 0).gpuVertexEntry.start = (vertexEntry.start)/sizeof(r2::draw::Vertex); //this is the base vertex
+		r2::sarr::At(*modelRef->meshEntries, 0).gpuVertexEntry.start = (vertexEntry.start)/vertexSize; //this is the base vertex
 		r2::sarr::At(*modelRef->meshEntries, 0).gpuVertexEntry.size = numVertices0;
 		r2::sarr::At(*modelRef->meshEntries, 0).gpuIndexEntry.start = (indexEntry.start) / sizeof(u32);
 		r2::sarr::At(*modelRef->meshEntries, 0).gpuIndexEntry.size = numIndices0;
 		r2::sarr::At(*modelRef->meshEntries, 0).meshBounds = r2::sarr::At(*model.optrMeshes, 0)->objectBounds;
 		r2::sarr::At(*modelRef->meshEntries, 0).materialIndex = r2::sarr::At(*model.optrMeshes, 0)->materialIndex;
+		SetMeshEntryLODs(r2::sarr::At(*modelRef->meshEntries, 0), *r2::sarr::At(*model.optrMeshes, 0));
 
 		//Upload the first mesh
-		cmd::FillVertexBuffer* fillVertexCommand = nullptr;
+		cmd::FillVertexBuffer* nextVertexCmd = nullptr;
+		cmd::FillQuantizedVertexBuffer* nextQuantizedVertexCmd = nullptr;
 
-		if (!prevCommand)
+		if (expandQuantizedVertices)
 		{
-			key::Basic uploadKey;
-			uploadKey.keyValue = 0;
-			fillVertexCommand = cmdbkt::AddCommand<key::Basic, mem::StackArena, cmd::FillVertexBuffer>(*commandBucketArena, *uploadBucket, uploadKey, 0);
+			if (!prevCommand)
+			{
+				key::Basic uploadKey;
+				uploadKey.keyValue = 0;
+				nextQuantizedVertexCmd = cmdbkt::AddCommand<key::Basic, mem::StackArena, cmd::FillQuantizedVertexBuffer>(*commandBucketArena, *uploadBucket, uploadKey, 0);
+			}
+			else
+			{
+				nextQuantizedVertexCmd = cmdbkt::AppendCommand<cmd::CopyBuffer, cmd::FillQuantizedVertexBuffer, mem::StackArena>(*commandBucketArena, prevCommand, 0);
+			}
+
+			FillQuantizedVertexBufferCommand(nextQuantizedVertexCmd, model, *r2::sarr::At(*model.optrMeshes, 0), vertexBufferLayout->gpuLayout.vboHandles[0], vertexEntry.start);
 		}
 		else
 		{
-			fillVertexCommand = cmdbkt::AppendCommand<cmd::CopyBuffer, cmd::FillVertexBuffer, mem::StackArena>(*commandBucketArena, prevCommand, 0);
-		}
-
-		FillVertexBufferCommand(fillVertexCommand, *r2::sarr::At(*model.optrMeshes, 0), vertexBufferLayout->gpuLayout.vboHandles[0], vertexEntry.start);
+			if (!prevCommand)
+			{
+				key::Basic uploadKey;
+				uploadKey.keyValue = 0;
+				nextVertexCmd = cmdbkt::AddCommand<key::Basic, mem::StackArena, cmd::FillVertexBuffer>(*commandBucketArena, *uploadBucket, uploadKey, 0);
+			}
+			else
+			{
+				nextVertexCmd = cmdbkt::AppendCommand<cmd::CopyBuffer, cmd::FillVertexBuffer, mem::StackArena>(*commandBucketArena, prevCommand, 0);
+			}
 
-		cmd::FillVertexBuffer* nextVertexCmd = fillVertexCommand;
+			FillVertexBufferCommand(nextVertexCmd, *r2::sarr::At(*model.optrMeshes, 0), vertexBufferLayout->gpuLayout.vboHandles[0], vertexEntry.start);
+		}
 
 		for (u32 i = 1; i < numMeshes; i++)
 		{
-			u32 numMeshVertices = r2::sarr::Size(*model.optrMeshes->mData[i]->optrVertices);
+			u32 numMeshVertices = GetNumVertices(*model.optrMeshes->mData[i]);
 
 			r2::sarr::At(*modelRef->meshEntries, i).gpuVertexEntry.size = numMeshVertices;
 			r2::sarr::At(*modelRef->meshEntries, i).gpuVertexEntry.start = r2::sarr::At(*modelRef->meshEntries, i - 1).gpuVertexEntry.size + r2::sarr::At(*modelRef->meshEntries, i - 1).gpuVertexEntry.start;
 			r2::sarr::At(*modelRef->meshEntries, i).materialIndex = r2::sarr::At(*model.optrMeshes, i)->materialIndex;
 			r2::sarr::At(*modelRef->meshEntries, i).meshBounds = r2::sarr::At(*model.optrMeshes, i)->objectBounds;
+			SetMeshEntryLODs(r2::sarr::At(*modelRef->meshEntries, i), *r2::sarr::At(*model.optrMeshes, i));
 
-			u32 vertexOffset = r2::sarr::At(*modelRef->meshEntries, i).gpuVertexEntry.start * sizeof(r2::draw::Vertex);
+			u32 vertexOffset = r2::sarr::At(*modelRef->meshEntries, i).gpuVertexEntry.start * vertexSize;
 
-			nextVertexCmd = cmdbkt::AppendCommand<cmd::FillVertexBuffer, cmd::FillVertexBuffer, mem::StackArena>(*commandBucketArena, nextVertexCmd, 0);
-			FillVertexBufferCommand(nextVertexCmd, *r2::sarr::At(*model.optrMeshes, i), vertexBufferLayout->gpuLayout.vboHandles[0], vertexOffset);
+			if (expandQuantizedVertices)
+			{
+				nextQuantizedVertexCmd = cmdbkt::AppendCommand<cmd::FillQuantizedVertexBuffer, cmd::FillQuantizedVertexBuffer, mem::StackArena>(*commandBucketArena, nextQuantizedVertexCmd, 0);
+				FillQuantizedVertexBufferCommand(nextQuantizedVertexCmd, model, *r2::sarr::At(*model.optrMeshes, i), vertexBufferLayout->gpuLayout.vboHandles[0], vertexOffset);
+			}
+			else
+			{
+				nextVertexCmd = cmdbkt::AppendCommand<cmd::FillVertexBuffer, cmd::FillVertexBuffer, mem::StackArena>(*commandBucketArena, nextVertexCmd, 0);
+				FillVertexBufferCommand(nextVertexCmd, *r2::sarr::At(*model.optrMeshes, i), vertexBufferLayout->gpuLayout.vboHandles[0], vertexOffset);
+			}
 		}
 
 		//Upload the bones
 		if (boneData)
 		{
-			nextVertexCmd = cmdbkt::AppendCommand<cmd::FillVertexBuffer, cmd::FillVertexBuffer, mem::StackArena>(*commandBucketArena, nextVertexCmd, 0);
+			if (expandQuantizedVertices)
+			{
+				nextVertexCmd = cmdbkt::AppendCommand<cmd::FillQuantizedVertexBuffer, cmd::FillVertexBuffer, mem::StackArena>(*commandBucketArena, nextQuantizedVertexCmd, 0);
+			}
+			else
+			{
+				nextVertexCmd = cmdbkt::AppendCommand<cmd::FillVertexBuffer, cmd::FillVertexBuffer, mem::StackArena>(*commandBucketArena, nextVertexCmd, 0);
+			}
+
 			FillBonesBufferCommand(nextVertexCmd, boneData, vertexBufferLayout->gpuLayout.vboHandles[1], boneVertexEntry.start);
 		}
 
 		//Upload all of the indices of the model
-		cmd::FillIndexBuffer* fillIndexCommand = cmdbkt::AppendCommand<cmd::FillVertexBuffer, cmd::FillIndexBuffer, mem::StackArena>(*commandBucketArena, nextVertexCmd, 0);
+		cmd::FillIndexBuffer* fillIndexCommand = nullptr;
+
+		if (nextVertexCmd)
+		{
+			fillIndexCommand = cmdbkt::AppendCommand<cmd::FillVertexBuffer, cmd::FillIndexBuffer, mem::StackArena>(*commandBucketArena, nextVertexCmd, 0);
+		}
+		else
+		{
+			fillIndexCommand = cmdbkt::AppendCommand<cmd::FillQuantizedVertexBuffer, cmd::FillIndexBuffer, mem::StackArena>(*commandBucketArena, nextQuantizedVertexCmd, 0);
+		}
+
 		FillIndexBufferCommand(fillIndexCommand, *r2::sarr::At(*model.optrMeshes, 0), vertexBufferLayout->gpuLayout.iboHandle, indexEntry.start);
 
 		cmd::FillIndexBuffer* nextIndexCmd = fillIndexCommand;
@@ -823,8 +878,10 @@ namespace r2::draw::vbsys
 
 		R2_CHECK(numVertexEntries > 0, "We should have at least 1");
 
+		const u32 vertexSize = GetVertexSize(*vertexBufferLayout);
+
 		vb::GPUBufferEntry vertexEntry;
-		vertexEntry.start = sizeof(r2::draw::Vertex) * r2::sarr::At(*modelRef->meshEntries, 0).gpuVertexEntry.start;
+		vertexEntry.start = vertexSize * r2::sarr::At(*modelRef->meshEntries, 0).gpuVertexEntry.start;
 		vertexEntry.size = r2::sarr::At(*modelRef->meshEntries, 0).gpuVertexEntry.size;
 
 		vb::GPUBufferEntry indexEntry;
@@ -837,7 +894,7 @@ namespace r2::draw::vbsys
 			indexEntry.size += r2::sarr::At(*modelRef->meshEntries, i).gpuIndexEntry.size;
 		}
 
-		vertexEntry.size *= sizeof(Vertex);
+		vertexEntry.size *= vertexSize;
 		indexEntry.size *= sizeof(u32);
 
 		if (modelRef->boneEntry.size > 0)
@@ -1075,6 +1132,11 @@ namespace r2::draw::vbsys
 		return foundIndex;
 	}
 
+	u32 GetVertexSize(const vb::VertexBufferLayout& vertexBufferLayout)
+	{
+		return vertexBufferLayout.layout.layout.GetStride(0);
+	}
+
 	u64 FillVertexBufferCommand(cmd::FillVertexBuffer* cmd, const Mesh& mesh, VertexBufferHandle handle, u64 offset)
 	{
 		if (cmd == nullptr)
@@ -1083,16 +1145,65 @@ namespace r2::draw::vbsys
 			return 0;
 		}
 
-		const u64 numVertices = r2::sarr::Size(*mesh.optrVertices);
-
 		cmd->vertexBufferHandle = handle;
 		cmd->offset = offset;
-		cmd->dataSize = sizeof(r2::draw::Vertex) * numVertices;
-		cmd->data = r2::sarr::Begin(*mesh.optrVertices);
+
+		if (mesh.optrQuantizedVertices)
+		{
+			cmd->dataSize = sizeof(r2::draw::QuantizedVertex) * r2::sarr::Size(*mesh.optrQuantizedVertices);
+			cmd->data = r2::sarr::Begin(*mesh.optrQuantizedVertices);
+		}
+		else
+		{
+			cmd->dataSize = sizeof(r2::draw::Vertex) * r2::sarr::Size(*mesh.optrVertices);
+			cmd->data = r2::sarr::Begin(*mesh.optrVertices);
+		}
 
 		return cmd->dataSize + offset;
 	}
 
+	u64 FillQuantizedVertexBufferCommand(cmd::FillQuantizedVertexBuffer* cmd, const Model& model, const Mesh& mesh, VertexBufferHandle handle, u64 offset)
+	{
+		if (cmd == nullptr)
+		{
+			R2_CHECK(false, "cmd or model is null");
+			return 0;
+		}
+
+		cmd->vertexBufferHandle = handle;
+		cmd->offset = offset;
+		cmd->numVertices = r2::sarr::Size(*mesh.optrQuantizedVertices);
+		cmd->data = r2::sarr::Begin(*mesh.optrQuantizedVertices);
+
+		for (u32 i = 0; i < 3; ++i)
+		{
+			cmd->positionScale[i] = model.quantizedPositionScale[i];
+			cmd->positionBias[i] = model.quantizedPositionBias[i];
+		}
+
+		return sizeof(r2::draw::Vertex) * cmd->numVertices + offset;
+	}
+
+	void SetMeshEntryLODs(vb::MeshEntry& meshEntry, const Mesh& mesh)
+	{
+		if (mesh.numLODs == 0)
+		{
+			//meshes that weren't made by the converter only have the one LOD
+			meshEntry.numLODs = 1;
+			meshEntry.lods[0].firstIndex = 0;
+			meshEntry.lods[0].numIndices = static_cast<u32>(r2::sarr::Size(*mesh.optrIndices));
+			meshEntry.lods[0].error = 0.0f;
+			return;
+		}
+
+		meshEntry.numLODs = mesh.numLODs;
+
+		for (u32 i = 0; i < mesh.numLODs; ++i)
+		{
+			meshEntry.lods[i] = mesh.lods[i];
+		}
+	}
+
 	u64 FillBonesBufferCommand(cmd::FillVertexBuffer* cmd, const r2::SArray<r2::draw::BoneData>* boneData, VertexBufferHandle handle, u64 offset)
 	{
 		if (cmd == nullptr)
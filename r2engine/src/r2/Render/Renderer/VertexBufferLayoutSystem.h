@@ -35,6 +35,10 @@ namespace r2::draw::vb
 		u32 materialIndex;
 
 		Bounds meshBounds;
+
+		//firstIndex is relative to gpuIndexEntry.start - there's always at least LOD 0
+		MeshLOD lods[Mesh::MAX_NUM_LODS];
+		u32 numLODs;
 	};
 
 	struct GPUModelRef
@@ -50,6 +54,7 @@ namespace r2::draw::vb
 		GPUBufferEntry boneEntry;
 		u32 numBones;
 		b32 isAnimated;
+		b32 isQuantized; //the vertices are in the GPU buffer as QuantizedVertex
 		u32 numGLTFMeshes;
 	};
 
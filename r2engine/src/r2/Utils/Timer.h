@@ -2,9 +2,11 @@
 #define __TIMER_H__
 
 #include "r2/Utils/Utils.h"
+#include "r2/Core/Profiler/Profiler.h"
 
-#define PROFILE_SCOPE_FN r2::util::Timer timerScope(__FUNCTION__, true);
-#define PROFILE_SCOPE(name) r2::util::Timer timerScopeName(name, true);
+//@NOTE(Serge): these used to print out a Timer - they're profiler zones now so they show up in the profiler panel and the trace. Names need to be static strings.
+#define PROFILE_SCOPE_FN R2_PROFILE_FUNCTION();
+#define PROFILE_SCOPE(name) R2_PROFILE_ZONE(name);
 
 namespace r2::util
 {
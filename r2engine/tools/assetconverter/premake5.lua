@@ -6,6 +6,7 @@ assetconverterIncludeDirs["cmdln"] = "../../libs/cmdln/include"
 assetconverterIncludeDirs["stb"] = "../../vendor/stb"
 assetconverterIncludeDirs["flatbuffers"] = "../../vendor/flatbuffers/include"
 assetconverterIncludeDirs["nvtt"] = "./libs/nvtt/include"
+assetconverterIncludeDirs["sha256"] = "../../vendor/sha256"
 
 project "assetconverter"
 	kind "ConsoleApp"
@@ -20,6 +21,8 @@ project "assetconverter"
 	{
 		"include/**.h",
 		"src/**.cpp",
+		"../../vendor/sha256/*.h",
+		"../../vendor/sha256/*.cpp"
 	}
 
 	includedirs
@@ -34,7 +37,8 @@ project "assetconverter"
 		"%{assetconverterIncludeDirs.cmdln}",
 		"%{assetconverterIncludeDirs.stb}",
 		"%{assetconverterIncludeDirs.flatbuffers}",
-		"%{assetconverterIncludeDirs.nvtt}"
+		"%{assetconverterIncludeDirs.nvtt}",
+		"%{assetconverterIncludeDirs.sha256}"
 	}
 
 	sysincludedirs
@@ -11,12 +11,19 @@
 
 #include "flatbuffers/flatbuffers.h"
 
+#include "sha256.h"
+
 #include <filesystem>
 #include <string>
 
 #include <fstream>
 
 #include <algorithm>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <unordered_map>
 
 namespace fs = std::filesystem;
 
@@ -34,6 +41,16 @@ namespace
 	//models
 	std::string GLTF_EXTENSION = ".gltf";
 	std::string GLB_EXTENSION = ".glb";
+	std::string BIN_EXTENSION = ".bin";
+
+	//outputs
+	std::string RTEX_EXTENSION = ".rtex";
+	std::string RMDL_EXTENSION = ".rmdl";
+
+	//build cache
+	std::string BUILD_CACHE_FILE_NAME = ".assetconverter_cache";
+	//bump this whenever the converters change their output so everything gets rebuilt
+	std::string BUILD_CACHE_VERSION = "3";
 }
 
 struct Arguments
@@ -46,6 +63,38 @@ struct Arguments
 	std::string texturePacksManifestPath = "";
 	uint32_t animationSamples = 60;
 	bool forceMaterialRebuild = false;
+	bool compressAnimations = false;
+	float animationCompressionTolerance = 0.0005f;
+	bool quantizeVertices = false;
+	std::string lodErrors = "0.01,0.04,0.12";
+	uint32_t numThreads = 0;
+	bool noCache = false;
+};
+
+enum class ConversionResult
+{
+	SKIPPED = 0,
+	CONVERTED,
+	FAILED
+};
+
+struct ConversionJob
+{
+	fs::path inputFilePath;
+	fs::path outputDir;
+	fs::path outputFilePath;
+	std::string extension;
+	std::string cacheName;
+	uintmax_t fileSize = 0;
+
+	//images only - these come from the closest meta.json seen while walking the input directory
+	uint32_t desiredMipLevels = 1;
+	flat::MipMapFilter mipMapFilter = flat::MipMapFilter_BOX;
+
+	//filled in when the job runs
+	std::string cacheKey = "";
+	std::string outputHash = "";
+	ConversionResult result = ConversionResult::FAILED;
 };
 
 bool SkipDirectory(const fs::path& p)
@@ -69,6 +118,41 @@ bool IsImage(const std::string& extension)
 		theExtension == HDR_EXTENSION;
 }
 
+std::vector<float> ParseLODErrors(const std::string& lodErrors)
+{
+	std::vector<float> lodErrorTargets;
+
+	size_t start = 0;
+	while (start < lodErrors.size())
+	{
+		size_t end = lodErrors.find(',', start);
+		if (end == std::string::npos)
+		{
+			end = lodErrors.size();
+		}
+
+		const std::string value = lodErrors.substr(start, end - start);
+
+		if (!value.empty())
+		{
+			const float lodError = std::strtof(value.c_str(), nullptr);
+
+			if (lodError > 0.0f)
+			{
+				lodErrorTargets.push_back(lodError);
+			}
+			else
+			{
+				printf("Ignoring LOD error: %s - it should be greater than 0\n", value.c_str());
+			}
+		}
+
+		start = end + 1;
+	}
+
+	return lodErrorTargets;
+}
+
 bool IsModel(const std::string& extension)
 {
 	std::string theExtension = extension;
@@ -219,6 +303,316 @@ void CreateMetaDataFile(fs::path metaDataJSONPath, fs::path inputPath, fs::path
 	}
 }
 
+std::string DigestToString(const unsigned char* digest)
+{
+	char buf[2 * SHA256::DIGEST_SIZE + 1];
+	buf[2 * SHA256::DIGEST_SIZE] = 0;
+
+	for (unsigned int i = 0; i < SHA256::DIGEST_SIZE; ++i)
+	{
+		snprintf(buf + i * 2, 3, "%02x", digest[i]);
+	}
+
+	return std::string(buf);
+}
+
+bool HashFileContents(const fs::path& path, SHA256& ctx)
+{
+	std::ifstream file;
+
+	file.open(path, std::ios::in | std::ios::binary);
+
+	if (!file.good())
+	{
+		return false;
+	}
+
+	std::vector<char> buffer(64 * 1024);
+
+	while (file)
+	{
+		file.read(buffer.data(), buffer.size());
+
+		const std::streamsize numRead = file.gcount();
+
+		if (numRead > 0)
+		{
+			ctx.update(reinterpret_cast<const unsigned char*>(buffer.data()), static_cast<unsigned int>(numRead));
+		}
+	}
+
+	return true;
+}
+
+void HashString(const std::string& str, SHA256& ctx)
+{
+	ctx.update(reinterpret_cast<const unsigned char*>(str.c_str()), static_cast<unsigned int>(str.size() + 1));
+}
+
+std::string HashFile(const fs::path& path)
+{
+	if (path.empty() || !fs::is_regular_file(path))
+	{
+		return "";
+	}
+
+	SHA256 ctx;
+	ctx.init();
+
+	if (!HashFileContents(path, ctx))
+	{
+		return "";
+	}
+
+	unsigned char digest[SHA256::DIGEST_SIZE];
+	ctx.final(digest);
+
+	return DigestToString(digest);
+}
+
+//The key of a job is the hash of everything that goes into the conversion: the input file (and the buffers of a .gltf),
+//the settings used and, for models, the manifests the materials are resolved against
+std::string MakeCacheKey(const ConversionJob& job, const std::string& settings)
+{
+	SHA256 ctx;
+	ctx.init();
+
+	HashString(BUILD_CACHE_VERSION, ctx);
+	HashString(job.outputDir.generic_string(), ctx);
+	HashString(settings, ctx);
+	HashString(std::to_string(job.desiredMipLevels) + "|" + std::to_string(job.mipMapFilter), ctx);
+
+	if (!HashFileContents(job.inputFilePath, ctx))
+	{
+		return "";
+	}
+
+	std::string extension = job.extension;
+
+	std::transform(extension.begin(), extension.end(), extension.begin(),
+		[](unsigned char c) { return std::tolower(c); });
+
+	if (extension == GLTF_EXTENSION)
+	{
+		std::vector<fs::path> buffers;
+
+		for (auto& p : fs::directory_iterator(job.inputFilePath.parent_path()))
+		{
+			std::string bufferExtension = p.path().extension().string();
+
+			std::transform(bufferExtension.begin(), bufferExtension.end(), bufferExtension.begin(),
+				[](unsigned char c) { return std::tolower(c); });
+
+			if (p.is_regular_file() && bufferExtension == BIN_EXTENSION)
+			{
+				buffers.push_back(p.path());
+			}
+		}
+
+		std::sort(buffers.begin(), buffers.end());
+
+		for (const auto& buffer : buffers)
+		{
+			HashString(buffer.filename().generic_string(), ctx);
+			HashFileContents(buffer, ctx);
+		}
+	}
+
+	unsigned char digest[SHA256::DIGEST_SIZE];
+	ctx.final(digest);
+
+	return DigestToString(digest);
+}
+
+struct BuildCacheEntry
+{
+	std::string cacheKey;
+	std::string outputHash;
+};
+
+//Each line is <cache key>\t<hash of the output file>\t<cache name>
+void LoadBuildCache(const fs::path& cachePath, std::unordered_map<std::string, BuildCacheEntry>& buildCache)
+{
+	std::ifstream cacheFile;
+
+	cacheFile.open(cachePath, std::ios::in);
+
+	if (!cacheFile.good())
+	{
+		return;
+	}
+
+	std::string line;
+	while (std::getline(cacheFile, line))
+	{
+		const size_t firstTab = line.find('\t');
+		const size_t secondTab = firstTab != std::string::npos ? line.find('\t', firstTab + 1) : std::string::npos;
+
+		if (secondTab == std::string::npos)
+		{
+			continue;
+		}
+
+		BuildCacheEntry& entry = buildCache[line.substr(secondTab + 1)];
+		entry.cacheKey = line.substr(0, firstTab);
+		entry.outputHash = line.substr(firstTab + 1, secondTab - firstTab - 1);
+	}
+}
+
+//Written sorted by name so the cache file is the same no matter what order the jobs finished in
+void WriteBuildCache(const fs::path& cachePath, const std::vector<ConversionJob>& jobs)
+{
+	std::vector<const ConversionJob*> entries;
+
+	for (const auto& job : jobs)
+	{
+		if (job.result != ConversionResult::FAILED && !job.cacheKey.empty() && !job.outputHash.empty())
+		{
+			entries.push_back(&job);
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const ConversionJob* a, const ConversionJob* b) {
+		return a->cacheName < b->cacheName;
+	});
+
+	std::ofstream cacheFile;
+
+	cacheFile.open(cachePath, std::ios::out | std::ios::trunc);
+
+	if (!cacheFile.good())
+	{
+		printf("Couldn't write the build cache: %s\n", cachePath.string().c_str());
+		return;
+	}
+
+	for (const auto* entry : entries)
+	{
+		cacheFile << entry->cacheKey << '\t' << entry->outputHash << '\t' << entry->cacheName << '\n';
+	}
+}
+
+//Runs func(i) for every i in [0, numJobs) on numThreads threads (including this one). Jobs are handed out in order.
+template<typename Func>
+void ParallelFor(size_t numJobs, uint32_t numThreads, Func&& func)
+{
+	std::atomic<size_t> nextJob = 0;
+
+	auto worker = [&]()
+	{
+		for (size_t i = nextJob++; i < numJobs; i = nextJob++)
+		{
+			func(i);
+		}
+	};
+
+	const size_t numWorkers = std::min(static_cast<size_t>(std::max(numThreads, 1u)), numJobs);
+
+	std::vector<std::thread> threads;
+
+	for (size_t i = 1; i < numWorkers; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+
+	worker();
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+//Jobs are kept sorted by path so the cache and the summary are deterministic, but the biggest files are started first
+//so one large model doesn't end up running alone at the end
+void RunConversionJobs(std::vector<ConversionJob>& jobs, uint32_t numThreads, const std::unordered_map<std::string, BuildCacheEntry>& buildCache, bool useCache, const std::string& settings, bool (*convert)(const ConversionJob&, void*), void* userData)
+{
+	std::sort(jobs.begin(), jobs.end(), [](const ConversionJob& a, const ConversionJob& b) {
+		return a.inputFilePath < b.inputFilePath;
+	});
+
+	std::vector<size_t> order(jobs.size());
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		order[i] = i;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&jobs](size_t a, size_t b) {
+		return jobs[a].fileSize > jobs[b].fileSize;
+	});
+
+	ParallelFor(jobs.size(), numThreads, [&](size_t i)
+	{
+		ConversionJob& job = jobs[order[i]];
+
+		job.cacheKey = MakeCacheKey(job, settings);
+
+		if (useCache && !job.cacheKey.empty())
+		{
+			auto iter = buildCache.find(job.cacheName);
+
+			//the output has to still be exactly what we wrote, otherwise a deleted or modified output would never get rebuilt
+			if (iter != buildCache.end() && iter->second.cacheKey == job.cacheKey &&
+				!iter->second.outputHash.empty() && HashFile(job.outputFilePath) == iter->second.outputHash)
+			{
+				job.outputHash = iter->second.outputHash;
+				job.result = ConversionResult::SKIPPED;
+				return;
+			}
+		}
+
+		job.result = convert(job, userData) ? ConversionResult::CONVERTED : ConversionResult::FAILED;
+
+		if (job.result == ConversionResult::CONVERTED)
+		{
+			job.outputHash = HashFile(job.outputFilePath);
+		}
+	});
+}
+
+struct ModelConversionSettings
+{
+	fs::path materialParamsManifestPath;
+	fs::path rawMaterialsParentPath;
+	fs::path engineTexturePacksManifestPath;
+	fs::path texturePacksManifestPath;
+	bool forceRebuild = false;
+	uint32_t numberOfAnimationSamples = 60;
+	bool compressAnimations = false;
+	float animationCompressionTolerance = 0.0005f;
+	bool quantizeVertices = false;
+	std::vector<float> lodErrorTargets;
+};
+
+bool ConvertImageJob(const ConversionJob& job, void*)
+{
+	return r2::assets::assetlib::ConvertImage(job.inputFilePath, job.outputDir, job.extension, std::max(job.desiredMipLevels, (uint32_t)1), job.mipMapFilter);
+}
+
+bool ConvertModelJob(const ConversionJob& job, void* userData)
+{
+	const ModelConversionSettings& settings = *static_cast<const ModelConversionSettings*>(userData);
+
+	return r2::assets::assetlib::ConvertModel(job.inputFilePath, job.outputDir, settings.materialParamsManifestPath, settings.rawMaterialsParentPath, settings.engineTexturePacksManifestPath, settings.texturePacksManifestPath, settings.forceRebuild, settings.numberOfAnimationSamples, settings.compressAnimations, settings.animationCompressionTolerance, settings.quantizeVertices, settings.lodErrorTargets);
+}
+
+void CountResults(const std::vector<ConversionJob>& jobs, size_t& numConverted, size_t& numSkipped, size_t& numFailed)
+{
+	for (const auto& job : jobs)
+	{
+		if (job.result == ConversionResult::CONVERTED)
+			++numConverted;
+		else if (job.result == ConversionResult::SKIPPED)
+			++numSkipped;
+		else
+		{
+			++numFailed;
+			printf("Failed to convert: %s\n", job.inputFilePath.string().c_str());
+		}
+	}
+}
+
 int main(int agrc, char** argv)
 {
 	Arguments arguments;
@@ -231,6 +625,12 @@ int main(int agrc, char** argv)
 	args.AddArgument({ "-t", "--texturepacksmanifest" }, &arguments.texturePacksManifestPath, "Texture Packs Manifest Path");
 	args.AddArgument({ "-f", "--forcerematerialrebuild" }, &arguments.forceMaterialRebuild, "Force Material Rebuild");
 	args.AddArgument({ "-s", "--animationsamples" }, &arguments.animationSamples, "Number of animation samples");
+	args.AddArgument({ "-c", "--compressanimations" }, &arguments.compressAnimations, "Compress the animation clips");
+	args.AddArgument({ "-a", "--animationtolerance" }, &arguments.animationCompressionTolerance, "Max error allowed when removing animation keys");
+	args.AddArgument({ "-q", "--quantizevertices" }, &arguments.quantizeVertices, "Write model vertices in the compact 16 bit vertex format");
+	args.AddArgument({ "-l", "--loderrors" }, &arguments.lodErrors, "Comma separated errors for each model LOD, relative to the mesh size. Empty for no LODs");
+	args.AddArgument({ "-j", "--jobs" }, &arguments.numThreads, "Number of threads to convert with, 0 uses all of the cores");
+	args.AddArgument({ "-n", "--nocache" }, &arguments.noCache, "Ignore the build cache and convert every file");
 	args.Parse(agrc, argv);
 
 	//arguments.inputDir = "D:\\Projects\\r2engine\\Sandbox\\assets\\Sandbox_Models\\BaseFemale2Test\\BaseFemale2Test.glb";
@@ -261,6 +661,11 @@ int main(int agrc, char** argv)
 	fs::path texturePacksManifestPath{ arguments.texturePacksManifestPath };
 	uint32_t numberOfAnimationSamples = arguments.animationSamples;
 	bool forceRebuild = arguments.forceMaterialRebuild;
+	bool compressAnimations = arguments.compressAnimations;
+	float animationCompressionTolerance = arguments.animationCompressionTolerance;
+	bool quantizeVertices = arguments.quantizeVertices;
+	std::vector<float> lodErrorTargets = ParseLODErrors(arguments.lodErrors);
+	uint32_t numThreads = arguments.numThreads > 0 ? arguments.numThreads : std::max(std::thread::hardware_concurrency(), 1u);
 
 	fs::path currentMetaPath = "";
 
@@ -274,7 +679,7 @@ int main(int agrc, char** argv)
 
 		if (IsModel(extension))
 		{
-			r2::assets::assetlib::ConvertModel(inputPath, outputPath, materialParamsManifestPath, rawMaterialsParentPath, engineTexturePacksManifestPath, texturePacksManifestPath, forceRebuild, numberOfAnimationSamples);
+			r2::assets::assetlib::ConvertModel(inputPath, outputPath, materialParamsManifestPath, rawMaterialsParentPath, engineTexturePacksManifestPath, texturePacksManifestPath, forceRebuild, numberOfAnimationSamples, compressAnimations, animationCompressionTolerance, quantizeVertices, lodErrorTargets);
 		}
 
 		//@TODO(Serge): other types here
@@ -289,6 +694,11 @@ int main(int agrc, char** argv)
 			}
 		}
 
+		//Walk the tree first to make the output directories and the texture pack meta files, then convert.
+		//Images go before models since models resolve their materials against the texture packs.
+		std::vector<ConversionJob> imageJobs;
+		std::vector<ConversionJob> modelJobs;
+
 		for (auto& p : fs::recursive_directory_iterator(inputPath))
 		{
 			fs::path newOutputPath = GetOutputPathForInputDirectory(outputPath, inputPath, p.path());
@@ -325,16 +735,78 @@ int main(int agrc, char** argv)
 					continue;
 				}
 
+				ConversionJob job;
+				job.inputFilePath = p.path();
+				job.outputDir = newOutputPath;
+				job.extension = extension;
+				job.cacheName = p.path().lexically_relative(inputPath).generic_string();
+				job.fileSize = p.file_size();
+
 				if (IsImage(extension) && !SkipDirectory(p.path().parent_path()))
 				{
-					r2::assets::assetlib::ConvertImage(p.path(), newOutputPath, extension, std::max(desiredMipLevels, (uint32_t)1), mipMapFilter);
+					job.desiredMipLevels = desiredMipLevels;
+					job.mipMapFilter = mipMapFilter;
+					job.outputFilePath = newOutputPath / fs::path(p.path().filename()).replace_extension(RTEX_EXTENSION);
+
+					imageJobs.push_back(job);
 				}
 				else if (IsModel(extension))
 				{
-					r2::assets::assetlib::ConvertModel(p.path(), newOutputPath, materialParamsManifestPath, rawMaterialsParentPath, engineTexturePacksManifestPath, texturePacksManifestPath, forceRebuild, numberOfAnimationSamples);
+					job.outputFilePath = newOutputPath / fs::path(p.path().filename()).replace_extension(RMDL_EXTENSION);
+					modelJobs.push_back(job);
 				}
 			}
 		}
+
+		fs::path buildCachePath = outputPath / BUILD_CACHE_FILE_NAME;
+
+		std::unordered_map<std::string, BuildCacheEntry> buildCache;
+
+		if (!arguments.noCache)
+		{
+			LoadBuildCache(buildCachePath, buildCache);
+		}
+
+		RunConversionJobs(imageJobs, numThreads, buildCache, !arguments.noCache, "", ConvertImageJob, nullptr);
+
+		ModelConversionSettings modelSettings;
+		modelSettings.materialParamsManifestPath = materialParamsManifestPath;
+		modelSettings.rawMaterialsParentPath = rawMaterialsParentPath;
+		modelSettings.engineTexturePacksManifestPath = engineTexturePacksManifestPath;
+		modelSettings.texturePacksManifestPath = texturePacksManifestPath;
+		modelSettings.forceRebuild = forceRebuild;
+		modelSettings.numberOfAnimationSamples = numberOfAnimationSamples;
+		modelSettings.compressAnimations = compressAnimations;
+		modelSettings.animationCompressionTolerance = animationCompressionTolerance;
+		modelSettings.quantizeVertices = quantizeVertices;
+		modelSettings.lodErrorTargets = lodErrorTargets;
+
+		//models depend on the material and texture pack manifests so those are part of every model's key
+		std::string modelSettingsString =
+			HashFile(materialParamsManifestPath) + "|" +
+			HashFile(engineTexturePacksManifestPath) + "|" +
+			HashFile(texturePacksManifestPath) + "|" +
+			rawMaterialsParentPath.generic_string() + "|" +
+			std::to_string(numberOfAnimationSamples) + "|" +
+			std::to_string(compressAnimations) + "|" +
+			std::to_string(animationCompressionTolerance) + "|" +
+			std::to_string(quantizeVertices) + "|" +
+			arguments.lodErrors;
+
+		RunConversionJobs(modelJobs, numThreads, buildCache, !arguments.noCache && !forceRebuild, modelSettingsString, ConvertModelJob, &modelSettings);
+
+		std::vector<ConversionJob> allJobs = imageJobs;
+		allJobs.insert(allJobs.end(), modelJobs.begin(), modelJobs.end());
+
+		WriteBuildCache(buildCachePath, allJobs);
+
+		size_t numConverted = 0;
+		size_t numSkipped = 0;
+		size_t numFailed = 0;
+
+		CountResults(allJobs, numConverted, numSkipped, numFailed);
+
+		printf("Converted: %zu, unchanged: %zu, failed: %zu - using %u threads\n", numConverted, numSkipped, numFailed, numThreads);
 	}
 
 	
@@ -61,6 +61,7 @@ struct Arguments
 	uint32_t iblsamples = 1024;
 	uint32_t outputSize = 0;
 	uint32_t numMipsToGenerate = 1;
+	uint32_t numThreads = 0;
 };
 
 void GenerateMipMaps(std::vector<r2::ibl::Cubemap>& levels, std::vector<r2::ibl::Image>& images);
@@ -145,6 +146,7 @@ int main(int argc, char* argv[])
 	args.AddArgument({ "-l", "--lutDFG" }, &arguments.lutDFG, "Make the lut dfg image");
 	args.AddArgument({ "-d", "--diffuseIrradiance" }, &arguments.diffuseIrradiance, "Make the diffuse irradiance cubemap");
 	args.AddArgument({ "-s", "--multiScatter" }, &arguments.multiscatter, "Use multiscattering");
+	args.AddArgument({ "-t", "--threads" }, &arguments.numThreads, "The number of threads to filter with. The default of 0 uses all of the cores");
 	args.Parse(argc, argv);
 
 	if (arguments.help)
@@ -152,6 +154,8 @@ int main(int argc, char* argv[])
 		args.PrintHelp();
 	}
 
+	r2::ibl::CubemapIBL::SetNumThreads(arguments.numThreads);
+
 	if (!arguments.inputFile.empty())
 	{
 		r2::ibl::Image inputImage;